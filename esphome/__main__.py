@@ -18,6 +18,7 @@ from esphome.const import (
     CONF_PORT,
     CONF_ESPHOME,
     CONF_PLATFORMIO_OPTIONS,
+    ENV_BUILD_CACHE_DIR,
     SECRETS_FILES,
 )
 from esphome.core import CORE, EsphomeError, coroutine
@@ -187,7 +188,18 @@ def compile_program(args, config):
     if rc != 0:
         return rc
     idedata = platformio_api.get_idedata(config)
-    return 0 if idedata is not None else 1
+    if idedata is None:
+        return 1
+    if getattr(args, "size_report", False):
+        from esphome import size_report
+
+        report = size_report.create_report(
+            os.path.splitext(idedata.firmware_elf_path)[0] + ".map",
+            CORE.relative_build_path("size_report.json"),
+        )
+        if report is not None:
+            _LOGGER.info("Firmware size per component:\n%s", report)
+    return 0
 
 
 def upload_using_esptool(config, port):
@@ -393,6 +405,74 @@ def command_run(args, config):
     return show_logs(config, args, port)
 
 
+def command_perf(args, config):
+    import time
+
+    from esphome import perf_report, platformio_api, size_report
+
+    if args.update_baseline and args.baseline is None:
+        raise EsphomeError("--update-baseline requires --baseline")
+    exit_code = write_cpp(config)
+    if exit_code != 0:
+        return exit_code
+    exit_code = compile_program(args, config)
+    if exit_code != 0:
+        return exit_code
+    idedata = platformio_api.get_idedata(config)
+    map_path = os.path.splitext(idedata.firmware_elf_path)[0] + ".map"
+    if not os.path.isfile(map_path):
+        raise EsphomeError(f"No linker map at {map_path}")
+    with open(map_path, encoding="utf-8", errors="replace") as file_handle:
+        metrics = perf_report.size_metrics(size_report.parse_map(file_handle.read()))
+
+    if not args.no_device:
+        if "api" not in config:
+            raise EsphomeError("Measuring on the device requires the api: component")
+        started = None
+        if args.upload:
+            port = choose_upload_log_host(
+                default=args.device,
+                check_default=None,
+                show_ota=True,
+                show_mqtt=False,
+                show_api=False,
+            )
+            exit_code = upload_program(config, args, port)
+            if exit_code != 0:
+                return exit_code
+            # the device restarts right after the upload
+            started = time.monotonic()
+        if args.reset_port:
+            perf_report.reset_device(args.reset_port)
+            started = time.monotonic()
+        address = CORE.address
+        if args.device is not None and get_port_type(args.device) == "NETWORK":
+            address = args.device
+        metrics.update(
+            perf_report.measure(config, address, args.duration, started=started)
+        )
+
+    if args.baseline is None:
+        safe_print(perf_report.format_metrics(metrics))
+        return 0
+    if args.update_baseline:
+        perf_report.write_baseline(args.baseline, metrics)
+        safe_print(perf_report.format_metrics(metrics))
+        _LOGGER.info("Stored the metrics as baseline in %s", args.baseline)
+        return 0
+    baseline, tolerances = perf_report.load_baseline(args.baseline)
+    if not baseline:
+        raise EsphomeError(f"No baseline at {args.baseline}, use --update-baseline")
+    results = perf_report.compare(metrics, baseline, tolerances)
+    safe_print(perf_report.format_comparison(results))
+    regressions = [r.name for r in results if r.regressed]
+    if regressions:
+        _LOGGER.error("Performance regression in %s", ", ".join(regressions))
+        return 1
+    _LOGGER.info("No performance regressions.")
+    return 0
+
+
 def command_clean_mqtt(args, config):
     return clean_mqtt(config, args)
 
@@ -495,6 +575,7 @@ POST_CONFIG_ACTIONS = {
     "upload": command_upload,
     "logs": command_logs,
     "run": command_run,
+    "perf": command_perf,
     "clean-mqtt": command_clean_mqtt,
     "mqtt-fingerprint": command_mqtt_fingerprint,
     "clean": command_clean,
@@ -555,6 +636,21 @@ def parse_args(argv):
         help="Only generate source code, do not compile.",
         action="store_true",
     )
+    parser_compile.add_argument(
+        "--build-cache",
+        help="Directory for a build cache shared by all configurations.",
+        metavar="DIR",
+    )
+    parser_compile.add_argument(
+        "--keep-going",
+        help="Continue with the next configuration if one of them fails.",
+        action="store_true",
+    )
+    parser_compile.add_argument(
+        "--size-report",
+        help="Show the flash and RAM used by each component, and the change since the last report.",
+        action="store_true",
+    )
 
     parser_upload = subparsers.add_parser(
         "upload", help="Validate the configuration and upload the latest binary."
@@ -596,6 +692,51 @@ def parse_args(argv):
         "--no-logs", help="Disable starting logs.", action="store_true"
     )
 
+    parser_perf = subparsers.add_parser(
+        "perf",
+        help="Compile a configuration, measure the firmware on a device and compare "
+        "the metrics with a baseline.",
+    )
+    parser_perf.add_argument(
+        "configuration", help="Your YAML configuration file.", nargs=1
+    )
+    parser_perf.add_argument(
+        "--device",
+        help="Manually specify the serial port/address to use, for example /dev/ttyUSB0.",
+    )
+    parser_perf.add_argument(
+        "--upload",
+        help="Upload the firmware before measuring, also measures the time until "
+        "the API is reachable.",
+        action="store_true",
+    )
+    parser_perf.add_argument(
+        "--reset-port",
+        help="Reset the device through this serial port before measuring, also "
+        "measures the time until the API is reachable.",
+    )
+    parser_perf.add_argument(
+        "--no-device",
+        help="Only report the flash and RAM use of the firmware.",
+        action="store_true",
+    )
+    parser_perf.add_argument(
+        "--duration",
+        help="Seconds to collect the sensor states of the device. Defaults to 180.",
+        type=float,
+        default=180,
+    )
+    parser_perf.add_argument(
+        "--baseline",
+        help="JSON file with the baseline metrics to compare with.",
+        metavar="FILE",
+    )
+    parser_perf.add_argument(
+        "--update-baseline",
+        help="Store the metrics as new baseline instead of comparing them.",
+        action="store_true",
+    )
+
     parser_clean = subparsers.add_parser(
         "clean-mqtt",
         help="Helper to clear retained messages from an MQTT topic.",
@@ -792,32 +933,48 @@ def run_esphome(argv):
             _LOGGER.error(e, exc_info=args.verbose)
             return 1
 
+    if getattr(args, "build_cache", None):
+        os.environ[ENV_BUILD_CACHE_DIR] = os.path.abspath(args.build_cache)
+
+    keep_going = getattr(args, "keep_going", False)
+    failed = []
     for conf_path in args.configuration:
         if any(os.path.basename(conf_path) == x for x in SECRETS_FILES):
             _LOGGER.warning("Skipping secrets file %s", conf_path)
             continue
 
-        CORE.config_path = conf_path
-        CORE.dashboard = args.dashboard
+        rc = run_configuration(args, conf_path)
+        if rc != 0:
+            if not keep_going:
+                return rc
+            failed.append((conf_path, rc))
+        CORE.reset()
 
-        config = read_config(dict(args.substitution) if args.substitution else {})
-        if config is None:
-            return 2
-        CORE.config = config
+    if failed:
+        _LOGGER.error(
+            "Failed configurations: %s", ", ".join(path for path, _ in failed)
+        )
+        return failed[0][1]
+    return 0
 
-        if args.command not in POST_CONFIG_ACTIONS:
-            safe_print(f"Unknown command {args.command}")
 
-        try:
-            rc = POST_CONFIG_ACTIONS[args.command](args, config)
-        except EsphomeError as e:
-            _LOGGER.error(e, exc_info=args.verbose)
-            return 1
-        if rc != 0:
-            return rc
+def run_configuration(args, conf_path):
+    CORE.config_path = conf_path
+    CORE.dashboard = args.dashboard
 
-        CORE.reset()
-    return 0
+    config = read_config(dict(args.substitution) if args.substitution else {})
+    if config is None:
+        return 2
+    CORE.config = config
+
+    if args.command not in POST_CONFIG_ACTIONS:
+        safe_print(f"Unknown command {args.command}")
+
+    try:
+        return POST_CONFIG_ACTIONS[args.command](args, config)
+    except EsphomeError as e:
+        _LOGGER.error(e, exc_info=args.verbose)
+        return 1
 
 
 def main():
@@ -6,6 +6,7 @@ from esphome.const import (
     CONF_COUNT,
     CONF_ELSE,
     CONF_ID,
+    CONF_LAMBDA,
     CONF_THEN,
     CONF_TIMEOUT,
     CONF_TRIGGER_ID,
@@ -65,6 +66,7 @@ def validate_potentially_and_condition(value):
 
 DelayAction = cg.esphome_ns.class_("DelayAction", Action, cg.Component)
 LambdaAction = cg.esphome_ns.class_("LambdaAction", Action)
+MergedLambdaAction = cg.esphome_ns.class_("MergedLambdaAction", Action)
 IfAction = cg.esphome_ns.class_("IfAction", Action)
 WhileAction = cg.esphome_ns.class_("WhileAction", Action)
 RepeatAction = cg.esphome_ns.class_("RepeatAction", Action)
@@ -317,11 +319,49 @@ async def build_action(full_config, template_arg, args):
     return ret
 
 
+async def build_merged_lambda_action(configs, template_arg, args):
+    """Build consecutive lambda actions as a single MergedLambdaAction.
+
+    Each lambda keeps its own body (an early return only ends that lambda), but the
+    trigger only goes through one action object instead of one per lambda, and the
+    compiler can inline all of them into a single function. Like separate actions,
+    the remaining lambdas are skipped once the action was stopped by one of them.
+    """
+    if len(configs) == 1:
+        return await build_action(configs[0], template_arg, args)
+    action_type = MergedLambdaAction.template(template_arg)
+    parts = []
+    for i, conf in enumerate(configs):
+        if i > 0:
+            parts.append("if (merged_action->is_stopped())\n  return;\n")
+        inner = await cg.process_lambda(
+            conf[CONF_LAMBDA], [], capture="&", return_type=cg.void
+        )
+        parts.extend([inner, "();\n"])
+    lambda_ = cg.LambdaExpression(
+        parts,
+        [(action_type.operator("ptr"), "merged_action")] + list(args),
+        return_type=cg.void,
+    )
+    action_id = configs[0][CONF_TYPE_ID].copy()
+    action_id.type = MergedLambdaAction
+    return cg.new_Pvariable(action_id, template_arg, lambda_)
+
+
 async def build_action_list(config, templ, arg_type):
     actions = []
+    lambdas = []
     for conf in config:
+        if CONF_LAMBDA in conf:
+            lambdas.append(conf)
+            continue
+        if lambdas:
+            actions.append(await build_merged_lambda_action(lambdas, templ, arg_type))
+            lambdas = []
         action = await build_action(conf, templ, arg_type)
         actions.append(action)
+    if lambdas:
+        actions.append(await build_merged_lambda_action(lambdas, templ, arg_type))
     return actions
 
 
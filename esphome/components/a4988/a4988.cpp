@@ -1,11 +1,94 @@
 #include "a4988.h"
+#include <algorithm>
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#ifdef USE_ESP32_FRAMEWORK_ARDUINO
+#include <esp32-hal-timer.h>
+#endif
+
 namespace esphome {
 namespace a4988 {
 
 static const char *const TAG = "a4988.stepper";
 
+#ifdef USE_ESP32_FRAMEWORK_ARDUINO
+// All steppers with a step timer share one hardware timer (timer 0 is used by ac_dimmer)
+static const uint8_t STEP_TIMER_NUM = 1;
+static A4988TimerStore *timer_stores[4];  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static hw_timer_t *step_timer = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t step_timer_interval = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static bool step_timer_running = false;   // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static void IRAM_ATTR HOT step_timer_intr() {
+  for (auto *store : timer_stores) {
+    if (store != nullptr)
+      store->timer_intr();
+  }
+}
+
+/// Run the timer only while a stepper moves.
+static void update_step_timer() {
+  bool moving = false;
+  for (auto *store : timer_stores) {
+    if (store != nullptr && (store->target != store->position || store->step_high))
+      moving = true;
+  }
+  if (moving == step_timer_running)
+    return;
+  if (moving) {
+    timerAlarmEnable(step_timer);
+  } else {
+    timerAlarmDisable(step_timer);
+  }
+  step_timer_running = moving;
+}
+
+void IRAM_ATTR HOT A4988TimerStore::timer_intr() {
+  if (this->step_high) {
+    this->step_pin.digital_write(false);
+    this->step_high = false;
+  }
+
+  int32_t position = this->position;
+  int32_t remaining = this->target - position;
+  if (remaining == 0) {
+    this->speed = 0;
+    this->phase = 0;
+    this->steps_to_stop = 0;
+    return;
+  }
+
+  uint32_t distance = remaining > 0 ? remaining : -remaining;
+  const uint32_t max_speed = this->profile.max_speed;
+  if (distance <= this->steps_to_stop) {
+    // within the stopping distance: slow down, but keep the last bit of speed to reach the target
+    if (this->speed > this->profile.deceleration)
+      this->speed -= this->profile.deceleration;
+  } else if (this->speed >= max_speed) {
+    this->speed = max_speed;
+  } else {
+    this->speed += std::min(this->profile.acceleration, max_speed - this->speed);
+  }
+
+  uint32_t phase = this->phase + this->speed;
+  bool step = phase < this->phase;  // overflow, one step more
+  this->phase = phase;
+  if (!step)
+    return;
+
+  int32_t dir = remaining > 0 ? 1 : -1;
+  if (dir != this->last_dir) {
+    this->dir_pin.digital_write(dir == 1);
+    this->last_dir = dir;
+  }
+  this->step_pin.digital_write(true);
+  this->step_high = true;
+  this->position = position + dir;
+  this->steps_to_stop = this->profile.steps_to_stop(this->speed);
+}
+#endif
+
 void A4988::setup() {
   ESP_LOGCONFIG(TAG, "Setting up A4988...");
   if (this->sleep_pin_ != nullptr) {
@@ -17,15 +100,29 @@ void A4988::setup() {
   this->step_pin_->digital_write(false);
   this->dir_pin_->setup();
   this->dir_pin_->digital_write(false);
+#ifdef USE_ESP32_FRAMEWORK_ARDUINO
+  if (this->step_timer_interval_ != 0)
+    this->setup_step_timer_();
+#endif
 }
 void A4988::dump_config() {
   ESP_LOGCONFIG(TAG, "A4988:");
   LOG_PIN("  Step Pin: ", this->step_pin_);
   LOG_PIN("  Dir Pin: ", this->dir_pin_);
   LOG_PIN("  Sleep Pin: ", this->sleep_pin_);
+#ifdef USE_ESP32_FRAMEWORK_ARDUINO
+  if (this->use_step_timer_)
+    ESP_LOGCONFIG(TAG, "  Step Timer Interval: %uus", this->step_timer_interval_);
+#endif
   LOG_STEPPER(this);
 }
 void A4988::loop() {
+#ifdef USE_ESP32_FRAMEWORK_ARDUINO
+  if (this->use_step_timer_) {
+    this->loop_step_timer_();
+    return;
+  }
+#endif
   bool at_target = this->has_reached_target();
   if (this->sleep_pin_ != nullptr) {
     bool sleep_rising_edge = !sleep_pin_state_ & !at_target;
@@ -51,5 +148,80 @@ void A4988::loop() {
   this->step_pin_->digital_write(false);
 }
 
+#ifdef USE_ESP32_FRAMEWORK_ARDUINO
+void A4988::setup_step_timer_() {
+  if (!this->step_pin_->is_internal() || !this->dir_pin_->is_internal()) {
+    ESP_LOGW(TAG, "The step timer needs internal step and dir pins, stepping from the main loop");
+    return;
+  }
+  A4988TimerStore **slot = nullptr;
+  for (auto &store : timer_stores) {
+    if (store == nullptr) {
+      slot = &store;
+      break;
+    }
+  }
+  if (slot == nullptr) {
+    ESP_LOGW(TAG, "Too many steppers with a step timer, stepping from the main loop");
+    return;
+  }
+
+  if (step_timer == nullptr) {
+    // 80 Divider -> 1 count=1µs
+    step_timer = timerBegin(STEP_TIMER_NUM, 80, true);
+    timerAttachInterrupt(step_timer, &step_timer_intr, true);
+    step_timer_interval = this->step_timer_interval_;
+    timerAlarmWrite(step_timer, step_timer_interval, true);
+  } else if (this->step_timer_interval_ != step_timer_interval) {
+    ESP_LOGW(TAG, "All step timers share one interval, using %uus", step_timer_interval);
+    this->step_timer_interval_ = step_timer_interval;
+  }
+
+  this->store_.step_pin = static_cast<InternalGPIOPin *>(this->step_pin_)->to_isr();
+  this->store_.dir_pin = static_cast<InternalGPIOPin *>(this->dir_pin_)->to_isr();
+  this->store_.position = this->current_position;
+  this->store_.target = this->current_position;
+  this->reported_position_ = this->current_position;
+  *slot = &this->store_;
+  this->use_step_timer_ = true;
+}
+
+void A4988::loop_step_timer_() {
+  if (this->current_position != this->reported_position_) {
+    // Changed with report_position(), continue from there
+    InterruptLock lock;
+    this->store_.position = this->current_position;
+    this->store_.speed = 0;
+    this->store_.phase = 0;
+  } else {
+    this->current_position = this->store_.position;
+  }
+  this->reported_position_ = this->current_position;
+
+  if (this->max_speed_ != this->profile_max_speed_ || this->acceleration_ != this->profile_acceleration_ ||
+      this->deceleration_ != this->profile_deceleration_) {
+    this->profile_max_speed_ = this->max_speed_;
+    this->profile_acceleration_ = this->acceleration_;
+    this->profile_deceleration_ = this->deceleration_;
+    stepper::StepProfile profile = this->compute_step_profile_(this->step_timer_interval_);
+    InterruptLock lock;
+    this->store_.profile = profile;
+  }
+
+  bool at_target = this->has_reached_target();
+  if (this->sleep_pin_ != nullptr) {
+    bool sleep_rising_edge = !sleep_pin_state_ & !at_target;
+    this->sleep_pin_->digital_write(!at_target);
+    this->sleep_pin_state_ = !at_target;
+    if (sleep_rising_edge) {
+      delayMicroseconds(1000);
+    }
+  }
+  // Only now, so the driver is awake before the interrupt steps
+  this->store_.target = this->target_position;
+  update_step_timer();
+}
+#endif
+
 }  // namespace a4988
 }  // namespace esphome
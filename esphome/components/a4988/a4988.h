@@ -7,11 +7,31 @@
 namespace esphome {
 namespace a4988 {
 
+#ifdef USE_ESP32_FRAMEWORK_ARDUINO
+/// State shared with the step timer interrupt, speeds and the phase are in stepper::StepProfile units.
+struct A4988TimerStore {
+  ISRInternalGPIOPin step_pin;
+  ISRInternalGPIOPin dir_pin;
+  stepper::StepProfile profile;
+  volatile int32_t position{0};
+  volatile int32_t target{0};
+  uint32_t speed{0};
+  uint32_t phase{0};
+  uint32_t steps_to_stop{0};
+  int32_t last_dir{0};
+  bool step_high{false};
+
+  void timer_intr();
+};
+#endif
+
 class A4988 : public stepper::Stepper, public Component {
  public:
   void set_step_pin(GPIOPin *step_pin) { step_pin_ = step_pin; }
   void set_dir_pin(GPIOPin *dir_pin) { dir_pin_ = dir_pin; }
   void set_sleep_pin(GPIOPin *sleep_pin) { this->sleep_pin_ = sleep_pin; }
+  /// Generate the steps from a hardware timer interrupt firing every step_timer_interval µs instead of loop().
+  void set_step_timer_interval(uint32_t step_timer_interval) { this->step_timer_interval_ = step_timer_interval; }
   void setup() override;
   void dump_config() override;
   void loop() override;
@@ -23,6 +43,18 @@ class A4988 : public stepper::Stepper, public Component {
   GPIOPin *sleep_pin_{nullptr};
   bool sleep_pin_state_;
   HighFrequencyLoopRequester high_freq_;
+  uint32_t step_timer_interval_{0};
+#ifdef USE_ESP32_FRAMEWORK_ARDUINO
+  void setup_step_timer_();
+  void loop_step_timer_();
+
+  A4988TimerStore store_;
+  bool use_step_timer_{false};
+  float profile_max_speed_{0.0f};
+  float profile_acceleration_{0.0f};
+  float profile_deceleration_{0.0f};
+  int32_t reported_position_{0};
+#endif
 };
 
 }  // namespace a4988
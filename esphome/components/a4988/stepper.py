@@ -3,8 +3,11 @@ from esphome.components import stepper
 import esphome.config_validation as cv
 import esphome.codegen as cg
 from esphome.const import CONF_DIR_PIN, CONF_ID, CONF_SLEEP_PIN, CONF_STEP_PIN
+from esphome.core import TimePeriod
 
 
+CONF_STEP_TIMER_INTERVAL = "step_timer_interval"
+
 a4988_ns = cg.esphome_ns.namespace("a4988")
 A4988 = a4988_ns.class_("A4988", stepper.Stepper, cg.Component)
 
@@ -14,6 +17,12 @@ CONFIG_SCHEMA = stepper.STEPPER_SCHEMA.extend(
         cv.Required(CONF_STEP_PIN): pins.gpio_output_pin_schema,
         cv.Required(CONF_DIR_PIN): pins.gpio_output_pin_schema,
         cv.Optional(CONF_SLEEP_PIN): pins.gpio_output_pin_schema,
+        cv.Optional(CONF_STEP_TIMER_INTERVAL): cv.All(
+            cv.only_on_esp32,
+            cv.only_with_arduino,
+            cv.positive_time_period_microseconds,
+            cv.Range(min=TimePeriod(microseconds=10), max=TimePeriod(milliseconds=1)),
+        ),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -31,3 +40,6 @@ async def to_code(config):
     if CONF_SLEEP_PIN in config:
         sleep_pin = await cg.gpio_pin_expression(config[CONF_SLEEP_PIN])
         cg.add(var.set_sleep_pin(sleep_pin))
+
+    if CONF_STEP_TIMER_INTERVAL in config:
+        cg.add(var.set_step_timer_interval(config[CONF_STEP_TIMER_INTERVAL]))
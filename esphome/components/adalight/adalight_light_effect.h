@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/light/addressable_light_effect.h"
 #include "esphome/components/uart/uart.h"
 
@@ -34,7 +35,7 @@ class AdalightLightEffect : public light::AddressableLightEffect, public uart::U
   uint32_t last_ack_{0};
   uint32_t last_byte_{0};
   uint32_t last_reset_{0};
-  std::vector<uint8_t> frame_;
+  std::vector<uint8_t, RAMAllocator<uint8_t, RAMPolicy::BULK>> frame_;
 };
 
 }  // namespace adalight
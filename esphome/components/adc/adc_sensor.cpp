@@ -110,6 +110,24 @@ float ADCSensor::sample() {
 #endif
 
 #ifdef USE_ESP32
+void ADCSensor::sample_block(float *values, size_t count) {
+  if (this->autorange_) {
+    // every reading switches the attenuation
+    VoltageSampler::sample_block(values, count);
+    return;
+  }
+  const esp_adc_cal_characteristics_t *cal = &this->cal_characteristics_[(int) this->attenuation_];
+  for (size_t i = 0; i < count; i++) {
+    int raw = adc1_get_raw(this->channel_);
+    if (raw == -1) {
+      values[i] = NAN;
+    } else if (this->output_raw_) {
+      values[i] = raw;
+    } else {
+      values[i] = esp_adc_cal_raw_to_voltage(raw, cal) / 1000.0f;
+    }
+  }
+}
 float ADCSensor::sample() {
   if (!autorange_) {
     int raw = adc1_get_raw(channel_);
@@ -33,6 +33,9 @@ class ADCSensor : public sensor::Sensor, public PollingComponent, public voltage
   void set_pin(InternalGPIOPin *pin) { this->pin_ = pin; }
   void set_output_raw(bool output_raw) { output_raw_ = output_raw; }
   float sample() override;
+#ifdef USE_ESP32
+  void sample_block(float *values, size_t count) override;
+#endif
 
 #ifdef USE_ESP8266
   std::string unique_id() override;
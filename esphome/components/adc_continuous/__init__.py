@@ -0,0 +1,73 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import pins
+from esphome.components import voltage_sampler
+from esphome.components.adc.sensor import (
+    ATTENUATION_MODES,
+    ESP32_VARIANT_ADC1_PIN_TO_CHANNEL,
+)
+from esphome.components.esp32 import get_esp32_variant
+from esphome.components.esp32.const import VARIANT_ESP32
+from esphome.const import (
+    CONF_ATTENUATION,
+    CONF_ID,
+    CONF_NUMBER,
+    CONF_PIN,
+)
+
+DEPENDENCIES = ["esp32"]
+AUTO_LOAD = ["sensor", "voltage_sampler"]
+
+CONF_ADC_CONTINUOUS_ID = "adc_continuous_id"
+CONF_SAMPLE_RATE = "sample_rate"
+
+adc_continuous_ns = cg.esphome_ns.namespace("adc_continuous")
+ADCContinuousComponent = adc_continuous_ns.class_(
+    "ADCContinuousComponent", cg.Component, voltage_sampler.VoltageSampler
+)
+
+
+def validate_variant(value):
+    # The built-in ADC mode of I2S only exists on the original ESP32
+    if get_esp32_variant() != VARIANT_ESP32:
+        raise cv.Invalid(f"{get_esp32_variant()} can't sample the ADC with I2S DMA")
+    return value
+
+
+def validate_adc1_pin(value):
+    value = pins.internal_gpio_input_pin_number(value)
+    if value not in ESP32_VARIANT_ADC1_PIN_TO_CHANNEL[VARIANT_ESP32]:
+        raise cv.Invalid("Only ADC1 pins can be sampled continuously")
+    return pins.internal_gpio_input_pin_schema(value)
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(ADCContinuousComponent),
+            cv.Required(CONF_PIN): validate_adc1_pin,
+            cv.Optional(CONF_ATTENUATION, default="0db"): cv.enum(
+                {k: v for k, v in ATTENUATION_MODES.items() if k != "auto"},
+                lower=True,
+            ),
+            cv.Optional(CONF_SAMPLE_RATE, default="20kHz"): cv.All(
+                cv.frequency, cv.int_range(min=1000, max=200000)
+            ),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    validate_variant,
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    pin = await cg.gpio_pin_expression(config[CONF_PIN])
+    cg.add(var.set_pin(pin))
+    channel = ESP32_VARIANT_ADC1_PIN_TO_CHANNEL[VARIANT_ESP32][
+        config[CONF_PIN][CONF_NUMBER]
+    ]
+    cg.add(var.set_channel(channel))
+    cg.add(var.set_attenuation(config[CONF_ATTENUATION]))
+    cg.add(var.set_sample_rate(int(config[CONF_SAMPLE_RATE])))
@@ -0,0 +1,180 @@
+#ifdef USE_ESP32
+
+#include "adc_continuous.h"
+#include "esphome/core/log.h"
+
+#include <driver/i2s.h>
+#include <esp_idf_version.h>
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace adc_continuous {
+
+static const char *const TAG = "adc_continuous";
+
+static const i2s_port_t I2S_PORT = I2S_NUM_0;
+static const int DMA_BUFFER_COUNT = 4;
+static const int DMA_BUFFER_LENGTH = 512;
+/// Samples kept for sample_block()
+static const size_t HISTORY_LENGTH = 512;
+/// Samples read from the DMA buffers at once
+static const size_t READ_BLOCK_SIZE = 128;
+
+void ADCContinuousComponent::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up continuous ADC...");
+  this->pin_->setup();
+
+  i2s_config_t config = {};
+  config.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
+  config.sample_rate = this->sample_rate_;
+  config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+#if ESP_IDF_VERSION_MAJOR >= 4
+  config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+#else
+  config.communication_format = I2S_COMM_FORMAT_I2S;
+#endif
+  config.dma_buf_count = DMA_BUFFER_COUNT;
+  config.dma_buf_len = DMA_BUFFER_LENGTH;
+
+  esp_err_t err = i2s_driver_install(I2S_PORT, &config, 0, nullptr);
+  if (err == ESP_OK)
+    err = i2s_set_adc_mode(ADC_UNIT_1, this->channel_);
+  if (err == ESP_OK)
+    err = adc1_config_channel_atten(this->channel_, this->attenuation_);
+  if (err == ESP_OK)
+    err = i2s_adc_enable(I2S_PORT);
+  if (err != ESP_OK) {
+    this->error_code_ = err;
+    this->mark_failed();
+    return;
+  }
+
+  esp_adc_cal_characterize(ADC_UNIT_1, this->attenuation_, ADC_WIDTH_BIT_12, 1100, &this->cal_characteristics_);
+  this->history_.resize(HISTORY_LENGTH);
+}
+
+void ADCContinuousComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Continuous ADC:");
+  LOG_PIN("  Pin: ", this->pin_);
+  ESP_LOGCONFIG(TAG, "  Sample Rate: %u Hz", this->sample_rate_);
+  if (this->is_failed()) {
+    ESP_LOGE(TAG, "  Setting up I2S ADC failed: %s", esp_err_to_name(this->error_code_));
+  }
+}
+
+void ADCContinuousComponent::loop() { this->read_(); }
+
+void ADCContinuousComponent::read_() {
+  // not set up (yet, or it failed)
+  if (this->history_.empty())
+    return;
+  uint16_t raw[READ_BLOCK_SIZE];
+  size_t bytes_read;
+  while (i2s_read(I2S_PORT, raw, sizeof(raw), &bytes_read, 0) == ESP_OK && bytes_read != 0) {
+    const size_t count = bytes_read / sizeof(uint16_t);
+    for (size_t i = 0; i < count; i++) {
+      // the upper 4 bits are the channel number
+      raw[i] &= 0x0FFF;
+      this->history_[this->history_at_] = raw[i];
+      this->history_at_ = (this->history_at_ + 1) % HISTORY_LENGTH;
+    }
+    this->unread_ = std::min(this->unread_ + count, HISTORY_LENGTH);
+    for (auto *sensor : this->sensors_)
+      sensor->add_samples(raw, count);
+  }
+}
+
+float ADCContinuousComponent::to_voltage(float raw) const {
+  // esp_adc_cal_raw_to_voltage() without the rounding to mV
+  return (raw * this->cal_characteristics_.coeff_a / 65536.0f + this->cal_characteristics_.coeff_b) / 1000.0f;
+}
+
+float ADCContinuousComponent::sample() {
+  if (this->history_.empty())
+    return NAN;
+  this->read_();
+  const size_t newest = (this->history_at_ + HISTORY_LENGTH - 1) % HISTORY_LENGTH;
+  return this->to_voltage(this->history_[newest]);
+}
+
+void ADCContinuousComponent::sample_block(float *values, size_t count) {
+  if (this->history_.empty()) {
+    std::fill(values, values + count, NAN);
+    return;
+  }
+  this->read_();
+  count = std::min(count, HISTORY_LENGTH);
+  const size_t start = (this->history_at_ + HISTORY_LENGTH - count) % HISTORY_LENGTH;
+  // the oldest count - unread_ values were already returned
+  const size_t seen = count > this->unread_ ? count - this->unread_ : 0;
+  for (size_t i = 0; i < count; i++) {
+    values[i] = i < seen ? NAN : this->to_voltage(this->history_[(start + i) % HISTORY_LENGTH]);
+  }
+  this->unread_ = 0;
+}
+
+void ADCContinuousSensor::add_samples(const uint16_t *raw, size_t count) {
+  uint32_t sum = 0;
+  uint64_t squared_sum = 0;
+  uint16_t min = this->min_;
+  uint16_t max = this->max_;
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t value = raw[i];
+    sum += value;
+    squared_sum += value * value;
+    min = std::min<uint16_t>(min, value);
+    max = std::max<uint16_t>(max, value);
+  }
+  this->count_ += count;
+  this->sum_ += sum;
+  this->squared_sum_ += squared_sum;
+  this->min_ = min;
+  this->max_ = max;
+}
+
+void ADCContinuousSensor::update() {
+  if (this->count_ == 0) {
+    this->publish_state(NAN);
+    return;
+  }
+
+  const double mean = double(this->sum_) / this->count_;
+  const double mean_squared = double(this->squared_sum_) / this->count_;
+  float value = NAN;
+  switch (this->statistic_) {
+    case BLOCK_STATISTIC_MEAN:
+      value = this->parent_->to_voltage(mean);
+      break;
+    case BLOCK_STATISTIC_RMS:
+      value = this->parent_->to_voltage(std::sqrt(mean_squared));
+      break;
+    case BLOCK_STATISTIC_AC_RMS:
+      // only the slope of the conversion applies to differences
+      value = this->parent_->to_voltage(std::sqrt(std::max(0.0, mean_squared - mean * mean))) -
+              this->parent_->to_voltage(0);
+      break;
+    case BLOCK_STATISTIC_PEAK_TO_PEAK:
+      value = this->parent_->to_voltage(this->max_ - this->min_) - this->parent_->to_voltage(0);
+      break;
+  }
+  ESP_LOGV(TAG, "'%s': %u samples", this->get_name().c_str(), this->count_);
+  this->publish_state(value);
+
+  this->count_ = 0;
+  this->sum_ = 0;
+  this->squared_sum_ = 0;
+  this->min_ = UINT16_MAX;
+  this->max_ = 0;
+}
+
+void ADCContinuousSensor::dump_config() {
+  LOG_SENSOR("", "Continuous ADC Sensor", this);
+  LOG_UPDATE_INTERVAL(this);
+}
+
+}  // namespace adc_continuous
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,99 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/voltage_sampler/voltage_sampler.h"
+
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+
+#include <vector>
+
+namespace esphome {
+namespace adc_continuous {
+
+enum BlockStatistic {
+  BLOCK_STATISTIC_MEAN,
+  BLOCK_STATISTIC_RMS,
+  /// RMS without the DC part, the level of vibration or audio signals.
+  BLOCK_STATISTIC_AC_RMS,
+  BLOCK_STATISTIC_PEAK_TO_PEAK,
+};
+
+class ADCContinuousComponent;
+
+/// Publishes a statistic of all samples taken since the last update.
+class ADCContinuousSensor : public sensor::Sensor, public PollingComponent {
+ public:
+  ADCContinuousSensor(ADCContinuousComponent *parent, BlockStatistic statistic)
+      : parent_(parent), statistic_(statistic) {}
+
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  /// Add a block of raw ADC readings.
+  void add_samples(const uint16_t *raw, size_t count);
+
+ protected:
+  ADCContinuousComponent *parent_;
+  BlockStatistic statistic_;
+  uint32_t count_{0};
+  uint64_t sum_{0};
+  uint64_t squared_sum_{0};
+  uint16_t min_{UINT16_MAX};
+  uint16_t max_{0};
+};
+
+/** Samples an ADC1 channel continuously with DMA, through the built-in ADC mode of I2S0.
+ *
+ * The I2S DMA buffers are the ring buffer, loop() drains them and passes every block to the statistic sensors. As a
+ * VoltageSampler (for ct_clamp for example), blocks come from the most recent samples.
+ */
+class ADCContinuousComponent : public Component, public voltage_sampler::VoltageSampler {
+ public:
+  void set_pin(InternalGPIOPin *pin) { this->pin_ = pin; }
+  void set_channel(adc1_channel_t channel) { this->channel_ = channel; }
+  void set_attenuation(adc_atten_t attenuation) { this->attenuation_ = attenuation; }
+  void set_sample_rate(uint32_t sample_rate) { this->sample_rate_ = sample_rate; }
+  void add_sensor(ADCContinuousSensor *sensor) { this->sensors_.push_back(sensor); }
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  float sample() override;
+  /// The newest samples, samples that were already returned by an earlier call are NAN.
+  void sample_block(float *values, size_t count) override;
+  float get_sample_rate() const override { return this->sample_rate_; }
+
+  /// Convert a raw reading (or a statistic of them, this is linear) to V.
+  float to_voltage(float raw) const;
+
+ protected:
+  /// Read all samples from the DMA buffers.
+  void read_();
+
+  InternalGPIOPin *pin_;
+  adc1_channel_t channel_{};
+  adc_atten_t attenuation_{ADC_ATTEN_DB_0};
+  uint32_t sample_rate_{20000};
+  esp_adc_cal_characteristics_t cal_characteristics_{};
+  std::vector<ADCContinuousSensor *> sensors_;
+  esp_err_t error_code_{ESP_OK};
+
+  /// The most recent samples for sample_block(), history_at_ is where the next one goes.
+  std::vector<uint16_t> history_;
+  size_t history_at_{0};
+  /// How many samples came in since the last sample_block().
+  size_t unread_{0};
+};
+
+}  // namespace adc_continuous
+}  // namespace esphome
+
+#endif  // USE_ESP32
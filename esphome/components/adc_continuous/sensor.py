@@ -0,0 +1,50 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    CONF_TYPE,
+    DEVICE_CLASS_VOLTAGE,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_VOLT,
+)
+from . import ADCContinuousComponent, CONF_ADC_CONTINUOUS_ID, adc_continuous_ns
+
+DEPENDENCIES = ["adc_continuous"]
+
+ADCContinuousSensor = adc_continuous_ns.class_(
+    "ADCContinuousSensor", sensor.Sensor, cg.PollingComponent
+)
+BlockStatistic = adc_continuous_ns.enum("BlockStatistic")
+
+STATISTICS = {
+    "mean": BlockStatistic.BLOCK_STATISTIC_MEAN,
+    "rms": BlockStatistic.BLOCK_STATISTIC_RMS,
+    "ac_rms": BlockStatistic.BLOCK_STATISTIC_AC_RMS,
+    "peak_to_peak": BlockStatistic.BLOCK_STATISTIC_PEAK_TO_PEAK,
+}
+
+CONFIG_SCHEMA = (
+    sensor.sensor_schema(
+        unit_of_measurement=UNIT_VOLT,
+        accuracy_decimals=3,
+        device_class=DEVICE_CLASS_VOLTAGE,
+        state_class=STATE_CLASS_MEASUREMENT,
+    )
+    .extend(
+        {
+            cv.GenerateID(): cv.declare_id(ADCContinuousSensor),
+            cv.GenerateID(CONF_ADC_CONTINUOUS_ID): cv.use_id(ADCContinuousComponent),
+            cv.Required(CONF_TYPE): cv.enum(STATISTICS, lower=True),
+        }
+    )
+    .extend(cv.polling_component_schema("1s"))
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_ADC_CONTINUOUS_ID])
+    var = cg.new_Pvariable(config[CONF_ID], parent, config[CONF_TYPE])
+    await cg.register_component(var, config)
+    await sensor.register_sensor(var, config)
+    cg.add(parent.add_sensor(var))
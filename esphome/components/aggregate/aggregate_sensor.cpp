@@ -0,0 +1,81 @@
+#include "aggregate_sensor.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace aggregate {
+
+static const char *const TAG = "aggregate";
+
+AggregateResolution::AggregateResolution(uint32_t interval, size_t length)
+    : interval_(interval), buckets_(new AggregateBucket[length]), length_(length) {}
+
+const AggregateBucket &AggregateResolution::get_bucket(size_t i) const {
+  return this->buckets_[(this->head_ + this->length_ - i) % this->length_];
+}
+
+void AggregateResolution::add_value(float value) {
+  if (this->count_ == 0 || value < this->min_)
+    this->min_ = value;
+  if (this->count_ == 0 || value > this->max_)
+    this->max_ = value;
+  this->sum_ += value;
+  this->count_++;
+}
+
+void AggregateResolution::finish_bucket() {
+  AggregateBucket bucket{};
+  bucket.count = std::min<uint32_t>(this->count_, UINT16_MAX);
+  if (this->count_ > UINT16_MAX) {
+    ESP_LOGW(TAG, "%u values in one %ums bucket, its count is stored as %u", this->count_, this->interval_,
+             UINT16_MAX);
+  }
+  if (this->count_ == 0) {
+    bucket.min = bucket.max = bucket.average = NAN;
+  } else {
+    bucket.min = this->min_;
+    bucket.max = this->max_;
+    bucket.average = this->sum_ / this->count_;
+  }
+  this->head_ = (this->head_ + 1) % this->length_;
+  this->buckets_[this->head_] = bucket;
+  if (this->size_ < this->length_)
+    this->size_++;
+
+  const uint32_t count = this->count_;
+  this->sum_ = 0.0;
+  this->count_ = 0;
+
+  if (this->min_sensor_ != nullptr)
+    this->min_sensor_->publish_state(bucket.min);
+  if (this->max_sensor_ != nullptr)
+    this->max_sensor_->publish_state(bucket.max);
+  if (this->average_sensor_ != nullptr)
+    this->average_sensor_->publish_state(bucket.average);
+  if (this->count_sensor_ != nullptr)
+    this->count_sensor_->publish_state(count);
+}
+
+void AggregateComponent::setup() {
+  this->sensor_->add_on_state_callback([this](float value) {
+    if (std::isnan(value))
+      return;
+    for (auto *resolution : this->resolutions_)
+      resolution->add_value(value);
+  });
+  for (auto *resolution : this->resolutions_)
+    this->set_interval(resolution->get_interval(), [resolution]() { resolution->finish_bucket(); });
+}
+
+void AggregateComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Aggregate of '%s':", this->sensor_->get_name().c_str());
+  for (auto *resolution : this->resolutions_) {
+    ESP_LOGCONFIG(TAG, "  Resolution: %ums, %u buckets", resolution->get_interval(),
+                  (unsigned) resolution->get_length());
+  }
+}
+
+}  // namespace aggregate
+}  // namespace esphome
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace aggregate {
+
+/// Statistics of the values received during one bucket interval, min/max/average are NAN if count is 0.
+struct AggregateBucket {
+  float min;
+  float max;
+  float average;
+  /// Saturates at 65535 to keep a bucket at 16 bytes, the count sensor gets the exact number.
+  uint16_t count;
+};
+
+/** One resolution of an aggregate: the bucket currently collecting values and a fixed ring of the last buckets.
+ *
+ * Every finished bucket is also published to the (optional) min/max/average/count sensors.
+ */
+class AggregateResolution {
+ public:
+  AggregateResolution(uint32_t interval, size_t length);
+
+  void set_min_sensor(sensor::Sensor *min_sensor) { this->min_sensor_ = min_sensor; }
+  void set_max_sensor(sensor::Sensor *max_sensor) { this->max_sensor_ = max_sensor; }
+  void set_average_sensor(sensor::Sensor *average_sensor) { this->average_sensor_ = average_sensor; }
+  void set_count_sensor(sensor::Sensor *count_sensor) { this->count_sensor_ = count_sensor; }
+
+  /// Length of a bucket in ms.
+  uint32_t get_interval() const { return this->interval_; }
+  /// Maximum number of finished buckets kept.
+  size_t get_length() const { return this->length_; }
+  /// Number of finished buckets in the history (up to the configured length).
+  size_t size() const { return this->size_; }
+  /// The i-th finished bucket, 0 is the most recent one.
+  const AggregateBucket &get_bucket(size_t i) const;
+
+  // ========== INTERNAL METHODS ==========
+  void add_value(float value);
+  /// Finish the current bucket, store it in the history and publish it.
+  void finish_bucket();
+
+ protected:
+  uint32_t interval_;
+  std::unique_ptr<AggregateBucket[]> buckets_;
+  size_t length_;
+  /// Position of the most recent bucket in buckets_.
+  size_t head_{0};
+  size_t size_{0};
+
+  float min_{NAN};
+  float max_{NAN};
+  double sum_{0.0};
+  uint32_t count_{0};
+
+  sensor::Sensor *min_sensor_{nullptr};
+  sensor::Sensor *max_sensor_{nullptr};
+  sensor::Sensor *average_sensor_{nullptr};
+  sensor::Sensor *count_sensor_{nullptr};
+};
+
+/// Aggregates the values of a sensor into min/max/average/count buckets at several resolutions.
+class AggregateComponent : public Component {
+ public:
+  void set_sensor(sensor::Sensor *sensor) { this->sensor_ = sensor; }
+  void add_resolution(AggregateResolution *resolution) { this->resolutions_.push_back(resolution); }
+  const std::vector<AggregateResolution *> &get_resolutions() const { return this->resolutions_; }
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+ protected:
+  sensor::Sensor *sensor_;
+  std::vector<AggregateResolution *> resolutions_;
+};
+
+}  // namespace aggregate
+}  // namespace esphome
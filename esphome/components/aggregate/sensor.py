@@ -0,0 +1,68 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_COUNT,
+    CONF_ID,
+    CONF_INTERVAL,
+    CONF_LENGTH,
+    CONF_SENSOR,
+    STATE_CLASS_MEASUREMENT,
+)
+
+CONF_AVERAGE = "average"
+CONF_MAX = "max"
+CONF_MIN = "min"
+CONF_RESOLUTIONS = "resolutions"
+
+aggregate_ns = cg.esphome_ns.namespace("aggregate")
+AggregateComponent = aggregate_ns.class_("AggregateComponent", cg.Component)
+AggregateResolution = aggregate_ns.class_("AggregateResolution")
+
+RESOLUTION_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(AggregateResolution),
+        cv.Required(CONF_INTERVAL): cv.positive_not_null_time_period,
+        cv.Optional(CONF_LENGTH, default=60): cv.int_range(min=1, max=1440),
+        cv.Optional(CONF_MIN): sensor.sensor_schema(
+            state_class=STATE_CLASS_MEASUREMENT
+        ),
+        cv.Optional(CONF_MAX): sensor.sensor_schema(
+            state_class=STATE_CLASS_MEASUREMENT
+        ),
+        cv.Optional(CONF_AVERAGE): sensor.sensor_schema(
+            state_class=STATE_CLASS_MEASUREMENT
+        ),
+        cv.Optional(CONF_COUNT): sensor.sensor_schema(
+            accuracy_decimals=0, state_class=STATE_CLASS_MEASUREMENT
+        ),
+    }
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(AggregateComponent),
+        cv.Required(CONF_SENSOR): cv.use_id(sensor.Sensor),
+        cv.Required(CONF_RESOLUTIONS): cv.All(
+            cv.ensure_list(RESOLUTION_SCHEMA), cv.Length(min=1)
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    sens = await cg.get_variable(config[CONF_SENSOR])
+    cg.add(var.set_sensor(sens))
+
+    for conf in config[CONF_RESOLUTIONS]:
+        resolution = cg.new_Pvariable(
+            conf[CONF_ID], conf[CONF_INTERVAL].total_milliseconds, conf[CONF_LENGTH]
+        )
+        for key in (CONF_MIN, CONF_MAX, CONF_AVERAGE, CONF_COUNT):
+            if key in conf:
+                sens = await sensor.new_sensor(conf[key])
+                cg.add(getattr(resolution, f"set_{key}_sensor")(sens))
+        cg.add(var.add_resolution(resolution))
@@ -100,8 +100,8 @@ void AirthingsWavePlus::update() {
   if (this->node_state != esp32_ble_tracker::ClientState::ESTABLISHED) {
     if (!parent()->enabled) {
       ESP_LOGW(TAG, "Reconnecting to device");
+      // Connected by the tracker once the device is seen, when a connection is free
       parent()->set_enabled(true);
-      parent()->connect();
     } else {
       ESP_LOGW(TAG, "Connection in progress");
     }
@@ -45,6 +45,9 @@ SERVICE_ARG_NATIVE_TYPES = {
     "string[]": cg.std_vector.template(cg.std_string),
 }
 CONF_ENCRYPTION = "encryption"
+CONF_BATCH_DELAY = "batch_delay"
+CONF_CACHE_LIST_ENTITIES = "cache_list_entities"
+CONF_MAX_CONNECTIONS = "max_connections"
 
 
 def validate_encryption_key(value):
@@ -69,6 +72,16 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(
             CONF_REBOOT_TIMEOUT, default="15min"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_BATCH_DELAY, default="0ms"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(max=cv.TimePeriod(milliseconds=1000)),
+        ),
+        cv.SplitDefault(
+            CONF_CACHE_LIST_ENTITIES, esp8266=False, esp32=True
+        ): cv.boolean,
+        cv.SplitDefault(CONF_MAX_CONNECTIONS, esp8266=4, esp32=8): cv.int_range(
+            min=1, max=20
+        ),
         cv.Optional(CONF_SERVICES): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(UserServiceTrigger),
@@ -99,6 +112,9 @@ async def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_batch_delay(config[CONF_BATCH_DELAY]))
+    cg.add(var.set_cache_list_entities(config[CONF_CACHE_LIST_ENTITIES]))
+    cg.add(var.set_max_connections(config[CONF_MAX_CONNECTIONS]))
 
     for conf in config.get(CONF_SERVICES, []):
         template_args = []
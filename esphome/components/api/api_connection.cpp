@@ -20,6 +20,28 @@ namespace esphome {
 namespace api {
 
 static const char *const TAG = "api.connection";
+/// Maximum number of state messages queued per connection while its socket is busy.
+static const size_t MAX_PENDING_STATES = 32;
+/// The message id of ExecuteServiceRequest.
+static const uint32_t EXECUTE_SERVICE_REQUEST_TYPE = 42;
+#ifdef USE_ESP32_CAMERA
+static const size_t CAMERA_CHUNK_SIZE = 1024;
+/// Upper bound for the camera data sent per connection in one loop iteration.
+static const uint8_t CAMERA_MAX_CHUNKS_PER_LOOP = 8;
+/// How often the achieved frame rate of a camera stream is logged (in ms).
+static const uint32_t CAMERA_STATS_INTERVAL = 10000;
+#endif
+
+void *APIConnection::operator new(size_t size) {
+  void *slot = global_api_server->acquire_connection_slot(size);
+  if (slot != nullptr)
+    return slot;
+  return ::operator new(size);
+}
+void APIConnection::operator delete(void *ptr) {
+  if (!global_api_server->release_connection_slot(ptr))
+    ::operator delete(ptr);
+}
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(parent, this), list_entities_iterator_(parent, this) {
@@ -64,12 +86,28 @@ void APIConnection::loop() {
     return;
   }
 
-  APIError err = helper_->loop();
+  APIError err;
+  if (this->helper_->is_batching() && millis() - this->batch_start_ >= this->parent_->get_batch_delay()) {
+    err = this->helper_->end_batch();
+    if (err != APIError::OK) {
+      on_fatal_error();
+      ESP_LOGW(TAG, "%s: Sending batch failed: %s errno=%d", client_info_.c_str(), api_error_to_str(err), errno);
+      return;
+    }
+  }
+
+  err = helper_->loop();
   if (err != APIError::OK) {
     on_fatal_error();
     ESP_LOGW(TAG, "%s: Socket operation failed: %s errno=%d", client_info_.c_str(), api_error_to_str(err), errno);
     return;
   }
+  if (!this->pending_states_.empty()) {
+    this->send_pending_states_();
+    if (this->remove_)
+      return;
+  }
+
   ReadPacketBuffer buffer;
   err = helper_->read_packet(&buffer);
   if (err == APIError::WOULD_BLOCK) {
@@ -87,13 +125,17 @@ void APIConnection::loop() {
   } else {
     this->last_traffic_ = millis();
     // read a packet
-    this->read_message(buffer.data_len, buffer.type, &buffer.container[buffer.data_offset]);
+    this->read_message(buffer.data_len, buffer.type, &buffer.frame[buffer.data_offset]);
     if (this->remove_)
       return;
   }
 
   this->list_entities_iterator_.advance();
   this->initial_state_iterator_.advance();
+#ifdef USE_SENSOR
+  if (this->history_request_.active)
+    this->process_sensor_history_();
+#endif
 
   const uint32_t keepalive = 60000;
   const uint32_t now = millis();
@@ -109,25 +151,7 @@ void APIConnection::loop() {
   }
 
 #ifdef USE_ESP32_CAMERA
-  if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
-    uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
-    // fixed32 key = 1;
-    buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
-    // bytes data = 2;
-    buffer.encode_bytes(2, this->image_reader_.peek_data_buffer(), to_send);
-    // bool done = 3;
-    bool done = this->image_reader_.available() == to_send;
-    buffer.encode_bool(3, done);
-    bool success = this->send_buffer(buffer, 44);
-
-    if (success) {
-      this->image_reader_.consume_data(to_send);
-    }
-    if (success && done) {
-      this->image_reader_.return_image();
-    }
-  }
+  this->process_camera_stream_();
 #endif
 
   if (state_subs_at_ != -1) {
@@ -172,9 +196,12 @@ bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary
   resp.key = binary_sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !binary_sensor->has_state();
-  return this->send_binary_sensor_state_response(resp);
+  this->begin_batch_();
+  return this->send_state_message_(resp, 21);
 }
 bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor) {
+  if (auto *cached = this->parent_->get_cached_info(binary_sensor))
+    return this->send_shared_buffer_(*cached, 12);
   ListEntitiesBinarySensorResponse msg;
   msg.object_id = binary_sensor->get_object_id();
   msg.key = binary_sensor->get_object_id_hash();
@@ -185,7 +212,7 @@ bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_
   msg.disabled_by_default = binary_sensor->is_disabled_by_default();
   msg.icon = binary_sensor->get_icon();
   msg.entity_category = static_cast<enums::EntityCategory>(binary_sensor->get_entity_category());
-  return this->send_list_entities_binary_sensor_response(msg);
+  return this->send_info_message_(binary_sensor, msg, 12);
 }
 #endif
 
@@ -203,9 +230,12 @@ bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (traits.get_supports_tilt())
     resp.tilt = cover->tilt;
   resp.current_operation = static_cast<enums::CoverOperation>(cover->current_operation);
-  return this->send_cover_state_response(resp);
+  this->begin_batch_();
+  return this->send_state_message_(resp, 22);
 }
 bool APIConnection::send_cover_info(cover::Cover *cover) {
+  if (auto *cached = this->parent_->get_cached_info(cover))
+    return this->send_shared_buffer_(*cached, 13);
   auto traits = cover->get_traits();
   ListEntitiesCoverResponse msg;
   msg.key = cover->get_object_id_hash();
@@ -219,7 +249,7 @@ bool APIConnection::send_cover_info(cover::Cover *cover) {
   msg.disabled_by_default = cover->is_disabled_by_default();
   msg.icon = cover->get_icon();
   msg.entity_category = static_cast<enums::EntityCategory>(cover->get_entity_category());
-  return this->send_list_entities_cover_response(msg);
+  return this->send_info_message_(cover, msg, 13);
 }
 void APIConnection::cover_command(const CoverCommandRequest &msg) {
   cover::Cover *cover = App.get_cover_by_key(msg.key);
@@ -270,9 +300,12 @@ bool APIConnection::send_fan_state(fan::FanState *fan) {
   }
   if (traits.supports_direction())
     resp.direction = static_cast<enums::FanDirection>(fan->direction);
-  return this->send_fan_state_response(resp);
+  this->begin_batch_();
+  return this->send_state_message_(resp, 23);
 }
 bool APIConnection::send_fan_info(fan::FanState *fan) {
+  if (auto *cached = this->parent_->get_cached_info(fan))
+    return this->send_shared_buffer_(*cached, 14);
   auto traits = fan->get_traits();
   ListEntitiesFanResponse msg;
   msg.key = fan->get_object_id_hash();
@@ -286,7 +319,7 @@ bool APIConnection::send_fan_info(fan::FanState *fan) {
   msg.disabled_by_default = fan->is_disabled_by_default();
   msg.icon = fan->get_icon();
   msg.entity_category = static_cast<enums::EntityCategory>(fan->get_entity_category());
-  return this->send_list_entities_fan_response(msg);
+  return this->send_info_message_(fan, msg, 14);
 }
 void APIConnection::fan_command(const FanCommandRequest &msg) {
   fan::FanState *fan = App.get_fan_by_key(msg.key);
@@ -337,9 +370,12 @@ bool APIConnection::send_light_state(light::LightState *light) {
   resp.warm_white = values.get_warm_white();
   if (light->supports_effects())
     resp.effect = light->get_effect_name();
-  return this->send_light_state_response(resp);
+  this->begin_batch_();
+  return this->send_state_message_(resp, 24);
 }
 bool APIConnection::send_light_info(light::LightState *light) {
+  if (auto *cached = this->parent_->get_cached_info(light))
+    return this->send_shared_buffer_(*cached, 15);
   auto traits = light->get_traits();
   ListEntitiesLightResponse msg;
   msg.key = light->get_object_id_hash();
@@ -371,7 +407,7 @@ bool APIConnection::send_light_info(light::LightState *light) {
     for (auto *effect : light->get_effects())
       msg.effects.push_back(effect->get_name());
   }
-  return this->send_list_entities_light_response(msg);
+  return this->send_info_message_(light, msg, 15);
 }
 void APIConnection::light_command(const LightCommandRequest &msg) {
   light::LightState *light = App.get_light_by_key(msg.key);
@@ -419,9 +455,14 @@ bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
   resp.key = sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !sensor->has_state();
-  return this->send_sensor_state_response(resp);
+  if (!resp.missing_state)
+    resp.age = millis() - sensor->get_state_time();
+  this->begin_batch_();
+  return this->send_state_message_(resp, 25, state);
 }
 bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
+  if (auto *cached = this->parent_->get_cached_info(sensor))
+    return this->send_shared_buffer_(*cached, 16);
   ListEntitiesSensorResponse msg;
   msg.key = sensor->get_object_id_hash();
   msg.object_id = sensor->get_object_id();
@@ -437,7 +478,7 @@ bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
   msg.state_class = static_cast<enums::SensorStateClass>(sensor->get_state_class());
   msg.disabled_by_default = sensor->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(sensor->get_entity_category());
-  return this->send_list_entities_sensor_response(msg);
+  return this->send_info_message_(sensor, msg, 16);
 }
 #endif
 
@@ -449,9 +490,12 @@ bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
   resp.state = state;
-  return this->send_switch_state_response(resp);
+  this->begin_batch_();
+  return this->send_state_message_(resp, 26);
 }
 bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
+  if (auto *cached = this->parent_->get_cached_info(a_switch))
+    return this->send_shared_buffer_(*cached, 17);
   ListEntitiesSwitchResponse msg;
   msg.key = a_switch->get_object_id_hash();
   msg.object_id = a_switch->get_object_id();
@@ -461,7 +505,7 @@ bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
   msg.assumed_state = a_switch->assumed_state();
   msg.disabled_by_default = a_switch->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(a_switch->get_entity_category());
-  return this->send_list_entities_switch_response(msg);
+  return this->send_info_message_(a_switch, msg, 17);
 }
 void APIConnection::switch_command(const SwitchCommandRequest &msg) {
   switch_::Switch *a_switch = App.get_switch_by_key(msg.key);
@@ -484,9 +528,12 @@ bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor,
   resp.key = text_sensor->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !text_sensor->has_state();
-  return this->send_text_sensor_state_response(resp);
+  this->begin_batch_();
+  return this->send_state_message_(resp, 27);
 }
 bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor) {
+  if (auto *cached = this->parent_->get_cached_info(text_sensor))
+    return this->send_shared_buffer_(*cached, 18);
   ListEntitiesTextSensorResponse msg;
   msg.key = text_sensor->get_object_id_hash();
   msg.object_id = text_sensor->get_object_id();
@@ -497,7 +544,7 @@ bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor)
   msg.icon = text_sensor->get_icon();
   msg.disabled_by_default = text_sensor->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(text_sensor->get_entity_category());
-  return this->send_list_entities_text_sensor_response(msg);
+  return this->send_info_message_(text_sensor, msg, 18);
 }
 #endif
 
@@ -531,9 +578,12 @@ bool APIConnection::send_climate_state(climate::Climate *climate) {
     resp.custom_preset = climate->custom_preset.value();
   if (traits.get_supports_swing_modes())
     resp.swing_mode = static_cast<enums::ClimateSwingMode>(climate->swing_mode);
-  return this->send_climate_state_response(resp);
+  this->begin_batch_();
+  return this->send_state_message_(resp, 47);
 }
 bool APIConnection::send_climate_info(climate::Climate *climate) {
+  if (auto *cached = this->parent_->get_cached_info(climate))
+    return this->send_shared_buffer_(*cached, 46);
   auto traits = climate->get_traits();
   ListEntitiesClimateResponse msg;
   msg.key = climate->get_object_id_hash();
@@ -567,7 +617,7 @@ bool APIConnection::send_climate_info(climate::Climate *climate) {
     msg.supported_custom_presets.push_back(custom_preset);
   for (auto swing_mode : traits.get_supported_swing_modes())
     msg.supported_swing_modes.push_back(static_cast<enums::ClimateSwingMode>(swing_mode));
-  return this->send_list_entities_climate_response(msg);
+  return this->send_info_message_(climate, msg, 46);
 }
 void APIConnection::climate_command(const ClimateCommandRequest &msg) {
   climate::Climate *climate = App.get_climate_by_key(msg.key);
@@ -608,9 +658,12 @@ bool APIConnection::send_number_state(number::Number *number, float state) {
   resp.key = number->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !number->has_state();
-  return this->send_number_state_response(resp);
+  this->begin_batch_();
+  return this->send_state_message_(resp, 50, state);
 }
 bool APIConnection::send_number_info(number::Number *number) {
+  if (auto *cached = this->parent_->get_cached_info(number))
+    return this->send_shared_buffer_(*cached, 49);
   ListEntitiesNumberResponse msg;
   msg.key = number->get_object_id_hash();
   msg.object_id = number->get_object_id();
@@ -626,7 +679,7 @@ bool APIConnection::send_number_info(number::Number *number) {
   msg.max_value = number->traits.get_max_value();
   msg.step = number->traits.get_step();
 
-  return this->send_list_entities_number_response(msg);
+  return this->send_info_message_(number, msg, 49);
 }
 void APIConnection::number_command(const NumberCommandRequest &msg) {
   number::Number *number = App.get_number_by_key(msg.key);
@@ -648,9 +701,12 @@ bool APIConnection::send_select_state(select::Select *select, std::string state)
   resp.key = select->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !select->has_state();
-  return this->send_select_state_response(resp);
+  this->begin_batch_();
+  return this->send_state_message_(resp, 53);
 }
 bool APIConnection::send_select_info(select::Select *select) {
+  if (auto *cached = this->parent_->get_cached_info(select))
+    return this->send_shared_buffer_(*cached, 52);
   ListEntitiesSelectResponse msg;
   msg.key = select->get_object_id_hash();
   msg.object_id = select->get_object_id();
@@ -663,7 +719,7 @@ bool APIConnection::send_select_info(select::Select *select) {
   for (const auto &option : select->traits.get_options())
     msg.options.push_back(option);
 
-  return this->send_list_entities_select_response(msg);
+  return this->send_info_message_(select, msg, 52);
 }
 void APIConnection::select_command(const SelectCommandRequest &msg) {
   select::Select *select = App.get_select_by_key(msg.key);
@@ -678,6 +734,8 @@ void APIConnection::select_command(const SelectCommandRequest &msg) {
 
 #ifdef USE_BUTTON
 bool APIConnection::send_button_info(button::Button *button) {
+  if (auto *cached = this->parent_->get_cached_info(button))
+    return this->send_shared_buffer_(*cached, 61);
   ListEntitiesButtonResponse msg;
   msg.key = button->get_object_id_hash();
   msg.object_id = button->get_object_id();
@@ -687,7 +745,7 @@ bool APIConnection::send_button_info(button::Button *button) {
   msg.disabled_by_default = button->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(button->get_entity_category());
   msg.device_class = button->get_device_class();
-  return this->send_list_entities_button_response(msg);
+  return this->send_info_message_(button, msg, 61);
 }
 void APIConnection::button_command(const ButtonCommandRequest &msg) {
   button::Button *button = App.get_button_by_key(msg.key);
@@ -699,6 +757,45 @@ void APIConnection::button_command(const ButtonCommandRequest &msg) {
 #endif
 
 #ifdef USE_ESP32_CAMERA
+void APIConnection::process_camera_stream_() {
+  // Send as many chunks as the socket takes right now. Each connection only writes when its own socket has room,
+  // so a slow client doesn't hold up the others (or the main loop).
+  for (uint8_t i = 0; i < CAMERA_MAX_CHUNKS_PER_LOOP && this->image_reader_.available(); i++) {
+    if (!this->helper_->can_write_without_blocking())
+      break;
+    uint32_t to_send = std::min(CAMERA_CHUNK_SIZE, this->image_reader_.available());
+    // key (5 bytes) + data header (at most 3 bytes) + done (2 bytes)
+    auto buffer = this->create_buffer(10 + to_send);
+    // fixed32 key = 1;
+    buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
+    // bytes data = 2;
+    buffer.encode_bytes(2, this->image_reader_.peek_data_buffer(), to_send);
+    // bool done = 3;
+    bool done = this->image_reader_.available() == to_send;
+    buffer.encode_bool(3, done);
+    if (!this->send_buffer(buffer, 44))
+      break;
+
+    this->image_reader_.consume_data(to_send);
+    if (done) {
+      // Frames that arrived in the meantime were skipped, the next one sent is the next fresh frame
+      this->image_reader_.return_image();
+      this->camera_frames_sent_++;
+      break;
+    }
+  }
+
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - this->camera_stats_start_;
+  if (elapsed >= CAMERA_STATS_INTERVAL) {
+    if (this->camera_frames_sent_ != 0) {
+      ESP_LOGD(TAG, "%s: Camera stream at %.1f fps", this->client_info_.c_str(),
+               this->camera_frames_sent_ * 1000.0f / elapsed);
+    }
+    this->camera_frames_sent_ = 0;
+    this->camera_stats_start_ = now;
+  }
+}
 void APIConnection::send_camera_state(std::shared_ptr<esp32_camera::CameraImage> image) {
   if (!this->state_subscription_)
     return;
@@ -707,6 +804,8 @@ void APIConnection::send_camera_state(std::shared_ptr<esp32_camera::CameraImage>
   this->image_reader_.set_image(std::move(image));
 }
 bool APIConnection::send_camera_info(esp32_camera::ESP32Camera *camera) {
+  if (auto *cached = this->parent_->get_cached_info(camera))
+    return this->send_shared_buffer_(*cached, 43);
   ListEntitiesCameraResponse msg;
   msg.key = camera->get_object_id_hash();
   msg.object_id = camera->get_object_id();
@@ -715,7 +814,7 @@ bool APIConnection::send_camera_info(esp32_camera::ESP32Camera *camera) {
   msg.disabled_by_default = camera->is_disabled_by_default();
   msg.icon = camera->get_icon();
   msg.entity_category = static_cast<enums::EntityCategory>(camera->get_entity_category());
-  return this->send_list_entities_camera_response(msg);
+  return this->send_info_message_(camera, msg, 43);
 }
 void APIConnection::camera_image(const CameraImageRequest &msg) {
   if (esp32_camera::global_esp32_camera == nullptr)
@@ -735,16 +834,35 @@ void APIConnection::on_get_time_response(const GetTimeResponse &value) {
 }
 #endif
 
+bool APIConnection::is_busy() {
+  if (!this->is_authenticated())
+    return false;
+  if (!this->helper_->can_write_without_blocking() || this->has_ready_pending_states_())
+    return true;
+  if (this->log_subscription_ != ESPHOME_LOG_LEVEL_NONE)
+    return true;
+#ifdef USE_ESP32_CAMERA
+  if (this->image_reader_.available())
+    return true;
+#endif
+  return false;
+}
+
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
   if (this->log_subscription_ < level)
     return false;
+  // queued states have priority over logs
+  if (this->has_ready_pending_states_())
+    return false;
 
   // Send raw so that we don't copy too much
-  auto buffer = this->create_buffer();
+  size_t line_length = strlen(line);
+  // level (2 bytes) + message header (at most 4 bytes)
+  auto buffer = this->create_buffer(6 + line_length);
   // LogLevel level = 1;
   buffer.encode_uint32(1, static_cast<uint32_t>(level));
   // string message = 3;
-  buffer.encode_string(3, line, strlen(line));
+  buffer.encode_string(3, line, line_length);
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
@@ -756,7 +874,7 @@ HelloResponse APIConnection::hello(const HelloRequest &msg) {
 
   HelloResponse resp;
   resp.api_version_major = 1;
-  resp.api_version_minor = 6;
+  resp.api_version_minor = 11;
   resp.server_info = App.get_name() + " (esphome v" ESPHOME_VERSION ")";
   this->connection_state_ = ConnectionState::CONNECTED;
   return resp;
@@ -800,15 +918,19 @@ DeviceInfoResponse APIConnection::device_info(const DeviceInfoRequest &msg) {
   return resp;
 }
 void APIConnection::on_home_assistant_state_response(const HomeAssistantStateResponse &msg) {
-  for (auto &it : this->parent_->get_state_subs())
-    if (it.entity_id == msg.entity_id && it.attribute.value() == msg.attribute) {
-      it.callback(msg.state);
-    }
+  this->parent_->on_home_assistant_state(msg.entity_id, msg.attribute, msg.state);
 }
 void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
+  // requests are normally executed straight from the receive buffer, see read_message()
+  std::vector<uint8_t> encoded;
+  msg.encode({&encoded});
+  this->execute_service_(encoded.data(), encoded.size());
+}
+void APIConnection::execute_service_(const uint8_t *data, size_t len) {
+  uint32_t key = decode_execute_service_key(data, len);
   bool found = false;
   for (auto *service : this->parent_->get_user_services()) {
-    if (service->execute_service(msg)) {
+    if (service->execute_service(key, data, len)) {
       found = true;
     }
   }
@@ -816,6 +938,22 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
     ESP_LOGV(TAG, "Could not find matching service!");
   }
 }
+bool APIConnection::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
+  if (msg_type != EXECUTE_SERVICE_REQUEST_TYPE)
+    return APIServerConnection::read_message(msg_size, msg_type, msg_data);
+  // the arguments are decoded by the service into its own storage, instead of into an ExecuteServiceRequest with a
+  // vector and strings for every argument
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return true;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return true;
+  }
+  this->execute_service_(msg_data, msg_size);
+  return true;
+}
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
@@ -840,7 +978,7 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  APIError err = this->helper_->write_protobuf_packet(message_type, buffer);
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
@@ -855,6 +993,191 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
   this->last_traffic_ = millis();
   return true;
 }
+void APIConnection::subscribe_states_filtered(const SubscribeStatesFilteredRequest &msg) {
+  this->state_filters_.clear();
+  this->state_filters_.reserve(msg.filters.size());
+  for (auto &filter : msg.filters) {
+    this->state_filters_.push_back(StateFilterEntry{filter.key, filter.min_interval, filter.deadband, NAN, 0});
+  }
+  this->state_subscription_ = true;
+  this->initial_state_iterator_.begin();
+}
+void APIConnection::batch_command(const BatchCommandRequest &msg) {
+  // The states the commands publish are collected and sent together once all of them are applied
+  StateBatch batch;
+#ifdef USE_LIGHT
+  for (auto &light : msg.lights)
+    this->light_command(light);
+#endif
+#ifdef USE_SWITCH
+  for (auto &a_switch : msg.switches)
+    this->switch_command(a_switch);
+#endif
+}
+void APIConnection::sensor_history(const SensorHistoryRequest &msg) {
+#ifdef USE_SENSOR
+  // a new request replaces one that is still being sent
+  this->history_request_ = HistoryRequest{};
+  this->history_request_.active = true;
+  this->history_request_.max_age = msg.max_age;
+#endif
+}
+#ifdef USE_SENSOR
+void APIConnection::process_sensor_history_() {
+  static const size_t MAX_STATES_PER_MESSAGE = 64;
+  auto &request = this->history_request_;
+  const auto &sensors = App.get_sensors();
+  while (request.sensor < sensors.size()) {
+    auto *sensor = sensors[request.sensor];
+    auto *history = sensor->get_history();
+    if (history == nullptr) {
+      request.sensor++;
+      continue;
+    }
+    // states are tracked by their number, so states added in between don't shift the position
+    const uint32_t added = history->get_added();
+    const uint32_t oldest = added - history->size();
+    if (!request.started) {
+      request.next = oldest;
+      request.started = true;
+    } else if (int32_t(request.next - oldest) < 0) {
+      ESP_LOGW(TAG, "%s: %u states of %s were overwritten before they were sent", this->client_info_.c_str(),
+               oldest - request.next, sensor->get_name().c_str());
+      request.next = oldest;
+    }
+
+    SensorHistoryResponse resp{};
+    resp.key = sensor->get_object_id_hash();
+    const uint32_t now = millis();
+    uint32_t next = request.next;
+    for (; next != added && resp.ages.size() < MAX_STATES_PER_MESSAGE; next++) {
+      const uint32_t age = now - history->get_time(next - oldest);
+      if (request.max_age != 0 && age > request.max_age)
+        continue;
+      resp.ages.push_back(age);
+      resp.states.push_back(history->get_state(next - oldest));
+    }
+    if (!resp.ages.empty() && !this->send_sensor_history_response(resp)) {
+      // the send buffer is full, the same states are tried again in the next loop()
+      ESP_LOGV(TAG, "%s: Sending the history of %s postponed", this->client_info_.c_str(), sensor->get_name().c_str());
+      return;
+    }
+    request.next = next;
+    if (next == added) {
+      request.sensor++;
+      request.started = false;
+    }
+    // one message per loop(), so a long history doesn't hold up the other connections
+    if (!resp.ages.empty())
+      return;
+  }
+  request.active = false;
+}
+#endif
+bool APIConnection::apply_state_filter_(uint32_t key, float value, uint32_t *send_after) {
+  for (auto &filter : this->state_filters_) {
+    if (filter.key != key)
+      continue;
+    // a deadband of 0 disables it, repeated values are still sent
+    if (filter.deadband > 0 && !std::isnan(value) && !std::isnan(filter.last_value) &&
+        std::fabs(value - filter.last_value) <= filter.deadband)
+      return false;
+    filter.last_value = value;
+    if (filter.min_interval == 0)
+      return true;
+
+    const uint32_t now = millis();
+    if (static_cast<int32_t>(now - filter.last_send) < 0) {
+      // the previous state is still waiting, this one replaces it
+      *send_after = filter.last_send;
+      return true;
+    }
+    uint32_t earliest = filter.last_send + filter.min_interval;
+    if (filter.last_send != 0 && static_cast<int32_t>(now - earliest) < 0) {
+      *send_after = earliest;
+      filter.last_send = earliest;
+    } else {
+      filter.last_send = now;
+    }
+    return true;
+  }
+  // not subscribed to this entity
+  return false;
+}
+bool APIConnection::send_state_buffer_(std::vector<uint8_t> &data, uint32_t message_type, uint32_t key,
+                                       uint32_t send_after) {
+  if (this->remove_)
+    return false;
+  for (auto &pending : this->pending_states_) {
+    if (pending.message_type == message_type && pending.key == key) {
+      // only the latest state matters
+      pending.data.assign(data.begin(), data.end());
+      pending.send_after = send_after;
+      return true;
+    }
+  }
+  if (send_after == 0 && !this->has_ready_pending_states_() && this->helper_->can_write_without_blocking())
+    return this->send_shared_buffer_(data, message_type);
+  if (this->pending_states_.size() >= MAX_PENDING_STATES) {
+    ESP_LOGV(TAG, "%s: State queue full, dropping state", this->client_info_.c_str());
+    return false;
+  }
+  this->pending_states_.push_back(PendingState{message_type, key, send_after, data});
+  return true;
+}
+bool APIConnection::has_ready_pending_states_() {
+  for (auto &pending : this->pending_states_) {
+    if (pending.send_after == 0)
+      return true;
+  }
+  return false;
+}
+void APIConnection::send_pending_states_() {
+  const uint32_t now = millis();
+  auto it = this->pending_states_.begin();
+  while (it != this->pending_states_.end() && this->helper_->can_write_without_blocking()) {
+    if (it->send_after != 0 && static_cast<int32_t>(now - it->send_after) < 0) {
+      ++it;
+      continue;
+    }
+    if (!this->send_buffer(ProtoWriteBuffer{&it->data}, it->message_type))
+      break;
+    it = this->pending_states_.erase(it);
+  }
+}
+bool APIConnection::send_shared_buffer_(std::vector<uint8_t> &shared, uint32_t message_type) {
+  if (!this->helper_->modifies_buffer() || &shared == &this->proto_write_buffer_)
+    return this->send_buffer(ProtoWriteBuffer{&shared}, message_type);
+  // The frame is built in place (e.g. encrypted), so each connection needs its own copy of the encoded message
+  this->proto_write_buffer_.assign(shared.begin(), shared.end());
+  return this->send_buffer(ProtoWriteBuffer{&this->proto_write_buffer_}, message_type);
+}
+void APIConnection::begin_batch_() {
+  if (this->parent_->get_batch_delay() == 0 || this->helper_->is_batching())
+    return;
+  if (this->helper_->begin_batch())
+    this->batch_start_ = millis();
+}
+void APIConnection::begin_state_batch() {
+  if (!this->state_subscription_)
+    return;
+  if (!this->helper_->is_batching() && this->helper_->begin_batch())
+    this->batch_start_ = millis();
+  this->state_batch_ = this->helper_->is_batching();
+}
+void APIConnection::end_state_batch() {
+  if (!this->state_batch_)
+    return;
+  this->state_batch_ = false;
+  // With a batch delay loop() sends it, so states of other components can still join
+  if (this->parent_->get_batch_delay() != 0 || !this->helper_->is_batching())
+    return;
+  APIError err = this->helper_->end_batch();
+  if (err != APIError::OK) {
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Sending batch failed: %s errno=%d", client_info_.c_str(), api_error_to_str(err), errno);
+  }
+}
 void APIConnection::on_unauthenticated_access() {
   this->on_fatal_error();
   ESP_LOGD(TAG, "%s: tried to access without authentication.", this->client_info_.c_str());
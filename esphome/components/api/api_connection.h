@@ -7,6 +7,8 @@
 #include "api_server.h"
 #include "api_frame_helper.h"
 
+#include <cmath>
+
 namespace esphome {
 namespace api {
 
@@ -15,6 +17,10 @@ class APIConnection : public APIServerConnection {
   APIConnection(std::unique_ptr<socket::Socket> socket, APIServer *parent);
   virtual ~APIConnection() = default;
 
+  // Connections live in the server's pre-allocated slots when one is free, so reconnects reuse the same memory.
+  static void *operator new(size_t size);
+  static void operator delete(void *ptr);
+
   void start();
   void loop();
 
@@ -74,6 +80,9 @@ class APIConnection : public APIServerConnection {
   bool send_select_info(select::Select *select);
   void select_command(const SelectCommandRequest &msg) override;
 #endif
+  /// Collect the state messages of a StateBatch and send them together at end_state_batch().
+  void begin_state_batch();
+  void end_state_batch();
 #ifdef USE_BUTTON
   bool send_button_info(button::Button *button);
   void button_command(const ButtonCommandRequest &msg) override;
@@ -84,6 +93,16 @@ class APIConnection : public APIServerConnection {
       return;
     this->send_homeassistant_service_response(call);
   }
+#ifdef USE_BLUETOOTH_PROXY
+  bool send_bluetooth_le_advertisements(const BluetoothLERawAdvertisementsResponse &msg) {
+    if (!this->bluetooth_le_advertisement_subscription_)
+      return false;
+    return this->send_bluetooth_le_raw_advertisements_response(msg);
+  }
+  bool is_bluetooth_le_advertisement_subscribed() const { return this->bluetooth_le_advertisement_subscription_; }
+#endif
+  /// Whether this connection is currently moving a lot of data (camera images, logs or a send backlog).
+  bool is_busy();
 #ifdef USE_HOMEASSISTANT_TIME
   void send_time_request() {
     GetTimeRequest req;
@@ -107,9 +126,12 @@ class APIConnection : public APIServerConnection {
   DeviceInfoResponse device_info(const DeviceInfoRequest &msg) override;
   void list_entities(const ListEntitiesRequest &msg) override { this->list_entities_iterator_.begin(); }
   void subscribe_states(const SubscribeStatesRequest &msg) override {
+    this->state_filters_.clear();
     this->state_subscription_ = true;
     this->initial_state_iterator_.begin();
   }
+  void subscribe_states_filtered(const SubscribeStatesFilteredRequest &msg) override;
+  void sensor_history(const SensorHistoryRequest &msg) override;
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
     if (msg.dump_config)
@@ -119,11 +141,17 @@ class APIConnection : public APIServerConnection {
     this->service_call_subscription_ = true;
   }
   void subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) override;
+#ifdef USE_BLUETOOTH_PROXY
+  void subscribe_bluetooth_le_advertisements(const SubscribeBluetoothLEAdvertisementsRequest &msg) override {
+    this->bluetooth_le_advertisement_subscription_ = true;
+  }
+#endif
   GetTimeResponse get_time(const GetTimeRequest &msg) override {
     // TODO
     return {};
   }
   void execute_service(const ExecuteServiceRequest &msg) override;
+  void batch_command(const BatchCommandRequest &msg) override;
   bool is_authenticated() override { return this->connection_state_ == ConnectionState::AUTHENTICATED; }
   bool is_connection_setup() override {
     return this->connection_state_ == ConnectionState ::CONNECTED || this->is_authenticated();
@@ -131,9 +159,13 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size) override {
     // FIXME: ensure no recursive writes can happen
     this->proto_write_buffer_.clear();
+    this->proto_write_buffer_.reserve(this->helper_->frame_header_padding() + reserve_size +
+                                      this->helper_->frame_footer_size());
+    // Reserve space for the frame header, so the frame helper can send the message without copying it
+    this->proto_write_buffer_.resize(this->helper_->frame_header_padding());
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
@@ -142,6 +174,75 @@ class APIConnection : public APIServerConnection {
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
+  bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
+  /// Execute the user service of an encoded ExecuteServiceRequest.
+  void execute_service_(const uint8_t *data, size_t len);
+#ifdef USE_ESP32_CAMERA
+  /// Send the next chunks of the current camera image, called from loop().
+  void process_camera_stream_();
+#endif
+#ifdef USE_SENSOR
+  /// Send the next message of the current sensor_history request, called from loop().
+  void process_sensor_history_();
+#endif
+  /** Send a state message, encoding it only once if it is being sent to all connections.
+   *
+   * While the server fans out a state update the first connection encodes the message into the shared buffer and
+   * all following connections send that buffer as is.
+   */
+  template<class C> bool send_state_message_(const C &msg, uint32_t message_type, float value = NAN) {
+    uint32_t send_after = 0;
+    if (!this->state_filters_.empty() && !this->apply_state_filter_(msg.key, value, &send_after))
+      return true;
+#ifdef HAS_PROTO_MESSAGE_DUMP
+    ESP_LOGVV("api.connection", "send_state_message: %s", msg.dump().c_str());
+#endif
+    SharedStateBuffer *shared = this->parent_->get_shared_state_buffer();
+    if (shared == nullptr) {
+      auto buffer = this->create_buffer(msg.calculate_size());
+      msg.encode(buffer);
+      return this->send_state_buffer_(*buffer.get_buffer(), message_type, msg.key, send_after);
+    }
+    if (!shared->encoded) {
+      shared->data.clear();
+      shared->data.reserve(this->helper_->frame_header_padding() + msg.calculate_size() +
+                           this->helper_->frame_footer_size());
+      shared->data.resize(this->helper_->frame_header_padding());
+      ProtoWriteBuffer buffer{&shared->data};
+      msg.encode(buffer);
+      shared->encoded = true;
+    }
+    return this->send_state_buffer_(shared->data, message_type, msg.key, send_after);
+  }
+  /** Check a state against the client's filter for this entity.
+   *
+   * Returns false if the state should not be sent, otherwise send_after is set to the time the state may be sent
+   * at (0 if it can be sent right away).
+   */
+  bool apply_state_filter_(uint32_t key, float value, uint32_t *send_after);
+  /// Send an encoded state message, or queue it if it has to wait (for the socket or a filter's min_interval).
+  bool send_state_buffer_(std::vector<uint8_t> &data, uint32_t message_type, uint32_t key, uint32_t send_after);
+  /// Send as many queued state messages as the socket accepts.
+  void send_pending_states_();
+  /// Whether there are queued states that are only waiting for the socket.
+  bool has_ready_pending_states_();
+  /// Send a ListEntities response, and keep the encoded message in the server's cache if that is enabled.
+  template<class C> bool send_info_message_(const EntityBase *entity, const C &msg, uint32_t message_type) {
+    std::vector<uint8_t> *cached = this->parent_->add_cached_info(entity);
+    if (cached == nullptr)
+      return this->send_message_<C>(msg, message_type);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+    ESP_LOGVV("api.connection", "send_info_message: %s", msg.dump().c_str());
+#endif
+    cached->resize(this->helper_->frame_header_padding());
+    ProtoWriteBuffer buffer{cached};
+    msg.encode(buffer);
+    cached->shrink_to_fit();
+    return this->send_shared_buffer_(*cached, message_type);
+  }
+  bool send_shared_buffer_(std::vector<uint8_t> &shared, uint32_t message_type);
+  /// Start batching outgoing messages if enabled, the batch is sent from loop() once the batch delay has passed.
+  void begin_batch_();
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -154,18 +255,57 @@ class APIConnection : public APIServerConnection {
   // Buffer used to encode proto messages
   // Re-use to prevent allocations
   std::vector<uint8_t> proto_write_buffer_;
+  struct PendingState {
+    uint32_t message_type;
+    uint32_t key;
+    /// Don't send before this time, 0 to send as soon as the socket allows it.
+    uint32_t send_after;
+    std::vector<uint8_t> data;
+  };
+  /// State messages that couldn't be sent yet, at most one per entity (newer states replace older ones).
+  std::vector<PendingState> pending_states_;
+  struct StateFilterEntry {
+    uint32_t key;
+    uint32_t min_interval;
+    float deadband;
+    float last_value;
+    /// Time the last accepted state is (or was) sent at.
+    uint32_t last_send;
+  };
+  /// Entities the client subscribed to with SubscribeStatesFilteredRequest, empty if it wants all states.
+  std::vector<StateFilterEntry> state_filters_;
   std::unique_ptr<APIFrameHelper> helper_;
 
   std::string client_info_;
+#ifdef USE_SENSOR
+  /// Position in the sensor_history request that is being sent, one message per loop().
+  struct HistoryRequest {
+    bool active{false};
+    /// Whether next is set for the current sensor.
+    bool started{false};
+    uint32_t max_age{0};
+    /// Index of the sensor in App.get_sensors().
+    size_t sensor{0};
+    /// Number (SensorHistory::get_added()) of the next state of that sensor to send.
+    uint32_t next{0};
+  } history_request_;
+#endif
 #ifdef USE_ESP32_CAMERA
   esp32_camera::CameraImageReader image_reader_;
+  uint16_t camera_frames_sent_{0};
+  uint32_t camera_stats_start_{0};
 #endif
 
   bool state_subscription_{false};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
   uint32_t last_traffic_;
+  uint32_t batch_start_{0};
+  bool state_batch_{false};
   bool sent_ping_{false};
   bool service_call_subscription_{false};
+#ifdef USE_BLUETOOTH_PROXY
+  bool bluetooth_le_advertisement_subscription_{false};
+#endif
   bool next_close_ = false;
   APIServer *parent_;
   InitialStateIterator initial_state_iterator_;
@@ -10,6 +10,9 @@ namespace api {
 
 static const char *const TAG = "api.socket";
 
+/// Maximum number of bytes collected in a batch before it is sent, about one TCP segment.
+static const size_t BATCH_MAX_SIZE = 1436;
+
 /// Is the given return value (from write syscalls) a wouldblock error?
 bool is_would_block(ssize_t ret) {
   if (ret == -1) {
@@ -150,7 +153,7 @@ APIError APINoiseFrameHelper::loop() {
     return APIError::OK;
   if (err != APIError::OK)
     return err;
-  if (!tx_buf_.empty()) {
+  if (!tx_buf_.empty() && !batching_) {
     err = try_send_tx_buf_();
     if (err != APIError::OK) {
       return err;
@@ -178,6 +181,22 @@ APIError APINoiseFrameHelper::try_read_frame_(ParsedFrame *frame) {
     HELPER_LOG("Bad argument for try_read_frame_");
     return APIError::BAD_ARG;
   }
+  consume_frame_();
+
+  if (state_ == State::DATA && rx_header_buf_len_ == 0) {
+    // a frame that was received in one piece is decrypted right in the socket's receive buffer
+    uint8_t *data;
+    ssize_t available = socket_->peek(&data);
+    if (available >= 3 && data[0] == 0x01) {
+      uint16_t msg_size = (((uint16_t) data[1]) << 8) | data[2];
+      if ((size_t) available >= 3u + msg_size) {
+        frame->data = data + 3;
+        frame->size = msg_size;
+        rx_consume_len_ = 3u + msg_size;
+        return APIError::OK;
+      }
+    }
+  }
 
   // read header
   if (rx_header_buf_len_ < 3) {
@@ -255,6 +274,8 @@ APIError APINoiseFrameHelper::try_read_frame_(ParsedFrame *frame) {
   ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_).c_str());
 #endif
   frame->msg = std::move(rx_buf_);
+  frame->data = frame->msg.data();
+  frame->size = frame->msg.size();
   // consume msg
   rx_buf_ = {};
   rx_buf_len_ = 0;
@@ -262,6 +283,14 @@ APIError APINoiseFrameHelper::try_read_frame_(ParsedFrame *frame) {
   return APIError::OK;
 }
 
+/// Release the frame that try_read_frame_() handed out from the socket's receive buffer.
+void APINoiseFrameHelper::consume_frame_() {
+  if (rx_consume_len_ == 0)
+    return;
+  socket_->consume(rx_consume_len_);
+  rx_consume_len_ = 0;
+}
+
 /** To be called from read/write methods.
  *
  * This method runs through the internal handshake methods, if in that state.
@@ -423,7 +452,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, frame.msg.data(), frame.msg.size(), frame.msg.size());
+  noise_buffer_set_inout(mbuf, frame.data, frame.size, frame.size);
   err = noise_cipherstate_decrypt(recv_cipher_, &mbuf);
   if (err != 0) {
     state_ = State::FAILED;
@@ -432,7 +461,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   }
 
   size_t msg_size = mbuf.size;
-  uint8_t *msg_data = frame.msg.data();
+  uint8_t *msg_data = frame.data;
   if (msg_size < 4) {
     state_ = State::FAILED;
     HELPER_LOG("Bad data packet: size %d too short", msg_size);
@@ -452,13 +481,28 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   }
 
   buffer->container = std::move(frame.msg);
+  buffer->frame = frame.data;
   buffer->data_offset = 4;
   buffer->data_len = data_len;
   buffer->type = type;
   return APIError::OK;
 }
-bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+bool APINoiseFrameHelper::can_write_without_blocking() {
+  return state_ == State::DATA && (tx_buf_.empty() || batching_);
+}
+bool APINoiseFrameHelper::begin_batch() {
+  if (!tx_buf_.empty())
+    return false;
+  batching_ = true;
+  return true;
+}
+APIError APINoiseFrameHelper::end_batch() {
+  batching_ = false;
+  if (tx_buf_.empty())
+    return APIError::OK;
+  return try_send_tx_buf_();
+}
+APIError APINoiseFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -470,31 +514,37 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  // the message was encoded after the space reserved for the headers
+  if (raw_buffer->size() < FRAME_HEADER_PADDING)
+    return APIError::BAD_ARG;
+  size_t payload_len = raw_buffer->size() - FRAME_HEADER_PADDING;
+  // the data length field has 16 bits
+  if (payload_len > 0xFFFF) {
+    HELPER_LOG("Packet too large to send");
+    return APIError::BAD_ARG;
+  }
   size_t padding = 0;
   size_t msg_len = 4 + payload_len + padding;
   size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
-  }
+  // make room for padding and MAC, the buffer keeps its capacity between messages so this usually doesn't allocate
+  raw_buffer->resize(frame_len);
+  uint8_t *buf = raw_buffer->data();
 
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
+  buf[0] = 0x01;  // indicator
+  // buf[1], buf[2] to be set later
   const uint8_t msg_offset = 3;
   const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t)(type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t)(payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
+  buf[msg_offset + 0] = (uint8_t)(type >> 8);  // type
+  buf[msg_offset + 1] = (uint8_t) type;
+  buf[msg_offset + 2] = (uint8_t)(payload_len >> 8);  // data_len
+  buf[msg_offset + 3] = (uint8_t) payload_len;
   // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  std::fill(&buf[payload_offset + payload_len], &buf[frame_len], 0);
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
+  noise_buffer_set_inout(mbuf, &buf[msg_offset], msg_len, frame_len - msg_offset);
   err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
   if (err != 0) {
     state_ = State::FAILED;
@@ -503,11 +553,11 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   }
 
   size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t)(mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
+  buf[1] = (uint8_t)(mbuf.size >> 8);
+  buf[2] = (uint8_t) mbuf.size;
 
   struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
+  iov.iov_base = buf;
   iov.iov_len = total_len;
 
   // write raw to not have two packets sent if NAGLE disabled
@@ -552,6 +602,18 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
     total_write_len += iov[i].iov_len;
   }
 
+  if (batching_) {
+    if (tx_buf_.size() + total_write_len <= BATCH_MAX_SIZE) {
+      for (int i = 0; i < iovcnt; i++) {
+        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
+                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      }
+      return APIError::OK;
+    }
+    // batch is full, send what was collected so far
+    batching_ = false;
+  }
+
   if (!tx_buf_.empty()) {
     // try to empty tx_buf_ first
     aerr = try_send_tx_buf_();
@@ -756,7 +818,7 @@ APIError APIPlaintextFrameHelper::loop() {
     return APIError::BAD_STATE;
   }
   // try send pending TX data
-  if (!tx_buf_.empty()) {
+  if (!tx_buf_.empty() && !batching_) {
     APIError err = try_send_tx_buf_();
     if (err != APIError::OK) {
       return err;
@@ -779,6 +841,32 @@ APIError APIPlaintextFrameHelper::try_read_frame_(ParsedFrame *frame) {
     HELPER_LOG("Bad argument for try_read_frame_");
     return APIError::BAD_ARG;
   }
+  consume_frame_();
+
+  if (!rx_header_parsed_ && rx_header_buf_.empty()) {
+    // a frame that was received in one piece is used right from the socket's receive buffer
+    uint8_t *data;
+    ssize_t available = socket_->peek(&data);
+    if (available > 1 && data[0] == 0x00) {
+      size_t i = 1;
+      uint32_t consumed = 0;
+      auto msg_size_varint = ProtoVarInt::parse(&data[i], available - i, &consumed);
+      if (msg_size_varint.has_value()) {
+        i += consumed;
+        auto msg_type_varint = ProtoVarInt::parse(&data[i], available - i, &consumed);
+        uint32_t msg_size = msg_size_varint->as_uint32();
+        if (msg_type_varint.has_value() && (size_t) available - i - consumed >= msg_size) {
+          i += consumed;
+          rx_header_parsed_len_ = msg_size;
+          rx_header_parsed_type_ = msg_type_varint->as_uint32();
+          frame->data = data + i;
+          frame->size = msg_size;
+          rx_consume_len_ = i + msg_size;
+          return APIError::OK;
+        }
+      }
+    }
+  }
 
   // read header
   while (!rx_header_parsed_) {
@@ -859,6 +947,8 @@ APIError APIPlaintextFrameHelper::try_read_frame_(ParsedFrame *frame) {
   ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_).c_str());
 #endif
   frame->msg = std::move(rx_buf_);
+  frame->data = frame->msg.data();
+  frame->size = frame->msg.size();
   // consume msg
   rx_buf_ = {};
   rx_buf_len_ = 0;
@@ -867,6 +957,14 @@ APIError APIPlaintextFrameHelper::try_read_frame_(ParsedFrame *frame) {
   return APIError::OK;
 }
 
+/// Release the frame that try_read_frame_() handed out from the socket's receive buffer.
+void APIPlaintextFrameHelper::consume_frame_() {
+  if (rx_consume_len_ == 0)
+    return;
+  socket_->consume(rx_consume_len_);
+  rx_consume_len_ = 0;
+}
+
 APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   APIError aerr;
 
@@ -880,29 +978,58 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
     return aerr;
 
   buffer->container = std::move(frame.msg);
+  buffer->frame = frame.data;
   buffer->data_offset = 0;
   buffer->data_len = rx_header_parsed_len_;
   buffer->type = rx_header_parsed_type_;
   return APIError::OK;
 }
-bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+bool APIPlaintextFrameHelper::can_write_without_blocking() {
+  return state_ == State::DATA && (tx_buf_.empty() || batching_);
+}
+bool APIPlaintextFrameHelper::begin_batch() {
+  if (!tx_buf_.empty())
+    return false;
+  batching_ = true;
+  return true;
+}
+APIError APIPlaintextFrameHelper::end_batch() {
+  batching_ = false;
+  if (tx_buf_.empty())
+    return APIError::OK;
+  return try_send_tx_buf_();
+}
+APIError APIPlaintextFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(payload_len).encode(header);
-  ProtoVarInt(type).encode(header);
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  if (raw_buffer->size() < FRAME_HEADER_PADDING)
+    return APIError::BAD_ARG;
+  size_t payload_len = raw_buffer->size() - FRAME_HEADER_PADDING;
+
+  // The header has variable length, so build it separately and place it right before the message
+  uint8_t header[FRAME_HEADER_PADDING + 3];
+  ProtoVarInt len_varint(payload_len);
+  ProtoVarInt type_varint(type);
+  if (1 + len_varint.encoded_size() + type_varint.encoded_size() > FRAME_HEADER_PADDING) {
+    HELPER_LOG("Packet too large to send");
+    return APIError::BAD_ARG;
+  }
+  size_t header_len = 0;
+  header[header_len++] = 0x00;
+  header_len += len_varint.encode(&header[header_len]);
+  header_len += type_varint.encode(&header[header_len]);
+
+  size_t header_offset = FRAME_HEADER_PADDING - header_len;
+  std::copy(header, header + header_len, raw_buffer->begin() + header_offset);
 
-  struct iovec iov[2];
-  iov[0].iov_base = &header[0];
-  iov[0].iov_len = header.size();
-  iov[1].iov_base = const_cast<uint8_t *>(payload);
-  iov[1].iov_len = payload_len;
+  struct iovec iov;
+  iov.iov_base = raw_buffer->data() + header_offset;
+  iov.iov_len = header_len + payload_len;
 
-  return write_raw_(iov, 2);
+  return write_raw_(&iov, 1);
 }
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
@@ -941,6 +1068,18 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
     total_write_len += iov[i].iov_len;
   }
 
+  if (batching_) {
+    if (tx_buf_.size() + total_write_len <= BATCH_MAX_SIZE) {
+      for (int i = 0; i < iovcnt; i++) {
+        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
+                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      }
+      return APIError::OK;
+    }
+    // batch is full, send what was collected so far
+    batching_ = false;
+  }
+
   if (!tx_buf_.empty()) {
     // try to empty tx_buf_ first
     aerr = try_send_tx_buf_();
@@ -12,12 +12,15 @@
 
 #include "esphome/components/socket/socket.h"
 #include "api_noise_context.h"
+#include "proto.h"
 
 namespace esphome {
 namespace api {
 
 struct ReadPacketBuffer {
   std::vector<uint8_t> container;
+  // The frame, either in container or still in the socket's receive buffer (valid until the next read_packet())
+  uint8_t *frame;
   uint16_t type;
   size_t data_offset;
   size_t data_len;
@@ -65,7 +68,26 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /** Frame and send a message that was encoded with create_buffer() semantics.
+   *
+   * The buffer must start with frame_header_padding() reserved bytes followed by the encoded message, the frame
+   * header (and MAC or other trailer) is written into the same buffer, so the message is never copied.
+   */
+  virtual APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) = 0;
+  /// Number of bytes to reserve in front of an encoded message for the frame header.
+  virtual uint8_t frame_header_padding() = 0;
+  /// Number of bytes the frame adds after the encoded message (e.g. a MAC).
+  virtual uint8_t frame_footer_size() = 0;
+  /// Whether write_protobuf_packet() changes the message in the buffer (so it can't be sent to multiple connections).
+  virtual bool modifies_buffer() = 0;
+  /** Collect the following packets in the send buffer instead of writing them right away.
+   *
+   * Only starts a batch if nothing is pending, returns whether a batch was started. The batch is sent by end_batch(),
+   * or earlier if it grows beyond one TCP segment.
+   */
+  virtual bool begin_batch() = 0;
+  virtual APIError end_batch() = 0;
+  virtual bool is_batching() = 0;
   virtual std::string getpeername() = 0;
   virtual APIError close() = 0;
   virtual APIError shutdown(int how) = 0;
@@ -83,7 +105,13 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  uint8_t frame_header_padding() override { return FRAME_HEADER_PADDING; }
+  uint8_t frame_footer_size() override { return FRAME_FOOTER_SIZE; }
+  bool modifies_buffer() override { return true; }  // encrypted in place
+  bool begin_batch() override;
+  APIError end_batch() override;
+  bool is_batching() override { return batching_; }
   std::string getpeername() override { return socket_->getpeername(); }
   APIError close() override;
   APIError shutdown(int how) override;
@@ -93,10 +121,14 @@ class APINoiseFrameHelper : public APIFrameHelper {
  protected:
   struct ParsedFrame {
     std::vector<uint8_t> msg;
+    // Points into msg, or into the socket's receive buffer if the frame was received in one piece
+    uint8_t *data = nullptr;
+    size_t size = 0;
   };
 
   APIError state_action_();
   APIError try_read_frame_(ParsedFrame *frame);
+  void consume_frame_();
   APIError try_send_tx_buf_();
   APIError write_frame_(const uint8_t *data, size_t len);
   APIError write_raw_(const struct iovec *iov, int iovcnt);
@@ -104,6 +136,11 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError check_handshake_finished_();
   void send_explicit_handshake_reject_(const std::string &reason);
 
+  // 3 byte frame header (indicator, encrypted size) + 4 byte message header (type, data length)
+  static const uint8_t FRAME_HEADER_PADDING = 7;
+  // MAC of the ChaChaPoly cipher
+  static const uint8_t FRAME_FOOTER_SIZE = 16;
+
   std::unique_ptr<socket::Socket> socket_;
 
   std::string info_;
@@ -111,8 +148,11 @@ class APINoiseFrameHelper : public APIFrameHelper {
   size_t rx_header_buf_len_ = 0;
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
+  // Bytes of the last frame that was used directly from the socket's receive buffer
+  size_t rx_consume_len_ = 0;
 
   std::vector<uint8_t> tx_buf_;
+  bool batching_ = false;
   std::vector<uint8_t> prologue_;
 
   std::shared_ptr<APINoiseContext> ctx_;
@@ -143,7 +183,13 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  uint8_t frame_header_padding() override { return FRAME_HEADER_PADDING; }
+  uint8_t frame_footer_size() override { return 0; }
+  bool modifies_buffer() override { return false; }  // only the header space is written
+  bool begin_batch() override;
+  APIError end_batch() override;
+  bool is_batching() override { return batching_; }
   std::string getpeername() override { return socket_->getpeername(); }
   APIError close() override;
   APIError shutdown(int how) override;
@@ -153,12 +199,19 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
  protected:
   struct ParsedFrame {
     std::vector<uint8_t> msg;
+    // Points into msg, or into the socket's receive buffer if the frame was received in one piece
+    uint8_t *data = nullptr;
+    size_t size = 0;
   };
 
   APIError try_read_frame_(ParsedFrame *frame);
+  void consume_frame_();
   APIError try_send_tx_buf_();
   APIError write_raw_(const struct iovec *iov, int iovcnt);
 
+  // Indicator byte + varint data length (up to 3 bytes) + varint type (up to 3 bytes)
+  static const uint8_t FRAME_HEADER_PADDING = 7;
+
   std::unique_ptr<socket::Socket> socket_;
 
   std::string info_;
@@ -169,8 +222,11 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
 
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
+  // Bytes of the last frame that was used directly from the socket's receive buffer
+  size_t rx_consume_len_ = 0;
 
   std::vector<uint8_t> tx_buf_;
+  bool batching_ = false;
 
   enum class State {
     INITIALIZE = 1,
@@ -533,6 +533,83 @@ void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeStatesRequest::dump_to(std::string &out) const { out.append("SubscribeStatesRequest {}"); }
 #endif
+bool StateFilter::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->min_interval = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool StateFilter::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 1: {
+      this->key = value.as_fixed32();
+      return true;
+    }
+    case 3: {
+      this->deadband = value.as_float();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void StateFilter::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_fixed32(1, this->key);
+  buffer.encode_uint32(2, this->min_interval);
+  buffer.encode_float(3, this->deadband);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void StateFilter::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("StateFilter {\n");
+  out.append("  key: ");
+  sprintf(buffer, "%u", this->key);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  min_interval: ");
+  sprintf(buffer, "%u", this->min_interval);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  deadband: ");
+  sprintf(buffer, "%g", this->deadband);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool SubscribeStatesFilteredRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->filters.push_back(value.as_message<StateFilter>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SubscribeStatesFilteredRequest::encode(ProtoWriteBuffer buffer) const {
+  for (auto &it : this->filters) {
+    buffer.encode_message<StateFilter>(1, it, true);
+  }
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void SubscribeStatesFilteredRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SubscribeStatesFilteredRequest {\n");
+  for (const auto &it : this->filters) {
+    out.append("  filters: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
+#endif
 bool ListEntitiesBinarySensorResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
     case 6: {
@@ -2059,6 +2136,10 @@ bool SensorStateResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
       this->missing_state = value.as_bool();
       return true;
     }
+    case 4: {
+      this->age = value.as_uint32();
+      return true;
+    }
     default:
       return false;
   }
@@ -2081,6 +2162,7 @@ void SensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
+  buffer.encode_uint32(4, this->age);
 }
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SensorStateResponse::dump_to(std::string &out) const {
@@ -2099,6 +2181,91 @@ void SensorStateResponse::dump_to(std::string &out) const {
   out.append("  missing_state: ");
   out.append(YESNO(this->missing_state));
   out.append("\n");
+
+  out.append("  age: ");
+  sprintf(buffer, "%u", this->age);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool SensorHistoryRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->max_age = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SensorHistoryRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_uint32(1, this->max_age); }
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void SensorHistoryRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SensorHistoryRequest {\n");
+  out.append("  max_age: ");
+  sprintf(buffer, "%u", this->max_age);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool SensorHistoryResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->ages.push_back(value.as_uint32());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SensorHistoryResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 1: {
+      this->key = value.as_fixed32();
+      return true;
+    }
+    case 3: {
+      this->states.push_back(value.as_float());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SensorHistoryResponse::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_fixed32(1, this->key);
+  for (auto &it : this->ages) {
+    buffer.encode_uint32(2, it, true);
+  }
+  for (auto &it : this->states) {
+    buffer.encode_float(3, it, true);
+  }
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void SensorHistoryResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SensorHistoryResponse {\n");
+  out.append("  key: ");
+  sprintf(buffer, "%u", this->key);
+  out.append(buffer);
+  out.append("\n");
+
+  for (const auto &it : this->ages) {
+    out.append("  ages: ");
+    sprintf(buffer, "%u", it);
+    out.append(buffer);
+    out.append("\n");
+  }
+
+  for (const auto &it : this->states) {
+    out.append("  states: ");
+    sprintf(buffer, "%g", it);
+    out.append(buffer);
+    out.append("\n");
+  }
   out.append("}");
 }
 #endif
@@ -4298,6 +4465,138 @@ void ButtonCommandRequest::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
+void SubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void SubscribeBluetoothLEAdvertisementsRequest::dump_to(std::string &out) const {
+  out.append("SubscribeBluetoothLEAdvertisementsRequest {}");
+}
+#endif
+bool BluetoothLERawAdvertisement::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->address = value.as_uint64();
+      return true;
+    }
+    case 2: {
+      this->rssi = value.as_sint32();
+      return true;
+    }
+    case 3: {
+      this->address_type = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool BluetoothLERawAdvertisement::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 4: {
+      this->data = value.as_string();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void BluetoothLERawAdvertisement::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_uint64(1, this->address);
+  buffer.encode_sint32(2, this->rssi);
+  buffer.encode_uint32(3, this->address_type);
+  buffer.encode_string(4, this->data);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void BluetoothLERawAdvertisement::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("BluetoothLERawAdvertisement {\n");
+  out.append("  address: ");
+  sprintf(buffer, "%llu", this->address);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  rssi: ");
+  sprintf(buffer, "%d", this->rssi);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  address_type: ");
+  sprintf(buffer, "%u", this->address_type);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  data: ");
+  out.append("'").append(this->data).append("'");
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool BluetoothLERawAdvertisementsResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->advertisements.push_back(value.as_message<BluetoothLERawAdvertisement>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void BluetoothLERawAdvertisementsResponse::encode(ProtoWriteBuffer buffer) const {
+  for (auto &it : this->advertisements) {
+    buffer.encode_message<BluetoothLERawAdvertisement>(1, it, true);
+  }
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void BluetoothLERawAdvertisementsResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("BluetoothLERawAdvertisementsResponse {\n");
+  for (const auto &it : this->advertisements) {
+    out.append("  advertisements: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
+#endif
+bool BatchCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->lights.push_back(value.as_message<LightCommandRequest>());
+      return true;
+    }
+    case 2: {
+      this->switches.push_back(value.as_message<SwitchCommandRequest>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void BatchCommandRequest::encode(ProtoWriteBuffer buffer) const {
+  for (auto &it : this->lights) {
+    buffer.encode_message<LightCommandRequest>(1, it, true);
+  }
+  for (auto &it : this->switches) {
+    buffer.encode_message<SwitchCommandRequest>(2, it, true);
+  }
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void BatchCommandRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("BatchCommandRequest {\n");
+  for (const auto &it : this->lights) {
+    out.append("  lights: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+
+  for (const auto &it : this->switches) {
+    out.append("  switches: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
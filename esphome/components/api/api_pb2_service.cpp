@@ -142,6 +142,14 @@ bool APIServerConnectionBase::send_sensor_state_response(const SensorStateRespon
   return this->send_message_<SensorStateResponse>(msg, 25);
 }
 #endif
+#ifdef USE_SENSOR
+bool APIServerConnectionBase::send_sensor_history_response(const SensorHistoryResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_sensor_history_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<SensorHistoryResponse>(msg, 65);
+}
+#endif
 #ifdef USE_SWITCH
 bool APIServerConnectionBase::send_list_entities_switch_response(const ListEntitiesSwitchResponse &msg) {
 #ifdef HAS_PROTO_MESSAGE_DUMP
@@ -292,6 +300,17 @@ bool APIServerConnectionBase::send_list_entities_button_response(const ListEntit
 #endif
 #ifdef USE_BUTTON
 #endif
+#ifdef USE_BLUETOOTH_PROXY
+#endif
+#ifdef USE_BLUETOOTH_PROXY
+bool APIServerConnectionBase::send_bluetooth_le_raw_advertisements_response(
+    const BluetoothLERawAdvertisementsResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_bluetooth_le_raw_advertisements_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<BluetoothLERawAdvertisementsResponse>(msg, 67);
+}
+#endif
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -375,6 +394,15 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       this->on_subscribe_states_request(msg);
       break;
     }
+    case 63: {
+      SubscribeStatesFilteredRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_subscribe_states_filtered_request: %s", msg.dump().c_str());
+#endif
+      this->on_subscribe_states_filtered_request(msg);
+      break;
+    }
     case 28: {
       SubscribeLogsRequest msg;
       msg.decode(msg_data, msg_size);
@@ -417,6 +445,15 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
 #endif
       break;
     }
+    case 64: {
+      SensorHistoryRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_sensor_history_request: %s", msg.dump().c_str());
+#endif
+      this->on_sensor_history_request(msg);
+      break;
+    }
     case 33: {
 #ifdef USE_SWITCH
       SwitchCommandRequest msg;
@@ -537,6 +574,26 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
 #endif
       break;
     }
+    case 66: {
+#ifdef USE_BLUETOOTH_PROXY
+      SubscribeBluetoothLEAdvertisementsRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_subscribe_bluetooth_le_advertisements_request: %s", msg.dump().c_str());
+#endif
+      this->on_subscribe_bluetooth_le_advertisements_request(msg);
+#endif
+      break;
+    }
+    case 68: {
+      BatchCommandRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_batch_command_request: %s", msg.dump().c_str());
+#endif
+      this->on_batch_command_request(msg);
+      break;
+    }
     default:
       return false;
   }
@@ -599,6 +656,28 @@ void APIServerConnection::on_subscribe_states_request(const SubscribeStatesReque
   }
   this->subscribe_states(msg);
 }
+void APIServerConnection::on_subscribe_states_filtered_request(const SubscribeStatesFilteredRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->subscribe_states_filtered(msg);
+}
+void APIServerConnection::on_sensor_history_request(const SensorHistoryRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->sensor_history(msg);
+}
 void APIServerConnection::on_subscribe_logs_request(const SubscribeLogsRequest &msg) {
   if (!this->is_connection_setup()) {
     this->on_no_setup_connection();
@@ -771,6 +850,31 @@ void APIServerConnection::on_button_command_request(const ButtonCommandRequest &
   this->button_command(msg);
 }
 #endif
+#ifdef USE_BLUETOOTH_PROXY
+void APIServerConnection::on_subscribe_bluetooth_le_advertisements_request(
+    const SubscribeBluetoothLEAdvertisementsRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->subscribe_bluetooth_le_advertisements(msg);
+}
+#endif
+void APIServerConnection::on_batch_command_request(const BatchCommandRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->batch_command(msg);
+}
 
 }  // namespace api
 }  // namespace esphome
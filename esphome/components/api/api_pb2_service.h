@@ -27,6 +27,7 @@ class APIServerConnectionBase : public ProtoService {
   virtual void on_list_entities_request(const ListEntitiesRequest &value){};
   bool send_list_entities_done_response(const ListEntitiesDoneResponse &msg);
   virtual void on_subscribe_states_request(const SubscribeStatesRequest &value){};
+  virtual void on_subscribe_states_filtered_request(const SubscribeStatesFilteredRequest &value){};
 #ifdef USE_BINARY_SENSOR
   bool send_list_entities_binary_sensor_response(const ListEntitiesBinarySensorResponse &msg);
 #endif
@@ -65,6 +66,10 @@ class APIServerConnectionBase : public ProtoService {
 #endif
 #ifdef USE_SENSOR
   bool send_sensor_state_response(const SensorStateResponse &msg);
+#endif
+  virtual void on_sensor_history_request(const SensorHistoryRequest &value){};
+#ifdef USE_SENSOR
+  bool send_sensor_history_response(const SensorHistoryResponse &msg);
 #endif
 #ifdef USE_SWITCH
   bool send_list_entities_switch_response(const ListEntitiesSwitchResponse &msg);
@@ -135,6 +140,14 @@ class APIServerConnectionBase : public ProtoService {
 #endif
 #ifdef USE_BUTTON
   virtual void on_button_command_request(const ButtonCommandRequest &value){};
+#endif
+#ifdef USE_BLUETOOTH_PROXY
+  virtual void on_subscribe_bluetooth_le_advertisements_request(
+      const SubscribeBluetoothLEAdvertisementsRequest &value){};
+#endif
+  virtual void on_batch_command_request(const BatchCommandRequest &value){};
+#ifdef USE_BLUETOOTH_PROXY
+  bool send_bluetooth_le_raw_advertisements_response(const BluetoothLERawAdvertisementsResponse &msg);
 #endif
  protected:
   bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
@@ -149,6 +162,8 @@ class APIServerConnection : public APIServerConnectionBase {
   virtual DeviceInfoResponse device_info(const DeviceInfoRequest &msg) = 0;
   virtual void list_entities(const ListEntitiesRequest &msg) = 0;
   virtual void subscribe_states(const SubscribeStatesRequest &msg) = 0;
+  virtual void subscribe_states_filtered(const SubscribeStatesFilteredRequest &msg) = 0;
+  virtual void sensor_history(const SensorHistoryRequest &msg) = 0;
   virtual void subscribe_logs(const SubscribeLogsRequest &msg) = 0;
   virtual void subscribe_homeassistant_services(const SubscribeHomeassistantServicesRequest &msg) = 0;
   virtual void subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) = 0;
@@ -181,6 +196,10 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_BUTTON
   virtual void button_command(const ButtonCommandRequest &msg) = 0;
 #endif
+#ifdef USE_BLUETOOTH_PROXY
+  virtual void subscribe_bluetooth_le_advertisements(const SubscribeBluetoothLEAdvertisementsRequest &msg) = 0;
+#endif
+  virtual void batch_command(const BatchCommandRequest &msg) = 0;
  protected:
   void on_hello_request(const HelloRequest &msg) override;
   void on_connect_request(const ConnectRequest &msg) override;
@@ -189,6 +208,8 @@ class APIServerConnection : public APIServerConnectionBase {
   void on_device_info_request(const DeviceInfoRequest &msg) override;
   void on_list_entities_request(const ListEntitiesRequest &msg) override;
   void on_subscribe_states_request(const SubscribeStatesRequest &msg) override;
+  void on_subscribe_states_filtered_request(const SubscribeStatesFilteredRequest &msg) override;
+  void on_sensor_history_request(const SensorHistoryRequest &msg) override;
   void on_subscribe_logs_request(const SubscribeLogsRequest &msg) override;
   void on_subscribe_homeassistant_services_request(const SubscribeHomeassistantServicesRequest &msg) override;
   void on_subscribe_home_assistant_states_request(const SubscribeHomeAssistantStatesRequest &msg) override;
@@ -221,6 +242,10 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_BUTTON
   void on_button_command_request(const ButtonCommandRequest &msg) override;
 #endif
+#ifdef USE_BLUETOOTH_PROXY
+  void on_subscribe_bluetooth_le_advertisements_request(const SubscribeBluetoothLEAdvertisementsRequest &msg) override;
+#endif
+  void on_batch_command_request(const BatchCommandRequest &msg) override;
 };
 
 }  // namespace api
@@ -6,6 +6,7 @@
 #include "esphome/core/util.h"
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/network/util.h"
 #include <cerrno>
 
@@ -56,6 +57,9 @@ void APIServer::setup() {
     return;
   }
 
+  this->clients_.reserve(this->max_connections_);
+  this->connection_slots_.reserve(this->max_connections_);
+
   err = socket_->listen(4);
   if (err != 0) {
     ESP_LOGW(TAG, "Socket unable to listen: errno %d", errno);
@@ -65,12 +69,21 @@ void APIServer::setup() {
 
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr) {
-    logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      for (auto &c : this->clients_) {
-        if (!c->remove_)
-          c->send_log_message(level, tag, message);
-      }
-    });
+    logger::global_logger->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) {
+          for (auto &c : this->clients_) {
+            if (!c->remove_)
+              c->send_log_message(level, tag, message);
+          }
+        },
+        [this]() {
+          int level = ESPHOME_LOG_LEVEL_NONE;
+          for (auto &c : this->clients_) {
+            if (!c->remove_)
+              level = std::max(level, c->log_subscription_);
+          }
+          return level;
+        });
   }
 #endif
 
@@ -88,6 +101,16 @@ void APIServer::setup() {
 #endif
 }
 void APIServer::loop() {
+  // Partition clients into remove and active
+  auto new_end = std::partition(this->clients_.begin(), this->clients_.end(),
+                                [](const std::unique_ptr<APIConnection> &conn) { return !conn->remove_; });
+  // print disconnection messages
+  for (auto it = new_end; it != this->clients_.end(); ++it) {
+    ESP_LOGV(TAG, "Removing connection to %s", (*it)->client_info_.c_str());
+  }
+  // resize vector
+  this->clients_.erase(new_end, this->clients_.end());
+
   // Accept new clients
   while (true) {
     struct sockaddr_storage source_addr;
@@ -95,6 +118,12 @@ void APIServer::loop() {
     auto sock = socket_->accept((struct sockaddr *) &source_addr, &addr_len);
     if (!sock)
       break;
+    if (this->clients_.size() >= this->max_connections_) {
+      ESP_LOGW(TAG, "Rejecting %s, maximum number of connections (%u) reached", sock->getpeername().c_str(),
+               this->max_connections_);
+      sock->close();
+      continue;
+    }
     ESP_LOGD(TAG, "Accepted %s", sock->getpeername().c_str());
 
     auto *conn = new APIConnection(std::move(sock), this);
@@ -102,16 +131,6 @@ void APIServer::loop() {
     conn->start();
   }
 
-  // Partition clients into remove and active
-  auto new_end = std::partition(this->clients_.begin(), this->clients_.end(),
-                                [](const std::unique_ptr<APIConnection> &conn) { return !conn->remove_; });
-  // print disconnection messages
-  for (auto it = new_end; it != this->clients_.end(); ++it) {
-    ESP_LOGV(TAG, "Removing connection to %s", (*it)->client_info_.c_str());
-  }
-  // resize vector
-  this->clients_.erase(new_end, this->clients_.end());
-
   for (auto &client : this->clients_) {
     client->loop();
   }
@@ -133,6 +152,7 @@ void APIServer::loop() {
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "API Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->port_);
+  ESP_LOGCONFIG(TAG, "  Max connections: %u", this->max_connections_);
 #ifdef USE_API_NOISE
   ESP_LOGCONFIG(TAG, "  Using noise encryption: YES");
 #else
@@ -173,8 +193,10 @@ void APIServer::handle_disconnect(APIConnection *conn) {}
 void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
   if (obj->is_internal())
     return;
+  this->begin_shared_state_();
   for (auto &c : this->clients_)
     c->send_binary_sensor_state(obj, state);
+  this->end_shared_state_();
 }
 #endif
 
@@ -182,8 +204,10 @@ void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool s
 void APIServer::on_cover_update(cover::Cover *obj) {
   if (obj->is_internal())
     return;
+  this->begin_shared_state_();
   for (auto &c : this->clients_)
     c->send_cover_state(obj);
+  this->end_shared_state_();
 }
 #endif
 
@@ -191,8 +215,10 @@ void APIServer::on_cover_update(cover::Cover *obj) {
 void APIServer::on_fan_update(fan::FanState *obj) {
   if (obj->is_internal())
     return;
+  this->begin_shared_state_();
   for (auto &c : this->clients_)
     c->send_fan_state(obj);
+  this->end_shared_state_();
 }
 #endif
 
@@ -200,8 +226,10 @@ void APIServer::on_fan_update(fan::FanState *obj) {
 void APIServer::on_light_update(light::LightState *obj) {
   if (obj->is_internal())
     return;
+  this->begin_shared_state_();
   for (auto &c : this->clients_)
     c->send_light_state(obj);
+  this->end_shared_state_();
 }
 #endif
 
@@ -209,8 +237,10 @@ void APIServer::on_light_update(light::LightState *obj) {
 void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
   if (obj->is_internal())
     return;
+  this->begin_shared_state_();
   for (auto &c : this->clients_)
     c->send_sensor_state(obj, state);
+  this->end_shared_state_();
 }
 #endif
 
@@ -218,8 +248,10 @@ void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
 void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
   if (obj->is_internal())
     return;
+  this->begin_shared_state_();
   for (auto &c : this->clients_)
     c->send_switch_state(obj, state);
+  this->end_shared_state_();
 }
 #endif
 
@@ -227,8 +259,10 @@ void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
 void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
   if (obj->is_internal())
     return;
+  this->begin_shared_state_();
   for (auto &c : this->clients_)
     c->send_text_sensor_state(obj, state);
+  this->end_shared_state_();
 }
 #endif
 
@@ -236,8 +270,10 @@ void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::s
 void APIServer::on_climate_update(climate::Climate *obj) {
   if (obj->is_internal())
     return;
+  this->begin_shared_state_();
   for (auto &c : this->clients_)
     c->send_climate_state(obj);
+  this->end_shared_state_();
 }
 #endif
 
@@ -245,8 +281,10 @@ void APIServer::on_climate_update(climate::Climate *obj) {
 void APIServer::on_number_update(number::Number *obj, float state) {
   if (obj->is_internal())
     return;
+  this->begin_shared_state_();
   for (auto &c : this->clients_)
     c->send_number_state(obj, state);
+  this->end_shared_state_();
 }
 #endif
 
@@ -254,11 +292,22 @@ void APIServer::on_number_update(number::Number *obj, float state) {
 void APIServer::on_select_update(select::Select *obj, const std::string &state) {
   if (obj->is_internal())
     return;
+  this->begin_shared_state_();
   for (auto &c : this->clients_)
     c->send_select_state(obj, state);
+  this->end_shared_state_();
 }
 #endif
 
+void APIServer::on_state_batch_begin() {
+  for (auto &c : this->clients_)
+    c->begin_state_batch();
+}
+void APIServer::on_state_batch_end() {
+  for (auto &c : this->clients_)
+    c->end_state_batch();
+}
+
 float APIServer::get_setup_priority() const { return setup_priority::AFTER_WIFI; }
 void APIServer::set_port(uint16_t port) { this->port_ = port; }
 APIServer *global_api_server = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -269,20 +318,112 @@ void APIServer::send_homeassistant_service_call(const HomeassistantServiceRespon
     client->send_homeassistant_service_call(call);
   }
 }
+#ifdef USE_BLUETOOTH_PROXY
+void APIServer::send_bluetooth_le_advertisements(const BluetoothLERawAdvertisementsResponse &msg) {
+  for (auto &client : this->clients_) {
+    client->send_bluetooth_le_advertisements(msg);
+  }
+}
+bool APIServer::has_bluetooth_le_advertisement_subscribers() const {
+  for (const auto &client : this->clients_) {
+    if (client->is_bluetooth_le_advertisement_subscribed())
+      return true;
+  }
+  return false;
+}
+#endif
 APIServer::APIServer() { global_api_server = this; }
+uint32_t APIServer::state_subscription_hash_(const std::string &entity_id, const std::string &attribute) {
+  // attributes can't contain spaces, so they don't create collisions between entity_id/attribute pairs
+  return fnv1_hash(entity_id + " " + attribute);
+}
+void APIServer::add_state_subscription_(HomeAssistantStateSubscription &&sub) {
+  uint32_t hash = state_subscription_hash_(sub.entity_id, sub.attribute.value_or(""));
+  this->state_subs_index_.emplace(hash, this->state_subs_.size());
+  this->state_subs_.push_back(std::move(sub));
+}
 void APIServer::subscribe_home_assistant_state(std::string entity_id, optional<std::string> attribute,
-                                               std::function<void(std::string)> f) {
-  this->state_subs_.push_back(HomeAssistantStateSubscription{
+                                               std::function<void(const std::string &)> f) {
+  this->add_state_subscription_(HomeAssistantStateSubscription{
       .entity_id = std::move(entity_id),
       .attribute = std::move(attribute),
       .callback = std::move(f),
+      .number_callback = nullptr,
   });
 }
+void APIServer::subscribe_home_assistant_number_state(std::string entity_id, optional<std::string> attribute,
+                                                      std::function<void(const std::string &, optional<float>)> f) {
+  this->add_state_subscription_(HomeAssistantStateSubscription{
+      .entity_id = std::move(entity_id),
+      .attribute = std::move(attribute),
+      .callback = nullptr,
+      .number_callback = std::move(f),
+  });
+}
+void APIServer::on_home_assistant_state(const std::string &entity_id, const std::string &attribute,
+                                        const std::string &state) {
+  auto range = this->state_subs_index_.equal_range(state_subscription_hash_(entity_id, attribute));
+  optional<float> number;
+  bool parsed = false;
+  for (auto it = range.first; it != range.second; ++it) {
+    auto &sub = this->state_subs_[it->second];
+    if (sub.entity_id != entity_id || sub.attribute.value_or("") != attribute)
+      continue;
+    if (sub.callback) {
+      sub.callback(state);
+      continue;
+    }
+    if (!parsed) {
+      number = parse_number<float>(state);
+      parsed = true;
+    }
+    sub.number_callback(state, number);
+  }
+}
 const std::vector<APIServer::HomeAssistantStateSubscription> &APIServer::get_state_subs() const {
   return this->state_subs_;
 }
 uint16_t APIServer::get_port() const { return this->port_; }
 void APIServer::set_reboot_timeout(uint32_t reboot_timeout) { this->reboot_timeout_ = reboot_timeout; }
+void *APIServer::acquire_connection_slot(size_t size) {
+  if (size != sizeof(APIConnection))
+    return nullptr;
+  for (auto &slot : this->connection_slots_) {
+    if (!slot.used) {
+      slot.used = true;
+      return slot.memory;
+    }
+  }
+  if (this->connection_slots_.size() >= this->max_connections_)
+    return nullptr;
+  void *memory = ::operator new(size);
+  this->connection_slots_.push_back({memory, true});
+  return memory;
+}
+bool APIServer::release_connection_slot(void *ptr) {
+  for (auto &slot : this->connection_slots_) {
+    if (slot.memory == ptr) {
+      slot.used = false;
+      return true;
+    }
+  }
+  return false;
+}
+std::vector<uint8_t> *APIServer::get_cached_info(const EntityBase *entity) {
+  auto it = this->info_cache_.find(entity);
+  if (it == this->info_cache_.end())
+    return nullptr;
+  return &it->second;
+}
+std::vector<uint8_t> *APIServer::add_cached_info(const EntityBase *entity) {
+  if (!this->cache_list_entities_)
+    return nullptr;
+  return &this->info_cache_[entity];
+}
+void APIServer::begin_shared_state_() {
+  this->shared_state_active_ = this->clients_.size() > 1;
+  this->shared_state_.encoded = false;
+}
 #ifdef USE_HOMEASSISTANT_TIME
 void APIServer::request_time() {
   for (auto &client : this->clients_) {
@@ -292,6 +433,13 @@ void APIServer::request_time() {
 }
 #endif
 bool APIServer::is_connected() const { return !this->clients_.empty(); }
+bool APIServer::is_busy() const {
+  for (const auto &client : this->clients_) {
+    if (client->is_busy())
+      return true;
+  }
+  return false;
+}
 void APIServer::on_shutdown() {
   for (auto &c : this->clients_) {
     c->send_disconnect_request(DisconnectRequest());
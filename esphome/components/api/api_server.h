@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/entity_base.h"
 #include "esphome/core/log.h"
 #include "esphome/components/socket/socket.h"
 #include "api_pb2.h"
@@ -13,9 +14,17 @@
 #include "user_services.h"
 #include "api_noise_context.h"
 
+#include <unordered_map>
+
 namespace esphome {
 namespace api {
 
+/// A state message encoded once and sent to all connections, see APIConnection::send_state_message_().
+struct SharedStateBuffer {
+  std::vector<uint8_t> data;
+  bool encoded;
+};
+
 class APIServer : public Component, public Controller {
  public:
   APIServer();
@@ -30,6 +39,22 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  void set_max_connections(uint8_t max_connections) { this->max_connections_ = max_connections; }
+  /// Coalesce state messages sent within this many milliseconds into one socket write, 0 disables batching.
+  void set_batch_delay(uint16_t batch_delay) { this->batch_delay_ = batch_delay; }
+  uint16_t get_batch_delay() const { return this->batch_delay_; }
+  void set_cache_list_entities(bool cache_list_entities) { this->cache_list_entities_ = cache_list_entities; }
+  /// The encoded ListEntities response of this entity, or nullptr if it has not been cached.
+  std::vector<uint8_t> *get_cached_info(const EntityBase *entity);
+  /// Create the cache entry for the ListEntities response of this entity, returns nullptr if caching is disabled.
+  std::vector<uint8_t> *add_cached_info(const EntityBase *entity);
+  /// Memory for a new connection, reusing the memory of an earlier connection if possible. nullptr if all
+  /// max_connections_ slots are in use.
+  void *acquire_connection_slot(size_t size);
+  /// Return a connection slot, false if ptr isn't one of the slots.
+  bool release_connection_slot(void *ptr);
+  /// The buffer for the state update currently sent to all clients, or nullptr if there is none.
+  SharedStateBuffer *get_shared_state_buffer() { return this->shared_state_active_ ? &this->shared_state_ : nullptr; }
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -67,33 +92,74 @@ class APIServer : public Component, public Controller {
 #ifdef USE_SELECT
   void on_select_update(select::Select *obj, const std::string &state) override;
 #endif
+  void on_state_batch_begin() override;
+  void on_state_batch_end() override;
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call);
+#ifdef USE_BLUETOOTH_PROXY
+  void send_bluetooth_le_advertisements(const BluetoothLERawAdvertisementsResponse &msg);
+  /// Whether any client subscribed to raw BLE advertisements, so they don't have to be collected otherwise.
+  bool has_bluetooth_le_advertisement_subscribers() const;
+#endif
   void register_user_service(UserServiceDescriptor *descriptor) { this->user_services_.push_back(descriptor); }
 #ifdef USE_HOMEASSISTANT_TIME
   void request_time();
 #endif
 
   bool is_connected() const;
+  /// Whether any client is currently moving a lot of data, for components sharing the radio with Wi-Fi.
+  bool is_busy() const;
 
   struct HomeAssistantStateSubscription {
     std::string entity_id;
     optional<std::string> attribute;
-    std::function<void(std::string)> callback;
+    std::function<void(const std::string &)> callback;
+    /// Set instead of callback for numeric imports, gets the state parsed to a number (if it is one).
+    std::function<void(const std::string &, optional<float>)> number_callback;
   };
 
   void subscribe_home_assistant_state(std::string entity_id, optional<std::string> attribute,
-                                      std::function<void(std::string)> f);
+                                      std::function<void(const std::string &)> f);
+  /// Like subscribe_home_assistant_state, but the state is parsed only once for all numeric subscribers of an entity.
+  void subscribe_home_assistant_number_state(std::string entity_id, optional<std::string> attribute,
+                                             std::function<void(const std::string &, optional<float>)> f);
   const std::vector<HomeAssistantStateSubscription> &get_state_subs() const;
+  /// Pass a state received from Home Assistant to the subscriptions of that entity (and attribute).
+  void on_home_assistant_state(const std::string &entity_id, const std::string &attribute, const std::string &state);
   const std::vector<UserServiceDescriptor *> &get_user_services() const { return this->user_services_; }
 
  protected:
+  /// Encode state messages only once while sending them to all clients, if there is more than one.
+  void begin_shared_state_();
+  void end_shared_state_() { this->shared_state_active_ = false; }
+  void add_state_subscription_(HomeAssistantStateSubscription &&sub);
+  static uint32_t state_subscription_hash_(const std::string &entity_id, const std::string &attribute);
+
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
   uint32_t last_connected_{0};
+  uint16_t batch_delay_{0};
+  uint8_t max_connections_{4};
+  struct ConnectionSlot {
+    void *memory;
+    bool used;
+  };
+  /** Memory for APIConnection objects, allocated when a connection needs it and kept for later connections.
+   *
+   * Only as many slots as connections were open at once exist (at most max_connections_), so a device that only
+   * ever has one client doesn't pay for the others, while reconnects still reuse the same memory.
+   */
+  std::vector<ConnectionSlot> connection_slots_;
+  SharedStateBuffer shared_state_{};
+  bool shared_state_active_{false};
+  bool cache_list_entities_{false};
+  /// Entity descriptors don't change at runtime, so they are only encoded for the first client that lists them.
+  std::unordered_map<const EntityBase *, std::vector<uint8_t>> info_cache_;
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
   std::vector<HomeAssistantStateSubscription> state_subs_;
+  /// Indices into state_subs_, by the hash of entity id and attribute.
+  std::unordered_multimap<uint32_t, size_t> state_subs_index_;
   std::vector<UserServiceDescriptor *> user_services_;
 
 #ifdef USE_API_NOISE
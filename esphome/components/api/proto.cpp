@@ -7,6 +7,11 @@ namespace api {
 
 static const char *const TAG = "api.proto";
 
+uint32_t ProtoMessage::calculate_size() const {
+  uint32_t size = 0;
+  this->encode(ProtoWriteBuffer::size_calculator(&size));
+  return size;
+}
 void ProtoMessage::decode(const uint8_t *buffer, size_t length) {
   uint32_t i = 0;
   bool error = false;
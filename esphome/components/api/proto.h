@@ -68,7 +68,7 @@ class ProtoVarInt {
       return static_cast<int64_t>(this->value_ >> 1);
   }
   void encode(std::vector<uint8_t> &out) {
-    uint32_t val = this->value_;
+    uint64_t val = this->value_;
     if (val <= 0x7F) {
       out.push_back(val);
       return;
@@ -83,6 +83,28 @@ class ProtoVarInt {
       }
     }
   }
+  /// Number of bytes encode() produces for this value.
+  uint32_t encoded_size() const {
+    uint64_t val = this->value_;
+    uint32_t size = 1;
+    while (val > 0x7F) {
+      val >>= 7;
+      size++;
+    }
+    return size;
+  }
+  /// Encode into a raw buffer, which must have room for encoded_size() (at most 10) bytes. Returns the number of bytes
+  /// written.
+  size_t encode(uint8_t *out) {
+    uint64_t val = this->value_;
+    size_t len = 0;
+    do {
+      uint8_t temp = val & 0x7F;
+      val >>= 7;
+      out[len++] = val ? (temp | 0x80) : temp;
+    } while (val);
+    return len;
+  }
 
  protected:
   uint64_t value_;
@@ -92,6 +114,9 @@ class ProtoLengthDelimited {
  public:
   explicit ProtoLengthDelimited(const uint8_t *value, size_t length) : value_(value), length_(length) {}
   std::string as_string() const { return std::string(reinterpret_cast<const char *>(this->value_), this->length_); }
+  /// The encoded value in the message buffer, without a copy.
+  const uint8_t *data() const { return this->value_; }
+  size_t size() const { return this->length_; }
   template<class C> C as_message() const {
     auto msg = C();
     msg.decode(this->value_, this->length_);
@@ -139,11 +164,40 @@ class Proto64Bit {
   const uint64_t value_;
 };
 
+/** Encodes protobuf fields into a buffer.
+ *
+ * A write buffer can also be created with size_calculator(), in which case nothing is written and only the
+ * encoded size is counted (see ProtoMessage::calculate_size()).
+ */
 class ProtoWriteBuffer {
  public:
   ProtoWriteBuffer(std::vector<uint8_t> *buffer) : buffer_(buffer) {}
-  void write(uint8_t value) { this->buffer_->push_back(value); }
-  void encode_varint_raw(ProtoVarInt value) { value.encode(*this->buffer_); }
+  static ProtoWriteBuffer size_calculator(uint32_t *size) {
+    ProtoWriteBuffer buffer{nullptr};
+    buffer.size_ = size;
+    return buffer;
+  }
+  void write(uint8_t value) {
+    if (this->buffer_ == nullptr) {
+      (*this->size_)++;
+      return;
+    }
+    this->buffer_->push_back(value);
+  }
+  void write(const uint8_t *data, size_t len) {
+    if (this->buffer_ == nullptr) {
+      *this->size_ += len;
+      return;
+    }
+    this->buffer_->insert(this->buffer_->end(), data, data + len);
+  }
+  void encode_varint_raw(ProtoVarInt value) {
+    if (this->buffer_ == nullptr) {
+      *this->size_ += value.encoded_size();
+      return;
+    }
+    value.encode(*this->buffer_);
+  }
   void encode_varint_raw(uint32_t value) { this->encode_varint_raw(ProtoVarInt(value)); }
   void encode_field_raw(uint32_t field_id, uint32_t type) {
     uint32_t val = (field_id << 3) | (type & 0b111);
@@ -155,9 +209,7 @@ class ProtoWriteBuffer {
 
     this->encode_field_raw(field_id, 2);
     this->encode_varint_raw(len);
-    auto *data = reinterpret_cast<const uint8_t *>(string);
-    for (size_t i = 0; i < len; i++)
-      this->write(data[i]);
+    this->write(reinterpret_cast<const uint8_t *>(string), len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
     this->encode_string(field_id, value.data(), value.size());
@@ -228,26 +280,24 @@ class ProtoWriteBuffer {
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // the length prefix comes first, so calculate it up front instead of moving the encoded message afterwards
+    this->encode_varint_raw(value.calculate_size());
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
  protected:
   std::vector<uint8_t> *buffer_;
+  /// Byte counter of a size calculator, only used if buffer_ is nullptr.
+  uint32_t *size_{nullptr};
 };
 
 class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Size of the encoded message in bytes.
+  uint32_t calculate_size() const;
   void decode(const uint8_t *buffer, size_t length);
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
@@ -271,12 +321,13 @@ class ProtoService {
   virtual void on_fatal_error() = 0;
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
-  virtual ProtoWriteBuffer create_buffer() = 0;
+  /// Get a buffer to encode a message into, reserve_size is the expected size of the encoded message.
+  virtual ProtoWriteBuffer create_buffer(uint32_t reserve_size) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
-    auto buffer = this->create_buffer();
+    auto buffer = this->create_buffer(msg.calculate_size());
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
@@ -4,25 +4,155 @@
 namespace esphome {
 namespace api {
 
-template<> bool get_execute_arg_value<bool>(const ExecuteServiceArgument &arg) { return arg.bool_; }
-template<> int get_execute_arg_value<int>(const ExecuteServiceArgument &arg) {
-  if (arg.legacy_int != 0)
-    return arg.legacy_int;
-  return arg.int_;
-}
-template<> float get_execute_arg_value<float>(const ExecuteServiceArgument &arg) { return arg.float_; }
-template<> std::string get_execute_arg_value<std::string>(const ExecuteServiceArgument &arg) { return arg.string_; }
-template<> std::vector<bool> get_execute_arg_value<std::vector<bool>>(const ExecuteServiceArgument &arg) {
-  return arg.bool_array;
-}
-template<> std::vector<int32_t> get_execute_arg_value<std::vector<int32_t>>(const ExecuteServiceArgument &arg) {
-  return arg.int_array;
-}
-template<> std::vector<float> get_execute_arg_value<std::vector<float>>(const ExecuteServiceArgument &arg) {
-  return arg.float_array;
+namespace {
+
+/// Reads only the key of an ExecuteServiceRequest, skipping the arguments.
+class ExecuteServiceKeyDecoder : public ProtoMessage {
+ public:
+  uint32_t key{0};
+  void encode(ProtoWriteBuffer buffer) const override {}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  void dump_to(std::string &out) const override {}
+#endif
+
+ protected:
+  bool decode_32bit(uint32_t field_id, Proto32Bit value) override {
+    if (field_id != 1)
+      return false;
+    this->key = value.as_fixed32();
+    return true;
+  }
+};
+
+/// Decodes one ExecuteServiceArgument straight into the storage of its argument type.
+class ExecuteServiceArgDecoder : public ProtoMessage {
+ public:
+  ExecuteServiceArgDecoder(enums::ServiceArgType type, void *storage) : type_(type), storage_(storage) {
+    switch (type) {
+      case enums::SERVICE_ARG_TYPE_BOOL:
+        *static_cast<bool *>(storage) = false;
+        break;
+      case enums::SERVICE_ARG_TYPE_INT:
+        *static_cast<int32_t *>(storage) = 0;
+        break;
+      case enums::SERVICE_ARG_TYPE_FLOAT:
+        *static_cast<float *>(storage) = 0.0f;
+        break;
+      case enums::SERVICE_ARG_TYPE_STRING:
+        static_cast<std::string *>(storage)->clear();
+        break;
+      case enums::SERVICE_ARG_TYPE_BOOL_ARRAY:
+        static_cast<ServiceArrayStorage<bool> *>(storage)->clear();
+        break;
+      case enums::SERVICE_ARG_TYPE_INT_ARRAY:
+        static_cast<ServiceArrayStorage<int32_t> *>(storage)->clear();
+        break;
+      case enums::SERVICE_ARG_TYPE_FLOAT_ARRAY:
+        static_cast<ServiceArrayStorage<float> *>(storage)->clear();
+        break;
+      case enums::SERVICE_ARG_TYPE_STRING_ARRAY:
+        static_cast<ServiceArrayStorage<std::string> *>(storage)->clear();
+        break;
+    }
+  }
+  void encode(ProtoWriteBuffer buffer) const override {}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  void dump_to(std::string &out) const override {}
+#endif
+
+ protected:
+  bool decode_varint(uint32_t field_id, ProtoVarInt value) override {
+    if (field_id == 1 && this->type_ == enums::SERVICE_ARG_TYPE_BOOL) {
+      *static_cast<bool *>(this->storage_) = value.as_bool();
+    } else if (field_id == 2 && this->type_ == enums::SERVICE_ARG_TYPE_INT) {
+      // clients before api v1.3 only send the unsigned legacy_int, which takes precedence if it's set
+      if (value.as_int32() != 0) {
+        *static_cast<int32_t *>(this->storage_) = value.as_int32();
+        this->legacy_int_ = true;
+      }
+    } else if (field_id == 5 && this->type_ == enums::SERVICE_ARG_TYPE_INT) {
+      if (!this->legacy_int_)
+        *static_cast<int32_t *>(this->storage_) = value.as_sint32();
+    } else if (field_id == 6 && this->type_ == enums::SERVICE_ARG_TYPE_BOOL_ARRAY) {
+      static_cast<ServiceArrayStorage<bool> *>(this->storage_)->next() = value.as_bool();
+    } else if (field_id == 7 && this->type_ == enums::SERVICE_ARG_TYPE_INT_ARRAY) {
+      static_cast<ServiceArrayStorage<int32_t> *>(this->storage_)->next() = value.as_sint32();
+    } else {
+      return false;
+    }
+    return true;
+  }
+  bool decode_length(uint32_t field_id, ProtoLengthDelimited value) override {
+    // assigning keeps the buffer of the string if it's large enough
+    const char *chars = reinterpret_cast<const char *>(value.data());
+    if (field_id == 4 && this->type_ == enums::SERVICE_ARG_TYPE_STRING) {
+      static_cast<std::string *>(this->storage_)->assign(chars, value.size());
+    } else if (field_id == 9 && this->type_ == enums::SERVICE_ARG_TYPE_STRING_ARRAY) {
+      static_cast<ServiceArrayStorage<std::string> *>(this->storage_)->next().assign(chars, value.size());
+    } else {
+      return false;
+    }
+    return true;
+  }
+  bool decode_32bit(uint32_t field_id, Proto32Bit value) override {
+    if (field_id == 3 && this->type_ == enums::SERVICE_ARG_TYPE_FLOAT) {
+      *static_cast<float *>(this->storage_) = value.as_float();
+    } else if (field_id == 8 && this->type_ == enums::SERVICE_ARG_TYPE_FLOAT_ARRAY) {
+      static_cast<ServiceArrayStorage<float> *>(this->storage_)->next() = value.as_float();
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  enums::ServiceArgType type_;
+  void *storage_;
+  bool legacy_int_{false};
+};
+
+/// Walks the arguments of an ExecuteServiceRequest and decodes each into the storage of its position.
+class ExecuteServiceArgsDecoder : public ProtoMessage {
+ public:
+  ExecuteServiceArgsDecoder(const enums::ServiceArgType *types, void *const *storage, size_t count)
+      : types_(types), storage_(storage), count_(count) {}
+  size_t args{0};
+  void encode(ProtoWriteBuffer buffer) const override {}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  void dump_to(std::string &out) const override {}
+#endif
+
+ protected:
+  bool decode_length(uint32_t field_id, ProtoLengthDelimited value) override {
+    if (field_id != 2)
+      return false;
+    if (this->args < this->count_) {
+      ExecuteServiceArgDecoder arg(this->types_[this->args], this->storage_[this->args]);
+      arg.decode(value.data(), value.size());
+    }
+    this->args++;
+    return true;
+  }
+  // the key was already read
+  bool decode_32bit(uint32_t field_id, Proto32Bit value) override { return field_id == 1; }
+
+  const enums::ServiceArgType *types_;
+  void *const *storage_;
+  size_t count_;
+};
+
+}  // namespace
+
+uint32_t decode_execute_service_key(const uint8_t *data, size_t len) {
+  ExecuteServiceKeyDecoder msg;
+  msg.decode(data, len);
+  return msg.key;
 }
-template<> std::vector<std::string> get_execute_arg_value<std::vector<std::string>>(const ExecuteServiceArgument &arg) {
-  return arg.string_array;
+
+size_t decode_execute_service_args(const uint8_t *data, size_t len, const enums::ServiceArgType *types,
+                                   void *const *storage, size_t count) {
+  ExecuteServiceArgsDecoder msg(types, storage, count);
+  msg.decode(data, len);
+  return msg.args;
 }
 
 template<> enums::ServiceArgType to_service_arg_type<bool>() { return enums::SERVICE_ARG_TYPE_BOOL; }
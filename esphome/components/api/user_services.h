@@ -1,6 +1,9 @@
 #pragma once
 
+#include <memory>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
@@ -9,17 +12,65 @@
 namespace esphome {
 namespace api {
 
-class UserServiceDescriptor {
+/** Storage for the values of an array argument that keeps its memory between calls.
+ *
+ * Only grows, and elements are reused instead of destroyed, so a string keeps its buffer too: once a service was
+ * called with its largest arguments, decoding them doesn't allocate anymore. The service itself gets a std::vector
+ * copy, since its actions may keep the arguments past the next call (a delay or a queued script).
+ */
+template<typename T> class ServiceArrayStorage {
  public:
-  virtual ListEntitiesServicesResponse encode_list_service_response() = 0;
+  void clear() { this->size_ = 0; }
+  /// The next element to decode a value into.
+  T &next() {
+    if (this->size_ == this->capacity_) {
+      size_t capacity = this->capacity_ == 0 ? 4 : this->capacity_ * 2;
+      std::unique_ptr<T[]> data(new T[capacity]);  // NOLINT
+      for (size_t i = 0; i < this->size_; i++)
+        data[i] = std::move(this->data_[i]);
+      this->data_ = std::move(data);
+      this->capacity_ = capacity;
+    }
+    return this->data_[this->size_++];
+  }
+  std::vector<T> to_vector() const { return std::vector<T>(this->data_.get(), this->data_.get() + this->size_); }
 
-  virtual bool execute_service(const ExecuteServiceRequest &req) = 0;
+ protected:
+  std::unique_ptr<T[]> data_;  // NOLINT
+  size_t size_{0};
+  size_t capacity_{0};
 };
 
-template<typename T> T get_execute_arg_value(const ExecuteServiceArgument &arg);
+/// How the value of an argument type is stored while it's decoded, and passed to the service from there.
+template<typename T> struct ServiceArgStorage {
+  using type = T;
+  static const T &get(const type &storage) { return storage; }
+};
+template<typename T> struct ServiceArgStorage<std::vector<T>> {
+  using type = ServiceArrayStorage<T>;
+  static std::vector<T> get(const type &storage) { return storage.to_vector(); }
+};
 
 template<typename T> enums::ServiceArgType to_service_arg_type();
 
+/// Read the key of an encoded ExecuteServiceRequest.
+uint32_t decode_execute_service_key(const uint8_t *data, size_t len);
+/** Decode the arguments of an encoded ExecuteServiceRequest into their storage.
+ *
+ * storage[i] points at the ServiceArgStorage type of types[i]. Returns the number of arguments in the request, the ones
+ * past count are skipped.
+ */
+size_t decode_execute_service_args(const uint8_t *data, size_t len, const enums::ServiceArgType *types,
+                                   void *const *storage, size_t count);
+
+class UserServiceDescriptor {
+ public:
+  virtual ListEntitiesServicesResponse encode_list_service_response() = 0;
+
+  /// Execute the service if the key is its own, with the arguments of the encoded ExecuteServiceRequest.
+  virtual bool execute_service(uint32_t key, const uint8_t *data, size_t len) = 0;
+};
+
 template<typename... Ts> class UserServiceBase : public UserServiceDescriptor {
  public:
   UserServiceBase(std::string name, const std::array<std::string, sizeof...(Ts)> &arg_names)
@@ -41,24 +92,28 @@ template<typename... Ts> class UserServiceBase : public UserServiceDescriptor {
     return msg;
   }
 
-  bool execute_service(const ExecuteServiceRequest &req) override {
-    if (req.key != this->key_)
+  bool execute_service(uint32_t key, const uint8_t *data, size_t len) override {
+    if (key != this->key_)
       return false;
-    if (req.args.size() != this->arg_names_.size())
-      return false;
-    this->execute_(req.args, typename gens<sizeof...(Ts)>::type());
-    return true;
+    return this->execute_(data, len, typename gens<sizeof...(Ts)>::type());
   }
 
  protected:
   virtual void execute(Ts... x) = 0;
-  template<int... S> void execute_(std::vector<ExecuteServiceArgument> args, seq<S...>) {
-    this->execute((get_execute_arg_value<Ts>(args[S]))...);
+  template<int... S> bool execute_(const uint8_t *data, size_t len, seq<S...>) {
+    static const enums::ServiceArgType TYPES[sizeof...(Ts) + 1] = {to_service_arg_type<Ts>()...};
+    void *const storage[sizeof...(Ts) + 1] = {&std::get<S>(this->args_)...};
+    if (decode_execute_service_args(data, len, TYPES, storage, sizeof...(Ts)) != sizeof...(Ts))
+      return false;
+    this->execute((ServiceArgStorage<Ts>::get(std::get<S>(this->args_)))...);
+    return true;
   }
 
   std::string name_;
   uint32_t key_{0};
   std::array<std::string, sizeof...(Ts)> arg_names_;
+  /// The decoded arguments of the last call, reused for the next one.
+  std::tuple<typename ServiceArgStorage<Ts>::type...> args_;
 };
 
 template<typename... Ts> class UserServiceTrigger : public UserServiceBase<Ts...>, public Trigger<Ts...> {
@@ -14,6 +14,7 @@ class BParasite : public Component, public esp32_ble_tracker::ESPBTDeviceListene
   void set_address(uint64_t address) { address_ = address; };
   void set_bindkey(const std::string &bindkey);
 
+  bool skips_duplicates() const override { return true; }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
@@ -0,0 +1,116 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import automation, pins
+from esphome.automation import maybe_simple_id
+from esphome.components import i2c, sensor
+from esphome.const import (
+    CONF_ADDRESS,
+    CONF_I2C_ID,
+    CONF_ID,
+    CONF_PIN,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+)
+
+CODEOWNERS = ["@esphome/core"]
+DEPENDENCIES = ["logger"]
+AUTO_LOAD = ["sensor"]
+
+CONF_RUN_ON_BOOT = "run_on_boot"
+CONF_FLASH = "flash"
+CONF_MILLIS = "millis"
+CONF_MICROS = "micros"
+CONF_GPIO = "gpio"
+CONF_HEAP = "heap"
+CONF_SCHEDULER = "scheduler"
+CONF_I2C = "i2c"
+CONF_PREFERENCES = "preferences"
+UNIT_MICROSECOND = "µs"
+
+benchmark_ns = cg.esphome_ns.namespace("benchmark")
+BenchmarkComponent = benchmark_ns.class_("BenchmarkComponent", cg.Component)
+RunAction = benchmark_ns.class_("RunAction", automation.Action)
+
+RESULT_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MICROSECOND,
+    icon=ICON_TIMER,
+    accuracy_decimals=3,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+
+def validate_sources(config):
+    for key, source in (
+        (CONF_GPIO, CONF_PIN),
+        (CONF_I2C, CONF_I2C_ID),
+    ):
+        if key in config and source not in config:
+            raise cv.Invalid(f"The {key} sensor requires '{source}' to be set")
+    if CONF_PREFERENCES in config and not config[CONF_FLASH]:
+        raise cv.Invalid(f"The {CONF_PREFERENCES} sensor requires '{CONF_FLASH}: true'")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(BenchmarkComponent),
+            cv.Optional(CONF_RUN_ON_BOOT, default=True): cv.boolean,
+            cv.Optional(CONF_PIN): pins.gpio_output_pin_schema,
+            cv.Optional(CONF_I2C_ID): cv.use_id(i2c.I2CBus),
+            cv.Optional(CONF_ADDRESS): cv.i2c_address,
+            # Writes to flash on every run, so it has to be enabled explicitly
+            cv.Optional(CONF_FLASH, default=False): cv.boolean,
+            cv.Optional(CONF_MILLIS): RESULT_SCHEMA,
+            cv.Optional(CONF_MICROS): RESULT_SCHEMA,
+            cv.Optional(CONF_GPIO): RESULT_SCHEMA,
+            cv.Optional(CONF_HEAP): RESULT_SCHEMA,
+            cv.Optional(CONF_SCHEDULER): RESULT_SCHEMA,
+            cv.Optional(CONF_I2C): RESULT_SCHEMA,
+            cv.Optional(CONF_PREFERENCES): RESULT_SCHEMA,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.has_none_or_all_keys(CONF_I2C_ID, CONF_ADDRESS),
+    validate_sources,
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_run_on_boot(config[CONF_RUN_ON_BOOT]))
+    cg.add(var.set_flash(config[CONF_FLASH]))
+    if CONF_PIN in config:
+        pin = await cg.gpio_pin_expression(config[CONF_PIN])
+        cg.add(var.set_pin(pin))
+    if CONF_I2C_ID in config:
+        cg.add_define("USE_BENCHMARK_I2C")
+        bus = await cg.get_variable(config[CONF_I2C_ID])
+        cg.add(var.set_i2c(bus, config[CONF_ADDRESS]))
+
+    for key, setter in (
+        (CONF_MILLIS, var.set_millis_sensor),
+        (CONF_MICROS, var.set_micros_sensor),
+        (CONF_GPIO, var.set_gpio_sensor),
+        (CONF_HEAP, var.set_heap_sensor),
+        (CONF_SCHEDULER, var.set_scheduler_sensor),
+        (CONF_I2C, var.set_i2c_sensor),
+        (CONF_PREFERENCES, var.set_preferences_sensor),
+    ):
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(setter(sens))
+
+
+@automation.register_action(
+    "benchmark.run",
+    RunAction,
+    maybe_simple_id({cv.GenerateID(): cv.use_id(BenchmarkComponent)}),
+)
+async def benchmark_run_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
@@ -0,0 +1,111 @@
+#include "benchmark.h"
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+#include <cstdlib>
+
+namespace esphome {
+namespace benchmark {
+
+static const char *const TAG = "benchmark";
+
+static const uint32_t FAST_ITERATIONS = 10000;
+static const uint32_t SLOW_ITERATIONS = 1000;
+static const uint32_t BUS_ITERATIONS = 100;
+static const uint32_t FLASH_ITERATIONS = 3;
+static const size_t HEAP_BLOCK_SIZE = 64;
+static const size_t I2C_READ_LENGTH = 8;
+
+void BenchmarkComponent::setup() {
+  if (this->pin_ != nullptr)
+    this->pin_->setup();
+  if (this->flash_)
+    this->pref_ = global_preferences->make_preference<uint32_t>(fnv1_hash("benchmark"));
+  if (this->run_on_boot_)
+    this->run();
+}
+
+void BenchmarkComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Benchmark:");
+  ESP_LOGCONFIG(TAG, "  Run On Boot: %s", YESNO(this->run_on_boot_));
+  LOG_PIN("  Pin: ", this->pin_);
+#ifdef USE_BENCHMARK_I2C
+  ESP_LOGCONFIG(TAG, "  I2C Address: 0x%02X", this->address_);
+#endif
+  ESP_LOGCONFIG(TAG, "  Flash: %s", YESNO(this->flash_));
+  LOG_SENSOR("  ", "millis()", this->millis_sensor_);
+  LOG_SENSOR("  ", "micros()", this->micros_sensor_);
+  LOG_SENSOR("  ", "GPIO", this->gpio_sensor_);
+  LOG_SENSOR("  ", "Heap", this->heap_sensor_);
+  LOG_SENSOR("  ", "Scheduler", this->scheduler_sensor_);
+  LOG_SENSOR("  ", "I2C", this->i2c_sensor_);
+  LOG_SENSOR("  ", "Preferences", this->preferences_sensor_);
+}
+
+void BenchmarkComponent::run() {
+  ESP_LOGI(TAG, "Running benchmarks...");
+  // Results are written to these so the compiler can't drop the measured calls.
+  volatile uint32_t sink = 0;
+  void *volatile block = nullptr;
+
+  this->report_("millis()", this->measure_(FAST_ITERATIONS, [&sink]() { sink = millis(); }), this->millis_sensor_);
+  this->report_("micros()", this->measure_(FAST_ITERATIONS, [&sink]() { sink = micros(); }), this->micros_sensor_);
+
+  if (this->pin_ != nullptr) {
+    bool state = false;
+    float result = this->measure_(FAST_ITERATIONS, [this, &state]() {
+      state = !state;
+      this->pin_->digital_write(state);
+    });
+    this->pin_->digital_write(false);
+    this->report_("GPIO write", result, this->gpio_sensor_);
+  }
+
+  float heap = this->measure_(SLOW_ITERATIONS, [&block]() {
+    block = malloc(HEAP_BLOCK_SIZE);  // NOLINT(cppcoreguidelines-no-malloc)
+    free(block);                      // NOLINT(cppcoreguidelines-no-malloc)
+  });
+  this->report_("malloc()+free()", heap, this->heap_sensor_);
+
+  float scheduler = this->measure_(SLOW_ITERATIONS, [this]() {
+    this->set_timeout("benchmark", 60000, []() {});
+    this->cancel_timeout("benchmark");
+  });
+  this->report_("set_timeout()+cancel_timeout()", scheduler, this->scheduler_sensor_);
+
+#ifdef USE_BENCHMARK_I2C
+  if (this->bus_ != nullptr) {
+    uint8_t data[I2C_READ_LENGTH];
+    i2c::ErrorCode err = i2c::ERROR_OK;
+    float result = this->measure_(BUS_ITERATIONS, [this, &data, &err]() {
+      i2c::ErrorCode ret = this->bus_->read(this->address_, data, sizeof(data));
+      if (ret != i2c::ERROR_OK)
+        err = ret;
+    });
+    if (err != i2c::ERROR_OK) {
+      ESP_LOGW(TAG, "I2C reads from 0x%02X failed with error %d", this->address_, err);
+    } else {
+      this->report_("I2C 8 byte read", result, this->i2c_sensor_);
+    }
+  }
+#endif
+
+  if (this->flash_) {
+    float result = this->measure_(FLASH_ITERATIONS, [this]() {
+      // A different value every time, so the write can't be skipped.
+      this->pref_value_++;
+      this->pref_.save(&this->pref_value_);
+      global_preferences->sync();
+    });
+    this->report_("Preference save+sync", result, this->preferences_sensor_);
+  }
+}
+
+void BenchmarkComponent::report_(const char *name, float result, sensor::Sensor *sensor) {
+  ESP_LOGI(TAG, "  %s: %.3f us", name, result);
+  if (sensor != nullptr)
+    sensor->publish_state(result);
+}
+
+}  // namespace benchmark
+}  // namespace esphome
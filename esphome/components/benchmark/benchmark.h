@@ -0,0 +1,86 @@
+#pragma once
+
+#include "esphome/core/application.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/sensor/sensor.h"
+
+#ifdef USE_BENCHMARK_I2C
+#include "esphome/components/i2c/i2c_bus.h"
+#endif
+
+namespace esphome {
+namespace benchmark {
+
+/** Measures how long common HAL and core operations take on this chip.
+ *
+ * Everything goes through the same APIs real components use (GPIOPin, I2CBus, the scheduler and preferences), so
+ * the numbers include their overhead. Results are logged and published to the optional sensors in microseconds per
+ * operation.
+ */
+class BenchmarkComponent : public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::LATE; }
+
+  /// Run all benchmarks now, this blocks the main loop for a few hundred milliseconds.
+  void run();
+
+  void set_run_on_boot(bool run_on_boot) { this->run_on_boot_ = run_on_boot; }
+  void set_flash(bool flash) { this->flash_ = flash; }
+  void set_pin(GPIOPin *pin) { this->pin_ = pin; }
+#ifdef USE_BENCHMARK_I2C
+  void set_i2c(i2c::I2CBus *bus, uint8_t address) {
+    this->bus_ = bus;
+    this->address_ = address;
+  }
+#endif
+  void set_millis_sensor(sensor::Sensor *millis_sensor) { this->millis_sensor_ = millis_sensor; }
+  void set_micros_sensor(sensor::Sensor *micros_sensor) { this->micros_sensor_ = micros_sensor; }
+  void set_gpio_sensor(sensor::Sensor *gpio_sensor) { this->gpio_sensor_ = gpio_sensor; }
+  void set_heap_sensor(sensor::Sensor *heap_sensor) { this->heap_sensor_ = heap_sensor; }
+  void set_scheduler_sensor(sensor::Sensor *scheduler_sensor) { this->scheduler_sensor_ = scheduler_sensor; }
+  void set_i2c_sensor(sensor::Sensor *i2c_sensor) { this->i2c_sensor_ = i2c_sensor; }
+  void set_preferences_sensor(sensor::Sensor *preferences_sensor) { this->preferences_sensor_ = preferences_sensor; }
+
+ protected:
+  /// Call func iterations times and return the average time per call in microseconds.
+  template<typename F> float measure_(uint32_t iterations, F &&func) {
+    const uint32_t start = micros();
+    for (uint32_t i = 0; i < iterations; i++)
+      func();
+    const uint32_t elapsed = micros() - start;
+    App.feed_wdt();
+    return elapsed / static_cast<float>(iterations);
+  }
+  void report_(const char *name, float result, sensor::Sensor *sensor);
+
+  bool run_on_boot_{true};
+  bool flash_{false};
+  GPIOPin *pin_{nullptr};
+#ifdef USE_BENCHMARK_I2C
+  i2c::I2CBus *bus_{nullptr};
+  uint8_t address_{0};
+#endif
+  ESPPreferenceObject pref_;
+  uint32_t pref_value_{0};
+  sensor::Sensor *millis_sensor_{nullptr};
+  sensor::Sensor *micros_sensor_{nullptr};
+  sensor::Sensor *gpio_sensor_{nullptr};
+  sensor::Sensor *heap_sensor_{nullptr};
+  sensor::Sensor *scheduler_sensor_{nullptr};
+  sensor::Sensor *i2c_sensor_{nullptr};
+  sensor::Sensor *preferences_sensor_{nullptr};
+};
+
+template<typename... Ts> class RunAction : public Action<Ts...>, public Parented<BenchmarkComponent> {
+ public:
+  void play(Ts... x) override { this->parent_->run(); }
+};
+
+}  // namespace benchmark
+}  // namespace esphome
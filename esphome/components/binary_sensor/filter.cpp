@@ -26,44 +26,55 @@ void Filter::input(bool value, bool is_initial) {
   }
 }
 
-DelayedOnOffFilter::DelayedOnOffFilter(uint32_t delay) : delay_(delay) {}
-optional<bool> DelayedOnOffFilter::new_value(bool value, bool is_initial) {
-  if (value) {
-    this->set_timeout("ON_OFF", this->delay_, [this, is_initial]() { this->output(true, is_initial); });
-  } else {
-    this->set_timeout("ON_OFF", this->delay_, [this, is_initial]() { this->output(false, is_initial); });
+DelayedOutputFilter::DelayedOutputFilter(uint32_t delay) : delay_(delay) {}
+void DelayedOutputFilter::setup() {
+  // an initial state may already be pending
+  if (!this->timeout_.active)
+    this->disable_loop();
+}
+void DelayedOutputFilter::loop() {
+  if (!this->timeout_.check(millis())) {
+    if (!this->timeout_.active)
+      this->disable_loop();
+    return;
   }
-  return {};
+  this->disable_loop();
+  this->output(this->value_, this->is_initial_);
+}
+void DelayedOutputFilter::output_delayed_(bool value, bool is_initial) {
+  this->value_ = value;
+  this->is_initial_ = is_initial;
+  this->timeout_.set(this->delay_);
+  this->enable_loop();
 }
 
-float DelayedOnOffFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+float DelayedOutputFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+
+optional<bool> DelayedOnOffFilter::new_value(bool value, bool is_initial) {
+  this->output_delayed_(value, is_initial);
+  return {};
+}
 
-DelayedOnFilter::DelayedOnFilter(uint32_t delay) : delay_(delay) {}
 optional<bool> DelayedOnFilter::new_value(bool value, bool is_initial) {
   if (value) {
-    this->set_timeout("ON", this->delay_, [this, is_initial]() { this->output(true, is_initial); });
+    this->output_delayed_(true, is_initial);
     return {};
   } else {
-    this->cancel_timeout("ON");
+    this->cancel_output_();
     return false;
   }
 }
 
-float DelayedOnFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
-
-DelayedOffFilter::DelayedOffFilter(uint32_t delay) : delay_(delay) {}
 optional<bool> DelayedOffFilter::new_value(bool value, bool is_initial) {
   if (!value) {
-    this->set_timeout("OFF", this->delay_, [this, is_initial]() { this->output(false, is_initial); });
+    this->output_delayed_(false, is_initial);
     return {};
   } else {
-    this->cancel_timeout("OFF");
+    this->cancel_output_();
     return true;
   }
 }
 
-float DelayedOffFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
-
 optional<bool> InvertFilter::new_value(bool value, bool is_initial) { return !value; }
 
 AutorepeatFilter::AutorepeatFilter(std::vector<AutorepeatFilterTiming> timings) : timings_(std::move(timings)) {}
@@ -77,20 +88,37 @@ optional<bool> AutorepeatFilter::new_value(bool value, bool is_initial) {
     this->next_timing_();
     return true;
   } else {
-    this->cancel_timeout("TIMING");
-    this->cancel_timeout("ON_OFF");
+    this->timing_timeout_.cancel();
+    this->toggle_timeout_.cancel();
     this->active_timing_ = 0;
     return false;
   }
 }
 
+void AutorepeatFilter::setup() {
+  if (!this->timing_timeout_.active && !this->toggle_timeout_.active)
+    this->disable_loop();
+}
+
+void AutorepeatFilter::loop() {
+  uint32_t now = millis();
+  if (this->timing_timeout_.check(now))
+    this->next_timing_();
+  if (this->toggle_timeout_.check(now))
+    this->next_value_(this->toggle_value_);
+  if (!this->timing_timeout_.active && !this->toggle_timeout_.active)
+    this->disable_loop();
+}
+
 void AutorepeatFilter::next_timing_() {
   // Entering this method
   // 1st time: starts waiting the first delay
   // 2nd time: starts waiting the second delay and starts toggling with the first time_off / _on
   // last time: no delay to start but have to bump the index to reflect the last
-  if (this->active_timing_ < this->timings_.size())
-    this->set_timeout("TIMING", this->timings_[this->active_timing_].delay, [this]() { this->next_timing_(); });
+  if (this->active_timing_ < this->timings_.size()) {
+    this->timing_timeout_.set(this->timings_[this->active_timing_].delay);
+    this->enable_loop();
+  }
 
   if (this->active_timing_ <= this->timings_.size()) {
     this->active_timing_++;
@@ -105,7 +133,9 @@ void AutorepeatFilter::next_timing_() {
 void AutorepeatFilter::next_value_(bool val) {
   const AutorepeatFilterTiming &timing = this->timings_[this->active_timing_ - 2];
   this->output(val, false);  // This is at least the second one so not initial
-  this->set_timeout("ON_OFF", val ? timing.time_on : timing.time_off, [this, val]() { this->next_value_(!val); });
+  this->toggle_value_ = !val;
+  this->toggle_timeout_.set(val ? timing.time_on : timing.time_off);
+  this->enable_loop();
 }
 
 float AutorepeatFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
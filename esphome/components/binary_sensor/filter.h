@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 
 namespace esphome {
@@ -25,40 +26,70 @@ class Filter {
   Deduplicator<bool> dedup_;
 };
 
-class DelayedOnOffFilter : public Filter, public Component {
- public:
-  explicit DelayedOnOffFilter(uint32_t delay);
+/** A deadline that a filter checks in its own loop(), instead of a scheduler timeout.
+ *
+ * Filters with timeouts restart them on every edge of their input. Doing that through set_timeout() means a name
+ * lookup and an allocation for every edge of a bouncing contact, this is just two fields.
+ */
+struct FilterTimeout {
+  uint32_t start{0};
+  uint32_t duration{0};
+  bool active{false};
+
+  void set(uint32_t duration) {
+    this->start = millis();
+    this->duration = duration;
+    this->active = true;
+  }
+  void cancel() { this->active = false; }
+  /// Whether the timeout just expired, it's inactive afterwards.
+  bool check(uint32_t now) {
+    if (!this->active || now - this->start < this->duration)
+      return false;
+    this->active = false;
+    return true;
+  }
+};
 
-  optional<bool> new_value(bool value, bool is_initial) override;
+/// A filter that outputs a value once a timeout expires, its loop() only runs while the timeout is pending.
+class DelayedOutputFilter : public Filter, public Component {
+ public:
+  explicit DelayedOutputFilter(uint32_t delay);
 
+  void setup() override;
+  void loop() override;
   float get_setup_priority() const override;
 
  protected:
+  /// Output value after the delay, replacing a pending output.
+  void output_delayed_(bool value, bool is_initial);
+  void cancel_output_() { this->timeout_.cancel(); }
+
   uint32_t delay_;
+  FilterTimeout timeout_;
+  bool value_{false};
+  bool is_initial_{false};
 };
 
-class DelayedOnFilter : public Filter, public Component {
+class DelayedOnOffFilter : public DelayedOutputFilter {
  public:
-  explicit DelayedOnFilter(uint32_t delay);
+  explicit DelayedOnOffFilter(uint32_t delay) : DelayedOutputFilter(delay) {}
 
   optional<bool> new_value(bool value, bool is_initial) override;
-
-  float get_setup_priority() const override;
-
- protected:
-  uint32_t delay_;
 };
 
-class DelayedOffFilter : public Filter, public Component {
+class DelayedOnFilter : public DelayedOutputFilter {
  public:
-  explicit DelayedOffFilter(uint32_t delay);
+  explicit DelayedOnFilter(uint32_t delay) : DelayedOutputFilter(delay) {}
 
   optional<bool> new_value(bool value, bool is_initial) override;
+};
 
-  float get_setup_priority() const override;
+class DelayedOffFilter : public DelayedOutputFilter {
+ public:
+  explicit DelayedOffFilter(uint32_t delay) : DelayedOutputFilter(delay) {}
 
- protected:
-  uint32_t delay_;
+  optional<bool> new_value(bool value, bool is_initial) override;
 };
 
 class InvertFilter : public Filter {
@@ -83,6 +114,8 @@ class AutorepeatFilter : public Filter, public Component {
 
   optional<bool> new_value(bool value, bool is_initial) override;
 
+  void setup() override;
+  void loop() override;
   float get_setup_priority() const override;
 
  protected:
@@ -91,6 +124,10 @@ class AutorepeatFilter : public Filter, public Component {
 
   std::vector<AutorepeatFilterTiming> timings_;
   uint8_t active_timing_{0};
+  FilterTimeout timing_timeout_;
+  FilterTimeout toggle_timeout_;
+  /// The value to output when toggle_timeout_ expires.
+  bool toggle_value_{false};
 };
 
 class LambdaFilter : public Filter {
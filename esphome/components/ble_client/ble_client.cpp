@@ -21,12 +21,18 @@ void BLEClient::setup() {
   }
   this->set_states_(espbt::ClientState::IDLE);
   this->enabled = true;
+
+  if (this->cache_services_) {
+    this->services_pref_ =
+        global_preferences->make_preference<SavedGattDatabase>(fnv1_hash("ble_client_gatt_" + this->address_str()));
+    if (this->load_services_()) {
+      ESP_LOGD(TAG, "[%s] Loaded %u cached services", this->address_str().c_str(), this->services_.size());
+    }
+  }
 }
 
 void BLEClient::loop() {
-  if (this->state() == espbt::ClientState::DISCOVERED) {
-    this->connect();
-  }
+  // The tracker connects discovered clients one at a time, see ESP32BLETracker::set_max_connections()
   for (auto *node : this->nodes_)
     node->loop();
 }
@@ -34,6 +40,7 @@ void BLEClient::loop() {
 void BLEClient::dump_config() {
   ESP_LOGCONFIG(TAG, "BLE Client:");
   ESP_LOGCONFIG(TAG, "  Address: %s", this->address_str().c_str());
+  ESP_LOGCONFIG(TAG, "  Cache Services: %s", YESNO(this->cache_services_));
 }
 
 bool BLEClient::parse_device(const espbt::ESPBTDevice &device) {
@@ -71,7 +78,10 @@ std::string BLEClient::address_str() const {
 void BLEClient::set_enabled(bool enabled) {
   if (enabled == this->enabled)
     return;
-  if (!enabled && this->state() != espbt::ClientState::IDLE) {
+  if (!enabled && this->state() == espbt::ClientState::DISCOVERED) {
+    // Still waiting for the tracker to connect it, giving up the place in the queue is enough
+    this->set_states_(espbt::ClientState::IDLE);
+  } else if (!enabled && this->state() != espbt::ClientState::IDLE) {
     ESP_LOGI(TAG, "[%s] Disabling BLE client.", this->address_str().c_str());
     auto ret = esp_ble_gattc_close(this->gattc_if, this->conn_id);
     if (ret) {
@@ -100,6 +110,7 @@ void BLEClient::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t es
     return;
 
   bool all_established = this->all_nodes_established_();
+  bool replay_search = false;
 
   switch (event) {
     case ESP_GATTC_REG_EVT: {
@@ -132,6 +143,17 @@ void BLEClient::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t es
         break;
       }
       ESP_LOGV(TAG, "cfg_mtu status %d, mtu %d", param->cfg_mtu.status, param->cfg_mtu.mtu);
+      if (this->services_cached_) {
+        // Only trust the cache if the device says its database didn't change
+        if (this->db_hash_handle_ != 0 && this->read_db_hash_(DbHashRead::VERIFY))
+          break;
+        if (this->db_hash_handle_ == 0) {
+          ESP_LOGD(TAG, "[%s] Using cached services", this->address_str().c_str());
+          replay_search = true;
+          break;
+        }
+        this->release_services_();
+      }
       esp_ble_gattc_search_service(esp_gattc_if, param->cfg_mtu.conn_id, nullptr);
       break;
     }
@@ -140,12 +162,29 @@ void BLEClient::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t es
         return;
       }
       ESP_LOGV(TAG, "[%s] ESP_GATTC_DISCONNECT_EVT", this->address_str().c_str());
-      for (auto &svc : this->services_)
-        delete svc;  // NOLINT(cppcoreguidelines-owning-memory)
-      this->services_.clear();
+      if (!this->services_cached_)
+        this->release_services_();
+      this->db_hash_read_ = DbHashRead::NONE;
       this->set_states_(espbt::ClientState::IDLE);
       break;
     }
+    case ESP_GATTC_READ_CHAR_EVT: {
+      if (this->db_hash_read_ != DbHashRead::NONE && param->read.handle == this->db_hash_handle_) {
+        replay_search = this->handle_db_hash_read_(param->read);
+        break;
+      }
+      this->check_cached_handle_(param->read.status, param->read.handle);
+      break;
+    }
+    case ESP_GATTC_READ_DESCR_EVT: {
+      this->check_cached_handle_(param->read.status, param->read.handle);
+      break;
+    }
+    case ESP_GATTC_WRITE_CHAR_EVT:
+    case ESP_GATTC_WRITE_DESCR_EVT: {
+      this->check_cached_handle_(param->write.status, param->write.handle);
+      break;
+    }
     case ESP_GATTC_SEARCH_RES_EVT: {
       BLEService *ble_service = new BLEService();  // NOLINT(cppcoreguidelines-owning-memory)
       ble_service->uuid = espbt::ESPBTUUID::from_uuid(param->search_res.srvc_id.uuid);
@@ -157,10 +196,19 @@ void BLEClient::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t es
     }
     case ESP_GATTC_SEARCH_CMPL_EVT: {
       ESP_LOGV(TAG, "[%s] ESP_GATTC_SEARCH_CMPL_EVT", this->address_str().c_str());
-      for (auto &svc : this->services_) {
-        ESP_LOGI(TAG, "Service UUID: %s", svc->uuid.to_string().c_str());
-        ESP_LOGI(TAG, "  start_handle: 0x%x  end_handle: 0x%x", svc->start_handle, svc->end_handle);
-        svc->parse_characteristics();
+      if (!this->services_cached_) {
+        for (auto &svc : this->services_) {
+          ESP_LOGI(TAG, "Service UUID: %s", svc->uuid.to_string().c_str());
+          ESP_LOGI(TAG, "  start_handle: 0x%x  end_handle: 0x%x", svc->start_handle, svc->end_handle);
+          svc->parse_characteristics();
+        }
+        if (this->cache_services_) {
+          this->services_cached_ = true;
+          // The hash is saved with the services, so reconnects can tell whether they are still valid
+          this->db_hash_handle_ = this->find_db_hash_handle_();
+          if (this->db_hash_handle_ == 0 || !this->read_db_hash_(DbHashRead::SAVE))
+            this->save_services_(nullptr);
+        }
       }
       this->set_states_(espbt::ClientState::CONNECTED);
       this->set_state(espbt::ClientState::ESTABLISHED);
@@ -193,11 +241,176 @@ void BLEClient::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t es
   for (auto *node : this->nodes_)
     node->gattc_event_handler(event, esp_gattc_if, param);
 
-  // Delete characteristics after clients have used them to save RAM.
-  if (!all_established && this->all_nodes_established_()) {
-    for (auto &svc : this->services_)
-      delete svc;  // NOLINT(cppcoreguidelines-owning-memory)
-    this->services_.clear();
+  // Delete characteristics after clients have used them to save RAM, unless they are kept for the next connection.
+  if (!all_established && !this->services_cached_ && this->all_nodes_established_())
+    this->release_services_();
+
+  if (replay_search) {
+    // Nodes look up their handles when the search completes, give them the cached services as if it just did
+    esp_ble_gattc_cb_param_t search_cmpl{};
+    search_cmpl.search_cmpl.status = ESP_GATT_OK;
+    search_cmpl.search_cmpl.conn_id = this->conn_id;
+    this->gattc_event_handler(ESP_GATTC_SEARCH_CMPL_EVT, esp_gattc_if, &search_cmpl);
+  }
+}
+
+void BLEClient::release_services_() {
+  for (auto &svc : this->services_)
+    delete svc;  // NOLINT(cppcoreguidelines-owning-memory)
+  this->services_.clear();
+  this->services_cached_ = false;
+  this->db_hash_handle_ = 0;
+}
+
+void BLEClient::check_cached_handle_(esp_gatt_status_t status, uint16_t handle) {
+  if (!this->services_cached_ || (status != ESP_GATT_INVALID_HANDLE && status != ESP_GATT_NOT_FOUND))
+    return;
+  ESP_LOGW(TAG, "[%s] Cached handle 0x%x is invalid, discovering services on the next connection",
+           this->address_str().c_str(), handle);
+  // Released on disconnect
+  this->services_cached_ = false;
+}
+
+uint16_t BLEClient::find_db_hash_handle_() {
+  auto *chr = this->get_characteristic(ESP_GATT_UUID_GATT_SRV, GATT_DATABASE_HASH_UUID);
+  return chr == nullptr ? 0 : chr->handle;
+}
+
+bool BLEClient::read_db_hash_(DbHashRead read) {
+  auto status = esp_ble_gattc_read_char(this->gattc_if, this->conn_id, this->db_hash_handle_, ESP_GATT_AUTH_REQ_NONE);
+  if (status) {
+    ESP_LOGW(TAG, "[%s] Error reading the GATT database hash, status=%d", this->address_str().c_str(), status);
+    return false;
+  }
+  this->db_hash_read_ = read;
+  return true;
+}
+
+bool BLEClient::handle_db_hash_read_(const esp_ble_gattc_cb_param_t::gattc_read_char_evt_param &param) {
+  const bool valid = param.status == ESP_GATT_OK && param.value_len == sizeof(this->db_hash_);
+  const DbHashRead read = this->db_hash_read_;
+  this->db_hash_read_ = DbHashRead::NONE;
+  if (read == DbHashRead::SAVE) {
+    this->save_services_(valid ? param.value : nullptr);
+    return false;
+  }
+
+  if (valid && memcmp(param.value, this->db_hash_, sizeof(this->db_hash_)) == 0) {
+    ESP_LOGD(TAG, "[%s] Using cached services", this->address_str().c_str());
+    return true;
+  }
+  ESP_LOGD(TAG, "[%s] GATT database changed, discovering services", this->address_str().c_str());
+  this->release_services_();
+  esp_ble_gattc_search_service(this->gattc_if, this->conn_id, nullptr);
+  return false;
+}
+
+bool BLEClient::load_services_() {
+  auto saved = make_unique<SavedGattDatabase>();
+  if (!this->services_pref_.load(saved.get()) || saved->address != this->address)
+    return false;
+  if (saved->service_count > MAX_SAVED_SERVICES || saved->characteristic_count > MAX_SAVED_CHARACTERISTICS ||
+      saved->descriptor_count > MAX_SAVED_DESCRIPTORS)
+    return false;
+
+  std::vector<BLECharacteristic *> characteristics;
+  for (uint8_t i = 0; i < saved->service_count; i++) {
+    auto *svc = new BLEService();  // NOLINT(cppcoreguidelines-owning-memory)
+    svc->uuid = espbt::ESPBTUUID::from_uuid(saved->services[i].uuid);
+    svc->start_handle = saved->services[i].start_handle;
+    svc->end_handle = saved->services[i].end_handle;
+    svc->client = this;
+    this->services_.push_back(svc);
+  }
+  for (uint8_t i = 0; i < saved->characteristic_count; i++) {
+    const auto &entry = saved->characteristics[i];
+    if (entry.service >= this->services_.size()) {
+      this->release_services_();
+      return false;
+    }
+    auto *chr = new BLECharacteristic();  // NOLINT(cppcoreguidelines-owning-memory)
+    chr->uuid = espbt::ESPBTUUID::from_uuid(entry.uuid);
+    chr->handle = entry.handle;
+    chr->properties = entry.properties;
+    chr->service = this->services_[entry.service];
+    chr->service->characteristics.push_back(chr);
+    characteristics.push_back(chr);
+  }
+  for (uint8_t i = 0; i < saved->descriptor_count; i++) {
+    const auto &entry = saved->descriptors[i];
+    if (entry.characteristic >= characteristics.size()) {
+      this->release_services_();
+      return false;
+    }
+    auto *desc = new BLEDescriptor();  // NOLINT(cppcoreguidelines-owning-memory)
+    desc->uuid = espbt::ESPBTUUID::from_uuid(entry.uuid);
+    desc->handle = entry.handle;
+    desc->characteristic = characteristics[entry.characteristic];
+    desc->characteristic->descriptors.push_back(desc);
+  }
+
+  memcpy(this->db_hash_, saved->db_hash, sizeof(this->db_hash_));
+  this->db_hash_handle_ = saved->db_hash_handle;
+  this->services_cached_ = true;
+  return true;
+}
+
+void BLEClient::save_services_(const uint8_t *db_hash) {
+  if (db_hash != nullptr) {
+    memcpy(this->db_hash_, db_hash, sizeof(this->db_hash_));
+  } else {
+    this->db_hash_handle_ = 0;
+  }
+
+  auto saved = make_unique<SavedGattDatabase>();
+  saved->address = this->address;
+  if (this->db_hash_handle_ != 0) {
+    memcpy(saved->db_hash, this->db_hash_, sizeof(saved->db_hash));
+    saved->db_hash_handle = this->db_hash_handle_;
+  }
+  for (auto *svc : this->services_) {
+    if (saved->service_count == MAX_SAVED_SERVICES)
+      break;
+    auto &svc_entry = saved->services[saved->service_count];
+    svc_entry.uuid = svc->uuid.get_uuid();
+    svc_entry.start_handle = svc->start_handle;
+    svc_entry.end_handle = svc->end_handle;
+    for (auto *chr : svc->characteristics) {
+      if (saved->characteristic_count == MAX_SAVED_CHARACTERISTICS)
+        break;
+      auto &chr_entry = saved->characteristics[saved->characteristic_count];
+      chr_entry.uuid = chr->uuid.get_uuid();
+      chr_entry.handle = chr->handle;
+      chr_entry.properties = chr->properties;
+      chr_entry.service = saved->service_count;
+      for (auto *desc : chr->descriptors) {
+        if (saved->descriptor_count == MAX_SAVED_DESCRIPTORS)
+          break;
+        auto &desc_entry = saved->descriptors[saved->descriptor_count++];
+        desc_entry.uuid = desc->uuid.get_uuid();
+        desc_entry.handle = desc->handle;
+        desc_entry.characteristic = saved->characteristic_count;
+      }
+      saved->characteristic_count++;
+    }
+    saved->service_count++;
+  }
+
+  size_t characteristic_count = 0, descriptor_count = 0;
+  for (auto *svc : this->services_) {
+    characteristic_count += svc->characteristics.size();
+    for (auto *chr : svc->characteristics)
+      descriptor_count += chr->descriptors.size();
+  }
+  if (this->services_.size() > saved->service_count || characteristic_count > saved->characteristic_count ||
+      descriptor_count > saved->descriptor_count) {
+    // A partial table would hide attributes from the nodes, only keep it in RAM
+    ESP_LOGW(TAG, "[%s] Too many attributes to save the services, they are only cached until reboot",
+             this->address_str().c_str());
+    return;
+  }
+  if (this->services_pref_.save(saved.get())) {
+    ESP_LOGD(TAG, "[%s] Saved %u services", this->address_str().c_str(), saved->service_count);
   }
 }
 
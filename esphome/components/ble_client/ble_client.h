@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
 #include "esphome/components/esp32_ble_tracker/esp32_ble_tracker.h"
 
 #ifdef USE_ESP32
@@ -76,6 +77,42 @@ class BLEService {
   BLECharacteristic *get_characteristic(uint16_t uuid);
 };
 
+/// Capacity of the attribute table kept in preferences, devices with more attributes are only cached in RAM.
+static const uint8_t MAX_SAVED_SERVICES = 8;
+static const uint8_t MAX_SAVED_CHARACTERISTICS = 24;
+static const uint8_t MAX_SAVED_DESCRIPTORS = 24;
+/// Characteristic in the Generic Attribute service that changes whenever the device's GATT database does.
+static const uint16_t GATT_DATABASE_HASH_UUID = 0x2B2A;
+
+/// The services, characteristics and descriptors of a device as stored in preferences by BLEClient.
+struct SavedGattDatabase {
+  uint64_t address;
+  /// Value of the Database Hash characteristic when the table was saved, all zero if the device has none.
+  uint8_t db_hash[16];
+  uint16_t db_hash_handle;
+  uint8_t service_count;
+  uint8_t characteristic_count;
+  uint8_t descriptor_count;
+  struct {
+    esp_bt_uuid_t uuid;
+    uint16_t start_handle;
+    uint16_t end_handle;
+  } services[MAX_SAVED_SERVICES];
+  struct {
+    esp_bt_uuid_t uuid;
+    uint16_t handle;
+    esp_gatt_char_prop_t properties;
+    /// Index into services.
+    uint8_t service;
+  } characteristics[MAX_SAVED_CHARACTERISTICS];
+  struct {
+    esp_bt_uuid_t uuid;
+    uint16_t handle;
+    /// Index into characteristics.
+    uint8_t characteristic;
+  } descriptors[MAX_SAVED_DESCRIPTORS];
+};
+
 class BLEClient : public espbt::ESPBTClient, public Component {
  public:
   void setup() override;
@@ -90,6 +127,11 @@ class BLEClient : public espbt::ESPBTClient, public Component {
   void connect() override;
 
   void set_address(uint64_t address) { this->address = address; }
+  /** Keep the services, characteristics and descriptors found on the device after it disconnects (and in
+   * preferences across reboots), reconnects then skip service discovery. The cache is dropped when the device's
+   * Database Hash changed or it reports an invalid handle.
+   */
+  void set_cache_services(bool cache_services) { this->cache_services_ = cache_services; }
 
   void set_enabled(bool enabled);
 
@@ -118,6 +160,15 @@ class BLEClient : public espbt::ESPBTClient, public Component {
   std::string address_str() const;
 
  protected:
+  /// What the pending read of the Database Hash is for.
+  enum class DbHashRead : uint8_t {
+    NONE,
+    /// Check that the cached services are still valid.
+    VERIFY,
+    /// Save the services that were just discovered.
+    SAVE,
+  };
+
   void set_states_(espbt::ClientState st) {
     this->set_state(st);
     for (auto &node : nodes_)
@@ -132,8 +183,31 @@ class BLEClient : public espbt::ESPBTClient, public Component {
     return true;
   }
 
+  /// Delete all services (and their characteristics and descriptors).
+  void release_services_();
+  /// Rebuild services_ from the table saved in preferences, if there is one for this device.
+  bool load_services_();
+  /// Save services_ and the given Database Hash value (nullptr if the device has none) to preferences.
+  void save_services_(const uint8_t *db_hash);
+  /// Handle of the Database Hash characteristic in services_, 0 if there is none.
+  uint16_t find_db_hash_handle_();
+  /// Read the Database Hash characteristic, calls handle_db_hash_read_() when done.
+  bool read_db_hash_(DbHashRead read);
+  /// Returns whether the cached services can be used for this connection.
+  bool handle_db_hash_read_(const esp_ble_gattc_cb_param_t::gattc_read_char_evt_param &param);
+  /// Drop the cached services if the status of an operation on handle says they no longer match the device.
+  void check_cached_handle_(esp_gatt_status_t status, uint16_t handle);
+
   std::vector<BLEClientNode *> nodes_;
   std::vector<BLEService *> services_;
+  bool cache_services_{false};
+  /// services_ holds the complete result of a previous service discovery.
+  bool services_cached_{false};
+  ESPPreferenceObject services_pref_;
+  /// Database Hash the cached services were discovered with, compared after connecting when db_hash_handle_ is set.
+  uint8_t db_hash_[16]{};
+  uint16_t db_hash_handle_{0};
+  DbHashRead db_hash_read_{DbHashRead::NONE};
 };
 
 }  // namespace ble_client
@@ -0,0 +1,39 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import esp32_ble_tracker
+from esphome.const import CONF_ID
+
+DEPENDENCIES = ["api", "esp32_ble_tracker"]
+
+CONF_BATCH_INTERVAL = "batch_interval"
+CONF_MIN_INTERVAL = "min_interval"
+
+bluetooth_proxy_ns = cg.esphome_ns.namespace("bluetooth_proxy")
+BluetoothProxy = bluetooth_proxy_ns.class_(
+    "BluetoothProxy", cg.Component, esp32_ble_tracker.ESPBTDeviceListener
+)
+
+CONFIG_SCHEMA = (
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(BluetoothProxy),
+            cv.Optional(
+                CONF_BATCH_INTERVAL, default="100ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_MIN_INTERVAL, default="0ms"
+            ): cv.positive_time_period_milliseconds,
+        }
+    )
+    .extend(esp32_ble_tracker.ESP_BLE_DEVICE_SCHEMA)
+    .extend(cv.COMPONENT_SCHEMA)
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await esp32_ble_tracker.register_ble_device(var, config)
+    cg.add(var.set_batch_interval(config[CONF_BATCH_INTERVAL]))
+    cg.add(var.set_min_interval(config[CONF_MIN_INTERVAL]))
+    cg.add_define("USE_BLUETOOTH_PROXY")
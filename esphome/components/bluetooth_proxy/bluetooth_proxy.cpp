@@ -0,0 +1,79 @@
+#include "bluetooth_proxy.h"
+#include "esphome/components/api/api_server.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#ifdef USE_ESP32
+
+namespace esphome {
+namespace bluetooth_proxy {
+
+static const char *const TAG = "bluetooth_proxy";
+
+bool BluetoothProxy::parse_device(const esp32_ble_tracker::ESPBTDevice &device) {
+  if (!api::global_api_server->has_bluetooth_le_advertisement_subscribers())
+    return false;
+
+  const uint32_t now = millis();
+  const uint64_t address = device.address_uint64();
+  if (this->min_interval_ != 0) {
+    auto it = this->last_forwarded_.find(address);
+    if (it != this->last_forwarded_.end()) {
+      if (now - it->second < this->min_interval_)
+        return false;
+      it->second = now;
+    } else {
+      if (this->last_forwarded_.size() >= MAX_TRACKED_DEVICES) {
+        // Forget devices whose interval has passed anyway, or everything if that's not enough
+        for (auto old = this->last_forwarded_.begin(); old != this->last_forwarded_.end();) {
+          if (now - old->second >= this->min_interval_) {
+            old = this->last_forwarded_.erase(old);
+          } else {
+            ++old;
+          }
+        }
+        if (this->last_forwarded_.size() >= MAX_TRACKED_DEVICES)
+          this->last_forwarded_.clear();
+      }
+      this->last_forwarded_[address] = now;
+    }
+  }
+
+  if (this->batch_.advertisements.empty())
+    this->batch_start_ = now;
+  const auto &param = device.get_scan_result();
+  this->batch_.advertisements.emplace_back();
+  auto &adv = this->batch_.advertisements.back();
+  adv.address = address;
+  adv.rssi = device.get_rssi();
+  adv.address_type = device.get_address_type();
+  adv.data.assign(reinterpret_cast<const char *>(param.ble_adv), param.adv_data_len + param.scan_rsp_len);
+  if (this->batch_.advertisements.size() >= MAX_BATCH_SIZE)
+    this->flush_();
+
+  // Forwarding doesn't count as handling the device, so unknown devices are still logged
+  return false;
+}
+
+void BluetoothProxy::loop() {
+  if (!this->batch_.advertisements.empty() && millis() - this->batch_start_ >= this->batch_interval_)
+    this->flush_();
+}
+
+void BluetoothProxy::flush_() {
+  api::global_api_server->send_bluetooth_le_advertisements(this->batch_);
+  this->batch_.advertisements.clear();
+}
+
+void BluetoothProxy::dump_config() {
+  ESP_LOGCONFIG(TAG, "Bluetooth Proxy:");
+  ESP_LOGCONFIG(TAG, "  Batch Interval: %u ms", this->batch_interval_);
+  if (this->min_interval_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Min Interval: %u ms", this->min_interval_);
+  }
+}
+
+}  // namespace bluetooth_proxy
+}  // namespace esphome
+
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/api/api_pb2.h"
+#include "esphome/components/esp32_ble_tracker/esp32_ble_tracker.h"
+
+#ifdef USE_ESP32
+
+#include <unordered_map>
+
+namespace esphome {
+namespace bluetooth_proxy {
+
+/** Forwards the raw advertisements seen by the tracker to API clients, which decode them themselves.
+ *
+ * Advertisements are collected into batches that are sent after batch_interval or once MAX_BATCH_SIZE is reached.
+ * With min_interval, at most one advertisement per device is forwarded in that time.
+ */
+class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Component {
+ public:
+  void set_batch_interval(uint32_t batch_interval) { this->batch_interval_ = batch_interval; }
+  void set_min_interval(uint32_t min_interval) { this->min_interval_ = min_interval; }
+
+  bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_BLUETOOTH; }
+
+ protected:
+  static const size_t MAX_BATCH_SIZE = 16;
+  /// Number of devices whose last forward time is remembered for min_interval.
+  static const size_t MAX_TRACKED_DEVICES = 256;
+
+  void flush_();
+
+  api::BluetoothLERawAdvertisementsResponse batch_;
+  /// millis() at which the first advertisement of the current batch was added.
+  uint32_t batch_start_{0};
+  /// When each device was last forwarded, only used with min_interval.
+  std::unordered_map<uint64_t, uint32_t> last_forwarded_;
+  uint32_t batch_interval_{100};
+  uint32_t min_interval_{0};
+};
+
+}  // namespace bluetooth_proxy
+}  // namespace esphome
+
+#endif
@@ -92,27 +92,45 @@ void BME280Component::setup() {
     return;
   }
 
-  // Read calibration
-  this->calibration_.t1 = read_u16_le_(BME280_REGISTER_DIG_T1);
-  this->calibration_.t2 = read_s16_le_(BME280_REGISTER_DIG_T2);
-  this->calibration_.t3 = read_s16_le_(BME280_REGISTER_DIG_T3);
-
-  this->calibration_.p1 = read_u16_le_(BME280_REGISTER_DIG_P1);
-  this->calibration_.p2 = read_s16_le_(BME280_REGISTER_DIG_P2);
-  this->calibration_.p3 = read_s16_le_(BME280_REGISTER_DIG_P3);
-  this->calibration_.p4 = read_s16_le_(BME280_REGISTER_DIG_P4);
-  this->calibration_.p5 = read_s16_le_(BME280_REGISTER_DIG_P5);
-  this->calibration_.p6 = read_s16_le_(BME280_REGISTER_DIG_P6);
-  this->calibration_.p7 = read_s16_le_(BME280_REGISTER_DIG_P7);
-  this->calibration_.p8 = read_s16_le_(BME280_REGISTER_DIG_P8);
-  this->calibration_.p9 = read_s16_le_(BME280_REGISTER_DIG_P9);
-
-  this->calibration_.h1 = read_u8_(BME280_REGISTER_DIG_H1);
-  this->calibration_.h2 = read_s16_le_(BME280_REGISTER_DIG_H2);
-  this->calibration_.h3 = read_u8_(BME280_REGISTER_DIG_H3);
-  this->calibration_.h4 = read_u8_(BME280_REGISTER_DIG_H4) << 4 | (read_u8_(BME280_REGISTER_DIG_H4 + 1) & 0x0F);
-  this->calibration_.h5 = read_u8_(BME280_REGISTER_DIG_H5 + 1) << 4 | (read_u8_(BME280_REGISTER_DIG_H5) >> 4);
-  this->calibration_.h6 = read_u8_(BME280_REGISTER_DIG_H6);
+  // Read calibration, the three register blocks are fetched in one transfer
+  uint8_t tp[24];
+  uint8_t h1;
+  uint8_t h[7];
+  auto batch = this->batch();
+  batch.read_register(BME280_REGISTER_DIG_T1, tp, sizeof(tp));
+  batch.read_register(BME280_REGISTER_DIG_H1, &h1, 1);
+  batch.read_register(BME280_REGISTER_DIG_H2, h, sizeof(h));
+  if (batch.execute() != i2c::ERROR_OK) {
+    this->error_code_ = COMMUNICATION_FAILED;
+    this->mark_failed();
+    return;
+  }
+  auto tp_u16 = [&tp](uint8_t reg) -> uint16_t {
+    uint8_t i = reg - BME280_REGISTER_DIG_T1;
+    return tp[i] | (tp[i + 1] << 8);
+  };
+  auto h_u8 = [&h](uint8_t reg) -> uint8_t { return h[reg - BME280_REGISTER_DIG_H2]; };
+
+  this->calibration_.t1 = tp_u16(BME280_REGISTER_DIG_T1);
+  this->calibration_.t2 = tp_u16(BME280_REGISTER_DIG_T2);
+  this->calibration_.t3 = tp_u16(BME280_REGISTER_DIG_T3);
+
+  this->calibration_.p1 = tp_u16(BME280_REGISTER_DIG_P1);
+  this->calibration_.p2 = tp_u16(BME280_REGISTER_DIG_P2);
+  this->calibration_.p3 = tp_u16(BME280_REGISTER_DIG_P3);
+  this->calibration_.p4 = tp_u16(BME280_REGISTER_DIG_P4);
+  this->calibration_.p5 = tp_u16(BME280_REGISTER_DIG_P5);
+  this->calibration_.p6 = tp_u16(BME280_REGISTER_DIG_P6);
+  this->calibration_.p7 = tp_u16(BME280_REGISTER_DIG_P7);
+  this->calibration_.p8 = tp_u16(BME280_REGISTER_DIG_P8);
+  this->calibration_.p9 = tp_u16(BME280_REGISTER_DIG_P9);
+
+  this->calibration_.h1 = h1;
+  this->calibration_.h2 = h_u8(BME280_REGISTER_DIG_H2) | (h_u8(BME280_REGISTER_DIG_H2 + 1) << 8);
+  this->calibration_.h3 = h_u8(BME280_REGISTER_DIG_H3);
+  this->calibration_.h4 = h_u8(BME280_REGISTER_DIG_H4) << 4 | (h_u8(BME280_REGISTER_DIG_H4 + 1) & 0x0F);
+  this->calibration_.h5 = h_u8(BME280_REGISTER_DIG_H5 + 1) << 4 | (h_u8(BME280_REGISTER_DIG_H5) >> 4);
+  this->calibration_.h6 = h_u8(BME280_REGISTER_DIG_H6);
 
   uint8_t humid_control_val = 0;
   if (!this->read_byte(BME280_REGISTER_CONTROLHUMID, &humid_control_val)) {
@@ -303,17 +321,6 @@ void BME280Component::set_humidity_oversampling(BME280Oversampling humidity_over
   this->humidity_oversampling_ = humidity_over_sampling;
 }
 void BME280Component::set_iir_filter(BME280IIRFilter iir_filter) { this->iir_filter_ = iir_filter; }
-uint8_t BME280Component::read_u8_(uint8_t a_register) {
-  uint8_t data = 0;
-  this->read_byte(a_register, &data);
-  return data;
-}
-uint16_t BME280Component::read_u16_le_(uint8_t a_register) {
-  uint16_t data = 0;
-  this->read_byte_16(a_register, &data);
-  return (data >> 8) | (data << 8);
-}
-int16_t BME280Component::read_s16_le_(uint8_t a_register) { return this->read_u16_le_(a_register); }
 
 }  // namespace bme280
 }  // namespace esphome
@@ -87,9 +87,6 @@ class BME280Component : public PollingComponent, public i2c::I2CDevice {
   float read_pressure_(const uint8_t *data, int32_t t_fine);
   /// Read the humidity value in % using the provided t_fine value.
   float read_humidity_(const uint8_t *data, int32_t t_fine);
-  uint8_t read_u8_(uint8_t a_register);
-  uint16_t read_u16_le_(uint8_t a_register);
-  int16_t read_s16_le_(uint8_t a_register);
 
   BME280CalibrationData calibration_;
   BME280Oversampling temperature_oversampling_{BME280_OVERSAMPLING_16X};
@@ -9,6 +9,9 @@ namespace bme680_bsec {
 static const char *const TAG = "bme680_bsec.sensor";
 
 static const std::string IAQ_ACCURACY_STATES[4] = {"Stabilizing", "Uncertain", "Calibrating", "Calibrated"};
+// Polling interval and limit while the sensor is still measuring after the profile duration
+static const uint32_t READ_RETRY_INTERVAL_MS = 5;
+static const uint8_t MAX_READ_ATTEMPTS = 40;
 
 BME680BSECComponent *BME680BSECComponent::instance;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
@@ -219,15 +222,25 @@ void BME680BSECComponent::run_() {
   }
 }
 
-void BME680BSECComponent::read_(int64_t trigger_time_ns, bsec_bme_settings_t bme680_settings) {
+void BME680BSECComponent::read_(int64_t trigger_time_ns, bsec_bme_settings_t bme680_settings, uint8_t attempt) {
   ESP_LOGV(TAG, "Reading data");
 
   if (bme680_settings.trigger_measurement) {
-    while (this->bme680_.power_mode != BME680_SLEEP_MODE) {
-      this->bme680_status_ = bme680_get_sensor_mode(&this->bme680_);
-      if (this->bme680_status_ != BME680_OK) {
-        ESP_LOGW(TAG, "Failed to get sensor mode (BME680 Error Code %d)", this->bme680_status_);
+    this->bme680_status_ = bme680_get_sensor_mode(&this->bme680_);
+    if (this->bme680_status_ != BME680_OK) {
+      ESP_LOGW(TAG, "Failed to get sensor mode (BME680 Error Code %d)", this->bme680_status_);
+    }
+    if (this->bme680_.power_mode != BME680_SLEEP_MODE) {
+      // The measurement takes longer than the profile duration, check again later instead of polling in a loop
+      if (attempt >= MAX_READ_ATTEMPTS) {
+        ESP_LOGW(TAG, "Measurement did not finish in time");
+        return;
       }
+      ESP_LOGV(TAG, "Measurement not finished, checking again in %ums", READ_RETRY_INTERVAL_MS);
+      this->set_timeout("read", READ_RETRY_INTERVAL_MS, [this, trigger_time_ns, bme680_settings, attempt]() {
+        this->read_(trigger_time_ns, bme680_settings, attempt + 1);
+      });
+      return;
     }
   }
 
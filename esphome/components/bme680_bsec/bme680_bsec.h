@@ -66,7 +66,7 @@ class BME680BSECComponent : public Component, public i2c::I2CDevice {
   void update_subscription_();
 
   void run_();
-  void read_(int64_t trigger_time_ns, bsec_bme_settings_t bme680_settings);
+  void read_(int64_t trigger_time_ns, bsec_bme_settings_t bme680_settings, uint8_t attempt = 0);
   void publish_(const bsec_output_t *outputs, uint8_t num_outputs);
   int64_t get_time_ns_();
 
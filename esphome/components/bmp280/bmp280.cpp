@@ -66,20 +66,29 @@ void BMP280Component::setup() {
     return;
   }
 
-  // Read calibration
-  this->calibration_.t1 = this->read_u16_le_(0x88);
-  this->calibration_.t2 = this->read_s16_le_(0x8A);
-  this->calibration_.t3 = this->read_s16_le_(0x8C);
-
-  this->calibration_.p1 = this->read_u16_le_(0x8E);
-  this->calibration_.p2 = this->read_s16_le_(0x90);
-  this->calibration_.p3 = this->read_s16_le_(0x92);
-  this->calibration_.p4 = this->read_s16_le_(0x94);
-  this->calibration_.p5 = this->read_s16_le_(0x96);
-  this->calibration_.p6 = this->read_s16_le_(0x98);
-  this->calibration_.p7 = this->read_s16_le_(0x9A);
-  this->calibration_.p8 = this->read_s16_le_(0x9C);
-  this->calibration_.p9 = this->read_s16_le_(0x9E);
+  // Read calibration, the 12 little endian words from 0x88 in one burst
+  uint8_t calibration[24];
+  if (!this->read_bytes(0x88, calibration, sizeof(calibration))) {
+    this->error_code_ = COMMUNICATION_FAILED;
+    this->mark_failed();
+    return;
+  }
+  auto calibration_u16 = [&calibration](size_t i) -> uint16_t {
+    return calibration[i * 2] | (calibration[i * 2 + 1] << 8);
+  };
+  this->calibration_.t1 = calibration_u16(0);
+  this->calibration_.t2 = calibration_u16(1);
+  this->calibration_.t3 = calibration_u16(2);
+
+  this->calibration_.p1 = calibration_u16(3);
+  this->calibration_.p2 = calibration_u16(4);
+  this->calibration_.p3 = calibration_u16(5);
+  this->calibration_.p4 = calibration_u16(6);
+  this->calibration_.p5 = calibration_u16(7);
+  this->calibration_.p6 = calibration_u16(8);
+  this->calibration_.p7 = calibration_u16(9);
+  this->calibration_.p8 = calibration_u16(10);
+  this->calibration_.p9 = calibration_u16(11);
 
   uint8_t config_register = 0;
   if (!this->read_byte(BMP280_REGISTER_CONFIG, &config_register)) {
@@ -137,14 +146,22 @@ void BMP280Component::update() {
   meas_time += 2.3f * oversampling_to_time(this->pressure_oversampling_) + 0.575f;
 
   this->set_timeout("data", uint32_t(ceilf(meas_time)), [this]() {
+    // Pressure and temperature in one burst, so both are from the same measurement
+    uint8_t data[6];
+    if (!this->read_bytes(BMP280_REGISTER_PRESSUREDATA, data, sizeof(data))) {
+      ESP_LOGW(TAG, "Error reading measurement.");
+      this->status_set_warning();
+      return;
+    }
+    const uint8_t *temperature_data = data + (BMP280_REGISTER_TEMPDATA - BMP280_REGISTER_PRESSUREDATA);
     int32_t t_fine = 0;
-    float temperature = this->read_temperature_(&t_fine);
+    float temperature = this->read_temperature_(temperature_data, &t_fine);
     if (std::isnan(temperature)) {
       ESP_LOGW(TAG, "Invalid temperature, cannot read pressure values.");
       this->status_set_warning();
       return;
     }
-    float pressure = this->read_pressure_(t_fine);
+    float pressure = this->read_pressure_(data, t_fine);
 
     ESP_LOGD(TAG, "Got temperature=%.1f°C pressure=%.1fhPa", temperature, pressure);
     if (this->temperature_sensor_ != nullptr)
@@ -155,10 +172,7 @@ void BMP280Component::update() {
   });
 }
 
-float BMP280Component::read_temperature_(int32_t *t_fine) {
-  uint8_t data[3];
-  if (!this->read_bytes(BMP280_REGISTER_TEMPDATA, data, 3))
-    return NAN;
+float BMP280Component::read_temperature_(const uint8_t *data, int32_t *t_fine) {
   int32_t adc = ((data[0] & 0xFF) << 16) | ((data[1] & 0xFF) << 8) | (data[2] & 0xFF);
   adc >>= 4;
   if (adc == 0x80000)
@@ -177,10 +191,7 @@ float BMP280Component::read_temperature_(int32_t *t_fine) {
   return temperature / 100.0f;
 }
 
-float BMP280Component::read_pressure_(int32_t t_fine) {
-  uint8_t data[3];
-  if (!this->read_bytes(BMP280_REGISTER_PRESSUREDATA, data, 3))
-    return NAN;
+float BMP280Component::read_pressure_(const uint8_t *data, int32_t t_fine) {
   int32_t adc = ((data[0] & 0xFF) << 16) | ((data[1] & 0xFF) << 8) | (data[2] & 0xFF);
   adc >>= 4;
   if (adc == 0x80000)
@@ -222,17 +233,6 @@ void BMP280Component::set_pressure_oversampling(BMP280Oversampling pressure_over
   this->pressure_oversampling_ = pressure_over_sampling;
 }
 void BMP280Component::set_iir_filter(BMP280IIRFilter iir_filter) { this->iir_filter_ = iir_filter; }
-uint8_t BMP280Component::read_u8_(uint8_t a_register) {
-  uint8_t data = 0;
-  this->read_byte(a_register, &data);
-  return data;
-}
-uint16_t BMP280Component::read_u16_le_(uint8_t a_register) {
-  uint16_t data = 0;
-  this->read_byte_16(a_register, &data);
-  return (data >> 8) | (data << 8);
-}
-int16_t BMP280Component::read_s16_le_(uint8_t a_register) { return this->read_u16_le_(a_register); }
 
 }  // namespace bmp280
 }  // namespace esphome
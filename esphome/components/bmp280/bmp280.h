@@ -69,13 +69,10 @@ class BMP280Component : public PollingComponent, public i2c::I2CDevice {
   void update() override;
 
  protected:
-  /// Read the temperature value and store the calculated ambient temperature in t_fine.
-  float read_temperature_(int32_t *t_fine);
-  /// Read the pressure value in hPa using the provided t_fine value.
-  float read_pressure_(int32_t t_fine);
-  uint8_t read_u8_(uint8_t a_register);
-  uint16_t read_u16_le_(uint8_t a_register);
-  int16_t read_s16_le_(uint8_t a_register);
+  /// Parse the raw temperature value and store the calculated ambient temperature in t_fine.
+  float read_temperature_(const uint8_t *data, int32_t *t_fine);
+  /// Parse the raw pressure value in hPa using the provided t_fine value.
+  float read_pressure_(const uint8_t *data, int32_t t_fine);
 
   BMP280CalibrationData calibration_;
   BMP280Oversampling temperature_oversampling_{BMP280_OVERSAMPLING_16X};
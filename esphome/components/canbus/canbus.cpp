@@ -55,30 +55,37 @@ void Canbus::add_trigger(CanbusTrigger *trigger) {
 };
 
 void Canbus::loop() {
-  struct CanFrame can_message;
-  // readmessage
-  if (this->read_message(&can_message) == canbus::ERROR_OK) {
-    if (can_message.use_extended_id) {
-      ESP_LOGD(TAG, "received can message extended can_id=0x%x size=%d", can_message.can_id,
-               can_message.can_data_length_code);
-    } else {
-      ESP_LOGD(TAG, "received can message std can_id=0x%x size=%d", can_message.can_id,
-               can_message.can_data_length_code);
-    }
+  // Empty the controller's receive buffers first, the triggers can take longer than the bus needs to fill them
+  struct CanFrame frames[CAN_RX_BURST_SIZE];
+  uint8_t count = 0;
+  while (count < CAN_RX_BURST_SIZE && this->read_message(&frames[count]) == canbus::ERROR_OK)
+    count++;
 
-    std::vector<uint8_t> data;
+  for (uint8_t i = 0; i < count; i++)
+    this->dispatch_frame_(frames[i]);
+}
 
-    // show data received
-    for (int i = 0; i < can_message.can_data_length_code; i++) {
-      ESP_LOGV(TAG, "  can_message.data[%d]=%02x", i, can_message.data[i]);
-      data.push_back(can_message.data[i]);
-    }
+void Canbus::dispatch_frame_(const struct CanFrame &can_message) {
+  if (can_message.use_extended_id) {
+    ESP_LOGD(TAG, "received can message extended can_id=0x%x size=%d", can_message.can_id,
+             can_message.can_data_length_code);
+  } else {
+    ESP_LOGD(TAG, "received can message std can_id=0x%x size=%d", can_message.can_id,
+             can_message.can_data_length_code);
+  }
+
+  std::vector<uint8_t> data;
+
+  // show data received
+  for (int i = 0; i < can_message.can_data_length_code; i++) {
+    ESP_LOGV(TAG, "  can_message.data[%d]=%02x", i, can_message.data[i]);
+    data.push_back(can_message.data[i]);
+  }
 
-    // fire all triggers
-    for (auto trigger : this->triggers_) {
-      if ((trigger->can_id_ == can_message.can_id) && (trigger->use_extended_id_ == can_message.use_extended_id)) {
-        trigger->trigger(data);
-      }
+  // fire all triggers
+  for (auto trigger : this->triggers_) {
+    if ((trigger->can_id_ == can_message.can_id) && (trigger->use_extended_id_ == can_message.use_extended_id)) {
+      trigger->trigger(data);
     }
   }
 }
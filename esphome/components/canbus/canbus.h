@@ -40,6 +40,8 @@ template<typename... Ts> class CanbusSendAction;
 
 /* CAN payload length definitions according to ISO 11898-1 */
 static const uint8_t CAN_MAX_DATA_LENGTH = 8;
+/// Frames taken from the controller per loop() before the triggers run.
+static const uint8_t CAN_RX_BURST_SIZE = 8;
 
 /*
 Can Frame describes a normative CAN Frame
@@ -79,6 +81,7 @@ class Canbus : public Component {
   virtual bool setup_internal();
   virtual Error send_message(struct CanFrame *frame);
   virtual Error read_message(struct CanFrame *frame);
+  void dispatch_frame_(const struct CanFrame &frame);
 };
 
 template<typename... Ts> class CanbusSendAction : public Action<Ts...>, public Parented<Canbus> {
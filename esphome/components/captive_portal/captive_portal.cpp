@@ -44,7 +44,7 @@ void CaptivePortal::handle_index(AsyncWebServerRequest *request) {
     }
 
     stream->print(F("<span class=\"network-ssid\">"));
-    stream->print(scan.get_ssid().c_str());
+    stream->print(scan.get_ssid());
     stream->print(F("</span></a>"));
     if (scan.get_with_auth()) {
       stream->print(F("<img src=\"/lock.svg\">"));
@@ -8,6 +8,10 @@ namespace ct_clamp {
 
 static const char *const TAG = "ct_clamp";
 
+/// Samples read per loop() during the sampling phase from sources that buffer samples at a fixed rate, bounds the
+/// time spent in a single loop(). Other sources (like external ADCs on I2C) are read once per loop().
+static const size_t SAMPLE_BLOCK_SIZE = 32;
+
 void CTClampSensor::dump_config() {
   LOG_SENSOR("", "CT Clamp Sensor", this);
   ESP_LOGCONFIG(TAG, "  Sample Duration: %.2fs", this->sample_duration_ / 1e3f);
@@ -51,19 +55,28 @@ void CTClampSensor::loop() {
   if (!this->is_sampling_)
     return;
 
-  // Perform a single sample
-  float value = this->source_->sample();
-  if (std::isnan(value))
-    return;
-
-  // Assuming a sine wave, avoid requesting values faster than the ADC can provide them
-  if (this->last_value_ == value)
-    return;
-  this->last_value_ = value;
-
-  this->num_samples_++;
-  this->sample_sum_ += value;
-  this->sample_squared_sum_ += value * value;
+  // Sample a block, sums are accumulated per block first, which also limits float rounding in the totals
+  float values[SAMPLE_BLOCK_SIZE];
+  const size_t count = std::isnan(this->source_->get_sample_rate()) ? 1 : SAMPLE_BLOCK_SIZE;
+  this->source_->sample_block(values, count);
+  float last_value = this->last_value_;
+  float sum = 0.0f;
+  float squared_sum = 0.0f;
+  uint32_t num_samples = 0;
+  for (size_t i = 0; i < count; i++) {
+    const float value = values[i];
+    // Assuming a sine wave, skip values read faster than the ADC can provide them
+    if (std::isnan(value) || value == last_value)
+      continue;
+    last_value = value;
+    num_samples++;
+    sum += value;
+    squared_sum += value * value;
+  }
+  this->last_value_ = last_value;
+  this->num_samples_ += num_samples;
+  this->sample_sum_ += sum;
+  this->sample_squared_sum_ += squared_sum;
 }
 
 }  // namespace ct_clamp
@@ -25,6 +25,7 @@ CONF_OBSTACLE_ROLLBACK = "obstacle_rollback"
 CONF_MALFUNCTION_DETECTION = "malfunction_detection"
 CONF_MALFUNCTION_ACTION = "malfunction_action"
 CONF_START_SENSING_DELAY = "start_sensing_delay"
+CONF_PUBLISH_INTERVAL = "publish_interval"
 
 current_based_ns = cg.esphome_ns.namespace("current_based")
 CurrentBasedCover = current_based_ns.class_(
@@ -62,6 +63,9 @@ CONFIG_SCHEMA = cover.COVER_SCHEMA.extend(
         cv.Optional(
             CONF_START_SENSING_DELAY, default="500ms"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(
+            CONF_PUBLISH_INTERVAL, default="1s"
+        ): cv.positive_time_period_milliseconds,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -122,3 +126,4 @@ def to_code(config):
             var.get_malfunction_trigger(), [], config[CONF_MALFUNCTION_ACTION]
         )
     cg.add(var.set_start_sensing_delay(config[CONF_START_SENSING_DELAY]))
+    cg.add(var.set_publish_interval(config[CONF_PUBLISH_INTERVAL]))
@@ -2,6 +2,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include <cfloat>
+#include <cmath>
 
 namespace esphome {
 namespace current_based {
@@ -38,14 +39,12 @@ void CurrentBasedCover::setup() {
   } else {
     this->position = 0.5f;
   }
-}
-
-void CurrentBasedCover::loop() {
-  if (this->current_operation == COVER_OPERATION_IDLE)
-    return;
 
-  const uint32_t now = millis();
+  this->open_sensor_->add_on_state_callback([this](float state) { this->check_currents_(); });
+  this->close_sensor_->add_on_state_callback([this](float state) { this->check_currents_(); });
+}
 
+void CurrentBasedCover::check_currents_() {
   if (this->current_operation == COVER_OPERATION_OPENING) {
     if (this->malfunction_detection_ && this->is_closing_()) {  // Malfunction
       this->direction_idle_();
@@ -63,7 +62,7 @@ void CurrentBasedCover::loop() {
         });
       }
     } else if (this->is_initial_delay_finished_() && !this->is_opening_()) {  // End reached
-      auto dur = (now - this->start_dir_time_) / 1e3f;
+      auto dur = (millis() - this->start_dir_time_) / 1e3f;
       ESP_LOGD(TAG, "'%s' - Open position reached. Took %.1fs.", this->name_.c_str(), dur);
       this->direction_idle_(COVER_OPEN);
     }
@@ -84,27 +83,27 @@ void CurrentBasedCover::loop() {
         });
       }
     } else if (this->is_initial_delay_finished_() && !this->is_closing_()) {  // End reached
-      auto dur = (now - this->start_dir_time_) / 1e3f;
+      auto dur = (millis() - this->start_dir_time_) / 1e3f;
       ESP_LOGD(TAG, "'%s' - Close position reached. Took %.1fs.", this->name_.c_str(), dur);
       this->direction_idle_(COVER_CLOSED);
     }
-  } else if (now - this->start_dir_time_ > this->max_duration_) {
-    ESP_LOGD(TAG, "'%s' - Max duration reached. Stopping cover.", this->name_.c_str());
-    this->direction_idle_();
-  }
-
-  // Recompute position every loop cycle
-  this->recompute_position_();
-
-  if (this->current_operation != COVER_OPERATION_IDLE && this->is_at_target_()) {
-    this->direction_idle_();
   }
+}
 
-  // Send current position every second
-  if (this->current_operation != COVER_OPERATION_IDLE && now - this->last_publish_time_ > 1000) {
-    this->publish_state(false);
-    this->last_publish_time_ = now;
+void CurrentBasedCover::schedule_arrival_() {
+  // the open and closed positions are only reached once the motor current stops
+  if ((this->current_operation == COVER_OPERATION_OPENING && this->target_position_ == COVER_OPEN) ||
+      (this->current_operation == COVER_OPERATION_CLOSING && this->target_position_ == COVER_CLOSED)) {
+    this->cancel_timeout("arrival");
+    return;
   }
+  this->recompute_position_();
+  const float duration = this->current_operation == COVER_OPERATION_OPENING ? this->open_duration_
+                                                                             : this->close_duration_;
+  // a target that was moved behind the cover is reached right away
+  const uint32_t remaining =
+      this->is_at_target_() ? 0 : uint32_t(std::fabs(this->target_position_ - this->position) * duration);
+  this->set_timeout("arrival", remaining, [this]() { this->direction_idle_(this->target_position_); });
 }
 
 void CurrentBasedCover::direction_idle_(float new_position) {
@@ -135,6 +134,7 @@ void CurrentBasedCover::dump_config() {
   }
   ESP_LOGCONFIG(TAG, "Start sensing delay: %.1fs", this->start_sensing_delay_ / 1e3f);
   ESP_LOGCONFIG(TAG, "Malfunction detection: %s", YESNO(this->malfunction_detection_));
+  ESP_LOGCONFIG(TAG, "Publish interval: %.1fs", this->publish_interval_ / 1e3f);
 }
 
 float CurrentBasedCover::get_setup_priority() const { return setup_priority::DATA; }
@@ -192,8 +192,12 @@ bool CurrentBasedCover::is_at_target_() const {
   }
 }
 void CurrentBasedCover::start_direction_(CoverOperation dir) {
-  if (dir == this->current_operation)
+  if (dir == this->current_operation) {
+    // the target may have changed
+    if (dir != COVER_OPERATION_IDLE)
+      this->schedule_arrival_();
     return;
+  }
 
   this->recompute_position_();
   Trigger<> *trig;
@@ -220,6 +224,28 @@ void CurrentBasedCover::start_direction_(CoverOperation dir) {
   const auto now = millis();
   this->start_dir_time_ = now;
   this->last_recompute_time_ = now;
+
+  if (dir == COVER_OPERATION_IDLE) {
+    this->cancel_timeout("arrival");
+    this->cancel_timeout("max_duration");
+    this->cancel_timeout("sensing_delay");
+    this->cancel_interval("publish");
+    return;
+  }
+  // the position is only computed when it's published, and once more when the target is reached
+  this->schedule_arrival_();
+  if (this->max_duration_ != UINT32_MAX) {
+    this->set_timeout("max_duration", this->max_duration_, [this]() {
+      ESP_LOGD(TAG, "'%s' - Max duration reached. Stopping cover.", this->name_.c_str());
+      this->direction_idle_();
+    });
+  }
+  // the end is reached when there's no current after the sensing delay, even if the sensors don't publish again
+  this->set_timeout("sensing_delay", this->start_sensing_delay_ + 1, [this]() { this->check_currents_(); });
+  this->set_interval("publish", this->publish_interval_, [this]() {
+    this->recompute_position_();
+    this->publish_state(false);
+  });
 }
 void CurrentBasedCover::recompute_position_() {
   if (this->current_operation == COVER_OPERATION_IDLE)
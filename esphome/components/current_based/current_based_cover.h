@@ -12,7 +12,6 @@ namespace current_based {
 class CurrentBasedCover : public cover::Cover, public Component {
  public:
   void setup() override;
-  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override;
 
@@ -43,6 +42,8 @@ class CurrentBasedCover : public cover::Cover, public Component {
 
   void set_malfunction_detection(bool malfunction_detection) { this->malfunction_detection_ = malfunction_detection; }
   void set_start_sensing_delay(uint32_t start_sensing_delay) { this->start_sensing_delay_ = start_sensing_delay; }
+  /// How often the position is published while the cover moves.
+  void set_publish_interval(uint32_t publish_interval) { this->publish_interval_ = publish_interval; }
 
   Trigger<> *get_malfunction_trigger() const { return this->malfunction_trigger_; }
 
@@ -61,6 +62,10 @@ class CurrentBasedCover : public cover::Cover, public Component {
 
   void direction_idle_(float new_position = FLT_MAX);
   void start_direction_(cover::CoverOperation dir);
+  /// Stop on an obstacle, a malfunction or the end position, called whenever one of the current sensors publishes.
+  void check_currents_();
+  /// Set the timeout for when the current operation reaches a target between the end positions.
+  void schedule_arrival_();
 
   void recompute_position_();
 
@@ -87,7 +92,7 @@ class CurrentBasedCover : public cover::Cover, public Component {
   Trigger<> *prev_command_trigger_{nullptr};
   uint32_t last_recompute_time_{0};
   uint32_t start_dir_time_{0};
-  uint32_t last_publish_time_{0};
+  uint32_t publish_interval_{1000};
   float target_position_{0};
 };
 
@@ -1,7 +1,15 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins
-from esphome.const import CONF_ID, CONF_PIN
+# Not imported as sensor, the sensor platform of this package would shadow that name
+import esphome.components.sensor as sensor_
+from esphome.const import (
+    CONF_ID,
+    CONF_PIN,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+)
 
 MULTI_CONF = True
 AUTO_LOAD = ["sensor"]
@@ -9,10 +17,20 @@ AUTO_LOAD = ["sensor"]
 dallas_ns = cg.esphome_ns.namespace("dallas")
 DallasComponent = dallas_ns.class_("DallasComponent", cg.PollingComponent)
 
+CONF_READ_LATENCY = "read_latency"
+UNIT_MILLISECOND = "ms"
+
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(DallasComponent),
         cv.Required(CONF_PIN): pins.internal_gpio_output_pin_schema,
+        cv.Optional(CONF_READ_LATENCY): sensor_.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
     }
 ).extend(cv.polling_component_schema("60s"))
 
@@ -23,3 +41,7 @@ async def to_code(config):
 
     pin = await cg.gpio_pin_expression(config[CONF_PIN])
     cg.add(var.set_pin(pin))
+
+    if CONF_READ_LATENCY in config:
+        sens = await sensor_.new_sensor(config[CONF_READ_LATENCY])
+        cg.add(var.set_read_latency_sensor(sens))
@@ -64,12 +64,15 @@ void DallasComponent::setup() {
     if (!sensor->setup_sensor()) {
       this->status_set_error();
     }
+    this->conversion_time_ = std::max(this->conversion_time_, sensor->millis_to_wait_for_conversion());
   }
+  this->disable_loop();
 }
 void DallasComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "DallasComponent:");
   LOG_PIN("  Pin: ", this->pin_);
   LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Read Latency", this->read_latency_sensor_);
 
   if (this->found_sensors_.empty()) {
     ESP_LOGW(TAG, "  Found no sensors!");
@@ -97,6 +100,9 @@ void DallasComponent::dump_config() {
 void DallasComponent::register_sensor(DallasTemperatureSensor *sensor) { this->sensors_.push_back(sensor); }
 void DallasComponent::update() {
   this->status_clear_warning();
+  // A conversion resets the scratch pads that weren't read yet
+  this->read_index_ = SIZE_MAX;
+  this->disable_loop();
 
   bool result;
   if (!this->one_wire_->reset()) {
@@ -113,28 +119,46 @@ void DallasComponent::update() {
     return;
   }
 
-  for (auto *sensor : this->sensors_) {
-    this->set_timeout(sensor->get_address_name(), sensor->millis_to_wait_for_conversion(), [this, sensor] {
-      bool res = sensor->read_scratch_pad();
-
-      if (!res) {
-        ESP_LOGW(TAG, "'%s' - Resetting bus for read failed!", sensor->get_name().c_str());
-        sensor->publish_state(NAN);
-        this->status_set_warning();
-        return;
-      }
-      if (!sensor->check_scratch_pad()) {
-        ESP_LOGW(TAG, "'%s' - Scratch pad checksum invalid!", sensor->get_name().c_str());
-        sensor->publish_state(NAN);
-        this->status_set_warning();
-        return;
-      }
+  // All sensors convert at once, so a single timeout for the slowest one covers them all
+  this->conversion_started_ = millis();
+  this->set_timeout("read", this->conversion_time_, [this] {
+    this->read_index_ = 0;
+    this->enable_loop();
+  });
+}
+void DallasComponent::loop() {
+  if (this->read_index_ >= this->sensors_.size()) {
+    this->disable_loop();
+    return;
+  }
+  this->read_sensor_(this->sensors_[this->read_index_++]);
+  if (this->read_index_ < this->sensors_.size())
+    return;
 
-      float tempc = sensor->get_temp_c();
-      ESP_LOGD(TAG, "'%s': Got Temperature=%.1f°C", sensor->get_name().c_str(), tempc);
-      sensor->publish_state(tempc);
-    });
+  this->read_index_ = SIZE_MAX;
+  this->disable_loop();
+  if (this->read_latency_sensor_ != nullptr)
+    this->read_latency_sensor_->publish_state(millis() - this->conversion_started_);
+}
+void DallasComponent::read_sensor_(DallasTemperatureSensor *sensor) {
+  bool res = sensor->read_scratch_pad();
+
+  if (!res) {
+    ESP_LOGW(TAG, "'%s' - Resetting bus for read failed!", sensor->get_name().c_str());
+    sensor->publish_state(NAN);
+    this->status_set_warning();
+    return;
   }
+  if (!sensor->check_scratch_pad()) {
+    ESP_LOGW(TAG, "'%s' - Scratch pad checksum invalid!", sensor->get_name().c_str());
+    sensor->publish_state(NAN);
+    this->status_set_warning();
+    return;
+  }
+
+  float tempc = sensor->get_temp_c();
+  ESP_LOGD(TAG, "'%s': Got Temperature=%.1f°C", sensor->get_name().c_str(), tempc);
+  sensor->publish_state(tempc);
 }
 
 void DallasTemperatureSensor::set_address(uint64_t address) { this->address_ = address; }
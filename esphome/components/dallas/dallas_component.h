@@ -13,20 +13,32 @@ class DallasComponent : public PollingComponent {
  public:
   void set_pin(InternalGPIOPin *pin) { pin_ = pin; }
   void register_sensor(DallasTemperatureSensor *sensor);
+  /// Set a sensor for the time from requesting the conversion until all sensors were read, in ms.
+  void set_read_latency_sensor(sensor::Sensor *read_latency_sensor) { read_latency_sensor_ = read_latency_sensor; }
 
   void setup() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
   void update() override;
+  /// Read the scratch pad of the next sensor, one per loop iteration so that the bus doesn't block for long.
+  void loop() override;
 
  protected:
   friend DallasTemperatureSensor;
 
+  void read_sensor_(DallasTemperatureSensor *sensor);
+
   InternalGPIOPin *pin_;
   ESPOneWire *one_wire_;
   std::vector<DallasTemperatureSensor *> sensors_;
   std::vector<uint64_t> found_sensors_;
+  sensor::Sensor *read_latency_sensor_{nullptr};
+  /// The longest conversion time of all sensors, in ms.
+  uint16_t conversion_time_{0};
+  /// The index of the next sensor to read in loop(), the sensors are only read after a conversion.
+  size_t read_index_{SIZE_MAX};
+  uint32_t conversion_started_{0};
 };
 
 /// Internal class that helps us create multiple sensors for one Dallas hub.
@@ -15,7 +15,7 @@ ESPOneWire::ESPOneWire(InternalGPIOPin *pin) { pin_ = pin->to_isr(); }
 bool HOT IRAM_ATTR ESPOneWire::reset() {
   // See reset here:
   // https://www.maximintegrated.com/en/design/technical-documents/app-notes/1/126.html
-  InterruptLock lock;
+  // Interrupts are only disabled where a slot has upper timing bounds, the fixed delays around them may be longer.
 
   // Wait for communication to clear (delay G)
   pin_.pin_mode(gpio::FLAG_INPUT | gpio::FLAG_PULLUP);
@@ -31,12 +31,16 @@ bool HOT IRAM_ATTR ESPOneWire::reset() {
   pin_.digital_write(false);
   delayMicroseconds(480);
 
-  // Release the bus, delay I
-  pin_.pin_mode(gpio::FLAG_INPUT | gpio::FLAG_PULLUP);
-  delayMicroseconds(70);
+  bool r;
+  {
+    InterruptLock lock;
+    // Release the bus, delay I
+    pin_.pin_mode(gpio::FLAG_INPUT | gpio::FLAG_PULLUP);
+    delayMicroseconds(70);
 
-  // sample bus, 0=device(s) present, 1=no device present
-  bool r = !pin_.digital_read();
+    // sample bus, 0=device(s) present, 1=no device present
+    r = !pin_.digital_read();
+  }
   // delay J
   delayMicroseconds(410);
   return r;
@@ -45,19 +49,20 @@ bool HOT IRAM_ATTR ESPOneWire::reset() {
 void HOT IRAM_ATTR ESPOneWire::write_bit(bool bit) {
   // See write 1/0 bit here:
   // https://www.maximintegrated.com/en/design/technical-documents/app-notes/1/126.html
-  InterruptLock lock;
-
-  // drive bus low
-  pin_.pin_mode(gpio::FLAG_OUTPUT);
-  pin_.digital_write(false);
-
   uint32_t delay0 = bit ? 10 : 65;
   uint32_t delay1 = bit ? 55 : 5;
 
-  // delay A/C
-  delayMicroseconds(delay0);
-  // release bus
-  pin_.digital_write(true);
+  {
+    InterruptLock lock;
+    // drive bus low
+    pin_.pin_mode(gpio::FLAG_OUTPUT);
+    pin_.digital_write(false);
+
+    // delay A/C
+    delayMicroseconds(delay0);
+    // release bus
+    pin_.digital_write(true);
+  }
   // delay B/D
   delayMicroseconds(delay1);
 }
@@ -65,19 +70,21 @@ void HOT IRAM_ATTR ESPOneWire::write_bit(bool bit) {
 bool HOT IRAM_ATTR ESPOneWire::read_bit() {
   // See read bit here:
   // https://www.maximintegrated.com/en/design/technical-documents/app-notes/1/126.html
-  InterruptLock lock;
-
-  // drive bus low, delay A
-  pin_.pin_mode(gpio::FLAG_OUTPUT);
-  pin_.digital_write(false);
-  delayMicroseconds(3);
-
-  // release bus, delay E
-  pin_.pin_mode(gpio::FLAG_INPUT | gpio::FLAG_PULLUP);
-  delayMicroseconds(10);
-
-  // sample bus to read bit from peer
-  bool r = pin_.digital_read();
+  bool r;
+  {
+    InterruptLock lock;
+    // drive bus low, delay A
+    pin_.pin_mode(gpio::FLAG_OUTPUT);
+    pin_.digital_write(false);
+    delayMicroseconds(3);
+
+    // release bus, delay E
+    pin_.pin_mode(gpio::FLAG_INPUT | gpio::FLAG_PULLUP);
+    delayMicroseconds(10);
+
+    // sample bus to read bit from peer
+    r = pin_.digital_read();
+  }
 
   // delay F
   delayMicroseconds(53);
@@ -15,7 +15,7 @@ class ESPOneWire {
 
   /** Reset the bus, should be done before all write operations.
    *
-   * Takes approximately 1ms.
+   * Takes approximately 1ms, interrupts are only disabled for the 70µs until the presence pulse is sampled.
    *
    * @return Whether the operation was successful.
    */
@@ -0,0 +1,70 @@
+#include "component_profile_sensor.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace debug {
+
+static const char *const TAG = "debug.profile";
+
+static const char *source_to_string(ComponentCallSource source) {
+  switch (source) {
+    case ComponentCallSource::SETUP:
+      return "setup";
+    case ComponentCallSource::LOOP:
+      return "loop";
+    case ComponentCallSource::SCHEDULER:
+      return "scheduler";
+    default:
+      return "unknown";
+  }
+}
+
+void ComponentProfileSensor::set_component(Component *component, ComponentCallSource source) {
+  this->component_ = component;
+  this->source_ = source;
+  global_profiler.track(component, source, &this->stats_);
+}
+const char *ComponentProfileSensor::get_component_name_() const {
+  return this->component_ == nullptr ? "main loop" : this->component_->get_component_source();
+}
+void ComponentProfileSensor::update() {
+  if (this->stats_.get_count() == 0)
+    return;
+
+  ESP_LOGV(TAG, "%s %s: count=%u min=%uus avg=%.0fus max=%uus p50=%uus p95=%uus p99=%uus",
+           this->get_component_name_(), source_to_string(this->source_), this->stats_.get_count(),
+           this->stats_.get_min(), this->stats_.get_average(), this->stats_.get_max(),
+           this->stats_.get_percentile(50.0f), this->stats_.get_percentile(95.0f), this->stats_.get_percentile(99.0f));
+
+  if (this->min_sensor_ != nullptr)
+    this->min_sensor_->publish_state(this->stats_.get_min() / 1000.0f);
+  if (this->average_sensor_ != nullptr)
+    this->average_sensor_->publish_state(this->stats_.get_average() / 1000.0f);
+  if (this->max_sensor_ != nullptr)
+    this->max_sensor_->publish_state(this->stats_.get_max() / 1000.0f);
+  if (this->p50_sensor_ != nullptr)
+    this->p50_sensor_->publish_state(this->stats_.get_percentile(50.0f) / 1000.0f);
+  if (this->p95_sensor_ != nullptr)
+    this->p95_sensor_->publish_state(this->stats_.get_percentile(95.0f) / 1000.0f);
+  if (this->p99_sensor_ != nullptr)
+    this->p99_sensor_->publish_state(this->stats_.get_percentile(99.0f) / 1000.0f);
+
+  // setup() only runs once, keep its statistics around
+  if (this->source_ != ComponentCallSource::SETUP)
+    this->stats_.reset();
+}
+void ComponentProfileSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "Component Profile:");
+  ESP_LOGCONFIG(TAG, "  Component: %s", this->get_component_name_());
+  ESP_LOGCONFIG(TAG, "  Source: %s", source_to_string(this->source_));
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Min", this->min_sensor_);
+  LOG_SENSOR("  ", "Average", this->average_sensor_);
+  LOG_SENSOR("  ", "Max", this->max_sensor_);
+  LOG_SENSOR("  ", "P50", this->p50_sensor_);
+  LOG_SENSOR("  ", "P95", this->p95_sensor_);
+  LOG_SENSOR("  ", "P99", this->p99_sensor_);
+}
+
+}  // namespace debug
+}  // namespace esphome
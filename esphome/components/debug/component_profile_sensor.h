@@ -0,0 +1,44 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "profiler.h"
+
+namespace esphome {
+namespace debug {
+
+/** Publishes the call duration statistics of another component, collected since the previous update.
+ *
+ * Without a component, the duration of every main loop iteration (without the time it sleeps) is tracked instead.
+ */
+class ComponentProfileSensor : public PollingComponent {
+ public:
+  /// Start tracking the given component (nullptr for the main loop), called from codegen so that even setup() gets
+  /// recorded.
+  void set_component(Component *component, ComponentCallSource source);
+  void set_min_sensor(sensor::Sensor *min_sensor) { this->min_sensor_ = min_sensor; }
+  void set_average_sensor(sensor::Sensor *average_sensor) { this->average_sensor_ = average_sensor; }
+  void set_max_sensor(sensor::Sensor *max_sensor) { this->max_sensor_ = max_sensor; }
+  void set_p50_sensor(sensor::Sensor *p50_sensor) { this->p50_sensor_ = p50_sensor; }
+  void set_p95_sensor(sensor::Sensor *p95_sensor) { this->p95_sensor_ = p95_sensor; }
+  void set_p99_sensor(sensor::Sensor *p99_sensor) { this->p99_sensor_ = p99_sensor; }
+
+  void update() override;
+  void dump_config() override;
+
+ protected:
+  const char *get_component_name_() const;
+
+  Component *component_{nullptr};
+  ComponentCallSource source_{ComponentCallSource::LOOP};
+  TimingStats stats_;
+  sensor::Sensor *min_sensor_{nullptr};
+  sensor::Sensor *average_sensor_{nullptr};
+  sensor::Sensor *max_sensor_{nullptr};
+  sensor::Sensor *p50_sensor_{nullptr};
+  sensor::Sensor *p95_sensor_{nullptr};
+  sensor::Sensor *p99_sensor_{nullptr};
+};
+
+}  // namespace debug
+}  // namespace esphome
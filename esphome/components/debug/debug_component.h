@@ -9,6 +9,7 @@ class DebugComponent : public Component {
  public:
   void loop() override;
   float get_setup_priority() const override;
+  bool can_setup_while_blocked() const override { return true; }
   void dump_config() override;
 
  protected:
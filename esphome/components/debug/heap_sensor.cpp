@@ -0,0 +1,62 @@
+#include "heap_sensor.h"
+#include "esphome/core/log.h"
+
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#endif
+
+#ifdef USE_ESP8266
+#include <Esp.h>
+#endif
+
+namespace esphome {
+namespace debug {
+
+static const char *const TAG = "debug.heap";
+
+void HeapSensor::update() {
+#ifdef USE_ESP32
+  uint32_t free_heap = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+  uint32_t max_block = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+  // The heap allocator keeps the low-water mark, which also catches dips between updates
+  uint32_t min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+  float fragmentation = free_heap == 0 ? 0.0f : 100.0f - (max_block * 100.0f) / free_heap;
+#elif defined(USE_ESP8266)
+  uint32_t free_heap;
+  uint16_t max_block;
+  uint8_t frag;
+  ESP.getHeapStats(&free_heap, &max_block, &frag);  // NOLINT(readability-static-accessed-through-instance)
+  this->min_free_ = std::min(this->min_free_, free_heap);
+  uint32_t min_free = this->min_free_;
+  float fragmentation = frag;
+#endif
+
+  ESP_LOGV(TAG, "Free=%u MinFree=%u Block=%u Fragmentation=%.0f%%", free_heap, min_free, max_block, fragmentation);
+
+  if (this->free_sensor_ != nullptr)
+    this->free_sensor_->publish_state(free_heap);
+  if (this->min_free_sensor_ != nullptr)
+    this->min_free_sensor_->publish_state(min_free);
+  if (this->block_sensor_ != nullptr)
+    this->block_sensor_->publish_state(max_block);
+  if (this->fragmentation_sensor_ != nullptr)
+    this->fragmentation_sensor_->publish_state(fragmentation);
+#ifdef USE_ESP32
+  if (this->psram_free_sensor_ != nullptr)
+    this->psram_free_sensor_->publish_state(heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+#endif
+}
+void HeapSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "Heap Sensor:");
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Free", this->free_sensor_);
+  LOG_SENSOR("  ", "Min Free", this->min_free_sensor_);
+  LOG_SENSOR("  ", "Largest Block", this->block_sensor_);
+  LOG_SENSOR("  ", "Fragmentation", this->fragmentation_sensor_);
+#ifdef USE_ESP32
+  LOG_SENSOR("  ", "PSRAM Free", this->psram_free_sensor_);
+#endif
+}
+
+}  // namespace debug
+}  // namespace esphome
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+
+namespace esphome {
+namespace debug {
+
+/// Periodically publishes heap usage statistics.
+class HeapSensor : public PollingComponent {
+ public:
+  void set_free_sensor(sensor::Sensor *free_sensor) { this->free_sensor_ = free_sensor; }
+  void set_min_free_sensor(sensor::Sensor *min_free_sensor) { this->min_free_sensor_ = min_free_sensor; }
+  void set_block_sensor(sensor::Sensor *block_sensor) { this->block_sensor_ = block_sensor; }
+  void set_fragmentation_sensor(sensor::Sensor *fragmentation_sensor) {
+    this->fragmentation_sensor_ = fragmentation_sensor;
+  }
+#ifdef USE_ESP32
+  void set_psram_free_sensor(sensor::Sensor *psram_free_sensor) { this->psram_free_sensor_ = psram_free_sensor; }
+#endif
+
+  void update() override;
+  void dump_config() override;
+
+ protected:
+  sensor::Sensor *free_sensor_{nullptr};
+  sensor::Sensor *min_free_sensor_{nullptr};
+  sensor::Sensor *block_sensor_{nullptr};
+  sensor::Sensor *fragmentation_sensor_{nullptr};
+#ifdef USE_ESP32
+  sensor::Sensor *psram_free_sensor_{nullptr};
+#endif
+  /// Lowest free heap seen on platforms that don't track it themselves.
+  uint32_t min_free_{UINT32_MAX};
+};
+
+}  // namespace debug
+}  // namespace esphome
@@ -0,0 +1,29 @@
+#include "preferences_sensor.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+
+namespace esphome {
+namespace debug {
+
+static const char *const TAG = "debug.preferences";
+
+void PreferencesSensor::update() {
+  uint32_t writes = global_preferences->get_flash_writes();
+  uint32_t skipped_writes = global_preferences->get_skipped_writes();
+
+  ESP_LOGV(TAG, "Writes=%u Skipped=%u", writes, skipped_writes);
+
+  if (this->writes_sensor_ != nullptr)
+    this->writes_sensor_->publish_state(writes);
+  if (this->skipped_writes_sensor_ != nullptr)
+    this->skipped_writes_sensor_->publish_state(skipped_writes);
+}
+void PreferencesSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "Preferences Sensor:");
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Flash Writes", this->writes_sensor_);
+  LOG_SENSOR("  ", "Skipped Writes", this->skipped_writes_sensor_);
+}
+
+}  // namespace debug
+}  // namespace esphome
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+
+namespace esphome {
+namespace debug {
+
+/// Periodically publishes how often preferences were written to flash, and how often a write was skipped.
+class PreferencesSensor : public PollingComponent {
+ public:
+  void set_writes_sensor(sensor::Sensor *writes_sensor) { this->writes_sensor_ = writes_sensor; }
+  void set_skipped_writes_sensor(sensor::Sensor *skipped_writes_sensor) {
+    this->skipped_writes_sensor_ = skipped_writes_sensor;
+  }
+
+  void update() override;
+  void dump_config() override;
+
+ protected:
+  sensor::Sensor *writes_sensor_{nullptr};
+  sensor::Sensor *skipped_writes_sensor_{nullptr};
+};
+
+}  // namespace debug
+}  // namespace esphome
@@ -0,0 +1,64 @@
+#include "profiler.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace debug {
+
+void HOT TimingStats::record(uint32_t duration_us) {
+  this->count_++;
+  this->total_ += duration_us;
+  this->min_ = std::min(this->min_, duration_us);
+  this->max_ = std::max(this->max_, duration_us);
+  // bucket i holds durations in [2^i - 1, 2^(i+1) - 1)
+  uint8_t bucket = 31 - __builtin_clz(duration_us + 1);
+  if (bucket >= NUM_BUCKETS)
+    bucket = NUM_BUCKETS - 1;
+  if (this->buckets_[bucket] != UINT16_MAX)
+    this->buckets_[bucket]++;
+}
+void TimingStats::reset() {
+  this->count_ = 0;
+  this->min_ = UINT32_MAX;
+  this->max_ = 0;
+  this->total_ = 0;
+  for (auto &bucket : this->buckets_)
+    bucket = 0;
+}
+float TimingStats::get_average() const {
+  if (this->count_ == 0)
+    return 0.0f;
+  return float(this->total_) / this->count_;
+}
+uint32_t TimingStats::get_percentile(float percentile) const {
+  uint32_t total = 0;
+  for (auto bucket : this->buckets_)
+    total += bucket;
+  if (total == 0)
+    return 0;
+
+  const uint32_t target = std::max<uint32_t>(1, (total * percentile) / 100.0f);
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < NUM_BUCKETS; i++) {
+    seen += this->buckets_[i];
+    if (seen >= target) {
+      uint32_t upper = i >= 31 ? UINT32_MAX : (1UL << (i + 1)) - 1;
+      return std::min(upper, this->max_);
+    }
+  }
+  return this->max_;
+}
+
+void ComponentProfiler::track(Component *component, ComponentCallSource source, TimingStats *stats) {
+  this->trackers_.push_back(Tracker{component, source, stats});
+}
+void HOT ComponentProfiler::record(Component *component, ComponentCallSource source, uint32_t duration_us) {
+  for (auto &tracker : this->trackers_) {
+    if (tracker.component == component && tracker.source == source)
+      tracker.stats->record(duration_us);
+  }
+}
+
+ComponentProfiler global_profiler;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace debug
+}  // namespace esphome
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include <vector>
+
+namespace esphome {
+namespace debug {
+
+/// Duration statistics of a sequence of calls, all values in microseconds.
+class TimingStats {
+ public:
+  void record(uint32_t duration_us);
+  void reset();
+
+  uint32_t get_count() const { return this->count_; }
+  uint32_t get_min() const { return this->count_ == 0 ? 0 : this->min_; }
+  uint32_t get_max() const { return this->max_; }
+  float get_average() const;
+  /** Approximate percentile (0-100) of the recorded durations.
+   *
+   * Durations are kept in power-of-two buckets, so the value returned is the upper bound of the bucket the
+   * percentile falls in (capped to the maximum seen).
+   */
+  uint32_t get_percentile(float percentile) const;
+
+ protected:
+  static const uint8_t NUM_BUCKETS = 32;
+
+  uint32_t count_{0};
+  uint32_t min_{UINT32_MAX};
+  uint32_t max_{0};
+  uint64_t total_{0};
+  uint16_t buckets_[NUM_BUCKETS]{};
+};
+
+/** Collects call durations of selected components.
+ *
+ * The core reports every setup(), loop() and scheduler callback duration here through
+ * WarnIfComponentBlockingGuard, only (component, source) pairs that have been tracked are recorded. The application
+ * reports the duration of each main loop iteration as (nullptr, LOOP).
+ */
+class ComponentProfiler {
+ public:
+  void track(Component *component, ComponentCallSource source, TimingStats *stats);
+  void record(Component *component, ComponentCallSource source, uint32_t duration_us);
+
+ protected:
+  struct Tracker {
+    Component *component;
+    ComponentCallSource source;
+    TimingStats *stats;
+  };
+  std::vector<Tracker> trackers_;
+};
+
+extern ComponentProfiler global_profiler;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace debug
+}  // namespace esphome
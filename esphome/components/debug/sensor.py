@@ -0,0 +1,206 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_COMPONENT_ID,
+    CONF_ID,
+    CONF_SOURCE,
+    CONF_TYPE,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_COUNTER,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_PERCENT,
+)
+from . import debug_ns
+
+CONF_MIN = "min"
+CONF_AVERAGE = "average"
+CONF_MAX = "max"
+CONF_P50 = "p50"
+CONF_P95 = "p95"
+CONF_P99 = "p99"
+CONF_FREE = "free"
+CONF_MIN_FREE = "min_free"
+CONF_BLOCK = "block"
+CONF_FRAGMENTATION = "fragmentation"
+CONF_PSRAM_FREE = "psram_free"
+CONF_WRITES = "writes"
+CONF_SKIPPED_WRITES = "skipped_writes"
+UNIT_MILLISECOND = "ms"
+UNIT_BYTES = "B"
+
+ComponentCallSource = cg.esphome_ns.enum("ComponentCallSource", is_class=True)
+COMPONENT_CALL_SOURCES = {
+    "SETUP": ComponentCallSource.SETUP,
+    "LOOP": ComponentCallSource.LOOP,
+    "SCHEDULER": ComponentCallSource.SCHEDULER,
+}
+
+ComponentProfileSensor = debug_ns.class_("ComponentProfileSensor", cg.PollingComponent)
+HeapSensor = debug_ns.class_("HeapSensor", cg.PollingComponent)
+PreferencesSensor = debug_ns.class_("PreferencesSensor", cg.PollingComponent)
+
+TYPE_HEAP = "heap"
+TYPE_PROFILE = "profile"
+TYPE_PREFERENCES = "preferences"
+
+TIMING_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MILLISECOND,
+    icon=ICON_TIMER,
+    accuracy_decimals=3,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+HEAP_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_BYTES,
+    icon=ICON_COUNTER,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+HEAP_CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(HeapSensor),
+            cv.Optional(CONF_FREE): HEAP_SCHEMA,
+            cv.Optional(CONF_MIN_FREE): HEAP_SCHEMA,
+            cv.Optional(CONF_BLOCK): HEAP_SCHEMA,
+            cv.Optional(CONF_FRAGMENTATION): sensor.sensor_schema(
+                unit_of_measurement=UNIT_PERCENT,
+                icon=ICON_COUNTER,
+                accuracy_decimals=1,
+                state_class=STATE_CLASS_MEASUREMENT,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
+            cv.Optional(CONF_PSRAM_FREE): cv.All(cv.only_on_esp32, HEAP_SCHEMA),
+        }
+    ).extend(cv.polling_component_schema("60s")),
+    cv.has_at_least_one_key(
+        CONF_FREE, CONF_MIN_FREE, CONF_BLOCK, CONF_FRAGMENTATION, CONF_PSRAM_FREE
+    ),
+)
+
+WRITES_SCHEMA = sensor.sensor_schema(
+    icon=ICON_COUNTER,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_TOTAL_INCREASING,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+PREFERENCES_CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(PreferencesSensor),
+            cv.Optional(CONF_WRITES): WRITES_SCHEMA,
+            cv.Optional(CONF_SKIPPED_WRITES): WRITES_SCHEMA,
+        }
+    ).extend(cv.polling_component_schema("60s")),
+    cv.has_at_least_one_key(CONF_WRITES, CONF_SKIPPED_WRITES),
+)
+
+
+def validate_profile_source(config):
+    if CONF_COMPONENT_ID not in config and config[CONF_SOURCE] != "LOOP":
+        raise cv.Invalid(
+            f"Without {CONF_COMPONENT_ID} the whole main loop is profiled, "
+            f"{CONF_SOURCE} can only be LOOP"
+        )
+    return config
+
+
+PROFILE_CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(ComponentProfileSensor),
+            # without a component the duration of every main loop iteration is profiled
+            cv.Optional(CONF_COMPONENT_ID): cv.use_id(cg.Component),
+            cv.Optional(CONF_SOURCE, default="LOOP"): cv.enum(
+                COMPONENT_CALL_SOURCES, upper=True
+            ),
+            cv.Optional(CONF_MIN): TIMING_SCHEMA,
+            cv.Optional(CONF_AVERAGE): TIMING_SCHEMA,
+            cv.Optional(CONF_MAX): TIMING_SCHEMA,
+            cv.Optional(CONF_P50): TIMING_SCHEMA,
+            cv.Optional(CONF_P95): TIMING_SCHEMA,
+            cv.Optional(CONF_P99): TIMING_SCHEMA,
+        }
+    ).extend(cv.polling_component_schema("60s")),
+    cv.has_at_least_one_key(
+        CONF_MIN, CONF_AVERAGE, CONF_MAX, CONF_P50, CONF_P95, CONF_P99
+    ),
+    validate_profile_source,
+)
+
+CONFIG_SCHEMA = cv.typed_schema(
+    {
+        TYPE_HEAP: HEAP_CONFIG_SCHEMA,
+        TYPE_PROFILE: PROFILE_CONFIG_SCHEMA,
+        TYPE_PREFERENCES: PREFERENCES_CONFIG_SCHEMA,
+    },
+    key=CONF_TYPE,
+    default_type=TYPE_PROFILE,
+)
+
+
+async def heap_to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    for key, setter in (
+        (CONF_FREE, var.set_free_sensor),
+        (CONF_MIN_FREE, var.set_min_free_sensor),
+        (CONF_BLOCK, var.set_block_sensor),
+        (CONF_FRAGMENTATION, var.set_fragmentation_sensor),
+        (CONF_PSRAM_FREE, var.set_psram_free_sensor),
+    ):
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(setter(sens))
+
+
+async def preferences_to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    for key, setter in (
+        (CONF_WRITES, var.set_writes_sensor),
+        (CONF_SKIPPED_WRITES, var.set_skipped_writes_sensor),
+    ):
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(setter(sens))
+
+
+async def to_code(config):
+    if config[CONF_TYPE] == TYPE_HEAP:
+        await heap_to_code(config)
+        return
+    if config[CONF_TYPE] == TYPE_PREFERENCES:
+        await preferences_to_code(config)
+        return
+
+    cg.add_define("USE_DEBUG_PROFILER")
+
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    comp = cg.nullptr
+    if CONF_COMPONENT_ID in config:
+        comp = await cg.get_variable(config[CONF_COMPONENT_ID])
+    cg.add(var.set_component(comp, config[CONF_SOURCE]))
+
+    for key, setter in (
+        (CONF_MIN, var.set_min_sensor),
+        (CONF_AVERAGE, var.set_average_sensor),
+        (CONF_MAX, var.set_max_sensor),
+        (CONF_P50, var.set_p50_sensor),
+        (CONF_P95, var.set_p95_sensor),
+        (CONF_P99, var.set_p99_sensor),
+    ):
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(setter(sens))
@@ -37,6 +37,9 @@ DisplayOnPageChangeTrigger = display_ns.class_(
 )
 
 CONF_ON_PAGE_CHANGE = "on_page_change"
+CONF_RUN_ON_CORE = "run_on_core"
+CONF_TASK_STACK_SIZE = "task_stack_size"
+CONF_REDRAW_ON = "redraw_on"
 
 DISPLAY_ROTATIONS = {
     0: display_ns.DISPLAY_ROTATION_0_DEGREES,
@@ -67,6 +70,9 @@ FULL_DISPLAY_SCHEMA = BASIC_DISPLAY_SCHEMA.extend(
                 {
                     cv.GenerateID(): cv.declare_id(DisplayPage),
                     cv.Required(CONF_LAMBDA): cv.lambda_,
+                    cv.Optional(CONF_REDRAW_ON): cv.ensure_list(
+                        cv.use_id(cg.EntityBase)
+                    ),
                 }
             ),
             cv.Length(min=1),
@@ -81,6 +87,14 @@ FULL_DISPLAY_SCHEMA = BASIC_DISPLAY_SCHEMA.extend(
             }
         ),
         cv.Optional(CONF_AUTO_CLEAR_ENABLED, default=True): cv.boolean,
+        cv.Optional(CONF_REDRAW_ON): cv.ensure_list(cv.use_id(cg.EntityBase)),
+        cv.Optional(CONF_RUN_ON_CORE): cv.All(
+            cv.only_on_esp32, cv.int_range(min=0, max=1)
+        ),
+        # only used with run_on_core
+        cv.Optional(CONF_TASK_STACK_SIZE): cv.All(
+            cv.only_on_esp32, cv.validate_bytes, cv.int_range(min=2048, max=65536)
+        ),
     }
 )
 
@@ -92,6 +106,17 @@ async def setup_display_core_(var, config):
     if CONF_AUTO_CLEAR_ENABLED in config:
         cg.add(var.set_auto_clear(config[CONF_AUTO_CLEAR_ENABLED]))
 
+    if CONF_RUN_ON_CORE in config:
+        # Render and flush the display from its own task
+        cg.add(var.set_update_task_core(config[CONF_RUN_ON_CORE]))
+        if CONF_TASK_STACK_SIZE in config:
+            cg.add(var.set_update_task_stack_size(config[CONF_TASK_STACK_SIZE]))
+
+    for entity_id in config.get(CONF_REDRAW_ON, []):
+        # Only render the lambda again when one of these entities changed
+        entity = await cg.get_variable(entity_id)
+        cg.add(var.redraw_on(entity))
+
     if CONF_PAGES in config:
         pages = []
         for conf in config[CONF_PAGES]:
@@ -99,6 +124,9 @@ async def setup_display_core_(var, config):
                 conf[CONF_LAMBDA], [(DisplayBufferRef, "it")], return_type=cg.void
             )
             page = cg.new_Pvariable(conf[CONF_ID], lambda_)
+            for entity_id in conf.get(CONF_REDRAW_ON, []):
+                entity = await cg.get_variable(entity_id)
+                cg.add(page.redraw_on(entity))
             pages.append(page)
         cg.add(var.set_pages(pages))
     for conf in config.get(CONF_ON_PAGE_CHANGE, []):
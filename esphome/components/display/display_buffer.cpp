@@ -1,5 +1,7 @@
 #include "display_buffer.h"
 
+#include <algorithm>
+#include <climits>
 #include <utility>
 #include "esphome/core/application.h"
 #include "esphome/core/color.h"
@@ -11,13 +13,16 @@ namespace esphome {
 namespace display {
 
 static const char *const TAG = "display";
+/// Number of image pixels converted on the stack before they are handed to blit_internal.
+static const int IMAGE_BLIT_CHUNK = 64;
+/// Number of unchanged pixels we accept to send when merging two dirty regions, instead of keeping both.
+static const int DIRTY_REGION_MERGE_SLACK = 64;
 
 const Color COLOR_OFF(0, 0, 0, 0);
 const Color COLOR_ON(255, 255, 255, 255);
 
 void DisplayBuffer::init_internal_(uint32_t buffer_length) {
-  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-  this->buffer_ = allocator.allocate(buffer_length);
+  this->buffer_ = static_cast<uint8_t *>(ram_allocate(RAMPolicy::BULK, buffer_length));
   if (this->buffer_ == nullptr) {
     ESP_LOGE(TAG, "Could not allocate buffer for display!");
     return;
@@ -66,6 +71,10 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
       y = this->get_height_internal() - y - 1;
       break;
   }
+  if (y < this->band_y1_ || y > this->band_y2_)
+    return;
+  if (x >= 0 && y >= 0 && x < this->get_width_internal() && y < this->get_height_internal())
+    this->mark_dirty_(x, y, x, y);
   this->draw_absolute_pixel_internal(x, y, color);
   App.feed_wdt();
 }
@@ -90,14 +99,10 @@ void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
   }
 }
 void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  this->fill_rect_(x, y, width, 1, color);
 }
 void HOT DisplayBuffer::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
+  this->fill_rect_(x, y, 1, height, color);
 }
 void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color) {
   this->horizontal_line(x1, y1, width, color);
@@ -106,10 +111,140 @@ void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
 void DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
-  for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
+  this->fill_rect_(x1, y1, width, height, color);
+}
+bool DisplayBuffer::rows_are_horizontal_() const {
+  return this->rotation_ == DISPLAY_ROTATION_0_DEGREES || this->rotation_ == DISPLAY_ROTATION_180_DEGREES;
+}
+void HOT DisplayBuffer::fill_rect_(int x, int y, int width, int height, Color color) {
+  if (width <= 0 || height <= 0)
+    return;
+  const int display_width = this->get_width_internal();
+  const int display_height = this->get_height_internal();
+
+  // a rectangle stays a rectangle in every rotation, only its corner and orientation change
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      std::swap(x, y);
+      std::swap(width, height);
+      x = display_width - x - width;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      x = display_width - x - width;
+      y = display_height - y - height;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      std::swap(x, y);
+      std::swap(width, height);
+      y = display_height - y - height;
+      break;
   }
+
+  const int x1 = std::max(x, 0);
+  const int y1 = std::max(y, this->band_y1_);
+  const int x2 = std::min(x + width, display_width);
+  const int y2 = std::min(y + height, std::min(display_height, this->band_y2_ + 1));
+  if (x1 >= x2 || y1 >= y2)
+    return;
+  this->mark_dirty_(x1, y1, x2 - 1, y2 - 1);
+  for (int row = y1; row < y2; row++)
+    this->fill_span_internal(x1, row, x2 - x1, color);
+  App.feed_wdt();
+}
+void HOT DisplayBuffer::blit_line_(int x, int y, int count, Color *colors) {
+  const int display_width = this->get_width_internal();
+  const int display_height = this->get_height_internal();
+
+  // the line runs along x for 0/180 degrees and along y for 90/270 degrees, so it is always one row of the display
+  bool reverse = false;
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      std::swap(x, y);
+      x = display_width - x - count;
+      reverse = true;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      x = display_width - x - count;
+      y = display_height - y - 1;
+      reverse = true;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      std::swap(x, y);
+      y = display_height - y - 1;
+      break;
+  }
+
+  if (y < this->band_y1_ || y > this->band_y2_ || y >= display_height)
+    return;
+  if (reverse)
+    std::reverse(colors, colors + count);
+  if (x < 0) {
+    colors += -x;
+    count += x;
+    x = 0;
+  }
+  count = std::min(count, display_width - x);
+  if (count <= 0)
+    return;
+  this->mark_dirty_(x, y, x + count - 1, y);
+  this->blit_internal(x, y, count, colors);
+  App.feed_wdt();
+}
+DisplayRegion DisplayRegion::merge(const DisplayRegion &other) const {
+  return DisplayRegion{std::min(this->x1, other.x1), std::min(this->y1, other.y1), std::max(this->x2, other.x2),
+                       std::max(this->y2, other.y2)};
+}
+/// Number of pixels that are sent in addition when a and b are replaced by their union (negative if they overlap).
+static int merge_cost(const DisplayRegion &a, const DisplayRegion &b) {
+  return a.merge(b).area() - a.area() - b.area();
+}
+void HOT DisplayBuffer::mark_dirty_(int x1, int y1, int x2, int y2) {
+  const DisplayRegion region{int16_t(x1), int16_t(y1), int16_t(x2), int16_t(y2)};
+  // most drawing extends an area that is already dirty, check that first
+  for (uint8_t i = 0; i < this->dirty_region_count_; i++) {
+    if (this->dirty_regions_[i].contains(region))
+      return;
+  }
+
+  uint8_t best = 0;
+  int best_cost = INT_MAX;
+  for (uint8_t i = 0; i < this->dirty_region_count_; i++) {
+    const int cost = merge_cost(this->dirty_regions_[i], region);
+    if (cost < best_cost) {
+      best = i;
+      best_cost = cost;
+    }
+  }
+  if (best_cost > DIRTY_REGION_MERGE_SLACK && this->dirty_region_count_ < MAX_DIRTY_REGIONS) {
+    this->dirty_regions_[this->dirty_region_count_++] = region;
+    return;
+  }
+
+  this->dirty_regions_[best] = this->dirty_regions_[best].merge(region);
+  // the grown region may now be close enough to the others to swallow them too
+  for (uint8_t i = 0; i < this->dirty_region_count_;) {
+    if (i != best && merge_cost(this->dirty_regions_[best], this->dirty_regions_[i]) <= DIRTY_REGION_MERGE_SLACK) {
+      this->dirty_regions_[best] = this->dirty_regions_[best].merge(this->dirty_regions_[i]);
+      this->dirty_regions_[i] = this->dirty_regions_[--this->dirty_region_count_];
+      if (best == this->dirty_region_count_)
+        best = i;
+      i = 0;
+      continue;
+    }
+    i++;
+  }
+}
+void HOT DisplayBuffer::fill_span_internal(int x, int y, int width, Color color) {
+  for (int i = x; i < x + width; i++)
+    this->draw_absolute_pixel_internal(i, y, color);
+}
+void HOT DisplayBuffer::blit_internal(int x, int y, int width, const Color *colors) {
+  for (int i = 0; i < width; i++)
+    this->draw_absolute_pixel_internal(x + i, y, colors[i]);
 }
 void HOT DisplayBuffer::circle(int center_x, int center_xy, int radius, Color color) {
   int dx = -radius;
@@ -162,45 +297,40 @@ void DisplayBuffer::filled_circle(int center_x, int center_y, int radius, Color
 }
 
 void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align, const char *text) {
+  const TextLayout &layout = font->layout(text);
+  const int height = font->get_height();
   int x_start, y_start;
-  int width, height;
-  this->get_text_bounds(x, y, text, font, align, &x_start, &y_start, &width, &height);
+  align_text_(x, y, align, layout.width, height, font->get_baseline(), &x_start, &y_start);
 
-  int i = 0;
-  int x_at = x_start;
-  while (text[i] != '\0') {
-    int match_length;
-    int glyph_n = font->match_next_glyph(text + i, &match_length);
-    if (glyph_n < 0) {
-      // Unknown char, skip
-      ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
-      if (!font->get_glyphs().empty()) {
-        uint8_t glyph_width = font->get_glyphs()[0].glyph_data_->width;
-        for (int glyph_x = 0; glyph_x < glyph_width; glyph_x++)
-          for (int glyph_y = 0; glyph_y < height; glyph_y++)
-            this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-        x_at += glyph_width;
-      }
-
-      i++;
+  for (const auto &item : layout.items) {
+    const int x_at = x_start + item.x;
+    if (item.glyph < 0) {
+      // Unknown char, draw a box instead
+      uint8_t glyph_width = font->get_glyphs()[0].glyph_data_->width;
+      this->filled_rectangle(x_at, y_start, glyph_width, height, color);
       continue;
     }
 
-    const Glyph &glyph = font->get_glyphs()[glyph_n];
-    int scan_x1, scan_y1, scan_width, scan_height;
-    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-    for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
-      for (int glyph_y = scan_y1; glyph_y < scan_y1 + scan_height; glyph_y++) {
-        if (glyph.get_pixel(glyph_x, glyph_y)) {
-          this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
+    const Glyph &glyph = font->get_glyphs()[item.glyph];
+    // draw runs of set pixels along the rows of the display, so each run is a single span
+    if (this->rows_are_horizontal_()) {
+      glyph.draw_spans(this, x_at, y_start, color);
+    } else {
+      int scan_x1, scan_y1, scan_width, scan_height;
+      glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
+      for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
+        int run = 0;
+        for (int glyph_y = scan_y1; glyph_y <= scan_y1 + scan_height; glyph_y++) {
+          if (glyph_y < scan_y1 + scan_height && glyph.get_pixel(glyph_x, glyph_y)) {
+            run++;
+            continue;
+          }
+          if (run > 0)
+            this->vertical_line(glyph_x + x_at, glyph_y - run + y_start, run, color);
+          run = 0;
         }
       }
     }
-
-    x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
-
-    i += match_length;
   }
 }
 void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign align, const char *format, va_list arg) {
@@ -210,29 +340,75 @@ void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign al
     this->print(x, y, font, color, align, buffer);
 }
 
-void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color color_off) {
+static Color get_image_pixel(Image *image, int x, int y, Color color_on, Color color_off) {
   switch (image->get_type()) {
     case IMAGE_TYPE_BINARY:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_pixel(img_x, img_y) ? color_on : color_off);
-        }
-      }
-      break;
+      return image->get_pixel(x, y) ? color_on : color_off;
     case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_grayscale_pixel(img_x, img_y));
-        }
-      }
-      break;
+      return image->get_grayscale_pixel(x, y);
     case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_color_pixel(img_x, img_y));
-        }
+    default:
+      return image->get_color_pixel(x, y);
+  }
+}
+void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color color_off) {
+  if (image->get_compression() == IMAGE_COMPRESSION_RLE) {
+    this->image_rle_(x, y, image);
+    return;
+  }
+
+  // walk the image along the rows of the display, so that every line is blitted in one go
+  const bool horizontal = this->rows_are_horizontal_();
+  const int lines = horizontal ? image->get_height() : image->get_width();
+  const int length = horizontal ? image->get_width() : image->get_height();
+  Color colors[IMAGE_BLIT_CHUNK];
+  for (int line = 0; line < lines; line++) {
+    for (int start = 0; start < length; start += IMAGE_BLIT_CHUNK) {
+      const int count = std::min(length - start, IMAGE_BLIT_CHUNK);
+      for (int i = 0; i < count; i++) {
+        colors[i] = horizontal ? get_image_pixel(image, start + i, line, color_on, color_off)
+                               : get_image_pixel(image, line, start + i, color_on, color_off);
       }
-      break;
+      if (horizontal) {
+        this->blit_line_(x + start, y + line, count, colors);
+      } else {
+        this->blit_line_(x + line, y + start, count, colors);
+      }
+    }
+  }
+}
+
+void DisplayBuffer::image_rle_(int x, int y, Image *image) {
+  const bool horizontal = this->rows_are_horizontal_();
+  const int pixel_size = image->get_rle_pixel_size();
+  Color colors[IMAGE_BLIT_CHUNK];
+  for (int row = 0; row < image->get_height(); row++) {
+    const uint8_t *data = image->get_rle_row(row);
+    int col = 0;
+    while (col < image->get_width()) {
+      const uint8_t header = progmem_read_byte(data++);
+      const int count = (header & 0x7F) + 1;
+      if (header & 0x80) {
+        this->fill_rect_(x + col, y + row, count, 1, image->read_rle_color(data));
+        data += pixel_size;
+        col += count;
+        continue;
+      }
+      if (!horizontal) {
+        // the row of the image is a column of the display, there's nothing to blit
+        for (int i = 0; i < count; i++, data += pixel_size)
+          this->draw_pixel_at(x + col + i, y + row, image->read_rle_color(data));
+        col += count;
+        continue;
+      }
+      for (int start = 0; start < count; start += IMAGE_BLIT_CHUNK) {
+        const int chunk = std::min(count - start, IMAGE_BLIT_CHUNK);
+        for (int i = 0; i < chunk; i++, data += pixel_size)
+          colors[i] = image->read_rle_color(data);
+        this->blit_line_(x + col + start, y + row, chunk, colors);
+      }
+      col += count;
+    }
   }
 }
 
@@ -247,16 +423,19 @@ void DisplayBuffer::get_text_bounds(int x, int y, const char *text, Font *font,
                                     int *width, int *height) {
   int x_offset, baseline;
   font->measure(text, width, &x_offset, &baseline, height);
-
+  align_text_(x, y, align, *width, *height, baseline, x1, y1);
+}
+void DisplayBuffer::align_text_(int x, int y, TextAlign align, int width, int height, int baseline, int *x1,
+                                int *y1) {
   auto x_align = TextAlign(int(align) & 0x18);
   auto y_align = TextAlign(int(align) & 0x07);
 
   switch (x_align) {
     case TextAlign::RIGHT:
-      *x1 = x - *width;
+      *x1 = x - width;
       break;
     case TextAlign::CENTER_HORIZONTAL:
-      *x1 = x - (*width) / 2;
+      *x1 = x - width / 2;
       break;
     case TextAlign::LEFT:
     default:
@@ -267,13 +446,13 @@ void DisplayBuffer::get_text_bounds(int x, int y, const char *text, Font *font,
 
   switch (y_align) {
     case TextAlign::BOTTOM:
-      *y1 = y - *height;
+      *y1 = y - height;
       break;
     case TextAlign::BASELINE:
       *y1 = y - baseline;
       break;
     case TextAlign::CENTER_VERTICAL:
-      *y1 = y - (*height) / 2;
+      *y1 = y - height / 2;
       break;
     case TextAlign::TOP:
     default:
@@ -337,10 +516,53 @@ void DisplayBuffer::show_page(DisplayPage *page) {
 }
 void DisplayBuffer::show_next_page() { this->page_->show_next(); }
 void DisplayBuffer::show_prev_page() { this->page_->show_prev(); }
-void DisplayBuffer::do_update_() {
+void DisplayBuffer::request_redraw() {
+  this->redraw_requested_ = true;
+  if (this->page_ != nullptr)
+    this->page_->request_redraw();
+}
+bool DisplayBuffer::do_update_() {
+  if (!this->should_render_())
+    return false;
   if (this->auto_clear_enabled_) {
     this->clear();
   }
+  this->run_writer_();
+  return true;
+}
+bool DisplayBuffer::do_update_banded_(int band_height, const std::function<void(int, int)> &flush) {
+  if (!this->should_render_())
+    return false;
+  const int height = this->get_height_internal();
+  const int band_y1 = this->band_y1_;
+  const int band_y2 = this->band_y2_;
+  for (int y = 0; y < height; y += band_height) {
+    this->band_y1_ = y;
+    this->band_y2_ = std::min(y + band_height, height) - 1;
+    this->clear();
+    this->run_writer_();
+    flush(this->band_y1_, this->band_y2_);
+  }
+  this->band_y1_ = band_y1;
+  this->band_y2_ = band_y2;
+  return true;
+}
+bool DisplayBuffer::should_render_() {
+  // retained pages keep what they rendered until one of their entities changes
+  if (this->page_ != nullptr) {
+    const bool requested = this->page_->take_redraw_request();
+    const bool page_changed = this->page_ != this->rendered_page_;
+    this->rendered_page_ = this->page_;
+    if (this->page_->is_retained() && !requested && !page_changed)
+      return false;
+  } else if (this->writer_.has_value()) {
+    const bool requested = this->redraw_requested_.exchange(false);
+    if (this->retained_ && !requested)
+      return false;
+  }
+  return true;
+}
+void DisplayBuffer::run_writer_() {
   if (this->page_ != nullptr) {
     this->page_->get_writer()(*this);
   } else if (this->writer_.has_value()) {
@@ -412,7 +634,25 @@ void Glyph::scan_area(int *x1, int *y1, int *width, int *height) const {
   *width = this->glyph_data_->width;
   *height = this->glyph_data_->height;
 }
+void Glyph::draw_spans(DisplayBuffer *display, int x, int y, Color color) const {
+  const uint8_t *spans = this->glyph_data_->spans;
+  x += this->glyph_data_->offset_x;
+  y += this->glyph_data_->offset_y;
+  for (int row = 0; row < this->glyph_data_->height; row++) {
+    for (uint8_t count = progmem_read_byte(spans++); count > 0; count--) {
+      const uint8_t start = progmem_read_byte(spans++);
+      const uint8_t length = progmem_read_byte(spans++);
+      display->horizontal_line(x + start, y + row, length, color);
+    }
+  }
+}
 int Font::match_next_glyph(const char *str, int *match_length) {
+  const auto first = static_cast<uint8_t>(str[0]);
+  if (first < 128 && this->ascii_glyphs_[first] >= 0) {
+    *match_length = 1;
+    return this->ascii_glyphs_[first];
+  }
+
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
   while (lo != hi) {
@@ -428,8 +668,35 @@ int Font::match_next_glyph(const char *str, int *match_length) {
   return lo;
 }
 void Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height) {
+  const TextLayout &layout = this->layout(str);
   *baseline = this->baseline_;
   *height = this->bottom_;
+  *x_offset = layout.x_offset;
+  *width = layout.width;
+}
+const TextLayout &Font::layout(const char *str) {
+  if (this->text_cache_size_ == 0) {
+    this->layout_into_(str, &this->scratch_layout_);
+    return this->scratch_layout_;
+  }
+  for (const auto &cached : this->text_cache_) {
+    if (cached.text == str)
+      return cached;
+  }
+  // replace the oldest entry once the cache is full
+  if (this->text_cache_.size() < this->text_cache_size_) {
+    this->text_cache_.emplace_back();
+    this->layout_into_(str, &this->text_cache_.back());
+    return this->text_cache_.back();
+  }
+  TextLayout &entry = this->text_cache_[this->text_cache_next_];
+  this->text_cache_next_ = (this->text_cache_next_ + 1) % this->text_cache_size_;
+  this->layout_into_(str, &entry);
+  return entry;
+}
+void Font::layout_into_(const char *str, TextLayout *layout) {
+  layout->text = str;
+  layout->items.clear();
   int i = 0;
   int min_x = 0;
   bool has_char = false;
@@ -439,8 +706,11 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
     int glyph_n = this->match_next_glyph(str + i, &match_length);
     if (glyph_n < 0) {
       // Unknown char, skip
-      if (!this->get_glyphs().empty())
+      ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", str[i]);
+      if (!this->get_glyphs().empty()) {
+        layout->items.push_back({-1, static_cast<int16_t>(x)});
         x += this->get_glyphs()[0].glyph_data_->width;
+      }
       i++;
       continue;
     }
@@ -450,18 +720,38 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
       min_x = glyph.glyph_data_->offset_x;
     else
       min_x = std::min(min_x, x + glyph.glyph_data_->offset_x);
+    layout->items.push_back({static_cast<int16_t>(glyph_n), static_cast<int16_t>(x)});
     x += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
 
     i += match_length;
     has_char = true;
   }
-  *x_offset = min_x;
-  *width = x - min_x;
+  layout->x_offset = min_x;
+  layout->width = x - min_x;
 }
 const std::vector<Glyph> &Font::get_glyphs() const { return this->glyphs_; }
 Font::Font(const GlyphData *data, int data_nr, int baseline, int bottom) : baseline_(baseline), bottom_(bottom) {
   for (int i = 0; i < data_nr; ++i)
     glyphs_.emplace_back(data + i);
+
+  // single characters can be looked up directly, unless a longer glyph starts with the same byte
+  for (auto &index : this->ascii_glyphs_)
+    index = -1;
+  for (int i = 0; i < data_nr; ++i) {
+    const auto first = static_cast<uint8_t>(data[i].a_char[0]);
+    if (first >= 128)
+      continue;
+    if (data[i].a_char[1] == '\0') {
+      if (this->ascii_glyphs_[first] != -2)
+        this->ascii_glyphs_[first] = i;
+    } else {
+      this->ascii_glyphs_[first] = -2;
+    }
+  }
+  for (auto &index : this->ascii_glyphs_) {
+    if (index == -2)
+      index = -1;
+  }
 }
 
 bool Image::get_pixel(int x, int y) const {
@@ -474,6 +764,8 @@ bool Image::get_pixel(int x, int y) const {
 Color Image::get_color_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return Color::BLACK;
+  if (this->compression_ == IMAGE_COMPRESSION_RLE)
+    return this->get_rle_pixel_(x, y);
   const uint32_t pos = (x + y * this->width_) * 3;
   const uint32_t color32 = (progmem_read_byte(this->data_start_ + pos + 2) << 0) |
                            (progmem_read_byte(this->data_start_ + pos + 1) << 8) |
@@ -483,6 +775,8 @@ Color Image::get_color_pixel(int x, int y) const {
 Color Image::get_grayscale_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return Color::BLACK;
+  if (this->compression_ == IMAGE_COMPRESSION_RLE)
+    return this->get_rle_pixel_(x, y);
   const uint32_t pos = (x + y * this->width_);
   const uint8_t gray = progmem_read_byte(this->data_start_ + pos);
   return Color(gray | gray << 8 | gray << 16 | gray << 24);
@@ -490,6 +784,31 @@ Color Image::get_grayscale_pixel(int x, int y) const {
 int Image::get_width() const { return this->width_; }
 int Image::get_height() const { return this->height_; }
 ImageType Image::get_type() const { return this->type_; }
+const uint8_t *Image::get_rle_row(int y) const {
+  const uint8_t *entry = this->data_start_ + y * 3;
+  const uint32_t offset = progmem_read_byte(entry) | (progmem_read_byte(entry + 1) << 8) |
+                          (uint32_t(progmem_read_byte(entry + 2)) << 16);
+  return this->data_start_ + offset;
+}
+Color Image::read_rle_color(const uint8_t *data) const {
+  if (this->type_ == IMAGE_TYPE_RGB24)
+    return Color(progmem_read_byte(data), progmem_read_byte(data + 1), progmem_read_byte(data + 2));
+  const uint8_t gray = progmem_read_byte(data);
+  return Color(gray | gray << 8 | gray << 16 | gray << 24);
+}
+Color Image::get_rle_pixel_(int x, int y) const {
+  const uint8_t *data = this->get_rle_row(y);
+  const int pixel_size = this->get_rle_pixel_size();
+  int col = 0;
+  while (true) {
+    const uint8_t header = progmem_read_byte(data++);
+    const int count = (header & 0x7F) + 1;
+    if (x < col + count)
+      return this->read_rle_color((header & 0x80) ? data : data + (x - col) * pixel_size);
+    data += (header & 0x80) ? pixel_size : count * pixel_size;
+    col += count;
+  }
+}
 Image::Image(const uint8_t *data_start, int width, int height, ImageType type)
     : width_(width), height_(height), type_(type), data_start_(data_start) {}
 
@@ -4,6 +4,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/automation.h"
 #include "display_color_utils.h"
+#include <atomic>
 #include <cstdarg>
 
 #ifdef USE_TIME
@@ -75,6 +76,14 @@ extern const Color COLOR_ON;
 
 enum ImageType { IMAGE_TYPE_BINARY = 0, IMAGE_TYPE_GRAYSCALE = 1, IMAGE_TYPE_RGB24 = 2 };
 
+/** How the pixel data of an image is stored.
+ *
+ * RLE data starts with a table of 3 byte (little endian) offsets to each row. Rows are a sequence of packets with a
+ * header byte: if the top bit is set, the next pixel is repeated (header & 0x7F) + 1 times, otherwise
+ * (header & 0x7F) + 1 pixels follow as is. Packets never cross rows.
+ */
+enum ImageCompression { IMAGE_COMPRESSION_NONE = 0, IMAGE_COMPRESSION_RLE = 1 };
+
 enum DisplayRotation {
   DISPLAY_ROTATION_0_DEGREES = 0,
   DISPLAY_ROTATION_90_DEGREES = 90,
@@ -82,6 +91,23 @@ enum DisplayRotation {
   DISPLAY_ROTATION_270_DEGREES = 270,
 };
 
+/// A rectangle in display coordinates (without rotation), both corners are inclusive.
+struct DisplayRegion {
+  int16_t x1;
+  int16_t y1;
+  int16_t x2;
+  int16_t y2;
+
+  int width() const { return this->x2 - this->x1 + 1; }
+  int height() const { return this->y2 - this->y1 + 1; }
+  int area() const { return this->width() * this->height(); }
+  bool contains(const DisplayRegion &other) const {
+    return other.x1 >= this->x1 && other.x2 <= this->x2 && other.y1 >= this->y1 && other.y2 <= this->y2;
+  }
+  /// The smallest region containing both this and other.
+  DisplayRegion merge(const DisplayRegion &other) const;
+};
+
 class Font;
 class Image;
 class DisplayBuffer;
@@ -336,18 +362,86 @@ class DisplayBuffer {
   // Internal method to set display auto clearing.
   void set_auto_clear(bool auto_clear_enabled) { this->auto_clear_enabled_ = auto_clear_enabled; }
 
+  /** Only render the writer lambda again after `entity` published a new state, instead of on every update.
+   *
+   * Once this is used, the buffer is kept (and not auto cleared) between updates in which nothing changed.
+   * Pages have their own DisplayPage::redraw_on().
+   */
+  template<typename T> void redraw_on(T *entity) {
+    this->retained_ = true;
+    entity->add_on_state_callback([this](const auto &...) { this->redraw_requested_ = true; });
+  }
+  /// Render the writer (or the current page) on the next update, even if none of its entities changed.
+  void request_redraw();
+
  protected:
   void vprintf_(int x, int y, Font *font, Color color, TextAlign align, const char *format, va_list arg);
 
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  /** Fill `width` pixels of row `y` starting at column `x` with `color`.
+   *
+   * Coordinates are in display space (without rotation) and the span is already clipped to the display. The default
+   * implementation calls draw_absolute_pixel_internal() for each pixel, buffered displays override this to write
+   * their buffer directly.
+   */
+  virtual void fill_span_internal(int x, int y, int width, Color color);
+
+  /** Write `width` pixels from `colors` to row `y` starting at column `x`.
+   *
+   * Same coordinate and clipping rules as fill_span_internal().
+   */
+  virtual void blit_internal(int x, int y, int width, const Color *colors);
+
+  /// Fill a rectangle given in rotated coordinates, clipped to the display.
+  void fill_rect_(int x, int y, int width, int height, Color color);
+
+  /** Write `count` pixels starting at [x,y] (rotated coordinates) along a single row of the display.
+   *
+   * That is along x for 0 and 180 degrees and along y for 90 and 270 degrees, see rows_are_horizontal_().
+   * The contents of `colors` may be reordered.
+   */
+  void blit_line_(int x, int y, int count, Color *colors);
+
+  /// Whether rows of the display run along the x axis with the current rotation.
+  bool rows_are_horizontal_() const;
+
+  /// Draw an RLE compressed image, decoding it row by row.
+  void image_rle_(int x, int y, Image *image);
+
+  /// Position [x1,y1] of the top left corner of text with the given size that is aligned to [x,y].
+  static void align_text_(int x, int y, TextAlign align, int width, int height, int baseline, int *x1, int *y1);
+
+  /** Record that the given area (display coordinates, inclusive and within the display) has changed.
+   *
+   * Drivers that can update part of the screen read dirty_regions_ when sending the buffer and then call
+   * clear_dirty_regions_(). At most MAX_DIRTY_REGIONS are kept, additional areas are merged into the region
+   * that grows the least.
+   */
+  void mark_dirty_(int x1, int y1, int x2, int y2);
+  /// Mark the entire display as changed (e.g. after fill()).
+  void mark_all_dirty_() { this->mark_dirty_(0, 0, this->get_width_internal() - 1, this->get_height_internal() - 1); }
+  void clear_dirty_regions_() { this->dirty_region_count_ = 0; }
+
+  static const uint8_t MAX_DIRTY_REGIONS = 4;
+
   virtual int get_height_internal() = 0;
 
   virtual int get_width_internal() = 0;
 
   void init_internal_(uint32_t buffer_length);
 
-  void do_update_();
+  /// Clear the buffer and run the writer of the current page, returns false if there was nothing to render.
+  bool do_update_();
+
+  /** Like do_update_(), but render in bands of band_height rows (display coordinates) for drivers whose buffer only
+   * holds a single band.
+   *
+   * For every band the buffer is cleared and the writer runs with drawing clipped to the band, then flush(y1, y2)
+   * sends rows y1 to y2 (inclusive). The driver addresses its buffer relative to band_y1_. The buffer is reused for
+   * every band, so it's always cleared regardless of auto_clear_enabled.
+   */
+  bool do_update_banded_(int band_height, const std::function<void(int, int)> &flush);
 
   uint8_t *buffer_{nullptr};
   DisplayRotation rotation_{DISPLAY_ROTATION_0_DEGREES};
@@ -356,6 +450,19 @@ class DisplayBuffer {
   DisplayPage *previous_page_{nullptr};
   std::vector<DisplayOnPageChangeTrigger *> on_page_change_triggers_;
   bool auto_clear_enabled_{true};
+  bool retained_{false};
+  std::atomic<bool> redraw_requested_{true};
+  /// The page that was rendered last, showing another page always renders it.
+  DisplayPage *rendered_page_{nullptr};
+  DisplayRegion dirty_regions_[MAX_DIRTY_REGIONS];
+  uint8_t dirty_region_count_{0};
+  /// Rows (display coordinates, inclusive) that drawing is clipped to, see do_update_banded_().
+  int band_y1_{0};
+  int band_y2_{INT16_MAX};
+
+  /// Whether the current page has to be rendered, see redraw_on.
+  bool should_render_();
+  void run_writer_();
 };
 
 class DisplayPage {
@@ -369,22 +476,54 @@ class DisplayPage {
   void set_next(DisplayPage *next);
   const display_writer_t &get_writer() const;
 
+  /// Only render this page again after `entity` published a new state (or when it is shown).
+  template<typename T> void redraw_on(T *entity) {
+    this->retained_ = true;
+    entity->add_on_state_callback([this](const auto &...) { this->redraw_requested_ = true; });
+  }
+  void request_redraw() { this->redraw_requested_ = true; }
+  bool is_retained() const { return this->retained_; }
+  /// Whether a redraw was requested since the last call.
+  bool take_redraw_request() { return this->redraw_requested_.exchange(false); }
+
  protected:
   DisplayBuffer *parent_;
   display_writer_t writer_;
+  bool retained_{false};
+  std::atomic<bool> redraw_requested_{true};
   DisplayPage *prev_{nullptr};
   DisplayPage *next_{nullptr};
 };
 
 struct GlyphData {
   const char *a_char;
+  /// Bitmap of the glyph, rows padded to whole bytes.
   const uint8_t *data;
+  /** Set pixels as runs along the rows of the glyph, for drawing.
+   *
+   * For every row there's a count of runs followed by a (start x, length) byte pair per run.
+   */
+  const uint8_t *spans;
   int offset_x;
   int offset_y;
   int width;
   int height;
 };
 
+/// Glyphs of a string and where they're drawn, relative to the start of the text.
+struct TextLayout {
+  struct Item {
+    /// Index of the glyph in the font, -1 for characters the font has no glyph for.
+    int16_t glyph;
+    int16_t x;
+  };
+
+  std::string text;
+  std::vector<Item> items;
+  int width;
+  int x_offset;
+};
+
 class Glyph {
  public:
   Glyph(const GlyphData *data) : glyph_data_(data) {}
@@ -399,6 +538,9 @@ class Glyph {
 
   void scan_area(int *x1, int *y1, int *width, int *height) const;
 
+  /// Draw the glyph with its origin at [x,y], as a horizontal line per run of set pixels.
+  void draw_spans(DisplayBuffer *display, int x, int y, Color color) const;
+
  protected:
   friend Font;
   friend DisplayBuffer;
@@ -420,12 +562,32 @@ class Font {
 
   void measure(const char *str, int *width, int *x_offset, int *baseline, int *height);
 
+  /** Get the glyphs and their positions for str.
+   *
+   * The result is valid until the next call. Up to text_cache_size layouts of recently used strings are kept, so
+   * labels that don't change don't have to be matched glyph by glyph on every update.
+   */
+  const TextLayout &layout(const char *str);
+
+  void set_text_cache_size(uint8_t text_cache_size) { this->text_cache_size_ = text_cache_size; }
+
+  int get_baseline() const { return this->baseline_; }
+  int get_height() const { return this->bottom_; }
+
   const std::vector<Glyph> &get_glyphs() const;
 
  protected:
+  void layout_into_(const char *str, TextLayout *layout);
+
   std::vector<Glyph> glyphs_;
+  /// Glyph index for single byte (ASCII) glyphs, -1 if the byte has no glyph or must go through match_next_glyph().
+  int16_t ascii_glyphs_[128];
   int baseline_;
   int bottom_;
+  uint8_t text_cache_size_{0};
+  uint8_t text_cache_next_{0};
+  std::vector<TextLayout> text_cache_;
+  TextLayout scratch_layout_;
 };
 
 class Image {
@@ -438,10 +600,24 @@ class Image {
   int get_height() const;
   ImageType get_type() const;
 
+  void set_compression(ImageCompression compression) { this->compression_ = compression; }
+  ImageCompression get_compression() const { return this->compression_; }
+
+  /// Start of the packets of row y of an RLE compressed image.
+  const uint8_t *get_rle_row(int y) const;
+  /// Number of bytes a pixel takes in RLE packets.
+  int get_rle_pixel_size() const { return this->type_ == IMAGE_TYPE_RGB24 ? 3 : 1; }
+  /// Read a single pixel from RLE packet data.
+  Color read_rle_color(const uint8_t *data) const;
+
  protected:
+  /// Random access to an RLE compressed image, decodes the row up to x.
+  Color get_rle_pixel_(int x, int y) const;
+
   int width_;
   int height_;
   ImageType type_;
+  ImageCompression compression_{IMAGE_COMPRESSION_NONE};
   const uint8_t *data_start_;
 };
 
@@ -7,13 +7,30 @@
 #include <Crypto.h>
 #include <GCM.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace esphome {
 namespace dsmr {
 
 static const char *const TAG = "dsmr";
+/// The longest line is a text message of up to 1024 characters.
+static const size_t MAX_LINE_LENGTH = 1100;
+/// Bytes taken from the UART at once.
+static const size_t READ_CHUNK_SIZE = 64;
+
+/// The CRC-16 of DSMR telegrams (reflected polynomial 0xA001, initial value 0).
+static uint16_t crc16_update(uint16_t crc, uint8_t byte) {
+  crc ^= byte;
+  for (uint8_t i = 0; i < 8; i++)
+    crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+  return crc;
+}
 
 void Dsmr::setup() {
-  this->telegram_ = new char[this->max_telegram_len_];  // NOLINT
+  // The text of plain telegrams is parsed line by line, only decrypted telegrams need a telegram buffer
+  this->line_size_ = std::min(this->max_telegram_len_, MAX_LINE_LENGTH);
+  this->line_ = new char[this->line_size_];  // NOLINT
   if (this->request_pin_ != nullptr) {
     this->request_pin_->setup();
   }
@@ -131,60 +148,148 @@ void Dsmr::reset_telegram_() {
   this->crypt_bytes_read_ = 0;
   this->crypt_telegram_len_ = 0;
   this->last_read_time_ = 0;
+  this->line_len_ = 0;
+  this->line_pending_ = false;
+  this->first_line_ = true;
+  this->telegram_valid_ = true;
+  this->crc_ = 0;
+  this->crc_len_ = 0;
 }
 
 void Dsmr::receive_telegram_() {
   while (this->available_within_timeout_()) {
-    const char c = this->read();
-
-    // Find a new telegram header, i.e. forward slash.
-    if (c == '/') {
-      ESP_LOGV(TAG, "Header of telegram found");
-      this->reset_telegram_();
-      this->header_found_ = true;
-    }
-    if (!this->header_found_)
-      continue;
-
-    // Check for buffer overflow.
-    if (this->bytes_read_ >= this->max_telegram_len_) {
-      this->reset_telegram_();
-      ESP_LOGE(TAG, "Error: telegram larger than buffer (%d bytes)", this->max_telegram_len_);
+    uint8_t chunk[READ_CHUNK_SIZE];
+    const size_t len = std::min<size_t>(this->available(), sizeof(chunk));
+    if (!this->read_array(chunk, len))
       return;
+    for (size_t i = 0; i < len; i++) {
+      // The rest of the chunk is dropped with the data after the telegram, see stop_requesting_data_()
+      if (this->parse_char_(chunk[i]))
+        return;
     }
+  }
+}
 
-    // Some v2.2 or v3 meters will send a new value which starts with '('
-    // in a new line, while the value belongs to the previous ObisId. For
-    // proper parsing, remove these new line characters.
-    if (c == '(') {
-      while (true) {
-        auto previous_char = this->telegram_[this->bytes_read_ - 1];
-        if (previous_char == '\n' || previous_char == '\r') {
-          this->bytes_read_--;
-        } else {
-          break;
-        }
-      }
+bool Dsmr::parse_char_(char c) {
+  // Find a new telegram header, i.e. forward slash.
+  if (c == '/') {
+    ESP_LOGV(TAG, "Header of telegram found");
+    this->reset_telegram_();
+    this->header_found_ = true;
+    this->data_ = MyData();
+    this->crc_ = crc16_update(0, c);
+    return false;
+  }
+  if (!this->header_found_)
+    return false;
+
+  // Check for buffer overflow.
+  if (this->bytes_read_ >= this->max_telegram_len_) {
+    this->reset_telegram_();
+    ESP_LOGE(TAG, "Error: telegram larger than buffer (%d bytes)", this->max_telegram_len_);
+    return true;
+  }
+  this->bytes_read_++;
+
+  // After the footer only the hex checksum follows, ended by a newline.
+  if (this->footer_found_) {
+    if (c == '\n') {
+      this->finish_telegram_();
+      return true;
     }
+    if (c != '\r' && this->crc_len_ < 4)
+      this->crc_text_[this->crc_len_++] = c;
+    return false;
+  }
+  this->crc_ = crc16_update(this->crc_, c);
+
+  // Check for a footer, i.e. exlamation mark, followed by a hex checksum.
+  if (c == '!') {
+    ESP_LOGV(TAG, "Footer of telegram found");
+    if (this->line_len_ > 0)
+      this->parse_line_();
+    this->footer_found_ = true;
+    return false;
+  }
+  if (c == '\n' || c == '\r') {
+    if (this->line_len_ > 0)
+      this->line_pending_ = true;
+    return false;
+  }
+  if (this->line_pending_) {
+    this->line_pending_ = false;
+    // Some v2.2 or v3 meters will send a new value which starts with '('
+    // in a new line, while the value belongs to the previous ObisId.
+    if (c != '(')
+      this->parse_line_();
+  }
 
-    // Store the byte in the buffer.
-    this->telegram_[this->bytes_read_] = c;
-    this->bytes_read_++;
+  if (this->line_len_ >= this->line_size_) {
+    this->reset_telegram_();
+    ESP_LOGE(TAG, "Error: telegram line larger than buffer (%d bytes)", this->line_size_);
+    return true;
+  }
+  this->line_[this->line_len_++] = c;
+  return false;
+}
 
-    // Check for a footer, i.e. exlamation mark, followed by a hex checksum.
-    if (c == '!') {
-      ESP_LOGV(TAG, "Footer of telegram found");
-      this->footer_found_ = true;
-      continue;
+void Dsmr::parse_line_() {
+  const char *end = this->line_ + this->line_len_;
+  this->line_len_ = 0;
+  if (!this->telegram_valid_)
+    return;
+
+  if (this->first_line_) {
+    this->first_line_ = false;
+    // The identification line usually looks like XXX5<id string> (a 3 for DSMR 2.x), but some meters send other
+    // baud rate characters there and their telegrams are fine, so this is only logged.
+    if (end - this->line_ < 4 || (this->line_[3] != '5' && this->line_[3] != '3'))
+      ESP_LOGV(TAG, "Unusual identification string: %.*s", (int) (end - this->line_), this->line_);
+    // It's offered for processing with the all-ones OBIS ID, which isn't otherwise valid.
+    auto res = this->data_.parse_line(::dsmr::ObisId(255, 255, 255, 255, 255, 255), this->line_, end);
+    if (res.err) {
+      ESP_LOGE(TAG, "%s", res.fullError(this->line_, end).c_str());
+      this->telegram_valid_ = false;
     }
-    // Check for the end of the hex checksum, i.e. a newline.
-    if (this->footer_found_ && c == '\n') {
-      // Parse the telegram and publish sensor values.
-      this->parse_telegram();
-      this->reset_telegram_();
-      return;
+    return;
+  }
+
+  auto id = ::dsmr::ObisIdParser::parse(this->line_, end);
+  if (id.err) {
+    ESP_LOGE(TAG, "%s", id.fullError(this->line_, end).c_str());
+    this->telegram_valid_ = false;
+    return;
+  }
+  // Unknown fields are ignored, a known field has to use the whole line.
+  auto res = this->data_.parse_line(id.result, id.next, end);
+  if (res.err) {
+    ESP_LOGE(TAG, "%s", res.fullError(this->line_, end).c_str());
+    this->telegram_valid_ = false;
+  } else if (res.next != id.next && res.next != end) {
+    ESP_LOGE(TAG, "Trailing characters on data line: %s", std::string(this->line_, end).c_str());
+    this->telegram_valid_ = false;
+  }
+}
+
+bool Dsmr::finish_telegram_() {
+  ESP_LOGV(TAG, "End of telegram found");
+  this->stop_requesting_data_();
+  bool valid = this->telegram_valid_ && !this->first_line_;
+  if (valid && this->crc_check_) {
+    this->crc_text_[this->crc_len_] = '\0';
+    char *crc_end;
+    const uint16_t crc = std::strtoul(this->crc_text_, &crc_end, 16);
+    if (this->crc_len_ != 4 || *crc_end != '\0' || crc != this->crc_) {
+      ESP_LOGE(TAG, "Checksum mismatch, received '%s', calculated %04X", this->crc_text_, this->crc_);
+      valid = false;
     }
   }
+  if (valid) {
+    this->status_clear_warning();
+    this->publish_sensors(this->data_);
+  }
+  this->reset_telegram_();
+  return valid;
 }
 
 void Dsmr::receive_encrypted_telegram_() {
@@ -253,22 +358,17 @@ void Dsmr::receive_encrypted_telegram_() {
 }
 
 bool Dsmr::parse_telegram() {
-  MyData data;
   ESP_LOGV(TAG, "Trying to parse telegram");
-  this->stop_requesting_data_();
-  ::dsmr::ParseResult<void> res =
-      ::dsmr::P1Parser::parse(&data, this->telegram_, this->bytes_read_, false,
-                              this->crc_check_);  // Parse telegram according to data definition. Ignore unknown values.
-  if (res.err) {
-    // Parsing error, show it
-    auto err_str = res.fullError(this->telegram_, this->telegram_ + this->bytes_read_);
-    ESP_LOGE(TAG, "%s", err_str.c_str());
-    return false;
-  } else {
-    this->status_clear_warning();
-    this->publish_sensors(data);
-    return true;
+  const size_t len = this->bytes_read_;
+  this->reset_telegram_();
+  for (size_t i = 0; i < len; i++) {
+    if (this->telegram_[i] == '\n' && this->footer_found_)
+      return this->finish_telegram_();
+    this->parse_char_(this->telegram_[i]);
   }
+  ESP_LOGE(TAG, "Telegram is incomplete");
+  this->stop_requesting_data_();
+  return false;
 }
 
 void Dsmr::dump_config() {
@@ -319,6 +419,9 @@ void Dsmr::set_decryption_key(const std::string &decryption_key) {
   if (this->crypt_telegram_ == nullptr) {
     this->crypt_telegram_ = new uint8_t[this->max_telegram_len_];  // NOLINT
   }
+  if (this->telegram_ == nullptr) {
+    this->telegram_ = new char[this->max_telegram_len_];  // NOLINT
+  }
 }
 
 }  // namespace dsmr
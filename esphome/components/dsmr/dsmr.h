@@ -52,6 +52,7 @@ class Dsmr : public Component, public uart::UARTDevice {
   void setup() override;
   void loop() override;
 
+  /// Parse the telegram in the buffer (the decrypted one) and publish the sensor values.
   bool parse_telegram();
 
   void publish_sensors(MyData &data) {
@@ -88,6 +89,13 @@ class Dsmr : public Component, public uart::UARTDevice {
   void receive_encrypted_telegram_();
   void reset_telegram_();
 
+  /// Feed one character of telegram text to the parser, true once the telegram is complete.
+  bool parse_char_(char c);
+  /// Parse the line in line_ into data_.
+  void parse_line_();
+  /// Check the CRC and publish data_, returns whether the telegram was valid.
+  bool finish_telegram_();
+
   /// Wait for UART data to become available within the read timeout.
   ///
   /// The smart meter might provide data in chunks, causing available() to
@@ -122,6 +130,19 @@ class Dsmr : public Component, public uart::UARTDevice {
   bool header_found_{false};
   bool footer_found_{false};
 
+  // Incremental parser, the telegram text is parsed line by line as it comes in
+  MyData data_;
+  char *line_{nullptr};
+  size_t line_size_{0};
+  size_t line_len_{0};
+  /// A complete line that's only parsed once the next line doesn't continue it.
+  bool line_pending_{false};
+  bool first_line_{true};
+  bool telegram_valid_{true};
+  uint16_t crc_{0};
+  char crc_text_[5]{};
+  uint8_t crc_len_{0};
+
 // Sensor member pointers
 #define DSMR_DECLARE_SENSOR(s) sensor::Sensor *s_##s##_{nullptr};
   DSMR_SENSOR_LIST(DSMR_DECLARE_SENSOR, )
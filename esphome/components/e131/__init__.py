@@ -20,6 +20,7 @@ CHANNELS = {
     "RGBW": e131_ns.E131_RGBW,
 }
 
+CONF_ARTNET = "artnet"
 CONF_UNIVERSE = "universe"
 CONF_E131_ID = "e131_id"
 
@@ -30,6 +31,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_METHOD, default="MULTICAST"): cv.one_of(
                 *METHODS, upper=True
             ),
+            cv.Optional(CONF_ARTNET, default=False): cv.boolean,
         }
     ),
     cv.only_with_arduino,
@@ -40,6 +42,7 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     cg.add(var.set_method(METHODS[config[CONF_METHOD]]))
+    cg.add(var.set_artnet(config[CONF_ARTNET]))
 
 
 @register_addressable_effect(
@@ -18,6 +18,7 @@ namespace e131 {
 
 static const char *const TAG = "e131";
 static const int PORT = 5568;
+static const int ARTNET_PORT = 6454;
 
 E131Component::E131Component() {}
 
@@ -25,6 +26,9 @@ E131Component::~E131Component() {
   if (udp_) {
     udp_->stop();
   }
+  if (artnet_udp_) {
+    artnet_udp_->stop();
+  }
 }
 
 void E131Component::setup() {
@@ -36,23 +40,51 @@ void E131Component::setup() {
     return;
   }
 
+  if (artnet_) {
+    artnet_udp_ = make_unique<WiFiUDP>();
+
+    if (!artnet_udp_->begin(ARTNET_PORT)) {
+      ESP_LOGE(TAG, "Cannot bind Art-Net to %d.", ARTNET_PORT);
+      mark_failed();
+      return;
+    }
+  }
+
   join_igmp_groups_();
 }
 
 void E131Component::loop() {
-  std::vector<uint8_t> payload;
+  receive_(udp_.get(), false);
+
+  if (artnet_udp_) {
+    receive_(artnet_udp_.get(), true);
+  }
+
+  const uint32_t now = millis();
+  for (auto light_effect : light_effects_) {
+    light_effect->check_sync_timeout_(now);
+  }
+}
+
+void E131Component::receive_(UDP *udp, bool artnet) {
   E131Packet packet;
+  uint16_t sync_address = 0;
   int universe = 0;
 
-  while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+  while (int packet_size = udp->parsePacket()) {
+    // anything not fitting in the buffer is too big to be valid, and gets rejected by the length checks
+    int size = udp->read(buffer_, std::min(packet_size, E131_MAX_PACKET_SIZE));
+    if (size <= 0) {
+      continue;
+    }
 
-    if (!udp_->read(&payload[0], payload.size())) {
+    if (artnet ? artnet_sync_packet_(buffer_, size) : sync_packet_(buffer_, size, sync_address)) {
+      sync_(artnet ? ARTNET_SYNC_ADDRESS : sync_address);
       continue;
     }
 
-    if (!packet_(payload, universe, packet)) {
-      ESP_LOGV(TAG, "Invalid packet received of size %zu.", payload.size());
+    if (!(artnet ? artnet_packet_(buffer_, size, universe, packet) : packet_(buffer_, size, universe, packet))) {
+      ESP_LOGV(TAG, "Invalid packet received of size %d.", size);
       continue;
     }
 
@@ -90,6 +122,7 @@ void E131Component::remove_effect(E131AddressableLightEffect *light_effect) {
   for (auto universe = light_effect->get_first_universe(); universe <= light_effect->get_last_universe(); ++universe) {
     leave_(universe);
   }
+  join_sync_universe_(light_effect, 0);
 }
 
 bool E131Component::process_(int universe, const E131Packet &packet) {
@@ -98,12 +131,37 @@ bool E131Component::process_(int universe, const E131Packet &packet) {
   ESP_LOGV(TAG, "Received E1.31 packet for %d universe, with %d bytes", universe, packet.count);
 
   for (auto light_effect : light_effects_) {
-    handled = light_effect->process_(universe, packet) || handled;
+    if (light_effect->process_(universe, packet)) {
+      join_sync_universe_(light_effect, packet.sync_address);
+      handled = true;
+    }
   }
 
   return handled;
 }
 
+void E131Component::join_sync_universe_(E131AddressableLightEffect *light_effect, uint16_t sync_address) {
+  // Art-Net sync packets are broadcast
+  if (sync_address == ARTNET_SYNC_ADDRESS || sync_address == light_effect->sync_universe_)
+    return;
+
+  if (light_effect->sync_universe_ != 0) {
+    leave_(light_effect->sync_universe_);
+  }
+  if (sync_address != 0) {
+    join_(sync_address);
+  }
+  light_effect->sync_universe_ = sync_address;
+}
+
+void E131Component::sync_(uint16_t sync_address) {
+  ESP_LOGV(TAG, "Received sync packet for address %d", sync_address);
+
+  for (auto light_effect : light_effects_) {
+    light_effect->sync_(sync_address);
+  }
+}
+
 }  // namespace e131
 }  // namespace esphome
 
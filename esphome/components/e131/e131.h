@@ -18,10 +18,18 @@ class E131AddressableLightEffect;
 enum E131ListenMethod { E131_MULTICAST, E131_UNICAST };
 
 const int E131_MAX_PROPERTY_VALUES_COUNT = 513;
+/// Size of the receive buffer, big enough for E1.31 and Art-Net DMX packets.
+const int E131_MAX_PACKET_SIZE = 638;
+/// Synchronization address used for Art-Net packets while ArtSync packets are received.
+const uint16_t ARTNET_SYNC_ADDRESS = 0xFFFF;
 
+/// DMX data of a received universe, points into the receive buffer and is only valid while the packet is processed.
 struct E131Packet {
+  /// Number of channel values (without the start code).
   uint16_t count;
-  uint8_t values[E131_MAX_PROPERTY_VALUES_COUNT];
+  const uint8_t *values;
+  /// Output should wait for a sync packet with this address, 0 if the data should be shown immediately.
+  uint16_t sync_address;
 };
 
 class E131Component : public esphome::Component {
@@ -39,10 +47,18 @@ class E131Component : public esphome::Component {
 
  public:
   void set_method(E131ListenMethod listen_method) { this->listen_method_ = listen_method; }
+  void set_artnet(bool artnet) { this->artnet_ = artnet; }
 
  protected:
-  bool packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet);
+  void receive_(UDP *udp, bool artnet);
+  bool packet_(const uint8_t *data, size_t size, int &universe, E131Packet &packet);
+  bool sync_packet_(const uint8_t *data, size_t size, uint16_t &sync_address);
+  bool artnet_packet_(const uint8_t *data, size_t size, int &universe, E131Packet &packet);
+  bool artnet_sync_packet_(const uint8_t *data, size_t size);
   bool process_(int universe, const E131Packet &packet);
+  /// Join the multicast group of the universe that the sync packets for the effect's data are sent to.
+  void join_sync_universe_(E131AddressableLightEffect *light_effect, uint16_t sync_address);
+  void sync_(uint16_t sync_address);
   bool join_igmp_groups_();
   void join_(int universe);
   void leave_(int universe);
@@ -50,9 +66,15 @@ class E131Component : public esphome::Component {
  protected:
   E131ListenMethod listen_method_{E131_MULTICAST};
   std::unique_ptr<UDP> udp_;
+  bool artnet_{false};
+  std::unique_ptr<UDP> artnet_udp_;
+  /// Time of the last ArtSync packet, Art-Net stays in synchronous mode while they keep coming.
+  uint32_t last_artnet_sync_{0};
+  bool artnet_synchronous_{false};
   std::set<E131AddressableLightEffect *> light_effects_;
   std::map<int, int> universe_consumers_;
-  std::map<int, E131Packet> universe_packets_;
+  /// Packets are read into this buffer and processed from there without copying.
+  uint8_t buffer_[E131_MAX_PACKET_SIZE];
 };
 
 }  // namespace e131
@@ -8,7 +8,9 @@ namespace esphome {
 namespace e131 {
 
 static const char *const TAG = "e131_addressable_light_effect";
-static const int MAX_DATA_SIZE = (sizeof(E131Packet::values) - 1);
+static const int MAX_DATA_SIZE = (E131_MAX_PROPERTY_VALUES_COUNT - 1);
+// The network data loss timeout of E1.31, data waiting longer than this for its sync packet is shown without it
+static const uint32_t SYNC_TIMEOUT = 2500;
 
 E131AddressableLightEffect::E131AddressableLightEffect(const std::string &name) : AddressableLightEffect(name) {}
 
@@ -55,41 +57,80 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
 
   int output_offset = (universe - first_universe_) * get_lights_per_universe();
   // limit amount of lights per universe and received
-  int output_end =
-      std::min(it->size(), std::min(output_offset + get_lights_per_universe(), output_offset + packet.count - 1));
-  auto input_data = packet.values + 1;
+  int output_end = std::min(it->size(), output_offset + std::min(get_lights_per_universe(), packet.count / channels_));
+  auto input_data = packet.values;
 
   ESP_LOGV(TAG, "Applying data for '%s' on %d universe, for %d-%d.", get_name().c_str(), universe, output_offset,
            output_end);
 
-  switch (channels_) {
-    case E131_MONO:
-      for (; output_offset < output_end; output_offset++, input_data++) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[0], input_data[0], input_data[0]));
-      }
-      break;
-
-    case E131_RGB:
-      for (; output_offset < output_end; output_offset++, input_data += 3) {
-        auto output = (*it)[output_offset];
-        output.set(
-            Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3));
-      }
-      break;
-
-    case E131_RGBW:
-      for (; output_offset < output_end; output_offset++, input_data += 4) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[1], input_data[2], input_data[3]));
-      }
-      break;
+  // convert in chunks and write them with the bulk pixel access
+  static const int CHUNK_SIZE = 32;
+  Color chunk[CHUNK_SIZE];
+  while (output_offset < output_end) {
+    int count = std::min(CHUNK_SIZE, output_end - output_offset);
+    switch (channels_) {
+      case E131_MONO:
+        for (int i = 0; i < count; i++, input_data++)
+          chunk[i] = Color(input_data[0], input_data[0], input_data[0], input_data[0]);
+        break;
+
+      case E131_RGB:
+        for (int i = 0; i < count; i++, input_data += 3)
+          chunk[i] =
+              Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3);
+        break;
+
+      case E131_RGBW:
+        for (int i = 0; i < count; i++, input_data += 4)
+          chunk[i] = Color(input_data[0], input_data[1], input_data[2], input_data[3]);
+        break;
+    }
+    it->write_span(output_offset, chunk, count);
+    output_offset += count;
   }
 
-  it->schedule_show();
+  if (packet.sync_address != sync_address_) {
+    sync_address_ = packet.sync_address;
+    sync_lost_ = false;
+  }
+  if (packet.sync_address != 0 && !sync_lost_) {
+    // latch together with the other universes when the sync packet arrives
+    if (pending_sync_address_ == 0)
+      pending_since_ = millis();
+    pending_sync_address_ = packet.sync_address;
+  } else {
+    pending_sync_address_ = 0;
+    it->schedule_show();
+  }
   return true;
 }
 
+void E131AddressableLightEffect::sync_(uint16_t sync_address) {
+  if (sync_address != sync_address_)
+    return;
+
+  if (sync_lost_) {
+    ESP_LOGD(TAG, "Sync packets for address %d received again, '%s' waits for them.", sync_address, get_name().c_str());
+    sync_lost_ = false;
+  }
+  if (pending_sync_address_ == 0)
+    return;
+
+  pending_sync_address_ = 0;
+  get_addressable_()->schedule_show();
+}
+
+void E131AddressableLightEffect::check_sync_timeout_(uint32_t now) {
+  if (pending_sync_address_ == 0 || now - pending_since_ < SYNC_TIMEOUT)
+    return;
+
+  ESP_LOGW(TAG, "No sync packet for address %d received, showing the data of '%s' without waiting for it.",
+           pending_sync_address_, get_name().c_str());
+  sync_lost_ = true;
+  pending_sync_address_ = 0;
+  get_addressable_()->schedule_show();
+}
+
 }  // namespace e131
 }  // namespace esphome
 
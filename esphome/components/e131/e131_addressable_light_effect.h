@@ -36,9 +36,21 @@ class E131AddressableLightEffect : public light::AddressableLightEffect {
 
  protected:
   bool process_(int universe, const E131Packet &packet);
+  void sync_(uint16_t sync_address);
+  /// Show data that waited too long for its sync packet.
+  void check_sync_timeout_(uint32_t now);
 
  protected:
   int first_universe_{0};
+  /// Received data waits for a sync packet with this address before it is shown, 0 if nothing is pending.
+  uint16_t pending_sync_address_{0};
+  uint32_t pending_since_{0};
+  /// Sync address of the last received data.
+  uint16_t sync_address_{0};
+  /// No sync packet arrived in time for sync_address_, its data is shown right away until one does.
+  bool sync_lost_{false};
+  /// Universe of the sync address whose multicast group was joined for this effect, 0 if none.
+  uint16_t sync_universe_{0};
   int last_universe_{0};
   E131LightChannels channels_{E131_RGB};
   E131Component *e131_{nullptr};
@@ -1,9 +1,11 @@
 #ifdef USE_ARDUINO
 
 #include "e131.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 #include "esphome/components/network/ip_address.h"
+#include <cstddef>
 #include <cstring>
 
 #include <lwip/init.h>
@@ -20,6 +22,16 @@ static const uint8_t ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x3
 static const uint32_t VECTOR_ROOT = 4;
 static const uint32_t VECTOR_FRAME = 2;
 static const uint8_t VECTOR_DMP = 2;
+static const uint32_t VECTOR_ROOT_EXTENDED = 8;
+static const uint32_t VECTOR_EXTENDED_SYNCHRONIZATION = 1;
+
+static const uint8_t ARTNET_ID[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00};
+static const uint16_t ARTNET_OP_DMX = 0x5000;
+static const uint16_t ARTNET_OP_SYNC = 0x5200;
+static const size_t ARTNET_DMX_HEADER_SIZE = 18;
+static const size_t ARTNET_SYNC_SIZE = 14;
+// Art-Net nodes go back to showing data immediately when no ArtSync was received for this long
+static const uint32_t ARTNET_SYNC_TIMEOUT = 4000;
 
 // E1.31 Packet Structure
 union E131RawPacket {
@@ -37,7 +49,7 @@ union E131RawPacket {
     uint32_t frame_vector;
     uint8_t source_name[64];
     uint8_t priority;
-    uint16_t reserved;
+    uint16_t sync_address;
     uint8_t sequence_number;
     uint8_t options;
     uint16_t universe;
@@ -55,6 +67,24 @@ union E131RawPacket {
   uint8_t raw[638];
 };
 
+// E1.31 Synchronization Packet Structure
+struct E131RawSyncPacket {
+  // Root Layer
+  uint16_t preamble_size;
+  uint16_t postamble_size;
+  uint8_t acn_id[12];
+  uint16_t root_flength;
+  uint32_t root_vector;
+  uint8_t cid[16];
+
+  // Synchronization Frame Layer
+  uint16_t frame_flength;
+  uint32_t frame_vector;
+  uint8_t sequence_number;
+  uint16_t sync_address;
+  uint16_t reserved;
+} __attribute__((packed));
+
 // We need to have at least one `1` value
 // Get the offset of `property_values[1]`
 const size_t E131_MIN_PACKET_SIZE = reinterpret_cast<size_t>(&((E131RawPacket *) nullptr)->property_values[1]);
@@ -112,11 +142,11 @@ void E131Component::leave_(int universe) {
   ESP_LOGD(TAG, "Left %d universe for E1.31.", universe);
 }
 
-bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet) {
-  if (data.size() < E131_MIN_PACKET_SIZE)
+bool E131Component::packet_(const uint8_t *data, size_t size, int &universe, E131Packet &packet) {
+  if (size < E131_MIN_PACKET_SIZE)
     return false;
 
-  auto sbuff = reinterpret_cast<const E131RawPacket *>(&data[0]);
+  auto sbuff = reinterpret_cast<const E131RawPacket *>(data);
 
   if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
     return false;
@@ -130,11 +160,72 @@ bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E13
     return false;
 
   universe = htons(sbuff->universe);
-  packet.count = htons(sbuff->property_value_count);
-  if (packet.count > E131_MAX_PROPERTY_VALUES_COUNT)
+  uint16_t count = htons(sbuff->property_value_count);
+  if (count < 1 || count > E131_MAX_PROPERTY_VALUES_COUNT)
+    return false;
+  if (offsetof(E131RawPacket, property_values) + count > size)
+    return false;
+
+  // skip the start code
+  packet.count = count - 1;
+  packet.values = sbuff->property_values + 1;
+  packet.sync_address = htons(sbuff->sync_address);
+  return true;
+}
+
+bool E131Component::sync_packet_(const uint8_t *data, size_t size, uint16_t &sync_address) {
+  if (size < sizeof(E131RawSyncPacket))
+    return false;
+
+  auto sbuff = reinterpret_cast<const E131RawSyncPacket *>(data);
+
+  if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
+    return false;
+  if (htonl(sbuff->root_vector) != VECTOR_ROOT_EXTENDED)
+    return false;
+  if (htonl(sbuff->frame_vector) != VECTOR_EXTENDED_SYNCHRONIZATION)
+    return false;
+
+  sync_address = htons(sbuff->sync_address);
+  return sync_address != 0;
+}
+
+bool E131Component::artnet_packet_(const uint8_t *data, size_t size, int &universe, E131Packet &packet) {
+  if (size < ARTNET_DMX_HEADER_SIZE)
+    return false;
+  if (memcmp(data, ARTNET_ID, sizeof(ARTNET_ID)) != 0)
+    return false;
+  // the op code is little endian, everything else big endian
+  if ((data[8] | (data[9] << 8)) != ARTNET_OP_DMX)
+    return false;
+
+  // 15 bit port address: net, sub-net and universe
+  universe = ((data[15] & 0x7f) << 8) | data[14];
+  uint16_t count = (data[16] << 8) | data[17];
+  if (count > E131_MAX_PROPERTY_VALUES_COUNT - 1 || ARTNET_DMX_HEADER_SIZE + count > size)
+    return false;
+
+  if (artnet_synchronous_ && millis() - last_artnet_sync_ > ARTNET_SYNC_TIMEOUT) {
+    ESP_LOGD(TAG, "No ArtSync received, leaving synchronous mode.");
+    artnet_synchronous_ = false;
+  }
+
+  packet.count = count;
+  packet.values = data + ARTNET_DMX_HEADER_SIZE;
+  packet.sync_address = artnet_synchronous_ ? ARTNET_SYNC_ADDRESS : 0;
+  return true;
+}
+
+bool E131Component::artnet_sync_packet_(const uint8_t *data, size_t size) {
+  if (size < ARTNET_SYNC_SIZE)
+    return false;
+  if (memcmp(data, ARTNET_ID, sizeof(ARTNET_ID)) != 0)
+    return false;
+  if ((data[8] | (data[9] << 8)) != ARTNET_OP_SYNC)
     return false;
 
-  memcpy(packet.values, sbuff->property_values, packet.count);
+  last_artnet_sync_ = millis();
+  artnet_synchronous_ = true;
   return true;
 }
 
@@ -14,6 +14,8 @@ from esphome.const import (
     CONF_MAX_DURATION,
 )
 
+CONF_PUBLISH_INTERVAL = "publish_interval"
+
 endstop_ns = cg.esphome_ns.namespace("endstop")
 EndstopCover = endstop_ns.class_("EndstopCover", cover.Cover, cg.Component)
 
@@ -28,6 +30,9 @@ CONFIG_SCHEMA = cover.COVER_SCHEMA.extend(
         cv.Required(CONF_CLOSE_ENDSTOP): cv.use_id(binary_sensor.BinarySensor),
         cv.Required(CONF_CLOSE_DURATION): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_MAX_DURATION): cv.positive_time_period_milliseconds,
+        cv.Optional(
+            CONF_PUBLISH_INTERVAL, default="1s"
+        ): cv.positive_time_period_milliseconds,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -57,3 +62,5 @@ async def to_code(config):
 
     if CONF_MAX_DURATION in config:
         cg.add(var.set_max_duration(config[CONF_MAX_DURATION]))
+
+    cg.add(var.set_publish_interval(config[CONF_PUBLISH_INTERVAL]))
@@ -2,6 +2,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 
+#include <cmath>
+
 namespace esphome {
 namespace endstop {
 
@@ -44,46 +46,45 @@ void EndstopCover::setup() {
   } else if (!restore.has_value()) {
     this->position = 0.5f;
   }
-}
-void EndstopCover::loop() {
-  if (this->current_operation == COVER_OPERATION_IDLE)
-    return;
-
-  const uint32_t now = millis();
 
+  this->open_endstop_->add_on_state_callback([this](bool state) { this->check_endstops_(); });
+  this->close_endstop_->add_on_state_callback([this](bool state) { this->check_endstops_(); });
+}
+void EndstopCover::check_endstops_() {
   if (this->current_operation == COVER_OPERATION_OPENING && this->is_open_()) {
-    float dur = (now - this->start_dir_time_) / 1e3f;
+    float dur = (millis() - this->start_dir_time_) / 1e3f;
     ESP_LOGD(TAG, "'%s' - Open endstop reached. Took %.1fs.", this->name_.c_str(), dur);
 
     this->start_direction_(COVER_OPERATION_IDLE);
     this->position = COVER_OPEN;
     this->publish_state();
   } else if (this->current_operation == COVER_OPERATION_CLOSING && this->is_closed_()) {
-    float dur = (now - this->start_dir_time_) / 1e3f;
+    float dur = (millis() - this->start_dir_time_) / 1e3f;
     ESP_LOGD(TAG, "'%s' - Close endstop reached. Took %.1fs.", this->name_.c_str(), dur);
 
     this->start_direction_(COVER_OPERATION_IDLE);
     this->position = COVER_CLOSED;
     this->publish_state();
-  } else if (now - this->start_dir_time_ > this->max_duration_) {
-    ESP_LOGD(TAG, "'%s' - Max duration reached. Stopping cover.", this->name_.c_str());
-    this->start_direction_(COVER_OPERATION_IDLE);
-    this->publish_state();
   }
-
-  // Recompute position every loop cycle
+}
+void EndstopCover::schedule_arrival_() {
+  // the open and closed positions are only reached once the endstop says so
+  if ((this->current_operation == COVER_OPERATION_OPENING && this->target_position_ == COVER_OPEN) ||
+      (this->current_operation == COVER_OPERATION_CLOSING && this->target_position_ == COVER_CLOSED)) {
+    this->cancel_timeout("arrival");
+    return;
+  }
   this->recompute_position_();
-
-  if (this->current_operation != COVER_OPERATION_IDLE && this->is_at_target_()) {
+  const float duration = this->current_operation == COVER_OPERATION_OPENING ? this->open_duration_
+                                                                             : this->close_duration_;
+  // a target that was moved behind the cover is reached right away
+  const uint32_t remaining =
+      this->is_at_target_() ? 0 : uint32_t(std::fabs(this->target_position_ - this->position) * duration);
+  this->set_timeout("arrival", remaining, [this]() {
     this->start_direction_(COVER_OPERATION_IDLE);
+    this->position = this->target_position_;
     this->publish_state();
-  }
-
-  // Send current position every second
-  if (this->current_operation != COVER_OPERATION_IDLE && now - this->last_publish_time_ > 1000) {
-    this->publish_state(false);
-    this->last_publish_time_ = now;
-  }
+  });
 }
 void EndstopCover::dump_config() {
   LOG_COVER("", "Endstop Cover", this);
@@ -91,6 +92,7 @@ void EndstopCover::dump_config() {
   ESP_LOGCONFIG(TAG, "  Open Duration: %.1fs", this->open_duration_ / 1e3f);
   LOG_BINARY_SENSOR("  ", "Close Endstop", this->close_endstop_);
   ESP_LOGCONFIG(TAG, "  Close Duration: %.1fs", this->close_duration_ / 1e3f);
+  ESP_LOGCONFIG(TAG, "  Publish Interval: %.1fs", this->publish_interval_ / 1e3f);
 }
 float EndstopCover::get_setup_priority() const { return setup_priority::DATA; }
 void EndstopCover::stop_prev_trigger_() {
@@ -115,8 +117,12 @@ bool EndstopCover::is_at_target_() const {
   }
 }
 void EndstopCover::start_direction_(CoverOperation dir) {
-  if (dir == this->current_operation)
+  if (dir == this->current_operation) {
+    // the target may have changed
+    if (dir != COVER_OPERATION_IDLE)
+      this->schedule_arrival_();
     return;
+  }
 
   this->recompute_position_();
   Trigger<> *trig;
@@ -143,6 +149,28 @@ void EndstopCover::start_direction_(CoverOperation dir) {
   const uint32_t now = millis();
   this->start_dir_time_ = now;
   this->last_recompute_time_ = now;
+
+  if (dir == COVER_OPERATION_IDLE) {
+    this->cancel_timeout("arrival");
+    this->cancel_timeout("max_duration");
+    this->cancel_interval("publish");
+    return;
+  }
+  // the position is only computed when it's published, and once more when the target is reached
+  this->schedule_arrival_();
+  if (this->max_duration_ != UINT32_MAX) {
+    this->set_timeout("max_duration", this->max_duration_, [this]() {
+      ESP_LOGD(TAG, "'%s' - Max duration reached. Stopping cover.", this->name_.c_str());
+      this->start_direction_(COVER_OPERATION_IDLE);
+      this->publish_state();
+    });
+  }
+  this->set_interval("publish", this->publish_interval_, [this]() {
+    this->recompute_position_();
+    this->publish_state(false);
+  });
+  // an endstop that's already active won't report a change
+  this->check_endstops_();
 }
 void EndstopCover::recompute_position_() {
   if (this->current_operation == COVER_OPERATION_IDLE)
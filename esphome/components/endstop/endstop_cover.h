@@ -11,7 +11,6 @@ namespace endstop {
 class EndstopCover : public cover::Cover, public Component {
  public:
   void setup() override;
-  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override;
 
@@ -23,6 +22,8 @@ class EndstopCover : public cover::Cover, public Component {
   void set_open_duration(uint32_t open_duration) { this->open_duration_ = open_duration; }
   void set_close_duration(uint32_t close_duration) { this->close_duration_ = close_duration; }
   void set_max_duration(uint32_t max_duration) { this->max_duration_ = max_duration; }
+  /// How often the position is published while the cover moves.
+  void set_publish_interval(uint32_t publish_interval) { this->publish_interval_ = publish_interval; }
 
   cover::CoverTraits get_traits() override;
 
@@ -34,6 +35,10 @@ class EndstopCover : public cover::Cover, public Component {
   bool is_at_target_() const;
 
   void start_direction_(cover::CoverOperation dir);
+  /// Stop if the endstop in the direction of the current operation is active.
+  void check_endstops_();
+  /// Set the timeout for when the current operation reaches a target between the endstops.
+  void schedule_arrival_();
 
   void recompute_position_();
 
@@ -49,7 +54,7 @@ class EndstopCover : public cover::Cover, public Component {
   Trigger<> *prev_command_trigger_{nullptr};
   uint32_t last_recompute_time_{0};
   uint32_t start_dir_time_{0};
-  uint32_t last_publish_time_{0};
+  uint32_t publish_interval_{1000};
   float target_position_{0};
 };
 
@@ -13,42 +13,53 @@ namespace esp32 {
 
 static const char *const TAG = "esp32.preferences";
 
-struct NVSData {
-  std::string key;
-  std::vector<uint8_t> data;
-};
-
-static std::vector<NVSData> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+class ESP32PreferenceBackend;
+
+// Preferences saved since the last sync(), each backend is in here at most once (tracked by its pending flag).
+static std::vector<ESP32PreferenceBackend *> s_pending_save;  // NOLINT
+
+/// CRC-32 (IEEE 802.3) of data, used to tell whether a save changes what's in flash.
+static uint32_t preference_crc32(const uint8_t *data, size_t len) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; bit++)
+      crc = (crc >> 1) ^ (0xEDB88320 & (-(crc & 1)));
+  }
+  return ~crc;
+}
 
 class ESP32PreferenceBackend : public ESPPreferenceBackend {
  public:
   std::string key;
   uint32_t nvs_handle;
+  /// Data waiting for the next sync(), only valid if pending is set.
+  std::vector<uint8_t> pending_data;
+  bool pending{false};
+  /// CRC of the data in NVS, only valid if persisted_known is set.
+  uint32_t persisted_crc{0};
+  size_t persisted_len{0};
+  bool persisted_known{false};
+
   bool save(const uint8_t *data, size_t len) override {
-    // try find in pending saves and update that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        obj.data.assign(data, data + len);
-        return true;
-      }
+    // Saving what's already in flash needs no write at all
+    if (!this->pending && this->matches_persisted(data, len))
+      return true;
+    this->pending_data.assign(data, data + len);
+    if (!this->pending) {
+      this->pending = true;
+      s_pending_save.push_back(this);
     }
-    NVSData save{};
-    save.key = key;
-    save.data.assign(data, data + len);
-    s_pending_save.emplace_back(save);
     return true;
   }
   bool load(uint8_t *data, size_t len) override {
-    // try find in pending saves and load from that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        if (obj.data.size() != len) {
-          // size mismatch
-          return false;
-        }
-        memcpy(data, obj.data.data(), len);
-        return true;
+    if (this->pending) {
+      if (this->pending_data.size() != len) {
+        // size mismatch
+        return false;
       }
+      memcpy(data, this->pending_data.data(), len);
+      return true;
     }
 
     size_t actual_len;
@@ -66,8 +77,28 @@ class ESP32PreferenceBackend : public ESPPreferenceBackend {
       ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", key.c_str(), esp_err_to_name(err));
       return false;
     }
+    this->set_persisted(data, len);
     return true;
   }
+
+  void set_persisted(const uint8_t *data, size_t len) {
+    this->persisted_crc = preference_crc32(data, len);
+    this->persisted_len = len;
+    this->persisted_known = true;
+  }
+  bool matches_persisted(const uint8_t *data, size_t len) {
+    if (!this->persisted_known) {
+      // Nothing was loaded or written yet, read the blob in NVS once to find out what's there
+      size_t actual_len;
+      if (nvs_get_blob(nvs_handle, key.c_str(), nullptr, &actual_len) != 0 || actual_len != len)
+        return false;
+      std::vector<uint8_t> stored(len);
+      if (nvs_get_blob(nvs_handle, key.c_str(), stored.data(), &actual_len) != 0)
+        return false;
+      this->set_persisted(stored.data(), len);
+    }
+    return this->persisted_len == len && this->persisted_crc == preference_crc32(data, len);
+  }
 };
 
 class ESP32Preferences : public ESPPreferences {
@@ -111,22 +142,40 @@ class ESP32Preferences : public ESPPreferences {
     if (s_pending_save.empty())
       return true;
 
-    ESP_LOGD(TAG, "Saving preferences to flash...");
     // goal try write all pending saves even if one fails
     bool any_failed = false;
-
-    // go through vector from back to front (makes erase easier/more efficient)
-    for (ssize_t i = s_pending_save.size() - 1; i >= 0; i--) {
-      const auto &save = s_pending_save[i];
-      esp_err_t err = nvs_set_blob(nvs_handle, save.key.c_str(), save.data.data(), save.data.size());
+    bool any_written = false;
+
+    // failed saves stay pending, keep them at the front of the vector
+    size_t remaining = 0;
+    for (auto *pref : s_pending_save) {
+      const auto &data = pref->pending_data;
+      if (pref->matches_persisted(data.data(), data.size())) {
+        ESP_LOGVV(TAG, "Skipping unchanged preference '%s'", pref->key.c_str());
+        this->skipped_writes_++;
+        pref->pending = false;
+        continue;
+      }
+      if (!any_written)
+        ESP_LOGD(TAG, "Saving preferences to flash...");
+      any_written = true;
+      esp_err_t err = nvs_set_blob(nvs_handle, pref->key.c_str(), data.data(), data.size());
       if (err != 0) {
-        ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save.key.c_str(), save.data.size(),
-                 esp_err_to_name(err));
+        ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", pref->key.c_str(), data.size(), esp_err_to_name(err));
+        // NVS might hold one or the other now
+        pref->persisted_known = false;
         any_failed = true;
+        s_pending_save[remaining++] = pref;
         continue;
       }
-      s_pending_save.erase(s_pending_save.begin() + i);
+      this->flash_writes_++;
+      pref->set_persisted(data.data(), data.size());
+      pref->pending = false;
     }
+    s_pending_save.resize(remaining);
+
+    if (!any_written)
+      return true;
 
     // note: commit on esp-idf currently is a no-op, nvs_set_blob always writes
     esp_err_t err = nvs_commit(nvs_handle);
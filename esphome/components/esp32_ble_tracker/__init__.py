@@ -15,6 +15,7 @@ from esphome.const import (
     CONF_ON_BLE_MANUFACTURER_DATA_ADVERTISE,
 )
 from esphome.core import CORE
+from esphome.components import ota
 from esphome.components.esp32 import add_idf_sdkconfig_option
 
 DEPENDENCIES = ["esp32"]
@@ -23,6 +24,14 @@ CONF_ESP32_BLE_ID = "esp32_ble_id"
 CONF_SCAN_PARAMETERS = "scan_parameters"
 CONF_WINDOW = "window"
 CONF_ACTIVE = "active"
+CONF_SCAN_BUFFER_SIZE = "scan_buffer_size"
+CONF_SCAN_BUFFER_PSRAM = "scan_buffer_psram"
+CONF_DUPLICATE_WINDOW = "duplicate_window"
+CONF_ADAPTIVE_SCAN = "adaptive_scan"
+CONF_IDLE_WINDOW = "idle_window"
+CONF_BUSY_WINDOW = "busy_window"
+CONF_OTA_ID = "ota_id"
+CONF_MAX_CONNECTIONS = "max_connections"
 esp32_ble_tracker_ns = cg.esphome_ns.namespace("esp32_ble_tracker")
 ESP32BLETracker = esp32_ble_tracker_ns.class_("ESP32BLETracker", cg.Component)
 ESPBTClient = esp32_ble_tracker_ns.class_("ESPBTClient")
@@ -63,6 +72,35 @@ def validate_scan_parameters(config):
     return config
 
 
+def validate_adaptive_scan(config):
+    if CONF_ADAPTIVE_SCAN not in config:
+        return config
+    interval = config[CONF_SCAN_PARAMETERS][CONF_INTERVAL]
+    window = config[CONF_SCAN_PARAMETERS][CONF_WINDOW]
+    adaptive = config[CONF_ADAPTIVE_SCAN]
+    idle_window = adaptive.get(CONF_IDLE_WINDOW, window)
+    busy_window = adaptive[CONF_BUSY_WINDOW]
+
+    if idle_window > interval:
+        raise cv.Invalid(
+            f"Idle scan window ({idle_window}) needs to be smaller than scan interval ({interval})"
+        )
+    if busy_window > idle_window:
+        raise cv.Invalid(
+            f"Busy scan window ({busy_window}) needs to be smaller than the idle scan window ({idle_window})"
+        )
+    return config
+
+
+def validate_max_connections(value):
+    value = cv.int_range(min=1, max=9)(value)
+    if value > 3 and not CORE.using_esp_idf:
+        raise cv.Invalid(
+            "The Arduino framework is built for at most 3 BLE connections, use esp-idf for more"
+        )
+    return value
+
+
 bt_uuid16_format = "XXXX"
 bt_uuid32_format = "XXXXXXXX"
 bt_uuid128_format = "XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXX"
@@ -122,54 +160,78 @@ def as_reversed_hex_array(value):
     )
 
 
-CONFIG_SCHEMA = cv.Schema(
-    {
-        cv.GenerateID(): cv.declare_id(ESP32BLETracker),
-        cv.Optional(CONF_SCAN_PARAMETERS, default={}): cv.All(
-            cv.Schema(
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(ESP32BLETracker),
+            cv.Optional(CONF_SCAN_PARAMETERS, default={}): cv.All(
+                cv.Schema(
+                    {
+                        cv.Optional(
+                            CONF_DURATION, default="5min"
+                        ): cv.positive_time_period_seconds,
+                        cv.Optional(
+                            CONF_INTERVAL, default="320ms"
+                        ): cv.positive_time_period_milliseconds,
+                        cv.Optional(
+                            CONF_WINDOW, default="30ms"
+                        ): cv.positive_time_period_milliseconds,
+                        cv.Optional(CONF_ACTIVE, default=True): cv.boolean,
+                    }
+                ),
+                validate_scan_parameters,
+            ),
+            cv.Optional(CONF_SCAN_BUFFER_SIZE, default=16): cv.int_range(
+                min=1, max=1024
+            ),
+            cv.Optional(CONF_SCAN_BUFFER_PSRAM, default=False): cv.boolean,
+            cv.Optional(
+                CONF_DUPLICATE_WINDOW, default="0ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_MAX_CONNECTIONS, default=3): validate_max_connections,
+            cv.Optional(CONF_ADAPTIVE_SCAN): cv.Schema(
                 {
+                    cv.Optional(CONF_IDLE_WINDOW): cv.positive_time_period_milliseconds,
                     cv.Optional(
-                        CONF_DURATION, default="5min"
-                    ): cv.positive_time_period_seconds,
-                    cv.Optional(
-                        CONF_INTERVAL, default="320ms"
-                    ): cv.positive_time_period_milliseconds,
-                    cv.Optional(
-                        CONF_WINDOW, default="30ms"
+                        CONF_BUSY_WINDOW, default="10ms"
                     ): cv.positive_time_period_milliseconds,
-                    cv.Optional(CONF_ACTIVE, default=True): cv.boolean,
+                    cv.OnlyWith(CONF_OTA_ID, "ota"): cv.use_id(ota.OTAComponent),
                 }
             ),
-            validate_scan_parameters,
-        ),
-        cv.Optional(CONF_ON_BLE_ADVERTISE): automation.validate_automation(
-            {
-                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(ESPBTAdvertiseTrigger),
-                cv.Optional(CONF_MAC_ADDRESS): cv.mac_address,
-            }
-        ),
-        cv.Optional(CONF_ON_BLE_SERVICE_DATA_ADVERTISE): automation.validate_automation(
-            {
-                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(
-                    BLEServiceDataAdvertiseTrigger
-                ),
-                cv.Optional(CONF_MAC_ADDRESS): cv.mac_address,
-                cv.Required(CONF_SERVICE_UUID): bt_uuid,
-            }
-        ),
-        cv.Optional(
-            CONF_ON_BLE_MANUFACTURER_DATA_ADVERTISE
-        ): automation.validate_automation(
-            {
-                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(
-                    BLEManufacturerDataAdvertiseTrigger
-                ),
-                cv.Optional(CONF_MAC_ADDRESS): cv.mac_address,
-                cv.Required(CONF_MANUFACTURER_ID): bt_uuid,
-            }
-        ),
-    }
-).extend(cv.COMPONENT_SCHEMA)
+            cv.Optional(CONF_ON_BLE_ADVERTISE): automation.validate_automation(
+                {
+                    cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(
+                        ESPBTAdvertiseTrigger
+                    ),
+                    cv.Optional(CONF_MAC_ADDRESS): cv.mac_address,
+                }
+            ),
+            cv.Optional(
+                CONF_ON_BLE_SERVICE_DATA_ADVERTISE
+            ): automation.validate_automation(
+                {
+                    cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(
+                        BLEServiceDataAdvertiseTrigger
+                    ),
+                    cv.Optional(CONF_MAC_ADDRESS): cv.mac_address,
+                    cv.Required(CONF_SERVICE_UUID): bt_uuid,
+                }
+            ),
+            cv.Optional(
+                CONF_ON_BLE_MANUFACTURER_DATA_ADVERTISE
+            ): automation.validate_automation(
+                {
+                    cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(
+                        BLEManufacturerDataAdvertiseTrigger
+                    ),
+                    cv.Optional(CONF_MAC_ADDRESS): cv.mac_address,
+                    cv.Required(CONF_MANUFACTURER_ID): bt_uuid,
+                }
+            ),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    validate_adaptive_scan,
+)
 
 ESP_BLE_DEVICE_SCHEMA = cv.Schema(
     {
@@ -186,6 +248,24 @@ async def to_code(config):
     cg.add(var.set_scan_interval(int(params[CONF_INTERVAL].total_milliseconds / 0.625)))
     cg.add(var.set_scan_window(int(params[CONF_WINDOW].total_milliseconds / 0.625)))
     cg.add(var.set_scan_active(params[CONF_ACTIVE]))
+    cg.add(var.set_scan_buffer_size(config[CONF_SCAN_BUFFER_SIZE]))
+    cg.add(var.set_scan_buffer_psram(config[CONF_SCAN_BUFFER_PSRAM]))
+    cg.add(var.set_duplicate_window(config[CONF_DUPLICATE_WINDOW]))
+    cg.add(var.set_max_connections(config[CONF_MAX_CONNECTIONS]))
+    if CONF_ADAPTIVE_SCAN in config:
+        conf = config[CONF_ADAPTIVE_SCAN]
+        idle_window = conf.get(CONF_IDLE_WINDOW, params[CONF_WINDOW])
+        busy_window = conf[CONF_BUSY_WINDOW]
+        cg.add(
+            var.set_adaptive_scan(
+                int(idle_window.total_milliseconds / 0.625),
+                int(busy_window.total_milliseconds / 0.625),
+            )
+        )
+        if CONF_OTA_ID in conf:
+            ota_var = await cg.get_variable(conf[CONF_OTA_ID])
+            cg.add(var.set_ota(ota_var))
+            cg.add_define("USE_OTA_STATE_CALLBACK")
     for conf in config.get(CONF_ON_BLE_ADVERTISE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
         if CONF_MAC_ADDRESS in conf:
@@ -218,11 +298,22 @@ async def to_code(config):
 
     if CORE.using_esp_idf:
         add_idf_sdkconfig_option("CONFIG_BT_ENABLED", True)
+        # The controller and host both have to allow the connections
+        add_idf_sdkconfig_option(
+            "CONFIG_BTDM_CTRL_BLE_MAX_CONN", config[CONF_MAX_CONNECTIONS]
+        )
+        add_idf_sdkconfig_option(
+            "CONFIG_BT_ACL_CONNECTIONS", config[CONF_MAX_CONNECTIONS]
+        )
 
 
 async def register_ble_device(var, config):
     paren = await cg.get_variable(config[CONF_ESP32_BLE_ID])
-    cg.add(paren.register_listener(var))
+    if CONF_MAC_ADDRESS in config:
+        # Only advertisements from this device are dispatched to it
+        cg.add(paren.register_listener(var, config[CONF_MAC_ADDRESS].as_hex))
+    else:
+        cg.add(paren.register_listener(var))
     return var
 
 
@@ -14,11 +14,16 @@
 #include <freertos/task.h>
 #include <esp_gap_ble_api.h>
 #include <esp_bt_defs.h>
+#include <new>
 
 #ifdef USE_ARDUINO
 #include <esp32-hal-bt.h>
 #endif
 
+#ifdef USE_API
+#include "esphome/components/api/api_server.h"
+#endif
+
 // bt_trace.h
 #undef TAG
 
@@ -47,24 +52,54 @@ void ESP32BLETracker::setup() {
   this->scan_result_lock_ = xSemaphoreCreateMutex();
   this->scan_end_lock_ = xSemaphoreCreateMutex();
 
+  using ScanResult = esp_ble_gap_cb_param_t::ble_scan_result_evt_param;
+  if (this->scan_result_buffer_psram_) {
+    ExternalRAMAllocator<ScanResult> allocator(ExternalRAMAllocator<ScanResult>::ALLOW_FAILURE);
+    this->scan_result_buffer_ = allocator.allocate(this->scan_result_buffer_size_);
+  } else {
+    this->scan_result_buffer_ = new (std::nothrow) ScanResult[this->scan_result_buffer_size_];  // NOLINT
+  }
+  if (this->scan_result_buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate scan result buffer!");
+    this->mark_failed();
+    return;
+  }
+
   if (!ESP32BLETracker::ble_setup()) {
     this->mark_failed();
     return;
   }
 
+  if (this->adaptive_scan_)
+    this->set_interval("adaptive_scan", ADAPTIVE_SCAN_CHECK_INTERVAL, [this]() { this->update_scan_load_(); });
+
   global_esp32_ble_tracker->start_scan_(true);
 }
 
 void ESP32BLETracker::loop() {
-  BLEEvent *ble_event = this->ble_events_.pop();
+  // GATTC events first, they belong to connections that time out if they are delayed
+  BLEEvent *ble_event = this->gattc_events_.front();
   while (ble_event != nullptr) {
-    if (ble_event->type_)
-      this->real_gattc_event_handler_(ble_event->event_.gattc.gattc_event, ble_event->event_.gattc.gattc_if,
-                                      &ble_event->event_.gattc.gattc_param);
-    else
-      this->real_gap_event_handler_(ble_event->event_.gap.gap_event, &ble_event->event_.gap.gap_param);
-    delete ble_event;  // NOLINT(cppcoreguidelines-owning-memory)
-    ble_event = this->ble_events_.pop();
+    this->real_gattc_event_handler_(ble_event->event_.gattc.gattc_event, ble_event->event_.gattc.gattc_if,
+                                    &ble_event->event_.gattc.gattc_param);
+    this->gattc_events_.pop();
+    ble_event = this->gattc_events_.front();
+  }
+  ble_event = this->gap_events_.front();
+  while (ble_event != nullptr) {
+    this->real_gap_event_handler_(ble_event->event_.gap.gap_event, &ble_event->event_.gap.gap_param);
+    this->gap_events_.pop();
+    ble_event = this->gap_events_.front();
+  }
+  uint32_t dropped = this->gattc_events_.take_dropped();
+  if (dropped != 0) {
+    ESP_LOGE(TAG, "GATTC event queue full, dropped %u events.", dropped);
+    this->gattc_events_dropped_ += dropped;
+  }
+  dropped = this->gap_events_.take_dropped();
+  if (dropped != 0) {
+    ESP_LOGW(TAG, "BLE event queue full, dropped %u events.", dropped);
+    this->adverts_dropped_ += dropped;
   }
 
   bool connecting = false;
@@ -72,7 +107,8 @@ void ESP32BLETracker::loop() {
     if (client->state() == ClientState::CONNECTING || client->state() == ClientState::DISCOVERED)
       connecting = true;
   }
-  if (!connecting && xSemaphoreTake(this->scan_end_lock_, 0L)) {
+  this->process_connect_queue_();
+  if (!connecting && this->scan_load_ != ScanLoad::PAUSED && xSemaphoreTake(this->scan_end_lock_, 0L)) {
     xSemaphoreGive(this->scan_end_lock_);
     global_esp32_ble_tracker->start_scan_(false);
   }
@@ -81,7 +117,7 @@ void ESP32BLETracker::loop() {
     uint32_t index = this->scan_result_index_;
     xSemaphoreGive(this->scan_result_lock_);
 
-    if (index >= 16) {
+    if (index >= this->scan_result_buffer_size_) {
       ESP_LOGW(TAG, "Too many BLE events to process. Some devices may not show up.");
     }
     for (size_t i = 0; i < index; i++) {
@@ -93,18 +129,44 @@ void ESP32BLETracker::loop() {
         if (listener->parse_device(device))
           found = true;
 
-      for (auto *client : this->clients_)
+      auto range = this->address_listeners_.equal_range(device.address_uint64());
+      // Only hashed when a listener of the address skips duplicates
+      optional<bool> duplicate;
+      for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->skips_duplicates()) {
+          if (!duplicate.has_value())
+            duplicate = this->is_duplicate_(device);
+          if (*duplicate) {
+            // Already handled by the listener, it just shouldn't be logged as an unknown device
+            found = true;
+            continue;
+          }
+        }
+        if (it->second->parse_device(device))
+          found = true;
+      }
+
+      uint8_t active_connections = this->get_active_connections();
+      for (auto *client : this->clients_) {
+        // Clients that aren't connected are only offered their device while there is a connection left for them
+        if (client->state() == ClientState::IDLE && active_connections >= this->max_connections_)
+          continue;
         if (client->parse_device(device)) {
           found = true;
           if (client->state() == ClientState::DISCOVERED) {
+            this->connect_queue_.push_back(client);
+            active_connections++;
             esp_ble_gap_stop_scanning();
             if (xSemaphoreTake(this->scan_end_lock_, 10L / portTICK_PERIOD_MS)) {
               xSemaphoreGive(this->scan_end_lock_);
             }
           }
         }
+      }
 
-      if (!found) {
+      if (found) {
+        this->adverts_dispatched_++;
+      } else {
         this->print_bt_device_info(device);
       }
     }
@@ -212,19 +274,28 @@ void ESP32BLETracker::start_scan_(bool first) {
   }
 
   ESP_LOGD(TAG, "Starting scan...");
-  if (!first) {
+  if (!first && !this->scan_restart_) {
     for (auto *listener : this->listeners_)
       listener->on_scan_end();
+    for (auto &it : this->address_listeners_)
+      it.second->on_scan_end();
   }
+  this->scan_restart_ = false;
   this->already_discovered_.clear();
   this->scan_params_.scan_type = this->scan_active_ ? BLE_SCAN_TYPE_ACTIVE : BLE_SCAN_TYPE_PASSIVE;
   this->scan_params_.own_addr_type = BLE_ADDR_TYPE_PUBLIC;
   this->scan_params_.scan_filter_policy = BLE_SCAN_FILTER_ALLOW_ALL;
   this->scan_params_.scan_interval = this->scan_interval_;
   this->scan_params_.scan_window = this->scan_window_;
+  if (this->adaptive_scan_) {
+    this->scan_params_.scan_window =
+        this->scan_load_ == ScanLoad::BUSY ? this->busy_scan_window_ : this->idle_scan_window_;
+  }
 
   esp_ble_gap_set_scan_params(&this->scan_params_);
   esp_ble_gap_start_scanning(this->scan_duration_);
+  this->account_radio_time_();
+  this->scanning_ = true;
 
   this->set_timeout("scan", this->scan_duration_ * 2000, []() {
     ESP_LOGW(TAG, "ESP-IDF BLE scan never terminated, rebooting to restore BLE stack...");
@@ -232,15 +303,136 @@ void ESP32BLETracker::start_scan_(bool first) {
   });
 }
 
+bool ESP32BLETracker::is_duplicate_(const ESPBTDevice &device) {
+  if (this->duplicate_window_ == 0)
+    return false;
+
+  // FNV-1a over the raw advertisement and scan response
+  const auto &param = device.get_scan_result();
+  uint32_t hash = 2166136261UL;
+  for (uint16_t i = 0; i < param.adv_data_len + param.scan_rsp_len; i++) {
+    hash ^= param.ble_adv[i];
+    hash *= 16777619UL;
+  }
+
+  const uint32_t now = millis();
+  auto &recent = this->recent_payloads_[device.address_uint64()];
+  uint8_t slot = recent.time[0] <= recent.time[1] ? 0 : 1;
+  for (uint8_t i = 0; i < 2; i++) {
+    if (recent.hash[i] != hash)
+      continue;
+    if (now - recent.time[i] < this->duplicate_window_)
+      return true;
+    slot = i;
+  }
+  recent.hash[slot] = hash;
+  recent.time[slot] = now;
+  return false;
+}
+
+void ESP32BLETracker::update_scan_load_() {
+  const uint32_t now = millis();
+#ifdef USE_API
+  if (api::global_api_server != nullptr && api::global_api_server->is_busy())
+    this->last_busy_ = now;
+#endif
+
+  ScanLoad load = ScanLoad::IDLE;
+  if (this->ota_in_progress_) {
+    load = ScanLoad::PAUSED;
+  } else if (this->last_busy_ != 0 && now - this->last_busy_ < ADAPTIVE_SCAN_BUSY_HOLD) {
+    load = ScanLoad::BUSY;
+  }
+  this->set_scan_load_(load);
+}
+
+void ESP32BLETracker::set_scan_load_(ScanLoad load) {
+  if (load == this->scan_load_)
+    return;
+  static const char *const LOAD_STRS[] = {"IDLE", "BUSY", "PAUSED"};
+  ESP_LOGD(TAG, "Scan load changed from %s to %s", LOAD_STRS[static_cast<uint8_t>(this->scan_load_)],
+           LOAD_STRS[static_cast<uint8_t>(load)]);
+  this->scan_load_ = load;
+
+  if (load == ScanLoad::PAUSED) {
+    // Scanning stays stopped until the load changes, the watchdog for a hanging scan must not fire meanwhile
+    this->cancel_timeout("scan");
+  }
+  // loop() starts the next scan (with the new window) once this one has stopped
+  if (this->scanning_) {
+    this->scan_restart_ = true;
+    esp_ble_gap_stop_scanning();
+  }
+}
+
+#ifdef USE_OTA_STATE_CALLBACK
+void ESP32BLETracker::set_ota(ota::OTAComponent *ota) {
+  ota->add_on_state_callback([this](ota::OTAState state, float progress, uint8_t error) {
+    // OTA blocks the main loop while it runs, so the scan has to be paused right away
+    this->ota_in_progress_ = state == ota::OTA_STARTED || state == ota::OTA_IN_PROGRESS;
+    if (this->ota_in_progress_) {
+      this->set_scan_load_(ScanLoad::PAUSED);
+    } else {
+      this->update_scan_load_();
+    }
+  });
+}
+#endif
+
+void ESP32BLETracker::account_radio_time_() {
+  const uint32_t now = millis();
+  if (this->scanning_) {
+    const uint64_t elapsed = now - this->radio_time_since_;
+    this->radio_time_ += elapsed * this->scan_params_.scan_window / this->scan_params_.scan_interval;
+  }
+  this->radio_time_since_ = now;
+}
+
+uint32_t ESP32BLETracker::get_radio_time() {
+  this->account_radio_time_();
+  return this->radio_time_;
+}
+
 void ESP32BLETracker::register_client(ESPBTClient *client) {
   client->app_id = ++this->app_id_;
   this->clients_.push_back(client);
 }
 
+uint8_t ESP32BLETracker::get_active_connections() const {
+  uint8_t count = 0;
+  for (auto *client : this->clients_) {
+    if (client->state() != ClientState::IDLE)
+      count++;
+  }
+  return count;
+}
+
+void ESP32BLETracker::process_connect_queue_() {
+  // Clients that were reset while they waited don't need their connection anymore
+  while (!this->connect_queue_.empty() && this->connect_queue_.front()->state() != ClientState::DISCOVERED)
+    this->connect_queue_.pop_front();
+  if (this->connect_queue_.empty())
+    return;
+  // The controller only handles one connection attempt at a time, and none while it is scanning
+  if (this->scanning_)
+    return;
+  for (auto *client : this->clients_) {
+    if (client->state() == ClientState::CONNECTING)
+      return;
+  }
+
+  ESPBTClient *client = this->connect_queue_.front();
+  this->connect_queue_.pop_front();
+  client->connect();
+}
+
 void ESP32BLETracker::gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
-  BLEEvent *gap_event = new BLEEvent(event, param);  // NOLINT(cppcoreguidelines-owning-memory)
-  global_esp32_ble_tracker->ble_events_.push(gap_event);
-}  // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+  BLEEvent *gap_event = global_esp32_ble_tracker->gap_events_.begin_push();
+  if (gap_event == nullptr)
+    return;
+  gap_event->load(event, param);
+  global_esp32_ble_tracker->gap_events_.end_push();
+}
 
 void ESP32BLETracker::real_gap_event_handler_(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
   switch (event) {
@@ -270,27 +462,39 @@ void ESP32BLETracker::gap_scan_start_complete_(const esp_ble_gap_cb_param_t::ble
 }
 
 void ESP32BLETracker::gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_scan_stop_cmpl_evt_param &param) {
+  this->account_radio_time_();
+  this->scanning_ = false;
   xSemaphoreGive(this->scan_end_lock_);
 }
 
 void ESP32BLETracker::gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
   if (param.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
+    this->adverts_seen_++;
     if (xSemaphoreTake(this->scan_result_lock_, 0L)) {
-      if (this->scan_result_index_ < 16) {
+      if (this->scan_result_index_ < this->scan_result_buffer_size_) {
         this->scan_result_buffer_[this->scan_result_index_++] = param;
+      } else {
+        this->adverts_dropped_++;
       }
       xSemaphoreGive(this->scan_result_lock_);
+    } else {
+      this->adverts_dropped_++;
     }
   } else if (param.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT) {
+    this->account_radio_time_();
+    this->scanning_ = false;
     xSemaphoreGive(this->scan_end_lock_);
   }
 }
 
 void ESP32BLETracker::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                                           esp_ble_gattc_cb_param_t *param) {
-  BLEEvent *gattc_event = new BLEEvent(event, gattc_if, param);  // NOLINT(cppcoreguidelines-owning-memory)
-  global_esp32_ble_tracker->ble_events_.push(gattc_event);
-}  // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+  BLEEvent *gattc_event = global_esp32_ble_tracker->gattc_events_.begin_push();
+  if (gattc_event == nullptr)
+    return;
+  gattc_event->load(event, gattc_if, param);
+  global_esp32_ble_tracker->gattc_events_.end_push();
+}
 
 void ESP32BLETracker::real_gattc_event_handler_(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                                                 esp_ble_gattc_cb_param_t *param) {
@@ -488,9 +692,10 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
     this->address_[i] = param.bda[i];
   this->address_type_ = param.ble_addr_type;
   this->rssi_ = param.rssi;
-  this->parse_adv_(param);
+  this->adv_parsed_ = false;
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+  this->parse_adv_();
   ESP_LOGVV(TAG, "Parse Result:");
   const char *address_type = "";
   switch (this->address_type_) {
@@ -544,21 +749,41 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
   ESP_LOGVV(TAG, "Adv data: %s", format_hex_pretty(param.ble_adv, param.adv_data_len + param.scan_rsp_len).c_str());
 #endif
 }
-void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
-  size_t offset = 0;
-  const uint8_t *payload = param.ble_adv;
-  uint8_t len = param.adv_data_len + param.scan_rsp_len;
+bool ESPBTDevice::next_ad_record(size_t &offset, ESPBTAdRecord &record) const {
+  const uint8_t *payload = this->scan_result_.ble_adv;
+  const size_t len = this->scan_result_.adv_data_len + this->scan_result_.scan_rsp_len;
 
-  while (offset + 2 < len) {
-    const uint8_t field_length = payload[offset++];  // First byte is length of adv record
-    if (field_length == 0)
-      break;
+  if (offset + 2 >= len)
+    return false;
+  const uint8_t field_length = payload[offset];  // First byte is length of adv record
+  if (field_length == 0 || offset + 1 + field_length > len)
+    return false;
 
-    // first byte of adv record is adv record type
-    const uint8_t record_type = payload[offset++];
-    const uint8_t *record = &payload[offset];
-    const uint8_t record_length = field_length - 1;
-    offset += record_length;
+  // first byte of adv record is adv record type
+  record.type = payload[offset + 1];
+  record.data = &payload[offset + 2];
+  record.length = field_length - 1;
+  offset += 1 + field_length;
+  return true;
+}
+void ESPBTDevice::parse_adv_() const {
+  if (this->adv_parsed_)
+    return;
+  this->adv_parsed_ = true;
+  this->name_.clear();
+  this->tx_powers_.clear();
+  this->appearance_.reset();
+  this->ad_flag_.reset();
+  this->service_uuids_.clear();
+  this->manufacturer_datas_.clear();
+  this->service_datas_.clear();
+
+  size_t offset = 0;
+  ESPBTAdRecord ad_record{};
+  while (this->next_ad_record(offset, ad_record)) {
+    const uint8_t record_type = ad_record.type;
+    const uint8_t *record = ad_record.data;
+    const uint8_t record_length = ad_record.length;
 
     // See also Generic Access Profile Assigned Numbers:
     // https://www.bluetooth.com/specifications/assigned-numbers/generic-access-profile/ See also ADVERTISING AND SCAN
@@ -578,7 +803,7 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // CSS 1.5 TX POWER LEVEL
         // "The TX Power Level data type indicates the transmitted power level of the packet containing the data type."
         // CSS 1: Optional in this context (may appear more than once in a block).
-        this->tx_powers_.push_back(*payload);
+        this->tx_powers_.push_back(*record);
         break;
       }
       case ESP_BLE_AD_TYPE_APPEARANCE: {
@@ -708,14 +933,25 @@ void ESP32BLETracker::dump_config() {
   ESP_LOGCONFIG(TAG, "  Scan Interval: %.1f ms", this->scan_interval_ * 0.625f);
   ESP_LOGCONFIG(TAG, "  Scan Window: %.1f ms", this->scan_window_ * 0.625f);
   ESP_LOGCONFIG(TAG, "  Scan Type: %s", this->scan_active_ ? "ACTIVE" : "PASSIVE");
+  ESP_LOGCONFIG(TAG, "  Scan Buffer Size: %u%s", this->scan_result_buffer_size_,
+                this->scan_result_buffer_psram_ ? " (PSRAM)" : "");
+  if (this->duplicate_window_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Duplicate Window: %u ms", this->duplicate_window_);
+  }
+  ESP_LOGCONFIG(TAG, "  Max Connections: %u", this->max_connections_);
+  if (this->adaptive_scan_) {
+    ESP_LOGCONFIG(TAG, "  Adaptive Scan:");
+    ESP_LOGCONFIG(TAG, "    Idle Window: %.1f ms", this->idle_scan_window_ * 0.625f);
+    ESP_LOGCONFIG(TAG, "    Busy Window: %.1f ms", this->busy_scan_window_ * 0.625f);
+  }
 }
 void ESP32BLETracker::print_bt_device_info(const ESPBTDevice &device) {
   const uint64_t address = device.address_uint64();
-  for (auto &disc : this->already_discovered_) {
-    if (disc == address)
-      return;
-  }
-  this->already_discovered_.push_back(address);
+  if (this->already_discovered_.count(address) != 0)
+    return;
+  if (this->already_discovered_.size() >= MAX_DISCOVERED)
+    this->already_discovered_.clear();
+  this->already_discovered_.insert(address);
 
   ESP_LOGD(TAG, "Found device %s RSSI=%d", device.address_str().c_str(), device.get_rssi());
 
@@ -8,10 +8,17 @@
 
 #include <string>
 #include <array>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
 #include <esp_gap_ble_api.h>
 #include <esp_gattc_api.h>
 #include <esp_bt_defs.h>
 
+#ifdef USE_OTA_STATE_CALLBACK
+#include "esphome/components/ota/ota_component.h"
+#endif
+
 namespace esphome {
 namespace esp32_ble_tracker {
 
@@ -73,6 +80,13 @@ class ESPBLEiBeacon {
   } PACKED beacon_data_;
 };
 
+/// A single AD structure of an advertisement, pointing into the raw advertisement data.
+struct ESPBTAdRecord {
+  uint8_t type;
+  const uint8_t *data;
+  uint8_t length;
+};
+
 class ESPBTDevice {
  public:
   void parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
@@ -85,22 +99,53 @@ class ESPBTDevice {
 
   esp_ble_addr_type_t get_address_type() const { return this->address_type_; }
   int get_rssi() const { return rssi_; }
-  const std::string &get_name() const { return this->name_; }
 
-  const std::vector<int8_t> &get_tx_powers() const { return tx_powers_; }
+  /** Iterate over the AD structures in the raw advertisement without decoding them.
+   *
+   * Start with offset 0 and call this until it returns false. The record points into this device, so it's only valid
+   * as long as the device is.
+   */
+  bool next_ad_record(size_t &offset, ESPBTAdRecord &record) const;
+
+  // The accessors below decode the whole advertisement on first use, so devices nobody is interested in are never
+  // decoded.
+  const std::string &get_name() const {
+    this->parse_adv_();
+    return this->name_;
+  }
 
-  const optional<uint16_t> &get_appearance() const { return appearance_; }
-  const optional<uint8_t> &get_ad_flag() const { return ad_flag_; }
-  const std::vector<ESPBTUUID> &get_service_uuids() const { return service_uuids_; }
+  const std::vector<int8_t> &get_tx_powers() const {
+    this->parse_adv_();
+    return tx_powers_;
+  }
 
-  const std::vector<ServiceData> &get_manufacturer_datas() const { return manufacturer_datas_; }
+  const optional<uint16_t> &get_appearance() const {
+    this->parse_adv_();
+    return appearance_;
+  }
+  const optional<uint8_t> &get_ad_flag() const {
+    this->parse_adv_();
+    return ad_flag_;
+  }
+  const std::vector<ESPBTUUID> &get_service_uuids() const {
+    this->parse_adv_();
+    return service_uuids_;
+  }
+
+  const std::vector<ServiceData> &get_manufacturer_datas() const {
+    this->parse_adv_();
+    return manufacturer_datas_;
+  }
 
-  const std::vector<ServiceData> &get_service_datas() const { return service_datas_; }
+  const std::vector<ServiceData> &get_service_datas() const {
+    this->parse_adv_();
+    return service_datas_;
+  }
 
   const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &get_scan_result() const { return scan_result_; }
 
   optional<ESPBLEiBeacon> get_ibeacon() const {
-    for (auto &it : this->manufacturer_datas_) {
+    for (auto &it : this->get_manufacturer_datas()) {
       auto res = ESPBLEiBeacon::from_manufacturer_data(it);
       if (res.has_value())
         return *res;
@@ -109,20 +154,22 @@ class ESPBTDevice {
   }
 
  protected:
-  void parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
+  /// Decode the raw advertisement into the members below, only the first call does any work.
+  void parse_adv_() const;
 
   esp_bd_addr_t address_{
       0,
   };
   esp_ble_addr_type_t address_type_{BLE_ADDR_TYPE_PUBLIC};
   int rssi_{0};
-  std::string name_{};
-  std::vector<int8_t> tx_powers_{};
-  optional<uint16_t> appearance_{};
-  optional<uint8_t> ad_flag_{};
-  std::vector<ESPBTUUID> service_uuids_;
-  std::vector<ServiceData> manufacturer_datas_{};
-  std::vector<ServiceData> service_datas_{};
+  mutable bool adv_parsed_{false};
+  mutable std::string name_{};
+  mutable std::vector<int8_t> tx_powers_{};
+  mutable optional<uint16_t> appearance_{};
+  mutable optional<uint8_t> ad_flag_{};
+  mutable std::vector<ESPBTUUID> service_uuids_;
+  mutable std::vector<ServiceData> manufacturer_datas_{};
+  mutable std::vector<ServiceData> service_datas_{};
   esp_ble_gap_cb_param_t::ble_scan_result_evt_param scan_result_{};
 };
 
@@ -132,6 +179,12 @@ class ESPBTDeviceListener {
  public:
   virtual void on_scan_end() {}
   virtual bool parse_device(const ESPBTDevice &device) = 0;
+  /** Whether advertisements with the same payload as one parsed less than duplicate_window ago can be skipped.
+   *
+   * Only for listeners registered for an address that just decode the payload, the ones that use the RSSI or the time
+   * of every advertisement (like ble_rssi and ble_presence) have to keep getting them all.
+   */
+  virtual bool skips_duplicates() const { return false; }
   void set_parent(ESP32BLETracker *parent) { parent_ = parent; }
 
  protected:
@@ -164,12 +217,73 @@ class ESPBTClient : public ESPBTDeviceListener {
   ClientState state_;
 };
 
+/// Number of GAP events that can be queued between two loop() calls (one slot always stays free).
+static const size_t BLE_GAP_EVENT_QUEUE_SIZE = 32;
+/// GATTC events have their own queue, so a burst of scan events can't push out connection events.
+static const size_t BLE_GATTC_EVENT_QUEUE_SIZE = 16;
+/// Upper bound on the number of distinct unknown devices logged per scan, so busy places can't exhaust the heap.
+static const size_t MAX_DISCOVERED = 256;
+/// How often the Wi-Fi load is checked in adaptive scan mode.
+static const uint32_t ADAPTIVE_SCAN_CHECK_INTERVAL = 1000;
+/// How long the load has to stay low before scanning is boosted again, so short bursts don't restart the scan.
+static const uint32_t ADAPTIVE_SCAN_BUSY_HOLD = 5000;
+
+/// How much of the radio the scanner may take from Wi-Fi, only changes in adaptive scan mode.
+enum class ScanLoad : uint8_t {
+  /// Wi-Fi is quiet, scan with the idle window.
+  IDLE,
+  /// The API is streaming, scan with the busy window.
+  BUSY,
+  /// An OTA update is running, don't scan at all.
+  PAUSED,
+};
+
 class ESP32BLETracker : public Component {
  public:
   void set_scan_duration(uint32_t scan_duration) { scan_duration_ = scan_duration; }
   void set_scan_interval(uint32_t scan_interval) { scan_interval_ = scan_interval; }
   void set_scan_window(uint32_t scan_window) { scan_window_ = scan_window; }
   void set_scan_active(bool scan_active) { scan_active_ = scan_active; }
+  /// Number of scan results that can be buffered between two loop() calls.
+  void set_scan_buffer_size(uint16_t scan_buffer_size) { scan_result_buffer_size_ = scan_buffer_size; }
+  /// Allocate the scan result buffer in PSRAM if it's available.
+  void set_scan_buffer_psram(bool scan_buffer_psram) { scan_result_buffer_psram_ = scan_buffer_psram; }
+
+  /** Don't dispatch an advertisement to the listeners registered for its address that skip duplicates if the same
+   * payload from that address was dispatched less than duplicate_window ms ago. 0 (the default) dispatches every
+   * advertisement.
+   */
+  void set_duplicate_window(uint32_t duplicate_window) { duplicate_window_ = duplicate_window; }
+
+  /** Adapt the scan window to the Wi-Fi load: scan with idle_window while the API is quiet and with busy_window
+   * while it streams (camera images, logs or a send backlog). Windows are in 0.625ms units like the scan window.
+   */
+  void set_adaptive_scan(uint32_t idle_window, uint32_t busy_window) {
+    this->adaptive_scan_ = true;
+    this->idle_scan_window_ = idle_window;
+    this->busy_scan_window_ = busy_window;
+  }
+#ifdef USE_OTA_STATE_CALLBACK
+  /// Pause scanning while an OTA update is running.
+  void set_ota(ota::OTAComponent *ota);
+#endif
+  /** Number of GATT connections clients may hold at the same time. Clients discovered while all connections are in
+   * use wait until one is released, those discovered meanwhile are connected one after another in discovery order.
+   */
+  void set_max_connections(uint8_t max_connections) { this->max_connections_ = max_connections; }
+
+  ScanLoad get_scan_load() const { return this->scan_load_; }
+  /// Milliseconds the scanner had the radio since boot, that is the time spent scanning weighted by window/interval.
+  uint32_t get_radio_time();
+
+  /// Number of advertisements received since boot.
+  uint32_t get_adverts_seen() const { return this->adverts_seen_; }
+  /// Number of advertisements (and other BLE events) lost because a buffer was full since boot.
+  uint32_t get_adverts_dropped() const { return this->adverts_dropped_; }
+  /// Number of GATTC events that were lost because loop() didn't keep up.
+  uint32_t get_gattc_events_dropped() const { return this->gattc_events_dropped_; }
+  /// Number of advertisements claimed by at least one listener or client since boot.
+  uint32_t get_adverts_dispatched() const { return this->adverts_dispatched_; }
 
   /// Setup the FreeRTOS task and the Bluetooth stack.
   void setup() override;
@@ -178,12 +292,20 @@ class ESP32BLETracker : public Component {
 
   void loop() override;
 
+  /// Register a listener that is offered every advertisement.
   void register_listener(ESPBTDeviceListener *listener) {
     listener->set_parent(this);
     this->listeners_.push_back(listener);
   }
+  /// Register a listener that is only offered advertisements from the given MAC address.
+  void register_listener(ESPBTDeviceListener *listener, uint64_t address) {
+    listener->set_parent(this);
+    this->address_listeners_.emplace(address, listener);
+  }
 
   void register_client(ESPBTClient *client);
+  /// Number of clients connecting or connected right now.
+  uint8_t get_active_connections() const;
 
   void print_bt_device_info(const ESPBTDevice &device);
 
@@ -204,16 +326,43 @@ class ESP32BLETracker : public Component {
   /// Called when a `ESP_GAP_BLE_SCAN_STOP_COMPLETE_EVT` event is received.
   void gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_scan_stop_cmpl_evt_param &param);
 
+  /// Whether this advertisement repeats a payload recently dispatched to the address listeners of the device.
+  bool is_duplicate_(const ESPBTDevice &device);
+
+  /// Check the Wi-Fi load and switch the scan load accordingly.
+  void update_scan_load_();
+  /// Restart the current scan (if any) with the parameters for the given load.
+  void set_scan_load_(ScanLoad load);
+  /// Add the radio time of the scan running since the last call to radio_time_.
+  void account_radio_time_();
+  /// Connect the next queued client if no connection attempt is running and the scan is stopped.
+  void process_connect_queue_();
+
   int app_id_;
   /// Callback that will handle all GATTC events and redistribute them to other callbacks.
   static void gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if, esp_ble_gattc_cb_param_t *param);
   void real_gattc_event_handler_(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if, esp_ble_gattc_cb_param_t *param);
 
-  /// Vector of addresses that have already been printed in print_bt_device_info
-  std::vector<uint64_t> already_discovered_;
+  /// Addresses that have already been printed in print_bt_device_info during this scan, at most MAX_DISCOVERED.
+  std::unordered_set<uint64_t> already_discovered_;
+  /// Listeners interested in all devices.
   std::vector<ESPBTDeviceListener *> listeners_;
+  /// Listeners interested in a single device, keyed by MAC address.
+  std::unordered_multimap<uint64_t, ESPBTDeviceListener *> address_listeners_;
+  /// Hashes of the last two payloads dispatched per address and when they were dispatched. Two are kept because with
+  /// active scanning devices alternate between their advertisement and their scan response.
+  struct RecentPayloads {
+    uint32_t hash[2];
+    uint32_t time[2];
+  };
+  /// Only has entries for addresses in address_listeners_, so it's bounded by the configuration.
+  std::unordered_map<uint64_t, RecentPayloads> recent_payloads_;
+  uint32_t duplicate_window_{0};
   /// Client parameters.
   std::vector<ESPBTClient *> clients_;
+  /// Discovered clients waiting for their connection attempt, in discovery order.
+  std::deque<ESPBTClient *> connect_queue_;
+  uint8_t max_connections_{3};
   /// A structure holding the ESP BLE scan parameters.
   esp_ble_scan_params_t scan_params_;
   /// The interval in seconds to perform scans.
@@ -221,14 +370,34 @@ class ESP32BLETracker : public Component {
   uint32_t scan_interval_;
   uint32_t scan_window_;
   bool scan_active_;
+  bool adaptive_scan_{false};
+  uint32_t idle_scan_window_;
+  uint32_t busy_scan_window_;
+  ScanLoad scan_load_{ScanLoad::IDLE};
+  uint32_t last_busy_{0};
+  bool ota_in_progress_{false};
+  /// Whether a scan was started and hasn't ended yet.
+  bool scanning_{false};
+  /// The running scan is only stopped to apply new parameters, listeners shouldn't see it as the end of a scan.
+  bool scan_restart_{false};
+  uint64_t radio_time_{0};
+  uint32_t radio_time_since_{0};
   SemaphoreHandle_t scan_result_lock_;
   SemaphoreHandle_t scan_end_lock_;
   size_t scan_result_index_{0};
-  esp_ble_gap_cb_param_t::ble_scan_result_evt_param scan_result_buffer_[16];
+  esp_ble_gap_cb_param_t::ble_scan_result_evt_param *scan_result_buffer_{nullptr};
+  uint16_t scan_result_buffer_size_{16};
+  bool scan_result_buffer_psram_{false};
+  uint32_t adverts_seen_{0};
+  uint32_t adverts_dropped_{0};
+  uint32_t adverts_dispatched_{0};
+  uint32_t gattc_events_dropped_{0};
   esp_bt_status_t scan_start_failed_{ESP_BT_STATUS_SUCCESS};
   esp_bt_status_t scan_set_param_failed_{ESP_BT_STATUS_SUCCESS};
 
-  Queue<BLEEvent> ble_events_;
+  /// GAP and GATTC events copied in by the Bluetooth task (the only producer) and handled in loop().
+  Queue<BLEEvent, BLE_GAP_EVENT_QUEUE_SIZE> gap_events_;
+  Queue<BLEEvent, BLE_GATTC_EVENT_QUEUE_SIZE> gattc_events_;
 };
 
 // NOLINTNEXTLINE
@@ -4,19 +4,17 @@
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 
-#include <queue>
-#include <mutex>
+#include <atomic>
 #include <cstring>
+#include <vector>
 
 #include <esp_gap_ble_api.h>
 #include <esp_gattc_api.h>
-#include <freertos/FreeRTOS.h>
-#include <freertos/semphr.h>
 
 /*
  * BLE events come in from a separate Task (thread) in the ESP32 stack. Rather
  * than trying to deal with various locking strategies, all incoming GAP and GATT
- * events will simply be placed on a semaphore guarded queue. The next time the
+ * events will simply be copied into a lock-free ring. The next time the
  * component runs loop(), these events are popped off the queue and handed at
  * this safer time.
  */
@@ -24,67 +22,79 @@
 namespace esphome {
 namespace esp32_ble_tracker {
 
-template<class T> class Queue {
+/// Fixed size single-producer single-consumer ring, elements are stored in place so pushing never allocates.
+template<class T, size_t SIZE> class Queue {
  public:
-  Queue() { m_ = xSemaphoreCreateMutex(); }
-
-  void push(T *element) {
-    if (element == nullptr)
-      return;
-    if (xSemaphoreTake(m_, 5L / portTICK_PERIOD_MS)) {
-      q_.push(element);
-      xSemaphoreGive(m_);
+  /// Get the slot to fill with the next element, or nullptr if the queue is full. Only called by the producer.
+  T *begin_push() {
+    size_t head = this->head_.load(std::memory_order_relaxed);
+    if ((head + 1) % SIZE == this->tail_.load(std::memory_order_acquire)) {
+      this->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
     }
+    return &this->slots_[head];
+  }
+  /// Make the slot returned by begin_push() visible to the consumer.
+  void end_push() {
+    size_t head = this->head_.load(std::memory_order_relaxed);
+    this->head_.store((head + 1) % SIZE, std::memory_order_release);
   }
 
-  T *pop() {
-    T *element = nullptr;
-
-    if (xSemaphoreTake(m_, 5L / portTICK_PERIOD_MS)) {
-      if (!q_.empty()) {
-        element = q_.front();
-        q_.pop();
-      }
-      xSemaphoreGive(m_);
-    }
-    return element;
+  /// Get the oldest element, or nullptr if the queue is empty. Only called by the consumer.
+  T *front() {
+    size_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire))
+      return nullptr;
+    return &this->slots_[tail];
   }
+  /// Release the element returned by front() so its slot can be reused.
+  void pop() {
+    size_t tail = this->tail_.load(std::memory_order_relaxed);
+    this->tail_.store((tail + 1) % SIZE, std::memory_order_release);
+  }
+
+  /// Number of elements that didn't fit since the last call.
+  uint32_t take_dropped() { return this->dropped_.exchange(0, std::memory_order_relaxed); }
 
  protected:
-  std::queue<T *> q_;
-  SemaphoreHandle_t m_;
+  T slots_[SIZE];
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
 };
 
 // Received GAP and GATTC events are only queued, and get processed in the main loop().
 // This class stores each event in a single type.
 class BLEEvent {
  public:
-  BLEEvent(esp_gap_ble_cb_event_t e, esp_ble_gap_cb_param_t *p) {
+  void load(esp_gap_ble_cb_event_t e, esp_ble_gap_cb_param_t *p) {
     this->event_.gap.gap_event = e;
     memcpy(&this->event_.gap.gap_param, p, sizeof(esp_ble_gap_cb_param_t));
     this->type_ = 0;
-  };
+  }
 
-  BLEEvent(esp_gattc_cb_event_t e, esp_gatt_if_t i, esp_ble_gattc_cb_param_t *p) {
+  void load(esp_gattc_cb_event_t e, esp_gatt_if_t i, esp_ble_gattc_cb_param_t *p) {
     this->event_.gattc.gattc_event = e;
     this->event_.gattc.gattc_if = i;
     memcpy(&this->event_.gattc.gattc_param, p, sizeof(esp_ble_gattc_cb_param_t));
+    auto &param = this->event_.gattc.gattc_param;
     // Need to also make a copy of relevant event data.
     switch (e) {
       case ESP_GATTC_NOTIFY_EVT:
-        memcpy(this->event_.gattc.data, p->notify.value, p->notify.value_len);
-        this->event_.gattc.gattc_param.notify.value = this->event_.gattc.data;
+        // The buffer of a slot keeps its capacity, so this only allocates when a longer value than before comes in
+        this->data_.assign(p->notify.value, p->notify.value + p->notify.value_len);
+        param.notify.value = this->data_.data();
         break;
       case ESP_GATTC_READ_CHAR_EVT:
       case ESP_GATTC_READ_DESCR_EVT:
-        memcpy(this->event_.gattc.data, p->read.value, p->read.value_len);
-        this->event_.gattc.gattc_param.read.value = this->event_.gattc.data;
+        this->data_.assign(p->read.value, p->read.value + p->read.value_len);
+        param.read.value = this->data_.data();
         break;
       default:
         break;
     }
     this->type_ = 1;
-  };
+  }
 
   union {
     struct gap_event {  // NOLINT(readability-identifier-naming)
@@ -96,9 +106,10 @@ class BLEEvent {
       esp_gattc_cb_event_t gattc_event;
       esp_gatt_if_t gattc_if;
       esp_ble_gattc_cb_param_t gattc_param;
-      uint8_t data[64];
     } gattc;
   } event_;
+  /// Copy of the notified or read value (up to the MTU), which the stack frees after the callback.
+  std::vector<uint8_t> data_;
   uint8_t type_;  // 0=gap 1=gattc
 };
 
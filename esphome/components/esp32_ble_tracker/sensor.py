@@ -0,0 +1,70 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_BLUETOOTH,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_PERCENT,
+)
+from . import CONF_ESP32_BLE_ID, ESP32BLETracker, esp32_ble_tracker_ns
+
+DEPENDENCIES = ["esp32_ble_tracker"]
+
+CONF_SEEN = "seen"
+CONF_DROPPED = "dropped"
+CONF_DISPATCHED = "dispatched"
+CONF_RADIO_TIME = "radio_time"
+UNIT_ADVERTISEMENTS_PER_SECOND = "adv/s"
+
+ESP32BLETrackerStatsSensor = esp32_ble_tracker_ns.class_(
+    "ESP32BLETrackerStatsSensor", cg.PollingComponent
+)
+
+RATE_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_ADVERTISEMENTS_PER_SECOND,
+    icon=ICON_BLUETOOTH,
+    accuracy_decimals=1,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(ESP32BLETrackerStatsSensor),
+            cv.GenerateID(CONF_ESP32_BLE_ID): cv.use_id(ESP32BLETracker),
+            cv.Optional(CONF_SEEN): RATE_SCHEMA,
+            cv.Optional(CONF_DROPPED): RATE_SCHEMA,
+            cv.Optional(CONF_DISPATCHED): RATE_SCHEMA,
+            cv.Optional(CONF_RADIO_TIME): sensor.sensor_schema(
+                unit_of_measurement=UNIT_PERCENT,
+                icon=ICON_BLUETOOTH,
+                accuracy_decimals=1,
+                state_class=STATE_CLASS_MEASUREMENT,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
+        }
+    ).extend(cv.polling_component_schema("60s")),
+    cv.has_at_least_one_key(
+        CONF_SEEN, CONF_DROPPED, CONF_DISPATCHED, CONF_RADIO_TIME
+    ),
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    paren = await cg.get_variable(config[CONF_ESP32_BLE_ID])
+    cg.add(var.set_parent(paren))
+
+    for key, setter in (
+        (CONF_SEEN, var.set_seen_sensor),
+        (CONF_DROPPED, var.set_dropped_sensor),
+        (CONF_DISPATCHED, var.set_dispatched_sensor),
+        (CONF_RADIO_TIME, var.set_radio_time_sensor),
+    ):
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(setter(sens))
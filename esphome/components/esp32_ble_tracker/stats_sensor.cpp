@@ -0,0 +1,61 @@
+#include "stats_sensor.h"
+
+#if defined(USE_ESP32) && defined(USE_SENSOR)
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+static const char *const TAG = "esp32_ble_tracker.stats";
+
+void ESP32BLETrackerStatsSensor::setup() {
+  this->last_seen_ = this->parent_->get_adverts_seen();
+  this->last_dropped_ = this->parent_->get_adverts_dropped();
+  this->last_dispatched_ = this->parent_->get_adverts_dispatched();
+  this->last_radio_time_ = this->parent_->get_radio_time();
+  this->last_update_ = millis();
+}
+
+void ESP32BLETrackerStatsSensor::update() {
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - this->last_update_;
+  if (elapsed == 0)
+    return;
+  const float seconds = elapsed / 1000.0f;
+
+  const uint32_t seen = this->parent_->get_adverts_seen();
+  const uint32_t dropped = this->parent_->get_adverts_dropped();
+  const uint32_t dispatched = this->parent_->get_adverts_dispatched();
+  const uint32_t radio_time = this->parent_->get_radio_time();
+  // Unsigned differences stay correct when the counters wrap around
+  if (this->seen_sensor_ != nullptr)
+    this->seen_sensor_->publish_state((seen - this->last_seen_) / seconds);
+  if (this->dropped_sensor_ != nullptr)
+    this->dropped_sensor_->publish_state((dropped - this->last_dropped_) / seconds);
+  if (this->dispatched_sensor_ != nullptr)
+    this->dispatched_sensor_->publish_state((dispatched - this->last_dispatched_) / seconds);
+  if (this->radio_time_sensor_ != nullptr)
+    this->radio_time_sensor_->publish_state((radio_time - this->last_radio_time_) * 100.0f / elapsed);
+
+  this->last_seen_ = seen;
+  this->last_dropped_ = dropped;
+  this->last_dispatched_ = dispatched;
+  this->last_radio_time_ = radio_time;
+  this->last_update_ = now;
+}
+
+void ESP32BLETrackerStatsSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "BLE Tracker Statistics:");
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Seen", this->seen_sensor_);
+  LOG_SENSOR("  ", "Dropped", this->dropped_sensor_);
+  LOG_SENSOR("  ", "Dispatched", this->dispatched_sensor_);
+  LOG_SENSOR("  ", "Radio Time", this->radio_time_sensor_);
+}
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
+
+#endif
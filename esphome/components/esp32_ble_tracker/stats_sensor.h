@@ -0,0 +1,46 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#if defined(USE_ESP32) && defined(USE_SENSOR)
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esp32_ble_tracker.h"
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+/** Periodically publishes how many advertisements per second the tracker received, dropped and dispatched, and
+ * which share of the radio time the scanner took (the rest is left to Wi-Fi).
+ */
+class ESP32BLETrackerStatsSensor : public PollingComponent {
+ public:
+  void set_parent(ESP32BLETracker *parent) { this->parent_ = parent; }
+  void set_seen_sensor(sensor::Sensor *seen_sensor) { this->seen_sensor_ = seen_sensor; }
+  void set_dropped_sensor(sensor::Sensor *dropped_sensor) { this->dropped_sensor_ = dropped_sensor; }
+  void set_dispatched_sensor(sensor::Sensor *dispatched_sensor) { this->dispatched_sensor_ = dispatched_sensor; }
+  void set_radio_time_sensor(sensor::Sensor *radio_time_sensor) { this->radio_time_sensor_ = radio_time_sensor; }
+
+  void setup() override;
+  void update() override;
+  void dump_config() override;
+
+ protected:
+  ESP32BLETracker *parent_;
+  sensor::Sensor *seen_sensor_{nullptr};
+  sensor::Sensor *dropped_sensor_{nullptr};
+  sensor::Sensor *dispatched_sensor_{nullptr};
+  sensor::Sensor *radio_time_sensor_{nullptr};
+  /// Counter values and time of the previous update.
+  uint32_t last_seen_{0};
+  uint32_t last_dropped_{0};
+  uint32_t last_dispatched_{0};
+  uint32_t last_radio_time_{0};
+  uint32_t last_update_{0};
+};
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
+
+#endif
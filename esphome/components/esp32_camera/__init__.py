@@ -64,6 +64,8 @@ CONF_AE_LEVEL = "ae_level"
 CONF_AEC_VALUE = "aec_value"
 CONF_SATURATION = "saturation"
 CONF_TEST_PATTERN = "test_pattern"
+CONF_FRAME_BUFFER_COUNT = "frame_buffer_count"
+CONF_ADAPTIVE_JPEG_QUALITY = "adaptive_jpeg_quality"
 
 camera_range_param = cv.int_range(min=-2, max=2)
 
@@ -111,9 +113,24 @@ CONFIG_SCHEMA = cv.ENTITY_BASE_SCHEMA.extend(
         cv.Optional(CONF_AE_LEVEL, default=0): camera_range_param,
         cv.Optional(CONF_AEC_VALUE, default=300): cv.int_range(min=0, max=1200),
         cv.Optional(CONF_TEST_PATTERN, default=False): cv.boolean,
+        # More frame buffers (in PSRAM) let clients keep sending older images
+        cv.Optional(CONF_FRAME_BUFFER_COUNT, default=1): cv.int_range(min=1, max=3),
+        # The lowest quality the stream may fall back to when images are sent too slowly
+        cv.Optional(CONF_ADAPTIVE_JPEG_QUALITY): cv.int_range(min=10, max=63),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
+
+def validate_adaptive_jpeg_quality(config):
+    if config.get(CONF_ADAPTIVE_JPEG_QUALITY, 63) < config[CONF_JPEG_QUALITY]:
+        raise cv.Invalid(
+            f"{CONF_ADAPTIVE_JPEG_QUALITY} can't be better than {CONF_JPEG_QUALITY}"
+        )
+    return config
+
+
+CONFIG_SCHEMA = cv.All(CONFIG_SCHEMA, validate_adaptive_jpeg_quality)
+
 SETTERS = {
     CONF_DATA_PINS: "set_data_pins",
     CONF_VSYNC_PIN: "set_vsync_pin",
@@ -131,6 +148,8 @@ SETTERS = {
     CONF_BRIGHTNESS: "set_brightness",
     CONF_SATURATION: "set_saturation",
     CONF_TEST_PATTERN: "set_test_pattern",
+    CONF_FRAME_BUFFER_COUNT: "set_frame_buffer_count",
+    CONF_ADAPTIVE_JPEG_QUALITY: "set_adaptive_jpeg_quality",
 }
 
 
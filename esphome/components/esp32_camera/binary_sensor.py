@@ -0,0 +1,38 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import binary_sensor
+from esphome.const import (
+    CONF_DEVICE_CLASS,
+    CONF_ID,
+    CONF_THRESHOLD,
+    DEVICE_CLASS_MOTION,
+)
+from . import esp32_camera_ns
+
+DEPENDENCIES = ["esp32_camera"]
+
+CONF_BLOCK_THRESHOLD = "block_threshold"
+
+ESP32CameraMotionBinarySensor = esp32_camera_ns.class_(
+    "ESP32CameraMotionBinarySensor", binary_sensor.BinarySensor, cg.PollingComponent
+)
+
+CONFIG_SCHEMA = binary_sensor.BINARY_SENSOR_SCHEMA.extend(
+    {
+        cv.GenerateID(): cv.declare_id(ESP32CameraMotionBinarySensor),
+        cv.Optional(
+            CONF_DEVICE_CLASS, default=DEVICE_CLASS_MOTION
+        ): binary_sensor.device_class,
+        cv.Optional(CONF_BLOCK_THRESHOLD, default=24): cv.int_range(min=1, max=255),
+        cv.Optional(CONF_THRESHOLD, default="2%"): cv.percentage,
+    }
+).extend(cv.polling_component_schema("1s"))
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await binary_sensor.register_binary_sensor(var, config)
+
+    cg.add(var.set_block_threshold(config[CONF_BLOCK_THRESHOLD]))
+    cg.add(var.set_threshold(config[CONF_THRESHOLD]))
@@ -11,10 +11,15 @@ namespace esp32_camera {
 
 static const char *const TAG = "esp32_camera";
 
+static const uint32_t STATS_INTERVAL = 60000;
+// Let a quality change show in the send times before changing it again
+static const uint32_t QUALITY_CHANGE_INTERVAL = 1000;
+
 void ESP32Camera::setup() {
   global_esp32_camera = this;
 
   this->last_update_ = millis();
+  this->last_image_ = this->last_update_;
   esp_err_t err = esp_camera_init(&this->config_);
   if (err != ESP_OK) {
     ESP_LOGE(TAG, "esp_camera_init failed: %s", esp_err_to_name(err));
@@ -33,8 +38,10 @@ void ESP32Camera::setup() {
   s->set_brightness(s, this->brightness_);
   s->set_saturation(s, this->saturation_);
   s->set_colorbar(s, this->test_pattern_);
-  this->framebuffer_get_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
-  this->framebuffer_return_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
+  this->current_jpeg_quality_ = this->config_.jpeg_quality;
+  // Every frame buffer can be waiting in either queue
+  this->framebuffer_get_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
+  this->framebuffer_return_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
   xTaskCreatePinnedToCore(&ESP32Camera::framebuffer_task,
                           "framebuffer_task",  // name
                           1024,                // stack size
@@ -57,6 +64,9 @@ void ESP32Camera::dump_config() {
   ESP_LOGCONFIG(TAG, "  External Clock: Pin:%d Frequency:%u", conf.pin_xclk, conf.xclk_freq_hz);
   ESP_LOGCONFIG(TAG, "  I2C Pins: SDA:%d SCL:%d", conf.pin_sscb_sda, conf.pin_sscb_scl);
   ESP_LOGCONFIG(TAG, "  Reset Pin: %d", conf.pin_reset);
+  ESP_LOGCONFIG(TAG, "  Frame Buffers: %u", conf.fb_count);
+  if (this->adaptive_jpeg_quality_ != 0)
+    ESP_LOGCONFIG(TAG, "  Adaptive JPEG Quality: %u-%u", conf.jpeg_quality, this->adaptive_jpeg_quality_);
   switch (this->config_.frame_size) {
     case FRAMESIZE_QQVGA:
       ESP_LOGCONFIG(TAG, "  Resolution: 160x120 (QQVGA)");
@@ -125,52 +135,143 @@ void ESP32Camera::dump_config() {
   ESP_LOGCONFIG(TAG, "  Test Pattern: %s", YESNO(st.colorbar));
 }
 void ESP32Camera::loop() {
-  // check if we can return the image
-  if (this->can_return_image_()) {
-    // return image
-    auto *fb = this->current_image_->get_raw_buffer();
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    this->current_image_.reset();
-  }
+  this->return_images_();
+  this->publish_stats_();
 
   // Check if we should fetch a new image
-  if (!this->has_requested_image_())
-    return;
-  if (this->current_image_.use_count() > 1) {
-    // image is still in use
+  const bool image_requested = this->has_requested_image_();
+  if (!image_requested && !this->frame_requester_)
     return;
+  if (this->current_image_) {
+    // With more than one frame buffer, consumers keep sending the previous image while the next one is taken
+    if (this->previous_images_.size() + 2 > this->config_.fb_count)
+      // image is still in use
+      return;
   }
   const uint32_t now = millis();
   if (now - this->last_update_ <= this->max_update_interval_)
     return;
 
-  // request new image
+  // request new image, the newest one if several were captured since
   camera_fb_t *fb;
   if (xQueueReceive(this->framebuffer_get_queue_, &fb, 0L) != pdTRUE) {
     // no frame ready
     ESP_LOGVV(TAG, "No frame ready");
     return;
   }
+  camera_fb_t *newer;
+  while (xQueueReceive(this->framebuffer_get_queue_, &newer, 0L) == pdTRUE) {
+    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+    this->dropped_frames_++;
+    fb = newer;
+  }
 
   if (fb == nullptr) {
     ESP_LOGW(TAG, "Got invalid frame from camera!");
     xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
     return;
   }
-  this->current_image_ = std::make_shared<CameraImage>(fb);
+  auto image = std::make_shared<CameraImage>(fb);
+  this->new_frame_callback_.call(image);
+  this->frame_requester_ = false;
+  this->last_update_ = now;
+  if (!image_requested) {
+    // frame callbacks are done with the image when they return
+    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+    return;
+  }
+
+  if (this->current_image_)
+    this->previous_images_.push_back(std::move(this->current_image_));
+  this->current_image_ = std::move(image);
 
   ESP_LOGD(TAG, "Got Image: len=%u", fb->len);
   this->new_image_callback_.call(this->current_image_);
-  this->last_update_ = now;
+  this->delivered_frames_++;
+  this->last_image_ = now;
   this->single_requester_ = false;
 }
+void ESP32Camera::return_images_() {
+  // check if we can return the images
+  for (auto it = this->previous_images_.begin(); it != this->previous_images_.end();) {
+    if (it->use_count() == 1) {
+      this->return_image_(*it);
+      it = this->previous_images_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (this->can_return_image_()) {
+    // return image
+    this->return_image_(this->current_image_);
+    this->current_image_.reset();
+  }
+}
+void ESP32Camera::return_image_(const std::shared_ptr<CameraImage> &image) {
+  auto *fb = image->get_raw_buffer();
+  xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+  if (this->adaptive_jpeg_quality_ != 0)
+    this->update_jpeg_quality_(millis() - image->get_timestamp());
+}
+void ESP32Camera::update_jpeg_quality_(uint32_t send_time) {
+  this->send_time_ = this->send_time_ * 0.75f + send_time * 0.25f;
+  const uint32_t now = millis();
+  if (now - this->last_quality_change_ < QUALITY_CHANGE_INTERVAL)
+    return;
+
+  // Higher values are lower quality. Back off quickly when the images can't keep up with the frame rate, and
+  // slowly go back when they are sent in well under that.
+  uint8_t quality = this->current_jpeg_quality_;
+  const float frame_time = this->max_update_interval_;
+  if (this->send_time_ > frame_time) {
+    quality = std::min<uint8_t>(quality + 4, this->adaptive_jpeg_quality_);
+  } else if (this->send_time_ < frame_time / 2 && quality > this->config_.jpeg_quality) {
+    quality--;
+  }
+  if (quality == this->current_jpeg_quality_)
+    return;
+
+  ESP_LOGD(TAG, "Images take %.0fms to send, changing JPEG quality to %u", this->send_time_, quality);
+  sensor_t *s = esp_camera_sensor_get();
+  s->set_quality(s, quality);
+  this->current_jpeg_quality_ = quality;
+  this->last_quality_change_ = now;
+}
+void ESP32Camera::publish_stats_() {
+  const uint32_t now = millis();
+  if (now - this->last_stats_ < STATS_INTERVAL)
+    return;
+  const float seconds = (now - this->last_stats_) / 1000.0f;
+  this->last_stats_ = now;
+  const uint32_t captured = this->captured_frames_.exchange(0);
+  if (captured == 0 && this->delivered_frames_ == 0)
+    return;
+  ESP_LOGD(TAG, "Captured %.1f fps, sent %.1f fps, dropped %u frames, %u images still being sent", captured / seconds,
+           this->delivered_frames_ / seconds, this->dropped_frames_, (unsigned) this->previous_images_.size());
+  this->delivered_frames_ = 0;
+  this->dropped_frames_ = 0;
+}
 void ESP32Camera::framebuffer_task(void *pv) {
+  ESP32Camera *camera = global_esp32_camera;
+  uint8_t held = 0;
   while (true) {
-    camera_fb_t *framebuffer = esp_camera_fb_get();
-    xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
+    camera_fb_t *framebuffer;
+    if (held == camera->config_.fb_count) {
+      // all frame buffers are waiting to be sent, wait until one is done
+      xQueueReceive(camera->framebuffer_return_queue_, &framebuffer, portMAX_DELAY);
+      esp_camera_fb_return(framebuffer);
+      held--;
+    }
     // return is no-op for config with 1 fb
-    xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, portMAX_DELAY);
-    esp_camera_fb_return(framebuffer);
+    while (xQueueReceive(camera->framebuffer_return_queue_, &framebuffer, 0L) == pdTRUE) {
+      esp_camera_fb_return(framebuffer);
+      held--;
+    }
+
+    framebuffer = esp_camera_fb_get();
+    xQueueSend(camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
+    held++;
+    camera->captured_frames_++;
   }
 }
 ESP32Camera::ESP32Camera(const std::string &name) : EntityBase(name) {
@@ -248,6 +349,9 @@ void ESP32Camera::set_power_down_pin(uint8_t pin) { this->config_.pin_pwdn = pin
 void ESP32Camera::add_image_callback(std::function<void(std::shared_ptr<CameraImage>)> &&f) {
   this->new_image_callback_.add(std::move(f));
 }
+void ESP32Camera::add_frame_callback(std::function<void(const std::shared_ptr<CameraImage> &)> &&f) {
+  this->new_frame_callback_.add(std::move(f));
+}
 void ESP32Camera::set_vertical_flip(bool vertical_flip) { this->vertical_flip_ = vertical_flip; }
 void ESP32Camera::set_horizontal_mirror(bool horizontal_mirror) { this->horizontal_mirror_ = horizontal_mirror; }
 void ESP32Camera::set_aec2(bool aec2) { this->aec2_ = aec2; }
@@ -259,6 +363,7 @@ void ESP32Camera::set_saturation(int saturation) { this->saturation_ = saturatio
 float ESP32Camera::get_setup_priority() const { return setup_priority::DATA; }
 uint32_t ESP32Camera::hash_base() { return 3010542557UL; }
 void ESP32Camera::request_image() { this->single_requester_ = true; }
+void ESP32Camera::request_frame() { this->frame_requester_ = true; }
 void ESP32Camera::request_stream() { this->last_stream_request_ = millis(); }
 bool ESP32Camera::has_requested_image_() const {
   if (this->single_requester_)
@@ -270,7 +375,7 @@ bool ESP32Camera::has_requested_image_() const {
     // stream request
     return true;
 
-  if (this->idle_update_interval_ != 0 && now - this->last_update_ > this->idle_update_interval_)
+  if (this->idle_update_interval_ != 0 && now - this->last_image_ > this->idle_update_interval_)
     // idle update
     return true;
 
@@ -284,6 +389,7 @@ void ESP32Camera::set_idle_update_interval(uint32_t idle_update_interval) {
   this->idle_update_interval_ = idle_update_interval;
 }
 void ESP32Camera::set_test_pattern(bool test_pattern) { this->test_pattern_ = test_pattern; }
+void ESP32Camera::set_frame_buffer_count(uint8_t count) { this->config_.fb_count = count; }
 
 ESP32Camera *global_esp32_camera;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
@@ -304,7 +410,7 @@ uint8_t *CameraImageReader::peek_data_buffer() { return this->image_->get_data_b
 camera_fb_t *CameraImage::get_raw_buffer() { return this->buffer_; }
 uint8_t *CameraImage::get_data_buffer() { return this->buffer_->buf; }
 size_t CameraImage::get_data_length() { return this->buffer_->len; }
-CameraImage::CameraImage(camera_fb_t *buffer) : buffer_(buffer) {}
+CameraImage::CameraImage(camera_fb_t *buffer) : buffer_(buffer), timestamp_(millis()) {}
 
 }  // namespace esp32_camera
 }  // namespace esphome
@@ -5,6 +5,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/entity_base.h"
 #include "esphome/core/helpers.h"
+#include <atomic>
 #include <esp_camera.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
@@ -20,9 +21,12 @@ class CameraImage {
   camera_fb_t *get_raw_buffer();
   uint8_t *get_data_buffer();
   size_t get_data_length();
+  /// When the image was taken from the camera, in ms.
+  uint32_t get_timestamp() const { return this->timestamp_; }
 
  protected:
   camera_fb_t *buffer_;
+  uint32_t timestamp_;
 };
 
 class CameraImageReader {
@@ -76,18 +80,35 @@ class ESP32Camera : public Component, public EntityBase {
   void set_max_update_interval(uint32_t max_update_interval);
   void set_idle_update_interval(uint32_t idle_update_interval);
   void set_test_pattern(bool test_pattern);
+  void set_frame_buffer_count(uint8_t count);
+  /// Lower the JPEG quality down to this value when images take longer to send than the frame rate allows.
+  void set_adaptive_jpeg_quality(uint8_t quality) { this->adaptive_jpeg_quality_ = quality; }
   void setup() override;
   void loop() override;
   void dump_config() override;
   void add_image_callback(std::function<void(std::shared_ptr<CameraImage>)> &&f);
+  /** Add a callback for frames that are analyzed on the device, see request_frame().
+   *
+   * These get every image, images that were only requested with request_frame() aren't passed to the image callbacks
+   * (so not sent to clients).
+   */
+  void add_frame_callback(std::function<void(const std::shared_ptr<CameraImage> &)> &&f);
   float get_setup_priority() const override;
   void request_stream();
   void request_image();
+  /// Request an image for the frame callbacks only.
+  void request_frame();
 
  protected:
   uint32_t hash_base() override;
   bool has_requested_image_() const;
   bool can_return_image_() const;
+  /// Give frame buffers the consumers are done with back to the framebuffer task.
+  void return_images_();
+  void publish_stats_();
+  void return_image_(const std::shared_ptr<CameraImage> &image);
+  /// Adapt the JPEG quality to how long the last image took to send.
+  void update_jpeg_quality_(uint32_t send_time);
 
   static void framebuffer_task(void *pv);
 
@@ -104,14 +125,35 @@ class ESP32Camera : public Component, public EntityBase {
 
   esp_err_t init_error_{ESP_OK};
   std::shared_ptr<CameraImage> current_image_;
+  /// Older images that are still being sent while there's a newer current_image_.
+  std::vector<std::shared_ptr<CameraImage>> previous_images_;
   uint32_t last_stream_request_{0};
   bool single_requester_{false};
+  bool frame_requester_{false};
   QueueHandle_t framebuffer_get_queue_;
   QueueHandle_t framebuffer_return_queue_;
   CallbackManager<void(std::shared_ptr<CameraImage>)> new_image_callback_;
+  CallbackManager<void(const std::shared_ptr<CameraImage> &)> new_frame_callback_;
   uint32_t max_update_interval_{1000};
   uint32_t idle_update_interval_{15000};
   uint32_t last_update_{0};
+  /// When the last image was passed to the image callbacks, for the idle updates.
+  uint32_t last_image_{0};
+
+  uint8_t adaptive_jpeg_quality_{0};
+  /// The JPEG quality the camera currently uses, between config_.jpeg_quality and adaptive_jpeg_quality_.
+  uint8_t current_jpeg_quality_{0};
+  /// Moving average of the time images take to send, in ms.
+  float send_time_{0};
+  uint32_t last_quality_change_{0};
+
+  // Frame statistics, logged once a minute
+  /// Counted up by the framebuffer task, read and reset by loop().
+  std::atomic<uint32_t> captured_frames_{0};
+  uint32_t delivered_frames_{0};
+  /// Frames that were replaced by a newer one before anybody requested them.
+  uint32_t dropped_frames_{0};
+  uint32_t last_stats_{0};
 };
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
@@ -0,0 +1,107 @@
+#include "motion_binary_sensor.h"
+
+#ifdef USE_ESP32
+#ifdef USE_BINARY_SENSOR
+
+#include "esphome/core/log.h"
+
+#include <esp_jpg_decode.h>
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace esp32_camera {
+
+static const char *const TAG = "esp32_camera.motion";
+
+// The background follows the frames by 1/2^BACKGROUND_SHIFT, so light changes slowly aren't motion
+static const uint8_t BACKGROUND_SHIFT = 3;
+
+void ESP32CameraMotionBinarySensor::setup() {
+  global_esp32_camera->add_frame_callback(
+      [this](const std::shared_ptr<CameraImage> &image) { this->process_frame_(image); });
+}
+
+void ESP32CameraMotionBinarySensor::update() { global_esp32_camera->request_frame(); }
+
+void ESP32CameraMotionBinarySensor::dump_config() {
+  LOG_BINARY_SENSOR("", "ESP32 Camera Motion", this);
+  ESP_LOGCONFIG(TAG, "  Block Threshold: %u", this->block_threshold_);
+  ESP_LOGCONFIG(TAG, "  Threshold: %.1f%%", this->threshold_ * 100.0f);
+  LOG_UPDATE_INTERVAL(this);
+}
+
+void ESP32CameraMotionBinarySensor::process_frame_(const std::shared_ptr<CameraImage> &image) {
+  this->decoding_ = image.get();
+  esp_err_t err = esp_jpg_decode(image->get_data_length(), JPG_SCALE_8X, ESP32CameraMotionBinarySensor::jpeg_read,
+                                 ESP32CameraMotionBinarySensor::jpeg_write, this);
+  this->decoding_ = nullptr;
+  if (err != ESP_OK || !this->blocks_) {
+    ESP_LOGW(TAG, "Decoding the image failed: %s", esp_err_to_name(err));
+    return;
+  }
+
+  const size_t count = size_t(this->width_) * this->height_;
+  uint8_t *blocks = this->blocks_.get();
+  uint8_t *background = this->background_.get();
+  if (!this->has_background_) {
+    memcpy(background, blocks, count);
+    this->has_background_ = true;
+    return;
+  }
+
+  size_t changed = 0;
+  for (size_t i = 0; i < count; i++) {
+    const int diff = int(blocks[i]) - int(background[i]);
+    if (diff > this->block_threshold_ || -diff > this->block_threshold_)
+      changed++;
+    background[i] = uint8_t(background[i] + (diff >> BACKGROUND_SHIFT));
+  }
+
+  ESP_LOGV(TAG, "%u of %u blocks changed", (unsigned) changed, (unsigned) count);
+  this->publish_state(changed > count * this->threshold_);
+}
+
+size_t ESP32CameraMotionBinarySensor::jpeg_read(void *arg, size_t index, uint8_t *buf, size_t len) {
+  auto *sensor = reinterpret_cast<ESP32CameraMotionBinarySensor *>(arg);
+  const size_t length = sensor->decoding_->get_data_length();
+  if (index >= length)
+    return 0;
+  len = std::min(len, length - index);
+  // the decoder skips data with buf == nullptr
+  if (buf != nullptr)
+    memcpy(buf, sensor->decoding_->get_data_buffer() + index, len);
+  return len;
+}
+
+bool ESP32CameraMotionBinarySensor::jpeg_write(void *arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                                               uint8_t *data) {
+  auto *sensor = reinterpret_cast<ESP32CameraMotionBinarySensor *>(arg);
+  if (data == nullptr) {
+    // start (at 0, 0 with the scaled image size) and end of the image
+    if (x == 0 && y == 0 && (w != sensor->width_ || h != sensor->height_)) {
+      sensor->width_ = w;
+      sensor->height_ = h;
+      sensor->blocks_.reset(new uint8_t[size_t(w) * h]);  // NOLINT(cppcoreguidelines-owning-memory)
+      sensor->background_.reset(new uint8_t[size_t(w) * h]);  // NOLINT(cppcoreguidelines-owning-memory)
+      sensor->has_background_ = false;
+    }
+    return true;
+  }
+
+  // data is RGB888 for the w x h rectangle at x, y, keep only its brightness
+  if (x + w > sensor->width_ || y + h > sensor->height_)
+    return false;
+  for (uint16_t row = 0; row < h; row++) {
+    uint8_t *out = sensor->blocks_.get() + size_t(y + row) * sensor->width_ + x;
+    for (uint16_t col = 0; col < w; col++, data += 3)
+      out[col] = uint8_t((data[0] * 77 + data[1] * 150 + data[2] * 29) >> 8);
+  }
+  return true;
+}
+
+}  // namespace esp32_camera
+}  // namespace esphome
+
+#endif  // USE_BINARY_SENSOR
+#endif  // USE_ESP32
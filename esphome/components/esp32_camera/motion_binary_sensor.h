@@ -0,0 +1,57 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_BINARY_SENSOR
+
+#include "esphome/core/component.h"
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esp32_camera.h"
+
+#include <memory>
+
+namespace esphome {
+namespace esp32_camera {
+
+/** Detect motion in the camera images, without sending them anywhere.
+ *
+ * The JPEG images are decoded at 1/8 scale, which only needs the DC coefficient of each 8x8 block. The brightness of
+ * those blocks is compared to a slowly adapting background, motion is when enough blocks differ from it.
+ */
+class ESP32CameraMotionBinarySensor : public binary_sensor::BinarySensor, public PollingComponent {
+ public:
+  void setup() override;
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  /// How much, out of 255, a block needs to differ from the background to be changed.
+  void set_block_threshold(uint8_t block_threshold) { this->block_threshold_ = block_threshold; }
+  /// The part of the blocks that need to change for motion.
+  void set_threshold(float threshold) { this->threshold_ = threshold; }
+
+ protected:
+  void process_frame_(const std::shared_ptr<CameraImage> &image);
+  static size_t jpeg_read(void *arg, size_t index, uint8_t *buf, size_t len);
+  static bool jpeg_write(void *arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t *data);
+
+  uint8_t block_threshold_{24};
+  float threshold_{0.02f};
+
+  /// The brightness of the blocks in the current frame, and their background.
+  std::unique_ptr<uint8_t[]> blocks_;
+  std::unique_ptr<uint8_t[]> background_;
+  uint16_t width_{0};
+  uint16_t height_{0};
+  bool has_background_{false};
+  const CameraImage *decoding_{nullptr};
+};
+
+}  // namespace esp32_camera
+}  // namespace esphome
+
+#endif  // USE_BINARY_SENSOR
+
+#endif  // USE_ESP32
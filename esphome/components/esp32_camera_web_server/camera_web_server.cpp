@@ -7,14 +7,20 @@
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <cstdlib>
 #include <esp_http_server.h>
+#include <sys/socket.h>
+#include <unistd.h>
 #include <utility>
 
 namespace esphome {
 namespace esp32_camera_web_server {
 
 static const int IMAGE_REQUEST_TIMEOUT = 2000;
+// Every stream client keeps its socket open, the least recently used one is closed for new ones
+static const int STREAM_MAX_CLIENTS = 4;
 static const char *const TAG = "esp32_camera_web_server";
 
 #define PART_BOUNDARY "123456789000000000000987654321"
@@ -27,13 +33,10 @@ static const char *const STREAM_HEADER = "HTTP/1.0 200 OK\r\n"
                                          "Content-Type: multipart/x-mixed-replace;boundary=" PART_BOUNDARY "\r\n"
                                          "\r\n"
                                          "--" PART_BOUNDARY "\r\n";
-static const char *const STREAM_ERROR = "Content-Type: text/plain\r\n"
-                                        "\r\n"
-                                        "No frames send.\r\n"
-                                        "--" PART_BOUNDARY "\r\n";
 static const char *const STREAM_PART = "Content-Type: " CONTENT_TYPE "\r\n" CONTENT_LENGTH ": %u\r\n\r\n";
-static const char *const STREAM_BOUNDARY = "\r\n"
-                                           "--" PART_BOUNDARY "\r\n";
+static const char STREAM_BOUNDARY[] = "\r\n"
+                                     "--" PART_BOUNDARY "\r\n";
+static const size_t STREAM_BOUNDARY_LENGTH = sizeof(STREAM_BOUNDARY) - 1;
 
 CameraWebServer::CameraWebServer() {}
 
@@ -50,9 +53,10 @@ void CameraWebServer::setup() {
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
   config.server_port = this->port_;
   config.ctrl_port = this->port_;
-  config.max_open_sockets = 1;
+  config.max_open_sockets = this->mode_ == STREAM ? STREAM_MAX_CLIENTS : 1;
   config.backlog_conn = 2;
   config.lru_purge_enable = true;
+  config.close_fn = CameraWebServer::close_socket;
 
   if (httpd_start(&this->httpd_, &config) != ESP_OK) {
     mark_failed();
@@ -68,7 +72,9 @@ void CameraWebServer::setup() {
   httpd_register_uri_handler(this->httpd_, &uri);
 
   esp32_camera::global_esp32_camera->add_image_callback([this](std::shared_ptr<esp32_camera::CameraImage> image) {
-    if (this->running_) {
+    if (this->mode_ == STREAM) {
+      this->on_stream_image_(std::move(image));
+    } else if (this->running_) {
       this->image_ = std::move(image);
       xSemaphoreGive(this->semaphore_);
     }
@@ -103,6 +109,103 @@ void CameraWebServer::loop() {
   if (!this->running_) {
     this->image_ = nullptr;
   }
+
+  LockGuard guard(this->clients_lock_);
+  if (this->clients_.empty()) {
+    this->high_freq_.stop();
+    return;
+  }
+  // Send the images in small steps, as often as possible
+  this->high_freq_.start();
+  esp32_camera::global_esp32_camera->request_stream();
+
+  for (auto *client : this->clients_) {
+    if (client->closing || client->fd < 0)
+      continue;
+    if (!this->send_stream_(client)) {
+      ESP_LOGW(TAG, "STREAM: sending failed: errno %d", errno);
+      client->closing = true;
+      httpd_sess_trigger_close(this->httpd_, client->fd);
+    }
+  }
+}
+
+void CameraWebServer::on_stream_image_(std::shared_ptr<esphome::esp32_camera::CameraImage> image) {
+  LockGuard guard(this->clients_lock_);
+  if (this->clients_.empty())
+    return;
+
+  auto frame = std::make_shared<StreamFrame>();
+  frame->part_length = snprintf(frame->part, sizeof(frame->part), STREAM_PART, image->get_data_length());
+  frame->image = std::move(image);
+  for (auto *client : this->clients_) {
+    if (!client->frame) {
+      client->frame = frame;
+    } else {
+      if (client->next)
+        client->dropped++;
+      client->next = frame;
+    }
+  }
+}
+
+bool CameraWebServer::send_stream_(StreamClient *client) {
+  while (client->frame) {
+    const StreamFrame &frame = *client->frame;
+    const size_t image_length = frame.image->get_data_length();
+    const char *buf;
+    size_t len;
+    size_t offset = client->offset;
+    if (offset < frame.part_length) {
+      buf = frame.part + offset;
+      len = frame.part_length - offset;
+    } else if ((offset -= frame.part_length) < image_length) {
+      buf = (const char *) frame.image->get_data_buffer() + offset;
+      len = image_length - offset;
+    } else {
+      offset -= image_length;
+      buf = STREAM_BOUNDARY + offset;
+      len = STREAM_BOUNDARY_LENGTH - offset;
+    }
+
+    ssize_t sent = send(client->fd, buf, len, MSG_DONTWAIT);
+    if (sent < 0)
+      return errno == EWOULDBLOCK || errno == EAGAIN;
+
+    client->offset += sent;
+    if (client->offset == frame.part_length + image_length + STREAM_BOUNDARY_LENGTH) {
+      ESP_LOGV(TAG, "MJPG: %uB to socket %d", (uint32_t) image_length, client->fd);
+      client->frames++;
+      client->offset = 0;
+      client->frame = std::move(client->next);
+      client->next = nullptr;
+    }
+  }
+  return true;
+}
+
+void CameraWebServer::close_socket(void *hd, int sockfd) {
+  auto *client = reinterpret_cast<StreamClient *>(httpd_sess_get_ctx(hd, sockfd));
+  if (client != nullptr) {
+    // httpd frees the client only after closing its socket, loop() must not send to the fd in between as a new
+    // connection can get the same number
+    LockGuard guard(client->server->clients_lock_);
+    client->fd = -1;
+    client->closing = true;
+  }
+  close(sockfd);
+}
+
+void CameraWebServer::free_stream_client(void *ctx) {
+  auto *client = reinterpret_cast<StreamClient *>(ctx);
+  CameraWebServer *server = client->server;
+  {
+    LockGuard guard(server->clients_lock_);
+    auto &clients = server->clients_;
+    clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+  }
+  ESP_LOGI(TAG, "STREAM: closed. Frames: %u, dropped: %u", client->frames, client->dropped);
+  delete client;  // NOLINT(cppcoreguidelines-owning-memory)
 }
 
 std::shared_ptr<esphome::esp32_camera::CameraImage> CameraWebServer::wait_for_image_() {
@@ -119,20 +222,13 @@ std::shared_ptr<esphome::esp32_camera::CameraImage> CameraWebServer::wait_for_im
 }
 
 esp_err_t CameraWebServer::handler_(struct httpd_req *req) {
-  esp_err_t res = ESP_FAIL;
+  if (this->mode_ == STREAM)
+    return this->streaming_handler_(req);
 
   this->image_ = nullptr;
   this->running_ = true;
 
-  switch (this->mode_) {
-    case STREAM:
-      res = this->streaming_handler_(req);
-      break;
-
-    case SNAPSHOT:
-      res = this->snapshot_handler_(req);
-      break;
-  }
+  esp_err_t res = this->snapshot_handler_(req);
 
   this->running_ = false;
   this->image_ = nullptr;
@@ -154,59 +250,27 @@ static esp_err_t httpd_send_all(httpd_req_t *r, const char *buf, size_t buf_len)
 }
 
 esp_err_t CameraWebServer::streaming_handler_(struct httpd_req *req) {
-  esp_err_t res = ESP_OK;
-  char part_buf[64];
-
   // This manually constructs HTTP response to avoid chunked encoding
   // which is not supported by some clients
 
-  res = httpd_send_all(req, STREAM_HEADER, strlen(STREAM_HEADER));
+  esp_err_t res = httpd_send_all(req, STREAM_HEADER, strlen(STREAM_HEADER));
   if (res != ESP_OK) {
     ESP_LOGW(TAG, "STREAM: failed to set HTTP header");
     return res;
   }
 
-  uint32_t last_frame = millis();
-  uint32_t frames = 0;
-
-  while (res == ESP_OK && this->running_) {
-    if (esp32_camera::global_esp32_camera != nullptr) {
-      esp32_camera::global_esp32_camera->request_stream();
-    }
-
-    auto image = this->wait_for_image_();
-
-    if (!image) {
-      ESP_LOGW(TAG, "STREAM: failed to acquire frame");
-      res = ESP_FAIL;
-    }
-    if (res == ESP_OK) {
-      size_t hlen = snprintf(part_buf, 64, STREAM_PART, image->get_data_length());
-      res = httpd_send_all(req, part_buf, hlen);
-    }
-    if (res == ESP_OK) {
-      res = httpd_send_all(req, (const char *) image->get_data_buffer(), image->get_data_length());
-    }
-    if (res == ESP_OK) {
-      res = httpd_send_all(req, STREAM_BOUNDARY, strlen(STREAM_BOUNDARY));
-    }
-    if (res == ESP_OK) {
-      frames++;
-      int64_t frame_time = millis() - last_frame;
-      last_frame = millis();
-
-      ESP_LOGD(TAG, "MJPG: %uB %ums (%.1ffps)", (uint32_t) image->get_data_length(), (uint32_t) frame_time,
-               1000.0 / (uint32_t) frame_time);
-    }
-  }
-
-  if (!frames) {
-    res = httpd_send_all(req, STREAM_ERROR, strlen(STREAM_ERROR));
-  }
-
-  ESP_LOGI(TAG, "STREAM: closed. Frames: %u", frames);
-
-  return res;
+  // The session stays open after this returns, loop() sends every image to all stream clients. httpd frees the
+  // client when the session is closed.
+  auto *client = new StreamClient{};  // NOLINT(cppcoreguidelines-owning-memory)
+  client->server = this;
+  client->fd = httpd_req_to_sockfd(req);
+  req->sess_ctx = client;
+  req->free_ctx = CameraWebServer::free_stream_client;
+
+  LockGuard guard(this->clients_lock_);
+  this->clients_.push_back(client);
+  ESP_LOGI(TAG, "STREAM: opened, %u clients", (unsigned) this->clients_.size());
+  return ESP_OK;
 }
 
 esp_err_t CameraWebServer::snapshot_handler_(struct httpd_req *req) {
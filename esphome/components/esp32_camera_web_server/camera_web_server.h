@@ -10,6 +10,9 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/preferences.h"
 
+#include <memory>
+#include <vector>
+
 struct httpd_req;
 
 namespace esphome {
@@ -17,6 +20,30 @@ namespace esp32_camera_web_server {
 
 enum Mode { STREAM, SNAPSHOT };
 
+/// An image with its multipart header, shared by all stream clients.
+struct StreamFrame {
+  std::shared_ptr<esphome::esp32_camera::CameraImage> image;
+  char part[64];
+  size_t part_length;
+};
+
+class CameraWebServer;
+
+/// A stream connection, owned by its httpd session.
+struct StreamClient {
+  CameraWebServer *server;
+  /// The session's socket, -1 once httpd closed it.
+  int fd;
+  /// The frame being sent, and how much of it (header, image and boundary) was sent already.
+  std::shared_ptr<StreamFrame> frame;
+  size_t offset{0};
+  /// The newest frame that came in while sending, older ones are dropped.
+  std::shared_ptr<StreamFrame> next;
+  uint32_t frames{0};
+  uint32_t dropped{0};
+  bool closing{false};
+};
+
 class CameraWebServer : public Component {
  public:
   CameraWebServer();
@@ -35,6 +62,12 @@ class CameraWebServer : public Component {
   esp_err_t handler_(struct httpd_req *req);
   esp_err_t streaming_handler_(struct httpd_req *req);
   esp_err_t snapshot_handler_(struct httpd_req *req);
+  void on_stream_image_(std::shared_ptr<esphome::esp32_camera::CameraImage> image);
+  /// Send as much of the client's frames as fits in the socket without blocking, false on errors.
+  bool send_stream_(StreamClient *client);
+  /// httpd's close_fn, closes a session's socket.
+  static void close_socket(void *hd, int sockfd);
+  static void free_stream_client(void *ctx);
 
  protected:
   uint16_t port_{0};
@@ -43,6 +76,11 @@ class CameraWebServer : public Component {
   std::shared_ptr<esphome::esp32_camera::CameraImage> image_;
   bool running_{false};
   Mode mode_{STREAM};
+
+  /// Stream clients are added and removed by the httpd task, and sent to in loop().
+  Mutex clients_lock_;
+  std::vector<StreamClient *> clients_;
+  HighFrequencyLoopRequester high_freq_;
 };
 
 }  // namespace esp32_camera_web_server
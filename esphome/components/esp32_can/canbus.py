@@ -0,0 +1,102 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import pins
+from esphome.components import canbus
+from esphome.components.canbus import (
+    CanbusComponent,
+    CONF_BIT_RATE,
+    CONF_CAN_ID,
+    CONF_ON_FRAME,
+    CONF_USE_EXTENDED_ID,
+)
+from esphome.const import (
+    CONF_ID,
+    CONF_RX_PIN,
+    CONF_TX_PIN,
+    KEY_CORE,
+    KEY_FRAMEWORK_VERSION,
+)
+from esphome.core import CORE
+
+DEPENDENCIES = ["esp32"]
+
+CONF_RX_QUEUE_LEN = "rx_queue_len"
+CONF_TX_QUEUE_LEN = "tx_queue_len"
+
+esp32_can_ns = cg.esphome_ns.namespace("esp32_can")
+esp32_can = esp32_can_ns.class_("ESP32Can", CanbusComponent)
+
+# The bit rates the TWAI driver has timing presets for on all ESP32 variants
+BIT_RATES = ["50KBPS", "100KBPS", "125KBPS", "250KBPS", "500KBPS", "1000KBPS"]
+
+
+def validate_framework(config):
+    # The TWAI driver was added in ESP-IDF 4.2, arduino-esp32 uses that from 2.0.0
+    if CORE.using_arduino:
+        version = CORE.data[KEY_CORE][KEY_FRAMEWORK_VERSION]
+        if version < cv.Version(2, 0, 0):
+            raise cv.Invalid(
+                "esp32_can requires ESP-IDF or arduino-esp32 2.0.0 or higher"
+            )
+    return config
+
+
+def validate_bit_rate(value):
+    value = cv.string(value).upper()
+    if value not in BIT_RATES:
+        raise cv.Invalid(f"Bit rate must be one of {', '.join(BIT_RATES)}")
+    return value
+
+
+def acceptance_filter(frames):
+    """Derive the single TWAI acceptance filter from the on_frame triggers.
+
+    Returns (code, mask) in the register layout of the single filter mode, set mask
+    bits are ignored. With both standard and extended IDs all frames are accepted,
+    the triggers still select the frames they handle.
+    """
+    ids = sorted({can_id for can_id, _ in frames})
+    kinds = {extended for _, extended in frames}
+    if not ids or len(kinds) != 1:
+        return 0, 0xFFFFFFFF
+    extended = kinds.pop()
+    diff = 0
+    for can_id in ids:
+        diff |= can_id ^ ids[0]
+    if extended:
+        # ID in bits 31-3, RTR and two unused bits below it
+        return ids[0] << 3, (diff << 3) | 0x7
+    # ID in bits 31-21, then RTR and (for data frames) the first two data bytes
+    return ids[0] << 21, (diff << 21) | 0x1FFFFF
+
+
+CONFIG_SCHEMA = cv.All(
+    canbus.CANBUS_SCHEMA.extend(
+        {
+            cv.GenerateID(): cv.declare_id(esp32_can),
+            cv.Optional(CONF_BIT_RATE, default="125KBPS"): validate_bit_rate,
+            cv.Required(CONF_RX_PIN): pins.internal_gpio_input_pin_number,
+            cv.Required(CONF_TX_PIN): pins.internal_gpio_output_pin_number,
+            cv.Optional(CONF_RX_QUEUE_LEN, default=32): cv.int_range(min=1, max=256),
+            cv.Optional(CONF_TX_QUEUE_LEN, default=8): cv.int_range(min=1, max=64),
+        }
+    ),
+    validate_framework,
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await canbus.register_canbus(var, config)
+
+    cg.add(var.set_rx(config[CONF_RX_PIN]))
+    cg.add(var.set_tx(config[CONF_TX_PIN]))
+    cg.add(var.set_rx_queue_len(config[CONF_RX_QUEUE_LEN]))
+    cg.add(var.set_tx_queue_len(config[CONF_TX_QUEUE_LEN]))
+
+    frames = [
+        (conf[CONF_CAN_ID], conf[CONF_USE_EXTENDED_ID])
+        for conf in config.get(CONF_ON_FRAME, [])
+    ]
+    code, mask = acceptance_filter(frames)
+    cg.add(var.set_acceptance_filter(code, mask))
@@ -0,0 +1,133 @@
+#ifdef USE_ESP32
+
+#include "esp32_can.h"
+#include "esphome/core/log.h"
+
+#include <driver/twai.h>
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace esp32_can {
+
+static const char *const TAG = "esp32_can";
+
+static bool get_timing_config(twai_timing_config_t &config, canbus::CanSpeed speed) {
+  switch (speed) {
+    case canbus::CAN_50KBPS:
+      config = (twai_timing_config_t) TWAI_TIMING_CONFIG_50KBITS();
+      return true;
+    case canbus::CAN_100KBPS:
+      config = (twai_timing_config_t) TWAI_TIMING_CONFIG_100KBITS();
+      return true;
+    case canbus::CAN_125KBPS:
+      config = (twai_timing_config_t) TWAI_TIMING_CONFIG_125KBITS();
+      return true;
+    case canbus::CAN_250KBPS:
+      config = (twai_timing_config_t) TWAI_TIMING_CONFIG_250KBITS();
+      return true;
+    case canbus::CAN_500KBPS:
+      config = (twai_timing_config_t) TWAI_TIMING_CONFIG_500KBITS();
+      return true;
+    case canbus::CAN_1000KBPS:
+      config = (twai_timing_config_t) TWAI_TIMING_CONFIG_1MBITS();
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool ESP32Can::setup_internal() {
+  twai_general_config_t g_config =
+      TWAI_GENERAL_CONFIG_DEFAULT((gpio_num_t) this->tx_, (gpio_num_t) this->rx_, TWAI_MODE_NORMAL);
+  g_config.rx_queue_len = this->rx_queue_len_;
+  g_config.tx_queue_len = this->tx_queue_len_;
+  twai_filter_config_t f_config{};
+  f_config.acceptance_code = this->acceptance_code_;
+  f_config.acceptance_mask = this->acceptance_mask_;
+  f_config.single_filter = true;
+  twai_timing_config_t t_config;
+
+  if (!get_timing_config(t_config, this->bit_rate_)) {
+    ESP_LOGE(TAG, "Unsupported bit rate");
+    return false;
+  }
+  esp_err_t err = twai_driver_install(&g_config, &t_config, &f_config);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Installing the TWAI driver failed: %s", esp_err_to_name(err));
+    return false;
+  }
+  err = twai_start();
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Starting the TWAI driver failed: %s", esp_err_to_name(err));
+    return false;
+  }
+  return true;
+}
+
+void ESP32Can::dump_config() {
+  canbus::Canbus::dump_config();
+  ESP_LOGCONFIG(TAG, "  RX Pin: GPIO%d", this->rx_);
+  ESP_LOGCONFIG(TAG, "  TX Pin: GPIO%d", this->tx_);
+  ESP_LOGCONFIG(TAG, "  Queue length: RX %u, TX %u", this->rx_queue_len_, this->tx_queue_len_);
+  ESP_LOGCONFIG(TAG, "  Acceptance filter: code 0x%08X, mask 0x%08X", this->acceptance_code_,
+                this->acceptance_mask_);
+}
+
+canbus::Error ESP32Can::send_message(struct canbus::CanFrame *frame) {
+  if (frame->can_data_length_code > canbus::CAN_MAX_DATA_LENGTH) {
+    return canbus::ERROR_FAILTX;
+  }
+
+  twai_message_t message{};
+  message.flags = (frame->use_extended_id ? TWAI_MSG_FLAG_EXTD : TWAI_MSG_FLAG_NONE) |
+                  (frame->remote_transmission_request ? TWAI_MSG_FLAG_RTR : TWAI_MSG_FLAG_NONE);
+  message.identifier = frame->can_id;
+  message.data_length_code = frame->can_data_length_code;
+  if (!frame->remote_transmission_request)
+    memcpy(message.data, frame->data, frame->can_data_length_code);
+
+  // Don't block the loop, the driver sends from its queue
+  esp_err_t err = twai_transmit(&message, 0);
+  if (err == ESP_ERR_TIMEOUT)
+    return canbus::ERROR_ALLTXBUSY;
+  if (err == ESP_ERR_INVALID_STATE)
+    this->recover_();
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "Sending frame failed: %s", esp_err_to_name(err));
+    return canbus::ERROR_FAILTX;
+  }
+  return canbus::ERROR_OK;
+}
+
+canbus::Error ESP32Can::read_message(struct canbus::CanFrame *frame) {
+  twai_message_t message;
+  if (twai_receive(&message, 0) != ESP_OK)
+    return canbus::ERROR_NOMSG;
+
+  frame->can_id = message.identifier;
+  frame->use_extended_id = message.flags & TWAI_MSG_FLAG_EXTD;
+  frame->remote_transmission_request = message.flags & TWAI_MSG_FLAG_RTR;
+  frame->can_data_length_code = std::min<uint8_t>(message.data_length_code, canbus::CAN_MAX_DATA_LENGTH);
+  if (!frame->remote_transmission_request)
+    memcpy(frame->data, message.data, frame->can_data_length_code);
+  return canbus::ERROR_OK;
+}
+
+void ESP32Can::recover_() {
+  twai_status_info_t status;
+  if (twai_get_status_info(&status) != ESP_OK)
+    return;
+  if (status.state == TWAI_STATE_BUS_OFF) {
+    ESP_LOGW(TAG, "Controller is bus-off, recovering");
+    twai_initiate_recovery();
+  } else if (status.state == TWAI_STATE_STOPPED) {
+    // after a recovery the controller is stopped
+    twai_start();
+  }
+}
+
+}  // namespace esp32_can
+}  // namespace esphome
+
+#endif  // USE_ESP32
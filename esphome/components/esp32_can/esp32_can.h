@@ -0,0 +1,43 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include "esphome/components/canbus/canbus.h"
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace esp32_can {
+
+/// canbus::Canbus on the built-in TWAI controller of the ESP32 family, frames are queued by the IDF driver.
+class ESP32Can : public canbus::Canbus {
+ public:
+  void set_rx(int rx) { this->rx_ = rx; }
+  void set_tx(int tx) { this->tx_ = tx; }
+  void set_rx_queue_len(uint32_t rx_queue_len) { this->rx_queue_len_ = rx_queue_len; }
+  void set_tx_queue_len(uint32_t tx_queue_len) { this->tx_queue_len_ = tx_queue_len; }
+  /// Set the single acceptance filter, see the TWAI docs for the bit layout. Set mask bits are ignored.
+  void set_acceptance_filter(uint32_t code, uint32_t mask) {
+    this->acceptance_code_ = code;
+    this->acceptance_mask_ = mask;
+  }
+  void dump_config() override;
+
+ protected:
+  bool setup_internal() override;
+  canbus::Error send_message(struct canbus::CanFrame *frame) override;
+  canbus::Error read_message(struct canbus::CanFrame *frame) override;
+  /// Bring the controller back after it went bus-off or stopped.
+  void recover_();
+
+  int rx_{-1};
+  int tx_{-1};
+  uint32_t rx_queue_len_{32};
+  uint32_t tx_queue_len_{8};
+  uint32_t acceptance_code_{0};
+  uint32_t acceptance_mask_{0xFFFFFFFF};
+};
+
+}  // namespace esp32_can
+}  // namespace esphome
+
+#endif  // USE_ESP32
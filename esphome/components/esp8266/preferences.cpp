@@ -6,7 +6,9 @@ extern "C" {
 }
 
 #include "preferences.h"
+#include <algorithm>
 #include <cstring>
+#include <memory>
 #include "esphome/core/preferences.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
@@ -19,7 +21,6 @@ static const char *const TAG = "esp8266.preferences";
 
 static bool s_prevent_write = false;         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 static uint32_t *s_flash_storage = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-static bool s_flash_dirty = false;           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 static const uint32_t ESP_RTC_USER_MEM_START = 0x60001200;
 #define ESP_RTC_USER_MEM ((uint32_t *) ESP_RTC_USER_MEM_START)
@@ -32,6 +33,24 @@ static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 128;
 static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 64;
 #endif
 
+// One bit per word of s_flash_storage that changed since the last sync()
+static uint32_t s_flash_dirty[(ESP8266_FLASH_STORAGE_SIZE + 31) / 32] = {};  // NOLINT
+
+/** The flash preferences are stored as an append-only log: a sync() appends one record per changed range of
+ * s_flash_storage, and an erase only happens once a sector is full, when the whole image is compacted into the next
+ * sector. The log uses the sector reserved after the filesystem and, if there is one, the end of the filesystem area
+ * before it (ESPHome doesn't use a filesystem on the ESP8266).
+ *
+ * Sector layout: LOG_SECTOR_MAGIC, sequence number, then records. A record is a header word (LOG_RECORD_MAGIC, word
+ * offset and word count), the data words and a checksum.
+ */
+static const uint32_t PREFERENCES_LOG_MAX_SECTORS = 4;
+static const uint32_t LOG_SECTOR_WORDS = SPI_FLASH_SEC_SIZE / 4;
+static const uint32_t LOG_SECTOR_MAGIC = 0x50524546;  // "PREF"
+static const uint32_t LOG_HEADER_WORDS = 2;
+static const uint32_t LOG_RECORD_MAGIC = 0xA5;
+static const uint32_t ERASED_WORD = 0xFFFFFFFF;
+
 static inline bool esp_rtc_user_mem_read(uint32_t index, uint32_t *dest) {
   if (index >= ESP_RTC_USER_MEM_SIZE_WORDS) {
     return false;
@@ -53,17 +72,43 @@ static inline bool esp_rtc_user_mem_write(uint32_t index, uint32_t value) {
   return true;
 }
 
-extern "C" uint32_t _SPIFFS_end;  // NOLINT
+extern "C" uint32_t _SPIFFS_start;  // NOLINT
+extern "C" uint32_t _SPIFFS_end;    // NOLINT
 
-static uint32_t get_esp8266_flash_sector() {
+static uint32_t get_flash_sector_of(uint32_t *symbol) {
   union {
     uint32_t *ptr;
     uint32_t uint;
   } data{};
-  data.ptr = &_SPIFFS_end;
+  data.ptr = symbol;
   return (data.uint - 0x40200000) / SPI_FLASH_SEC_SIZE;
 }
-static uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
+static uint32_t get_esp8266_flash_sector() { return get_flash_sector_of(&_SPIFFS_end); }
+static uint32_t get_log_sector_count() {
+  uint32_t filesystem_sectors = get_esp8266_flash_sector() - get_flash_sector_of(&_SPIFFS_start);
+  return 1 + std::min(filesystem_sectors, PREFERENCES_LOG_MAX_SECTORS - 1);
+}
+/// Log sector 0 is the reserved sector, the others are taken from the end of the filesystem area.
+static uint32_t get_log_sector_address(uint32_t index) {
+  return (get_esp8266_flash_sector() - index) * SPI_FLASH_SEC_SIZE;
+}
+
+static bool read_flash(uint32_t address, uint32_t *data, size_t len) {
+  InterruptLock lock;
+  return spi_flash_read(address, data, len * 4) == SPI_FLASH_RESULT_OK;
+}
+static bool write_flash(uint32_t address, uint32_t *data, size_t len) {
+  InterruptLock lock;
+  return spi_flash_write(address, data, len * 4) == SPI_FLASH_RESULT_OK;
+}
+static bool erase_flash_sector(uint32_t address) {
+  InterruptLock lock;
+  return spi_flash_erase_sector(address / SPI_FLASH_SEC_SIZE) == SPI_FLASH_RESULT_OK;
+}
+
+static uint32_t make_record_header(uint32_t offset, uint32_t len) {
+  return (LOG_RECORD_MAGIC << 24) | (offset << 16) | (len << 8);
+}
 
 template<class It> uint32_t calculate_crc(It first, It last, uint32_t type) {
   uint32_t crc = type;
@@ -81,7 +126,7 @@ static bool save_to_flash(size_t offset, const uint32_t *data, size_t len) {
     uint32_t v = data[i];
     uint32_t *ptr = &s_flash_storage[j];
     if (*ptr != v)
-      s_flash_dirty = true;
+      s_flash_dirty[j / 32] |= 1UL << (j % 32);
     *ptr = v;
   }
   return true;
@@ -165,12 +210,54 @@ class ESP8266Preferences : public ESPPreferences {
 
   void setup() {
     s_flash_storage = new uint32_t[ESP8266_FLASH_STORAGE_SIZE];  // NOLINT
+    std::fill(s_flash_storage, s_flash_storage + ESP8266_FLASH_STORAGE_SIZE, ERASED_WORD);
     ESP_LOGVV(TAG, "Loading preferences from flash...");
 
-    {
-      InterruptLock lock;
-      spi_flash_read(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+    this->log_sectors_ = get_log_sector_count();
+    bool found = false;
+    for (uint32_t i = 0; i < this->log_sectors_; i++) {
+      uint32_t header[LOG_HEADER_WORDS];
+      if (!read_flash(get_log_sector_address(i), header, LOG_HEADER_WORDS) || header[0] != LOG_SECTOR_MAGIC)
+        continue;
+      if (!found || static_cast<int32_t>(header[1] - this->log_sequence_) > 0) {
+        this->log_active_ = i;
+        this->log_sequence_ = header[1];
+        found = true;
+      }
+    }
+
+    if (!found) {
+      // No log yet, the reserved sector may still hold a plain copy of s_flash_storage from an older version. It's
+      // moved into a log sector by the first sync().
+      read_flash(get_log_sector_address(0), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE);
+      this->log_position_ = LOG_SECTOR_WORDS;
+      return;
+    }
+
+    std::unique_ptr<uint32_t[]> sector(new uint32_t[LOG_SECTOR_WORDS]);  // NOLINT
+    if (!read_flash(get_log_sector_address(this->log_active_), sector.get(), LOG_SECTOR_WORDS)) {
+      this->log_position_ = LOG_SECTOR_WORDS;
+      return;
     }
+    uint32_t pos = LOG_HEADER_WORDS;
+    while (pos < LOG_SECTOR_WORDS && sector[pos] != ERASED_WORD) {
+      const uint32_t header = sector[pos];
+      const uint32_t offset = (header >> 16) & 0xFF;
+      const uint32_t len = (header >> 8) & 0xFF;
+      if (header != make_record_header(offset, len) || len == 0 || offset + len > ESP8266_FLASH_STORAGE_SIZE ||
+          pos + len + 2 > LOG_SECTOR_WORDS) {
+        ESP_LOGW(TAG, "Preferences log is corrupted at word %u, compacting on the next save", pos);
+        pos = LOG_SECTOR_WORDS;
+        break;
+      }
+      const uint32_t *data = &sector[pos + 1];
+      // A record with a bad checksum was interrupted while being written, the previous value stays
+      if (calculate_crc(data, data + len, header) == data[len])
+        memcpy(&s_flash_storage[offset], data, len * 4);
+      pos += len + 2;
+    }
+    this->log_position_ = pos;
+    ESP_LOGVV(TAG, "Preferences log in sector %u uses %u/%u words", this->log_active_, pos, LOG_SECTOR_WORDS);
   }
 
   ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
@@ -226,32 +313,87 @@ class ESP8266Preferences : public ESPPreferences {
   }
 
   bool sync() override {
-    if (!s_flash_dirty)
+    bool dirty = false;
+    for (uint32_t word : s_flash_dirty)
+      dirty |= word != 0;
+    if (!dirty)
       return true;
     if (s_prevent_write)
       return false;
 
     ESP_LOGD(TAG, "Saving preferences to flash...");
-    SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
-    {
-      InterruptLock lock;
-      erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
-      if (erase_res == SPI_FLASH_RESULT_OK) {
-        write_res = spi_flash_write(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+    std::vector<uint32_t> record;
+    uint32_t start = 0;
+    while (true) {
+      while (start < ESP8266_FLASH_STORAGE_SIZE && !is_dirty_(start))
+        start++;
+      if (start == ESP8266_FLASH_STORAGE_SIZE)
+        break;
+      uint32_t end = start;
+      while (end < ESP8266_FLASH_STORAGE_SIZE && is_dirty_(end))
+        end++;
+
+      const uint32_t len = end - start;
+      if (this->log_position_ + len + 2 > LOG_SECTOR_WORDS)
+        return this->compact_();
+      record.resize(len + 2);
+      record[0] = make_record_header(start, len);
+      memcpy(&record[1], &s_flash_storage[start], len * 4);
+      record[len + 1] = calculate_crc(record.begin() + 1, record.end() - 1, record[0]);
+      const uint32_t address = get_log_sector_address(this->log_active_) + this->log_position_ * 4;
+      if (!write_flash(address, record.data(), record.size())) {
+        ESP_LOGV(TAG, "Write ESP8266 flash failed!");
+        // What made it to flash is unknown, start over in a fresh sector
+        this->log_position_ = LOG_SECTOR_WORDS;
+        return false;
       }
+      this->log_position_ += record.size();
+      this->flash_writes_++;
+      for (uint32_t i = start; i < end; i++)
+        s_flash_dirty[i / 32] &= ~(1UL << (i % 32));
+      start = end;
     }
-    if (erase_res != SPI_FLASH_RESULT_OK) {
+    return true;
+  }
+
+ protected:
+  static bool is_dirty_(uint32_t index) { return (s_flash_dirty[index / 32] >> (index % 32)) & 1; }
+
+  /// Write the whole image into the next log sector. The sector header is written last, so an interrupted compaction
+  /// leaves the previous sector active (unless there's only one sector).
+  bool compact_() {
+    const uint32_t next = (this->log_active_ + 1) % this->log_sectors_;
+    const uint32_t address = get_log_sector_address(next);
+    ESP_LOGD(TAG, "Compacting preferences into log sector %u...", next);
+    if (!erase_flash_sector(address)) {
       ESP_LOGV(TAG, "Erase ESP8266 flash failed!");
       return false;
     }
-    if (write_res != SPI_FLASH_RESULT_OK) {
+
+    std::vector<uint32_t> record(ESP8266_FLASH_STORAGE_SIZE + 2);
+    record[0] = make_record_header(0, ESP8266_FLASH_STORAGE_SIZE);
+    memcpy(&record[1], s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+    record[ESP8266_FLASH_STORAGE_SIZE + 1] = calculate_crc(record.begin() + 1, record.end() - 1, record[0]);
+    uint32_t header[LOG_HEADER_WORDS] = {LOG_SECTOR_MAGIC, this->log_sequence_ + 1};
+    if (!write_flash(address + LOG_HEADER_WORDS * 4, record.data(), record.size()) ||
+        !write_flash(address, header, LOG_HEADER_WORDS)) {
       ESP_LOGV(TAG, "Write ESP8266 flash failed!");
       return false;
     }
 
-    s_flash_dirty = false;
+    this->log_active_ = next;
+    this->log_sequence_++;
+    this->log_position_ = LOG_HEADER_WORDS + record.size();
+    this->flash_writes_++;
+    memset(s_flash_dirty, 0, sizeof(s_flash_dirty));
     return true;
   }
+
+  uint32_t log_sectors_{1};
+  uint32_t log_active_{0};
+  uint32_t log_sequence_{0};
+  /// Next free word in the active log sector, LOG_SECTOR_WORDS if the next sync() has to compact.
+  uint32_t log_position_{LOG_SECTOR_WORDS};
 };
 
 void setup_preferences() {
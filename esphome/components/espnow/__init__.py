@@ -0,0 +1,27 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_CHANNEL, CONF_ID
+
+DEPENDENCIES = ["esp32"]
+
+CONF_ESPNOW_ID = "espnow_id"
+CONF_PEER = "peer"
+
+espnow_ns = cg.esphome_ns.namespace("espnow")
+ESPNowComponent = espnow_ns.class_("ESPNowComponent", cg.Component, cg.Controller)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ESPNowComponent),
+        cv.Optional(CONF_PEER): cv.mac_address,
+        cv.Optional(CONF_CHANNEL, default=1): cv.int_range(min=1, max=14),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    if CONF_PEER in config:
+        cg.add(var.set_peer(config[CONF_PEER].as_hex))
+    cg.add(var.set_channel(config[CONF_CHANNEL]))
@@ -0,0 +1,22 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import binary_sensor
+from esphome.helpers import fnv1_hash
+from . import CONF_ESPNOW_ID, ESPNowComponent
+from .sensor import CONF_REMOTE_OBJECT_ID
+
+DEPENDENCIES = ["espnow"]
+
+CONFIG_SCHEMA = binary_sensor.BINARY_SENSOR_SCHEMA.extend(
+    {
+        cv.GenerateID(CONF_ESPNOW_ID): cv.use_id(ESPNowComponent),
+        cv.Required(CONF_REMOTE_OBJECT_ID): cv.string_strict,
+    }
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_ESPNOW_ID])
+    var = await binary_sensor.new_binary_sensor(config)
+    object_id_hash = fnv1_hash(config[CONF_REMOTE_OBJECT_ID])
+    cg.add(parent.register_binary_sensor(object_id_hash, var))
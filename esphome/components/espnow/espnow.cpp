@@ -0,0 +1,164 @@
+#ifdef USE_ESP32
+
+#include "espnow.h"
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+#include <esp_now.h>
+#include <esp_wifi.h>
+#include <esp_event.h>
+#include <cstring>
+
+namespace esphome {
+namespace espnow {
+
+static const char *const TAG = "espnow";
+
+static const uint8_t FRAME_MAGIC = 0xE5;
+
+ESPNowComponent *global_espnow = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static void receive_callback(const uint8_t *mac, const uint8_t *data, int len) {
+  global_espnow->on_receive(mac, data, len);
+}
+
+ESPNowComponent::ESPNowComponent() { global_espnow = this; }
+
+void ESPNowComponent::set_peer(uint64_t peer) {
+  for (int i = 0; i < 6; i++)
+    this->peer_[i] = peer >> ((5 - i) * 8);
+  this->has_peer_ = true;
+}
+
+bool ESPNowComponent::init_wifi_() {
+#ifndef USE_WIFI
+  // without the wifi component only the radio is needed, in station mode on a fixed channel
+  esp_err_t err = esp_event_loop_create_default();
+  if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+    ESP_LOGE(TAG, "esp_event_loop_create_default failed: %s", esp_err_to_name(err));
+    return false;
+  }
+  wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+  err = esp_wifi_init(&cfg);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "esp_wifi_init failed: %s", esp_err_to_name(err));
+    return false;
+  }
+  esp_wifi_set_storage(WIFI_STORAGE_RAM);
+  esp_wifi_set_mode(WIFI_MODE_STA);
+  err = esp_wifi_start();
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "esp_wifi_start failed: %s", esp_err_to_name(err));
+    return false;
+  }
+  err = esp_wifi_set_channel(this->channel_, WIFI_SECOND_CHAN_NONE);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "esp_wifi_set_channel failed: %s", esp_err_to_name(err));
+    return false;
+  }
+#endif
+  return true;
+}
+
+void ESPNowComponent::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up ESP-NOW...");
+  if (!this->init_wifi_()) {
+    this->mark_failed();
+    return;
+  }
+  esp_err_t err = esp_now_init();
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "esp_now_init failed: %s", esp_err_to_name(err));
+    this->mark_failed();
+    return;
+  }
+  esp_now_register_recv_cb(receive_callback);
+
+  if (this->has_peer_) {
+    esp_now_peer_info_t peer{};
+    memcpy(peer.peer_addr, this->peer_, sizeof(this->peer_));
+    // 0 sends on the current channel
+    peer.channel = 0;
+    peer.ifidx = WIFI_IF_STA;
+    peer.encrypt = false;
+    err = esp_now_add_peer(&peer);
+    if (err != ESP_OK) {
+      ESP_LOGE(TAG, "esp_now_add_peer failed: %s", esp_err_to_name(err));
+      this->mark_failed();
+      return;
+    }
+    this->setup_controller();
+  }
+}
+
+void ESPNowComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "ESP-NOW:");
+  if (this->has_peer_) {
+    ESP_LOGCONFIG(TAG, "  Peer: %02X:%02X:%02X:%02X:%02X:%02X", this->peer_[0], this->peer_[1], this->peer_[2],
+                  this->peer_[3], this->peer_[4], this->peer_[5]);
+  }
+#ifndef USE_WIFI
+  ESP_LOGCONFIG(TAG, "  Channel: %u", this->channel_);
+#endif
+}
+
+void ESPNowComponent::on_receive(const uint8_t *mac, const uint8_t *data, int len) {
+  // runs in the Wi-Fi task, the entities are only looked up here (the maps don't change after setup) and their states
+  // are published from the main loop
+  if (len != sizeof(ESPNowStateFrame) || data[0] != FRAME_MAGIC)
+    return;
+  ESPNowStateFrame frame;
+  memcpy(&frame, data, sizeof(frame));
+  switch (frame.type) {
+#ifdef USE_SENSOR
+    case ESPNOW_STATE_SENSOR: {
+      auto it = this->sensors_.find(frame.object_id_hash);
+      if (it != this->sensors_.end())
+        App.publish_queue.push_float(it->second, frame.value);
+      return;
+    }
+#endif
+#ifdef USE_BINARY_SENSOR
+    case ESPNOW_STATE_BINARY_SENSOR: {
+      auto it = this->binary_sensors_.find(frame.object_id_hash);
+      if (it != this->binary_sensors_.end())
+        App.publish_queue.push_bool(it->second, frame.value != 0.0f);
+      return;
+    }
+#endif
+    default:
+      return;
+  }
+}
+
+void ESPNowComponent::send_(ESPNowStateType type, EntityBase *obj, float value) {
+  ESPNowStateFrame frame{};
+  frame.magic = FRAME_MAGIC;
+  frame.type = type;
+  frame.object_id_hash = obj->get_object_id_hash();
+  frame.value = value;
+  esp_err_t err = esp_now_send(this->peer_, reinterpret_cast<const uint8_t *>(&frame), sizeof(frame));
+  if (err != ESP_OK) {
+    // don't log every failed state, a peer that's out of range fails them all
+    if (this->send_errors_++ == 0)
+      ESP_LOGW(TAG, "Sending '%s' failed: %s", obj->get_name().c_str(), esp_err_to_name(err));
+    return;
+  }
+  this->send_errors_ = 0;
+}
+
+#ifdef USE_SENSOR
+void ESPNowComponent::on_sensor_update(sensor::Sensor *obj, float state) {
+  this->send_(ESPNOW_STATE_SENSOR, obj, state);
+}
+#endif
+#ifdef USE_BINARY_SENSOR
+void ESPNowComponent::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
+  this->send_(ESPNOW_STATE_BINARY_SENSOR, obj, state ? 1.0f : 0.0f);
+}
+#endif
+
+}  // namespace espnow
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,91 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include "esphome/core/component.h"
+#include "esphome/core/controller.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_BINARY_SENSOR
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#endif
+
+#include <map>
+
+namespace esphome {
+namespace espnow {
+
+enum ESPNowStateType : uint8_t {
+  ESPNOW_STATE_SENSOR = 0,
+  ESPNOW_STATE_BINARY_SENSOR = 1,
+};
+
+/// One state update as it's sent over ESP-NOW.
+struct ESPNowStateFrame {
+  uint8_t magic;
+  uint8_t type;  ///< An ESPNowStateType.
+  uint32_t object_id_hash;
+  float value;
+} PACKED;  // NOLINT
+
+/** Relay entity states between nodes over ESP-NOW, without a Wi-Fi connection.
+ *
+ * A node with a peer sends every state change of its sensors and binary sensors as a small frame to that peer (the
+ * gateway), right when it's published. The gateway publishes the frames it receives through the espnow sensors and
+ * binary sensors that are configured with the object id of the sending entity.
+ *
+ * Both nodes need to be on the same Wi-Fi channel. If the gateway is connected to Wi-Fi, that's the channel of its
+ * access point.
+ */
+class ESPNowComponent : public Component, public Controller {
+ public:
+  ESPNowComponent();
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  /// Set the node that states are sent to, as a 48 bit MAC address.
+  void set_peer(uint64_t peer);
+  /// The channel to use if there's no wifi component that decides it.
+  void set_channel(uint8_t channel) { this->channel_ = channel; }
+
+#ifdef USE_SENSOR
+  void register_sensor(uint32_t object_id_hash, sensor::Sensor *obj) { this->sensors_[object_id_hash] = obj; }
+  void on_sensor_update(sensor::Sensor *obj, float state) override;
+#endif
+#ifdef USE_BINARY_SENSOR
+  void register_binary_sensor(uint32_t object_id_hash, binary_sensor::BinarySensor *obj) {
+    this->binary_sensors_[object_id_hash] = obj;
+  }
+  void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
+#endif
+
+  /// Called from the Wi-Fi task for every received packet.
+  void on_receive(const uint8_t *mac, const uint8_t *data, int len);
+
+ protected:
+  bool init_wifi_();
+  void send_(ESPNowStateType type, EntityBase *obj, float value);
+
+  uint8_t peer_[6]{};
+  bool has_peer_{false};
+  uint8_t channel_{1};
+  uint32_t send_errors_{0};
+#ifdef USE_SENSOR
+  std::map<uint32_t, sensor::Sensor *> sensors_;
+#endif
+#ifdef USE_BINARY_SENSOR
+  std::map<uint32_t, binary_sensor::BinarySensor *> binary_sensors_;
+#endif
+};
+
+extern ESPNowComponent *global_espnow;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace espnow
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,22 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.helpers import fnv1_hash
+from . import CONF_ESPNOW_ID, ESPNowComponent
+
+DEPENDENCIES = ["espnow"]
+
+CONF_REMOTE_OBJECT_ID = "remote_object_id"
+
+CONFIG_SCHEMA = sensor.sensor_schema().extend(
+    {
+        cv.GenerateID(CONF_ESPNOW_ID): cv.use_id(ESPNowComponent),
+        cv.Required(CONF_REMOTE_OBJECT_ID): cv.string_strict,
+    }
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_ESPNOW_ID])
+    var = await sensor.new_sensor(config)
+    cg.add(parent.register_sensor(fnv1_hash(config[CONF_REMOTE_OBJECT_ID]), var))
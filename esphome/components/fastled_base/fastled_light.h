@@ -223,6 +223,21 @@ class FastLEDLightOutput : public light::AddressableLight {
       this->effect_data_[i] = 0;
   }
 
+  using Format = light::AddressablePixelFormat<sizeof(CRGB), 0, 1, 2>;
+
+  optional<light::AddressableLightBuffer> get_raw_buffer() const override {
+    return Format::buffer(reinterpret_cast<uint8_t *>(this->leds_));
+  }
+  void fill_range(int32_t from, int32_t to, Color color) override {
+    Format::fill(reinterpret_cast<uint8_t *>(this->leds_), from, to, color, this->correction_);
+  }
+  void write_span(int32_t first, const Color *colors, int32_t count) override {
+    Format::write(reinterpret_cast<uint8_t *>(this->leds_), first, colors, count, this->correction_);
+  }
+  void read_span(int32_t first, Color *colors, int32_t count) const override {
+    Format::read(reinterpret_cast<const uint8_t *>(this->leds_), first, colors, count, this->correction_);
+  }
+
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override {
     return {&this->leds_[index].r,      &this->leds_[index].g, &this->leds_[index].b, nullptr,
@@ -75,6 +75,7 @@ DEFAULT_GLYPHS = (
     ' !"%()+=,-.:/0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz°'
 )
 CONF_RAW_GLYPH_ID = "raw_glyph_id"
+CONF_TEXT_CACHE_SIZE = "text_cache_size"
 
 FONT_SCHEMA = cv.Schema(
     {
@@ -82,6 +83,7 @@ FONT_SCHEMA = cv.Schema(
         cv.Required(CONF_FILE): validate_truetype_file,
         cv.Optional(CONF_GLYPHS, default=DEFAULT_GLYPHS): validate_glyphs,
         cv.Optional(CONF_SIZE, default=20): cv.int_range(min=1),
+        cv.Optional(CONF_TEXT_CACHE_SIZE, default=0): cv.int_range(min=0, max=64),
         cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         cv.GenerateID(CONF_RAW_GLYPH_ID): cv.declare_id(GlyphData),
     }
@@ -115,8 +117,33 @@ async def to_code(config):
                     continue
                 pos = x + y * width8
                 glyph_data[pos // 8] |= 0x80 >> (pos % 8)
-        glyph_args[glyph] = (len(data), offset_x, offset_y, width, height)
-        data += glyph_data
+        if width > 255:
+            raise core.EsphomeError(
+                f"Glyph '{glyph}' is {width} pixels wide, at most 255 are supported"
+            )
+        # runs of set pixels per row, as count followed by (start, length) pairs
+        spans = []
+        for y in range(height):
+            runs = []
+            x = 0
+            while x < width:
+                if not mask.getpixel((x, y)):
+                    x += 1
+                    continue
+                start = x
+                while x < width and mask.getpixel((x, y)):
+                    x += 1
+                runs += [start, x - start]
+            spans += [len(runs) // 2] + runs
+        glyph_args[glyph] = (
+            len(data),
+            offset_x,
+            offset_y,
+            width,
+            height,
+            len(data) + len(glyph_data),
+        )
+        data += glyph_data + spans
 
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
@@ -131,6 +158,10 @@ async def to_code(config):
                     "data",
                     cg.RawExpression(f"{str(prog_arr)} + {str(glyph_args[glyph][0])}"),
                 ),
+                (
+                    "spans",
+                    cg.RawExpression(f"{str(prog_arr)} + {str(glyph_args[glyph][5])}"),
+                ),
                 ("offset_x", glyph_args[glyph][1]),
                 ("offset_y", glyph_args[glyph][2]),
                 ("width", glyph_args[glyph][3]),
@@ -140,6 +171,8 @@ async def to_code(config):
 
     glyphs = cg.static_const_array(config[CONF_RAW_GLYPH_ID], glyph_initializer)
 
-    cg.new_Pvariable(
+    var = cg.new_Pvariable(
         config[CONF_ID], glyphs, len(glyph_initializer), ascent, ascent + descent
     )
+    if config[CONF_TEXT_CACHE_SIZE] > 0:
+        cg.add(var.set_text_cache_size(config[CONF_TEXT_CACHE_SIZE]))
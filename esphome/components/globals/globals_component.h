@@ -34,12 +34,18 @@ template<typename T> class RestoringGlobalsComponent : public Component {
     memcpy(this->value_, initial_value.data(), sizeof(T));
   }
 
-  T &value() { return this->value_; }
+  /// The value may be changed through the reference, so it's compared to the saved one in the next loop().
+  T &value() {
+    this->enable_loop();
+    return this->value_;
+  }
 
   void setup() override {
     this->rtc_ = global_preferences->make_preference<T>(1944399030U ^ this->name_hash_);
     this->rtc_.load(&this->value_);
     memcpy(&this->prev_value_, &this->value_, sizeof(T));
+    // Only loop after the value was accessed
+    this->disable_loop();
   }
 
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
@@ -47,9 +53,11 @@ template<typename T> class RestoringGlobalsComponent : public Component {
   void loop() override {
     int diff = memcmp(&this->value_, &this->prev_value_, sizeof(T));
     if (diff != 0) {
+      // Saves are written to flash by the preferences syncer
       this->rtc_.save(&this->value_);
       memcpy(&this->prev_value_, &this->value_, sizeof(T));
     }
+    this->disable_loop();
   }
 
   void set_name_hash(uint32_t name_hash) { this->name_hash_ = name_hash; }
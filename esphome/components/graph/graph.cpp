@@ -14,6 +14,7 @@ using namespace display;
 
 static const char *const TAG = "graph";
 static const char *const TAGL = "graphlegend";
+static const int16_t POINT_NONE = INT16_MIN;
 
 void HistoryData::init(int length) {
   this->length_ = length;
@@ -29,23 +30,38 @@ void HistoryData::take_sample(float data) {
   // Step data based on time
   this->period_ += dt;
   while (this->period_ >= this->update_time_) {
+    // only a sample that defined the range can shrink it, so a full rescan is rarely needed
+    const float old = this->samples_[this->count_];
+    if (old == this->recent_min_ || old == this->recent_max_)
+      this->range_invalid_ = true;
     this->samples_[this->count_] = data;
+    // only stored values can widen the range, one published between two steps would never be overwritten
+    if (!std::isnan(data) && !this->range_invalid_) {
+      if (std::isnan(this->recent_max_) || this->recent_max_ < data)
+        this->recent_max_ = data;
+      if (std::isnan(this->recent_min_) || this->recent_min_ > data)
+        this->recent_min_ = data;
+    }
     this->period_ -= this->update_time_;
     this->count_ = (this->count_ + 1) % this->length_;
+    this->sample_count_++;
     ESP_LOGV(TAG, "Updating trace with value: %f", data);
   }
-  if (!std::isnan(data)) {
-    // Recalc recent max/min
-    this->recent_min_ = data;
-    this->recent_max_ = data;
-    for (int i = 0; i < this->length_; i++) {
-      if (!std::isnan(this->samples_[i])) {
-        if (this->recent_max_ < this->samples_[i])
-          this->recent_max_ = this->samples_[i];
-        if (this->recent_min_ > this->samples_[i])
-          this->recent_min_ = this->samples_[i];
-      }
-    }
+}
+
+void HistoryData::update_range_() const {
+  if (!this->range_invalid_)
+    return;
+  this->range_invalid_ = false;
+  this->recent_min_ = NAN;
+  this->recent_max_ = NAN;
+  for (float sample : this->samples_) {
+    if (std::isnan(sample))
+      continue;
+    if (std::isnan(this->recent_max_) || this->recent_max_ < sample)
+      this->recent_max_ = sample;
+    if (std::isnan(this->recent_min_) || this->recent_min_ > sample)
+      this->recent_min_ = sample;
   }
 }
 
@@ -54,6 +70,28 @@ void GraphTrace::init(Graph *g) {
   this->data_.init(g->get_width());
   sensor_->add_on_state_callback([this](float state) { this->data_.take_sample(state); });
   this->data_.set_update_time_ms(g->get_duration() * 1000 / g->get_width());
+  this->points_.resize(g->get_width(), POINT_NONE);
+}
+
+void GraphTrace::update_points_(float ymin, float yrange, uint32_t height) {
+  const int length = this->data_.get_length();
+  uint32_t fresh = this->data_.get_sample_count() - this->points_sample_count_;
+  if (ymin != this->points_ymin_ || yrange != this->points_yrange_ || fresh > uint32_t(length))
+    fresh = length;
+  this->points_ymin_ = ymin;
+  this->points_yrange_ = yrange;
+  this->points_sample_count_ = this->data_.get_sample_count();
+
+  const int thick = this->line_thickness_;
+  for (uint32_t i = 0; i < fresh; i++) {
+    const float v = (this->data_.get_value(i) - ymin) / yrange;
+    int16_t &point = this->points_[this->data_.get_index(i)];
+    if (std::isnan(v)) {
+      point = POINT_NONE;
+    } else {
+      point = (int16_t) roundf((height - 1) * (1.0 - v)) - thick / 2;
+    }
+  }
 }
 
 void Graph::draw(DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Color color) {
@@ -158,17 +196,18 @@ void Graph::draw(DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Colo
   for (auto *trace : traces_) {
     Color c = trace->get_line_color();
     uint16_t thick = trace->get_line_thickness();
+    if (thick == 0)
+      continue;
+    trace->update_points_(ymin, yrange, this->height_);
+    const HistoryData *data = trace->get_tracedata();
     for (uint32_t i = 0; i < this->width_; i++) {
-      float v = (trace->get_tracedata()->get_value(i) - ymin) / yrange;
-      if (!std::isnan(v) && (thick > 0)) {
-        int16_t x = this->width_ - 1 - i;
-        uint8_t b = (i % (thick * LineType::PATTERN_LENGTH)) / thick;
-        if (((uint8_t) trace->get_line_type() & (1 << b)) == (1 << b)) {
-          int16_t y = (int16_t) roundf((this->height_ - 1) * (1.0 - v)) - thick / 2;
-          for (uint16_t t = 0; t < thick; t++) {
-            buff->draw_pixel_at(x_offset + x, y_offset + y + t, c);
-          }
-        }
+      const int16_t y = trace->points_[data->get_index(i)];
+      if (y == POINT_NONE)
+        continue;
+      int16_t x = this->width_ - 1 - i;
+      uint8_t b = (i % (thick * LineType::PATTERN_LENGTH)) / thick;
+      if (((uint8_t) trace->get_line_type() & (1 << b)) == (1 << b)) {
+        buff->vertical_line(x_offset + x, y_offset + y, thick, c);
       }
     }
   }
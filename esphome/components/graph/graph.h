@@ -89,18 +89,33 @@ class HistoryData {
   void set_update_time_ms(uint32_t update_time_ms) { update_time_ = update_time_ms; }
   void take_sample(float data);
   int get_length() const { return length_; }
-  float get_value(int idx) const { return samples_[(count_ + length_ - 1 - idx) % length_]; }
-  float get_recent_max() const { return recent_max_; }
-  float get_recent_min() const { return recent_min_; }
+  /// Position in the ring buffer of the sample taken idx samples ago.
+  int get_index(int idx) const { return (count_ + length_ - 1 - idx) % length_; }
+  float get_value(int idx) const { return samples_[this->get_index(idx)]; }
+  float get_recent_max() const {
+    this->update_range_();
+    return recent_max_;
+  }
+  float get_recent_min() const {
+    this->update_range_();
+    return recent_min_;
+  }
+  /// Total number of samples stored so far, tells which samples are new since an earlier call.
+  uint32_t get_sample_count() const { return sample_count_; }
 
  protected:
+  /// Recalculate the min/max range if a sample that defined it was overwritten.
+  void update_range_() const;
+
   uint32_t last_sample_;
   uint32_t period_{0};       /// in ms
   uint32_t update_time_{0};  /// in ms
   int length_;
   int count_{0};
-  float recent_min_{NAN};
-  float recent_max_{NAN};
+  uint32_t sample_count_{0};
+  mutable bool range_invalid_{false};
+  mutable float recent_min_{NAN};
+  mutable float recent_max_{NAN};
   std::vector<float> samples_;
 };
 
@@ -119,12 +134,23 @@ class GraphTrace {
   const HistoryData *get_tracedata() { return &data_; }
 
  protected:
+  /** Bring points_ up to date for the given scale.
+   *
+   * Only samples taken since the last call are scaled, unless the scale changed.
+   */
+  void update_points_(float ymin, float yrange, uint32_t height);
+
   sensor::Sensor *sensor_{nullptr};
   std::string name_{""};
   uint8_t line_thickness_{3};
   enum LineType line_type_ { LINE_TYPE_SOLID };
   Color line_color_{COLOR_ON};
   HistoryData data_;
+  /// Top pixel row of the line for each sample (same positions as in data_), POINT_NONE for missing samples.
+  std::vector<int16_t> points_;
+  float points_ymin_{NAN};
+  float points_yrange_{NAN};
+  uint32_t points_sample_count_{0};
 
   friend Graph;
   friend GraphLegend;
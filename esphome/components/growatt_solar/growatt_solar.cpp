@@ -1,5 +1,6 @@
 #include "growatt_solar.h"
 #include "esphome/core/log.h"
+#include "esphome/core/controller.h"
 
 namespace esphome {
 namespace growatt_solar {
@@ -11,7 +12,8 @@ static const uint8_t MODBUS_REGISTER_COUNT = 33;
 
 void GrowattSolar::update() { this->send(MODBUS_CMD_READ_IN_REGISTERS, 0, MODBUS_REGISTER_COUNT); }
 
-void GrowattSolar::on_modbus_data(const std::vector<uint8_t> &data) {
+void GrowattSolar::on_modbus_frame(const uint8_t *data, size_t len) {
+  StateBatch batch;
   auto publish_1_reg_sensor_state = [&](sensor::Sensor *sensor, size_t i, float unit) -> void {
     if (sensor == nullptr)
       return;
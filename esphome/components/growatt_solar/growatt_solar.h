@@ -13,7 +13,7 @@ static const float ONE_DEC_UNIT = 0.1;
 class GrowattSolar : public PollingComponent, public modbus::ModbusDevice {
  public:
   void update() override;
-  void on_modbus_data(const std::vector<uint8_t> &data) override;
+  void on_modbus_frame(const uint8_t *data, size_t len) override;
   void dump_config() override;
 
   void set_inverter_status_sensor(sensor::Sensor *sensor) { this->inverter_status_ = sensor; }
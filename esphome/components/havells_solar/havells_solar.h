@@ -76,7 +76,7 @@ class HavellsSolar : public PollingComponent, public modbus::ModbusDevice {
 
   void update() override;
 
-  void on_modbus_data(const std::vector<uint8_t> &data) override;
+  void on_modbus_frame(const uint8_t *data, size_t len) override;
 
   void dump_config() override;
 
@@ -0,0 +1,85 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import http_request, time
+from esphome.const import (
+    CONF_BUFFER_SIZE,
+    CONF_FORMAT,
+    CONF_ID,
+    CONF_INCLUDE_INTERNAL,
+    CONF_TIME_ID,
+    CONF_URL,
+)
+
+DEPENDENCIES = ["http_request"]
+
+http_exporter_ns = cg.esphome_ns.namespace("http_exporter")
+HttpExporter = http_exporter_ns.class_("HttpExporter", cg.Component, cg.Controller)
+ExportFormat = http_exporter_ns.enum("ExportFormat")
+EXPORT_FORMATS = {
+    "INFLUX": ExportFormat.EXPORT_FORMAT_INFLUX,
+    "JSON_LINES": ExportFormat.EXPORT_FORMAT_JSON_LINES,
+}
+
+CONF_HTTP_REQUEST_ID = "http_request_id"
+CONF_HEADERS = "headers"
+CONF_MEASUREMENT = "measurement"
+CONF_FLUSH_INTERVAL = "flush_interval"
+CONF_BATCH_SIZE = "batch_size"
+
+
+def validate_sizes(config):
+    if config[CONF_BATCH_SIZE] > config[CONF_BUFFER_SIZE]:
+        raise cv.Invalid(f"{CONF_BATCH_SIZE} can't be larger than {CONF_BUFFER_SIZE}")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(HttpExporter),
+            cv.GenerateID(CONF_HTTP_REQUEST_ID): cv.use_id(
+                http_request.HttpRequestComponent
+            ),
+            cv.Required(CONF_URL): http_request.validate_url,
+            cv.Optional(CONF_FORMAT, default="influx"): cv.enum(
+                EXPORT_FORMATS, upper=True, space="_"
+            ),
+            cv.Optional(CONF_MEASUREMENT, default="esphome"): cv.string_strict,
+            cv.Optional(CONF_HEADERS, default={}): cv.All(
+                cv.Schema({cv.string: cv.string})
+            ),
+            cv.Optional(
+                CONF_FLUSH_INTERVAL, default="10s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_BATCH_SIZE, default="4kB"): cv.All(
+                cv.validate_bytes, cv.int_range(min=256)
+            ),
+            cv.Optional(CONF_BUFFER_SIZE, default="16kB"): cv.All(
+                cv.validate_bytes, cv.int_range(min=256)
+            ),
+            cv.Optional(CONF_INCLUDE_INTERNAL, default=False): cv.boolean,
+            cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.only_with_arduino,
+    validate_sizes,
+)
+
+
+async def to_code(config):
+    paren = await cg.get_variable(config[CONF_HTTP_REQUEST_ID])
+    var = cg.new_Pvariable(config[CONF_ID], paren)
+    await cg.register_component(var, config)
+
+    cg.add(var.set_url(config[CONF_URL]))
+    cg.add(var.set_format(config[CONF_FORMAT]))
+    cg.add(var.set_measurement(config[CONF_MEASUREMENT]))
+    for name, value in config[CONF_HEADERS].items():
+        cg.add(var.add_header(name, value))
+    cg.add(var.set_flush_interval(config[CONF_FLUSH_INTERVAL]))
+    cg.add(var.set_batch_size(config[CONF_BATCH_SIZE]))
+    cg.add(var.set_buffer_size(config[CONF_BUFFER_SIZE]))
+    cg.add(var.set_include_internal(config[CONF_INCLUDE_INTERNAL]))
+    if CONF_TIME_ID in config:
+        time_ = await cg.get_variable(config[CONF_TIME_ID])
+        cg.add(var.set_time(time_))
@@ -0,0 +1,215 @@
+#ifdef USE_ARDUINO
+
+#include "http_exporter.h"
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace esphome {
+namespace http_exporter {
+
+static const char *const TAG = "http_exporter";
+
+static const uint32_t MIN_RETRY_DELAY = 5000;
+static const uint32_t MAX_RETRY_DELAY = 300000;
+
+void HttpExporter::setup() {
+  this->buffer_ = static_cast<uint8_t *>(ram_allocate(RAMPolicy::BULK, this->buffer_size_));
+  if (this->buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate a buffer of %zu bytes", this->buffer_size_);
+    this->mark_failed();
+    return;
+  }
+  this->device_ = App.get_name();
+  this->setup_controller(this->include_internal_);
+}
+
+void HttpExporter::dump_config() {
+  ESP_LOGCONFIG(TAG, "HTTP Exporter:");
+  ESP_LOGCONFIG(TAG, "  URL: %s", this->url_.c_str());
+  ESP_LOGCONFIG(TAG, "  Format: %s", this->format_ == EXPORT_FORMAT_INFLUX ? "InfluxDB line protocol" : "JSON lines");
+  ESP_LOGCONFIG(TAG, "  Flush Interval: %ums", this->flush_interval_);
+  ESP_LOGCONFIG(TAG, "  Batch Size: %zu bytes", this->batch_size_);
+  ESP_LOGCONFIG(TAG, "  Buffer Size: %zu bytes", this->buffer_size_);
+}
+
+void HttpExporter::loop() {
+  if (this->sending_ || this->buffer_len_ == 0)
+    return;
+  uint32_t wait = this->flush_interval_;
+  if (this->retry_delay_ != 0) {
+    wait = this->retry_delay_;
+  } else if (this->buffer_len_ >= this->batch_size_) {
+    wait = 0;
+  }
+  if (millis() - this->last_attempt_ < wait)
+    return;
+  this->flush_();
+}
+
+#ifdef USE_SENSOR
+void HttpExporter::on_sensor_update(sensor::Sensor *obj, float state) {
+  if (std::isnan(state))
+    return;
+  this->add_value_(obj, value_accuracy_to_string(state, obj->get_accuracy_decimals()));
+}
+#endif
+#ifdef USE_BINARY_SENSOR
+void HttpExporter::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
+  this->add_value_(obj, state ? "1" : "0");
+}
+#endif
+#ifdef USE_SWITCH
+void HttpExporter::on_switch_update(switch_::Switch *obj, bool state) { this->add_value_(obj, state ? "1" : "0"); }
+#endif
+#ifdef USE_NUMBER
+void HttpExporter::on_number_update(number::Number *obj, float state) {
+  if (std::isnan(state))
+    return;
+  this->add_value_(obj, str_sprintf("%g", state));
+}
+#endif
+#ifdef USE_TEXT_SENSOR
+void HttpExporter::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
+  this->add_string_(obj, state);
+}
+#endif
+#ifdef USE_SELECT
+void HttpExporter::on_select_update(select::Select *obj, const std::string &state) { this->add_string_(obj, state); }
+#endif
+
+std::string HttpExporter::begin_line_(EntityBase *obj) {
+  // Device names and object ids only contain characters that don't need escaping in tags or JSON
+  std::string line;
+  if (this->format_ == EXPORT_FORMAT_INFLUX) {
+    line = this->measurement_ + ",device=" + this->device_ + ",entity=" + obj->get_object_id() + " ";
+  } else {
+    line = "{\"device\":\"" + this->device_ + "\",\"entity\":\"" + obj->get_object_id() + "\",";
+  }
+  return line;
+}
+
+void HttpExporter::end_line_(std::string &line) {
+  time_t timestamp = 0;
+#ifdef USE_TIME
+  if (this->time_ != nullptr && this->time_->utcnow().is_valid())
+    timestamp = this->time_->timestamp_now();
+#endif
+  if (this->format_ == EXPORT_FORMAT_INFLUX) {
+    // Nanoseconds, the default precision of the write endpoint
+    if (timestamp != 0)
+      line += " " + to_string(static_cast<int64_t>(timestamp)) + "000000000";
+    line += "\n";
+  } else {
+    if (timestamp != 0)
+      line += ",\"time\":" + to_string(static_cast<int64_t>(timestamp));
+    line += "}\n";
+  }
+  this->append_(line);
+}
+
+void HttpExporter::add_value_(EntityBase *obj, const std::string &value) {
+  std::string line = this->begin_line_(obj);
+  line += this->format_ == EXPORT_FORMAT_INFLUX ? "value=" : "\"value\":";
+  line += value;
+  this->end_line_(line);
+}
+
+void HttpExporter::add_string_(EntityBase *obj, const std::string &value) {
+  std::string line = this->begin_line_(obj);
+  line += this->format_ == EXPORT_FORMAT_INFLUX ? "state=\"" : "\"state\":\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      line += '\\';
+      line += c;
+    } else if (static_cast<uint8_t>(c) < 0x20) {
+      // Control characters aren't allowed in either format
+      line += this->format_ == EXPORT_FORMAT_INFLUX ? std::string(" ") : str_sprintf("\\u%04x", c);
+    } else {
+      line += c;
+    }
+  }
+  line += '"';
+  this->end_line_(line);
+}
+
+void HttpExporter::append_(const std::string &line) {
+  if (this->buffer_ == nullptr || line.size() > this->buffer_size_)
+    return;
+  if (this->buffer_len_ + line.size() > this->buffer_size_)
+    this->drop_(this->buffer_len_ + line.size() - this->buffer_size_);
+  memcpy(this->buffer_ + this->buffer_len_, line.data(), line.size());
+  this->buffer_len_ += line.size();
+}
+
+void HttpExporter::drop_(size_t len) {
+  auto *end = static_cast<uint8_t *>(memchr(this->buffer_ + len - 1, '\n', this->buffer_len_ - len + 1));
+  size_t drop = end == nullptr ? this->buffer_len_ : end - this->buffer_ + 1;
+  for (size_t i = 0; i < drop; i++) {
+    if (this->buffer_[i] == '\n')
+      this->dropped_++;
+  }
+  memmove(this->buffer_, this->buffer_ + drop, this->buffer_len_ - drop);
+  this->buffer_len_ -= drop;
+  // What's being sent now starts later in the buffer, only the rest of it may be removed after a success
+  this->sending_len_ = this->sending_len_ > drop ? this->sending_len_ - drop : 0;
+}
+
+void HttpExporter::flush_() {
+  size_t len = this->buffer_len_;
+  if (len > this->batch_size_) {
+    // Whole lines only, a single line is sent on its own even if it's longer than a batch
+    size_t end = this->batch_size_;
+    while (end > 0 && this->buffer_[end - 1] != '\n')
+      end--;
+    if (end == 0)
+      end = static_cast<uint8_t *>(memchr(this->buffer_, '\n', len)) - this->buffer_ + 1;
+    len = end;
+  }
+
+  ESP_LOGV(TAG, "Sending %zu of %zu bytes", len, this->buffer_len_);
+  this->sending_ = true;
+  this->sending_len_ = len;
+  this->last_attempt_ = millis();
+  this->parent_->set_url(this->url_);
+  this->parent_->set_method("POST");
+  this->parent_->set_body(std::string(reinterpret_cast<const char *>(this->buffer_), len));
+  this->parent_->set_headers(this->headers_);
+  this->parent_->send({}, [this](int status_code) { this->on_response_(status_code); });
+  // Don't leave the batch to an http_request action that doesn't set its own body or headers
+  this->parent_->set_body("");
+  this->parent_->set_headers({});
+}
+
+void HttpExporter::on_response_(int status_code) {
+  this->sending_ = false;
+  bool rejected = status_code >= 400 && status_code < 500 && status_code != 429;
+  if (status_code < 200 || (status_code >= 300 && !rejected)) {
+    this->retry_delay_ = clamp(this->retry_delay_ * 2, MIN_RETRY_DELAY, MAX_RETRY_DELAY);
+    ESP_LOGW(TAG, "Sending failed (%d), retrying in %us", status_code, this->retry_delay_ / 1000);
+    this->status_set_warning();
+    return;
+  }
+
+  if (rejected) {
+    // Sending the same data again won't help
+    ESP_LOGW(TAG, "Server rejected %zu bytes (%d), dropping them", this->sending_len_, status_code);
+  }
+  memmove(this->buffer_, this->buffer_ + this->sending_len_, this->buffer_len_ - this->sending_len_);
+  this->buffer_len_ -= this->sending_len_;
+  this->sending_len_ = 0;
+  this->retry_delay_ = 0;
+  if (this->dropped_ != 0) {
+    ESP_LOGW(TAG, "Dropped %u states while the buffer was full", this->dropped_);
+    this->dropped_ = 0;
+  }
+  this->status_clear_warning();
+}
+
+}  // namespace http_exporter
+}  // namespace esphome
+
+#endif  // USE_ARDUINO
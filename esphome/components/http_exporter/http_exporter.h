@@ -0,0 +1,113 @@
+#pragma once
+
+#ifdef USE_ARDUINO
+
+#include "esphome/components/http_request/http_request.h"
+#include "esphome/core/component.h"
+#include "esphome/core/controller.h"
+#include "esphome/core/defines.h"
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
+
+#include <list>
+#include <string>
+
+namespace esphome {
+namespace http_exporter {
+
+enum ExportFormat {
+  EXPORT_FORMAT_INFLUX,
+  EXPORT_FORMAT_JSON_LINES,
+};
+
+/** Send state changes to an HTTP server in batches, as InfluxDB line protocol or JSON lines.
+ *
+ * The states are collected in a buffer (in PSRAM if there is some). While the server can't be reached it keeps the
+ * newest states, the oldest ones are dropped to make room. A batch is posted after the flush interval or as soon as
+ * batch_size bytes are waiting, failed batches are retried with an increasing delay.
+ */
+class HttpExporter : public Component, public Controller {
+ public:
+  explicit HttpExporter(http_request::HttpRequestComponent *parent) : parent_(parent) {}
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  void set_url(const std::string &url) { this->url_ = url; }
+  void set_format(ExportFormat format) { this->format_ = format; }
+  void set_measurement(const std::string &measurement) { this->measurement_ = measurement; }
+  void add_header(const char *name, const char *value) { this->headers_.push_back({name, value}); }
+  void set_flush_interval(uint32_t flush_interval) { this->flush_interval_ = flush_interval; }
+  void set_batch_size(size_t batch_size) { this->batch_size_ = batch_size; }
+  void set_buffer_size(size_t buffer_size) { this->buffer_size_ = buffer_size; }
+  void set_include_internal(bool include_internal) { this->include_internal_ = include_internal; }
+#ifdef USE_TIME
+  /// Add the time of each state, so states buffered during an outage keep their time.
+  void set_time(time::RealTimeClock *time) { this->time_ = time; }
+#endif
+
+#ifdef USE_SENSOR
+  void on_sensor_update(sensor::Sensor *obj, float state) override;
+#endif
+#ifdef USE_BINARY_SENSOR
+  void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
+#endif
+#ifdef USE_SWITCH
+  void on_switch_update(switch_::Switch *obj, bool state) override;
+#endif
+#ifdef USE_NUMBER
+  void on_number_update(number::Number *obj, float state) override;
+#endif
+#ifdef USE_TEXT_SENSOR
+  void on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) override;
+#endif
+#ifdef USE_SELECT
+  void on_select_update(select::Select *obj, const std::string &state) override;
+#endif
+
+ protected:
+  /// Add a state, value is already formatted as a number.
+  void add_value_(EntityBase *obj, const std::string &value);
+  /// Add a state that's a string.
+  void add_string_(EntityBase *obj, const std::string &value);
+  /// Start a line with the tags of obj, each format puts the field name and value between this and end_line_().
+  std::string begin_line_(EntityBase *obj);
+  void end_line_(std::string &line);
+  void append_(const std::string &line);
+  /// Remove at least len bytes of whole lines from the start of the buffer.
+  void drop_(size_t len);
+  void flush_();
+  void on_response_(int status_code);
+
+  http_request::HttpRequestComponent *parent_;
+  std::string url_;
+  ExportFormat format_{EXPORT_FORMAT_INFLUX};
+  std::string measurement_;
+  std::list<http_request::Header> headers_;
+  uint32_t flush_interval_{10000};
+  size_t batch_size_{4000};
+  size_t buffer_size_{16000};
+  bool include_internal_{false};
+#ifdef USE_TIME
+  time::RealTimeClock *time_{nullptr};
+#endif
+  std::string device_;
+
+  uint8_t *buffer_{nullptr};
+  size_t buffer_len_{0};
+  /// Bytes at the start of the buffer that are being sent
+  size_t sending_len_{0};
+  bool sending_{false};
+  uint32_t last_attempt_{0};
+  /// Delay before the next attempt after a failed one, 0 if the last one succeeded
+  uint32_t retry_delay_{0};
+  uint32_t dropped_{0};
+};
+
+}  // namespace http_exporter
+}  // namespace esphome
+
+#endif  // USE_ARDUINO
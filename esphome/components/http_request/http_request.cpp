@@ -10,36 +10,145 @@ namespace http_request {
 
 static const char *const TAG = "http_request";
 
+#ifdef USE_ESP32
+static const uint8_t REQUEST_QUEUE_SIZE = 4;
+#endif
+
+/// Collects a response body, or discards it if response is nullptr. HTTPClient::writeToStream() takes care of the
+/// transfer encoding.
+class ResponseStream : public Stream {
+ public:
+  explicit ResponseStream(std::string *response) : response_(response) {}
+  size_t write(uint8_t data) override {
+    if (this->response_ != nullptr)
+      this->response_->push_back(static_cast<char>(data));
+    return 1;
+  }
+  size_t write(const uint8_t *data, size_t len) override {
+    if (this->response_ != nullptr)
+      this->response_->append(reinterpret_cast<const char *>(data), len);
+    return len;
+  }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  void flush() override {}
+
+ protected:
+  std::string *response_;
+};
+
+/// Scheme, host and port of a URL, requests to the same origin can reuse the connection.
+static std::string url_origin(const std::string &url) {
+  size_t start = url.find("://");
+  if (start == std::string::npos)
+    return url;
+  return url.substr(0, url.find('/', start + 3));
+}
+
+void HttpRequestComponent::setup() {
+#ifdef USE_ESP32
+  if (this->task_core_ >= 0) {
+    this->pending_queue_ = xQueueCreate(REQUEST_QUEUE_SIZE, sizeof(Request *));
+    this->done_queue_ = xQueueCreate(REQUEST_QUEUE_SIZE, sizeof(Request *));
+    if (this->pending_queue_ == nullptr || this->done_queue_ == nullptr ||
+        xTaskCreatePinnedToCore(HttpRequestComponent::worker_task_, "http_request", 8192, this, 1,
+                                &this->worker_task_handle_, this->task_core_) != pdPASS) {
+      ESP_LOGE(TAG, "Could not start the request task, sending requests from the main loop");
+      this->worker_task_handle_ = nullptr;
+    } else {
+      return;
+    }
+  }
+#endif
+  // Requests are sent right away, there's nothing to do in loop()
+  this->disable_loop();
+}
+
+void HttpRequestComponent::loop() {
+#ifdef USE_ESP32
+  Request *request;
+  while (this->done_queue_ != nullptr && xQueueReceive(this->done_queue_, &request, 0) == pdTRUE) {
+    this->finish_(request);
+    delete request;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+#endif
+}
+
 void HttpRequestComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "HTTP Request:");
   ESP_LOGCONFIG(TAG, "  Timeout: %ums", this->timeout_);
   ESP_LOGCONFIG(TAG, "  User-Agent: %s", this->useragent_);
+#ifdef USE_ESP32
+  if (this->worker_task_handle_ != nullptr)
+    ESP_LOGCONFIG(TAG, "  Running on core: %d", this->task_core_);
+#endif
 }
 
 void HttpRequestComponent::set_url(std::string url) {
   this->url_ = std::move(url);
   this->secure_ = this->url_.compare(0, 6, "https:") == 0;
-
-  if (!this->last_url_.empty() && this->url_ != this->last_url_) {
-    // Close connection if url has been changed
-    this->client_.setReuse(false);
-    this->client_.end();
-  }
-  this->client_.setReuse(true);
 }
 
-void HttpRequestComponent::send(const std::vector<HttpRequestResponseTrigger *> &response_triggers) {
+void HttpRequestComponent::send(const std::vector<HttpRequestResponseTrigger *> &response_triggers,
+                                std::function<void(int)> &&callback) {
   if (!network::is_connected()) {
-    this->client_.end();
+#ifdef USE_ESP32
+    if (this->worker_task_handle_ == nullptr)
+#endif
+      this->client_.end();
     this->status_set_warning();
     ESP_LOGW(TAG, "HTTP Request failed; Not connected to network");
+    if (callback)
+      callback(HTTPC_ERROR_NOT_CONNECTED);
     return;
   }
 
-  bool begin_status = false;
-  const String url = this->url_.c_str();
+  auto *request = new Request();  // NOLINT(cppcoreguidelines-owning-memory)
+  request->url = this->url_;
+  request->method = this->method_;
+  request->useragent = this->useragent_;
+  request->timeout = this->timeout_;
+  request->body = this->body_;
+  for (const auto &header : this->headers_)
+    request->headers.emplace_back(header.name, header.value != nullptr ? header.value : "");
+  request->response_triggers = response_triggers;
+  request->callback = std::move(callback);
+
 #ifdef USE_ESP32
-  begin_status = this->client_.begin(url);
+  if (this->worker_task_handle_ != nullptr) {
+    // The done queue is as long as the pending one, so the worker never waits for loop() to make room
+    if (uxQueueMessagesWaiting(this->done_queue_) + uxQueueMessagesWaiting(this->pending_queue_) >=
+            REQUEST_QUEUE_SIZE ||
+        xQueueSend(this->pending_queue_, &request, 0) != pdTRUE) {
+      ESP_LOGW(TAG, "HTTP Request dropped; Too many requests pending. URL: %s", request->url.c_str());
+      this->status_set_warning();
+      if (request->callback)
+        request->callback(HTTPC_ERROR_TOO_LESS_RAM);
+      delete request;  // NOLINT(cppcoreguidelines-owning-memory)
+    }
+    return;
+  }
+#endif
+
+  this->perform_(request);
+  this->finish_(request);
+  delete request;  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+void HttpRequestComponent::perform_(Request *request) {
+  std::string origin = url_origin(request->url);
+  if (origin != this->last_origin_) {
+    // Only connections to the same server can be kept alive
+    this->client_.setReuse(false);
+    this->client_.end();
+    this->last_origin_ = origin;
+  }
+  this->client_.setReuse(true);
+
+  const String url = request->url.c_str();
+#ifdef USE_ESP32
+  request->began = this->client_.begin(url);
 #endif
 #ifdef USE_ESP8266
 #if ARDUINO_VERSION_CODE >= VERSION_CODE(2, 7, 0)
@@ -50,44 +159,77 @@ void HttpRequestComponent::send(const std::vector<HttpRequestResponseTrigger *>
 #if ARDUINO_VERSION_CODE >= VERSION_CODE(2, 6, 0)
   this->client_.setRedirectLimit(3);
 #endif
-  begin_status = this->client_.begin(*this->get_wifi_client_(), url);
+  request->began = this->client_.begin(*this->get_wifi_client_(), url);
 #endif
 
-  if (!begin_status) {
+  if (!request->began) {
     this->client_.end();
-    this->status_set_warning();
-    ESP_LOGW(TAG, "HTTP Request failed at the begin phase. Please check the configuration");
     return;
   }
 
-  this->client_.setTimeout(this->timeout_);
-  if (this->useragent_ != nullptr) {
-    this->client_.setUserAgent(this->useragent_);
+  this->client_.setTimeout(request->timeout);
+  if (request->useragent != nullptr) {
+    this->client_.setUserAgent(request->useragent);
+  }
+  for (const auto &header : request->headers) {
+    this->client_.addHeader(header.first.c_str(), header.second.c_str(), false, true);
+  }
+
+  request->status_code = this->client_.sendRequest(request->method, request->body.c_str());
+  if (request->status_code > 0) {
+    // Read the whole body so the connection can be used again, but only keep it for on_response
+    ResponseStream stream(request->response_triggers.empty() ? nullptr : &request->response);
+    this->client_.writeToStream(&stream);
   }
-  for (const auto &header : this->headers_) {
-    this->client_.addHeader(header.name, header.value, false, true);
+  // Keeps the connection open if the server allows it
+  this->client_.end();
+}
+
+void HttpRequestComponent::finish_(Request *request) {
+  if (!request->began) {
+    this->status_set_warning();
+    ESP_LOGW(TAG, "HTTP Request failed at the begin phase. Please check the configuration");
+    if (request->callback)
+      request->callback(HTTPC_ERROR_CONNECTION_REFUSED);
+    return;
   }
 
-  int http_code = this->client_.sendRequest(this->method_, this->body_.c_str());
-  for (auto *trigger : response_triggers)
+  this->response_ = std::move(request->response);
+  int http_code = request->status_code;
+  for (auto *trigger : request->response_triggers)
     trigger->process(http_code);
+  if (request->callback)
+    request->callback(http_code);
 
   if (http_code < 0) {
-    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Error: %s", this->url_.c_str(),
+    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Error: %s", request->url.c_str(),
              HTTPClient::errorToString(http_code).c_str());
     this->status_set_warning();
     return;
   }
 
   if (http_code < 200 || http_code >= 300) {
-    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Code: %d", this->url_.c_str(), http_code);
+    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Code: %d", request->url.c_str(), http_code);
     this->status_set_warning();
     return;
   }
 
   this->status_clear_warning();
-  ESP_LOGD(TAG, "HTTP Request completed; URL: %s; Code: %d", this->url_.c_str(), http_code);
+  ESP_LOGD(TAG, "HTTP Request completed; URL: %s; Code: %d", request->url.c_str(), http_code);
+}
+
+#ifdef USE_ESP32
+void HttpRequestComponent::worker_task_(void *arg) {
+  auto *component = static_cast<HttpRequestComponent *>(arg);
+  Request *request;
+  while (true) {
+    if (xQueueReceive(component->pending_queue_, &request, portMAX_DELAY) != pdTRUE)
+      continue;
+    component->perform_(request);
+    xQueueSend(component->done_queue_, &request, portMAX_DELAY);
+  }
 }
+#endif
 
 #ifdef USE_ESP8266
 std::shared_ptr<WiFiClient> HttpRequestComponent::get_wifi_client_() {
@@ -97,6 +239,7 @@ std::shared_ptr<WiFiClient> HttpRequestComponent::get_wifi_client_() {
       this->wifi_client_secure_ = std::make_shared<BearSSL::WiFiClientSecure>();
       this->wifi_client_secure_->setInsecure();
       this->wifi_client_secure_->setBufferSizes(512, 512);
+      this->wifi_client_secure_->setSession(&this->tls_session_);
     }
     return this->wifi_client_secure_;
   }
@@ -110,18 +253,14 @@ std::shared_ptr<WiFiClient> HttpRequestComponent::get_wifi_client_() {
 #endif
 
 void HttpRequestComponent::close() {
-  this->last_url_ = this->url_;
+#ifdef USE_ESP32
+  // The worker task owns the client
+  if (this->worker_task_handle_ != nullptr)
+    return;
+#endif
   this->client_.end();
 }
 
-const char *HttpRequestComponent::get_string() {
-  // The static variable is here because HTTPClient::getString() returns a String on ESP32, and we need something to
-  // to keep a buffer alive.
-  static std::string str;
-  str = this->client_.getString().c_str();
-  return str.c_str();
-}
-
 }  // namespace http_request
 }  // namespace esphome
 
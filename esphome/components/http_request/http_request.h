@@ -6,13 +6,18 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
+#include <functional>
 #include <list>
 #include <map>
+#include <string>
 #include <utility>
 #include <memory>
 
 #ifdef USE_ESP32
 #include <HTTPClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
 #endif
 #ifdef USE_ESP8266
 #include <ESP8266HTTPClient.h>
@@ -31,10 +36,33 @@ struct Header {
 
 class HttpRequestResponseTrigger;
 
+/// Everything about one request, copied when it's sent so the next action can already change the component.
+struct Request {
+  std::string url;
+  const char *method;
+  const char *useragent;
+  uint16_t timeout;
+  std::string body;
+  std::list<std::pair<std::string, std::string>> headers;
+  std::vector<HttpRequestResponseTrigger *> response_triggers;
+  /// Called from loop() with the status code (or a negative HTTPClient error) once the request is done.
+  std::function<void(int)> callback;
+
+  bool began{false};
+  int status_code{0};
+  std::string response;
+};
+
 class HttpRequestComponent : public Component {
  public:
+  void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+#ifdef USE_ESP32
+  /// Run the requests in a task on this core, so loop() doesn't wait for DNS, the TLS handshake and the response.
+  void set_task_core(int8_t core) { this->task_core_ = core; }
+#endif
 
   void set_url(std::string url);
   void set_method(const char *method) { this->method_ = method; }
@@ -42,14 +70,23 @@ class HttpRequestComponent : public Component {
   void set_timeout(uint16_t timeout) { this->timeout_ = timeout; }
   void set_body(const std::string &body) { this->body_ = body; }
   void set_headers(std::list<Header> headers) { this->headers_ = std::move(headers); }
-  void send(const std::vector<HttpRequestResponseTrigger *> &response_triggers);
+  void send(const std::vector<HttpRequestResponseTrigger *> &response_triggers,
+            std::function<void(int)> &&callback = nullptr);
   void close();
-  const char *get_string();
+  /// The body of the last response, valid in on_response. It's only kept for requests with on_response triggers.
+  const char *get_string() { return this->response_.c_str(); }
 
  protected:
+  /// Run the request with client_, doesn't log or touch the component state so the worker task can use it.
+  void perform_(Request *request);
+  /// Report the result of a finished request and call its triggers.
+  void finish_(Request *request);
+
   HTTPClient client_{};
   std::string url_;
-  std::string last_url_;
+  /// Scheme, host and port of the connection that's kept alive.
+  std::string last_origin_;
+  std::string response_;
   const char *method_;
   const char *useragent_{nullptr};
   bool secure_;
@@ -60,9 +97,20 @@ class HttpRequestComponent : public Component {
   std::shared_ptr<WiFiClient> wifi_client_;
 #ifdef USE_HTTP_REQUEST_ESP8266_HTTPS
   std::shared_ptr<BearSSL::WiFiClientSecure> wifi_client_secure_;
+  /// Resumed by the next handshake with the same server
+  BearSSL::Session tls_session_;
 #endif
   std::shared_ptr<WiFiClient> get_wifi_client_();
 #endif
+#ifdef USE_ESP32
+  static void worker_task_(void *arg);
+
+  int8_t task_core_{-1};
+  TaskHandle_t worker_task_handle_{nullptr};
+  /// Requests for the worker task and the ones it has finished
+  QueueHandle_t pending_queue_{nullptr};
+  QueueHandle_t done_queue_{nullptr};
+#endif
 };
 
 template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
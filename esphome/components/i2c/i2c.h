@@ -36,6 +36,58 @@ class I2CRegister {
 inline uint16_t i2ctohs(uint16_t i2cshort) { return convert_big_endian(i2cshort); }
 inline uint16_t htoi2cs(uint16_t hostshort) { return convert_big_endian(hostshort); }
 
+/** Register reads and writes that are sent to a device in one transfer, see I2CBus::transfer().
+ *
+ * Get one with I2CDevice::batch(). The buffers have to stay valid until execute() is called.
+ */
+class I2CBatch {
+ public:
+  static const size_t MAX_OPERATIONS = 8;
+
+  I2CBatch(I2CBus *bus, uint8_t address) : bus_(bus), address_(address) {}
+
+  I2CBatch &read_register(uint8_t a_register, uint8_t *data, size_t len) {
+    return this->add_(a_register, nullptr, 0, data, len);
+  }
+  /// Read a big endian 16 bit register, like I2CDevice::read_byte_16().
+  I2CBatch &read_register_16(uint8_t a_register, uint16_t *data) {
+    if (this->count_ < MAX_OPERATIONS)
+      this->words_[this->count_] = data;
+    return this->add_(a_register, nullptr, 0, reinterpret_cast<uint8_t *>(data), 2);
+  }
+  I2CBatch &write_register(uint8_t a_register, const uint8_t *data, size_t len) {
+    return this->add_(a_register, data, len, nullptr, 0);
+  }
+
+  ErrorCode execute() {
+    if (this->count_ > MAX_OPERATIONS)
+      return ERROR_TOO_LARGE;
+    ErrorCode err = this->bus_->transfer(this->address_, this->operations_.data(), this->count_);
+    if (err != ERROR_OK)
+      return err;
+    for (size_t i = 0; i < this->count_; i++) {
+      if (this->words_[i] != nullptr)
+        *this->words_[i] = i2ctohs(*this->words_[i]);
+    }
+    return ERROR_OK;
+  }
+
+ protected:
+  I2CBatch &add_(uint8_t a_register, const uint8_t *write_data, size_t write_len, uint8_t *read_data,
+                 size_t read_len) {
+    if (this->count_ < MAX_OPERATIONS)
+      this->operations_[this->count_] = {a_register, write_data, write_len, read_data, read_len};
+    this->count_++;
+    return *this;
+  }
+
+  I2CBus *bus_;
+  uint8_t address_;
+  std::array<RegisterOperation, MAX_OPERATIONS> operations_{};
+  std::array<uint16_t *, MAX_OPERATIONS> words_{};
+  size_t count_{0};
+};
+
 class I2CDevice {
  public:
   I2CDevice() = default;
@@ -44,6 +96,8 @@ class I2CDevice {
   void set_i2c_bus(I2CBus *bus) { bus_ = bus; }
 
   I2CRegister reg(uint8_t a_register) { return {this, a_register}; }
+  /// Collect register operations to run in one transfer.
+  I2CBatch batch() { return {this->bus_, this->address_}; }
 
   ErrorCode read(uint8_t *data, size_t len) { return bus_->read(address_, data, len); }
   ErrorCode read_register(uint8_t a_register, uint8_t *data, size_t len) {
@@ -53,6 +107,11 @@ class I2CDevice {
     return this->read(data, len);
   }
 
+  /// Read len bytes from a_register without blocking, see I2CBus::transfer_async().
+  void read_register_async(uint8_t a_register, size_t len, transaction_callback_t &&callback) {
+    this->bus_->transfer_async(this->address_, &a_register, 1, len, std::move(callback));
+  }
+
   ErrorCode write(const uint8_t *data, uint8_t len) { return bus_->write(address_, data, len); }
   ErrorCode write_register(uint8_t a_register, const uint8_t *data, size_t len) {
     WriteBuffer buffers[2];
@@ -62,6 +121,14 @@ class I2CDevice {
     buffers[1].len = len;
     return bus_->writev(address_, buffers, 2);
   }
+  /// Write data to a_register without blocking, see I2CBus::transfer_async().
+  void write_register_async(uint8_t a_register, const uint8_t *data, size_t len, transaction_callback_t &&callback) {
+    std::vector<uint8_t> buffer;
+    buffer.reserve(len + 1);
+    buffer.push_back(a_register);
+    buffer.insert(buffer.end(), data, data + len);
+    this->bus_->transfer_async(this->address_, buffer.data(), buffer.size(), 0, std::move(callback));
+  }
 
   // Compat APIs
 
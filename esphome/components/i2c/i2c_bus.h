@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -26,6 +27,18 @@ struct WriteBuffer {
   size_t len;
 };
 
+/// A register write and/or read, see I2CBus::transfer().
+struct RegisterOperation {
+  uint8_t a_register;
+  const uint8_t *write_data;
+  size_t write_len;
+  uint8_t *read_data;
+  size_t read_len;
+};
+
+/// Called with the result and the data that was read once a transaction queued with transfer_async() is done.
+using transaction_callback_t = std::function<void(ErrorCode error, const uint8_t *data, size_t len)>;
+
 class I2CBus {
  public:
   virtual ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) {
@@ -42,6 +55,38 @@ class I2CBus {
     return writev(address, &buf, 1);
   }
   virtual ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt) = 0;
+  /** Run several register operations in one go.
+   *
+   * Each operation writes the register address and write_data, and then reads read_len bytes. Buses that support it
+   * put repeated starts between them instead of a stop and a new start, this default runs them one by one.
+   */
+  virtual ErrorCode transfer(uint8_t address, const RegisterOperation *ops, size_t cnt) {
+    for (size_t i = 0; i < cnt; i++) {
+      WriteBuffer buffers[2] = {{&ops[i].a_register, 1}, {ops[i].write_data, ops[i].write_len}};
+      ErrorCode err = this->writev(address, buffers, 2);
+      if (err == ERROR_OK && ops[i].read_len != 0)
+        err = this->read(address, ops[i].read_data, ops[i].read_len);
+      if (err != ERROR_OK)
+        return err;
+    }
+    return ERROR_OK;
+  }
+  /** Write write_len bytes and then read read_len bytes without blocking the caller.
+   *
+   * The write data is copied. Buses with a worker task queue the transaction and call the callback from the main
+   * loop once it's done, so components can start the transactions for all their sensors at once. This default
+   * implementation runs it right away and calls the callback before returning.
+   */
+  virtual void transfer_async(uint8_t address, const uint8_t *write_data, size_t write_len, size_t read_len,
+                              transaction_callback_t &&callback) {
+    ErrorCode err = ERROR_OK;
+    if (write_len != 0 || read_len == 0)
+      err = this->write(address, write_data, write_len);
+    std::vector<uint8_t> data(read_len);
+    if (err == ERROR_OK && read_len != 0)
+      err = this->read(address, data.data(), read_len);
+    callback(err, data.data(), err == ERROR_OK ? read_len : 0);
+  }
 
  protected:
   void i2c_scan_() {
@@ -11,6 +11,11 @@ namespace i2c {
 
 static const char *const TAG = "i2c.idf";
 
+// Transactions that can be queued for the worker task before transfer_async() runs them right away
+static const size_t ASYNC_QUEUE_SIZE = 16;
+// How often the bus statistics are logged
+static const uint32_t STATS_INTERVAL = 60000;
+
 void IDFI2CBus::setup() {
   static i2c_port_t next_port = 0;
   port_ = next_port++;
@@ -38,6 +43,8 @@ void IDFI2CBus::setup() {
     return;
   }
   initialized_ = true;
+  this->stats_start_ = millis();
+  this->set_interval(STATS_INTERVAL, [this]() { this->log_stats_(); });
   if (this->scan_) {
     ESP_LOGV(TAG, "Scanning i2c bus for active devices...");
     this->i2c_scan_();
@@ -74,6 +81,157 @@ void IDFI2CBus::dump_config() {
   }
 }
 
+void IDFI2CBus::loop() {
+  if (this->done_queue_ == nullptr)
+    return;
+  Transaction *transaction;
+  while (xQueueReceive(this->done_queue_, &transaction, 0) == pdTRUE) {
+    if (transaction->callback) {
+      size_t len = transaction->error == ERROR_OK ? transaction->read_data.size() : 0;
+      transaction->callback(transaction->error, transaction->read_data.data(), len);
+    }
+    delete transaction;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+}
+
+void IDFI2CBus::transfer_async(uint8_t address, const uint8_t *write_data, size_t write_len, size_t read_len,
+                               transaction_callback_t &&callback) {
+  if (!initialized_) {
+    callback(ERROR_NOT_INITIALIZED, nullptr, 0);
+    return;
+  }
+  if (this->worker_task_handle_ == nullptr) {
+    if (this->pending_queue_ == nullptr)
+      this->pending_queue_ = xQueueCreate(ASYNC_QUEUE_SIZE, sizeof(Transaction *));
+    if (this->done_queue_ == nullptr)
+      this->done_queue_ = xQueueCreate(ASYNC_QUEUE_SIZE, sizeof(Transaction *));
+    if (this->pending_queue_ == nullptr || this->done_queue_ == nullptr ||
+        xTaskCreate(IDFI2CBus::worker_task_, "i2c_worker", 2048, this, uxTaskPriorityGet(nullptr),
+                    &this->worker_task_handle_) != pdPASS) {
+      ESP_LOGE(TAG, "Could not start the I2C worker task");
+      this->worker_task_handle_ = nullptr;
+      I2CBus::transfer_async(address, write_data, write_len, read_len, std::move(callback));
+      return;
+    }
+  }
+  auto *transaction = new Transaction();  // NOLINT(cppcoreguidelines-owning-memory)
+  transaction->address = address;
+  transaction->write_data.assign(write_data, write_data + write_len);
+  transaction->read_data.resize(read_len);
+  transaction->callback = std::move(callback);
+  // The done queue is as long as the pending one, so the worker never waits for loop() to make room
+  if (uxQueueMessagesWaiting(this->done_queue_) + uxQueueMessagesWaiting(this->pending_queue_) >= ASYNC_QUEUE_SIZE ||
+      xQueueSend(this->pending_queue_, &transaction, 0) != pdTRUE) {
+    ESP_LOGVV(TAG, "I2C queue is full, running the transaction right away");
+    transaction->error = this->transfer_(transaction);
+    size_t len = transaction->error == ERROR_OK ? transaction->read_data.size() : 0;
+    transaction->callback(transaction->error, transaction->read_data.data(), len);
+    delete transaction;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+}
+
+void IDFI2CBus::worker_task_(void *arg) {
+  auto *bus = reinterpret_cast<IDFI2CBus *>(arg);
+  Transaction *transaction;
+  while (true) {
+    if (xQueueReceive(bus->pending_queue_, &transaction, portMAX_DELAY) != pdTRUE)
+      continue;
+    transaction->error = bus->transfer_(transaction);
+    xQueueSend(bus->done_queue_, &transaction, portMAX_DELAY);
+  }
+}
+
+// Add a start, a write of prefix and write_data and then a repeated start and a read of read_data to cmd. The write
+// is left out if there's nothing to write but something to read.
+static esp_err_t add_transfer(i2c_cmd_handle_t cmd, uint8_t address, const uint8_t *prefix, size_t prefix_len,
+                              const uint8_t *write_data, size_t write_len, uint8_t *read_data, size_t read_len) {
+  esp_err_t err = i2c_master_start(cmd);
+  if (err == ESP_OK && (prefix_len != 0 || write_len != 0 || read_len == 0)) {
+    err = i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_WRITE, true);
+    if (err == ESP_OK && prefix_len != 0)
+      err = i2c_master_write(cmd, prefix, prefix_len, true);
+    if (err == ESP_OK && write_len != 0)
+      err = i2c_master_write(cmd, write_data, write_len, true);
+    // repeated start for the read
+    if (err == ESP_OK && read_len != 0)
+      err = i2c_master_start(cmd);
+  }
+  if (err == ESP_OK && read_len != 0) {
+    err = i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_READ, true);
+    if (err == ESP_OK)
+      err = i2c_master_read(cmd, read_data, read_len, I2C_MASTER_LAST_NACK);
+  }
+  return err;
+}
+
+ErrorCode IDFI2CBus::transfer_(Transaction *transaction) {
+  auto &read_data = transaction->read_data;
+  auto &write_data = transaction->write_data;
+  i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+  esp_err_t err = add_transfer(cmd, transaction->address, nullptr, 0, write_data.data(), write_data.size(),
+                               read_data.data(), read_data.size());
+  return this->finish_cmd_(cmd, err);
+}
+
+ErrorCode IDFI2CBus::transfer(uint8_t address, const RegisterOperation *ops, size_t cnt) {
+  if (!initialized_) {
+    ESP_LOGVV(TAG, "i2c bus not initialized!");
+    return ERROR_NOT_INITIALIZED;
+  }
+  i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+  esp_err_t err = ESP_OK;
+  for (size_t i = 0; i < cnt && err == ESP_OK; i++) {
+    const auto &op = ops[i];
+    err = add_transfer(cmd, address, &op.a_register, 1, op.write_data, op.write_len, op.read_data, op.read_len);
+  }
+  return this->finish_cmd_(cmd, err);
+}
+
+ErrorCode IDFI2CBus::finish_cmd_(i2c_cmd_handle_t cmd, esp_err_t err) {
+  if (err == ESP_OK)
+    err = i2c_master_stop(cmd);
+  if (err != ESP_OK) {
+    i2c_cmd_link_delete(cmd);
+    return ERROR_UNKNOWN;
+  }
+  err = this->cmd_begin_(cmd);
+  i2c_cmd_link_delete(cmd);
+  if (err == ESP_FAIL)
+    return ERROR_NOT_ACKNOWLEDGED;
+  if (err == ESP_ERR_TIMEOUT)
+    return ERROR_TIMEOUT;
+  if (err != ESP_OK)
+    return ERROR_UNKNOWN;
+  return ERROR_OK;
+}
+
+esp_err_t IDFI2CBus::cmd_begin_(i2c_cmd_handle_t cmd) {
+  const uint32_t start = micros();
+  esp_err_t err = i2c_master_cmd_begin(port_, cmd, 20 / portTICK_PERIOD_MS);
+  this->busy_time_ += micros() - start;
+  this->transaction_count_++;
+  if (err != ESP_OK)
+    this->error_count_++;
+  return err;
+}
+
+void IDFI2CBus::log_stats_() {
+  const uint32_t now = millis();
+  uint32_t transactions = this->transaction_count_.exchange(0);
+  uint32_t errors = this->error_count_.exchange(0);
+  uint32_t busy_time = this->busy_time_.exchange(0);
+  float elapsed_us = (now - this->stats_start_) * 1000.0f;
+  this->stats_start_ = now;
+  if (transactions == 0)
+    return;
+  if (errors != 0) {
+    ESP_LOGD(TAG, "Bus %d: %.1f%% busy, %u transactions, %u errors (%.1f%%)", this->port_,
+             busy_time * 100.0f / elapsed_us, transactions, errors, errors * 100.0f / transactions);
+  } else {
+    ESP_LOGV(TAG, "Bus %d: %.1f%% busy, %u transactions", this->port_, busy_time * 100.0f / elapsed_us, transactions);
+  }
+}
+
 ErrorCode IDFI2CBus::readv(uint8_t address, ReadBuffer *buffers, size_t cnt) {
   // logging is only enabled with vv level, if warnings are shown the caller
   // should log them
@@ -111,7 +269,7 @@ ErrorCode IDFI2CBus::readv(uint8_t address, ReadBuffer *buffers, size_t cnt) {
     i2c_cmd_link_delete(cmd);
     return ERROR_UNKNOWN;
   }
-  err = i2c_master_cmd_begin(port_, cmd, 20 / portTICK_PERIOD_MS);
+  err = this->cmd_begin_(cmd);
   i2c_cmd_link_delete(cmd);
   if (err == ESP_FAIL) {
     // transfer not acked
@@ -193,7 +351,7 @@ ErrorCode IDFI2CBus::writev(uint8_t address, WriteBuffer *buffers, size_t cnt) {
     i2c_cmd_link_delete(cmd);
     return ERROR_UNKNOWN;
   }
-  err = i2c_master_cmd_begin(port_, cmd, 20 / portTICK_PERIOD_MS);
+  err = this->cmd_begin_(cmd);
   i2c_cmd_link_delete(cmd);
   if (err == ESP_FAIL) {
     // transfer not acked
@@ -4,7 +4,11 @@
 
 #include "i2c_bus.h"
 #include "esphome/core/component.h"
+#include <atomic>
 #include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
 
 namespace esphome {
 namespace i2c {
@@ -18,9 +22,15 @@ enum RecoveryCode {
 class IDFI2CBus : public I2CBus, public Component {
  public:
   void setup() override;
+  void loop() override;
   void dump_config() override;
   ErrorCode readv(uint8_t address, ReadBuffer *buffers, size_t cnt) override;
   ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt) override;
+  /// Queued to a worker task that's started on first use, the callback is called from loop().
+  void transfer_async(uint8_t address, const uint8_t *write_data, size_t write_len, size_t read_len,
+                      transaction_callback_t &&callback) override;
+  /// All operations in one command link, with repeated starts in between.
+  ErrorCode transfer(uint8_t address, const RegisterOperation *ops, size_t cnt) override;
   float get_setup_priority() const override { return setup_priority::BUS; }
 
   void set_scan(bool scan) { scan_ = scan; }
@@ -35,6 +45,32 @@ class IDFI2CBus : public I2CBus, public Component {
   RecoveryCode recovery_result_;
 
  protected:
+  struct Transaction {
+    uint8_t address;
+    std::vector<uint8_t> write_data;
+    std::vector<uint8_t> read_data;
+    ErrorCode error;
+    transaction_callback_t callback;
+  };
+  static void worker_task_(void *arg);
+  /// Run a transaction with a repeated start between writing and reading, doesn't log so the worker can use it.
+  ErrorCode transfer_(Transaction *transaction);
+  /// Add the stop to a command link, run it and delete it. err is the result of building the link.
+  ErrorCode finish_cmd_(i2c_cmd_handle_t cmd, esp_err_t err);
+  /// Run a command link and keep the bus statistics.
+  esp_err_t cmd_begin_(i2c_cmd_handle_t cmd);
+  void log_stats_();
+
+  TaskHandle_t worker_task_handle_{nullptr};
+  /// Transactions for the worker task and the ones it has finished
+  QueueHandle_t pending_queue_{nullptr};
+  QueueHandle_t done_queue_{nullptr};
+  /// Bus statistics since they were last logged, updated by both the main loop and the worker task
+  std::atomic<uint32_t> busy_time_{0};
+  std::atomic<uint32_t> transaction_count_{0};
+  std::atomic<uint32_t> error_count_{0};
+  uint32_t stats_start_{0};
+
   i2c_port_t port_;
   uint8_t sda_pin_;
   bool sda_pullup_enabled_;
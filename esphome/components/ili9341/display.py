@@ -14,6 +14,8 @@ from esphome.const import (
 DEPENDENCIES = ["spi"]
 
 CONF_LED_PIN = "led_pin"
+CONF_COLOR_DEPTH = "color_depth"
+CONF_STRIP_HEIGHT = "strip_height"
 
 ili9341_ns = cg.esphome_ns.namespace("ili9341")
 ili9341 = ili9341_ns.class_(
@@ -39,6 +41,10 @@ CONFIG_SCHEMA = cv.All(
             cv.Required(CONF_DC_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_RESET_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_LED_PIN): pins.gpio_output_pin_schema,
+            # 16 bits needs 150kB for the buffer, so usually PSRAM
+            cv.Optional(CONF_COLOR_DEPTH, default=8): cv.one_of(8, 16, int=True),
+            # render in strips of this many rows instead of buffering the whole screen
+            cv.Optional(CONF_STRIP_HEIGHT): cv.int_range(min=1, max=320),
         }
     )
     .extend(cv.polling_component_schema("1s"))
@@ -59,6 +65,9 @@ async def to_code(config):
     await display.register_display(var, config)
     await spi.register_spi_device(var, config)
     cg.add(var.set_model(config[CONF_MODEL]))
+    cg.add(var.set_color_depth(config[CONF_COLOR_DEPTH]))
+    if CONF_STRIP_HEIGHT in config:
+        cg.add(var.set_strip_height(config[CONF_STRIP_HEIGHT]))
     dc = await cg.gpio_pin_expression(config[CONF_DC_PIN])
     cg.add(var.set_dc_pin(dc))
 
@@ -9,8 +9,31 @@ namespace ili9341 {
 
 static const char *const TAG = "ili9341";
 
+/// RGB332 to RGB565 for all values of the 8 bit buffer, computed at compile time.
+struct RGB332Palette {
+  uint16_t colors[256];
+
+  constexpr RGB332Palette() : colors() {
+    for (int i = 0; i < 256; i++) {
+      const int r = i >> 5;
+      const int g = (i >> 2) & 0x07;
+      const int b = i & 0x03;
+      this->colors[i] = uint16_t(((r * 0x04) << 11) | ((g * 0x09) << 5) | (b * 0x0A));
+    }
+  }
+};
+static constexpr RGB332Palette RGB332_PALETTE{};
+
 void ILI9341Display::setup_pins_() {
   this->init_internal_(this->get_buffer_length_());
+  if (this->buffer_ == nullptr && this->color_depth_ == 16) {
+    ESP_LOGW(TAG, "Not enough memory for a 16 bit buffer, falling back to 8 bit");
+    this->color_depth_ = 8;
+    this->init_internal_(this->get_buffer_length_());
+  }
+  // outside of updates, only draw to the rows the strip can hold
+  if (this->strip_height_ > 0)
+    this->band_y2_ = this->get_buffer_rows_() - 1;
   this->dc_pin_->setup();  // OUTPUT
   this->dc_pin_->digital_write(false);
   if (this->reset_pin_ != nullptr) {
@@ -29,6 +52,9 @@ void ILI9341Display::setup_pins_() {
 void ILI9341Display::dump_config() {
   LOG_DISPLAY("", "ili9341", this);
   ESP_LOGCONFIG(TAG, "  Width: %d, Height: %d,  Rotation: %d", this->width_, this->height_, this->rotation_);
+  ESP_LOGCONFIG(TAG, "  Color depth: %u bit", this->color_depth_);
+  if (this->strip_height_ > 0)
+    ESP_LOGCONFIG(TAG, "  Strip height: %d rows", this->get_buffer_rows_());
   LOG_PIN("  Reset Pin: ", this->reset_pin_);
   LOG_PIN("  DC Pin: ", this->dc_pin_);
   LOG_PIN("  Busy Pin: ", this->busy_pin_);
@@ -80,49 +106,64 @@ uint8_t ILI9341Display::read_command(uint8_t command_byte, uint8_t index) {
 }
 
 void ILI9341Display::update() {
-  this->do_update_();
+  if (this->strip_height_ > 0) {
+    this->do_update_banded_(this->get_buffer_rows_(), [this](int y1, int y2) { this->display_strip_(y1, y2); });
+    return;
+  }
+  if (!this->do_update_())
+    return;
   this->display_();
 }
 
-void ILI9341Display::display_() {
-  // we will only update the changed window to the display
-  uint16_t w = this->x_high_ - this->x_low_ + 1;
-  uint16_t h = this->y_high_ - this->y_low_ + 1;
-
-  set_addr_window_(this->x_low_, this->y_low_, w, h);
+void ILI9341Display::display_strip_(int y1, int y2) {
+  const uint32_t width = this->get_width_internal();
+  this->set_addr_window_(0, y1, width, y2 - y1 + 1);
   this->start_data_();
-  uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
-  for (uint16_t row = 0; row < h; row++) {
-    uint32_t pos = start_pos + (row * width_);
-    uint32_t rem = w;
-
-    while (rem > 0) {
-      uint32_t sz = buffer_to_transfer_(pos, rem);
-      this->write_array(transfer_buffer_, 2 * sz);
-      pos += sz;
-      rem -= sz;
-    }
+  uint8_t index = 0;
+  uint32_t pos = 0;
+  uint32_t rem = width * (y2 - y1 + 1);
+  while (rem > 0) {
+    uint32_t sz = buffer_to_transfer_(pos, rem, transfer_buffer_[index]);
+    this->write_array_async(transfer_buffer_[index], 2 * sz);
+    index ^= 1;
+    pos += sz;
+    rem -= sz;
   }
   this->end_data_();
-
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
+  this->clear_dirty_regions_();
 }
 
-uint16_t ILI9341Display::convert_to_16bit_color_(uint8_t color_8bit) {
-  int r = color_8bit >> 5;
-  int g = (color_8bit >> 2) & 0x07;
-  int b = color_8bit & 0x03;
-  uint16_t color = (r * 0x04) << 11;
-  color |= (g * 0x09) << 5;
-  color |= (b * 0x0A);
-
-  return color;
+void ILI9341Display::display_() {
+  // we will only update the changed regions to the display
+  for (uint8_t i = 0; i < this->dirty_region_count_; i++) {
+    const display::DisplayRegion &region = this->dirty_regions_[i];
+    uint16_t w = region.width();
+    uint16_t h = region.height();
+
+    set_addr_window_(region.x1, region.y1, w, h);
+    this->start_data_();
+    uint32_t start_pos = ((region.y1 * this->width_) + region.x1);
+    // convert the next chunk into one transfer buffer while the other one is being sent
+    uint8_t index = 0;
+    for (uint16_t row = 0; row < h; row++) {
+      uint32_t pos = start_pos + (row * width_);
+      uint32_t rem = w;
+
+      while (rem > 0) {
+        uint32_t sz = buffer_to_transfer_(pos, rem, transfer_buffer_[index]);
+        this->write_array_async(transfer_buffer_[index], 2 * sz);
+        index ^= 1;
+        pos += sz;
+        rem -= sz;
+      }
+    }
+    this->end_data_();
+  }
+  this->clear_dirty_regions_();
 }
 
+uint16_t ILI9341Display::convert_to_16bit_color_(uint8_t color_8bit) { return RGB332_PALETTE.colors[color_8bit]; }
+
 uint8_t ILI9341Display::convert_to_8bit_color_(uint16_t color_16bit) {
   // convert 16bit color to 8 bit buffer
   uint8_t r = color_16bit >> 11;
@@ -133,61 +174,108 @@ uint8_t ILI9341Display::convert_to_8bit_color_(uint16_t color_16bit) {
 }
 
 void ILI9341Display::fill(Color color) {
-  auto color565 = display::ColorUtil::color_to_565(color);
-  memset(this->buffer_, convert_to_8bit_color_(color565), this->get_buffer_length_());
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  if (this->color_depth_ == 16) {
+    this->fill_16bit_(this->buffer_, this->get_width_internal() * this->get_buffer_rows_(), color);
+  } else {
+    auto color565 = display::ColorUtil::color_to_565(color);
+    memset(this->buffer_, convert_to_8bit_color_(color565), this->get_buffer_length_());
+  }
+  this->mark_all_dirty_();
 }
 
 void ILI9341Display::fill_internal_(Color color) {
+  uint8_t *buffer = transfer_buffer_[0];
   if (color.raw_32 == Color::BLACK.raw_32) {
-    memset(transfer_buffer_, 0, sizeof(transfer_buffer_));
+    memset(buffer, 0, sizeof(transfer_buffer_[0]));
   } else {
-    uint8_t *dst = transfer_buffer_;
+    uint8_t *dst = buffer;
     auto color565 = display::ColorUtil::color_to_565(color);
 
-    while (dst < transfer_buffer_ + sizeof(transfer_buffer_)) {
+    while (dst < buffer + sizeof(transfer_buffer_[0])) {
       *dst++ = (uint8_t)(color565 >> 8);
       *dst++ = (uint8_t) color565;
     }
   }
 
-  uint32_t rem = this->get_width_internal() * this->get_height_internal();
+  // two bytes per pixel
+  uint32_t rem = this->get_width_internal() * this->get_height_internal() * 2;
 
   this->set_addr_window_(0, 0, this->get_width_internal(), this->get_height_internal());
   this->start_data_();
 
+  // the buffer doesn't change, so it can be queued over and over
   while (rem > 0) {
-    size_t sz = rem <= sizeof(transfer_buffer_) ? rem : sizeof(transfer_buffer_);
-    this->write_array(transfer_buffer_, sz);
+    size_t sz = rem <= sizeof(transfer_buffer_[0]) ? rem : sizeof(transfer_buffer_[0]);
+    this->write_array_async(buffer, sz);
     rem -= sz;
   }
 
   this->end_data_();
 
-  memset(buffer_, 0, (this->get_width_internal()) * (this->get_height_internal()));
+  memset(buffer_, 0, this->get_buffer_length_());
 }
 
 void HOT ILI9341Display::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
     return;
 
-  // low and high watermark may speed up drawing from buffer
-  this->x_low_ = (x < this->x_low_) ? x : this->x_low_;
-  this->y_low_ = (y < this->y_low_) ? y : this->y_low_;
-  this->x_high_ = (x > this->x_high_) ? x : this->x_high_;
-  this->y_high_ = (y > this->y_high_) ? y : this->y_high_;
-
-  uint32_t pos = (y * width_) + x;
+  uint32_t pos = ((y - this->band_y1_) * width_) + x;
   auto color565 = display::ColorUtil::color_to_565(color);
+  if (this->color_depth_ == 16) {
+    buffer_[pos * 2] = color565 >> 8;
+    buffer_[pos * 2 + 1] = color565;
+    return;
+  }
   buffer_[pos] = convert_to_8bit_color_(color565);
 }
 
-// should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
-// values per bit is huge
-uint32_t ILI9341Display::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal(); }
+void HOT ILI9341Display::fill_span_internal(int x, int y, int width, Color color) {
+  if (this->color_depth_ == 16) {
+    this->fill_16bit_(this->buffer_ + (((y - this->band_y1_) * width_) + x) * 2, width, color);
+    return;
+  }
+  auto color565 = display::ColorUtil::color_to_565(color);
+  memset(this->buffer_ + ((y - this->band_y1_) * width_) + x, convert_to_8bit_color_(color565), width);
+}
+
+void HOT ILI9341Display::blit_internal(int x, int y, int width, const Color *colors) {
+  if (this->color_depth_ == 16) {
+    uint8_t *dst = this->buffer_ + (((y - this->band_y1_) * width_) + x) * 2;
+    for (int i = 0; i < width; i++) {
+      const uint16_t color565 = display::ColorUtil::color_to_565(colors[i]);
+      *dst++ = color565 >> 8;
+      *dst++ = color565;
+    }
+    return;
+  }
+  uint8_t *dst = this->buffer_ + ((y - this->band_y1_) * width_) + x;
+  for (int i = 0; i < width; i++)
+    dst[i] = convert_to_8bit_color_(display::ColorUtil::color_to_565(colors[i]));
+}
+
+void ILI9341Display::fill_16bit_(uint8_t *dst, uint32_t pixels, Color color) {
+  const uint16_t color565 = display::ColorUtil::color_to_565(color);
+  const uint8_t high = color565 >> 8;
+  const uint8_t low = color565;
+  if (high == low) {
+    memset(dst, high, pixels * 2);
+    return;
+  }
+  for (uint32_t i = 0; i < pixels; i++) {
+    *dst++ = high;
+    *dst++ = low;
+  }
+}
+
+// One byte per pixel (RGB332) or two (RGB565), a full screen RGB565 buffer is 150kB and often only fits in PSRAM
+uint32_t ILI9341Display::get_buffer_length_() {
+  return this->get_width_internal() * this->get_buffer_rows_() * (this->color_depth_ / 8u);
+}
+int ILI9341Display::get_buffer_rows_() {
+  if (this->strip_height_ == 0)
+    return this->get_height_internal();
+  return std::min<int>(this->strip_height_, this->get_height_internal());
+}
 
 void ILI9341Display::start_command_() {
   this->dc_pin_->digital_write(false);
@@ -238,14 +326,19 @@ void ILI9341Display::invert_display_(bool invert) { this->command(invert ? ILI93
 int ILI9341Display::get_width_internal() { return this->width_; }
 int ILI9341Display::get_height_internal() { return this->height_; }
 
-uint32_t ILI9341Display::buffer_to_transfer_(uint32_t pos, uint32_t sz) {
-  uint8_t *src = buffer_ + pos;
-  uint8_t *dst = transfer_buffer_;
+uint32_t ILI9341Display::buffer_to_transfer_(uint32_t pos, uint32_t sz, uint8_t *dst) {
+  if (sz > sizeof(transfer_buffer_[0]) / 2) {
+    sz = sizeof(transfer_buffer_[0]) / 2;
+  }
 
-  if (sz > sizeof(transfer_buffer_) / 2) {
-    sz = sizeof(transfer_buffer_) / 2;
+  if (this->color_depth_ == 16) {
+    // already stored the way it is sent
+    memcpy(dst, buffer_ + pos * 2, sz * 2);
+    return sz;
   }
 
+  uint8_t *src = buffer_ + pos;
+
   for (uint32_t i = 0; i < sz; ++i) {
     uint16_t color = convert_to_16bit_color_(*src++);
     *dst++ = (uint8_t)(color >> 8);
@@ -24,6 +24,18 @@ class ILI9341Display : public PollingComponent,
   void set_reset_pin(GPIOPin *reset) { this->reset_pin_ = reset; }
   void set_led_pin(GPIOPin *led) { this->led_pin_ = led; }
   void set_model(ILI9341Model model) { this->model_ = model; }
+  /** Bits per pixel of the buffer.
+   *
+   * 8 stores RGB332 and converts every pixel when sending. 16 stores RGB565 as it is sent to the display, which
+   * keeps the full color depth and makes sending a plain copy, but it needs twice the memory (PSRAM).
+   */
+  void set_color_depth(uint8_t color_depth) { this->color_depth_ = color_depth; }
+  /** Only buffer this many rows and render the page once per strip of rows, 0 buffers the whole screen.
+   *
+   * The writer then runs several times per update, but the buffer needs a fraction of the memory, so the full 16 bit
+   * color depth works without PSRAM.
+   */
+  void set_strip_height(uint16_t strip_height) { this->strip_height_ = strip_height; }
 
   void command(uint8_t value);
   void data(uint8_t value);
@@ -43,6 +55,8 @@ class ILI9341Display : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_internal(int x, int y, int width, const Color *colors) override;
   void setup_pins_();
 
   void init_lcd_(const uint8_t *init_cmd);
@@ -51,16 +65,20 @@ class ILI9341Display : public PollingComponent,
   void reset_();
   void fill_internal_(Color color);
   void display_();
+  /// Send the buffered strip, which holds rows y1 to y2.
+  void display_strip_(int y1, int y2);
+  /// Number of rows the buffer holds.
+  int get_buffer_rows_();
+  /// Fill pixels of a 16 bit buffer starting at dst with color.
+  void fill_16bit_(uint8_t *dst, uint32_t pixels, Color color);
   uint16_t convert_to_16bit_color_(uint8_t color_8bit);
   uint8_t convert_to_8bit_color_(uint16_t color_16bit);
 
   ILI9341Model model_;
+  uint8_t color_depth_{8};
+  uint16_t strip_height_{0};
   int16_t width_{320};   ///< Display width as modified by current rotation
   int16_t height_{240};  ///< Display height as modified by current rotation
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
 
   uint32_t get_buffer_length_();
   int get_width_internal() override;
@@ -71,9 +89,11 @@ class ILI9341Display : public PollingComponent,
   void start_data_();
   void end_data_();
 
-  uint8_t transfer_buffer_[64];
+  /// Two buffers, so that one can be filled while the other one is being sent.
+  uint8_t transfer_buffer_[2][256];
 
-  uint32_t buffer_to_transfer_(uint32_t pos, uint32_t sz);
+  /// Copy up to sz pixels starting at pos as RGB565 into dst, returns the number of pixels copied.
+  uint32_t buffer_to_transfer_(uint32_t pos, uint32_t sz, uint8_t *dst);
 
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *led_pin_{nullptr};
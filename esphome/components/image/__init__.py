@@ -28,6 +28,63 @@ IMAGE_TYPE = {
 
 Image_ = display.display_ns.class_("Image")
 
+ImageCompression = display.display_ns.enum("ImageCompression")
+IMAGE_COMPRESSION = {
+    "NONE": ImageCompression.IMAGE_COMPRESSION_NONE,
+    "RLE": ImageCompression.IMAGE_COMPRESSION_RLE,
+}
+CONF_COMPRESSION = "compression"
+
+# Packets hold up to this many pixels, see ImageCompression in display_buffer.h
+RLE_MAX_PACKET = 128
+# Repeats shorter than this are kept in literal packets
+RLE_MIN_RUN = 3
+
+
+def validate_compression(config):
+    if config[CONF_COMPRESSION] != "NONE" and config[CONF_TYPE] == "BINARY":
+        raise cv.Invalid("Compression is only supported for GRAYSCALE and RGB24 images")
+    return config
+
+
+def rle_encode(rows):
+    """Compress rows of pixels (lists of byte tuples), prefixed with the row offset table."""
+    packets = []
+    offsets = []
+    table_size = len(rows) * 3
+    for row in rows:
+        offsets.append(table_size + len(packets))
+        x = 0
+        while x < len(row):
+            run = 1
+            while (
+                x + run < len(row) and run < RLE_MAX_PACKET and row[x + run] == row[x]
+            ):
+                run += 1
+            if run >= RLE_MIN_RUN:
+                packets.append(0x80 | (run - 1))
+                packets += row[x]
+                x += run
+                continue
+            start = x
+            while x < len(row) and x - start < RLE_MAX_PACKET:
+                if (
+                    x + RLE_MIN_RUN <= len(row)
+                    and len(set(row[x : x + RLE_MIN_RUN])) == 1
+                ):
+                    break
+                x += 1
+            packets.append(x - start - 1)
+            for pix in row[start:x]:
+                packets += pix
+    if table_size + len(packets) >= 1 << 24:
+        raise core.EsphomeError("Compressed image is too big")
+    table = []
+    for offset in offsets:
+        table += [offset & 0xFF, (offset >> 8) & 0xFF, offset >> 16]
+    return table + packets
+
+
 IMAGE_SCHEMA = cv.Schema(
     {
         cv.Required(CONF_ID): cv.declare_id(Image_),
@@ -37,11 +94,16 @@ IMAGE_SCHEMA = cv.Schema(
         cv.Optional(CONF_DITHER, default="NONE"): cv.one_of(
             "NONE", "FLOYDSTEINBERG", upper=True
         ),
+        cv.Optional(CONF_COMPRESSION, default="NONE"): cv.enum(
+            IMAGE_COMPRESSION, upper=True
+        ),
         cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
     }
 )
 
-CONFIG_SCHEMA = cv.All(font.validate_pillow_installed, IMAGE_SCHEMA)
+CONFIG_SCHEMA = cv.All(
+    font.validate_pillow_installed, IMAGE_SCHEMA, validate_compression
+)
 
 
 async def to_code(config):
@@ -99,8 +161,26 @@ async def to_code(config):
                 pos = x + y * width8
                 data[pos // 8] |= 0x80 >> (pos % 8)
 
+    if config[CONF_COMPRESSION] == "RLE":
+        pixel_size = 3 if config[CONF_TYPE] == "RGB24" else 1
+        pixels = [
+            tuple(data[pos : pos + pixel_size])
+            for pos in range(0, len(data), pixel_size)
+        ]
+        rows = [pixels[y * width : (y + 1) * width] for y in range(height)]
+        compressed = rle_encode(rows)
+        _LOGGER.debug(
+            "Image %s: %d bytes compressed to %d",
+            config[CONF_ID],
+            len(data),
+            len(compressed),
+        )
+        data = compressed
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
-    cg.new_Pvariable(
+    var = cg.new_Pvariable(
         config[CONF_ID], prog_arr, width, height, IMAGE_TYPE[config[CONF_TYPE]]
     )
+    if config[CONF_COMPRESSION] != "NONE":
+        cg.add(var.set_compression(IMAGE_COMPRESSION[config[CONF_COMPRESSION]]))
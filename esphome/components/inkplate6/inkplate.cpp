@@ -12,6 +12,9 @@ namespace inkplate6 {
 
 static const char *const TAG = "inkplate";
 
+// How long loop() writes passes with the panel powered, before it powers the panel off and returns
+static const uint32_t PASSES_BUDGET_MS = 250;
+
 void Inkplate6::setup() {
   this->initialize_();
 
@@ -47,6 +50,13 @@ void Inkplate6::initialize_() {
   if (buffer_size == 0)
     return;
 
+  // the passes of a running update would use the old buffers
+  if (this->next_pass_ < this->passes_.size()) {
+    this->passes_.clear();
+    this->next_pass_ = 0;
+    this->eink_off_();
+  }
+
   if (this->partial_buffer_ != nullptr)
     allocator.deallocate(this->partial_buffer_, buffer_size);
   if (this->partial_buffer_2_ != nullptr)
@@ -88,6 +98,12 @@ size_t Inkplate6::get_buffer_length_() {
   }
 }
 void Inkplate6::update() {
+  // the previous update is still being written to the panel, update once it's done
+  if (this->next_pass_ < this->passes_.size()) {
+    this->update_pending_ = true;
+    return;
+  }
+
   this->do_update_();
 
   if (this->full_update_every_ > 0 && this->partial_updates_ >= this->full_update_every_) {
@@ -214,98 +230,101 @@ void Inkplate6::fill(Color color) {
 }
 void Inkplate6::display() {
   ESP_LOGV(TAG, "Display called");
-  uint32_t start_time = millis();
+  this->display_start_ = millis();
+  this->passes_.clear();
+  this->next_pass_ = 0;
 
   if (this->greyscale_) {
     this->display3b_();
   } else {
     if (this->partial_updating_ && this->partial_update_()) {
-      ESP_LOGV(TAG, "Display finished (partial) (%ums)", millis() - start_time);
+      ESP_LOGV(TAG, "Display queued (partial) (%ums)", millis() - this->display_start_);
       return;
     }
     this->display1b_();
   }
-  ESP_LOGV(TAG, "Display finished (full) (%ums)", millis() - start_time);
+  ESP_LOGV(TAG, "Display queued (full) (%ums)", millis() - this->display_start_);
+}
+void Inkplate6::loop() {
+  if (this->next_pass_ >= this->passes_.size())
+    return;
+
+  // Write passes for up to PASSES_BUDGET_MS per loop, so the rest of the system keeps running during the update. The
+  // high voltage is only on while passes are written, the panel keeps its image while it's off between loops.
+  uint32_t start = millis();
+  this->eink_on_();
+  do {
+    this->passes_[this->next_pass_++]();
+  } while (this->next_pass_ < this->passes_.size() && millis() - start < PASSES_BUDGET_MS);
+  this->vscan_start_();
+  this->eink_off_();
+  if (this->next_pass_ < this->passes_.size())
+    return;
+
+  ESP_LOGV(TAG, "Display finished (%ums)", millis() - this->display_start_);
+  this->passes_.clear();
+  this->next_pass_ = 0;
+  if (this->update_pending_) {
+    this->update_pending_ = false;
+    this->update();
+  }
+}
+void Inkplate6::queue_pass_(std::function<void()> &&pass) { this->passes_.push_back(std::move(pass)); }
+void Inkplate6::queue_clean_(uint8_t c, uint8_t rep) {
+  for (uint8_t i = 0; i < rep; i++)
+    this->queue_pass_([this, c]() { this->clean_fast_(c, 1); });
 }
 void Inkplate6::display1b_() {
   ESP_LOGV(TAG, "Display1b called");
-  uint32_t start_time = millis();
 
   memcpy(this->buffer_, this->partial_buffer_, this->get_buffer_length_());
 
+  this->queue_clean_(0, 1);
+  this->queue_clean_(1, 5);
+  this->queue_clean_(2, 1);
+  this->queue_clean_(0, 5);
+  this->queue_clean_(2, 1);
+  this->queue_clean_(1, 12);
+  this->queue_clean_(2, 1);
+  this->queue_clean_(0, 11);
+
+  for (int k = 0; k < 3; k++)
+    this->queue_pass_([this]() { this->write_1b_pass_(LUTB); });
+  this->queue_pass_([this]() { this->write_1b_pass_(LUT2); });
+  this->queue_pass_([this]() { this->write_1b_discharge_pass_(); });
+
+  this->queue_pass_([this]() {
+    this->block_partial_ = false;
+    this->partial_updates_ = 0;
+  });
+}
+void Inkplate6::write_1b_pass_(const uint8_t *lut) {
   uint32_t send;
   uint8_t data;
   uint8_t buffer_value;
-  const uint8_t *buffer_ptr;
-  eink_on_();
-  clean_fast_(0, 1);
-  clean_fast_(1, 5);
-  clean_fast_(2, 1);
-  clean_fast_(0, 5);
-  clean_fast_(2, 1);
-  clean_fast_(1, 12);
-  clean_fast_(2, 1);
-  clean_fast_(0, 11);
-
   uint32_t clock = (1 << this->cl_pin_->get_pin());
-  ESP_LOGV(TAG, "Display1b start loops (%ums)", millis() - start_time);
-  for (int k = 0; k < 3; k++) {
-    buffer_ptr = &this->buffer_[this->get_buffer_length_() - 1];
-    vscan_start_();
-    for (int i = 0; i < this->get_height_internal(); i++) {
-      buffer_value = *(buffer_ptr--);
-      data = LUTB[(buffer_value >> 4) & 0x0F];
-      send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
-             (((data & 0b11100000) >> 5) << 25);
-      hscan_start_(send);
-      data = LUTB[buffer_value & 0x0F];
-      send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
-             (((data & 0b11100000) >> 5) << 25) | clock;
-      GPIO.out_w1ts = send;
-      GPIO.out_w1tc = send;
-
-      for (int j = 0, jm = (this->get_width_internal() / 8) - 1; j < jm; j++) {
-        buffer_value = *(buffer_ptr--);
-        data = LUTB[(buffer_value >> 4) & 0x0F];
-        send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
-               (((data & 0b11100000) >> 5) << 25) | clock;
-        GPIO.out_w1ts = send;
-        GPIO.out_w1tc = send;
-        data = LUTB[buffer_value & 0x0F];
-        send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
-               (((data & 0b11100000) >> 5) << 25) | clock;
-        GPIO.out_w1ts = send;
-        GPIO.out_w1tc = send;
-      }
-      GPIO.out_w1ts = send;
-      GPIO.out_w1tc = get_data_pin_mask_() | clock;
-      vscan_end_();
-    }
-    delayMicroseconds(230);
-  }
-  ESP_LOGV(TAG, "Display1b first loop x %d (%ums)", 3, millis() - start_time);
-
-  buffer_ptr = &this->buffer_[this->get_buffer_length_() - 1];
+  const uint8_t *buffer_ptr = &this->buffer_[this->get_buffer_length_() - 1];
   vscan_start_();
   for (int i = 0; i < this->get_height_internal(); i++) {
     buffer_value = *(buffer_ptr--);
-    data = LUT2[(buffer_value >> 4) & 0x0F];
+    data = lut[(buffer_value >> 4) & 0x0F];
     send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
            (((data & 0b11100000) >> 5) << 25);
     hscan_start_(send);
-    data = LUT2[buffer_value & 0x0F];
+    data = lut[buffer_value & 0x0F];
     send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
            (((data & 0b11100000) >> 5) << 25) | clock;
     GPIO.out_w1ts = send;
     GPIO.out_w1tc = send;
+
     for (int j = 0, jm = (this->get_width_internal() / 8) - 1; j < jm; j++) {
       buffer_value = *(buffer_ptr--);
-      data = LUT2[(buffer_value >> 4) & 0x0F];
+      data = lut[(buffer_value >> 4) & 0x0F];
       send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
              (((data & 0b11100000) >> 5) << 25) | clock;
       GPIO.out_w1ts = send;
       GPIO.out_w1tc = send;
-      data = LUT2[buffer_value & 0x0F];
+      data = lut[buffer_value & 0x0F];
       send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
              (((data & 0b11100000) >> 5) << 25) | clock;
       GPIO.out_w1ts = send;
@@ -316,13 +335,14 @@ void Inkplate6::display1b_() {
     vscan_end_();
   }
   delayMicroseconds(230);
-  ESP_LOGV(TAG, "Display1b second loop (%ums)", millis() - start_time);
-
+}
+void Inkplate6::write_1b_discharge_pass_() {
+  uint32_t clock = (1 << this->cl_pin_->get_pin());
   vscan_start_();
   for (int i = 0; i < this->get_height_internal(); i++) {
-    data = 0b00000000;
-    send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
-           (((data & 0b11100000) >> 5) << 25);
+    uint8_t data = 0b00000000;
+    uint32_t send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) |
+                    (((data & 0b00010000) >> 4) << 23) | (((data & 0b11100000) >> 5) << 25);
     hscan_start_(send);
     send |= clock;
     GPIO.out_w1ts = send;
@@ -338,41 +358,56 @@ void Inkplate6::display1b_() {
     vscan_end_();
   }
   delayMicroseconds(230);
-  ESP_LOGV(TAG, "Display1b third loop (%ums)", millis() - start_time);
-
-  vscan_start_();
-  eink_off_();
-  this->block_partial_ = false;
-  this->partial_updates_ = 0;
-  ESP_LOGV(TAG, "Display1b finished (%ums)", millis() - start_time);
 }
 void Inkplate6::display3b_() {
   ESP_LOGV(TAG, "Display3b called");
-  uint32_t start_time = millis();
 
-  eink_on_();
-  clean_fast_(0, 1);
-  clean_fast_(1, 12);
-  clean_fast_(2, 1);
-  clean_fast_(0, 11);
-  clean_fast_(2, 1);
-  clean_fast_(1, 12);
-  clean_fast_(2, 1);
-  clean_fast_(0, 11);
+  this->queue_clean_(0, 1);
+  this->queue_clean_(1, 12);
+  this->queue_clean_(2, 1);
+  this->queue_clean_(0, 11);
+  this->queue_clean_(2, 1);
+  this->queue_clean_(1, 12);
+  this->queue_clean_(2, 1);
+  this->queue_clean_(0, 11);
+
+  for (int k = 0; k < 8; k++)
+    this->queue_pass_([this, k]() { this->write_3b_pass_(k); });
 
+  this->queue_clean_(2, 1);
+  this->queue_clean_(3, 1);
+}
+void Inkplate6::write_3b_pass_(int k) {
   uint32_t clock = (1 << this->cl_pin_->get_pin());
-  for (int k = 0; k < 8; k++) {
-    const uint8_t *buffer_ptr = &this->buffer_[this->get_buffer_length_() - 1];
-    uint32_t send;
-    uint8_t pix1;
-    uint8_t pix2;
-    uint8_t pix3;
-    uint8_t pix4;
-    uint8_t pixel;
-    uint8_t pixel2;
+  const uint8_t *buffer_ptr = &this->buffer_[this->get_buffer_length_() - 1];
+  uint32_t send;
+  uint8_t pix1;
+  uint8_t pix2;
+  uint8_t pix3;
+  uint8_t pix4;
+  uint8_t pixel;
+  uint8_t pixel2;
 
-    vscan_start_();
-    for (int i = 0; i < this->get_height_internal(); i++) {
+  vscan_start_();
+  for (int i = 0; i < this->get_height_internal(); i++) {
+    pix1 = (*buffer_ptr--);
+    pix2 = (*buffer_ptr--);
+    pix3 = (*buffer_ptr--);
+    pix4 = (*buffer_ptr--);
+    pixel = (waveform3Bit[pix1 & 0x07][k] << 6) | (waveform3Bit[(pix1 >> 4) & 0x07][k] << 4) |
+            (waveform3Bit[pix2 & 0x07][k] << 2) | (waveform3Bit[(pix2 >> 4) & 0x07][k] << 0);
+    pixel2 = (waveform3Bit[pix3 & 0x07][k] << 6) | (waveform3Bit[(pix3 >> 4) & 0x07][k] << 4) |
+             (waveform3Bit[pix4 & 0x07][k] << 2) | (waveform3Bit[(pix4 >> 4) & 0x07][k] << 0);
+
+    send = ((pixel & 0b00000011) << 4) | (((pixel & 0b00001100) >> 2) << 18) | (((pixel & 0b00010000) >> 4) << 23) |
+           (((pixel & 0b11100000) >> 5) << 25);
+    hscan_start_(send);
+    send = ((pixel2 & 0b00000011) << 4) | (((pixel2 & 0b00001100) >> 2) << 18) |
+           (((pixel2 & 0b00010000) >> 4) << 23) | (((pixel2 & 0b11100000) >> 5) << 25) | clock;
+    GPIO.out_w1ts = send;
+    GPIO.out_w1tc = send;
+
+    for (int j = 0, jm = (this->get_width_internal() / 8) - 1; j < jm; j++) {
       pix1 = (*buffer_ptr--);
       pix2 = (*buffer_ptr--);
       pix3 = (*buffer_ptr--);
@@ -383,44 +418,20 @@ void Inkplate6::display3b_() {
                (waveform3Bit[pix4 & 0x07][k] << 2) | (waveform3Bit[(pix4 >> 4) & 0x07][k] << 0);
 
       send = ((pixel & 0b00000011) << 4) | (((pixel & 0b00001100) >> 2) << 18) | (((pixel & 0b00010000) >> 4) << 23) |
-             (((pixel & 0b11100000) >> 5) << 25);
-      hscan_start_(send);
-      send = ((pixel2 & 0b00000011) << 4) | (((pixel2 & 0b00001100) >> 2) << 18) |
-             (((pixel2 & 0b00010000) >> 4) << 23) | (((pixel2 & 0b11100000) >> 5) << 25) | clock;
+             (((pixel & 0b11100000) >> 5) << 25) | clock;
       GPIO.out_w1ts = send;
       GPIO.out_w1tc = send;
 
-      for (int j = 0, jm = (this->get_width_internal() / 8) - 1; j < jm; j++) {
-        pix1 = (*buffer_ptr--);
-        pix2 = (*buffer_ptr--);
-        pix3 = (*buffer_ptr--);
-        pix4 = (*buffer_ptr--);
-        pixel = (waveform3Bit[pix1 & 0x07][k] << 6) | (waveform3Bit[(pix1 >> 4) & 0x07][k] << 4) |
-                (waveform3Bit[pix2 & 0x07][k] << 2) | (waveform3Bit[(pix2 >> 4) & 0x07][k] << 0);
-        pixel2 = (waveform3Bit[pix3 & 0x07][k] << 6) | (waveform3Bit[(pix3 >> 4) & 0x07][k] << 4) |
-                 (waveform3Bit[pix4 & 0x07][k] << 2) | (waveform3Bit[(pix4 >> 4) & 0x07][k] << 0);
-
-        send = ((pixel & 0b00000011) << 4) | (((pixel & 0b00001100) >> 2) << 18) | (((pixel & 0b00010000) >> 4) << 23) |
-               (((pixel & 0b11100000) >> 5) << 25) | clock;
-        GPIO.out_w1ts = send;
-        GPIO.out_w1tc = send;
-
-        send = ((pixel2 & 0b00000011) << 4) | (((pixel2 & 0b00001100) >> 2) << 18) |
-               (((pixel2 & 0b00010000) >> 4) << 23) | (((pixel2 & 0b11100000) >> 5) << 25) | clock;
-        GPIO.out_w1ts = send;
-        GPIO.out_w1tc = send;
-      }
+      send = ((pixel2 & 0b00000011) << 4) | (((pixel2 & 0b00001100) >> 2) << 18) |
+             (((pixel2 & 0b00010000) >> 4) << 23) | (((pixel2 & 0b11100000) >> 5) << 25) | clock;
       GPIO.out_w1ts = send;
-      GPIO.out_w1tc = get_data_pin_mask_() | clock;
-      vscan_end_();
+      GPIO.out_w1tc = send;
     }
-    delayMicroseconds(230);
+    GPIO.out_w1ts = send;
+    GPIO.out_w1tc = get_data_pin_mask_() | clock;
+    vscan_end_();
   }
-  clean_fast_(2, 1);
-  clean_fast_(3, 1);
-  vscan_start_();
-  eink_off_();
-  ESP_LOGV(TAG, "Display3b finished (%ums)", millis() - start_time);
+  delayMicroseconds(230);
 }
 bool Inkplate6::partial_update_() {
   ESP_LOGV(TAG, "Partial update called");
@@ -433,8 +444,6 @@ bool Inkplate6::partial_update_() {
   this->partial_updates_++;
 
   uint16_t pos = this->get_buffer_length_() - 1;
-  uint32_t send;
-  uint8_t data;
   uint8_t diffw, diffb;
   uint32_t n = (this->get_buffer_length_() * 2) - 1;
 
@@ -449,38 +458,38 @@ bool Inkplate6::partial_update_() {
   }
   ESP_LOGV(TAG, "Partial update buffer built after (%ums)", millis() - start_time);
 
-  eink_on_();
+  for (int k = 0; k < 5; k++)
+    this->queue_pass_([this]() { this->write_partial_pass_(); });
+  this->queue_clean_(2, 2);
+  this->queue_clean_(3, 1);
+  this->queue_pass_([this]() {
+    memcpy(this->buffer_, this->partial_buffer_, this->get_buffer_length_());
+  });
+  return true;
+}
+void Inkplate6::write_partial_pass_() {
+  uint32_t send;
+  uint8_t data;
   uint32_t clock = (1 << this->cl_pin_->get_pin());
-  for (int k = 0; k < 5; k++) {
-    vscan_start_();
-    const uint8_t *data_ptr = &this->partial_buffer_2_[(this->get_buffer_length_() * 2) - 1];
-    for (int i = 0; i < this->get_height_internal(); i++) {
+  vscan_start_();
+  const uint8_t *data_ptr = &this->partial_buffer_2_[(this->get_buffer_length_() * 2) - 1];
+  for (int i = 0; i < this->get_height_internal(); i++) {
+    data = *(data_ptr--);
+    send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
+           (((data & 0b11100000) >> 5) << 25);
+    hscan_start_(send);
+    for (int j = 0, jm = (this->get_width_internal() / 4) - 1; j < jm; j++) {
       data = *(data_ptr--);
       send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
-             (((data & 0b11100000) >> 5) << 25);
-      hscan_start_(send);
-      for (int j = 0, jm = (this->get_width_internal() / 4) - 1; j < jm; j++) {
-        data = *(data_ptr--);
-        send = ((data & 0b00000011) << 4) | (((data & 0b00001100) >> 2) << 18) | (((data & 0b00010000) >> 4) << 23) |
-               (((data & 0b11100000) >> 5) << 25) | clock;
-        GPIO.out_w1ts = send;
-        GPIO.out_w1tc = send;
-      }
+             (((data & 0b11100000) >> 5) << 25) | clock;
       GPIO.out_w1ts = send;
-      GPIO.out_w1tc = get_data_pin_mask_() | clock;
-      vscan_end_();
+      GPIO.out_w1tc = send;
     }
-    delayMicroseconds(230);
-    ESP_LOGV(TAG, "Partial update loop k=%d (%ums)", k, millis() - start_time);
+    GPIO.out_w1ts = send;
+    GPIO.out_w1tc = get_data_pin_mask_() | clock;
+    vscan_end_();
   }
-  clean_fast_(2, 2);
-  clean_fast_(3, 1);
-  vscan_start_();
-  eink_off_();
-
-  memcpy(this->buffer_, this->partial_buffer_, this->get_buffer_length_());
-  ESP_LOGV(TAG, "Partial update finished (%ums)", millis() - start_time);
-  return true;
+  delayMicroseconds(230);
 }
 void Inkplate6::vscan_start_() {
   this->ckv_pin_->digital_write(true);
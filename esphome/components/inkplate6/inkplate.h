@@ -80,6 +80,7 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
   void fill(Color color) override;
 
   void update() override;
+  void loop() override;
 
   void setup() override;
 
@@ -90,6 +91,16 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  /// Queue a single pass over the panel, display() queues all passes of an update and loop() runs them in turn with
+  /// the panel powered.
+  void queue_pass_(std::function<void()> &&pass);
+  /// Queue rep passes of clean_fast_(c, 1).
+  void queue_clean_(uint8_t c, uint8_t rep);
+  void write_1b_pass_(const uint8_t *lut);
+  void write_1b_discharge_pass_();
+  void write_3b_pass_(int k);
+  void write_partial_pass_();
+
   void display1b_();
   void display3b_();
   void initialize_();
@@ -148,6 +159,11 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
   uint32_t full_update_every_;
   uint32_t partial_updates_{0};
 
+  std::vector<std::function<void()>> passes_;
+  size_t next_pass_{0};
+  uint32_t display_start_{0};
+  bool update_pending_{false};
+
   bool block_partial_;
   bool greyscale_;
   bool partial_updating_;
@@ -9,20 +9,21 @@ namespace integration {
 static const char *const TAG = "integration";
 
 void IntegrationSensor::setup() {
-  if (this->restore_) {
-    this->rtc_ = global_preferences->make_preference<float>(this->get_object_id_hash());
-    float preference_value = 0;
-    this->rtc_.load(&preference_value);
-    this->result_ = preference_value;
-  }
+  if (this->restore_)
+    this->integrator_.load(this->get_object_id_hash(), this->get_time_factor_());
 
-  this->last_update_ = millis();
-  this->last_save_ = this->last_update_;
+  const uint32_t now = millis();
+  this->integrator_.start(now);
+  this->last_save_ = now;
 
-  this->publish_and_save_(this->result_);
+  this->publish_and_save_();
   this->sensor_->add_on_state_callback([this](float state) { this->process_sensor_value_(state); });
 }
 void IntegrationSensor::dump_config() { LOG_SENSOR("", "Integration Sensor", this); }
+void IntegrationSensor::on_shutdown() {
+  if (this->restore_)
+    this->integrator_.save();
+}
 std::string IntegrationSensor::unit_of_measurement() {
   std::string suffix;
   switch (this->time_) {
@@ -49,26 +50,32 @@ std::string IntegrationSensor::unit_of_measurement() {
   return base + suffix;
 }
 void IntegrationSensor::process_sensor_value_(float value) {
+  // Callbacks run while the sensor publishes, so this is the time of the value.
+  this->integrator_.add(value, millis());
+  this->publish_and_save_();
+}
+void IntegrationSensor::publish_and_save_() {
+  this->publish_state(this->integrator_.get_total(this->get_time_factor_()));
+  this->save_();
+}
+void IntegrationSensor::save_() {
+  if (!this->restore_)
+    return;
   const uint32_t now = millis();
-  const double old_value = this->last_value_;
-  const double new_value = value;
-  const uint32_t dt_ms = now - this->last_update_;
-  const double dt = dt_ms * this->get_time_factor_();
-  double area = 0.0f;
-  switch (this->method_) {
-    case INTEGRATION_METHOD_TRAPEZOID:
-      area = dt * (old_value + new_value) / 2.0;
-      break;
-    case INTEGRATION_METHOD_LEFT:
-      area = dt * old_value;
-      break;
-    case INTEGRATION_METHOD_RIGHT:
-      area = dt * new_value;
-      break;
+  const uint32_t since_save = now - this->last_save_;
+  if (since_save >= this->min_save_interval_) {
+    this->last_save_ = now;
+    this->integrator_.save();
+    return;
   }
-  this->last_value_ = new_value;
-  this->last_update_ = now;
-  this->publish_and_save_(this->result_ + area);
+  // Save the latest total when the interval is over instead of dropping it.
+  if (this->save_pending_)
+    return;
+  this->save_pending_ = true;
+  this->set_timeout("save", this->min_save_interval_ - since_save, [this]() {
+    this->save_pending_ = false;
+    this->save_();
+  });
 }
 
 }  // namespace integration
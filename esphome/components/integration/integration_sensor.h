@@ -5,6 +5,7 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/hal.h"
 #include "esphome/components/sensor/sensor.h"
+#include "esphome/components/sensor/integrator.h"
 
 namespace esphome {
 namespace integration {
@@ -27,56 +28,53 @@ class IntegrationSensor : public sensor::Sensor, public Component {
  public:
   void setup() override;
   void dump_config() override;
+  void on_shutdown() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
   void set_min_save_interval(uint32_t min_interval) { this->min_save_interval_ = min_interval; }
   void set_sensor(Sensor *sensor) { sensor_ = sensor; }
   void set_time(IntegrationSensorTime time) { time_ = time; }
-  void set_method(IntegrationMethod method) { method_ = method; }
+  // The methods are in the same order as sensor::IntegratorMethod.
+  void set_method(IntegrationMethod method) {
+    this->integrator_.set_method(static_cast<sensor::IntegratorMethod>(method));
+  }
   void set_restore(bool restore) { restore_ = restore; }
-  void reset() { this->publish_and_save_(0.0f); }
+  void reset() {
+    this->integrator_.reset();
+    this->publish_and_save_();
+  }
 
  protected:
   void process_sensor_value_(float value);
-  float get_time_factor_() {
+  double get_time_factor_() {
     switch (this->time_) {
       case INTEGRATION_SENSOR_TIME_MILLISECOND:
-        return 1.0f;
+        return 1.0;
       case INTEGRATION_SENSOR_TIME_SECOND:
-        return 1.0f / 1000.0f;
+        return 1.0 / 1000.0;
       case INTEGRATION_SENSOR_TIME_MINUTE:
-        return 1.0f / 60000.0f;
+        return 1.0 / 60000.0;
       case INTEGRATION_SENSOR_TIME_HOUR:
-        return 1.0f / 3600000.0f;
+        return 1.0 / 3600000.0;
       case INTEGRATION_SENSOR_TIME_DAY:
-        return 1.0f / 86400000.0f;
+        return 1.0 / 86400000.0;
       default:
-        return 0.0f;
+        return 0.0;
     }
   }
-  void publish_and_save_(double result) {
-    this->result_ = result;
-    this->publish_state(result);
-    float result_f = result;
-    const uint32_t now = millis();
-    if (now - this->last_save_ < this->min_save_interval_)
-      return;
-    this->last_save_ = now;
-    this->rtc_.save(&result_f);
-  }
+  void publish_and_save_();
+  /// Save the total now, or once min_save_interval has passed since the last save.
+  void save_();
   std::string unit_of_measurement() override;
   int8_t accuracy_decimals() override { return this->sensor_->get_accuracy_decimals() + 2; }
 
   sensor::Sensor *sensor_;
   IntegrationSensorTime time_;
-  IntegrationMethod method_;
   bool restore_;
-  ESPPreferenceObject rtc_;
+  sensor::Integrator integrator_;
 
   uint32_t last_save_{0};
   uint32_t min_save_interval_{0};
-  uint32_t last_update_;
-  double result_{0.0f};
-  float last_value_{0.0f};
+  bool save_pending_{false};
 };
 
 template<typename... Ts> class ResetAction : public Action<Ts...> {
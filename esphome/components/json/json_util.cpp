@@ -1,62 +1,163 @@
 #include "json_util.h"
 #include "esphome/core/log.h"
 
-#ifdef USE_ESP8266
-#include <Esp.h>
-#endif
-#ifdef USE_ESP32
-#include <esp_heap_caps.h>
-#endif
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
 
 namespace esphome {
 namespace json {
 
 static const char *const TAG = "json";
 
-static std::vector<char> global_json_build_buffer;  // NOLINT
+/// Capacity the shared document starts with, it grows to fit the largest document built or parsed so far.
+static const size_t INITIAL_DOCUMENT_CAPACITY = 512;
+/// Documents larger than this are freed after use instead of being kept for the next call.
+static const size_t MAX_SHARED_DOCUMENT_CAPACITY = 4096;
+/// Heap that is always left to other allocations when a document has to grow.
+static const size_t HEAP_RESERVE = 2048;
 
-std::string build_json(const json_build_t &f) {
-  // Here we are allocating as much heap memory as available minus 2kb to be safe
-  // as we can not have a true dynamic sized document.
-  // The excess memory is freed below with `shrinkToFit()`
-#ifdef USE_ESP8266
-  const size_t free_heap = ESP.getMaxFreeBlockSize() - 2048;  // NOLINT(readability-static-accessed-through-instance)
-#elif defined(USE_ESP32)
-  const size_t free_heap = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT) - 2048;
-#endif
+/** Allocates documents through RAMPolicy::BULK. ArduinoJson doesn't pass the size when freeing, so it's stored in front
+ * of the memory of the document.
+ */
+struct DocumentAllocator {
+  static const size_t HEADER = sizeof(std::max_align_t);
+
+  void *allocate(size_t size) {
+    auto *ptr = static_cast<uint8_t *>(ram_allocate(RAMPolicy::BULK, size + HEADER));
+    if (ptr == nullptr)
+      return nullptr;
+    *reinterpret_cast<size_t *>(ptr) = size;
+    return ptr + HEADER;
+  }
+  void deallocate(void *ptr) {
+    if (ptr == nullptr)
+      return;
+    uint8_t *start = static_cast<uint8_t *>(ptr) - HEADER;
+    ram_free(RAMPolicy::BULK, start, *reinterpret_cast<size_t *>(start) + HEADER);
+  }
+  void *reallocate(void *ptr, size_t new_size) {
+    void *result = this->allocate(new_size);
+    if (result != nullptr && ptr != nullptr) {
+      size_t old_size = *reinterpret_cast<size_t *>(static_cast<uint8_t *>(ptr) - HEADER);
+      memcpy(result, ptr, std::min(old_size, new_size));
+      this->deallocate(ptr);
+    }
+    return result;
+  }
+};
+using Document = BasicJsonDocument<DocumentAllocator>;
+
+// One document shared by all calls, so building and parsing doesn't allocate once it has grown large enough. Calls
+// made while it's in use (nested, or from another task) use a temporary document instead.
+static std::unique_ptr<Document> shared_document;  // NOLINT
+static bool shared_document_in_use = false;        // NOLINT
+static Mutex shared_document_lock;                 // NOLINT
+
+static size_t max_document_capacity() {
+  const size_t largest_block = ram_policy_max_allocation(RAMPolicy::BULK);
+  return largest_block > HEAP_RESERVE + DocumentAllocator::HEADER
+             ? largest_block - HEAP_RESERVE - DocumentAllocator::HEADER
+             : 0;
+}
+
+/** Run fill on a document, starting with capacity bytes and doubling that until fill reports the document was large
+ * enough, then run use on it. Returns false if the document can't grow any further.
+ */
+template<typename Fill, typename Use> static bool with_document(size_t capacity, Fill &&fill, Use &&use) {
+  const bool shared = !shared_document_in_use && shared_document_lock.try_lock();
+  if (shared)
+    shared_document_in_use = true;
+  std::unique_ptr<Document> temporary;
+  std::unique_ptr<Document> &document = shared ? shared_document : temporary;
+
+  bool success = false;
+  bool at_limit = false;
+  while (true) {
+    if (document == nullptr || document->capacity() < capacity) {
+      // Free the old document first, so the new one can use its memory
+      document.reset();
+      const size_t max_capacity = max_document_capacity();
+      if (capacity >= max_capacity) {
+        capacity = max_capacity;
+        at_limit = true;
+      }
+      document = make_unique<Document>(capacity);
+      if (document->capacity() == 0)
+        break;
+    }
+    document->clear();
+    if (fill(*document)) {
+      use(*document);
+      success = true;
+      break;
+    }
+    if (at_limit)
+      break;
+    capacity = document->capacity() * 2;
+  }
 
-  DynamicJsonDocument json_document(free_heap);
-  JsonObject root = json_document.to<JsonObject>();
-  f(root);
-  json_document.shrinkToFit();
+  if (shared) {
+    // Don't let one unusually large document hold on to that much heap
+    if (!success || shared_document->capacity() > MAX_SHARED_DOCUMENT_CAPACITY)
+      shared_document.reset();
+    shared_document_in_use = false;
+    shared_document_lock.unlock();
+  }
+  return success;
+}
 
+std::string build_json(const json_build_t &f) {
   std::string output;
-  serializeJson(json_document, output);
+  build_json(f, output);
   return output;
 }
 
-void parse_json(const std::string &data, const json_parse_t &f) {
-  // Here we are allocating as much heap memory as available minus 2kb to be safe
-  // as we can not have a true dynamic sized document.
-  // The excess memory is freed below with `shrinkToFit()`
-#ifdef USE_ESP8266
-  const size_t free_heap = ESP.getMaxFreeBlockSize() - 2048;  // NOLINT(readability-static-accessed-through-instance)
-#elif defined(USE_ESP32)
-  const size_t free_heap = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT) - 2048;
-#endif
+/// Build the document with f and hand it to serialize, returns false if there's not enough memory.
+template<typename Serialize> static bool build_document(const json_build_t &f, Serialize &&serialize) {
+  auto fill = [&f](Document &document) {
+    f(document.to<JsonObject>());
+    return !document.overflowed();
+  };
+  if (!with_document(INITIAL_DOCUMENT_CAPACITY, fill, serialize)) {
+    ESP_LOGW(TAG, "Not enough memory to build JSON document.");
+    return false;
+  }
+  return true;
+}
 
-  DynamicJsonDocument json_document(free_heap);
-  DeserializationError err = deserializeJson(json_document, data);
-  json_document.shrinkToFit();
+bool build_json(const json_build_t &f, std::string &output) {
+  output.clear();
+  return build_document(f, [&output](Document &document) {
+    output.reserve(measureJson(document));
+    serializeJson(document, output);
+  });
+}
 
-  JsonObject root = json_document.as<JsonObject>();
+#ifdef USE_ARDUINO
+bool build_json(const json_build_t &f, Print &output) {
+  return build_document(f, [&output](Document &document) { serializeJson(document, output); });
+}
+#endif
 
-  if (err) {
-    ESP_LOGW(TAG, "Parsing JSON failed.");
-    return;
+void parse_json(const std::string &data, const json_parse_t &f) {
+  DeserializationError err;
+  auto fill = [&data, &err](Document &document) {
+    err = deserializeJson(document, data);
+    return err != DeserializationError::NoMemory;
+  };
+  auto use = [&f, &err](Document &document) {
+    if (err) {
+      ESP_LOGW(TAG, "Parsing JSON failed.");
+      return;
+    }
+    f(document.as<JsonObject>());
+  };
+  // Strings are copied into the document, so it needs at least as much room as the input
+  if (!with_document(std::max(INITIAL_DOCUMENT_CAPACITY, data.size() * 2), fill, use)) {
+    ESP_LOGW(TAG, "Not enough memory to parse JSON document.");
   }
-
-  f(root);
 }
 
 }  // namespace json
@@ -18,9 +18,20 @@ using json_parse_t = std::function<void(JsonObject)>;
 /// Callback function typedef for building JsonObjects.
 using json_build_t = std::function<void(JsonObject)>;
 
-/// Build a JSON string with the provided json build function.
+/** Build a JSON string with the provided json build function.
+ *
+ * The document is sized to what f adds to it (f may be run more than once), documents are reused between calls.
+ */
 std::string build_json(const json_build_t &f);
 
+/// Build a JSON string into output, reusing its memory. Returns false (and leaves output empty) if the heap is full.
+bool build_json(const json_build_t &f, std::string &output);
+
+#ifdef USE_ARDUINO
+/// Build a JSON document and serialize it straight into output (e.g. a response stream) without an intermediate string.
+bool build_json(const json_build_t &f, Print &output);
+#endif
+
 /// Parse a JSON string and run the provided json parse function if it's valid.
 void parse_json(const std::string &data, const json_parse_t &f);
 
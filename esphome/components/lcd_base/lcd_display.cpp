@@ -31,8 +31,12 @@ static const uint8_t LCD_DISPLAY_FUNCTION_5X10_DOTS = 0x04;
 
 void LCDDisplay::setup() {
   this->buffer_ = new uint8_t[this->rows_ * this->columns_];  // NOLINT
-  for (uint8_t i = 0; i < this->rows_ * this->columns_; i++)
+  // the clear display command below fills the DDRAM with spaces
+  this->shown_ = new uint8_t[this->rows_ * this->columns_];  // NOLINT
+  for (uint8_t i = 0; i < this->rows_ * this->columns_; i++) {
     this->buffer_[i] = ' ';
+    this->shown_[i] = ' ';
+  }
 
   uint8_t display_function = 0;
 
@@ -82,25 +86,22 @@ void LCDDisplay::setup() {
 
 float LCDDisplay::get_setup_priority() const { return setup_priority::PROCESSOR; }
 void HOT LCDDisplay::display() {
-  this->command_(LCD_DISPLAY_COMMAND_SET_DDRAM_ADDR | 0);
-
-  for (uint8_t i = 0; i < this->columns_; i++)
-    this->send(this->buffer_[i], true);
-
-  if (this->rows_ >= 3) {
-    for (uint8_t i = 0; i < this->columns_; i++)
-      this->send(this->buffer_[this->columns_ * 2 + i], true);
-  }
-
-  if (this->rows_ >= 1) {
-    this->command_(LCD_DISPLAY_COMMAND_SET_DDRAM_ADDR | 0x40);
-
-    for (uint8_t i = 0; i < this->columns_; i++)
-      this->send(this->buffer_[this->columns_ + i], true);
-
-    if (this->rows_ >= 4) {
-      for (uint8_t i = 0; i < this->columns_; i++)
-        this->send(this->buffer_[this->columns_ * 3 + i], true);
+  // Only send the characters that changed since the last call. The DDRAM address auto-increments with every
+  // character, so a new address is only needed when skipping over unchanged ones.
+  int16_t next_address = -1;
+  for (uint8_t row = 0; row < this->rows_; row++) {
+    // rows 3 and 4 continue rows 1 and 2 in DDRAM
+    uint8_t row_address = (row % 2 == 0 ? 0x00 : 0x40) + (row >= 2 ? this->columns_ : 0);
+    for (uint8_t column = 0; column < this->columns_; column++) {
+      uint16_t pos = row * this->columns_ + column;
+      if (this->shown_[pos] == this->buffer_[pos])
+        continue;
+      uint8_t address = row_address + column;
+      if (address != next_address)
+        this->command_(LCD_DISPLAY_COMMAND_SET_DDRAM_ADDR | address);
+      this->send(this->buffer_[pos], true);
+      this->shown_[pos] = this->buffer_[pos];
+      next_address = address + 1;
     }
   }
 }
@@ -22,6 +22,7 @@ class LCDDisplay : public PollingComponent {
   void setup() override;
   float get_setup_priority() const override;
   void update() override;
+  /// Send the characters that changed since the last call to the LCD.
   void display();
   //// Clear LCD display
   void clear();
@@ -58,6 +59,8 @@ class LCDDisplay : public PollingComponent {
   uint8_t columns_;
   uint8_t rows_;
   uint8_t *buffer_{nullptr};
+  /// What the LCD currently shows, to only send changes.
+  uint8_t *shown_{nullptr};
 };
 
 }  // namespace lcd_base
@@ -6,18 +6,15 @@
 #ifdef USE_ARDUINO
 #include <esp32-hal-ledc.h>
 #endif
-#ifdef USE_ESP_IDF
 #include <driver/ledc.h>
-#endif
 
 namespace esphome {
 namespace ledc {
 
 static const char *const TAG = "ledc.output";
 
-#ifdef USE_ESP_IDF
-static const int MAX_RES_BITS = LEDC_TIMER_BIT_MAX - 1;
-#if SOC_LEDC_SUPPORT_HS_MODE
+// The Arduino core uses the same channel numbering, so this is used for both frameworks
+#if SOC_LEDC_SUPPORT_HS_MODE || (defined(USE_ARDUINO) && defined(CONFIG_IDF_TARGET_ESP32))
 // Only ESP32 has LEDC_HIGH_SPEED_MODE
 inline ledc_mode_t get_speed_mode(uint8_t channel) { return channel < 8 ? LEDC_HIGH_SPEED_MODE : LEDC_LOW_SPEED_MODE; }
 #else
@@ -26,6 +23,8 @@ inline ledc_mode_t get_speed_mode(uint8_t channel) { return channel < 8 ? LEDC_H
 // https://docs.espressif.com/projects/esp-idf/en/latest/esp32c3/api-reference/peripherals/ledc.html#functionality-overview
 inline ledc_mode_t get_speed_mode(uint8_t) { return LEDC_LOW_SPEED_MODE; }
 #endif
+#ifdef USE_ESP_IDF
+static const int MAX_RES_BITS = LEDC_TIMER_BIT_MAX - 1;
 #else
 static const int MAX_RES_BITS = 20;
 #endif
@@ -50,12 +49,34 @@ optional<uint8_t> ledc_bit_depth_for_frequency(float frequency) {
   return {};
 }
 
+bool LEDCOutput::stop_fade_() {
+  if (!this->fading_)
+    return true;
+#if ESP_IDF_VERSION_MAJOR >= 5
+  ledc_fade_stop(get_speed_mode(this->channel_), static_cast<ledc_channel_t>(this->channel_ % 8));
+  this->fading_ = false;
+  return true;
+#else
+  if (millis() - this->fade_start_ < this->fade_length_)
+    return false;
+  this->fading_ = false;
+  return true;
+#endif
+}
+
 void LEDCOutput::write_state(float state) {
   if (!initialized_) {
     ESP_LOGW(TAG, "LEDC output hasn't been initialized yet!");
     return;
   }
 
+  this->cancel_timeout("fade");
+  if (!this->stop_fade_()) {
+    this->set_timeout("fade", this->fade_length_ - (millis() - this->fade_start_),
+                      [this, state]() { this->write_state(state); });
+    return;
+  }
+
   if (this->pin_->is_inverted())
     state = 1.0f - state;
 
@@ -75,6 +96,47 @@ void LEDCOutput::write_state(float state) {
 #endif
 }
 
+void LEDCOutput::write_state_fade(float state, uint32_t length) {
+  if (!initialized_) {
+    ESP_LOGW(TAG, "LEDC output hasn't been initialized yet!");
+    return;
+  }
+
+  this->cancel_timeout("fade");
+  if (!this->stop_fade_()) {
+    this->set_timeout("fade", this->fade_length_ - (millis() - this->fade_start_),
+                      [this, state, length]() { this->write_state_fade(state, length); });
+    return;
+  }
+
+  const float level = state;
+  if (this->pin_->is_inverted())
+    state = 1.0f - state;
+
+  this->duty_ = state;
+  const uint32_t max_duty = (uint32_t(1) << this->bit_depth_) - 1;
+  auto duty = static_cast<uint32_t>(roundf(state * max_duty));
+
+  // the fade service is shared by all channels, install it once
+  static bool fade_installed = false;
+  if (!fade_installed) {
+    ledc_fade_func_install(0);
+    fade_installed = true;
+  }
+
+  auto speed_mode = get_speed_mode(channel_);
+  auto chan_num = static_cast<ledc_channel_t>(channel_ % 8);
+  if (ledc_set_fade_with_time(speed_mode, chan_num, duty, length) != ESP_OK ||
+      ledc_fade_start(speed_mode, chan_num, LEDC_FADE_NO_WAIT) != ESP_OK) {
+    ESP_LOGW(TAG, "Starting fade failed, setting level directly");
+    this->write_state(level);
+    return;
+  }
+  this->fading_ = true;
+  this->fade_start_ = millis();
+  this->fade_length_ = length;
+}
+
 void LEDCOutput::setup() {
 #ifdef USE_ARDUINO
   this->update_frequency(this->frequency_);
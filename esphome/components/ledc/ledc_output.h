@@ -30,14 +30,27 @@ class LEDCOutput : public output::FloatOutput, public Component {
 
   /// Override FloatOutput's write_state.
   void write_state(float state) override;
+  /// LEDC has a hardware fade unit.
+  bool supports_fade() const override { return true; }
+  void write_state_fade(float state, uint32_t length) override;
 
  protected:
+  /** Stop a running hardware fade, which would keep changing the duty until it reaches its own target.
+   *
+   * Returns false if the fade can't be stopped (ESP-IDF before 5.0 has no ledc_fade_stop()), the duty must then only
+   * be changed once the fade is done.
+   */
+  bool stop_fade_();
+
   InternalGPIOPin *pin_;
   uint8_t channel_{};
   uint8_t bit_depth_{};
   float frequency_{};
   float duty_{0.0f};
   bool initialized_ = false;
+  bool fading_{false};
+  uint32_t fade_start_{0};
+  uint32_t fade_length_{0};
 };
 
 template<typename... Ts> class SetFrequencyAction : public Action<Ts...> {
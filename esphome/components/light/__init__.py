@@ -44,6 +44,9 @@ from .types import (  # noqa
 CODEOWNERS = ["@esphome/core"]
 IS_PLATFORM_COMPONENT = True
 
+CONF_TARGET_FPS = "target_fps"
+CONF_TRANSITION_SNAPSHOT = "transition_snapshot"
+
 LightRestoreMode = light_ns.enum("LightRestoreMode")
 RESTORE_MODES = {
     "RESTORE_DEFAULT_OFF": LightRestoreMode.LIGHT_RESTORE_DEFAULT_OFF,
@@ -112,6 +115,8 @@ ADDRESSABLE_LIGHT_SCHEMA = RGB_LIGHT_SCHEMA.extend(
             [cv.percentage], cv.Length(min=3, max=4)
         ),
         cv.Optional(CONF_POWER_SUPPLY): cv.use_id(power_supply.PowerSupply),
+        cv.Optional(CONF_TRANSITION_SNAPSHOT, default=False): cv.boolean,
+        cv.Optional(CONF_TARGET_FPS): cv.int_range(min=1, max=1000),
     }
 )
 
@@ -147,6 +152,8 @@ async def setup_light_core_(light_var, output_var, config):
         )
     if CONF_GAMMA_CORRECT in config:
         cg.add(light_var.set_gamma_correct(config[CONF_GAMMA_CORRECT]))
+    if CONF_TARGET_FPS in config:
+        cg.add(light_var.set_target_fps(config[CONF_TARGET_FPS]))
     effects = await cg.build_registry_list(
         EFFECTS_REGISTRY, config.get(CONF_EFFECTS, [])
     )
@@ -169,6 +176,9 @@ async def setup_light_core_(light_var, output_var, config):
         var_ = await cg.get_variable(config[CONF_POWER_SUPPLY])
         cg.add(output_var.set_power_supply(var_))
 
+    if config.get(CONF_TRANSITION_SNAPSHOT):
+        cg.add(output_var.set_transition_snapshot(True))
+
     if CONF_MQTT_ID in config:
         mqtt_ = cg.new_Pvariable(config[CONF_MQTT_ID], light_var)
         await mqtt.register_mqtt_component(mqtt_, config)
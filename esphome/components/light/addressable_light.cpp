@@ -1,6 +1,8 @@
 #include "addressable_light.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace light {
 
@@ -23,6 +25,56 @@ void AddressableLight::call_setup() {
 #endif
 }
 
+void HOT AddressableLight::fill_range(int32_t from, int32_t to, Color color) {
+  auto buffer = this->get_raw_buffer();
+  if (!buffer.has_value()) {
+    for (int32_t i = from; i < to; i++)
+      this->get_view_internal(i) = color;
+    return;
+  }
+  const Color corrected = this->correction_.color_correct(color);
+  uint8_t *pixel = buffer->pixels + from * buffer->bytes_per_pixel;
+  for (int32_t i = from; i < to; i++, pixel += buffer->bytes_per_pixel) {
+    pixel[buffer->red_offset] = corrected.red;
+    pixel[buffer->green_offset] = corrected.green;
+    pixel[buffer->blue_offset] = corrected.blue;
+    if (buffer->white_offset >= 0)
+      pixel[buffer->white_offset] = corrected.white;
+  }
+}
+void HOT AddressableLight::write_span(int32_t first, const Color *colors, int32_t count) {
+  auto buffer = this->get_raw_buffer();
+  if (!buffer.has_value()) {
+    for (int32_t i = 0; i < count; i++)
+      this->get_view_internal(first + i) = colors[i];
+    return;
+  }
+  uint8_t *pixel = buffer->pixels + first * buffer->bytes_per_pixel;
+  for (int32_t i = 0; i < count; i++, pixel += buffer->bytes_per_pixel) {
+    pixel[buffer->red_offset] = this->correction_.color_correct_red(colors[i].red);
+    pixel[buffer->green_offset] = this->correction_.color_correct_green(colors[i].green);
+    pixel[buffer->blue_offset] = this->correction_.color_correct_blue(colors[i].blue);
+    if (buffer->white_offset >= 0)
+      pixel[buffer->white_offset] = this->correction_.color_correct_white(colors[i].white);
+  }
+}
+void HOT AddressableLight::read_span(int32_t first, Color *colors, int32_t count) const {
+  auto buffer = this->get_raw_buffer();
+  if (!buffer.has_value()) {
+    for (int32_t i = 0; i < count; i++)
+      colors[i] = this->get_view_internal(first + i).get();
+    return;
+  }
+  const uint8_t *pixel = buffer->pixels + first * buffer->bytes_per_pixel;
+  for (int32_t i = 0; i < count; i++, pixel += buffer->bytes_per_pixel) {
+    colors[i] = Color(this->correction_.color_uncorrect_red(pixel[buffer->red_offset]),
+                      this->correction_.color_uncorrect_green(pixel[buffer->green_offset]),
+                      this->correction_.color_uncorrect_blue(pixel[buffer->blue_offset]),
+                      buffer->white_offset >= 0 ? this->correction_.color_uncorrect_white(pixel[buffer->white_offset])
+                                                : 0);
+  }
+}
+
 std::unique_ptr<LightTransformer> AddressableLight::create_default_transition() {
   return make_unique<AddressableLightTransformer>(*this);
 }
@@ -59,6 +111,33 @@ void AddressableLightTransformer::start() {
   // our transition will handle brightness, disable brightness in correction.
   this->light_.correction_.set_local_brightness(255);
   this->target_color_ *= to_uint8_scale(end_values.get_brightness() * end_values.get_state());
+
+  this->free_snapshot_();
+  if (this->light_.transition_snapshot_) {
+    const int32_t size = this->light_.size();
+    this->snapshot_ = static_cast<Color *>(ram_allocate(RAMPolicy::BULK, size * sizeof(Color)));
+    if (this->snapshot_ == nullptr) {
+      ESP_LOGW(TAG, "Cannot allocate transition snapshot for %d LEDs, falling back to approximated transition", size);
+      return;
+    }
+    this->snapshot_size_ = size;
+    this->light_.read_span(0, this->snapshot_, size);
+  }
+}
+
+AddressableLightTransformer::~AddressableLightTransformer() { this->free_snapshot_(); }
+
+void AddressableLightTransformer::free_snapshot_() {
+  if (this->snapshot_ == nullptr)
+    return;
+  ram_free(RAMPolicy::BULK, this->snapshot_, this->snapshot_size_ * sizeof(Color));
+  this->snapshot_ = nullptr;
+  this->snapshot_size_ = 0;
+}
+
+// from + (to - from) * amount / 65536, amount in [0, 65536]
+static inline uint8_t lerp_channel(uint8_t from, uint8_t to, int32_t amount) {
+  return from + (((int32_t(to) - int32_t(from)) * amount) >> 16);
 }
 
 optional<LightColorValues> AddressableLightTransformer::apply() {
@@ -73,7 +152,32 @@ optional<LightColorValues> AddressableLightTransformer::apply() {
   // Use a specialized transition for addressable lights: instead of using a unified transition for
   // all LEDs, we use the current state of each LED as the start.
 
-  // We can't use a direct lerp smoothing here though - that would require creating a copy of the original
+  // blend in chunks through the bulk pixel access
+  static const int32_t CHUNK_SIZE = 32;
+  Color chunk[CHUNK_SIZE];
+
+  if (this->snapshot_ != nullptr) {
+    // Exact lerp from the copy of each LED taken at the start of the transition.
+    const int32_t amount = static_cast<int32_t>(clamp(smoothed_progress, 0.0f, 1.0f) * 65536.0f);
+    const Color target = this->target_color_;
+    const int32_t size = std::min(this->snapshot_size_, this->light_.size());
+    for (int32_t first = 0; first < size; first += CHUNK_SIZE) {
+      const int32_t count = std::min(CHUNK_SIZE, size - first);
+      const Color *start = this->snapshot_ + first;
+      for (int32_t i = 0; i < count; i++) {
+        chunk[i] = Color(lerp_channel(start[i].red, target.red, amount),
+                         lerp_channel(start[i].green, target.green, amount),
+                         lerp_channel(start[i].blue, target.blue, amount),
+                         lerp_channel(start[i].white, target.white, amount));
+      }
+      this->light_.write_span(first, chunk, count);
+    }
+    this->last_transition_progress_ = smoothed_progress;
+    this->light_.schedule_show();
+    return {};
+  }
+
+  // Without a snapshot we can't use a direct lerp smoothing - that would require creating a copy of the original
   // state of each LED at the start of the transition.
   // Instead, we "fake" the look of the LERP by using an exponential average over time and using
   // dynamically-calculated alpha values to match the look.
@@ -99,8 +203,14 @@ optional<LightColorValues> AddressableLightTransformer::apply() {
     uint8_t inv_alpha8 = 255 - alpha8;
     Color add = this->target_color_ * alpha8;
 
-    for (auto led : this->light_)
-      led.set(add + led.get() * inv_alpha8);
+    const int32_t size = this->light_.size();
+    for (int32_t first = 0; first < size; first += CHUNK_SIZE) {
+      const int32_t count = std::min(CHUNK_SIZE, size - first);
+      this->light_.read_span(first, chunk, count);
+      for (int32_t i = 0; i < count; i++)
+        chunk[i] = add + chunk[i] * inv_alpha8;
+      this->light_.write_span(first, chunk, count);
+    }
   }
 
   this->last_transition_progress_ = smoothed_progress;
@@ -22,6 +22,61 @@ using ESPColor ESPDEPRECATED("esphome::light::ESPColor is deprecated, use esphom
 /// Convert the color information from a `LightColorValues` object to a `Color` object (does not apply brightness).
 Color color_from_light_color_values(LightColorValues val);
 
+/// Layout of the pixel buffer of an addressable light, for bulk access without going through ESPColorView.
+struct AddressableLightBuffer {
+  /// Start of the first pixel, pixels are stored back to back.
+  uint8_t *pixels;
+  uint8_t bytes_per_pixel;
+  uint8_t red_offset;
+  uint8_t green_offset;
+  uint8_t blue_offset;
+  /// Offset of the white channel, -1 if there is none.
+  int8_t white_offset;
+};
+
+/** Compile time layout of a raw pixel buffer.
+ *
+ * Outputs with a fixed layout can implement the bulk pixel access of AddressableLight with these kernels, so that
+ * the channel offsets are constants instead of being looked up for every pixel.
+ */
+template<uint8_t BYTES_PER_PIXEL, uint8_t RED, uint8_t GREEN, uint8_t BLUE, int8_t WHITE = -1>
+struct AddressablePixelFormat {
+  static AddressableLightBuffer buffer(uint8_t *pixels) {
+    return AddressableLightBuffer{pixels, BYTES_PER_PIXEL, RED, GREEN, BLUE, WHITE};
+  }
+  static void fill(uint8_t *pixels, int32_t from, int32_t to, Color color, const ESPColorCorrection &correction) {
+    const Color corrected = correction.color_correct(color);
+    for (uint8_t *pixel = pixels + from * BYTES_PER_PIXEL, *end = pixels + to * BYTES_PER_PIXEL; pixel < end;
+         pixel += BYTES_PER_PIXEL) {
+      pixel[RED] = corrected.red;
+      pixel[GREEN] = corrected.green;
+      pixel[BLUE] = corrected.blue;
+      if (WHITE >= 0)
+        pixel[WHITE] = corrected.white;
+    }
+  }
+  static void write(uint8_t *pixels, int32_t first, const Color *colors, int32_t count,
+                    const ESPColorCorrection &correction) {
+    uint8_t *pixel = pixels + first * BYTES_PER_PIXEL;
+    for (int32_t i = 0; i < count; i++, pixel += BYTES_PER_PIXEL) {
+      pixel[RED] = correction.color_correct_red(colors[i].red);
+      pixel[GREEN] = correction.color_correct_green(colors[i].green);
+      pixel[BLUE] = correction.color_correct_blue(colors[i].blue);
+      if (WHITE >= 0)
+        pixel[WHITE] = correction.color_correct_white(colors[i].white);
+    }
+  }
+  static void read(const uint8_t *pixels, int32_t first, Color *colors, int32_t count,
+                   const ESPColorCorrection &correction) {
+    const uint8_t *pixel = pixels + first * BYTES_PER_PIXEL;
+    for (int32_t i = 0; i < count; i++, pixel += BYTES_PER_PIXEL) {
+      colors[i] = Color(correction.color_uncorrect_red(pixel[RED]), correction.color_uncorrect_green(pixel[GREEN]),
+                        correction.color_uncorrect_blue(pixel[BLUE]),
+                        WHITE >= 0 ? correction.color_uncorrect_white(pixel[WHITE]) : 0);
+    }
+  }
+};
+
 /// Use a custom state class for addressable lights, to allow type system to discriminate between addressable and
 /// non-addressable lights.
 class AddressableLightState : public LightState {
@@ -42,6 +97,17 @@ class AddressableLight : public LightOutput, public Component {
   ESPRangeView all() { return ESPRangeView(this, 0, this->size()); }
   ESPRangeIterator begin() { return this->all().begin(); }
   ESPRangeIterator end() { return this->all().end(); }
+  /// Set the LEDs [from, to) to color (color correction is applied, like for ESPColorView::set()).
+  virtual void fill_range(int32_t from, int32_t to, Color color);
+  /// Set count LEDs starting at first to the given colors.
+  virtual void write_span(int32_t first, const Color *colors, int32_t count);
+  /// Read the (uncorrected) colors of count LEDs starting at first.
+  virtual void read_span(int32_t first, Color *colors, int32_t count) const;
+  /** The raw pixel buffer and its layout, if the output has one.
+   *
+   * Values in the buffer are color corrected, use fill_range()/write_span() to write uncorrected colors.
+   */
+  virtual optional<AddressableLightBuffer> get_raw_buffer() const { return {}; }
   void shift_left(int32_t amnt) {
     if (amnt < 0) {
       this->shift_right(-amnt);
@@ -63,6 +129,8 @@ class AddressableLight : public LightOutput, public Component {
   // Indicates whether an effect that directly updates the output buffer is active to prevent overwriting
   bool is_effect_active() const { return this->effect_active_; }
   void set_effect_active(bool effect_active) { this->effect_active_ = effect_active; }
+  /// Copy the LEDs at the start of a transition and lerp from that copy (exact, but uses 4 bytes of RAM per LED).
+  void set_transition_snapshot(bool transition_snapshot) { this->transition_snapshot_ = transition_snapshot; }
   std::unique_ptr<LightTransformer> create_default_transition() override;
   void set_correction(float red, float green, float blue, float white = 1.0f) {
     this->correction_.set_max_brightness(
@@ -98,6 +166,7 @@ class AddressableLight : public LightOutput, public Component {
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
 
   bool effect_active_{false};
+  bool transition_snapshot_{false};
   ESPColorCorrection correction_{};
 #ifdef USE_POWER_SUPPLY
   power_supply::PowerSupplyRequester power_;
@@ -108,13 +177,19 @@ class AddressableLight : public LightOutput, public Component {
 class AddressableLightTransformer : public LightTransitionTransformer {
  public:
   AddressableLightTransformer(AddressableLight &light) : light_(light) {}
+  ~AddressableLightTransformer() override;
 
   void start() override;
   optional<LightColorValues> apply() override;
 
  protected:
+  void free_snapshot_();
+
   AddressableLight &light_;
   Color target_color_{};
+  /// Colors of the LEDs at the start of the transition, only used with transition_snapshot.
+  Color *snapshot_{nullptr};
+  int32_t snapshot_size_{0};
   float last_transition_progress_{0.0f};
   float accumulated_alpha_{0.0f};
 };
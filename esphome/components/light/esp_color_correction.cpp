@@ -1,26 +1,107 @@
 #include "esp_color_correction.h"
 #include "light_color_values.h"
 #include "esphome/core/log.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 namespace esphome {
 namespace light {
 
-void ESPColorCorrection::calculate_gamma_table(float gamma) {
+/// The tables of all instances, each combination of inputs only once.
+static std::vector<ESPColorCorrectionTables *> &all_tables() {
+  static std::vector<ESPColorCorrectionTables *> tables;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  return tables;
+}
+
+static void calculate_tables(ESPColorCorrectionTables *tables) {
+  uint8_t gamma_table[256];
+  uint8_t gamma_reverse_table[256];
   for (uint16_t i = 0; i < 256; i++) {
-    // corrected = val ^ gamma
-    auto corrected = to_uint8_scale(gamma_correct(i / 255.0f, gamma));
-    this->gamma_table_[i] = corrected;
+    if (tables->gamma == 0.0f) {
+      // no gamma correction
+      gamma_table[i] = i;
+      gamma_reverse_table[i] = i;
+    } else {
+      // corrected = val ^ gamma, val = corrected ^ (1/gamma)
+      gamma_table[i] = to_uint8_scale(gamma_correct(i / 255.0f, tables->gamma));
+      gamma_reverse_table[i] = to_uint8_scale(powf(i / 255.0f, 1.0f / tables->gamma));
+    }
+  }
+
+  const uint8_t local_brightness = tables->local_brightness;
+  const uint8_t max_brightness[4] = {tables->max_brightness.red, tables->max_brightness.green,
+                                     tables->max_brightness.blue, tables->max_brightness.white};
+  for (uint8_t channel = 0; channel < 4; channel++) {
+    uint8_t *correct = tables->correct[channel];
+    uint8_t *uncorrect = tables->uncorrect[channel];
+    for (uint16_t i = 0; i < 256; i++) {
+      uint8_t res = esp_scale8(esp_scale8(i, max_brightness[channel]), local_brightness);
+      correct[i] = gamma_table[res];
+    }
+    if (max_brightness[channel] == 0 || local_brightness == 0) {
+      memset(uncorrect, 0, 256);
+      continue;
+    }
+    for (uint16_t i = 0; i < 256; i++) {
+      uint16_t uncorrected = gamma_reverse_table[i] * 255UL;
+      uncorrect[i] = ((uncorrected / max_brightness[channel]) * 255UL) / local_brightness;
+    }
   }
-  if (gamma == 0.0f) {
-    for (uint16_t i = 0; i < 256; i++)
-      this->gamma_reverse_table_[i] = i;
+}
+
+ESPColorCorrection::ESPColorCorrection() {
+  // no gamma correction until calculate_gamma_table() is called
+  this->select_tables_(0.0f, Color(255, 255, 255, 255), 255);
+}
+ESPColorCorrection::~ESPColorCorrection() { this->release_tables_(); }
+void ESPColorCorrection::set_max_brightness(const Color &max_brightness) {
+  this->select_tables_(this->tables_->gamma, max_brightness, this->tables_->local_brightness);
+}
+void ESPColorCorrection::set_local_brightness(uint8_t local_brightness) {
+  // called on every state update, select_tables_() returns right away if it didn't change
+  this->select_tables_(this->tables_->gamma, this->tables_->max_brightness, local_brightness);
+}
+void ESPColorCorrection::calculate_gamma_table(float gamma) {
+  this->select_tables_(gamma, this->tables_->max_brightness, this->tables_->local_brightness);
+}
+void ESPColorCorrection::select_tables_(float gamma, Color max_brightness, uint8_t local_brightness) {
+  auto &all = all_tables();
+  for (auto *tables : all) {
+    if (tables->gamma != gamma || tables->max_brightness.raw_32 != max_brightness.raw_32 ||
+        tables->local_brightness != local_brightness)
+      continue;
+    if (tables != this->tables_) {
+      tables->users++;
+      this->release_tables_();
+      this->tables_ = tables;
+    }
     return;
   }
-  for (uint16_t i = 0; i < 256; i++) {
-    // val = corrected ^ (1/gamma)
-    auto uncorrected = to_uint8_scale(powf(i / 255.0f, 1.0f / gamma));
-    this->gamma_reverse_table_[i] = uncorrected;
+
+  ESPColorCorrectionTables *tables = this->tables_;
+  if (tables == nullptr || tables->users > 1) {
+    // the current tables are still used by other instances
+    this->release_tables_();
+    tables = new ESPColorCorrectionTables();  // NOLINT(cppcoreguidelines-owning-memory)
+    tables->users = 1;
+    all.push_back(tables);
+    this->tables_ = tables;
+  }
+  tables->gamma = gamma;
+  tables->max_brightness = max_brightness;
+  tables->local_brightness = local_brightness;
+  calculate_tables(tables);
+}
+void ESPColorCorrection::release_tables_() {
+  if (this->tables_ == nullptr)
+    return;
+  if (--this->tables_->users == 0) {
+    auto &all = all_tables();
+    all.erase(std::remove(all.begin(), all.end(), this->tables_), all.end());
+    delete this->tables_;  // NOLINT(cppcoreguidelines-owning-memory)
   }
+  this->tables_ = nullptr;
 }
 
 }  // namespace light
@@ -5,72 +5,65 @@
 namespace esphome {
 namespace light {
 
+/// Lookup tables of ESPColorCorrection for one combination of gamma, max brightness and local brightness.
+struct ESPColorCorrectionTables {
+  float gamma;
+  Color max_brightness;
+  uint8_t local_brightness;
+  /// Number of ESPColorCorrection instances using these tables.
+  uint16_t users;
+  /// Combined tables in red, green, blue, white order.
+  uint8_t correct[4][256];
+  uint8_t uncorrect[4][256];
+};
+
+/** Brightness and gamma correction for addressable lights.
+ *
+ * Each channel has a lookup table that combines max brightness, local brightness and gamma (and one for the reverse
+ * direction), so correcting or uncorrecting a channel is a single table lookup. The tables are recalculated when one
+ * of the inputs changes, and they are shared by all instances with the same inputs, so lights with the same settings
+ * don't each keep 2KB of the same tables.
+ */
 class ESPColorCorrection {
  public:
-  ESPColorCorrection() : max_brightness_(255, 255, 255, 255) {}
-  void set_max_brightness(const Color &max_brightness) { this->max_brightness_ = max_brightness; }
-  void set_local_brightness(uint8_t local_brightness) { this->local_brightness_ = local_brightness; }
+  ESPColorCorrection();
+  ESPColorCorrection(const ESPColorCorrection &) = delete;
+  ESPColorCorrection &operator=(const ESPColorCorrection &) = delete;
+  ~ESPColorCorrection();
+  void set_max_brightness(const Color &max_brightness);
+  void set_local_brightness(uint8_t local_brightness);
   void calculate_gamma_table(float gamma);
   inline Color color_correct(Color color) const ALWAYS_INLINE {
     // corrected = (uncorrected * max_brightness * local_brightness) ^ gamma
     return Color(this->color_correct_red(color.red), this->color_correct_green(color.green),
                  this->color_correct_blue(color.blue), this->color_correct_white(color.white));
   }
-  inline uint8_t color_correct_red(uint8_t red) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(red, this->max_brightness_.red), this->local_brightness_);
-    return this->gamma_table_[res];
-  }
-  inline uint8_t color_correct_green(uint8_t green) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(green, this->max_brightness_.green), this->local_brightness_);
-    return this->gamma_table_[res];
-  }
-  inline uint8_t color_correct_blue(uint8_t blue) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(blue, this->max_brightness_.blue), this->local_brightness_);
-    return this->gamma_table_[res];
-  }
-  inline uint8_t color_correct_white(uint8_t white) const ALWAYS_INLINE {
-    uint8_t res = esp_scale8(esp_scale8(white, this->max_brightness_.white), this->local_brightness_);
-    return this->gamma_table_[res];
-  }
+  inline uint8_t color_correct_red(uint8_t red) const ALWAYS_INLINE { return this->tables_->correct[0][red]; }
+  inline uint8_t color_correct_green(uint8_t green) const ALWAYS_INLINE { return this->tables_->correct[1][green]; }
+  inline uint8_t color_correct_blue(uint8_t blue) const ALWAYS_INLINE { return this->tables_->correct[2][blue]; }
+  inline uint8_t color_correct_white(uint8_t white) const ALWAYS_INLINE { return this->tables_->correct[3][white]; }
   inline Color color_uncorrect(Color color) const ALWAYS_INLINE {
     // uncorrected = corrected^(1/gamma) / (max_brightness * local_brightness)
     return Color(this->color_uncorrect_red(color.red), this->color_uncorrect_green(color.green),
                  this->color_uncorrect_blue(color.blue), this->color_uncorrect_white(color.white));
   }
-  inline uint8_t color_uncorrect_red(uint8_t red) const ALWAYS_INLINE {
-    if (this->max_brightness_.red == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[red] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.red) * 255UL) / this->local_brightness_;
-    return res;
-  }
+  inline uint8_t color_uncorrect_red(uint8_t red) const ALWAYS_INLINE { return this->tables_->uncorrect[0][red]; }
   inline uint8_t color_uncorrect_green(uint8_t green) const ALWAYS_INLINE {
-    if (this->max_brightness_.green == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[green] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.green) * 255UL) / this->local_brightness_;
-    return res;
+    return this->tables_->uncorrect[1][green];
   }
   inline uint8_t color_uncorrect_blue(uint8_t blue) const ALWAYS_INLINE {
-    if (this->max_brightness_.blue == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[blue] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.blue) * 255UL) / this->local_brightness_;
-    return res;
+    return this->tables_->uncorrect[2][blue];
   }
   inline uint8_t color_uncorrect_white(uint8_t white) const ALWAYS_INLINE {
-    if (this->max_brightness_.white == 0 || this->local_brightness_ == 0)
-      return 0;
-    uint16_t uncorrected = this->gamma_reverse_table_[white] * 255UL;
-    uint8_t res = ((uncorrected / this->max_brightness_.white) * 255UL) / this->local_brightness_;
-    return res;
+    return this->tables_->uncorrect[3][white];
   }
 
  protected:
-  uint8_t gamma_table_[256];
-  uint8_t gamma_reverse_table_[256];
-  Color max_brightness_;
-  uint8_t local_brightness_{255};
+  /// Use the tables for these inputs, shared with the other instances that use them or calculated.
+  void select_tables_(float gamma, Color max_brightness, uint8_t local_brightness);
+  void release_tables_();
+
+  ESPColorCorrectionTables *tables_{nullptr};
 };
 
 }  // namespace light
@@ -106,8 +106,31 @@ void LightState::dump_config() {
   }
 }
 void LightState::loop() {
-  // Apply effect (if any)
   auto *effect = this->get_active_effect_();
+  if (effect == nullptr && this->transformer_ == nullptr && !this->next_write_) {
+    this->frame_clock_running_ = false;
+    return;
+  }
+
+  uint32_t now = micros();
+  if (this->frame_interval_ != 0 && !this->frame_clock_running_) {
+    // first frame after being idle, start the frame clock now
+    this->frame_clock_running_ = true;
+    this->next_frame_ = now + this->frame_interval_;
+  } else if (this->frame_interval_ != 0) {
+    if (static_cast<int32_t>(now - this->next_frame_) < 0)
+      return;
+    this->next_frame_ += this->frame_interval_;
+    if (static_cast<int32_t>(now - this->next_frame_) >= 0) {
+      // more than a full frame behind, drop the missed frames instead of rendering them back to back
+      uint32_t behind = now - this->next_frame_;
+      this->frame_stats_.skipped_frames += behind / this->frame_interval_ + 1;
+      this->next_frame_ = now + this->frame_interval_;
+    }
+  }
+  this->frame_stats_.frames++;
+
+  // Apply effect (if any)
   if (effect != nullptr) {
     effect->apply();
   }
@@ -131,10 +154,15 @@ void LightState::loop() {
     }
   }
 
+  uint32_t rendered = micros();
+  this->frame_stats_.render_time += rendered - now;
+
   // Write state to the light
   if (this->next_write_) {
     this->next_write_ = false;
     this->output_->write_state(this);
+    this->frame_stats_.shows++;
+    this->frame_stats_.show_time += micros() - rendered;
   }
 }
 
@@ -217,6 +245,8 @@ void LightState::start_effect_(uint32_t effect_index) {
   this->active_effect_index_ = effect_index;
   auto *effect = this->get_active_effect_();
   effect->start_internal();
+  // Flash writes stall the loop, which shows as a stutter in effects
+  global_preferences->hold_writes();
 }
 LightEffect *LightState::get_active_effect_() {
   if (this->active_effect_index_ == 0)
@@ -228,6 +258,7 @@ void LightState::stop_effect_() {
   auto *effect = this->get_active_effect_();
   if (effect != nullptr) {
     effect->stop();
+    global_preferences->release_writes();
   }
   this->active_effect_index_ = 0;
 }
@@ -24,6 +24,19 @@ enum LightRestoreMode {
   LIGHT_RESTORE_INVERTED_DEFAULT_ON,
 };
 
+/// Render and write statistics of a light, accumulated since the last reset.
+struct LightFrameStats {
+  /// Number of frames (loop iterations with an effect, transition or write).
+  uint32_t frames{0};
+  /// Number of frames dropped because the previous ones took longer than the frame interval.
+  uint32_t skipped_frames{0};
+  /// Total time spent in effects and transitions, in µs.
+  uint32_t render_time{0};
+  /// Number of writes to the output and total time spent in them, in µs.
+  uint32_t shows{0};
+  uint32_t show_time{0};
+};
+
 /** This class represents the communication layer between the front-end MQTT layer and the
  * hardware output layer.
  */
@@ -112,6 +125,16 @@ class LightState : public EntityBase, public Component {
   void set_gamma_correct(float gamma_correct);
   float get_gamma_correct() const { return this->gamma_correct_; }
 
+  /** Limit effects, transitions and writes to the given number of frames per second, 0 for no limit.
+   *
+   * Frames that would have to be rendered late because the previous ones took too long are skipped instead.
+   */
+  void set_target_fps(uint16_t target_fps) { this->frame_interval_ = target_fps == 0 ? 0 : 1000000UL / target_fps; }
+
+  /// Get the render statistics since the last call to reset_frame_stats().
+  const LightFrameStats &get_frame_stats() const { return this->frame_stats_; }
+  void reset_frame_stats() { this->frame_stats_ = LightFrameStats{}; }
+
   /// Set the restore mode of this light
   void set_restore_mode(LightRestoreMode restore_mode);
 
@@ -176,6 +199,13 @@ class LightState : public EntityBase, public Component {
   std::unique_ptr<LightTransformer> transformer_{nullptr};
   /// Whether the light value should be written in the next cycle.
   bool next_write_{true};
+  /// Time between frames in µs, 0 if not limited.
+  uint32_t frame_interval_{0};
+  /// Start of the next frame (micros()), only used when frame_interval_ is set.
+  uint32_t next_frame_{0};
+  /// Whether next_frame_ is valid, the clock is restarted when the light was idle.
+  bool frame_clock_running_{false};
+  LightFrameStats frame_stats_{};
 
   /// Object used to store the persisted values of the light.
   ESPPreferenceObject rtc_;
@@ -21,7 +21,7 @@ class LightTransformer {
   }
 
   /// Indicates whether this transformation is finished.
-  virtual bool is_finished() { return this->get_progress_() >= 1.0f; }
+  virtual bool is_finished() { return this->get_progress_fixed_() >= PROGRESS_ONE; }
 
   /// This will be called before the transition is started.
   virtual void start() {}
@@ -49,6 +49,20 @@ class LightTransformer {
     return clamp((now - this->start_time_) / float(this->length_), 0.0f, 1.0f);
   }
 
+  /// Fixed point value of a progress of 1, see get_progress_fixed_().
+  static const uint32_t PROGRESS_ONE = 1UL << 16;
+
+  /// The progress of this transition, on a scale of 0 to PROGRESS_ONE.
+  uint32_t get_progress_fixed_() {
+    uint32_t now = esphome::millis();
+    if (now < this->start_time_)
+      return 0;
+    if (now >= this->start_time_ + this->length_)
+      return PROGRESS_ONE;
+
+    return (uint64_t(now - this->start_time_) << 16) / this->length_;
+  }
+
   uint32_t start_time_;
   uint32_t length_;
   LightColorValues start_values_;
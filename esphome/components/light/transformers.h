@@ -36,30 +36,106 @@ class LightTransitionTransformer : public LightTransformer {
   }
 
   optional<LightColorValues> apply() override {
-    float p = this->get_progress_();
+    // Everything except the final conversion back to LightColorValues is done in fixed point, as this runs every loop
+    // for every transitioning light and ESP8266 has no FPU.
+    uint32_t p = this->get_progress_fixed_();
+    if (p >= PROGRESS_ONE)
+      return this->end_values_;
 
+    const uint32_t half = PROGRESS_ONE / 2;
     // Halfway through, when intermediate state (off) is reached, flip it to the target, but remain off.
-    if (this->changing_color_mode_ && p > 0.5f &&
+    if (this->changing_color_mode_ && p > half &&
         this->intermediate_values_.get_color_mode() != this->target_values_.get_color_mode()) {
       this->intermediate_values_ = this->target_values_;
       this->intermediate_values_.set_state(false);
     }
 
-    LightColorValues &start = this->changing_color_mode_ && p > 0.5f ? this->intermediate_values_ : this->start_values_;
-    LightColorValues &end = this->changing_color_mode_ && p < 0.5f ? this->intermediate_values_ : this->end_values_;
-    if (this->changing_color_mode_)
-      p = p < 0.5f ? p * 2 : (p - 0.5) * 2;
+    uint8_t segment = 0;
+    if (this->changing_color_mode_) {
+      segment = p > half ? 2 : 1;
+      p = p > half ? (p - half) * 2 : p * 2;
+    }
+    if (segment != this->segment_) {
+      LightColorValues &start = segment == 2 ? this->intermediate_values_ : this->start_values_;
+      LightColorValues &end = segment == 1 ? this->intermediate_values_ : this->end_values_;
+      this->interpolation_.set(start, end);
+      this->segment_ = segment;
+    }
 
-    float v = LightTransitionTransformer::smoothed_progress(p);
-    return LightColorValues::lerp(start, end, v);
+    return this->interpolation_.at(LightTransitionTransformer::smoothed_progress_fixed(p));
   }
 
  protected:
   // This looks crazy, but it reduces to 6x^5 - 15x^4 + 10x^3 which is just a smooth sigmoid-like
   // transition from 0 to 1 on x = [0, 1]
   static float smoothed_progress(float x) { return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f); }
+  /// Fixed point version of smoothed_progress(), x and the result are on a scale of 0 to PROGRESS_ONE.
+  static uint32_t smoothed_progress_fixed(uint32_t x) {
+    int64_t x2 = (int64_t(x) * x) >> 16;
+    int64_t x3 = (x2 * x) >> 16;
+    int64_t poly = ((x2 * 6) - (int64_t(x) * 15) + (int64_t(10) << 16));
+    return clamp<int64_t>((x3 * poly) >> 16, 0, PROGRESS_ONE);
+  }
+
+  /// Start and delta of all channels in 16-bit fixed point, for interpolating between two LightColorValues.
+  struct FixedInterpolation {
+    enum Channel { STATE, BRIGHTNESS, COLOR_BRIGHTNESS, RED, GREEN, BLUE, WHITE, COLD_WHITE, WARM_WHITE, COUNT };
+
+    void set(const LightColorValues &start, const LightColorValues &end) {
+      this->color_mode = end.get_color_mode();
+      const float start_values[COUNT] = {start.get_state(),      start.get_brightness(), start.get_color_brightness(),
+                                         start.get_red(),        start.get_green(),      start.get_blue(),
+                                         start.get_white(),      start.get_cold_white(), start.get_warm_white()};
+      const float end_values[COUNT] = {end.get_state(), end.get_brightness(), end.get_color_brightness(),
+                                       end.get_red(),   end.get_green(),      end.get_blue(),
+                                       end.get_white(), end.get_cold_white(), end.get_warm_white()};
+      for (uint8_t i = 0; i < COUNT; i++) {
+        this->start[i] = to_fixed(start_values[i]);
+        this->delta[i] = int32_t(to_fixed(end_values[i])) - this->start[i];
+      }
+      this->color_temperature_start = start.get_color_temperature();
+      this->color_temperature_delta = end.get_color_temperature() - this->color_temperature_start;
+    }
+
+    /// The values at the given completion (on a scale of 0 to PROGRESS_ONE).
+    LightColorValues at(uint32_t completion) const {
+      // 15 bit completion so that delta * completion fits in 32 bits
+      const int32_t c = std::min<uint32_t>(completion >> 1, 0x7FFF);
+      uint16_t v[COUNT];
+      for (uint8_t i = 0; i < COUNT; i++)
+        v[i] = this->start[i] + ((this->delta[i] * c) >> 15);
+
+      LightColorValues values;
+      values.set_color_mode(this->color_mode);
+      values.set_state(from_fixed(v[STATE]));
+      values.set_brightness(from_fixed(v[BRIGHTNESS]));
+      values.set_color_brightness(from_fixed(v[COLOR_BRIGHTNESS]));
+      values.set_red(from_fixed(v[RED]));
+      values.set_green(from_fixed(v[GREEN]));
+      values.set_blue(from_fixed(v[BLUE]));
+      values.set_white(from_fixed(v[WHITE]));
+      values.set_color_temperature(this->color_temperature_start +
+                                   this->color_temperature_delta * (completion / float(PROGRESS_ONE)));
+      values.set_cold_white(from_fixed(v[COLD_WHITE]));
+      values.set_warm_white(from_fixed(v[WARM_WHITE]));
+      return values;
+    }
+
+    static uint16_t to_fixed(float value) { return static_cast<uint16_t>(clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f); }
+    static float from_fixed(uint16_t value) { return value * (1.0f / 65535.0f); }
+
+    ColorMode color_mode;
+    uint16_t start[COUNT];
+    int32_t delta[COUNT];
+    float color_temperature_start;
+    float color_temperature_delta;
+  };
 
   bool changing_color_mode_{false};
+  /// Which part of the transition interpolation_ was set up for: 0 for all of it, 1/2 for the halves when changing
+  /// color mode. 0xFF if not set up yet.
+  uint8_t segment_{0xFF};
+  FixedInterpolation interpolation_{};
   LightColorValues end_values_{};
   LightColorValues intermediate_values_{};
 };
@@ -0,0 +1,41 @@
+#include "light_stats_sensor.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace light_stats {
+
+static const char *const TAG = "light_stats";
+
+void LightStatsSensor::setup() {
+  this->light_->reset_frame_stats();
+  this->last_update_ = millis();
+}
+
+void LightStatsSensor::update() {
+  const light::LightFrameStats stats = this->light_->get_frame_stats();
+  this->light_->reset_frame_stats();
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - this->last_update_;
+  this->last_update_ = now;
+
+  if (this->fps_sensor_ != nullptr && elapsed != 0)
+    this->fps_sensor_->publish_state(stats.shows * 1000.0f / elapsed);
+  if (this->render_time_sensor_ != nullptr)
+    this->render_time_sensor_->publish_state(stats.frames == 0 ? 0.0f : float(stats.render_time) / stats.frames);
+  if (this->show_time_sensor_ != nullptr)
+    this->show_time_sensor_->publish_state(stats.shows == 0 ? 0.0f : float(stats.show_time) / stats.shows);
+  if (this->skipped_frames_sensor_ != nullptr)
+    this->skipped_frames_sensor_->publish_state(stats.skipped_frames);
+}
+
+void LightStatsSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "Light Stats '%s':", this->light_->get_name().c_str());
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "FPS", this->fps_sensor_);
+  LOG_SENSOR("  ", "Render Time", this->render_time_sensor_);
+  LOG_SENSOR("  ", "Show Time", this->show_time_sensor_);
+  LOG_SENSOR("  ", "Skipped Frames", this->skipped_frames_sensor_);
+}
+
+}  // namespace light_stats
+}  // namespace esphome
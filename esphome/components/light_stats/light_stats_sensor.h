@@ -0,0 +1,36 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/light/light_state.h"
+#include "esphome/components/sensor/sensor.h"
+
+namespace esphome {
+namespace light_stats {
+
+/// Publishes the frame statistics of a light, averaged over the update interval.
+class LightStatsSensor : public PollingComponent {
+ public:
+  void set_light(light::LightState *light) { this->light_ = light; }
+  void set_fps_sensor(sensor::Sensor *fps_sensor) { this->fps_sensor_ = fps_sensor; }
+  void set_render_time_sensor(sensor::Sensor *render_time_sensor) { this->render_time_sensor_ = render_time_sensor; }
+  void set_show_time_sensor(sensor::Sensor *show_time_sensor) { this->show_time_sensor_ = show_time_sensor; }
+  void set_skipped_frames_sensor(sensor::Sensor *skipped_frames_sensor) {
+    this->skipped_frames_sensor_ = skipped_frames_sensor;
+  }
+
+  void setup() override;
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+ protected:
+  light::LightState *light_{nullptr};
+  sensor::Sensor *fps_sensor_{nullptr};
+  sensor::Sensor *render_time_sensor_{nullptr};
+  sensor::Sensor *show_time_sensor_{nullptr};
+  sensor::Sensor *skipped_frames_sensor_{nullptr};
+  uint32_t last_update_{0};
+};
+
+}  // namespace light_stats
+}  // namespace esphome
@@ -0,0 +1,65 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import light, sensor
+from esphome.const import (
+    CONF_ID,
+    CONF_LIGHT_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_HERTZ,
+)
+
+DEPENDENCIES = ["light"]
+
+CONF_FPS = "fps"
+CONF_RENDER_TIME = "render_time"
+CONF_SHOW_TIME = "show_time"
+CONF_SKIPPED_FRAMES = "skipped_frames"
+UNIT_MICROSECOND = "µs"
+
+light_stats_ns = cg.esphome_ns.namespace("light_stats")
+LightStatsSensor = light_stats_ns.class_("LightStatsSensor", cg.PollingComponent)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(LightStatsSensor),
+        cv.Required(CONF_LIGHT_ID): cv.use_id(light.LightState),
+        cv.Optional(CONF_FPS): sensor.sensor_schema(
+            unit_of_measurement=UNIT_HERTZ,
+            accuracy_decimals=1,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_RENDER_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MICROSECOND,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_SHOW_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MICROSECOND,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_SKIPPED_FRAMES): sensor.sensor_schema(
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    light_ = await cg.get_variable(config[CONF_LIGHT_ID])
+    cg.add(var.set_light(light_))
+
+    for key in [CONF_FPS, CONF_RENDER_TIME, CONF_SHOW_TIME, CONF_SKIPPED_FRAMES]:
+        if key not in config:
+            continue
+        sens = await sensor.new_sensor(config[key])
+        cg.add(getattr(var, f"set_{key}_sensor")(sens))
@@ -106,12 +106,20 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_ASYNC_BUFFER_SIZE = "async_buffer_size"
+CONF_CRASH_LOG_SIZE = "crash_log_size"
+CONF_CRASH_LOG_LEVEL = "crash_log_level"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(Logger),
             cv.Optional(CONF_BAUD_RATE, default=115200): cv.positive_int,
             cv.Optional(CONF_TX_BUFFER_SIZE, default=512): cv.validate_bytes,
+            cv.Optional(CONF_ASYNC_BUFFER_SIZE, default=0): cv.validate_bytes,
+            cv.Optional(CONF_CRASH_LOG_SIZE): cv.All(
+                cv.only_on_esp32, cv.validate_bytes, cv.int_range(min=256, max=4096)
+            ),
+            cv.Optional(CONF_CRASH_LOG_LEVEL, default="INFO"): is_log_level,
             cv.Optional(CONF_DEASSERT_RTS_DTR, default=False): cv.boolean,
             cv.Optional(CONF_HARDWARE_UART, default="UART0"): uart_selection,
             cv.Optional(CONF_LEVEL, default="DEBUG"): is_log_level,
@@ -144,6 +152,14 @@ async def to_code(config):
         HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]],
     )
     log = cg.Pvariable(config[CONF_ID], rhs)
+    if config[CONF_ASYNC_BUFFER_SIZE] > 0:
+        cg.add(log.set_async_buffer_size(config[CONF_ASYNC_BUFFER_SIZE]))
+    if CONF_CRASH_LOG_SIZE in config:
+        cg.add_define("USE_LOGGER_CRASH_LOG_SIZE", config[CONF_CRASH_LOG_SIZE])
+        cg.add(log.set_crash_log_level(LOG_LEVELS[config[CONF_CRASH_LOG_LEVEL]]))
+    if config[CONF_ASYNC_BUFFER_SIZE] > 0 or CONF_CRASH_LOG_SIZE in config:
+        # async messages are written out from loop(), the previous boot's log is shown in dump_config()
+        await cg.register_component(log, config)
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
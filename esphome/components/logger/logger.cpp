@@ -8,9 +8,14 @@
 #if defined(USE_ESP32_FRAMEWORK_ARDUINO) || defined(USE_ESP_IDF)
 #include <esp_log.h>
 #endif
+#ifdef USE_LOGGER_CRASH_LOG_SIZE
+#include <esp_attr.h>
+#endif
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace logger {
 
@@ -48,25 +53,97 @@ void Logger::write_header_(int level, const char *tag, int line) {
   this->printf_to_buffer_("%s[%s][%s:%03u]: ", color, letter, tag, line);
 }
 
+#ifdef USE_LOGGER_CRASH_LOG_SIZE
+/// Ring of the last log lines (separated by newlines), survives software resets and watchdog reboots.
+struct CrashLog {
+  uint32_t magic;
+  uint32_t head;
+  bool wrapped;
+  char data[USE_LOGGER_CRASH_LOG_SIZE];
+};
+static const uint32_t CRASH_LOG_MAGIC = 0x4C4F4721;
+static RTC_NOINIT_ATTR CrashLog crash_log;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void Logger::load_crash_log_() {
+  // RTC memory is random after a power-on, the magic (combined with the head) tells if it holds a log
+  if (crash_log.magic == (CRASH_LOG_MAGIC ^ crash_log.head) && crash_log.head < sizeof(crash_log.data)) {
+    if (crash_log.wrapped)
+      this->previous_boot_log_.assign(crash_log.data + crash_log.head, sizeof(crash_log.data) - crash_log.head);
+    this->previous_boot_log_.append(crash_log.data, crash_log.head);
+  }
+  crash_log.head = 0;
+  crash_log.wrapped = false;
+  crash_log.magic = CRASH_LOG_MAGIC;
+}
+void HOT Logger::write_crash_log_(const char *msg, size_t length) {
+  uint32_t head = crash_log.head;
+  for (size_t i = 0; i <= length; i++) {
+    crash_log.data[head++] = i < length ? msg[i] : '\n';
+    if (head == sizeof(crash_log.data)) {
+      head = 0;
+      crash_log.wrapped = true;
+    }
+  }
+  crash_log.head = head;
+  crash_log.magic = CRASH_LOG_MAGIC ^ head;
+}
+#endif
+
+bool HOT Logger::is_level_wanted_(int level) {
+#ifdef USE_LOGGER_CRASH_LOG_SIZE
+  if (level <= this->crash_log_level_)
+    return true;
+#endif
+  if (this->baud_rate_ > 0 || this->has_unfiltered_callback_)
+    return true;
+  for (auto &level_callback : this->log_level_callbacks_) {
+    if (level <= level_callback())
+      return true;
+  }
+  return false;
+}
+
+#ifdef USE_ESP32
+// Per task: whether the task is in the logger already, a log call then comes from a log callback.
+static thread_local bool in_logger = false;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#else
+static bool in_logger = false;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->max_log_level_ || (level > this->min_log_level_ && level > this->level_for(tag)) ||
+      !this->is_level_wanted_(level))
     return;
+  if (in_logger) {
+    this->recursion_dropped_++;
+    return;
+  }
 
-  recursion_guard_ = true;
-  this->reset_buffer_();
-  this->write_header_(level, tag, line);
-  this->vprintf_to_buffer_(format, args);
-  this->write_footer_();
-  this->log_message_(level, tag);
-  recursion_guard_ = false;
+  in_logger = true;
+  {
+    LockGuard guard{this->log_lock_};
+    this->reset_buffer_();
+    this->write_header_(level, tag, line);
+    this->vprintf_to_buffer_(format, args);
+    this->write_footer_();
+    this->log_message_(level, tag);
+    this->report_recursion_dropped_();
+  }
+  in_logger = false;
 }
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,
                           va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->max_log_level_ || (level > this->min_log_level_ && level > this->level_for(tag)) ||
+      !this->is_level_wanted_(level))
     return;
+  if (in_logger) {
+    this->recursion_dropped_++;
+    return;
+  }
 
-  recursion_guard_ = true;
+  in_logger = true;
+  LockGuard guard{this->log_lock_};
   this->reset_buffer_();
   // copy format string
   auto *format_pgm_p = reinterpret_cast<const uint8_t *>(format);
@@ -76,8 +153,10 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
     this->tx_buffer_[this->tx_buffer_at_++] = ch = (char) progmem_read_byte(format_pgm_p++);
   }
   // Buffer full form copying format
-  if (this->is_buffer_full_())
+  if (this->is_buffer_full_()) {
+    in_logger = false;
     return;
+  }
 
   // length of format string, includes null terminator
   uint32_t offset = this->tx_buffer_at_;
@@ -87,18 +166,44 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
   this->vprintf_to_buffer_(this->tx_buffer_, args);
   this->write_footer_();
   this->log_message_(level, tag, offset);
-  recursion_guard_ = false;
+  this->report_recursion_dropped_();
+  in_logger = false;
 }
 #endif
+void Logger::report_recursion_dropped_() {
+  if (this->recursion_dropped_.load(std::memory_order_relaxed) == 0)
+    return;
+  const uint32_t dropped = this->recursion_dropped_.exchange(0);
+  this->reset_buffer_();
+  this->write_header_(ESPHOME_LOG_LEVEL_WARN, TAG, __LINE__);
+  this->printf_to_buffer_("%u log messages dropped, they were logged from a log callback", dropped);
+  this->write_footer_();
+  this->log_message_(ESPHOME_LOG_LEVEL_WARN, TAG);
+}
 
 int HOT Logger::level_for(const char *tag) {
-  // Uses std::vector<> for low memory footprint, though the vector
-  // could be sorted to minimize lookup times. This feature isn't used that
-  // much anyway so it doesn't matter too much.
-  for (auto &it : this->log_levels_) {
-    if (it.tag == tag) {
+  if (this->log_levels_.empty())
+    return ESPHOME_LOG_LEVEL;
+  // A log call from a log callback already holds log_lock_, it skips the cache. The overrides don't change after
+  // setup, so they can always be read.
+  if (in_logger)
+    return this->find_level_(tag);
+
+  // Tag and level of an entry must change together, other tasks log at the same time
+  LockGuard guard{this->log_lock_};
+  auto &cached = this->log_level_cache_[(reinterpret_cast<uintptr_t>(tag) >> 2) % LOG_LEVEL_CACHE_SIZE];
+  if (cached.tag == tag)
+    return cached.level;
+  const int level = this->find_level_(tag);
+  cached.tag = tag;
+  cached.level = level;
+  return level;
+}
+int Logger::find_level_(const char *tag) const {
+  // Uses std::vector<> for low memory footprint, the cache in level_for() avoids the string compares for repeated tags.
+  for (const auto &it : this->log_levels_) {
+    if (it.tag == tag)
       return it.level;
-    }
   }
   return ESPHOME_LOG_LEVEL;
 }
@@ -111,6 +216,19 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   this->set_null_terminator_();
 
   const char *msg = this->tx_buffer_ + offset;
+#ifdef USE_LOGGER_CRASH_LOG_SIZE
+  // written right away (even in async mode), so the lines right before a crash are kept
+  if (level <= this->crash_log_level_ && !this->replaying_crash_log_)
+    this->write_crash_log_(msg, this->tx_buffer_at_ - offset);
+#endif
+  if (this->async_buffer_ != nullptr) {
+    if (!this->push_async_(level, tag, msg, this->tx_buffer_at_ - offset))
+      this->async_dropped_++;
+    return;
+  }
+  this->emit_message_(level, tag, msg);
+}
+void HOT Logger::emit_message_(int level, const char *tag, const char *msg) {
   if (this->baud_rate_ > 0) {
 #ifdef USE_ARDUINO
     this->hw_serial_->println(msg);
@@ -134,6 +252,100 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   this->log_callback_.call(level, tag, msg);
 }
 
+/// Header in front of every message in the async ring buffer, the message and its null terminator follow.
+struct AsyncLogHeader {
+  const char *tag;
+  uint16_t length;
+  uint8_t level;
+};
+/// Header length marking that the next message is at the start of the buffer.
+static const uint16_t ASYNC_LOG_WRAP = UINT16_MAX;
+/// Messages written out per loop(), so a burst of logs doesn't stall a single loop iteration.
+static const uint8_t ASYNC_LOG_MAX_PER_LOOP = 16;
+
+void Logger::set_async_buffer_size(size_t size) {
+  if (size == 0)
+    return;
+  this->async_buffer_ = static_cast<uint8_t *>(ram_allocate(RAMPolicy::BULK, size));
+  if (this->async_buffer_ != nullptr)
+    this->async_buffer_size_ = size;
+}
+bool HOT Logger::push_async_(int level, const char *tag, const char *msg, size_t length) {
+  const size_t size = sizeof(AsyncLogHeader) + length + 1;
+  const size_t head = this->async_head_.load(std::memory_order_relaxed);
+  const size_t tail = this->async_tail_.load(std::memory_order_acquire);
+  // Messages are stored contiguously. One byte is always kept free, so that head == tail means empty.
+  size_t pos = head;
+  if (head >= tail) {
+    size_t at_end = this->async_buffer_size_ - head - (tail == 0 ? 1 : 0);
+    if (at_end < size) {
+      // doesn't fit before the end of the buffer, continue at the start
+      if (tail == 0 || tail - 1 < size)
+        return false;
+      if (this->async_buffer_size_ - head >= sizeof(AsyncLogHeader)) {
+        AsyncLogHeader wrap{nullptr, ASYNC_LOG_WRAP, 0};
+        memcpy(this->async_buffer_ + head, &wrap, sizeof(wrap));
+      }
+      pos = 0;
+    }
+  } else if (tail - head - 1 < size) {
+    return false;
+  }
+
+  AsyncLogHeader header{tag, static_cast<uint16_t>(length), static_cast<uint8_t>(level)};
+  memcpy(this->async_buffer_ + pos, &header, sizeof(header));
+  memcpy(this->async_buffer_ + pos + sizeof(header), msg, length);
+  this->async_buffer_[pos + sizeof(header) + length] = '\0';
+  size_t new_head = pos + size;
+  if (new_head == this->async_buffer_size_)
+    new_head = 0;
+  this->async_head_.store(new_head, std::memory_order_release);
+  return true;
+}
+void Logger::loop() {
+  if (this->async_buffer_ == nullptr)
+    return;
+  // log callbacks can't log themselves, same as for synchronous logging
+  in_logger = true;
+  uint32_t dropped = this->async_dropped_.exchange(0);
+  if (dropped > 0) {
+    // tx_buffer_ is shared with the log calls of other tasks
+    LockGuard guard{this->log_lock_};
+    this->reset_buffer_();
+    this->write_header_(ESPHOME_LOG_LEVEL_WARN, TAG, __LINE__);
+    this->printf_to_buffer_("%u log messages dropped, the async buffer is full", dropped);
+    this->write_footer_();
+    this->set_null_terminator_();
+    this->emit_message_(ESPHOME_LOG_LEVEL_WARN, TAG, this->tx_buffer_);
+  }
+
+  size_t tail = this->async_tail_.load(std::memory_order_relaxed);
+  const size_t head = this->async_head_.load(std::memory_order_acquire);
+  uint8_t count = 0;
+  while (tail != head && count < ASYNC_LOG_MAX_PER_LOOP) {
+    AsyncLogHeader header;
+    bool wrap = this->async_buffer_size_ - tail < sizeof(header);
+    if (!wrap) {
+      memcpy(&header, this->async_buffer_ + tail, sizeof(header));
+      wrap = header.length == ASYNC_LOG_WRAP;
+    }
+    if (wrap) {
+      tail = 0;
+      continue;
+    }
+    this->emit_message_(header.level, header.tag,
+                        reinterpret_cast<const char *>(this->async_buffer_ + tail + sizeof(header)));
+    tail += sizeof(header) + header.length + 1;
+    if (tail == this->async_buffer_size_)
+      tail = 0;
+    // free the space right away, a message logged by another task can use it
+    this->async_tail_.store(tail, std::memory_order_release);
+    count++;
+  }
+  this->async_tail_.store(tail, std::memory_order_release);
+  in_logger = false;
+}
+
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size, UARTSelection uart)
     : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size), uart_(uart) {
   // add 1 to buffer size for null terminator
@@ -204,6 +416,9 @@ void Logger::pre_setup() {
 #endif
 
   global_logger = this;
+#ifdef USE_LOGGER_CRASH_LOG_SIZE
+  this->load_crash_log_();
+#endif
 #if defined(USE_ESP_IDF) || defined(USE_ESP32_FRAMEWORK_ARDUINO)
   esp_log_set_vprintf(esp_idf_log_vprintf_);
   if (ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE) {
@@ -216,9 +431,19 @@ void Logger::pre_setup() {
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
 void Logger::set_log_level(const std::string &tag, int log_level) {
   this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  this->min_log_level_ = std::min(this->min_log_level_, log_level);
+  this->max_log_level_ = std::max(this->max_log_level_, log_level);
+  for (auto &cached : this->log_level_cache_)
+    cached.tag = nullptr;
 }
 UARTSelection Logger::get_uart() const { return this->uart_; }
 void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
+  this->has_unfiltered_callback_ = true;
+  this->log_callback_.add(std::move(callback));
+}
+void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback,
+                                 std::function<int()> &&level_callback) {
+  this->log_level_callbacks_.push_back(std::move(level_callback));
   this->log_callback_.add(std::move(callback));
 }
 float Logger::get_setup_priority() const { return setup_priority::BUS + 500.0f; }
@@ -229,14 +454,37 @@ const char *const UART_SELECTIONS[] = {"UART0", "UART1", "UART2"};
 #ifdef USE_ESP8266
 const char *const UART_SELECTIONS[] = {"UART0", "UART1", "UART0_SWAP"};
 #endif
+#ifdef USE_HOST
+const char *const UART_SELECTIONS[] = {"UART0", "UART1"};
+#endif
 void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "Logger:");
   ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[ESPHOME_LOG_LEVEL]);
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %u", this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", UART_SELECTIONS[this->uart_]);
+  if (this->async_buffer_size_ > 0)
+    ESP_LOGCONFIG(TAG, "  Async Buffer Size: %u", (unsigned) this->async_buffer_size_);
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
+#ifdef USE_LOGGER_CRASH_LOG_SIZE
+  ESP_LOGCONFIG(TAG, "  Crash Log Size: %u", USE_LOGGER_CRASH_LOG_SIZE);
+  ESP_LOGCONFIG(TAG, "  Crash Log Level: %s", LOG_LEVELS[this->crash_log_level_]);
+  if (!this->previous_boot_log_.empty()) {
+    ESP_LOGCONFIG(TAG, "  Log before the last reboot:");
+    // not recorded again, the crash log of this boot only gets its own messages
+    this->replaying_crash_log_ = true;
+    size_t start = 0;
+    while (start < this->previous_boot_log_.size()) {
+      size_t end = this->previous_boot_log_.find('\n', start);
+      if (end == std::string::npos)
+        end = this->previous_boot_log_.size();
+      ESP_LOGCONFIG(TAG, "    %.*s", (int) (end - start), this->previous_boot_log_.c_str() + start);
+      start = end + 1;
+    }
+    this->replaying_crash_log_ = false;
+  }
+#endif
 }
 void Logger::write_footer_() { this->write_to_buffer_(ESPHOME_LOG_RESET_COLOR, strlen(ESPHOME_LOG_RESET_COLOR)); }
 
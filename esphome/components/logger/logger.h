@@ -4,6 +4,8 @@
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/log.h"
+#include <atomic>
 #include <cstdarg>
 
 #ifdef USE_ARDUINO
@@ -52,16 +54,38 @@ class Logger : public Component {
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
 
+  /** Queue log messages in a ring buffer of the given size instead of writing them out immediately.
+   *
+   * The queued messages are written to the UART and passed to the log callbacks from loop(), messages that don't fit
+   * in the buffer are dropped (and counted). Set to 0 (the default) to log synchronously.
+   */
+  void set_async_buffer_size(size_t size);
+
+#ifdef USE_LOGGER_CRASH_LOG_SIZE
+  /// The last log lines before the previous reboot (kept in RTC memory), empty if the previous boot left none.
+  const std::string &get_previous_boot_log() const { return this->previous_boot_log_; }
+  /// Only messages of this level or more severe are kept in the crash log (and formatted even if no output wants them).
+  void set_crash_log_level(int level) { this->crash_log_level_ = level; }
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
   void pre_setup();
   void dump_config() override;
+  void loop() override;
 
   int level_for(const char *tag);
 
   /// Register a callback that will be called for every log message sent
   void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
+  /** Register a callback for log messages, together with a function returning the most verbose level it currently
+   * wants (ESPHOME_LOG_LEVEL_NONE for none).
+   *
+   * Messages that neither the UART nor any callback wants are not formatted at all.
+   */
+  void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback,
+                           std::function<int()> &&level_callback);
 
   float get_setup_priority() const override;
 
@@ -71,9 +95,22 @@ class Logger : public Component {
 #endif
 
  protected:
+#ifdef USE_LOGGER_CRASH_LOG_SIZE
+  /// Copy what the previous boot left in the crash log and start a new one.
+  void load_crash_log_();
+  void write_crash_log_(const char *msg, size_t length);
+#endif
+  /// Whether any output (UART or callback) wants messages of this level right now.
+  bool is_level_wanted_(int level);
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+  /// Write a finished message to the UART and the log callbacks.
+  void emit_message_(int level, const char *tag, const char *msg);
+  /// Queue a message in the async ring buffer, returns false if it didn't fit.
+  bool push_async_(int level, const char *tag, const char *msg, size_t length);
+  /// Log how many messages were dropped as recursive log calls since the last report, if any.
+  void report_recursion_dropped_();
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -129,9 +166,46 @@ class Logger : public Component {
     int level;
   };
   std::vector<LogLevelOverride> log_levels_;
+  /// Least and most verbose level of the global level and all overrides, outside of this range no lookup is needed.
+  int min_log_level_{ESPHOME_LOG_LEVEL};
+  int max_log_level_{ESPHOME_LOG_LEVEL};
+  /// The level of the override for tag, or the global level.
+  int find_level_(const char *tag) const;
+  /// Direct-mapped cache of level_for() results, keyed by the tag pointer (tags are almost always static strings).
+  /// Guarded by log_lock_.
+  struct LogLevelCacheEntry {
+    const char *tag;
+    int level;
+  };
+  static const size_t LOG_LEVEL_CACHE_SIZE = 16;
+  LogLevelCacheEntry log_level_cache_[LOG_LEVEL_CACHE_SIZE]{};
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
-  /// Prevents recursive log calls, if true a log message is already being processed.
-  bool recursion_guard_ = false;
+  /// Levels wanted by the callbacks registered with a level callback.
+  std::vector<std::function<int()>> log_level_callbacks_;
+  /// Whether a callback was registered without a level callback, it wants all messages.
+  bool has_unfiltered_callback_{false};
+  /// Ring buffer for asynchronous logging, nullptr if logging synchronously.
+  uint8_t *async_buffer_{nullptr};
+  size_t async_buffer_size_{0};
+  /** Write (head) and read (tail) offset in async_buffer_, written by log calls and loop() respectively.
+   *
+   * Log calls from all tasks are serialized by log_lock_, so the ring only has one producer at a time and loop()
+   * reads it without taking the lock.
+   */
+  std::atomic<size_t> async_head_{0};
+  std::atomic<size_t> async_tail_{0};
+  /// Messages dropped because the async buffer was full, since the last one was reported.
+  std::atomic<uint32_t> async_dropped_{0};
+#ifdef USE_LOGGER_CRASH_LOG_SIZE
+  std::string previous_boot_log_;
+  int crash_log_level_{ESPHOME_LOG_LEVEL_INFO};
+  /// Set while dump_config() prints the previous boot's log, so those lines aren't recorded again.
+  bool replaying_crash_log_{false};
+#endif
+  /// Held while a message is formatted into tx_buffer_ and passed on, log calls can come from any task.
+  Mutex log_lock_;
+  /// Log calls from a task that is already logging (e.g. from a log callback), since the last report.
+  std::atomic<uint32_t> recursion_dropped_{0};
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -140,11 +214,13 @@ class LoggerMessageTrigger : public Trigger<int, const char *, const char *> {
  public:
   explicit LoggerMessageTrigger(Logger *parent, int level) {
     this->level_ = level;
-    parent->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      if (level <= this->level_) {
-        this->trigger(level, tag, message);
-      }
-    });
+    parent->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) {
+          if (level <= this->level_) {
+            this->trigger(level, tag, message);
+          }
+        },
+        [this]() { return this->level_; });
   }
 
  protected:
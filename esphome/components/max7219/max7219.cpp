@@ -119,6 +119,7 @@ void MAX7219Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up MAX7219...");
   this->spi_setup();
   this->buffer_ = new uint8_t[this->num_chips_ * 8];  // NOLINT
+  this->shown_ = new uint8_t[this->num_chips_ * 8];   // NOLINT
   for (uint8_t i = 0; i < this->num_chips_ * 8; i++)
     this->buffer_[i] = 0;
 
@@ -141,7 +142,14 @@ void MAX7219Component::dump_config() {
 }
 
 void MAX7219Component::display() {
+  // Every digit register is written to all chips of the chain in one transaction, but only if it changed on one of
+  // them since the last call.
   for (uint8_t i = 0; i < 8; i++) {
+    bool changed = !this->shown_valid_;
+    for (uint8_t j = 0; j < this->num_chips_ && !changed; j++)
+      changed = this->shown_[j * 8 + i] != this->buffer_[j * 8 + i];
+    if (!changed)
+      continue;
     this->enable();
     for (uint8_t j = 0; j < this->num_chips_; j++)
       if (reverse_)
@@ -149,7 +157,10 @@ void MAX7219Component::display() {
       else
         this->send_byte_(8 - i, buffer_[j * 8 + i]);
     this->disable();
+    for (uint8_t j = 0; j < this->num_chips_; j++)
+      this->shown_[j * 8 + i] = this->buffer_[j * 8 + i];
   }
+  this->shown_valid_ = true;
 }
 void MAX7219Component::send_byte_(uint8_t a_register, uint8_t data) {
   this->write_byte(a_register);
@@ -30,6 +30,7 @@ class MAX7219Component : public PollingComponent,
 
   float get_setup_priority() const override;
 
+  /// Send the digits that changed since the last call to the chips.
   void display();
 
   void set_intensity(uint8_t intensity);
@@ -61,6 +62,9 @@ class MAX7219Component : public PollingComponent,
   uint8_t intensity_{15};  /// Intensity of the display from 0 to 15 (most)
   uint8_t num_chips_{1};
   uint8_t *buffer_;
+  /// The digits as they were last sent to the chips, only changed digit registers are sent again.
+  uint8_t *shown_;
+  bool shown_valid_{false};
   bool reverse_{false};
   optional<max7219_writer_t> writer_{};
 };
@@ -32,6 +32,8 @@ void MAX7219Component::setup() {
     // Initialize buffer with 0 for display so all non written pixels are blank
     this->max_displaybuffer_[chip_line].resize(get_width_internal(), 0);
   }
+  this->frame_.resize(this->num_chips_ * 8, 0);
+  this->shown_.resize(this->num_chips_ * 8, 0);
   // let's assume the user has all 8 digits connected, only important in daisy chained setups anyway
   this->send_to_all_(MAX7219_REGISTER_SCAN_LIMIT, 7);
   // let's use our own ASCII -> led pattern encoding
@@ -108,29 +110,40 @@ void MAX7219Component::loop() {
 
 void MAX7219Component::display() {
   uint8_t pixels[8];
+  size_t offset = this->scroll_offset_();
+  size_t buffer_size = this->max_displaybuffer_[0].size();
   // Run this loop for every MAX CHIP (GRID OF 64 leds)
   // Run this routine for the rows of every chip 8x row 0 top to 7 bottom
-  // Fill the pixel parameter with display data
-  // Send the data to the chip
+  // Fill the pixel parameter with display data, scrolled by offset columns
+  // Render it into the frame of the chip
   for (uint8_t chip = 0; chip < this->num_chips_ / this->num_chip_lines_; chip++) {
     for (uint8_t chip_line = 0; chip_line < this->num_chip_lines_; chip_line++) {
       for (uint8_t j = 0; j < 8; j++) {
         bool reverse =
             chip_line % 2 != 0 && this->chip_lines_style_ == ChipLinesStyle::SNAKE ? !this->reverse_ : this->reverse_;
+        size_t column;
         if (reverse) {
-          pixels[j] =
-              this->max_displaybuffer_[chip_line][(this->num_chips_ / this->num_chip_lines_ - chip - 1) * 8 + j];
+          column = (this->num_chips_ / this->num_chip_lines_ - chip - 1) * 8 + j;
         } else {
-          pixels[j] = this->max_displaybuffer_[chip_line][chip * 8 + j];
+          column = chip * 8 + j;
         }
+        pixels[j] = this->max_displaybuffer_[chip_line][(column + offset) % buffer_size];
       }
       if (chip_line % 2 != 0 && this->chip_lines_style_ == ChipLinesStyle::SNAKE)
         this->orientation_ = orientation_180_();
-      this->send64pixels(chip_line * this->num_chips_ / this->num_chip_lines_ + chip, pixels);
+      this->render64pixels_(chip_line * this->num_chips_ / this->num_chip_lines_ + chip, pixels);
       if (chip_line % 2 != 0 && this->chip_lines_style_ == ChipLinesStyle::SNAKE)
         this->orientation_ = orientation_180_();
     }
   }
+  this->flush_();
+}
+
+size_t MAX7219Component::scroll_offset_() {
+  if (!this->scroll_ || this->max_displaybuffer_[0].size() <= (size_t) this->get_width_internal())
+    return 0;
+  // scroll_left() counts a step when the blank column after the text is added, without moving
+  return this->stepsleft_ == 0 ? 0 : this->stepsleft_ - 1;
 }
 
 uint8_t MAX7219Component::orientation_180_() {
@@ -226,17 +239,10 @@ void MAX7219Component::intensity(uint8_t intensity) {
 void MAX7219Component::scroll(bool on_off) { this->set_scroll(on_off); }
 
 void MAX7219Component::scroll_left() {
-  for (int chip_line = 0; chip_line < this->num_chip_lines_; chip_line++) {
-    if (this->update_) {
+  // The text isn't moved in the buffer, display() shows it from the scroll offset on
+  if (this->update_) {
+    for (int chip_line = 0; chip_line < this->num_chip_lines_; chip_line++)
       this->max_displaybuffer_[chip_line].push_back(this->bckgrnd_);
-      for (uint16_t i = 0; i < this->stepsleft_; i++) {
-        this->max_displaybuffer_[chip_line].push_back(this->max_displaybuffer_[chip_line].front());
-        this->max_displaybuffer_[chip_line].erase(this->max_displaybuffer_[chip_line].begin());
-      }
-    } else {
-      this->max_displaybuffer_[chip_line].push_back(this->max_displaybuffer_[chip_line].front());
-      this->max_displaybuffer_[chip_line].erase(this->max_displaybuffer_[chip_line].begin());
-    }
   }
   this->update_ = false;
   this->stepsleft_++;
@@ -251,12 +257,13 @@ void MAX7219Component::send_char(uint8_t chip, uint8_t data) {
 // send one character (data) to position (chip)
 
 void MAX7219Component::send64pixels(uint8_t chip, const uint8_t pixels[8]) {
+  this->render64pixels_(chip, pixels);
+  this->flush_();
+}
+
+void MAX7219Component::render64pixels_(uint8_t chip, const uint8_t pixels[8]) {
   for (uint8_t col = 0; col < 8; col++) {  // RUN THIS LOOP 8 times until column is 7
-    this->enable();                        // start sending by enabling SPI
-    for (uint8_t i = 0; i < chip; i++)     // send extra NOPs to push the pixels out to extra displays
-      this->send_byte_(MAX7219_REGISTER_NOOP,
-                       MAX7219_REGISTER_NOOP);  // run this loop unit the matching chip is reached
-    uint8_t b = 0;                              // rotate pixels 90 degrees -- set byte to 0
+    uint8_t b = 0;                         // rotate pixels 90 degrees -- set byte to 0
     if (this->orientation_ == 0) {
       for (uint8_t i = 0; i < 8; i++) {
         // run this loop 8 times for all the pixels[8] received
@@ -271,17 +278,27 @@ void MAX7219Component::send64pixels(uint8_t chip, const uint8_t pixels[8]) {
     } else {
       b = pixels[7 - col];
     }
-    // send this byte to display at selected chip
-    if (this->invert_) {
-      this->send_byte_(col + 1, ~b);
-    } else {
-      this->send_byte_(col + 1, b);
+    this->frame_[chip * 8 + col] = this->invert_ ? ~b : b;
+  }  // end of for each column
+}  // end of render64pixels_
+
+void MAX7219Component::flush_() {
+  for (uint8_t col = 0; col < 8; col++) {
+    bool changed = !this->shown_valid_;
+    for (uint8_t chip = 0; chip < this->num_chips_ && !changed; chip++)
+      changed = this->frame_[chip * 8 + col] != this->shown_[chip * 8 + col];
+    if (!changed)
+      continue;
+    // one transaction writes this column register of all chips, the first byte ends up in the first chip
+    this->enable();
+    for (uint8_t chip = 0; chip < this->num_chips_; chip++) {
+      this->send_byte_(col + 1, this->frame_[chip * 8 + col]);
+      this->shown_[chip * 8 + col] = this->frame_[chip * 8 + col];
     }
-    for (int i = 0; i < this->num_chips_ - chip - 1; i++)  // end with enough NOPs so later chips don't update
-      this->send_byte_(MAX7219_REGISTER_NOOP, MAX7219_REGISTER_NOOP);
-    this->disable();  // all done disable SPI
-  }                   // end of for each column
-}  // end of send64pixels
+    this->disable();
+  }
+  this->shown_valid_ = true;
+}
 
 uint8_t MAX7219Component::printdigit(const char *str) { return this->printdigit(0, str); }
 
@@ -97,6 +97,12 @@ class MAX7219Component : public PollingComponent,
   void send_byte_(uint8_t a_register, uint8_t data);
   void send_to_all_(uint8_t a_register, uint8_t data);
   uint8_t orientation_180_();
+  /// Rotate the pixels of one chip into its column registers in frame_.
+  void render64pixels_(uint8_t chip, const uint8_t pixels[8]);
+  /// Send the column registers of frame_ that changed since the last flush.
+  void flush_();
+  /// The first buffer column to show while scrolling.
+  size_t scroll_offset_();
 
   uint8_t intensity_;  /// Intensity of the display from 0 to 15 (most)
   uint8_t num_chips_;
@@ -114,6 +120,10 @@ class MAX7219Component : public PollingComponent,
   uint8_t orientation_;
   uint8_t bckgrnd_ = 0x0;
   std::vector<std::vector<uint8_t>> max_displaybuffer_;
+  /// The column registers of all chips, as they should be and as they were last sent.
+  std::vector<uint8_t> frame_;
+  std::vector<uint8_t> shown_;
+  bool shown_valid_{false};
   uint32_t last_scroll_ = 0;
   uint16_t stepsleft_;
   size_t get_buffer_length_();
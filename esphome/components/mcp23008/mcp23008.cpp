@@ -18,6 +18,7 @@ void MCP23008::setup() {
     // enable open-drain interrupt pins, 3.3V-safe
     this->write_reg(mcp23x08_base::MCP23X08_IOCON, 0x04);
   }
+  this->setup_interrupt_pin_();
 }
 
 void MCP23008::dump_config() { ESP_LOGCONFIG(TAG, "MCP23008:"); }
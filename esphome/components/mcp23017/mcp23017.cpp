@@ -8,17 +8,26 @@ static const char *const TAG = "mcp23017";
 
 void MCP23017::setup() {
   ESP_LOGCONFIG(TAG, "Setting up MCP23017...");
-  uint8_t iocon;
-  if (!this->read_reg(mcp23x17_base::MCP23X17_IOCONA, &iocon)) {
+  uint8_t reg;
+  if (!this->read_reg(mcp23x17_base::MCP23X17_IOCONA, &reg)) {
     this->mark_failed();
     return;
   }
 
+  uint8_t iocon = 0x00;
   if (this->open_drain_ints_) {
     // enable open-drain interrupt pins, 3.3V-safe
-    this->write_reg(mcp23x17_base::MCP23X17_IOCONA, 0x04);
-    this->write_reg(mcp23x17_base::MCP23X17_IOCONB, 0x04);
+    iocon |= 0x04;
   }
+  if (this->interrupt_pin_ != nullptr) {
+    // mirror the interrupts of both ports on INTA and INTB, so that either can be connected
+    iocon |= 0x40;
+  }
+  if (iocon != 0x00) {
+    this->write_reg(mcp23x17_base::MCP23X17_IOCONA, iocon);
+    this->write_reg(mcp23x17_base::MCP23X17_IOCONB, iocon);
+  }
+  this->setup_interrupt_pin_();
 }
 
 void MCP23017::dump_config() { ESP_LOGCONFIG(TAG, "MCP23017:"); }
@@ -27,6 +27,7 @@ void MCP23S08::setup() {
     // enable open-drain interrupt pins, 3.3V-safe
     this->write_reg(mcp23x08_base::MCP23X08_IOCON, 0x04);
   }
+  this->setup_interrupt_pin_();
 }
 
 void MCP23S08::dump_config() {
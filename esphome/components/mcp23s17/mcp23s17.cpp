@@ -23,11 +23,20 @@ void MCP23S17::setup() {
   this->transfer_byte(0b00011000);  // Enable HAEN pins for addressing
   this->disable();
 
+  uint8_t iocon = 0b00011000;
   if (this->open_drain_ints_) {
     // enable open-drain interrupt pins, 3.3V-safe
-    this->write_reg(mcp23x17_base::MCP23X17_IOCONA, 0x04);
-    this->write_reg(mcp23x17_base::MCP23X17_IOCONB, 0x04);
+    iocon |= 0x04;
   }
+  if (this->interrupt_pin_ != nullptr) {
+    // mirror the interrupts of both ports on INTA and INTB, so that either can be connected
+    iocon |= 0x40;
+  }
+  if (iocon != 0b00011000) {
+    this->write_reg(mcp23x17_base::MCP23X17_IOCONA, iocon);
+    this->write_reg(mcp23x17_base::MCP23X17_IOCONB, iocon);
+  }
+  this->setup_interrupt_pin_();
 }
 
 void MCP23S17::dump_config() {
@@ -10,7 +10,7 @@ bool MCP23X08Base::digital_read(uint8_t pin) {
   uint8_t bit = pin % 8;
   uint8_t reg_addr = mcp23x08_base::MCP23X08_GPIO;
   uint8_t value = 0;
-  this->read_reg(reg_addr, &value);
+  this->read_port_(0, reg_addr, &value);
   return value & (1 << bit);
 }
 
@@ -76,6 +76,8 @@ void MCP23X08Base::update_reg(uint8_t pin, bool pin_value, uint8_t reg_addr) {
 
   if (reg_addr == mcp23x08_base::MCP23X08_OLAT) {
     this->olat_ = reg_value;
+    // The cached port value might show the old output state
+    this->ports_valid_ = 0;
   }
 }
 
@@ -10,7 +10,7 @@ bool MCP23X17Base::digital_read(uint8_t pin) {
   uint8_t bit = pin % 8;
   uint8_t reg_addr = pin < 8 ? mcp23x17_base::MCP23X17_GPIOA : mcp23x17_base::MCP23X17_GPIOB;
   uint8_t value = 0;
-  this->read_reg(reg_addr, &value);
+  this->read_port_(pin < 8 ? 0 : 1, reg_addr, &value);
   return value & (1 << bit);
 }
 
@@ -79,8 +79,11 @@ void MCP23X17Base::update_reg(uint8_t pin, bool pin_value, uint8_t reg_addr) {
 
   if (reg_addr == mcp23x17_base::MCP23X17_OLATA) {
     this->olat_a_ = reg_value;
+    // The cached port value might show the old output state
+    this->ports_valid_ &= ~1;
   } else if (reg_addr == mcp23x17_base::MCP23X17_OLATB) {
     this->olat_b_ = reg_value;
+    this->ports_valid_ &= ~2;
   }
 }
 
@@ -5,8 +5,43 @@ namespace esphome {
 namespace mcp23xxx_base {
 
 float MCP23XXXBase::get_setup_priority() const { return setup_priority::IO; }
+void MCP23XXXBase::loop() {
+  if (this->interrupt_pin_ != nullptr && !this->ports_changed_)
+    return;
+  this->ports_changed_ = false;
+  this->ports_valid_ = 0;
+}
+void MCP23XXXBase::setup_interrupt_pin_() {
+  if (this->interrupt_pin_ == nullptr)
+    return;
+  this->interrupt_pin_->setup();
+  // INT is active low, reading the port releases it again
+  this->interrupt_pin_->attach_interrupt(&MCP23XXXBase::gpio_intr, this, gpio::INTERRUPT_FALLING_EDGE);
+}
+void IRAM_ATTR MCP23XXXBase::gpio_intr(MCP23XXXBase *arg) { arg->ports_changed_ = true; }
+bool MCP23XXXBase::read_port_(uint8_t port, uint8_t reg, uint8_t *value) {
+  if (this->ports_valid_ & (1 << port)) {
+    *value = this->ports_[port];
+    return true;
+  }
+  if (!this->read_reg(reg, value))
+    return false;
+  if ((this->get_component_state() & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP) {
+    this->ports_[port] = *value;
+    this->ports_valid_ |= 1 << port;
+  }
+  return true;
+}
 
-void MCP23XXXGPIOPin::setup() { pin_mode(flags_); }
+void MCP23XXXGPIOPin::setup() {
+  pin_mode(flags_);
+  MCP23XXXInterruptMode interrupt_mode = this->interrupt_mode_;
+  // With the INT output connected, inputs are only read after they changed
+  if (this->parent_->has_interrupt_pin() && (this->flags_ & gpio::FLAG_INPUT))
+    interrupt_mode = MCP23XXX_CHANGE;
+  if (interrupt_mode != MCP23XXX_NO_INTERRUPT)
+    this->parent_->pin_interrupt_mode(this->pin_, interrupt_mode);
+}
 void MCP23XXXGPIOPin::pin_mode(gpio::Flags flags) { this->parent_->pin_mode(this->pin_, flags); }
 bool MCP23XXXGPIOPin::digital_read() { return this->parent_->digital_read(this->pin_) != this->inverted_; }
 void MCP23XXXGPIOPin::digital_write(bool value) { this->parent_->digital_write(this->pin_, value != this->inverted_); }
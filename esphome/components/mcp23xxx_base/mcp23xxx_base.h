@@ -16,9 +16,28 @@ class MCP23XXXBase : public Component {
   virtual void pin_interrupt_mode(uint8_t pin, MCP23XXXInterruptMode interrupt_mode);
 
   void set_open_drain_ints(const bool value) { this->open_drain_ints_ = value; }
+  /** Set the pin the INT output of the chip is connected to.
+   *
+   * All input pins then interrupt on change, and their values are only read from the chip again after an interrupt.
+   */
+  void set_interrupt_pin(InternalGPIOPin *interrupt_pin) { this->interrupt_pin_ = interrupt_pin; }
+  bool has_interrupt_pin() const { return this->interrupt_pin_ != nullptr; }
   float get_setup_priority() const override;
+  /// Drop the port values read during the previous loop iteration (or before the last interrupt).
+  void loop() override;
 
  protected:
+  /// Attach the interrupt of interrupt_pin_, if set. Called by the setup() of the chips.
+  void setup_interrupt_pin_();
+  static void gpio_intr(MCP23XXXBase *arg);
+
+  /** Read a port (GPIO) register, port being its index (0 or 1).
+   *
+   * Once looping, the value is cached until the next loop iteration, so reading all pins of a port takes a single
+   * bus transaction per loop instead of one per pin. During setup it's always read from the chip.
+   */
+  bool read_port_(uint8_t port, uint8_t reg, uint8_t *value);
+
   // read a given register
   virtual bool read_reg(uint8_t reg, uint8_t *value);
   // write a value to a given register
@@ -27,6 +46,12 @@ class MCP23XXXBase : public Component {
   virtual void update_reg(uint8_t pin, bool pin_value, uint8_t reg_a);
 
   bool open_drain_ints_;
+  InternalGPIOPin *interrupt_pin_{nullptr};
+  /// Set from the ISR of interrupt_pin_ when an input changed.
+  volatile bool ports_changed_{true};
+  uint8_t ports_[2]{};
+  /// Bit i set if ports_[i] was read during this loop iteration.
+  uint8_t ports_valid_{0};
 };
 
 class MCP23XXXGPIOPin : public GPIOPin {
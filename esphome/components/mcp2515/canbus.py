@@ -1,18 +1,40 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import spi, canbus
-from esphome.const import CONF_ID, CONF_MODE
-from esphome.components.canbus import CanbusComponent
+from esphome import pins
+from esphome.components import spi, canbus, sensor
+from esphome.const import (
+    CONF_ID,
+    CONF_MODE,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_COUNTER,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+)
+from esphome.components.canbus import (
+    CanbusComponent,
+    CONF_CAN_ID,
+    CONF_ON_FRAME,
+    CONF_USE_EXTENDED_ID,
+)
 
 CODEOWNERS = ["@mvturnho", "@danielschramm"]
 DEPENDENCIES = ["spi"]
+AUTO_LOAD = ["sensor"]
 
 CONF_CLOCK = "clock"
+CONF_IRQ_PIN = "irq_pin"
+CONF_FRAME_RATE = "frame_rate"
+CONF_OVERFLOW_COUNT = "overflow_count"
+UNIT_FRAMES_PER_SECOND = "frames/s"
 
 mcp2515_ns = cg.esphome_ns.namespace("mcp2515")
 mcp2515 = mcp2515_ns.class_("MCP2515", CanbusComponent, spi.SPIDevice)
 CanClock = mcp2515_ns.enum("CAN_CLOCK")
 McpMode = mcp2515_ns.enum("CANCTRL_REQOP_MODE")
+Mask = mcp2515_ns.enum("MASK")
+MASKS = [Mask.MASK0, Mask.MASK1]
+Rxf = mcp2515_ns.enum("RXF")
+RXFS = [Rxf.RXF0, Rxf.RXF1, Rxf.RXF2, Rxf.RXF3, Rxf.RXF4, Rxf.RXF5]
 
 CAN_CLOCK = {
     "8MHZ": CanClock.MCP_8MHZ,
@@ -31,10 +53,60 @@ CONFIG_SCHEMA = canbus.CANBUS_SCHEMA.extend(
         cv.GenerateID(): cv.declare_id(mcp2515),
         cv.Optional(CONF_CLOCK, default="8MHZ"): cv.enum(CAN_CLOCK, upper=True),
         cv.Optional(CONF_MODE, default="NORMAL"): cv.enum(MCP_MODE, upper=True),
+        cv.Optional(CONF_IRQ_PIN): pins.gpio_input_pin_schema,
+        cv.Optional(CONF_FRAME_RATE): sensor.sensor_schema(
+            unit_of_measurement=UNIT_FRAMES_PER_SECOND,
+            accuracy_decimals=1,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_OVERFLOW_COUNT): sensor.sensor_schema(
+            icon=ICON_COUNTER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
     }
 ).extend(spi.spi_device_schema(True))
 
 
+def _buffer_acceptance(ids, extended, slots):
+    """Mask and filters for one receive buffer that accept all of ids (of one kind)."""
+    full = 0x1FFFFFFF if extended else 0x7FF
+    if len(ids) <= slots:
+        padded = ids + ids[:1] * (slots - len(ids))
+        return (extended, full), [(extended, can_id) for can_id in padded]
+    # Too many IDs for the filters, only compare the bits they have in common
+    diff = 0
+    for can_id in ids:
+        diff |= can_id ^ ids[0]
+    return (extended, full & ~diff), [(extended, ids[0])] * slots
+
+
+def acceptance_filters(frames):
+    """Derive the masks and filters that accept the frames of the on_frame triggers.
+
+    Returns ([mask 0, mask 1], [filter 0, ..., filter 5]) as (extended, value) pairs.
+    Receive buffer 0 has mask 0 and filters 0-1, receive buffer 1 mask 1 and filters
+    2-5. Where there are more IDs than filters the mask is widened, so some other
+    frames pass as well.
+    """
+    standard = sorted({can_id for can_id, extended in frames if not extended})
+    extended = sorted({can_id for can_id, extended in frames if extended})
+    if standard and extended:
+        # The larger set gets the buffer with four filters
+        groups = sorted([(standard, False), (extended, True)], key=lambda g: len(g[0]))
+    else:
+        ids, is_extended = (standard, False) if standard else (extended, True)
+        if len(ids) <= 6:
+            groups = [(ids[:2], is_extended), (ids[2:] or ids, is_extended)]
+        else:
+            groups = [(ids, is_extended), (ids, is_extended)]
+    mask0, filters0 = _buffer_acceptance(*groups[0], 2)
+    mask1, filters1 = _buffer_acceptance(*groups[1], 4)
+    return [mask0, mask1], filters0 + filters1
+
+
 async def to_code(config):
     rhs = mcp2515.new()
     var = cg.Pvariable(config[CONF_ID], rhs)
@@ -45,5 +117,26 @@ async def to_code(config):
     if CONF_MODE in config:
         mode = MCP_MODE[config[CONF_MODE]]
         cg.add(var.set_mcp_mode(mode))
+    if CONF_IRQ_PIN in config:
+        irq_pin = await cg.gpio_pin_expression(config[CONF_IRQ_PIN])
+        cg.add(var.set_irq_pin(irq_pin))
+    if CONF_FRAME_RATE in config:
+        sens = await sensor.new_sensor(config[CONF_FRAME_RATE])
+        cg.add(var.set_frame_rate_sensor(sens))
+    if CONF_OVERFLOW_COUNT in config:
+        sens = await sensor.new_sensor(config[CONF_OVERFLOW_COUNT])
+        cg.add(var.set_overflow_count_sensor(sens))
+
+    # Frames are only used by the on_frame triggers, let the controller drop all others
+    frames = [
+        (conf[CONF_CAN_ID], conf[CONF_USE_EXTENDED_ID])
+        for conf in config.get(CONF_ON_FRAME, [])
+    ]
+    if frames:
+        masks, filters = acceptance_filters(frames)
+        for mask, (extended, value) in zip(MASKS, masks):
+            cg.add(var.set_acceptance_mask(mask, extended, value))
+        for rxf, (extended, value) in zip(RXFS, filters):
+            cg.add(var.set_acceptance_filter(rxf, extended, value))
 
     await spi.register_spi_device(var, config)
@@ -5,6 +5,7 @@ namespace esphome {
 namespace mcp2515 {
 
 static const char *const TAG = "mcp2515";
+static const uint32_t STATS_INTERVAL = 60000;
 
 const struct MCP2515::TxBnRegs MCP2515::TXB[N_TXBUFFERS] = {{MCP_TXB0CTRL, MCP_TXB0SIDH, MCP_TXB0DATA},
                                                             {MCP_TXB1CTRL, MCP_TXB1SIDH, MCP_TXB1DATA},
@@ -15,11 +16,24 @@ const struct MCP2515::RxBnRegs MCP2515::RXB[N_RXBUFFERS] = {{MCP_RXB0CTRL, MCP_R
 
 bool MCP2515::setup_internal() {
   this->spi_setup();
+  if (this->irq_pin_ != nullptr)
+    this->irq_pin_->setup();
 
   if (this->reset_() == canbus::ERROR_FAIL)
     return false;
   this->set_bitrate_(this->bit_rate_, this->mcp_clock_);
+  if (this->use_filters_) {
+    this->set_filter_mask_(MASK0, this->masks_[MASK0].extended, this->masks_[MASK0].value);
+    this->set_filter_mask_(MASK1, this->masks_[MASK1].extended, this->masks_[MASK1].value);
+    for (uint8_t i = 0; i < 6; i++)
+      this->set_filter_(static_cast<RXF>(i), this->filters_[i].extended, this->filters_[i].value);
+  }
   this->set_mode_(this->mcp_mode_);
+
+  if (this->frame_rate_sensor_ != nullptr || this->overflow_count_sensor_ != nullptr) {
+    this->last_stats_ = millis();
+    this->set_interval(STATS_INTERVAL, [this]() { this->publish_stats_(); });
+  }
   ESP_LOGV(TAG, "setup done");
   return true;
 }
@@ -62,14 +76,11 @@ uint8_t MCP2515::read_register_(const REGISTER reg) {
 }
 
 void MCP2515::read_registers_(const REGISTER reg, uint8_t values[], const uint8_t n) {
-  this->enable();
-  this->transfer_byte(INSTRUCTION_READ);
-  this->transfer_byte(reg);
-  // this->transfer_array(values, n);
+  const uint8_t header[2] = {INSTRUCTION_READ, reg};
   // mcp2515 has auto - increment of address - pointer
-  for (uint8_t i = 0; i < n; i++) {
-    values[i] = this->transfer_byte(0x00);
-  }
+  const std::array<spi::SPISegment, 2> segments = {{{header, nullptr, 2}, {nullptr, values, n}}};
+  this->enable();
+  this->transfer_segments(segments);
   this->disable();
 }
 
@@ -82,13 +93,10 @@ void MCP2515::set_register_(const REGISTER reg, const uint8_t value) {
 }
 
 void MCP2515::set_registers_(const REGISTER reg, uint8_t values[], const uint8_t n) {
+  const uint8_t header[2] = {INSTRUCTION_WRITE, reg};
+  const std::array<spi::SPISegment, 2> segments = {{{header, nullptr, 2}, {values, nullptr, n}}};
   this->enable();
-  this->transfer_byte(INSTRUCTION_WRITE);
-  this->transfer_byte(reg);
-  // this->transfer_array(values, n);
-  for (uint8_t i = 0; i < n; i++) {
-    this->transfer_byte(values[i]);
-  }
+  this->transfer_segments(segments);
   this->disable();
 }
 
@@ -263,15 +271,17 @@ canbus::Error MCP2515::send_message(struct canbus::CanFrame *frame) {
 }
 
 canbus::Error MCP2515::read_message_(RXBn rxbn, struct canbus::CanFrame *frame) {
-  const struct RxBnRegs *rxb = &RXB[rxbn];
-
-  uint8_t tbufdata[5];
-
-  read_registers_(rxb->SIDH, tbufdata, 5);
+  // READ RX BUFFER returns the header and data in one transfer and clears the RXnIF flag once CS goes high
+  const uint8_t instruction = rxbn == RXB0 ? INSTRUCTION_READ_RX0 : INSTRUCTION_READ_RX1;
+  uint8_t tbufdata[5 + canbus::CAN_MAX_DATA_LENGTH];
+  const std::array<spi::SPISegment, 2> segments = {{{&instruction, nullptr, 1}, {nullptr, tbufdata, sizeof(tbufdata)}}};
+  this->enable();
+  this->transfer_segments(segments);
+  this->disable();
 
   uint32_t id = (tbufdata[MCP_SIDH] << 3) + (tbufdata[MCP_SIDL] >> 5);
   bool use_extended_id = false;
-  bool remote_transmission_request = false;
+  bool remote_transmission_request;
 
   if ((tbufdata[MCP_SIDL] & TXB_EXIDE_MASK) == TXB_EXIDE_MASK) {
     id = (id << 2) + (tbufdata[MCP_SIDL] & 0x03);
@@ -279,6 +289,9 @@ canbus::Error MCP2515::read_message_(RXBn rxbn, struct canbus::CanFrame *frame)
     id = (id << 8) + tbufdata[MCP_EID0];
     // id |= canbus::CAN_EFF_FLAG;
     use_extended_id = true;
+    remote_transmission_request = (tbufdata[MCP_DLC] & RTR_MASK) != 0;
+  } else {
+    remote_transmission_request = (tbufdata[MCP_SIDL] & RXB_SIDL_SRR) != 0;
   }
 
   uint8_t dlc = (tbufdata[MCP_DLC] & DLC_MASK);
@@ -286,37 +299,50 @@ canbus::Error MCP2515::read_message_(RXBn rxbn, struct canbus::CanFrame *frame)
     return canbus::ERROR_FAIL;
   }
 
-  uint8_t ctrl = read_register_(rxb->CTRL);
-  if (ctrl & RXB_CTRL_RTR) {
-    // id |= canbus::CAN_RTR_FLAG;
-    remote_transmission_request = true;
-  }
-
   frame->can_id = id;
   frame->can_data_length_code = dlc;
   frame->use_extended_id = use_extended_id;
   frame->remote_transmission_request = remote_transmission_request;
-
-  read_registers_(rxb->DATA, frame->data, dlc);
-
-  modify_register_(MCP_CANINTF, rxb->CANINTF_RXnIF, 0);
+  memcpy(frame->data, &tbufdata[MCP_DATA], dlc);
+  this->rx_frames_++;
 
   return canbus::ERROR_OK;
 }
 
 canbus::Error MCP2515::read_message(struct canbus::CanFrame *frame) {
-  canbus::Error rc;
-  uint8_t stat = get_status_();
+  // INT is active low and stays low while a receive or error flag is set
+  if (this->irq_pin_ != nullptr && this->irq_pin_->digital_read())
+    return canbus::ERROR_NOMSG;
+
+  uint8_t intf = this->get_int_();
+  if (intf & (CANINTF_ERRIF | CANINTF_MERRF))
+    this->handle_errors_();
+
+  if (intf & CANINTF_RX0IF)
+    return this->read_message_(RXB0, frame);
+  if (intf & CANINTF_RX1IF)
+    return this->read_message_(RXB1, frame);
+  return canbus::ERROR_NOMSG;
+}
 
-  if (stat & STAT_RX0IF) {
-    rc = read_message_(RXB0, frame);
-  } else if (stat & STAT_RX1IF) {
-    rc = read_message_(RXB1, frame);
-  } else {
-    rc = canbus::ERROR_NOMSG;
+void MCP2515::handle_errors_() {
+  uint8_t eflg = this->get_error_flags_();
+  if (eflg & (EFLG_RX0OVR | EFLG_RX1OVR)) {
+    this->rx_overflows_++;
+    ESP_LOGV(TAG, "Receive buffer overflow, a frame was lost");
+    this->clear_rx_n_ovr_flags_();
   }
+  this->modify_register_(MCP_CANINTF, CANINTF_ERRIF | CANINTF_MERRF, 0);
+}
 
-  return rc;
+void MCP2515::publish_stats_() {
+  const uint32_t now = millis();
+  if (this->frame_rate_sensor_ != nullptr && now != this->last_stats_)
+    this->frame_rate_sensor_->publish_state(this->rx_frames_ * 1000.0f / (now - this->last_stats_));
+  if (this->overflow_count_sensor_ != nullptr)
+    this->overflow_count_sensor_->publish_state(this->rx_overflows_);
+  this->rx_frames_ = 0;
+  this->last_stats_ = now;
 }
 
 bool MCP2515::check_receive_() {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/components/canbus/canbus.h"
+#include "esphome/components/sensor/sensor.h"
 #include "esphome/components/spi/spi.h"
 #include "esphome/core/component.h"
 #include "mcp2515_defs.h"
@@ -59,6 +60,18 @@ class MCP2515 : public canbus::Canbus,
   MCP2515(){};
   void set_mcp_clock(CanClock clock) { this->mcp_clock_ = clock; };
   void set_mcp_mode(const CanctrlReqopMode mode) { this->mcp_mode_ = mode; }
+  /// The INT pin, while it's high the receive buffers are known to be empty and aren't polled.
+  void set_irq_pin(GPIOPin *irq_pin) { this->irq_pin_ = irq_pin; }
+  /// Set the acceptance mask of a receive buffer, filters are only used once a mask is set.
+  void set_acceptance_mask(MASK mask, bool extended, uint32_t value) {
+    this->masks_[mask] = {extended, value};
+    this->use_filters_ = true;
+  }
+  void set_acceptance_filter(RXF num, bool extended, uint32_t value) { this->filters_[num] = {extended, value}; }
+  void set_frame_rate_sensor(sensor::Sensor *frame_rate_sensor) { this->frame_rate_sensor_ = frame_rate_sensor; }
+  void set_overflow_count_sensor(sensor::Sensor *overflow_count_sensor) {
+    this->overflow_count_sensor_ = overflow_count_sensor;
+  }
   static const struct TxBnRegs {
     REGISTER CTRL;
     REGISTER SIDH;
@@ -75,6 +88,20 @@ class MCP2515 : public canbus::Canbus,
  protected:
   CanClock mcp_clock_{MCP_8MHZ};
   CanctrlReqopMode mcp_mode_ = CANCTRL_REQOP_NORMAL;
+  GPIOPin *irq_pin_{nullptr};
+  struct Acceptance {
+    bool extended;
+    uint32_t value;
+  };
+  Acceptance masks_[2]{};
+  Acceptance filters_[6]{};
+  bool use_filters_{false};
+  sensor::Sensor *frame_rate_sensor_{nullptr};
+  sensor::Sensor *overflow_count_sensor_{nullptr};
+  uint32_t rx_frames_{0};
+  uint32_t rx_overflows_{0};
+  uint32_t last_stats_{0};
+
   bool setup_internal() override;
   canbus::Error set_mode_(CanctrlReqopMode mode);
 
@@ -95,6 +122,8 @@ class MCP2515 : public canbus::Canbus,
   canbus::Error send_message(struct canbus::CanFrame *frame) override;
   canbus::Error read_message_(RXBn rxbn, struct canbus::CanFrame *frame);
   canbus::Error read_message(struct canbus::CanFrame *frame) override;
+  void handle_errors_();
+  void publish_stats_();
   bool check_receive_();
   bool check_error_();
   uint8_t get_error_flags_();
@@ -133,6 +133,7 @@ static const uint8_t CNF3_SOF = 0x80;
 static const uint8_t TXB_EXIDE_MASK = 0x08;
 static const uint8_t DLC_MASK = 0x0F;
 static const uint8_t RTR_MASK = 0x40;
+static const uint8_t RXB_SIDL_SRR = 0x10;
 
 static const uint8_t RXB_CTRL_RXM_STD = 0x20;
 static const uint8_t RXB_CTRL_RXM_EXT = 0x40;
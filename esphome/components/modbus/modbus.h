@@ -28,16 +28,26 @@ class Modbus : public uart::UARTDevice, public Component {
   void set_flow_control_pin(GPIOPin *flow_control_pin) { this->flow_control_pin_ = flow_control_pin; }
   uint8_t waiting_for_response{0};
   void set_send_wait_time(uint16_t time_in_ms) { send_wait_time_ = time_in_ms; }
+  uint32_t get_baud_rate() const { return this->parent_->get_baud_rate(); }
+  /** Called with every valid frame (without the crc) before it's dispatched to the devices.
+   *
+   * Return true to take the frame, the devices don't see it then. Used by gateways that forward requests of other
+   * masters on this bus.
+   */
+  void set_frame_interceptor(std::function<bool(const uint8_t *frame, size_t len)> &&interceptor) {
+    this->frame_interceptor_ = std::move(interceptor);
+  }
 
  protected:
   GPIOPin *flow_control_pin_{nullptr};
 
-  bool parse_modbus_byte_(uint8_t byte);
+  void on_rx_frame_(const uint8_t *data, size_t len);
+  size_t parse_modbus_frame_(const uint8_t *raw, size_t len);
   uint16_t send_wait_time_{250};
   std::vector<uint8_t> rx_buffer_;
-  uint32_t last_modbus_byte_{0};
   uint32_t last_send_{0};
   std::vector<ModbusDevice *> devices_;
+  std::function<bool(const uint8_t *frame, size_t len)> frame_interceptor_{};
 };
 
 uint16_t crc16(const uint8_t *data, uint8_t len);
@@ -46,7 +56,12 @@ class ModbusDevice {
  public:
   void set_parent(Modbus *parent) { parent_ = parent; }
   void set_address(uint8_t address) { address_ = address; }
-  virtual void on_modbus_data(const std::vector<uint8_t> &data) = 0;
+  virtual void on_modbus_data(const std::vector<uint8_t> &data) {}
+  /// Called with the data of each response, pointing into the receive buffer. Override this instead of
+  /// on_modbus_data() to skip copying it into a vector.
+  virtual void on_modbus_frame(const uint8_t *data, size_t len) {
+    this->on_modbus_data(std::vector<uint8_t>(data, data + len));
+  }
   virtual void on_modbus_error(uint8_t function_code, uint8_t exception_code) {}
   void send(uint8_t function, uint16_t start_address, uint16_t number_of_entities, uint8_t payload_len = 0,
             const uint8_t *payload = nullptr) {
@@ -10,7 +10,9 @@ from .const import (
     CONF_COMMAND_THROTTLE,
     CONF_CUSTOM_COMMAND,
     CONF_FORCE_NEW_RANGE,
+    CONF_MAX_REGISTER_GAP,
     CONF_MODBUS_CONTROLLER_ID,
+    CONF_POLL_INTERVAL,
     CONF_REGISTER_COUNT,
     CONF_REGISTER_TYPE,
     CONF_RESPONSE_SIZE,
@@ -105,6 +107,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_COMMAND_THROTTLE, default="0ms"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_MAX_REGISTER_GAP, default=0): cv.int_range(min=0, max=124),
         }
     )
     .extend(cv.polling_component_schema("60s"))
@@ -130,6 +133,7 @@ ModbusItemBaseSchema = cv.Schema(
         cv.Optional(CONF_BITMASK, default=0xFFFFFFFF): cv.hex_uint32_t,
         cv.Optional(CONF_SKIP_UPDATES, default=0): cv.positive_int,
         cv.Optional(CONF_FORCE_NEW_RANGE, default=False): cv.boolean,
+        cv.Optional(CONF_POLL_INTERVAL): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_LAMBDA): cv.returning_lambda,
         cv.Optional(CONF_RESPONSE_SIZE, default=0): cv.positive_int,
     },
@@ -150,6 +154,10 @@ def validate_modbus_register(config):
         raise cv.Invalid(
             f" {CONF_REGISTER_TYPE} is a required property if '{CONF_CUSTOM_COMMAND}:' isn't used"
         )
+    if CONF_POLL_INTERVAL in config and config.get(CONF_SKIP_UPDATES, 0) != 0:
+        raise cv.Invalid(
+            f"can't use '{CONF_SKIP_UPDATES}:' together with '{CONF_POLL_INTERVAL}:'"
+        )
     return config
 
 
@@ -190,6 +198,9 @@ async def add_modbus_base_properties(
     if config[CONF_RESPONSE_SIZE] > 0:
         cg.add(var.set_register_size(config[CONF_RESPONSE_SIZE]))
 
+    if CONF_POLL_INTERVAL in config:
+        cg.add(var.set_poll_interval(config[CONF_POLL_INTERVAL]))
+
     if CONF_LAMBDA in config:
         template_ = await cg.process_lambda(
             config[CONF_LAMBDA],
@@ -209,6 +220,8 @@ async def add_modbus_base_properties(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID], config[CONF_COMMAND_THROTTLE])
     cg.add(var.set_command_throttle(config[CONF_COMMAND_THROTTLE]))
+    if config[CONF_MAX_REGISTER_GAP] != 0:
+        cg.add(var.set_max_register_gap(config[CONF_MAX_REGISTER_GAP]))
     await register_modbus_device(var, config)
 
 
@@ -1,15 +1,28 @@
 #include "modbus_controller.h"
 #include "esphome/core/application.h"
 #include "esphome/core/log.h"
+#include "esphome/core/controller.h"
 
 namespace esphome {
 namespace modbus_controller {
 
 static const char *const TAG = "modbus_controller";
 
+// How often the poll rates and response times are logged
+static const uint32_t POLL_STATS_INTERVAL = 60000;
+// Most registers a single read command can return
+static const uint8_t MAX_READ_REGISTERS = 125;
+
 void ModbusController::setup() {
   // Modbus::setup();
   this->create_register_ranges_();
+  this->coalesce_register_ranges_();
+  for (auto &r : this->register_ranges_) {
+    if (r.poll_interval != 0)
+      this->has_poll_intervals_ = true;
+  }
+  this->stats_start_ = millis();
+  this->set_interval(POLL_STATS_INTERVAL, [this]() { this->log_poll_stats_(); });
 }
 
 /*
@@ -32,24 +45,37 @@ bool ModbusController::send_next_command_() {
     if (!command->on_data_func || command->send_countdown < 1) {
       ESP_LOGD(TAG, "Modbus command to device=%d register=0x%02X countdown=%d removed from queue after send",
                this->address_, command->register_address, command->send_countdown);
-      command_queue_.pop_front();
+      this->pop_command_();
     }
   }
   return (!command_queue_.empty());
 }
 
 // Queue incoming response
-void ModbusController::on_modbus_data(const std::vector<uint8_t> &data) {
-  auto &current_command = this->command_queue_.front();
+void ModbusController::on_modbus_frame(const uint8_t *data, size_t len) {
+  if (this->command_queue_.empty())
+    return;
+  auto current_command = this->pop_command_();
   if (current_command != nullptr) {
+    uint32_t response_time = millis() - this->last_command_timestamp_;
+    this->response_count_++;
+    this->response_time_total_ += response_time;
+    this->response_time_max_ = std::max(this->response_time_max_, response_time);
     // Move the commandItem to the response queue
-    current_command->payload = data;
+    current_command->payload.assign(data, data + len);
     this->incoming_queue_.push(std::move(current_command));
     ESP_LOGV(TAG, "Modbus response queued");
-    command_queue_.pop_front();
   }
 }
 
+std::unique_ptr<ModbusCommandItem> ModbusController::pop_command_() {
+  auto command = std::move(this->command_queue_.front());
+  this->command_queue_.pop_front();
+  if (command != nullptr)
+    this->queued_commands_.erase(command->queue_key());
+  return command;
+}
+
 // Dispatch the response to the registered handler
 void ModbusController::process_modbus_data_(const ModbusCommandItem *response) {
   ESP_LOGV(TAG, "Process modbus response for address 0x%X size: %zu", response->register_address,
@@ -59,8 +85,11 @@ void ModbusController::process_modbus_data_(const ModbusCommandItem *response) {
 
 void ModbusController::on_modbus_error(uint8_t function_code, uint8_t exception_code) {
   ESP_LOGE(TAG, "Modbus error function code: 0x%X exception: %d ", function_code, exception_code);
+  this->error_count_++;
   // Remove pending command waiting for a response
-  auto &current_command = this->command_queue_.front();
+  if (this->command_queue_.empty())
+    return;
+  auto current_command = this->pop_command_();
   if (current_command != nullptr) {
     ESP_LOGE(TAG,
              "Modbus error - last command: function code=0x%X  register adddress = 0x%X  "
@@ -68,17 +97,21 @@ void ModbusController::on_modbus_error(uint8_t function_code, uint8_t exception_
              "payload size=%zu",
              function_code, current_command->register_address, current_command->register_count,
              current_command->payload.size());
-    command_queue_.pop_front();
   }
 }
 
-std::map<uint64_t, SensorItem *>::iterator ModbusController::find_register_(ModbusRegisterType register_type,
-                                                                            uint16_t start_address) {
+RegisterRange *ModbusController::find_range_(ModbusRegisterType register_type, uint16_t start_address) {
   auto vec_it = find_if(begin(register_ranges_), end(register_ranges_), [=](RegisterRange const &r) {
     return (r.start_address == start_address && r.register_type == register_type);
   });
+  return vec_it == register_ranges_.end() ? nullptr : &*vec_it;
+}
+
+std::map<uint64_t, SensorItem *>::iterator ModbusController::find_register_(ModbusRegisterType register_type,
+                                                                            uint16_t start_address) {
+  auto *vec_it = this->find_range_(register_type, start_address);
 
-  if (vec_it == register_ranges_.end()) {
+  if (vec_it == nullptr) {
     ESP_LOGE(TAG, "No matching range for sensor found - start_address :  0x%X", start_address);
   } else {
     auto map_it = sensormap_.find(vec_it->first_sensorkey);
@@ -94,7 +127,11 @@ std::map<uint64_t, SensorItem *>::iterator ModbusController::find_register_(Modb
 void ModbusController::on_register_data(ModbusRegisterType register_type, uint16_t start_address,
                                         const std::vector<uint8_t> &data) {
   ESP_LOGV(TAG, "data for register address : 0x%X : ", start_address);
+  auto *range = this->find_range_(register_type, start_address);
+  if (range != nullptr)
+    range->responses++;
 
+  StateBatch batch;
   auto map_it = find_register_(register_type, start_address);
   // loop through all sensors with the same start address
   while (map_it != sensormap_.end() && map_it->second->start_address == start_address) {
@@ -107,46 +144,79 @@ void ModbusController::on_register_data(ModbusRegisterType register_type, uint16
 
 void ModbusController::queue_command(const ModbusCommandItem &command) {
   // check if this commmand is already qeued.
-  // not very effective but the queue is never really large
-  for (auto &item : command_queue_) {
-    if (item->register_address == command.register_address && item->register_count == command.register_count &&
-        item->register_type == command.register_type) {
+  auto queued = this->queued_commands_.find(command.queue_key());
+  if (queued != this->queued_commands_.end()) {
+    if (command.is_write()) {
       ESP_LOGW(TAG, "Duplicate modbus command found");
-      // update the payload of the queued command
-      // replaces a previous command
-      item->payload = command.payload;
-      return;
+    } else {
+      ESP_LOGV(TAG, "Modbus read of 0x%X still queued", command.register_address);
     }
+    // update the payload of the queued command
+    // replaces a previous command
+    queued->second->payload = command.payload;
+    return;
+  }
+  auto item = make_unique<ModbusCommandItem>(command);
+  this->queued_commands_[item->queue_key()] = item.get();
+  if (!item->is_write()) {
+    this->command_queue_.push_back(std::move(item));
+    return;
   }
-  command_queue_.push_back(make_unique<ModbusCommandItem>(command));
+  // writes go before the queued reads, but never before the command at the front that may be waiting for a response
+  auto pos = this->command_queue_.begin();
+  if (pos != this->command_queue_.end())
+    pos++;
+  while (pos != this->command_queue_.end() && (*pos)->is_write())
+    pos++;
+  this->command_queue_.insert(pos, std::move(item));
 }
 
 void ModbusController::update_range_(RegisterRange &r) {
   ESP_LOGV(TAG, "Range : %X Size: %x (%d) skip: %d", r.start_address, r.register_count, (int) r.register_type,
            r.skip_updates_counter);
   if (r.skip_updates_counter == 0) {
-    // if a custom command is used the user supplied custom_data is only available in the SensorItem.
-    if (r.register_type == ModbusRegisterType::CUSTOM) {
-      auto it = this->find_register_(r.register_type, r.start_address);
-      if (it != sensormap_.end()) {
-        auto command_item = ModbusCommandItem::create_custom_command(
-            this, it->second->custom_data,
-            [this](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
-              this->on_register_data(ModbusRegisterType::CUSTOM, start_address, data);
-            });
-        command_item.register_address = it->second->start_address;
-        command_item.register_count = it->second->register_count;
-        command_item.function_code = ModbusFunctionCode::CUSTOM;
-        queue_command(command_item);
-      }
-    } else {
-      queue_command(ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count));
-    }
+    this->poll_range_(r);
     r.skip_updates_counter = r.skip_updates;  // reset counter to config value
   } else {
     r.skip_updates_counter--;
   }
 }
+
+void ModbusController::poll_range_(RegisterRange &r) {
+  // if a custom command is used the user supplied custom_data is only available in the SensorItem.
+  if (r.register_type == ModbusRegisterType::CUSTOM) {
+    auto it = this->find_register_(r.register_type, r.start_address);
+    if (it != sensormap_.end()) {
+      auto command_item = ModbusCommandItem::create_custom_command(
+          this, it->second->custom_data,
+          [this](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
+            this->on_register_data(ModbusRegisterType::CUSTOM, start_address, data);
+          });
+      command_item.register_address = it->second->start_address;
+      command_item.register_count = it->second->register_count;
+      command_item.function_code = ModbusFunctionCode::CUSTOM;
+      queue_command(command_item);
+    }
+  } else {
+    queue_command(ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count));
+  }
+}
+
+void ModbusController::poll_due_ranges_(uint32_t now) {
+  if (!this->has_poll_intervals_ || int32_t(now - this->next_poll_due_) < 0)
+    return;
+  uint32_t next_due = UINT32_MAX;
+  for (auto &r : this->register_ranges_) {
+    if (r.poll_interval == 0)
+      continue;
+    if (now - r.last_poll >= r.poll_interval) {
+      r.last_poll = now;
+      this->poll_range_(r);
+    }
+    next_due = std::min(next_due, r.poll_interval - (now - r.last_poll));
+  }
+  this->next_poll_due_ = now + next_due;
+}
 //
 // Queue the modbus requests to be send.
 // Once we get a response to the command it is removed from the queue and the next command is send
@@ -159,6 +229,9 @@ void ModbusController::update() {
   }
 
   for (auto &r : this->register_ranges_) {
+    // ranges with their own poll interval are polled from loop()
+    if (r.poll_interval != 0)
+      continue;
     ESP_LOGVV(TAG, "Updating range 0x%X", r.start_address);
     update_range_(r);
   }
@@ -178,6 +251,8 @@ size_t ModbusController::create_register_ranges_() {
   uint16_t current_start_address = ix->second->start_address;
   uint8_t buffer_offset = ix->second->offset;
   uint8_t skip_updates = ix->second->skip_updates;
+  uint32_t poll_interval = ix->second->poll_interval;
+  auto interval_of = [this](uint32_t interval) { return interval != 0 ? interval : this->get_update_interval(); };
   auto first_sensorkey = ix->second->getkey();
   total_register_count = 0;
   while (ix != sensormap_.end()) {
@@ -188,6 +263,7 @@ size_t ModbusController::create_register_ranges_() {
     // convert to an offset to the previous sensor (address 0x101 becomes address 0x100 offset 2 bytes)
     if (!ix->second->force_new_range && total_register_count >= 0 &&
         prev->second->register_type == ix->second->register_type &&
+        prev->second->poll_interval == ix->second->poll_interval &&
         prev->second->start_address + total_register_count == ix->second->start_address &&
         prev->second->start_address < ix->second->start_address) {
       ix->second->start_address = prev->second->start_address;
@@ -216,10 +292,14 @@ size_t ModbusController::create_register_ranges_() {
         r.first_sensorkey = first_sensorkey;
         r.skip_updates = skip_updates;
         r.skip_updates_counter = 0;
+        r.poll_interval = poll_interval == this->get_update_interval() ? 0 : poll_interval;
+        r.last_poll = 0;
+        r.responses = 0;
         ESP_LOGV(TAG, "Add range 0x%X %d skip:%d", r.start_address, r.register_count, r.skip_updates);
         register_ranges_.push_back(r);
       }
       skip_updates = ix->second->skip_updates;
+      poll_interval = ix->second->poll_interval;
       current_start_address = ix->second->start_address;
       first_sensorkey = ix->second->getkey();
       total_register_count = ix->second->register_count;
@@ -240,6 +320,9 @@ size_t ModbusController::create_register_ranges_() {
           skip_updates = ix->second->skip_updates;
         }
       }
+      // a register shared by items with different poll intervals is polled with the shortest one
+      if (ix->second->poll_interval != poll_interval)
+        poll_interval = std::min(interval_of(poll_interval), interval_of(ix->second->poll_interval));
     }
     prev = ix++;
   }
@@ -257,15 +340,68 @@ size_t ModbusController::create_register_ranges_() {
     r.first_sensorkey = first_sensorkey;
     r.skip_updates = skip_updates;
     r.skip_updates_counter = 0;
+    r.poll_interval = poll_interval == this->get_update_interval() ? 0 : poll_interval;
+    r.last_poll = 0;
+    r.responses = 0;
     ESP_LOGV(TAG, "Add last range 0x%X %d skip:%d", r.start_address, r.register_count, r.skip_updates);
     register_ranges_.push_back(r);
   }
   return register_ranges_.size();
 }
 
+void ModbusController::coalesce_register_ranges_() {
+  if (this->max_register_gap_ == 0 || this->register_ranges_.size() < 2)
+    return;
+  // Every request costs the request itself (8 bytes), the response header and crc (5 bytes), two 3.5 character
+  // frame gaps and the command throttle. Each register read in a gap costs 2 bytes in the response.
+  uint32_t throttle_bytes = uint32_t(this->command_throttle_) * this->parent_->get_baud_rate() / 11 / 1000;
+  uint32_t max_gap = std::min<uint32_t>(this->max_register_gap_, (8 + 5 + 7 + throttle_bytes) / 2);
+
+  std::vector<RegisterRange> ranges;
+  for (auto &r : this->register_ranges_) {
+    if (!ranges.empty()) {
+      auto &prev = ranges.back();
+      uint32_t prev_end = prev.start_address + prev.register_count;
+      uint32_t gap = r.start_address - prev_end;
+      bool registers = r.register_type == ModbusRegisterType::HOLDING || r.register_type == ModbusRegisterType::READ;
+      if (registers && prev.register_type == r.register_type && prev.poll_interval == r.poll_interval &&
+          prev.skip_updates == r.skip_updates && r.start_address >= prev_end && gap <= max_gap &&
+          r.start_address + r.register_count - prev.start_address <= MAX_READ_REGISTERS &&
+          !this->sensormap_[r.first_sensorkey]->force_new_range) {
+        ESP_LOGV(TAG, "Merge range 0x%X into 0x%X, reading %u unused registers", r.start_address, prev.start_address,
+                 gap);
+        // move the items to the merged range, the response data for them now starts further into the response
+        std::vector<SensorItem *> items;
+        for (auto it = this->sensormap_.find(r.first_sensorkey);
+             it != this->sensormap_.end() && it->second->register_type == r.register_type &&
+             it->second->start_address == r.start_address;
+             it = this->sensormap_.erase(it)) {
+          items.push_back(it->second);
+        }
+        for (auto *item : items) {
+          item->offset += (r.start_address - prev.start_address) * 2;
+          item->start_address = prev.start_address;
+          this->sensormap_[item->getkey()] = item;
+        }
+        prev.register_count = r.start_address + r.register_count - prev.start_address;
+        continue;
+      }
+    }
+    ranges.push_back(r);
+  }
+  this->register_ranges_ = std::move(ranges);
+}
+
 void ModbusController::dump_config() {
   ESP_LOGCONFIG(TAG, "ModbusController:");
   ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
+  if (this->max_register_gap_ != 0)
+    ESP_LOGCONFIG(TAG, "  Max Register Gap: %u", this->max_register_gap_);
+  for (auto &r : this->register_ranges_) {
+    if (r.poll_interval != 0)
+      ESP_LOGCONFIG(TAG, "  Range 0x%X (%u registers) Poll Interval: %u ms", r.start_address, r.register_count,
+                    r.poll_interval);
+  }
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
   ESP_LOGCONFIG(TAG, "sensormap");
   for (auto &it : sensormap_) {
@@ -285,10 +421,33 @@ void ModbusController::loop() {
 
   } else {
     // all messages processed send pending commmands
+    this->poll_due_ranges_(millis());
     send_next_command_();
   }
 }
 
+void ModbusController::log_poll_stats_() {
+  const uint32_t now = millis();
+  float seconds = (now - this->stats_start_) / 1000.0f;
+  if (this->response_count_ != 0) {
+    ESP_LOGD(TAG, "Device 0x%02X: %.2f responses/s, response time avg %u ms max %u ms, %u errors", this->address_,
+             this->response_count_ / seconds, this->response_time_total_ / this->response_count_,
+             this->response_time_max_, this->error_count_);
+  } else {
+    ESP_LOGD(TAG, "Device 0x%02X: no responses, %u errors", this->address_, this->error_count_);
+  }
+  for (auto &r : this->register_ranges_) {
+    ESP_LOGV(TAG, "  Range 0x%X: %.2f polls/s (configured %.2f/s)", r.start_address, r.responses / seconds,
+             1000.0f / (r.poll_interval != 0 ? r.poll_interval : this->get_update_interval() * (r.skip_updates + 1)));
+    r.responses = 0;
+  }
+  this->stats_start_ = now;
+  this->response_count_ = 0;
+  this->response_time_total_ = 0;
+  this->response_time_max_ = 0;
+  this->error_count_ = 0;
+}
+
 void ModbusController::on_write_register_response(ModbusRegisterType register_type, uint16_t start_address,
                                                   const std::vector<uint8_t> &data) {
   ESP_LOGV(TAG, "Command ACK 0x%X %d ", get_data<uint16_t>(data, 0), get_data<int16_t>(data, 1));
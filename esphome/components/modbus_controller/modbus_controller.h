@@ -8,6 +8,7 @@
 #include <list>
 #include <map>
 #include <queue>
+#include <unordered_map>
 #include <vector>
 
 namespace esphome {
@@ -69,6 +70,9 @@ struct RegisterRange {
   uint8_t skip_updates;  // the config value
   uint64_t first_sensorkey;
   uint8_t skip_updates_counter;  // the running value
+  uint32_t poll_interval;        // in ms, 0 if polled with the update interval
+  uint32_t last_poll;
+  uint16_t responses;  // since the last poll statistics were logged
 } __attribute__((packed));
 
 inline ModbusFunctionCode modbus_register_read_function(ModbusRegisterType reg_type) {
@@ -259,6 +263,8 @@ class SensorItem {
   }
   // Override register size for modbus devices not using 1 register for one dword
   void set_register_size(uint8_t register_size) { response_bytes = register_size; }
+  // Poll this item every poll_interval ms instead of with the update interval of the controller
+  void set_poll_interval(uint32_t poll_interval) { this->poll_interval = poll_interval; }
   ModbusRegisterType register_type;
   SensorValueType sensor_value_type;
   uint16_t start_address;
@@ -267,6 +273,7 @@ class SensorItem {
   uint8_t register_count;
   uint8_t response_bytes{0};
   uint8_t skip_updates;
+  uint32_t poll_interval{0};
   std::vector<uint8_t> custom_data{};
   bool force_new_range{false};
 };
@@ -287,6 +294,18 @@ class ModbusCommandItem {
   // wrong commands (esp. custom commands) can block the send queue
   // limit the number of repeats
   uint8_t send_countdown{MAX_SEND_REPEATS};
+  /// commands with the same key replace each other in the send queue
+  uint64_t queue_key() const {
+    return uint64_t(function_code) << 40 | uint64_t(register_type) << 32 | uint32_t(register_address) << 16 |
+           register_count;
+  }
+  /// writes are sent before the queued reads
+  bool is_write() const {
+    return function_code == ModbusFunctionCode::WRITE_SINGLE_COIL ||
+           function_code == ModbusFunctionCode::WRITE_SINGLE_REGISTER ||
+           function_code == ModbusFunctionCode::WRITE_MULTIPLE_COILS ||
+           function_code == ModbusFunctionCode::WRITE_MULTIPLE_REGISTERS;
+  }
   /// factory methods
   /** Create modbus read command
    *  Function code 02-04
@@ -368,6 +387,7 @@ class ModbusCommandItem {
  *
  * all sensor items (sensors, switches, binarysensor ...) are parsed in modbus address ranges.
  * when esphome calls ModbusController::Update the commands for each range are created and sent
+ * Ranges with their own poll interval are queued from loop() once they're due.
  * Responses for the commands are dispatched to the modbus sensor items.
  */
 
@@ -384,7 +404,7 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   /// Registers a sensor with the controller. Called by esphomes code generator
   void add_sensor_item(SensorItem *item) { sensormap_[item->getkey()] = item; }
   /// called when a modbus response was prased without errors
-  void on_modbus_data(const std::vector<uint8_t> &data) override;
+  void on_modbus_frame(const uint8_t *data, size_t len) override;
   /// called when a modbus error response was received
   void on_modbus_error(uint8_t function_code, uint8_t exception_code) override;
   /// default delegate called by process_modbus_data when a response has retrieved from the incoming queue
@@ -395,14 +415,28 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
                                   const std::vector<uint8_t> &data);
   /// called by esphome generated code to set the command_throttle period
   void set_command_throttle(uint16_t command_throttle) { this->command_throttle_ = command_throttle; }
+  /// called by esphome generated code to allow reading up to max_register_gap unused registers between two ranges
+  void set_max_register_gap(uint8_t max_register_gap) { this->max_register_gap_ = max_register_gap; }
 
  protected:
   /// parse sensormap_ and create range of sequential addresses
   size_t create_register_ranges_();
+  /// merge ranges with small gaps in between when reading the gap is cheaper than another request
+  void coalesce_register_ranges_();
+  /// find the range starting at start_address
+  RegisterRange *find_range_(ModbusRegisterType register_type, uint16_t start_address);
   // find register in sensormap. Returns iterator with all registers having the same start address
   std::map<uint64_t, SensorItem *>::iterator find_register_(ModbusRegisterType register_type, uint16_t start_address);
-  /// submit the read command for the address range to the send queue
+  /// submit the read command for the address range to the send queue, honoring skip_updates
   void update_range_(RegisterRange &r);
+  /// submit the read command for the address range to the send queue
+  void poll_range_(RegisterRange &r);
+  /// queue the ranges with their own poll interval that are due
+  void poll_due_ranges_(uint32_t now);
+  /// remove the command at the front of the send queue
+  std::unique_ptr<ModbusCommandItem> pop_command_();
+  /// log the poll rates and response times since the last call
+  void log_poll_stats_();
   /// parse incoming modbus data
   void process_modbus_data_(const ModbusCommandItem *response);
   /// send the next modbus command from the send queue
@@ -418,12 +452,24 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   std::vector<RegisterRange> register_ranges_;
   /// Hold the pending requests to be sent
   std::list<std::unique_ptr<ModbusCommandItem>> command_queue_;
+  /// The queued commands by their queue_key()
+  std::unordered_map<uint64_t, ModbusCommandItem *> queued_commands_;
   /// modbus response data waiting to get processed
   std::queue<std::unique_ptr<ModbusCommandItem>> incoming_queue_;
   /// when was the last send operation
   uint32_t last_command_timestamp_;
   /// min time in ms between sending modbus commands
   uint16_t command_throttle_;
+  uint8_t max_register_gap_{0};
+  /// when the next range with its own poll interval is due
+  uint32_t next_poll_due_{0};
+  bool has_poll_intervals_{false};
+  /// response statistics since the last time they were logged
+  uint32_t stats_start_{0};
+  uint32_t response_count_{0};
+  uint32_t response_time_total_{0};
+  uint32_t response_time_max_{0};
+  uint32_t error_count_{0};
 };
 
 /** convert vector<uint8_t> response payload to float
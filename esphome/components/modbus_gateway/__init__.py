@@ -0,0 +1,37 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import modbus
+from esphome.const import CONF_ID, CONF_PORT
+
+DEPENDENCIES = ["network"]
+AUTO_LOAD = ["socket", "modbus"]
+MULTI_CONF = True
+
+CONF_CACHE_TIME = "cache_time"
+CONF_MAX_CONNECTIONS = "max_connections"
+
+modbus_gateway_ns = cg.esphome_ns.namespace("modbus_gateway")
+ModbusGateway = modbus_gateway_ns.class_("ModbusGateway", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ModbusGateway),
+        cv.GenerateID(modbus.CONF_MODBUS_ID): cv.use_id(modbus.Modbus),
+        cv.Optional(CONF_PORT, default=502): cv.port,
+        cv.Optional(CONF_MAX_CONNECTIONS, default=2): cv.int_range(min=1, max=8),
+        cv.Optional(
+            CONF_CACHE_TIME, default="1s"
+        ): cv.positive_time_period_milliseconds,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    parent = await cg.get_variable(config[modbus.CONF_MODBUS_ID])
+    cg.add(var.set_parent(parent))
+    cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_max_connections(config[CONF_MAX_CONNECTIONS]))
+    cg.add(var.set_cache_time(config[CONF_CACHE_TIME]))
@@ -0,0 +1,297 @@
+#include "modbus_gateway.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace esphome {
+namespace modbus_gateway {
+
+static const char *const TAG = "modbus_gateway";
+
+// transaction id, protocol id, length, unit id
+static const size_t MBAP_HEADER_SIZE = 7;
+// unit id and the longest PDU
+static const size_t MAX_FRAME_SIZE = 254;
+// requests a client may have waiting for the bus before it gets busy responses
+static const size_t MAX_QUEUED_REQUESTS = 8;
+static const size_t MAX_CACHE_ENTRIES = 8;
+
+static const uint8_t EXCEPTION_SERVER_DEVICE_BUSY = 0x06;
+static const uint8_t EXCEPTION_GATEWAY_TARGET_FAILED = 0x0B;
+
+static bool is_read(uint8_t function_code) { return function_code >= 0x01 && function_code <= 0x04; }
+
+void ModbusGateway::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up Modbus TCP gateway...");
+  this->socket_ = socket::socket(AF_INET, SOCK_STREAM, 0);
+  if (this->socket_ == nullptr) {
+    ESP_LOGW(TAG, "Could not create socket.");
+    this->mark_failed();
+    return;
+  }
+  int enable = 1;
+  int err = this->socket_->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set reuseaddr: errno %d", err);
+    // we can still continue
+  }
+  err = this->socket_->setblocking(false);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", err);
+    this->mark_failed();
+    return;
+  }
+
+  struct sockaddr_in server;
+  memset(&server, 0, sizeof(server));
+  server.sin_family = AF_INET;
+  server.sin_addr.s_addr = ESPHOME_INADDR_ANY;
+  server.sin_port = htons(this->port_);
+
+  err = this->socket_->bind((struct sockaddr *) &server, sizeof(server));
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to bind: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+  err = this->socket_->listen(this->max_connections_);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to listen: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+
+  this->parent_->set_frame_interceptor(
+      [this](const uint8_t *frame, size_t len) { return this->on_rtu_frame_(frame, len); });
+}
+
+void ModbusGateway::loop() {
+  this->accept_clients_();
+  for (auto &client : this->clients_)
+    this->read_client_(client.get());
+
+  auto new_end = std::partition(this->clients_.begin(), this->clients_.end(),
+                                [](const std::unique_ptr<Client> &client) { return !client->remove; });
+  for (auto it = new_end; it != this->clients_.end(); ++it) {
+    ESP_LOGD(TAG, "Disconnected %s", (*it)->peername.c_str());
+    if (it->get() == this->in_flight_client_)
+      this->in_flight_client_ = nullptr;
+  }
+  this->clients_.erase(new_end, this->clients_.end());
+
+  if (this->in_flight_) {
+    if (this->response_received_) {
+      this->finish_request_(this->response_.data(), this->response_.size());
+    } else if (this->parent_->waiting_for_response != this->in_flight_request_.frame[0]) {
+      // the bus gave up waiting for the response
+      ESP_LOGW(TAG, "No response from device 0x%02X", this->in_flight_request_.frame[0]);
+      uint8_t pdu[2] = {uint8_t(this->in_flight_request_.frame[1] | 0x80), EXCEPTION_GATEWAY_TARGET_FAILED};
+      this->finish_request_(pdu, sizeof(pdu));
+    }
+    return;
+  }
+  if (this->parent_->waiting_for_response != 0)
+    return;
+  if (this->yield_) {
+    this->yield_ = false;
+    return;
+  }
+  this->send_next_request_();
+}
+
+void ModbusGateway::accept_clients_() {
+  while (true) {
+    struct sockaddr_storage source_addr;
+    socklen_t addr_len = sizeof(source_addr);
+    auto sock = this->socket_->accept((struct sockaddr *) &source_addr, &addr_len);
+    if (!sock)
+      break;
+    if (this->clients_.size() >= this->max_connections_) {
+      ESP_LOGW(TAG, "Rejecting %s, maximum number of connections (%u) reached", sock->getpeername().c_str(),
+               this->max_connections_);
+      sock->close();
+      continue;
+    }
+    int err = sock->setblocking(false);
+    if (err != 0) {
+      ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", err);
+      sock->close();
+      continue;
+    }
+    int enable = 1;
+    sock->setsockopt(IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(int));
+    auto client = make_unique<Client>();
+    client->peername = sock->getpeername();
+    client->socket = std::move(sock);
+    ESP_LOGD(TAG, "Accepted %s", client->peername.c_str());
+    this->clients_.push_back(std::move(client));
+  }
+}
+
+void ModbusGateway::read_client_(Client *client) {
+  while (!client->remove) {
+    uint8_t buf[MBAP_HEADER_SIZE - 1 + MAX_FRAME_SIZE];
+    ssize_t received = client->socket->read(buf, sizeof(buf));
+    if (received == -1) {
+      if (errno != EWOULDBLOCK && errno != EAGAIN) {
+        ESP_LOGW(TAG, "Socket read failed with errno %d", errno);
+        client->remove = true;
+      }
+      break;
+    }
+    if (received == 0) {
+      client->remove = true;
+      break;
+    }
+    client->rx_buffer.insert(client->rx_buffer.end(), buf, buf + received);
+  }
+
+  size_t at = 0;
+  while (!client->remove && client->rx_buffer.size() - at >= MBAP_HEADER_SIZE) {
+    const uint8_t *adu = &client->rx_buffer[at];
+    uint16_t transaction_id = encode_uint16(adu[0], adu[1]);
+    uint16_t protocol_id = encode_uint16(adu[2], adu[3]);
+    uint16_t length = encode_uint16(adu[4], adu[5]);
+    if (protocol_id != 0 || length < 2 || length > MAX_FRAME_SIZE) {
+      ESP_LOGW(TAG, "Invalid Modbus TCP header from %s, closing", client->peername.c_str());
+      client->remove = true;
+      break;
+    }
+    if (client->rx_buffer.size() - at < 6u + length)
+      break;
+    this->handle_request_(client, transaction_id, adu + 6, length);
+    at += 6u + length;
+  }
+  client->rx_buffer.erase(client->rx_buffer.begin(), client->rx_buffer.begin() + at);
+}
+
+void ModbusGateway::handle_request_(Client *client, uint16_t transaction_id, const uint8_t *frame, size_t len) {
+  uint8_t unit = frame[0];
+  uint8_t function_code = frame[1];
+  ESP_LOGV(TAG, "Request from %s: %s", client->peername.c_str(), format_hex_pretty(frame, len).c_str());
+  if (is_read(function_code) && len == 6) {
+    auto *entry = this->find_cache_entry_(frame);
+    if (entry != nullptr && millis() - entry->time < this->cache_time_) {
+      ESP_LOGV(TAG, "Response from cache");
+      this->send_response_(client, transaction_id, unit, entry->response.data(), entry->response.size());
+      return;
+    }
+  } else {
+    // anything else may change what's read, forget what was read from the device
+    this->cache_.erase(std::remove_if(this->cache_.begin(), this->cache_.end(),
+                                      [unit](const CacheEntry &entry) { return entry.request[0] == unit; }),
+                       this->cache_.end());
+  }
+  if (client->requests.size() >= MAX_QUEUED_REQUESTS) {
+    ESP_LOGW(TAG, "Too many requests from %s", client->peername.c_str());
+    this->send_exception_(client, transaction_id, unit, function_code, EXCEPTION_SERVER_DEVICE_BUSY);
+    return;
+  }
+  client->requests.push(Request{transaction_id, std::vector<uint8_t>(frame, frame + len)});
+}
+
+void ModbusGateway::send_next_request_() {
+  // take turns between the clients
+  for (size_t i = 0; i < this->clients_.size(); i++) {
+    size_t index = (this->next_client_ + i) % this->clients_.size();
+    auto *client = this->clients_[index].get();
+    if (client->requests.empty())
+      continue;
+    this->next_client_ = index + 1;
+    this->in_flight_client_ = client;
+    this->in_flight_request_ = std::move(client->requests.front());
+    client->requests.pop();
+    this->response_received_ = false;
+    this->parent_->send_raw(this->in_flight_request_.frame);
+    // broadcasts don't get a response
+    this->in_flight_ = this->in_flight_request_.frame[0] != 0;
+    this->yield_ = true;
+    return;
+  }
+}
+
+bool ModbusGateway::on_rtu_frame_(const uint8_t *frame, size_t len) {
+  if (!this->in_flight_ || this->response_received_ || frame[0] != this->in_flight_request_.frame[0])
+    return false;
+  this->response_.assign(frame + 1, frame + len);
+  this->response_received_ = true;
+  return true;
+}
+
+void ModbusGateway::finish_request_(const uint8_t *pdu, size_t len) {
+  this->in_flight_ = false;
+  if ((pdu[0] & 0x80) == 0 && is_read(pdu[0]) && this->in_flight_request_.frame.size() == 6)
+    this->update_cache_(this->in_flight_request_, pdu, len);
+  // the client may have disconnected in the meantime
+  if (this->in_flight_client_ != nullptr) {
+    this->send_response_(this->in_flight_client_, this->in_flight_request_.transaction_id,
+                         this->in_flight_request_.frame[0], pdu, len);
+  }
+  this->in_flight_client_ = nullptr;
+}
+
+void ModbusGateway::send_response_(Client *client, uint16_t transaction_id, uint8_t unit, const uint8_t *pdu,
+                                   size_t len) {
+  uint8_t adu[MBAP_HEADER_SIZE + MAX_FRAME_SIZE - 1];
+  len = std::min(len, MAX_FRAME_SIZE - 1);
+  adu[0] = transaction_id >> 8;
+  adu[1] = transaction_id;
+  adu[2] = 0;
+  adu[3] = 0;
+  adu[4] = (len + 1) >> 8;
+  adu[5] = len + 1;
+  adu[6] = unit;
+  memcpy(&adu[MBAP_HEADER_SIZE], pdu, len);
+  ssize_t sent = client->socket->write(adu, MBAP_HEADER_SIZE + len);
+  if (sent != ssize_t(MBAP_HEADER_SIZE + len)) {
+    ESP_LOGW(TAG, "Socket write failed with errno %d", errno);
+    client->remove = true;
+  }
+}
+
+void ModbusGateway::send_exception_(Client *client, uint16_t transaction_id, uint8_t unit, uint8_t function_code,
+                                    uint8_t exception_code) {
+  uint8_t pdu[2] = {uint8_t(function_code | 0x80), exception_code};
+  this->send_response_(client, transaction_id, unit, pdu, sizeof(pdu));
+}
+
+ModbusGateway::CacheEntry *ModbusGateway::find_cache_entry_(const uint8_t *frame) {
+  for (auto &entry : this->cache_) {
+    if (memcmp(entry.request.data(), frame, entry.request.size()) == 0)
+      return &entry;
+  }
+  return nullptr;
+}
+
+void ModbusGateway::update_cache_(const Request &request, const uint8_t *pdu, size_t len) {
+  if (this->cache_time_ == 0)
+    return;
+  auto *entry = this->find_cache_entry_(request.frame.data());
+  if (entry == nullptr) {
+    if (this->cache_.size() < MAX_CACHE_ENTRIES) {
+      this->cache_.emplace_back();
+      entry = &this->cache_.back();
+    } else {
+      // replace the oldest entry
+      entry = &*std::min_element(this->cache_.begin(), this->cache_.end(),
+                                 [](const CacheEntry &a, const CacheEntry &b) { return a.time < b.time; });
+    }
+    std::copy(request.frame.begin(), request.frame.end(), entry->request.begin());
+  }
+  entry->response.assign(pdu, pdu + len);
+  entry->time = millis();
+}
+
+void ModbusGateway::dump_config() {
+  ESP_LOGCONFIG(TAG, "Modbus TCP Gateway:");
+  ESP_LOGCONFIG(TAG, "  Port: %u", this->port_);
+  ESP_LOGCONFIG(TAG, "  Max Connections: %u", this->max_connections_);
+  ESP_LOGCONFIG(TAG, "  Cache Time: %u ms", this->cache_time_);
+}
+
+}  // namespace modbus_gateway
+}  // namespace esphome
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/modbus/modbus.h"
+#include "esphome/components/socket/socket.h"
+
+#include <array>
+#include <memory>
+#include <queue>
+#include <vector>
+
+namespace esphome {
+namespace modbus_gateway {
+
+/** Modbus TCP server that forwards the requests to the devices on a Modbus RTU bus.
+ *
+ * The requests share the bus with the local modbus_controller devices: one request is sent whenever the bus is free,
+ * taking turns between the TCP clients, and after each of them the bus is left to the local devices for one loop.
+ * Responses to reads are cached for cache_time, so SCADA systems polling the same range don't hit the serial line
+ * every time.
+ */
+class ModbusGateway : public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  void set_parent(modbus::Modbus *parent) { this->parent_ = parent; }
+  void set_port(uint16_t port) { this->port_ = port; }
+  void set_max_connections(uint8_t max_connections) { this->max_connections_ = max_connections; }
+  void set_cache_time(uint32_t cache_time) { this->cache_time_ = cache_time; }
+
+ protected:
+  struct Request {
+    uint16_t transaction_id;
+    /// unit id and PDU, the RTU frame without crc
+    std::vector<uint8_t> frame;
+  };
+  struct Client {
+    std::unique_ptr<socket::Socket> socket;
+    std::string peername;
+    std::vector<uint8_t> rx_buffer;
+    std::queue<Request> requests;
+    bool remove{false};
+  };
+  struct CacheEntry {
+    /// unit id and the read request PDU
+    std::array<uint8_t, 6> request;
+    std::vector<uint8_t> response;
+    uint32_t time;
+  };
+
+  void accept_clients_();
+  void read_client_(Client *client);
+  void handle_request_(Client *client, uint16_t transaction_id, const uint8_t *frame, size_t len);
+  void send_next_request_();
+  void finish_request_(const uint8_t *pdu, size_t len);
+  void send_response_(Client *client, uint16_t transaction_id, uint8_t unit, const uint8_t *pdu, size_t len);
+  void send_exception_(Client *client, uint16_t transaction_id, uint8_t unit, uint8_t function_code,
+                       uint8_t exception_code);
+  bool on_rtu_frame_(const uint8_t *frame, size_t len);
+  CacheEntry *find_cache_entry_(const uint8_t *frame);
+  void update_cache_(const Request &request, const uint8_t *pdu, size_t len);
+
+  modbus::Modbus *parent_;
+  uint16_t port_{502};
+  uint8_t max_connections_{2};
+  uint32_t cache_time_{1000};
+  std::unique_ptr<socket::Socket> socket_;
+  std::vector<std::unique_ptr<Client>> clients_;
+  std::vector<CacheEntry> cache_;
+  /// the client that gets the next turn on the bus
+  size_t next_client_{0};
+  /// the request that was sent on the bus and the client it's for
+  Client *in_flight_client_{nullptr};
+  Request in_flight_request_{};
+  bool in_flight_{false};
+  std::vector<uint8_t> response_;
+  bool response_received_{false};
+  /// leave the free bus to the local devices for one loop
+  bool yield_{false};
+};
+
+}  // namespace modbus_gateway
+}  // namespace esphome
@@ -8,10 +8,13 @@ MonochromaticLightOutput = monochromatic_ns.class_(
     "MonochromaticLightOutput", light.LightOutput
 )
 
+CONF_HARDWARE_TRANSITION = "hardware_transition"
+
 CONFIG_SCHEMA = light.BRIGHTNESS_ONLY_LIGHT_SCHEMA.extend(
     {
         cv.GenerateID(CONF_OUTPUT_ID): cv.declare_id(MonochromaticLightOutput),
         cv.Required(CONF_OUTPUT): cv.use_id(output.FloatOutput),
+        cv.Optional(CONF_HARDWARE_TRANSITION, default=False): cv.boolean,
     }
 )
 
@@ -22,3 +25,5 @@ async def to_code(config):
 
     out = await cg.get_variable(config[CONF_OUTPUT])
     cg.add(var.set_output(out))
+    if config[CONF_HARDWARE_TRANSITION]:
+        cg.add(var.set_hardware_transition(True))
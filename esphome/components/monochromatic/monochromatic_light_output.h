@@ -3,6 +3,8 @@
 #include "esphome/core/component.h"
 #include "esphome/components/output/float_output.h"
 #include "esphome/components/light/light_output.h"
+#include "esphome/components/light/light_state.h"
+#include "esphome/components/light/light_transformer.h"
 
 namespace esphome {
 namespace monochromatic {
@@ -10,20 +12,68 @@ namespace monochromatic {
 class MonochromaticLightOutput : public light::LightOutput {
  public:
   void set_output(output::FloatOutput *output) { output_ = output; }
+  /// Let the output fade in hardware during transitions (if it supports that).
+  void set_hardware_transition(bool hardware_transition) { hardware_transition_ = hardware_transition; }
   light::LightTraits get_traits() override {
     auto traits = light::LightTraits();
     traits.set_supported_color_modes({light::ColorMode::BRIGHTNESS});
     return traits;
   }
+  void setup_state(light::LightState *state) override { state_ = state; }
+  std::unique_ptr<light::LightTransformer> create_default_transition() override;
   void write_state(light::LightState *state) override {
+    // the output is fading on its own
+    if (this->fading_)
+      return;
     float bright;
     state->current_values_as_brightness(&bright);
     this->output_->set_level(bright);
   }
 
  protected:
+  friend class MonochromaticFadeTransformer;
+
   output::FloatOutput *output_;
+  light::LightState *state_{nullptr};
+  bool hardware_transition_{false};
+  bool fading_{false};
 };
 
+/** Transition that hands the whole fade to the output.
+ *
+ * The values reported to the light state still follow the (linear) transition, but aren't written to the output.
+ */
+class MonochromaticFadeTransformer : public light::LightTransformer {
+ public:
+  explicit MonochromaticFadeTransformer(MonochromaticLightOutput &light) : light_(light) {}
+  ~MonochromaticFadeTransformer() override { this->light_.fading_ = false; }
+
+  void start() override {
+    float bright;
+    this->target_values_.as_brightness(&bright, this->light_.state_->get_gamma_correct());
+    this->light_.output_->fade_level(bright, this->length_);
+    this->light_.fading_ = true;
+  }
+  optional<light::LightColorValues> apply() override {
+    return light::LightColorValues::lerp(this->start_values_, this->target_values_, this->get_progress_());
+  }
+  void stop() override {
+    // make sure the output ends up exactly at the target (and the power supply is released when off)
+    this->light_.fading_ = false;
+    float bright;
+    this->target_values_.as_brightness(&bright, this->light_.state_->get_gamma_correct());
+    this->light_.output_->set_level(bright);
+  }
+
+ protected:
+  MonochromaticLightOutput &light_;
+};
+
+inline std::unique_ptr<light::LightTransformer> MonochromaticLightOutput::create_default_transition() {
+  if (this->hardware_transition_ && this->state_ != nullptr && this->output_->supports_fade())
+    return make_unique<MonochromaticFadeTransformer>(*this);
+  return LightOutput::create_default_transition();
+}
+
 }  // namespace monochromatic
 }  // namespace esphome
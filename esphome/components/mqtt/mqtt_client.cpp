@@ -7,6 +7,7 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/components/network/util.h"
+#include <algorithm>
 #include <utility>
 #ifdef USE_LOGGER
 #include "esphome/components/logger/logger.h"
@@ -20,6 +21,13 @@ namespace mqtt {
 
 static const char *const TAG = "mqtt";
 
+/// Messages that can be waiting to be published, see MQTTClientComponent::publish().
+static const size_t MAX_OUTBOUND_MESSAGES = 16;
+/// Discovery messages published per loop iteration are limited to this many bytes (but at least one is sent).
+static const size_t DISCOVERY_BYTES_PER_LOOP = 1024;
+/// Discovery messages that are only built to check whether they changed, per loop iteration.
+static const uint8_t DISCOVERY_CHECKS_PER_LOOP = 8;
+
 MQTTClientComponent::MQTTClientComponent() {
   global_mqtt_client = this;
   this->credentials_.client_id = App.get_name() + "-" + get_mac_address();
@@ -38,7 +46,8 @@ void MQTTClientComponent::setup() {
 
     // MQTT fully received
     if (len + index == total) {
-      this->on_message(topic, this->payload_buffer_);
+      // this is called in the LWiP thread (the AsyncTCP task on ESP32), the callbacks run from loop()
+      this->queue_message_(topic);
       this->payload_buffer_.clear();
     }
   });
@@ -48,15 +57,29 @@ void MQTTClientComponent::setup() {
   });
 #ifdef USE_LOGGER
   if (this->is_log_message_enabled() && logger::global_logger != nullptr) {
-    logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      if (level <= this->log_level_ && this->is_connected()) {
-        this->publish(this->log_message_.topic, message, strlen(message), this->log_message_.qos,
-                      this->log_message_.retain);
-      }
-    });
+    logger::global_logger->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) {
+          if (level <= this->log_level_ && this->is_connected()) {
+            this->publish(this->log_message_.topic, message, strlen(message), this->log_message_.qos,
+                          this->log_message_.retain);
+          }
+        },
+        [this]() { return this->is_connected() ? this->log_level_ : ESPHOME_LOG_LEVEL_NONE; });
   }
 #endif
 
+  this->discovery_pref_ = global_preferences->make_preference<uint32_t>(fnv1_hash("mqtt_discovery"));
+  if (!this->discovery_pref_.load(&this->discovery_published_hash_))
+    this->discovery_published_hash_ = 0;
+  if (this->is_discovery_enabled()) {
+    // Home Assistant announces itself when it connects to the broker, give it all discovery info again then
+    this->subscribe(this->discovery_info_.prefix + "/status",
+                    [this](const std::string &topic, const std::string &payload) {
+                      if (payload == "online")
+                        this->start_discovery_(true);
+                    });
+  }
+
   this->last_connected_ = millis();
   this->start_dnslookup_();
 }
@@ -220,9 +243,11 @@ void MQTTClientComponent::check_connected() {
 
   for (MQTTComponent *component : this->children_)
     component->schedule_resend_state();
+  this->start_discovery_(false);
 }
 
 void MQTTClientComponent::loop() {
+  this->dispatch_queued_messages_();
   if (this->disconnect_reason_.has_value()) {
     const LogString *reason_s;
     switch (*this->disconnect_reason_) {
@@ -287,6 +312,9 @@ void MQTTClientComponent::loop() {
 
         this->last_connected_ = now;
         this->resubscribe_subscriptions_();
+        this->drain_outbound_();
+        if (this->discovery_state_ != MQTTDiscoveryState::IDLE && this->outbound_.empty())
+          this->process_discovery_();
       }
       break;
   }
@@ -342,12 +370,13 @@ void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t ca
       .resubscribe_timeout = 0,
   };
   this->resubscribe_subscription_(&subscription);
-  this->subscriptions_.push_back(subscription);
+  this->subscriptions_.push_back(std::move(subscription));
+  this->add_subscription_to_trie_(this->subscriptions_.size() - 1);
 }
 
 void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_json_callback_t &callback, uint8_t qos) {
   auto f = [callback](const std::string &topic, const std::string &payload) {
-    json::parse_json(payload, [topic, callback](JsonObject root) { callback(topic, root); });
+    json::parse_json(payload, [&topic, &callback](JsonObject root) { callback(topic, root); });
   };
   MQTTSubscription subscription{
       .topic = topic,
@@ -357,7 +386,8 @@ void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_js
       .resubscribe_timeout = 0,
   };
   this->resubscribe_subscription_(&subscription);
-  this->subscriptions_.push_back(subscription);
+  this->subscriptions_.push_back(std::move(subscription));
+  this->add_subscription_to_trie_(this->subscriptions_.size() - 1);
 }
 
 void MQTTClientComponent::unsubscribe(const std::string &topic) {
@@ -378,6 +408,44 @@ void MQTTClientComponent::unsubscribe(const std::string &topic) {
     else
       ++it;
   }
+  this->rebuild_subscription_trie_();
+}
+
+void MQTTClientComponent::add_subscription_to_trie_(size_t index) {
+  const std::string &topic = this->subscriptions_[index].topic;
+  MQTTTopicNode *node = &this->subscription_trie_;
+  size_t start = 0;
+  while (true) {
+    size_t end = topic.find('/', start);
+    if (end == std::string::npos)
+      end = topic.size();
+
+    MQTTTopicNode *child = nullptr;
+    for (auto &candidate : node->children) {
+      if (candidate->level.compare(0, std::string::npos, topic, start, end - start) == 0) {
+        child = candidate.get();
+        break;
+      }
+    }
+    if (child == nullptr) {
+      node->children.push_back(make_unique<MQTTTopicNode>());
+      child = node->children.back().get();
+      child->level = topic.substr(start, end - start);
+    }
+    node = child;
+
+    if (end == topic.size())
+      break;
+    start = end + 1;
+  }
+  node->subscriptions.push_back(index);
+}
+
+void MQTTClientComponent::rebuild_subscription_trie_() {
+  // Removing subscriptions shifts the indices of all later ones, so it's easiest to start over
+  this->subscription_trie_.children.clear();
+  for (size_t i = 0; i < this->subscriptions_.size(); i++)
+    this->add_subscription_to_trie_(i);
 }
 
 // Publish
@@ -387,29 +455,98 @@ bool MQTTClientComponent::publish(const std::string &topic, const std::string &p
 
 bool MQTTClientComponent::publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
                                   bool retain) {
-  if (!this->is_connected()) {
-    // critical components will re-transmit their messages
-    return false;
+  return this->publish_(topic, payload, payload_length, qos, retain, false);
+}
+
+bool MQTTClientComponent::publish_state(const std::string &topic, const std::string &payload, uint8_t qos,
+                                        bool retain) {
+  return this->publish_(topic, payload.data(), payload.size(), qos, retain, true);
+}
+
+bool MQTTClientComponent::publish_(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
+                                   bool retain, bool state) {
+  if (topic == this->log_message_.topic) {
+    // Never queue log messages, logging that the queue is full would queue another one
+    if (!this->is_connected())
+      return false;
+    return this->publish_now_(topic, payload, payload_length, qos, retain);
   }
-  bool logging_topic = topic == this->log_message_.topic;
+
+  // Once messages are queued, new ones go after them to keep the order
+  if (this->outbound_.empty() && this->is_connected() &&
+      this->publish_now_(topic, payload, payload_length, qos, retain)) {
+    ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d)", topic.c_str(), payload, retain);
+    return true;
+  }
+  return this->enqueue_(topic, payload, payload_length, qos, retain, state);
+}
+
+bool MQTTClientComponent::publish_now_(const std::string &topic, const char *payload, size_t payload_length,
+                                       uint8_t qos, bool retain) {
   uint16_t ret = this->mqtt_client_.publish(topic.c_str(), qos, retain, payload, payload_length);
   delay(0);
-  if (ret == 0 && !logging_topic && this->is_connected()) {
-    delay(0);
-    ret = this->mqtt_client_.publish(topic.c_str(), qos, retain, payload, payload_length);
-    delay(0);
+  if (ret == 0)
+    return false;
+  this->messages_sent_++;
+  return true;
+}
+
+bool MQTTClientComponent::enqueue_(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
+                                   bool retain, bool state) {
+  if (state) {
+    // Only the latest state of a topic needs to be sent
+    for (auto &queued : this->outbound_) {
+      if (queued.state && queued.message.topic == topic) {
+        queued.message.payload.assign(payload, payload_length);
+        queued.message.qos = qos;
+        queued.message.retain = retain;
+        return true;
+      }
+    }
   }
 
-  if (!logging_topic) {
-    if (ret != 0) {
-      ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d)", topic.c_str(), payload, retain);
-    } else {
-      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", topic.c_str(),
+  if (this->outbound_.size() >= MAX_OUTBOUND_MESSAGES) {
+    // Make room for messages with QoS > 0 by dropping a QoS 0 message, otherwise drop the new one
+    auto it = this->outbound_.end();
+    if (qos > 0)
+      it = std::find_if(this->outbound_.begin(), this->outbound_.end(),
+                        [](const MQTTOutboundMessage &queued) { return queued.message.qos == 0; });
+    this->messages_dropped_++;
+    this->status_momentary_warning("publish", 1000);
+    if (it == this->outbound_.end()) {
+      ESP_LOGV(TAG, "Outbound queue full, dropping message for topic='%s' (len=%u).", topic.c_str(),
                payload_length);  // NOLINT
-      this->status_momentary_warning("publish", 1000);
+      return false;
     }
+    ESP_LOGV(TAG, "Outbound queue full, dropping message for topic='%s'.", it->message.topic.c_str());
+    this->outbound_.erase(it);
+  }
+
+  ESP_LOGV(TAG, "Queueing message for topic='%s' (len=%u).", topic.c_str(), payload_length);  // NOLINT
+  this->outbound_.push_back(MQTTOutboundMessage{
+      .message =
+          MQTTMessage{
+              .topic = topic,
+              .payload = std::string(payload, payload_length),
+              .qos = qos,
+              .retain = retain,
+          },
+      .state = state,
+  });
+  this->messages_queued_++;
+  return true;
+}
+
+void MQTTClientComponent::drain_outbound_() {
+  while (!this->outbound_.empty()) {
+    const MQTTMessage &message = this->outbound_.front().message;
+    // Continue on the next loop iteration when the send buffer is full
+    if (!this->publish_now_(message.topic, message.payload.data(), message.payload.size(), message.qos,
+                            message.retain))
+      return;
+    ESP_LOGV(TAG, "Publish(topic='%s' retain=%d) from queue", message.topic.c_str(), message.retain);
+    this->outbound_.pop_front();
   }
-  return ret != 0;
 }
 
 bool MQTTClientComponent::publish(const MQTTMessage &message) {
@@ -417,91 +554,172 @@ bool MQTTClientComponent::publish(const MQTTMessage &message) {
 }
 bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos,
                                        bool retain) {
-  std::string message = json::build_json(f);
-  return this->publish(topic, message, qos, retain);
+  if (!json::build_json(f, this->json_message_))
+    return false;
+  return this->publish(topic, this->json_message_, qos, retain);
+}
+bool MQTTClientComponent::publish_json_state(const std::string &topic, const json::json_build_t &f, uint8_t qos,
+                                             bool retain) {
+  if (!json::build_json(f, this->json_message_))
+    return false;
+  return this->publish_state(topic, this->json_message_, qos, retain);
 }
 
-/** Check if the message topic matches the given subscription topic
+/** Collect the subscriptions matching a message topic, walking the trie one topic level at a time.
  *
  * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
- *
- * @param message The message topic that was received from the MQTT server. Note: this must not contain
- *                wildcard characters as mandated by the MQTT spec.
- * @param subscription The subscription topic we are matching against.
- * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
- * @param past_separator Are we past the first '/' topic separator.
- * @return true if the subscription topic matches the message topic, false otherwise.
+ * Wildcards don't match the first level of topics beginning with a "$", and a "#" wildcard needs at least one more
+ * character in the message topic.
  */
-static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
-  // Reached end of both strings at the same time, this means we have a successful match
-  if (*message == '\0' && *subscription == '\0')
-    return true;
-
-  // Either the message or the subscribe are at the end. This means they don't match.
-  if (*message == '\0' || *subscription == '\0')
-    return false;
-
-  bool do_wildcards = is_normal || past_separator;
-
-  if (*subscription == '+' && do_wildcards) {
-    // single level wildcard
-    // consume + from subscription
-    subscription++;
-    // consume everything from message until '/' found or end of string
-    while (*message != '\0' && *message != '/') {
-      message++;
+void MQTTClientComponent::match_subscriptions_(const MQTTTopicNode &node, const std::string &topic, size_t start) {
+  size_t end = topic.find('/', start);
+  if (end == std::string::npos)
+    end = topic.size();
+  const bool do_wildcards = start != 0 || topic.empty() || topic[0] != '$';
+
+  for (const auto &child : node.children) {
+    if (do_wildcards && child->level == "#") {
+      if (start < topic.size())
+        this->matched_subscriptions_.insert(this->matched_subscriptions_.end(), child->subscriptions.begin(),
+                                            child->subscriptions.end());
+      continue;
     }
-    // after this, both pointers will point to a '/' or to the end of the string
+    if (!(do_wildcards && child->level == "+") && topic.compare(start, end - start, child->level) != 0)
+      continue;
 
-    return topic_match(message, subscription, is_normal, true);
+    if (end == topic.size()) {
+      this->matched_subscriptions_.insert(this->matched_subscriptions_.end(), child->subscriptions.begin(),
+                                          child->subscriptions.end());
+    } else {
+      this->match_subscriptions_(*child, topic, end + 1);
+    }
   }
+}
 
-  if (*subscription == '#' && do_wildcards) {
-    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
-    return true;
+void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
+  this->matched_subscriptions_.clear();
+  this->match_subscriptions_(this->subscription_trie_, topic, 0);
+  // Call the callbacks in the order they subscribed
+  std::sort(this->matched_subscriptions_.begin(), this->matched_subscriptions_.end());
+  for (size_t index : this->matched_subscriptions_)
+    this->subscriptions_[index].callback(topic, payload);
+}
+
+void MQTTClientComponent::queue_message_(const char *topic) {
+  LockGuard guard(this->inbound_lock_);
+  if (this->inbound_count_ == this->inbound_.size())
+    this->inbound_.emplace_back();
+  MQTTInboundMessage &message = this->inbound_[this->inbound_count_++];
+  message.topic = topic;
+  // Hand the payload over, payload_buffer_ continues with the memory of a previously dispatched message
+  message.payload.swap(this->payload_buffer_);
+}
+
+void MQTTClientComponent::dispatch_queued_messages_() {
+  if (this->inbound_count_ == 0)
+    return;
+  // New messages can be queued while these are dispatched, they go to the other vector
+  size_t count;
+  {
+    LockGuard guard(this->inbound_lock_);
+    std::swap(this->inbound_, this->inbound_dispatch_);
+    count = this->inbound_count_;
+    this->inbound_count_ = 0;
   }
+  for (size_t i = 0; i < count; i++)
+    this->on_message(this->inbound_dispatch_[i].topic, this->inbound_dispatch_[i].payload);
+}
 
-  // this handles '/' and normal characters at the same time.
-  if (*message != *subscription)
-    return false;
-
-  past_separator = past_separator || *subscription == '/';
+void MQTTClientComponent::start_discovery_(bool force) {
+  if (!this->is_discovery_enabled())
+    return;
+  for (MQTTComponent *component : this->children_)
+    component->set_discovery_pending(component->is_discovery_enabled());
+  this->discovery_index_ = 0;
+  this->discovery_round_hash_ = this->discovery_hash_seed_();
+  // Unless it's retained, Home Assistant only gets the discovery info that's published while it's connected
+  const bool check = !force && this->discovery_info_.retain && !this->discovery_info_.clean &&
+                     this->discovery_published_hash_ != 0;
+  this->discovery_state_ = check ? MQTTDiscoveryState::CHECKING : MQTTDiscoveryState::PUBLISHING;
+}
+
+void MQTTClientComponent::process_discovery_() {
+  const bool publishing = this->discovery_state_ == MQTTDiscoveryState::PUBLISHING;
+  size_t bytes_left = DISCOVERY_BYTES_PER_LOOP;
+  uint8_t checks_left = DISCOVERY_CHECKS_PER_LOOP;
+  for (; this->discovery_index_ < this->children_.size(); this->discovery_index_++) {
+    MQTTComponent *component = this->children_[this->discovery_index_];
+    if (!component->is_discovery_pending())
+      continue;
+    // Stop publishing when messages had to be queued, the send buffer is full
+    if (publishing ? bytes_left == 0 || !this->outbound_.empty() : checks_left-- == 0)
+      return;
 
-  // consume characters
-  subscription++;
-  message++;
+    uint32_t hash = 0;
+    this->json_message_.clear();
+    if (!this->discovery_info_.clean) {
+      // Try again on the next loop iteration if there's not enough memory or room in the send buffer
+      if (!component->build_discovery(this->json_message_))
+        return;
+      hash = fnv1_hash(this->json_message_);
+    }
+    if (publishing) {
+      if (!component->publish_discovery(this->json_message_))
+        return;
+      component->set_discovery_pending(false);
+      bytes_left -= std::min(bytes_left, this->json_message_.size() + 1);
+    }
+    this->discovery_round_hash_ = (this->discovery_round_hash_ * 16777619) ^ hash;
+  }
 
-  return topic_match(message, subscription, is_normal, past_separator);
-}
+  if (!publishing) {
+    if (this->discovery_round_hash_ == this->discovery_published_hash_) {
+      ESP_LOGD(TAG, "Discovery info is unchanged, not publishing it again.");
+      for (MQTTComponent *component : this->children_)
+        component->set_discovery_pending(false);
+      this->discovery_state_ = MQTTDiscoveryState::IDLE;
+    } else {
+      this->discovery_index_ = 0;
+      this->discovery_round_hash_ = this->discovery_hash_seed_();
+      this->discovery_state_ = MQTTDiscoveryState::PUBLISHING;
+    }
+    return;
+  }
 
-static bool topic_match(const char *message, const char *subscription) {
-  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
+  const uint32_t published_hash = this->discovery_info_.clean ? 0 : this->discovery_round_hash_;
+  if (published_hash != this->discovery_published_hash_) {
+    this->discovery_published_hash_ = published_hash;
+    this->discovery_pref_.save(&this->discovery_published_hash_);
+  }
+  this->discovery_state_ = MQTTDiscoveryState::IDLE;
 }
 
-void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
-#ifdef USE_ESP8266
-  // on ESP8266, this is called in LWiP thread; some components do not like running
-  // in an ISR.
-  this->defer([this, topic, payload]() {
-#endif
-    for (auto &subscription : this->subscriptions_)
-      if (topic_match(topic.c_str(), subscription.topic.c_str()))
-        subscription.callback(topic, payload);
-#ifdef USE_ESP8266
-  });
-#endif
+uint32_t MQTTClientComponent::discovery_hash_seed_() const {
+  return fnv1_hash(this->credentials_.address + ":" + to_string(this->credentials_.port) + "/" +
+                   this->credentials_.client_id);
 }
 
 // Setters
 void MQTTClientComponent::disable_log_message() { this->log_message_.topic = ""; }
 bool MQTTClientComponent::is_log_message_enabled() const { return !this->log_message_.topic.empty(); }
 void MQTTClientComponent::set_reboot_timeout(uint32_t reboot_timeout) { this->reboot_timeout_ = reboot_timeout; }
-void MQTTClientComponent::register_mqtt_component(MQTTComponent *component) { this->children_.push_back(component); }
+void MQTTClientComponent::register_mqtt_component(MQTTComponent *component) {
+  this->children_.push_back(component);
+  if (this->discovery_state_ != MQTTDiscoveryState::IDLE) {
+    // The running round gets to it, it's at the end of children_
+    component->set_discovery_pending(component->is_discovery_enabled());
+  } else if (this->is_connected()) {
+    this->start_discovery_(false);
+  }
+}
 void MQTTClientComponent::set_log_level(int level) { this->log_level_ = level; }
 void MQTTClientComponent::set_keep_alive(uint16_t keep_alive_s) { this->mqtt_client_.setKeepAlive(keep_alive_s); }
 void MQTTClientComponent::set_log_message_template(MQTTMessage &&message) { this->log_message_ = std::move(message); }
 const MQTTDiscoveryInfo &MQTTClientComponent::get_discovery_info() const { return this->discovery_info_; }
-void MQTTClientComponent::set_topic_prefix(std::string topic_prefix) { this->topic_prefix_ = std::move(topic_prefix); }
+void MQTTClientComponent::set_topic_prefix(std::string topic_prefix) {
+  this->topic_prefix_ = std::move(topic_prefix);
+  this->topic_prefix_version_++;
+}
 const std::string &MQTTClientComponent::get_topic_prefix() const { return this->topic_prefix_; }
 void MQTTClientComponent::disable_birth_message() {
   this->birth_message_.topic = "";
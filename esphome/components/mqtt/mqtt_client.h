@@ -7,9 +7,11 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
 #include "esphome/components/json/json_util.h"
 #include "esphome/components/network/ip_address.h"
 #include <AsyncMqttClient.h>
+#include <deque>
 #include "lwip/ip_addr.h"
 
 namespace esphome {
@@ -39,6 +41,31 @@ struct MQTTSubscription {
   uint32_t resubscribe_timeout;
 };
 
+/// internal node of the subscription topic trie, there's one for each level of the subscribed topics.
+struct MQTTTopicNode {
+  std::string level;  ///< The topic level, or a "+" / "#" wildcard.
+  std::vector<size_t> subscriptions;  ///< Indices of the subscriptions whose topic ends at this node.
+  std::vector<std::unique_ptr<MQTTTopicNode>> children;
+};
+
+/// internal struct for received MQTT messages waiting to be dispatched from the main loop.
+struct MQTTInboundMessage {
+  std::string topic;
+  std::string payload;
+};
+
+/// internal struct for MQTT messages waiting to be published.
+struct MQTTOutboundMessage {
+  MQTTMessage message;
+  bool state;  ///< Published with publish_state(), a newer state of the topic replaces it.
+};
+
+enum class MQTTDiscoveryState : uint8_t {
+  IDLE,        ///< All discovery info was sent.
+  CHECKING,    ///< Building the discovery info to check if it changed since it was last published.
+  PUBLISHING,  ///< Publishing the discovery info.
+};
+
 /// internal struct for MQTT credentials.
 struct MQTTCredentials {
   std::string address;  ///< The address of the server without port number
@@ -145,6 +172,8 @@ class MQTTClientComponent : public Component {
   void set_topic_prefix(std::string topic_prefix);
   /// Get the topic prefix of this device, using default if necessary
   const std::string &get_topic_prefix() const;
+  /// Incremented whenever the topic prefix changes, so components know when to rebuild cached topics.
+  uint32_t get_topic_prefix_version() const { return this->topic_prefix_version_; }
 
   /// Manually set the topic used for logging.
   void set_log_message_template(MQTTMessage &&message);
@@ -188,16 +217,26 @@ class MQTTClientComponent : public Component {
   bool publish(const MQTTMessage &message);
 
   /** Publish a MQTT message
+   *
+   * Messages that can't be sent right away (while disconnected or when the TCP send buffer is full) are queued and
+   * sent in order from loop(). Only call this from the main loop, like the subscription callbacks are.
    *
    * @param topic The topic.
    * @param payload The payload.
    * @param retain Whether to retain the message.
+   * @return false if the message was dropped.
    */
   bool publish(const std::string &topic, const std::string &payload, uint8_t qos = 0, bool retain = false);
 
   bool publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos = 0,
                bool retain = false);
 
+  /** Publish the current state of an entity.
+   *
+   * Like publish(), but while it's queued a newer state for the same topic replaces it, only the latest one is sent.
+   */
+  bool publish_state(const std::string &topic, const std::string &payload, uint8_t qos = 0, bool retain = false);
+
   /** Construct and send a JSON MQTT message.
    *
    * @param topic The topic.
@@ -205,6 +244,9 @@ class MQTTClientComponent : public Component {
    * @param retain Whether to retain the message.
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos = 0, bool retain = false);
+  /// Construct and send a JSON state, see publish_state().
+  bool publish_json_state(const std::string &topic, const json::json_build_t &f, uint8_t qos = 0,
+                          bool retain = false);
 
   /// Setup the MQTT client, registering a bunch of callbacks and attempting to connect.
   void setup() override;
@@ -226,6 +268,13 @@ class MQTTClientComponent : public Component {
 
   bool is_connected();
 
+  /// Number of messages handed to the MQTT client library.
+  uint32_t get_messages_sent() const { return this->messages_sent_; }
+  /// Number of messages that had to be queued.
+  uint32_t get_messages_queued() const { return this->messages_queued_; }
+  /// Number of messages that were dropped because the outbound queue was full.
+  uint32_t get_messages_dropped() const { return this->messages_dropped_; }
+
   void on_shutdown() override;
 
   void set_broker_address(const std::string &address) { this->credentials_.address = address; }
@@ -251,6 +300,30 @@ class MQTTClientComponent : public Component {
   bool subscribe_(const char *topic, uint8_t qos);
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
+  /// Publish a message right away, returns false if the MQTT client library couldn't take it.
+  bool publish_now_(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos, bool retain);
+  bool publish_(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos, bool retain,
+                bool state);
+  /// Add a message to outbound_, returns false if it was dropped.
+  bool enqueue_(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos, bool retain,
+                bool state);
+  /// Publish queued messages until the send buffer is full.
+  void drain_outbound_();
+  /// Start sending the discovery info of all components, if force is false it's only published if it changed.
+  void start_discovery_(bool force);
+  /// Send the next few discovery messages, within the per loop budget.
+  void process_discovery_();
+  /// Start value of discovery_round_hash_. The retained configs are only known to be on the broker they were
+  /// published to, so a saved hash doesn't match after a change of the broker or client id.
+  uint32_t discovery_hash_seed_() const;
+  /// Add subscriptions_[index] to the topic trie.
+  void add_subscription_to_trie_(size_t index);
+  void rebuild_subscription_trie_();
+  /// Collect the subscriptions below node matching topic, which node matched up to start.
+  void match_subscriptions_(const MQTTTopicNode &node, const std::string &topic, size_t start);
+  /// Queue the message in payload_buffer_ for dispatch from loop().
+  void queue_message_(const char *topic);
+  void dispatch_queued_messages_();
 
   MQTTCredentials credentials_;
   /// The last will message. Disabled optional denotes it being default and
@@ -271,11 +344,36 @@ class MQTTClientComponent : public Component {
       .clean = false,
   };
   std::string topic_prefix_{};
+  uint32_t topic_prefix_version_{1};
   MQTTMessage log_message_;
   std::string payload_buffer_;
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  MQTTTopicNode subscription_trie_;
+  /// Reused by on_message() to collect the matching subscriptions.
+  std::vector<size_t> matched_subscriptions_;
+  // Messages received in the LWiP thread (the AsyncTCP task on ESP32) are queued in inbound_, which loop() swaps with
+  // inbound_dispatch_ before dispatching them. Both keep their strings, so receiving doesn't allocate once they have
+  // grown large enough. Dispatching from loop() keeps the callbacks, and what they publish, on the main loop.
+  std::vector<MQTTInboundMessage> inbound_;
+  size_t inbound_count_{0};
+  std::vector<MQTTInboundMessage> inbound_dispatch_;
+  Mutex inbound_lock_;
+  /// Reused by publish_json() and for discovery messages, so serializing messages doesn't allocate every time.
+  std::string json_message_;
+  /// Messages waiting to be published, see publish().
+  std::deque<MQTTOutboundMessage> outbound_;
+  uint32_t messages_sent_{0};
+  uint32_t messages_queued_{0};
+  uint32_t messages_dropped_{0};
+  MQTTDiscoveryState discovery_state_{MQTTDiscoveryState::IDLE};
+  /// The next component in children_ to send the discovery info of.
+  size_t discovery_index_{0};
+  /// Combined hash of the discovery info of the current round, and of the last round that was completely published.
+  uint32_t discovery_round_hash_{0};
+  uint32_t discovery_published_hash_{0};
+  ESPPreferenceObject discovery_pref_;
   AsyncMqttClient mqtt_client_;
   MQTTClientState state_{MQTT_CLIENT_DISCONNECTED};
   network::IPAddress ip_;
@@ -27,10 +27,15 @@ std::string MQTTComponent::get_default_topic_for_(const std::string &suffix) con
          "/" + suffix;
 }
 
-const std::string MQTTComponent::get_state_topic_() const {
-  if (this->custom_state_topic_.empty())
-    return this->get_default_topic_for_("state");
-  return this->custom_state_topic_;
+const std::string &MQTTComponent::get_state_topic_() const {
+  if (!this->custom_state_topic_.empty())
+    return this->custom_state_topic_;
+  const uint32_t version = global_mqtt_client->get_topic_prefix_version();
+  if (this->default_state_topic_version_ != version) {
+    this->default_state_topic_ = this->get_default_topic_for_("state");
+    this->default_state_topic_version_ = version;
+  }
+  return this->default_state_topic_;
 }
 
 const std::string MQTTComponent::get_command_topic_() const {
@@ -42,16 +47,16 @@ const std::string MQTTComponent::get_command_topic_() const {
 bool MQTTComponent::publish(const std::string &topic, const std::string &payload) {
   if (topic.empty())
     return false;
-  return global_mqtt_client->publish(topic, payload, 0, this->retain_);
+  return global_mqtt_client->publish_state(topic, payload, 0, this->retain_);
 }
 
 bool MQTTComponent::publish_json(const std::string &topic, const json::json_build_t &f) {
   if (topic.empty())
     return false;
-  return global_mqtt_client->publish_json(topic, f, 0, this->retain_);
+  return global_mqtt_client->publish_json_state(topic, f, 0, this->retain_);
 }
 
-bool MQTTComponent::send_discovery_() {
+bool MQTTComponent::publish_discovery(const std::string &payload) {
   const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
 
   if (discovery_info.clean) {
@@ -60,9 +65,11 @@ bool MQTTComponent::send_discovery_() {
   }
 
   ESP_LOGV(TAG, "'%s': Sending discovery...", this->friendly_name().c_str());
+  return global_mqtt_client->publish(this->get_discovery_topic_(discovery_info), payload, 0, discovery_info.retain);
+}
 
-  return global_mqtt_client->publish_json(
-      this->get_discovery_topic_(discovery_info),
+bool MQTTComponent::build_discovery(std::string &payload) {
+  return json::build_json(
       [this](JsonObject root) {
         SendDiscoveryConfig config;
         config.state_topic = true;
@@ -134,7 +141,7 @@ bool MQTTComponent::send_discovery_() {
         device_info[MQTT_DEVICE_MODEL] = ESPHOME_BOARD;
         device_info[MQTT_DEVICE_MANUFACTURER] = "espressif";
       },
-      0, discovery_info.retain);
+      payload);
 }
 
 bool MQTTComponent::get_retain() const { return this->retain_; }
@@ -143,8 +150,10 @@ bool MQTTComponent::is_discovery_enabled() const {
   return this->discovery_enabled_ && global_mqtt_client->is_discovery_enabled();
 }
 
-std::string MQTTComponent::get_default_object_id_() const {
-  return str_sanitize(str_snake_case(this->friendly_name()));
+const std::string &MQTTComponent::get_default_object_id_() const {
+  if (this->object_id_.empty())
+    this->object_id_ = str_sanitize(str_snake_case(this->friendly_name()));
+  return this->object_id_;
 }
 
 void MQTTComponent::subscribe(const std::string &topic, mqtt_callback_t callback, uint8_t qos) {
@@ -181,18 +190,8 @@ void MQTTComponent::call_setup() {
   this->setup();
 
   global_mqtt_client->register_mqtt_component(this);
-
-  if (!this->is_connected_())
-    return;
-
-  if (this->is_discovery_enabled()) {
-    if (!this->send_discovery_()) {
-      this->schedule_resend_state();
-    }
-  }
-  if (!this->send_initial_state()) {
-    this->schedule_resend_state();
-  }
+  // The MQTT client sends the discovery info, the initial state follows from call_loop() once that's done.
+  this->schedule_resend_state();
 }
 
 void MQTTComponent::call_loop() {
@@ -201,16 +200,11 @@ void MQTTComponent::call_loop() {
 
   this->loop();
 
-  if (!this->resend_state_ || !this->is_connected_()) {
+  if (!this->resend_state_ || this->discovery_pending_ || !this->is_connected_()) {
     return;
   }
 
   this->resend_state_ = false;
-  if (this->is_discovery_enabled()) {
-    if (!this->send_discovery_()) {
-      this->schedule_resend_state();
-    }
-  }
   if (!this->send_initial_state()) {
     this->schedule_resend_state();
   }
@@ -62,7 +62,7 @@ class MQTTComponent : public Component {
   /// Constructs a MQTTComponent.
   explicit MQTTComponent();
 
-  /// Override setup_ so that we can call send_discovery() when needed.
+  /// Override setup_ so that we can register with the MQTT client, which sends the discovery info.
   void call_setup() override;
 
   void call_loop() override;
@@ -105,14 +105,22 @@ class MQTTComponent : public Component {
   /// Internal method for the MQTT client base to schedule a resend of the state on reconnect.
   void schedule_resend_state();
 
-  /** Send a MQTT message.
+  /// Internal method for the MQTT client, build the discovery info into payload. Returns false if the heap is full.
+  bool build_discovery(std::string &payload);
+  /// Internal method for the MQTT client, publish the discovery info built by build_discovery().
+  bool publish_discovery(const std::string &payload);
+  /// Internal method for the MQTT client, the initial state is only sent once the discovery info isn't pending.
+  void set_discovery_pending(bool pending) { this->discovery_pending_ = pending; }
+  bool is_discovery_pending() const { return this->discovery_pending_; }
+
+  /** Send a MQTT message with a state of this component, see MQTTClientComponent::publish_state().
    *
    * @param topic The topic.
    * @param payload The payload.
    */
   bool publish(const std::string &topic, const std::string &payload);
 
-  /** Construct and send a JSON MQTT message.
+  /** Construct and send a JSON MQTT message with a state of this component.
    *
    * @param topic The topic.
    * @param f The Json Message builder.
@@ -171,28 +179,31 @@ class MQTTComponent : public Component {
   virtual bool is_disabled_by_default() const;
 
   /// Get the MQTT topic that new states will be shared to.
-  const std::string get_state_topic_() const;
+  const std::string &get_state_topic_() const;
 
   /// Get the MQTT topic for listening to commands.
   const std::string get_command_topic_() const;
 
   bool is_connected_() const;
 
-  /// Internal method to start sending discovery info, this will call send_discovery().
-  bool send_discovery_();
-
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Generate the Home Assistant MQTT discovery object id by automatically transforming the friendly name.
-  std::string get_default_object_id_() const;
+  const std::string &get_default_object_id_() const;
 
  protected:
   std::string custom_state_topic_{};
   std::string custom_command_topic_{};
+  // The object id and default state topic are used on every publish, so they're only built once (and again when
+  // the topic prefix changes).
+  mutable std::string object_id_{};
+  mutable std::string default_state_topic_{};
+  mutable uint32_t default_state_topic_version_{0};
   bool retain_{true};
   bool discovery_enabled_{true};
   std::unique_ptr<Availability> availability_;
   bool resend_state_{false};
+  bool discovery_pending_{false};
 };
 
 }  // namespace mqtt
@@ -1,8 +1,13 @@
 #include "mqtt_sensor.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 #include "mqtt_const.h"
 
+#include <cmath>
+#include <ctime>
+#include <sys/time.h>
+
 #ifdef USE_MQTT
 #ifdef USE_SENSOR
 
@@ -58,6 +63,9 @@ void MQTTSensorComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryCon
   if (this->sensor_->get_state_class() != STATE_CLASS_NONE)
     root[MQTT_STATE_CLASS] = state_class_to_string(this->sensor_->get_state_class());
 
+  if (this->json_state_)
+    root[MQTT_VALUE_TEMPLATE] = "{{ value_json.value }}";
+
   config.command_topic = false;
 }
 bool MQTTSensorComponent::send_initial_state() {
@@ -69,7 +77,29 @@ bool MQTTSensorComponent::send_initial_state() {
 }
 bool MQTTSensorComponent::publish_state(float value) {
   int8_t accuracy = this->sensor_->get_accuracy_decimals();
-  return this->publish(this->get_state_topic_(), value_accuracy_to_string(value, accuracy));
+  if (!this->json_state_)
+    return this->publish(this->get_state_topic_(), value_accuracy_to_string(value, accuracy));
+
+  return this->publish_json(this->get_state_topic_(), [this, value, accuracy](JsonObject root) {
+    if (std::isnan(value)) {
+      root["value"] = nullptr;
+    } else {
+      root["value"] = serialized(value_accuracy_to_string(value, accuracy));
+    }
+    // the measurement time in UTC, as far as the clock is set (a year before 2019 means it isn't)
+    uint32_t age = millis() - this->sensor_->get_state_time();
+    struct timeval now;
+    ::gettimeofday(&now, nullptr);
+    int64_t measured_ms = int64_t(now.tv_sec) * 1000 + now.tv_usec / 1000 - age;
+    time_t measured = measured_ms / 1000;
+    struct tm t;
+    if (measured < 1546300800 || ::gmtime_r(&measured, &t) == nullptr)
+      return;
+    char buf[32];
+    size_t len = ::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &t);
+    snprintf(buf + len, sizeof(buf) - len, ".%03dZ", int(measured_ms % 1000));
+    root["time"] = buf;
+  });
 }
 std::string MQTTSensorComponent::unique_id() { return this->sensor_->unique_id(); }
 
@@ -26,6 +26,8 @@ class MQTTSensorComponent : public mqtt::MQTTComponent {
   void set_expire_after(uint32_t expire_after);
   /// Disable Home Assistant value expiry.
   void disable_expire_after();
+  /// Publish states as JSON with their value and, once the clock is set, the time they were measured.
+  void set_json_state(bool json_state) { this->json_state_ = json_state; }
 
   void send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) override;
 
@@ -50,6 +52,7 @@ class MQTTSensorComponent : public mqtt::MQTTComponent {
 
   sensor::Sensor *sensor_;
   optional<uint32_t> expire_after_;  // Override the expire after advertised to Home Assistant
+  bool json_state_{false};
 };
 
 }  // namespace mqtt
@@ -55,6 +55,17 @@ SPI_BUS_HSPI = "hspi"
 SPI_SPEEDS = [40e6, 20e6, 10e6, 5e6, 2e6, 1e6, 500e3]
 
 
+ESP32_RMT_CHANNELS = {
+    VARIANT_ESP32: [0, 1, 2, 3, 4, 5, 6, 7],
+    VARIANT_ESP32S2: [0, 1, 2, 3],
+    VARIANT_ESP32C3: [0, 1],
+}
+ESP32_I2S_BUSES = {
+    VARIANT_ESP32: [0, 1],
+    VARIANT_ESP32S2: [0],
+}
+
+
 def _esp32_rmt_default_channel():
     return {
         VARIANT_ESP32S2: 1,
@@ -67,15 +78,10 @@ def _validate_esp32_rmt_channel(value):
         value = CHANNEL_DYNAMIC
     else:
         value = cv.int_(value)
-    variant_channels = {
-        VARIANT_ESP32: [0, 1, 2, 3, 4, 5, 6, 7, CHANNEL_DYNAMIC],
-        VARIANT_ESP32S2: [0, 1, 2, 3, CHANNEL_DYNAMIC],
-        VARIANT_ESP32C3: [0, 1, CHANNEL_DYNAMIC],
-    }
     variant = get_esp32_variant()
-    if variant not in variant_channels:
+    if variant not in ESP32_RMT_CHANNELS:
         raise cv.Invalid(f"{variant} does not support the rmt method")
-    if value not in variant_channels[variant]:
+    if value not in ESP32_RMT_CHANNELS[variant] + [CHANNEL_DYNAMIC]:
         raise cv.Invalid(f"{variant} does not support rmt channel {value}")
     return value
 
@@ -92,14 +98,10 @@ def _validate_esp32_i2s_bus(value):
         value = BUS_DYNAMIC
     else:
         value = cv.int_(value)
-    variant_buses = {
-        VARIANT_ESP32: [0, 1, BUS_DYNAMIC],
-        VARIANT_ESP32S2: [0, BUS_DYNAMIC],
-    }
     variant = get_esp32_variant()
-    if variant not in variant_buses:
+    if variant not in ESP32_I2S_BUSES:
         raise cv.Invalid(f"{variant} does not support the i2s method")
-    if value not in variant_buses[variant]:
+    if value not in ESP32_I2S_BUSES[variant] + [BUS_DYNAMIC]:
         raise cv.Invalid(f"{variant} does not support i2s bus {value}")
     return value
 
@@ -1,11 +1,15 @@
+import logging
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome import pins
 from esphome.components import light
 from esphome.const import (
     CONF_CHANNEL,
     CONF_CLOCK_PIN,
     CONF_DATA_PIN,
+    CONF_ID,
     CONF_METHOD,
     CONF_NUM_LEDS,
     CONF_PIN,
@@ -20,6 +24,10 @@ from esphome.components.esp32.const import (
 )
 from esphome.core import CORE
 from ._methods import (
+    BUS_DYNAMIC,
+    CHANNEL_DYNAMIC,
+    ESP32_I2S_BUSES,
+    ESP32_RMT_CHANNELS,
     METHODS,
     METHOD_SPI,
     METHOD_ESP8266_UART,
@@ -35,6 +43,8 @@ from .const import (
     ONE_WIRE_CHIPS,
 )
 
+_LOGGER = logging.getLogger(__name__)
+
 neopixelbus_ns = cg.esphome_ns.namespace("neopixelbus")
 NeoPixelBusLightOutputBase = neopixelbus_ns.class_(
     "NeoPixelBusLightOutputBase", light.AddressableLight
@@ -187,6 +197,53 @@ CONFIG_SCHEMA = cv.All(
 )
 
 
+KEY_NEOPIXELBUS_PERIPHERALS = "neopixelbus_peripherals"
+
+
+def _final_validate(config):
+    # Strips on their own RMT channel/I2S bus are transmitted in parallel, so a light
+    # that shares one with an earlier light is moved to a free one.
+    method = config[CONF_METHOD]
+    if method[CONF_TYPE] == METHOD_ESP32_RMT:
+        key, name, dynamic = CONF_CHANNEL, "rmt channel", CHANNEL_DYNAMIC
+        choices = ESP32_RMT_CHANNELS.get(get_esp32_variant(), [])
+    elif method[CONF_TYPE] == METHOD_ESP32_I2S:
+        key, name, dynamic = CONF_BUS, "i2s bus", BUS_DYNAMIC
+        choices = ESP32_I2S_BUSES.get(get_esp32_variant(), [])
+    else:
+        return config
+    if method[key] == dynamic:
+        return config
+    used = fv.full_config.get().data.setdefault(KEY_NEOPIXELBUS_PERIPHERALS, {})
+    taken = used.setdefault(method[CONF_TYPE], {})
+    if method[key] in taken:
+        free = [c for c in choices if c not in taken]
+        if not free:
+            _LOGGER.warning(
+                "The %s %s is used by both %s and %s, they can't be shown at once.",
+                name,
+                method[key],
+                config[CONF_ID],
+                taken[method[key]],
+            )
+            return config
+        _LOGGER.warning(
+            "The %s %s is already used by %s, using %s %s for %s instead.",
+            name,
+            method[key],
+            taken[method[key]],
+            name,
+            free[0],
+            config[CONF_ID],
+        )
+        method[key] = free[0]
+    taken[method[key]] = config[CONF_ID]
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 async def to_code(config):
     has_white = "W" in config[CONF_TYPE]
     method = config[CONF_METHOD]
@@ -194,11 +251,13 @@ async def to_code(config):
     method_template = METHODS[method[CONF_TYPE]].to_code(
         method, config[CONF_VARIANT], config[CONF_INVERT]
     )
+    # the color order is a template parameter, so that pixel access uses constant offsets
+    order = getattr(ESPNeoPixelOrder, config[CONF_TYPE])
 
     if has_white:
-        out_type = NeoPixelRGBWLightOutput.template(method_template)
+        out_type = NeoPixelRGBWLightOutput.template(method_template, order)
     else:
-        out_type = NeoPixelRGBLightOutput.template(method_template)
+        out_type = NeoPixelRGBLightOutput.template(method_template, order)
     rhs = out_type.new()
     var = cg.Pvariable(config[CONF_OUTPUT_ID], rhs, out_type)
     await light.register_light(var, config)
@@ -213,7 +272,5 @@ async def to_code(config):
             )
         )
 
-    cg.add(var.set_pixel_order(getattr(ESPNeoPixelOrder, config[CONF_TYPE])))
-
     # https://github.com/Makuna/NeoPixelBus/blob/master/library.json
     cg.add_library("makuna/NeoPixelBus", "2.6.9")
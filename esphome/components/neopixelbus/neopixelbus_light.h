@@ -51,6 +51,11 @@ enum class ESPNeoPixelOrder {
   RWBG = 0b00111001,
 };
 
+/// Byte offset of a channel (0 = red, 1 = green, 2 = blue, 3 = white) within a pixel for the given order.
+constexpr uint8_t neopixel_order_offset(ESPNeoPixelOrder order, uint8_t channel) {
+  return (static_cast<uint8_t>(order) >> (6 - 2 * channel)) & 0b11;
+}
+
 template<typename T_METHOD, typename T_COLOR_FEATURE>
 class NeoPixelBusLightOutputBase : public light::AddressableLight {
  public:
@@ -86,6 +91,15 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
   }
 
   void write_state(light::LightState *state) override {
+    // The RMT, I2S and DMA methods transmit in the background from their own send buffer, but Show() waits for the
+    // previous frame to finish. Don't block the loop on that, try again next loop iteration instead.
+    // Strips on different RMT channels or I2S buses (light.py moves a light off a channel or bus that is already used)
+    // transmit at the same time, and a frame takes as long as the longest strip. NeoPixelBus 2.6.9 has no I2S parallel method to drive
+    // more strips than there are channels at once.
+    if (!this->controller_->CanShow()) {
+      this->schedule_show();
+      return;
+    }
     this->mark_shown_();
     this->controller_->Dirty();
 
@@ -96,51 +110,75 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
 
   int32_t size() const override { return this->controller_->PixelCount(); }
 
-  void set_pixel_order(ESPNeoPixelOrder order) {
-    uint8_t u_order = static_cast<uint8_t>(order);
-    this->rgb_offsets_[0] = (u_order >> 6) & 0b11;
-    this->rgb_offsets_[1] = (u_order >> 4) & 0b11;
-    this->rgb_offsets_[2] = (u_order >> 2) & 0b11;
-    this->rgb_offsets_[3] = (u_order >> 0) & 0b11;
-  }
-
  protected:
   NeoPixelBus<T_COLOR_FEATURE, T_METHOD> *controller_{nullptr};
   uint8_t *effect_data_{nullptr};
-  uint8_t rgb_offsets_[4]{0, 1, 2, 3};
 };
 
-template<typename T_METHOD, typename T_COLOR_FEATURE = NeoRgbFeature>
+/// The color order is a template parameter, so that all pixel access uses constant offsets.
+template<typename T_METHOD, ESPNeoPixelOrder T_ORDER, typename T_COLOR_FEATURE = NeoRgbFeature>
 class NeoPixelRGBLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COLOR_FEATURE> {
  public:
+  using Format = light::AddressablePixelFormat<3, neopixel_order_offset(T_ORDER, 0), neopixel_order_offset(T_ORDER, 1),
+                                               neopixel_order_offset(T_ORDER, 2)>;
+
   light::LightTraits get_traits() override {
     auto traits = light::LightTraits();
     traits.set_supported_color_modes({light::ColorMode::RGB});
     return traits;
   }
+  optional<light::AddressableLightBuffer> get_raw_buffer() const override {
+    return Format::buffer(this->controller_->Pixels());
+  }
+  void fill_range(int32_t from, int32_t to, Color color) override {
+    Format::fill(this->controller_->Pixels(), from, to, color, this->correction_);
+  }
+  void write_span(int32_t first, const Color *colors, int32_t count) override {
+    Format::write(this->controller_->Pixels(), first, colors, count, this->correction_);
+  }
+  void read_span(int32_t first, Color *colors, int32_t count) const override {
+    Format::read(this->controller_->Pixels(), first, colors, count, this->correction_);
+  }
 
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override {  // NOLINT
     uint8_t *base = this->controller_->Pixels() + 3ULL * index;
-    return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
-                               nullptr, this->effect_data_ + index, &this->correction_);
+    return light::ESPColorView(base + neopixel_order_offset(T_ORDER, 0), base + neopixel_order_offset(T_ORDER, 1),
+                               base + neopixel_order_offset(T_ORDER, 2), nullptr, this->effect_data_ + index,
+                               &this->correction_);
   }
 };
 
-template<typename T_METHOD, typename T_COLOR_FEATURE = NeoRgbwFeature>
+template<typename T_METHOD, ESPNeoPixelOrder T_ORDER, typename T_COLOR_FEATURE = NeoRgbwFeature>
 class NeoPixelRGBWLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COLOR_FEATURE> {
  public:
+  using Format = light::AddressablePixelFormat<4, neopixel_order_offset(T_ORDER, 0), neopixel_order_offset(T_ORDER, 1),
+                                               neopixel_order_offset(T_ORDER, 2), neopixel_order_offset(T_ORDER, 3)>;
+
   light::LightTraits get_traits() override {
     auto traits = light::LightTraits();
     traits.set_supported_color_modes({light::ColorMode::RGB_WHITE});
     return traits;
   }
+  optional<light::AddressableLightBuffer> get_raw_buffer() const override {
+    return Format::buffer(this->controller_->Pixels());
+  }
+  void fill_range(int32_t from, int32_t to, Color color) override {
+    Format::fill(this->controller_->Pixels(), from, to, color, this->correction_);
+  }
+  void write_span(int32_t first, const Color *colors, int32_t count) override {
+    Format::write(this->controller_->Pixels(), first, colors, count, this->correction_);
+  }
+  void read_span(int32_t first, Color *colors, int32_t count) const override {
+    Format::read(this->controller_->Pixels(), first, colors, count, this->correction_);
+  }
 
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override {  // NOLINT
     uint8_t *base = this->controller_->Pixels() + 4ULL * index;
-    return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
-                               base + this->rgb_offsets_[3], this->effect_data_ + index, &this->correction_);
+    return light::ESPColorView(base + neopixel_order_offset(T_ORDER, 0), base + neopixel_order_offset(T_ORDER, 1),
+                               base + neopixel_order_offset(T_ORDER, 2), base + neopixel_order_offset(T_ORDER, 3),
+                               this->effect_data_ + index, &this->correction_);
   }
 };
 
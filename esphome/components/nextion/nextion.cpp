@@ -1,4 +1,6 @@
 #include "nextion.h"
+#include <algorithm>
+#include "esphome/core/helpers.h"
 #include "esphome/core/util.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
@@ -30,12 +32,47 @@ bool Nextion::send_command_(const std::string &command) {
     return false;
   }
 
+  // Component updates queued before this command go out first, the display sees them in order
+  this->send_pending_sets_(true);
+  this->write_command_(command);
+  return true;
+}
+
+void Nextion::write_command_(const std::string &command) {
   ESP_LOGN(TAG, "send_command %s", command.c_str());
 
   this->write_str(command.c_str());
   const uint8_t to_send[3] = {0xFF, 0xFF, 0xFF};
   this->write_array(to_send, sizeof(to_send));
-  return true;
+}
+
+void Nextion::send_pending_sets_(bool all) {
+  // the display may have been reset or gone to sleep since the updates were queued
+  if (!this->ignore_is_setup_ && !this->is_setup())
+    return;
+  while (!this->pending_sets_.empty() && (all || this->nextion_queue_.size() < MAX_OUTSTANDING_COMMANDS)) {
+    PendingSet set = std::move(this->pending_sets_.front());
+    this->pending_sets_.pop_front();
+    if (!set.is_sleep_safe && this->is_sleeping()) {
+      ESP_LOGN(TAG, "Dropping update of %s, the display is sleeping", set.variable_name_to_send.c_str());
+      continue;
+    }
+    this->write_command_(set.command);
+    this->add_no_result_to_queue_(set.variable_name);
+  }
+}
+
+void Nextion::add_pending_set_(const std::string &variable_name, const std::string &variable_name_to_send,
+                               const std::string &command, bool is_sleep_safe) {
+  for (auto &set : this->pending_sets_) {
+    if (set.variable_name_to_send == variable_name_to_send) {
+      ESP_LOGN(TAG, "Replacing pending update of %s", variable_name_to_send.c_str());
+      set.command = command;
+      set.is_sleep_safe = is_sleep_safe;
+      return;
+    }
+  }
+  this->pending_sets_.push_back({variable_name, variable_name_to_send, command, is_sleep_safe});
 }
 
 bool Nextion::check_connect_() {
@@ -111,6 +148,7 @@ void Nextion::reset_(bool reset_nextion) {
     this->read_byte(&d);
   };
   this->nextion_queue_.clear();
+  this->pending_sets_.clear();
 }
 
 void Nextion::dump_config() {
@@ -238,6 +276,7 @@ void Nextion::loop() {
 
   this->process_serial_();            // Receive serial data
   this->process_nextion_commands_();  // Process nextion return commands
+  this->send_pending_sets_(false);    // Send component updates as acks come in
 
   if (!this->nextion_reports_is_setup_) {
     if (this->started_ms_ == 0)
@@ -274,11 +313,14 @@ bool Nextion::remove_from_q_(bool report_empty) {
 }
 
 void Nextion::process_serial_() {
-  uint8_t d;
+  uint8_t buf[64];
 
-  while (this->available()) {
-    read_byte(&d);
-    this->command_data_ += d;
+  size_t avail;
+  while ((avail = this->available()) > 0) {
+    size_t to_read = std::min(avail, sizeof(buf));
+    if (!this->read_array(buf, to_read))
+      break;
+    this->command_data_.append(reinterpret_cast<const char *>(buf), to_read);
   }
 }
 // nextion.tech/instruction-set/
@@ -1008,8 +1050,14 @@ void Nextion::add_no_result_to_queue_with_set_internal_(const std::string &varia
   if ((!this->is_setup() && !this->ignore_is_setup_) || (!is_sleep_safe && this->is_sleeping()))
     return;
 
-  this->add_no_result_to_queue_with_ignore_sleep_printf_(variable_name, "%s=%d", variable_name_to_send.c_str(),
-                                                         state_value);
+  if (this->ignore_is_setup_) {
+    this->add_no_result_to_queue_with_ignore_sleep_printf_(variable_name, "%s=%d", variable_name_to_send.c_str(),
+                                                           state_value);
+    return;
+  }
+
+  this->add_pending_set_(variable_name, variable_name_to_send, variable_name_to_send + "=" + to_string(state_value),
+                         is_sleep_safe);
 }
 
 /**
@@ -1036,8 +1084,14 @@ void Nextion::add_no_result_to_queue_with_set_internal_(const std::string &varia
   if ((!this->is_setup() && !this->ignore_is_setup_) || (!is_sleep_safe && this->is_sleeping()))
     return;
 
-  this->add_no_result_to_queue_with_printf_(variable_name, "%s=\"%s\"", variable_name_to_send.c_str(),
-                                            state_value.c_str());
+  if (this->ignore_is_setup_) {
+    this->add_no_result_to_queue_with_printf_(variable_name, "%s=\"%s\"", variable_name_to_send.c_str(),
+                                              state_value.c_str());
+    return;
+  }
+
+  this->add_pending_set_(variable_name, variable_name_to_send, variable_name_to_send + "=\"" + state_value + "\"",
+                         is_sleep_safe);
 }
 
 void Nextion::add_to_get_queue(NextionComponentBase *component) {
@@ -30,6 +30,9 @@ class NextionComponentBase;
 using nextion_writer_t = std::function<void(Nextion &)>;
 
 static const std::string COMMAND_DELIMITER{static_cast<char>(255), static_cast<char>(255), static_cast<char>(255)};
+/// Component updates are written while fewer than this many commands wait for their ack, so the display's serial
+/// buffer can't overflow while a page with many widgets is refreshed.
+static const size_t MAX_OUTSTANDING_COMMANDS = 8;
 
 class Nextion : public NextionBase, public PollingComponent, public uart::UARTDevice {
  public:
@@ -729,6 +732,14 @@ class Nextion : public NextionBase, public PollingComponent, public uart::UARTDe
 
  protected:
   std::deque<NextionQueue *> nextion_queue_;
+  struct PendingSet {
+    std::string variable_name;
+    std::string variable_name_to_send;
+    std::string command;
+    bool is_sleep_safe;
+  };
+  /// Component updates that weren't sent yet, only the latest value of each variable is kept.
+  std::deque<PendingSet> pending_sets_;
   uint16_t recv_ret_string_(std::string &response, uint32_t timeout, bool recv_flag);
   void all_components_send_state_(bool force_update = false);
   uint64_t comok_sent_ = 0;
@@ -753,6 +764,14 @@ class Nextion : public NextionBase, public PollingComponent, public uart::UARTDe
    * @param command The command to write, for example "vis b0,0".
    */
   bool send_command_(const std::string &command);
+  /// Write a command and its terminator to the UART.
+  void write_command_(const std::string &command);
+  /// Send coalesced component updates, only while fewer than MAX_OUTSTANDING_COMMANDS are waiting for an ack
+  /// unless all is set. They are checked like send_command_() checks a command, at the time they are sent.
+  void send_pending_sets_(bool all);
+  /// Queue a component update, replacing an update for the same variable that hasn't been sent yet.
+  void add_pending_set_(const std::string &variable_name, const std::string &variable_name_to_send,
+                        const std::string &command, bool is_sleep_safe);
   void add_no_result_to_queue_(const std::string &variable_name);
   bool add_no_result_to_queue_with_ignore_sleep_printf_(const std::string &variable_name, const char *format, ...)
       __attribute__((format(printf, 3, 4)));
@@ -265,7 +265,13 @@ void Nextion::upload_tft() {
   }
 #else
   // NOLINTNEXTLINE(readability-static-accessed-through-instance)
-  uint32_t chunk_size = ESP.getFreeHeap() < 10240 ? 4096 : 8192;
+  uint32_t free_heap = ESP.getFreeHeap();
+  uint32_t chunk_size = 8192;
+  if (free_heap > 40960) {  // 24K to keep on hand
+    chunk_size = 16384;
+  } else if (free_heap < 10240) {
+    chunk_size = 4096;
+  }
 #endif
 
   if (this->transfer_buffer_ == nullptr) {
@@ -4,6 +4,13 @@
 namespace esphome {
 namespace ota {
 
+/// Persisted progress of an upload, so an interrupted upload of the same image can be resumed.
+struct OTAResumeState {
+  char md5[32];
+  uint32_t image_size;
+  uint32_t written;
+};
+
 class OTABackend {
  public:
   virtual ~OTABackend() = default;
@@ -13,6 +20,16 @@ class OTABackend {
   virtual OTAResponseTypes end() = 0;
   virtual void abort() = 0;
   virtual bool supports_compression() = 0;
+  virtual bool supports_resume() { return false; }
+  /// Set where the progress of the upload is persisted, called before begin().
+  virtual void set_resume_state(ESPPreferenceObject *state) {}
+  /// Continue an interrupted upload of the same image (size and MD5), returns the offset the upload continues from.
+  virtual size_t resume() { return 0; }
+  virtual bool supports_delta() { return false; }
+  /// Get the SHA-256 of the running firmware (32 bytes), which a delta update is based on.
+  virtual bool get_running_digest(uint8_t *digest) { return false; }
+  /// Apply the upload as a delta against the running firmware (see DeltaDecoder), called before begin().
+  virtual void set_delta(bool delta) {}
 };
 
 }  // namespace ota
@@ -4,60 +4,244 @@
 #include "ota_backend_esp_idf.h"
 #include "ota_component.h"
 #include <esp_ota_ops.h>
+#include <esp_image_format.h>
+#include <esp_spi_flash.h>
 #include "esphome/components/md5/md5.h"
+#include "esphome/core/application.h"
+
+#include <algorithm>
 
 namespace esphome {
 namespace ota {
 
+/// The progress is persisted every time this many bytes have been written.
+static const size_t RESUME_CHECKPOINT_SIZE = 64 * 1024;
+/// Size of each of the two buffers handed to the writer task.
+static const size_t PIPELINE_BUFFER_SIZE = SPI_FLASH_SEC_SIZE;
+/// How far the writer task erases ahead of the write pointer while it waits for data.
+static const size_t PIPELINE_ERASE_AHEAD = 4 * SPI_FLASH_SEC_SIZE;
+static const uint8_t PIPELINE_STOP = 0xFF;
+
+IDFOTABackend::~IDFOTABackend() { this->stop_writer_(); }
+
 OTAResponseTypes IDFOTABackend::begin(size_t image_size) {
   this->partition_ = esp_ota_get_next_update_partition(nullptr);
   if (this->partition_ == nullptr) {
     return OTA_RESPONSE_ERROR_NO_UPDATE_PARTITION;
   }
-  esp_err_t err = esp_ota_begin(this->partition_, image_size, &this->update_handle_);
-  if (err != ESP_OK) {
-    esp_ota_abort(this->update_handle_);
-    this->update_handle_ = 0;
-    if (err == ESP_ERR_INVALID_SIZE) {
-      return OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE;
-    } else if (err == ESP_ERR_FLASH_OP_TIMEOUT || err == ESP_ERR_FLASH_OP_FAIL) {
-      return OTA_RESPONSE_ERROR_WRITING_FLASH;
-    }
-    return OTA_RESPONSE_ERROR_UNKNOWN;
+  if (image_size > this->partition_->size) {
+    return OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE;
   }
+  // Unlike esp_ota_begin(), nothing is erased up front, so a resumed upload keeps what's already in flash
+  this->image_size_ = image_size;
+  this->erase_limit_ = image_size;
+  this->write_offset_ = 0;
+  this->erased_end_ = 0;
+  this->written_ = 0;
+  this->checkpoint_ = 0;
+  this->error_ = OTA_RESPONSE_OK;
   this->md5_.init();
+
+  if (this->delta_) {
+    // image_size is the size of the delta, the size of the image itself is only known once it's decoded
+    this->erase_limit_ = this->partition_->size;
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    this->delta_decoder_ = make_unique<DeltaDecoder>(
+        running->size,
+        [running](size_t offset, uint8_t *data, size_t len) {
+          return esp_partition_read(running, offset, data, len) == ESP_OK;
+        },
+        [this](const uint8_t *data, size_t len) { return this->queue_data_(data, len); });
+  }
+
+  for (auto &buffer : this->buffers_)
+    buffer.resize(PIPELINE_BUFFER_SIZE);
+  this->fill_index_ = 0;
+  this->fill_len_ = 0;
+  this->queue_ = xQueueCreate(2, sizeof(uint8_t));
+  // The buffer that isn't being filled starts out free
+  this->free_buffers_ = xSemaphoreCreateCounting(2, 1);
+  this->caller_ = xTaskGetCurrentTaskHandle();
+  if (this->queue_ == nullptr || this->free_buffers_ == nullptr ||
+      xTaskCreate(IDFOTABackend::writer_task_, "ota_writer", 4096, this, uxTaskPriorityGet(nullptr), &this->task_) !=
+          pdPASS) {
+    this->task_ = nullptr;
+    this->stop_writer_();
+    return OTA_RESPONSE_ERROR_UNKNOWN;
+  }
   return OTA_RESPONSE_OK;
 }
 
 void IDFOTABackend::set_update_md5(const char *expected_md5) { memcpy(this->expected_bin_md5_, expected_md5, 32); }
 
+bool IDFOTABackend::get_running_digest(uint8_t *digest) {
+  return esp_partition_get_sha256(esp_ota_get_running_partition(), digest) == ESP_OK;
+}
+
+size_t IDFOTABackend::resume() {
+  OTAResumeState state{};
+  // A delta can't be resumed, the progress is tracked in image offsets
+  if (this->delta_ || this->resume_state_ == nullptr || !this->resume_state_->load(&state))
+    return 0;
+  if (state.image_size != this->image_size_ || state.written == 0 || state.written > this->image_size_ ||
+      memcmp(state.md5, this->expected_bin_md5_, 32) != 0)
+    return 0;
+
+  // The MD5 covers the whole image, so hash the part that's already in flash again. Nothing was handed to the
+  // writer task yet, so its state can still be set from here.
+  uint8_t buf[1024];
+  for (size_t pos = 0; pos < state.written; pos += sizeof(buf)) {
+    size_t len = std::min(sizeof(buf), state.written - pos);
+    if (esp_partition_read(this->partition_, pos, buf, len) != ESP_OK) {
+      this->md5_.init();
+      return 0;
+    }
+    this->md5_.add(buf, len);
+    App.feed_wdt();
+  }
+  this->write_offset_ = state.written;
+  this->erased_end_ = state.written;
+  this->written_ = state.written;
+  this->checkpoint_ = state.written / RESUME_CHECKPOINT_SIZE;
+  return state.written;
+}
+
 OTAResponseTypes IDFOTABackend::write(uint8_t *data, size_t len) {
-  esp_err_t err = esp_ota_write(this->update_handle_, data, len);
-  this->md5_.add(data, len);
-  if (err != ESP_OK) {
-    if (err == ESP_ERR_OTA_VALIDATE_FAILED) {
-      return OTA_RESPONSE_ERROR_MAGIC;
-    } else if (err == ESP_ERR_FLASH_OP_TIMEOUT || err == ESP_ERR_FLASH_OP_FAIL) {
-      return OTA_RESPONSE_ERROR_WRITING_FLASH;
+  if (this->delta_) {
+    this->md5_.add(data, len);
+    OTAResponseTypes error = this->delta_decoder_->feed(data, len);
+    return error != OTA_RESPONSE_OK ? error : this->error_.load();
+  }
+
+  OTAResponseTypes error = this->queue_data_(data, len);
+  const size_t written = this->written_;
+  if (written / RESUME_CHECKPOINT_SIZE != this->checkpoint_) {
+    this->checkpoint_ = written / RESUME_CHECKPOINT_SIZE;
+    // Only whole sectors are recorded, the sector the upload continues in is erased again when resuming
+    this->save_progress_(written - written % SPI_FLASH_SEC_SIZE);
+  }
+  return error;
+}
+
+OTAResponseTypes IDFOTABackend::queue_data_(const uint8_t *data, size_t len) {
+  while (len > 0 && this->error_ == OTA_RESPONSE_OK) {
+    size_t chunk = std::min(len, PIPELINE_BUFFER_SIZE - this->fill_len_);
+    memcpy(this->buffers_[this->fill_index_].data() + this->fill_len_, data, chunk);
+    this->fill_len_ += chunk;
+    data += chunk;
+    len -= chunk;
+    if (this->fill_len_ == PIPELINE_BUFFER_SIZE)
+      this->send_buffer_();
+  }
+  return this->error_;
+}
+
+void IDFOTABackend::send_buffer_() {
+  this->buffer_len_[this->fill_index_] = this->fill_len_;
+  xQueueSend(this->queue_, &this->fill_index_, portMAX_DELAY);
+  xSemaphoreTake(this->free_buffers_, portMAX_DELAY);
+  this->fill_index_ ^= 1;
+  this->fill_len_ = 0;
+}
+
+void IDFOTABackend::writer_task_(void *arg) { static_cast<IDFOTABackend *>(arg)->run_writer_(); }
+
+void IDFOTABackend::run_writer_() {
+  uint8_t index;
+  while (xQueueReceive(this->queue_, &index, portMAX_DELAY) == pdTRUE && index != PIPELINE_STOP) {
+    // After an error buffers are still handed back, so the receiving side never blocks
+    if (this->error_ == OTA_RESPONSE_OK)
+      this->error_ = this->write_buffer_(this->buffers_[index].data(), this->buffer_len_[index]);
+    xSemaphoreGive(this->free_buffers_);
+
+    // Erase ahead while the next buffer is being received
+    const size_t erase_limit = std::min(this->write_offset_ + PIPELINE_ERASE_AHEAD, this->erase_limit_);
+    while (this->error_ == OTA_RESPONSE_OK && this->erased_end_ < erase_limit &&
+           uxQueueMessagesWaiting(this->queue_) == 0) {
+      if (esp_partition_erase_range(this->partition_, this->erased_end_, SPI_FLASH_SEC_SIZE) != ESP_OK) {
+        this->error_ = OTA_RESPONSE_ERROR_WRITING_FLASH;
+        break;
+      }
+      this->erased_end_ += SPI_FLASH_SEC_SIZE;
     }
-    return OTA_RESPONSE_ERROR_UNKNOWN;
   }
+  xTaskNotifyGive(this->caller_);
+  vTaskDelete(nullptr);
+}
+
+OTAResponseTypes IDFOTABackend::write_buffer_(const uint8_t *data, size_t len) {
+  if (this->write_offset_ == 0 && len > 0 && data[0] != ESP_IMAGE_HEADER_MAGIC) {
+    return OTA_RESPONSE_ERROR_MAGIC;
+  }
+  if (this->write_offset_ + len > this->partition_->size) {
+    return OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE;
+  }
+  while (this->erased_end_ < this->write_offset_ + len) {
+    if (esp_partition_erase_range(this->partition_, this->erased_end_, SPI_FLASH_SEC_SIZE) != ESP_OK)
+      return OTA_RESPONSE_ERROR_WRITING_FLASH;
+    this->erased_end_ += SPI_FLASH_SEC_SIZE;
+  }
+  if (esp_partition_write(this->partition_, this->write_offset_, data, len) != ESP_OK) {
+    return OTA_RESPONSE_ERROR_WRITING_FLASH;
+  }
+  if (!this->delta_)
+    this->md5_.add(data, len);
+  this->write_offset_ += len;
+  this->written_ = this->write_offset_;
   return OTA_RESPONSE_OK;
 }
 
+void IDFOTABackend::stop_writer_() {
+  if (this->task_ != nullptr) {
+    // The queue is in order, so once the task stopped everything before was written
+    xQueueSend(this->queue_, &PIPELINE_STOP, portMAX_DELAY);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    this->task_ = nullptr;
+  }
+  if (this->queue_ != nullptr) {
+    vQueueDelete(this->queue_);
+    this->queue_ = nullptr;
+  }
+  if (this->free_buffers_ != nullptr) {
+    vSemaphoreDelete(this->free_buffers_);
+    this->free_buffers_ = nullptr;
+  }
+  for (auto &buffer : this->buffers_) {
+    buffer.clear();
+    buffer.shrink_to_fit();
+  }
+}
+
+void IDFOTABackend::save_progress_(uint32_t written) {
+  if (this->resume_state_ == nullptr)
+    return;
+  OTAResumeState state{};
+  memcpy(state.md5, this->expected_bin_md5_, 32);
+  state.image_size = this->image_size_;
+  state.written = written;
+  this->resume_state_->save(&state);
+  global_preferences->sync();
+}
+
 OTAResponseTypes IDFOTABackend::end() {
+  if (this->fill_len_ > 0 && this->error_ == OTA_RESPONSE_OK)
+    this->send_buffer_();
+  this->stop_writer_();
+  // Whatever the outcome, this upload can't be resumed anymore
+  this->save_progress_(0);
+  if (this->error_ != OTA_RESPONSE_OK)
+    return this->error_;
+  if (this->delta_ && !this->delta_decoder_->is_complete())
+    return OTA_RESPONSE_ERROR_DELTA;
+
   this->md5_.calculate();
   if (!this->md5_.equals_hex(this->expected_bin_md5_)) {
-    this->abort();
     return OTA_RESPONSE_ERROR_UPDATE_END;
   }
-  esp_err_t err = esp_ota_end(this->update_handle_);
-  this->update_handle_ = 0;
+  // Verifies the image before making it bootable
+  esp_err_t err = esp_ota_set_boot_partition(this->partition_);
   if (err == ESP_OK) {
-    err = esp_ota_set_boot_partition(this->partition_);
-    if (err == ESP_OK) {
-      return OTA_RESPONSE_OK;
-    }
+    return OTA_RESPONSE_OK;
   }
   if (err == ESP_ERR_OTA_VALIDATE_FAILED) {
     return OTA_RESPONSE_ERROR_UPDATE_END;
@@ -69,8 +253,8 @@ OTAResponseTypes IDFOTABackend::end() {
 }
 
 void IDFOTABackend::abort() {
-  esp_ota_abort(this->update_handle_);
-  this->update_handle_ = 0;
+  // The progress saved so far stays, so the upload can be resumed
+  this->stop_writer_();
 }
 
 }  // namespace ota
@@ -4,26 +4,83 @@
 
 #include "ota_component.h"
 #include "ota_backend.h"
+#include "ota_delta.h"
 #include <esp_ota_ops.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 #include "esphome/components/md5/md5.h"
+#include "esphome/core/helpers.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace esphome {
 namespace ota {
 
+/** Writes the update straight to the partition, erasing sectors as it goes so an interrupted upload can be resumed.
+ *
+ * Received data is collected in one of two buffers while a separate task writes the other one to flash, so the
+ * network isn't idle while a sector is erased. The writer erases ahead of the write pointer while it waits for data.
+ */
 class IDFOTABackend : public OTABackend {
  public:
+  ~IDFOTABackend() override;
   OTAResponseTypes begin(size_t image_size) override;
   void set_update_md5(const char *md5) override;
   OTAResponseTypes write(uint8_t *data, size_t len) override;
   OTAResponseTypes end() override;
   void abort() override;
   bool supports_compression() override { return false; }
+  bool supports_resume() override { return true; }
+  void set_resume_state(ESPPreferenceObject *state) override { this->resume_state_ = state; }
+  size_t resume() override;
+  bool supports_delta() override { return true; }
+  bool get_running_digest(uint8_t *digest) override;
+  void set_delta(bool delta) override { this->delta_ = delta; }
 
  private:
-  esp_ota_handle_t update_handle_{0};
+  static void writer_task_(void *arg);
+  void run_writer_();
+  /// Copy image data into the buffers handed to the writer task.
+  OTAResponseTypes queue_data_(const uint8_t *data, size_t len);
+  /// Hand the buffer being filled to the writer task, and wait for the other one to be free.
+  void send_buffer_();
+  void stop_writer_();
+  OTAResponseTypes write_buffer_(const uint8_t *data, size_t len);
+  void save_progress_(uint32_t written);
+
   const esp_partition_t *partition_;
-  md5::MD5Digest md5_{};
+  size_t image_size_{0};
+  /// The writer task doesn't erase ahead past this offset.
+  size_t erase_limit_{0};
+  bool delta_{false};
+  /// Rebuilds the image from a delta, the MD5 is computed over the delta itself by write().
+  std::unique_ptr<DeltaDecoder> delta_decoder_;
+  ESPPreferenceObject *resume_state_{nullptr};
   char expected_bin_md5_[32];
+  size_t checkpoint_{0};
+
+  /// Written to flash while the cache is disabled, so they must be in internal RAM.
+  std::vector<uint8_t, RAMAllocator<uint8_t, RAMPolicy::INTERNAL>> buffers_[2];
+  size_t buffer_len_[2]{};
+  uint8_t fill_index_{0};
+  size_t fill_len_{0};
+  TaskHandle_t task_{nullptr};
+  TaskHandle_t caller_{nullptr};
+  QueueHandle_t queue_{nullptr};
+  SemaphoreHandle_t free_buffers_{nullptr};
+  std::atomic<OTAResponseTypes> error_{OTA_RESPONSE_OK};
+  /// Bytes the writer task has written to flash.
+  std::atomic<size_t> written_{0};
+
+  // Only used by the writer task once it runs
+  size_t write_offset_{0};
+  /// Everything before this offset has been erased for this upload.
+  size_t erased_end_{0};
+  md5::MD5Digest md5_{};
 };
 
 }  // namespace ota
@@ -75,6 +75,10 @@ void OTAComponent::setup() {
     return;
   }
 
+#ifdef USE_ESP_IDF
+  this->resume_pref_ = global_preferences->make_preference<OTAResumeState>(fnv1_hash("ota_resume"));
+#endif
+
   this->dump_config();
 }
 
@@ -105,16 +109,25 @@ void OTAComponent::loop() {
 }
 
 static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
+static const uint8_t FEATURE_SUPPORTS_RESUME = 0x02;
+static const uint8_t FEATURE_SUPPORTS_DELTA = 0x04;
+/// The uploader creates the delta before it answers, which can take a while for large images.
+static const uint32_t DELTA_MODE_TIMEOUT = 20000;
 
 void OTAComponent::handle_() {
   OTAResponseTypes error_code = OTA_RESPONSE_ERROR_UNKNOWN;
   bool update_started = false;
   size_t total = 0;
   uint32_t last_progress = 0;
-  uint8_t buf[1024];
+  // Only used for the handshake, the update itself is received into data
+  uint8_t buf[128];
   char *sbuf = reinterpret_cast<char *>(buf);
+  std::unique_ptr<uint8_t[]> data;
   size_t ota_size;
   uint8_t ota_features;
+  bool compression;
+  bool resume;
+  bool delta;
   std::unique_ptr<OTABackend> backend;
   (void) ota_features;
 
@@ -157,6 +170,7 @@ void OTAComponent::handle_() {
   this->writeall_(buf, 2);
 
   backend = make_ota_backend();
+  backend->set_resume_state(&this->resume_pref_);
 
   // Read features - 1 byte
   if (!this->readall_(buf, 1)) {
@@ -167,13 +181,24 @@ void OTAComponent::handle_() {
   ESP_LOGV(TAG, "OTA features is 0x%02X", ota_features);
 
   // Acknowledge header - 1 byte
-  buf[0] = OTA_RESPONSE_HEADER_OK;
-  if ((ota_features & FEATURE_SUPPORTS_COMPRESSION) != 0 && backend->supports_compression()) {
-    buf[0] = OTA_RESPONSE_SUPPORTS_COMPRESSION;
+  compression = (ota_features & FEATURE_SUPPORTS_COMPRESSION) != 0 && backend->supports_compression();
+  resume = (ota_features & FEATURE_SUPPORTS_RESUME) != 0 && backend->supports_resume();
+  delta = (ota_features & FEATURE_SUPPORTS_DELTA) != 0 && backend->supports_delta();
+  if ((ota_features & ~(FEATURE_SUPPORTS_COMPRESSION | FEATURE_SUPPORTS_RESUME)) != 0) {
+    // Newer uploaders get the features both sides support as a bit field - 2 bytes
+    buf[0] = OTA_RESPONSE_SUPPORTED_FEATURES;
+    buf[1] = (compression ? FEATURE_SUPPORTS_COMPRESSION : 0) | (resume ? FEATURE_SUPPORTS_RESUME : 0) |
+             (delta ? FEATURE_SUPPORTS_DELTA : 0);
+    this->writeall_(buf, 2);
+  } else {
+    if (compression) {
+      buf[0] = resume ? OTA_RESPONSE_SUPPORTS_COMPRESSION_AND_RESUME : OTA_RESPONSE_SUPPORTS_COMPRESSION;
+    } else {
+      buf[0] = resume ? OTA_RESPONSE_SUPPORTS_RESUME : OTA_RESPONSE_HEADER_OK;
+    }
+    this->writeall_(buf, 1);
   }
 
-  this->writeall_(buf, 1);
-
 #ifdef USE_OTA_PASSWORD
   if (!this->password_.empty()) {
     buf[0] = OTA_RESPONSE_REQUEST_AUTH;
@@ -237,6 +262,20 @@ void OTAComponent::handle_() {
   buf[0] = OTA_RESPONSE_AUTH_OK;
   this->writeall_(buf, 1);
 
+  if (delta) {
+    // Send the SHA-256 of the running firmware - 32 bytes, all zeros if unknown
+    if (!backend->get_running_digest(buf))
+      memset(buf, 0, 32);
+    this->writeall_(buf, 32);
+    // Read whether the upload is a delta against it - 1 byte
+    if (!this->readall_(buf, 1, DELTA_MODE_TIMEOUT)) {
+      ESP_LOGW(TAG, "Reading delta mode failed!");
+      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    }
+    ESP_LOGD(TAG, "Update is a %s", buf[0] != 0 ? "delta" : "full image");
+    backend->set_delta(buf[0] != 0);
+  }
+
   // Read size, 4 bytes MSB first
   if (!this->readall_(buf, 4)) {
     ESP_LOGW(TAG, "Reading size failed!");
@@ -271,10 +310,21 @@ void OTAComponent::handle_() {
   buf[0] = OTA_RESPONSE_BIN_MD5_OK;
   this->writeall_(buf, 1);
 
+  if (resume) {
+    // Send the offset the upload continues from, 4 bytes MSB first
+    total = backend->resume();
+    if (total != 0)
+      ESP_LOGI(TAG, "Resuming interrupted update at %u bytes", total);
+    for (uint8_t i = 0; i < 4; i++)
+      buf[i] = total >> (24 - i * 8);
+    this->writeall_(buf, 4);
+  }
+
+  data.reset(new uint8_t[this->buffer_size_]);  // NOLINT(cppcoreguidelines-owning-memory)
   while (total < ota_size) {
     // TODO: timeout check
-    size_t requested = std::min(sizeof(buf), ota_size - total);
-    ssize_t read = this->client_->read(buf, requested);
+    size_t requested = std::min(this->buffer_size_, ota_size - total);
+    ssize_t read = this->client_->read(data.get(), requested);
     if (read == -1) {
       if (errno == EAGAIN || errno == EWOULDBLOCK) {
         App.feed_wdt();
@@ -291,7 +341,7 @@ void OTAComponent::handle_() {
       goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
     }
 
-    error_code = backend->write(buf, read);
+    error_code = backend->write(data.get(), read);
     if (error_code != OTA_RESPONSE_OK) {
       ESP_LOGW(TAG, "Error writing binary data to flash!");
       goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
@@ -312,6 +362,8 @@ void OTAComponent::handle_() {
     }
   }
 
+  data.reset();
+
   // Acknowledge receive OK - 1 byte
   buf[0] = OTA_RESPONSE_RECEIVE_OK;
   this->writeall_(buf, 1);
@@ -359,12 +411,12 @@ error:
 #endif
 }
 
-bool OTAComponent::readall_(uint8_t *buf, size_t len) {
+bool OTAComponent::readall_(uint8_t *buf, size_t len, uint32_t timeout) {
   uint32_t start = millis();
   uint32_t at = 0;
   while (len - at > 0) {
     uint32_t now = millis();
-    if (now - start > 1000) {
+    if (now - start > timeout) {
       ESP_LOGW(TAG, "Timed out reading %d bytes of data", len);
       return false;
     }
@@ -20,6 +20,9 @@ enum OTAResponseTypes {
   OTA_RESPONSE_RECEIVE_OK = 68,
   OTA_RESPONSE_UPDATE_END_OK = 69,
   OTA_RESPONSE_SUPPORTS_COMPRESSION = 70,
+  OTA_RESPONSE_SUPPORTS_RESUME = 71,
+  OTA_RESPONSE_SUPPORTS_COMPRESSION_AND_RESUME = 72,
+  OTA_RESPONSE_SUPPORTED_FEATURES = 73,
 
   OTA_RESPONSE_ERROR_MAGIC = 128,
   OTA_RESPONSE_ERROR_UPDATE_PREPARE = 129,
@@ -32,6 +35,7 @@ enum OTAResponseTypes {
   OTA_RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136,
   OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137,
   OTA_RESPONSE_ERROR_NO_UPDATE_PARTITION = 138,
+  OTA_RESPONSE_ERROR_DELTA = 139,
   OTA_RESPONSE_ERROR_UNKNOWN = 255,
 };
 
@@ -46,6 +50,8 @@ class OTAComponent : public Component {
 
   /// Manually set the port OTA should listen on.
   void set_port(uint16_t port);
+  /// Set the size of the buffer the update is received into.
+  void set_buffer_size(size_t buffer_size) { this->buffer_size_ = buffer_size; }
 
   bool should_enter_safe_mode(uint8_t num_attempts, uint32_t enable_time);
 
@@ -75,7 +81,7 @@ class OTAComponent : public Component {
   uint32_t read_rtc_();
 
   void handle_();
-  bool readall_(uint8_t *buf, size_t len);
+  bool readall_(uint8_t *buf, size_t len, uint32_t timeout = 1000);
   bool writeall_(const uint8_t *buf, size_t len);
 
 #ifdef USE_OTA_PASSWORD
@@ -83,6 +89,7 @@ class OTAComponent : public Component {
 #endif  // USE_OTA_PASSWORD
 
   uint16_t port_;
+  size_t buffer_size_{1024};
 
   std::unique_ptr<socket::Socket> server_;
   std::unique_ptr<socket::Socket> client_;
@@ -93,6 +100,8 @@ class OTAComponent : public Component {
   uint32_t safe_mode_rtc_value_;
   uint8_t safe_mode_num_attempts_;
   ESPPreferenceObject rtc_;
+  /// Progress of the last upload, for backends that can resume an interrupted one.
+  ESPPreferenceObject resume_pref_;
 
   static const uint32_t ENTER_SAFE_MODE_MAGIC =
       0x5afe5afe;  ///< a magic number to indicate that safe mode should be entered on next boot
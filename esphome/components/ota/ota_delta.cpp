@@ -0,0 +1,123 @@
+#include "ota_delta.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace ota {
+
+static const uint8_t DELTA_MAGIC[4] = {'E', 'O', 'D', '1'};
+static const uint8_t DELTA_OP_COPY = 0x01;
+static const uint8_t DELTA_OP_INSERT = 0x02;
+/// Copies from the running firmware go through a stack buffer of this size.
+static const size_t DELTA_COPY_CHUNK = 512;
+
+bool DeltaDecoder::collect_(const uint8_t *&data, size_t &len, size_t needed) {
+  size_t chunk = std::min(len, needed - this->field_len_);
+  memcpy(this->field_buffer_ + this->field_len_, data, chunk);
+  this->field_len_ += chunk;
+  data += chunk;
+  len -= chunk;
+  if (this->field_len_ < needed)
+    return false;
+  this->field_len_ = 0;
+  return true;
+}
+
+uint32_t DeltaDecoder::field_(size_t offset) const {
+  return encode_uint32(this->field_buffer_[offset + 3], this->field_buffer_[offset + 2],
+                       this->field_buffer_[offset + 1], this->field_buffer_[offset]);
+}
+
+OTAResponseTypes DeltaDecoder::copy_(uint32_t offset, uint32_t len) {
+  if (offset > this->source_size_ || len > this->source_size_ - offset)
+    return OTA_RESPONSE_ERROR_DELTA;
+  uint8_t buf[DELTA_COPY_CHUNK];
+  while (len > 0) {
+    size_t chunk = std::min<size_t>(len, sizeof(buf));
+    if (!this->read_source_(offset, buf, chunk))
+      return OTA_RESPONSE_ERROR_DELTA;
+    OTAResponseTypes error = this->write_image_(buf, chunk);
+    if (error != OTA_RESPONSE_OK)
+      return error;
+    offset += chunk;
+    len -= chunk;
+  }
+  return OTA_RESPONSE_OK;
+}
+
+void DeltaDecoder::operation_done_() {
+  this->state_ = this->produced_ == this->image_size_ ? State::COMPLETE : State::OPCODE;
+}
+
+OTAResponseTypes DeltaDecoder::feed(const uint8_t *data, size_t len) {
+  while (len > 0) {
+    switch (this->state_) {
+      case State::HEADER:
+        if (!this->collect_(data, len, 8))
+          break;
+        if (memcmp(this->field_buffer_, DELTA_MAGIC, sizeof(DELTA_MAGIC)) != 0)
+          return OTA_RESPONSE_ERROR_DELTA;
+        this->image_size_ = this->field_(4);
+        this->operation_done_();
+        break;
+      case State::OPCODE:
+        if (*data == DELTA_OP_COPY) {
+          this->state_ = State::COPY_ARGUMENTS;
+        } else if (*data == DELTA_OP_INSERT) {
+          this->state_ = State::INSERT_ARGUMENTS;
+        } else {
+          return OTA_RESPONSE_ERROR_DELTA;
+        }
+        data++;
+        len--;
+        break;
+      case State::COPY_ARGUMENTS: {
+        if (!this->collect_(data, len, 8))
+          break;
+        const uint32_t offset = this->field_(0);
+        const uint32_t copy_len = this->field_(4);
+        if (copy_len > this->image_size_ - this->produced_)
+          return OTA_RESPONSE_ERROR_DELTA;
+        OTAResponseTypes error = this->copy_(offset, copy_len);
+        if (error != OTA_RESPONSE_OK)
+          return error;
+        this->produced_ += copy_len;
+        this->operation_done_();
+        break;
+      }
+      case State::INSERT_ARGUMENTS:
+        if (!this->collect_(data, len, 4))
+          break;
+        this->insert_left_ = this->field_(0);
+        if (this->insert_left_ > this->image_size_ - this->produced_)
+          return OTA_RESPONSE_ERROR_DELTA;
+        if (this->insert_left_ == 0) {
+          this->operation_done_();
+        } else {
+          this->state_ = State::INSERT_DATA;
+        }
+        break;
+      case State::INSERT_DATA: {
+        size_t chunk = std::min(len, this->insert_left_);
+        OTAResponseTypes error = this->write_image_(data, chunk);
+        if (error != OTA_RESPONSE_OK)
+          return error;
+        data += chunk;
+        len -= chunk;
+        this->insert_left_ -= chunk;
+        this->produced_ += chunk;
+        if (this->insert_left_ == 0)
+          this->operation_done_();
+        break;
+      }
+      case State::COMPLETE:
+        // Data after the end of the image
+        return OTA_RESPONSE_ERROR_DELTA;
+    }
+  }
+  return OTA_RESPONSE_OK;
+}
+
+}  // namespace ota
+}  // namespace esphome
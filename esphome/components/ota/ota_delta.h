@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ota_component.h"
+
+#include <functional>
+
+namespace esphome {
+namespace ota {
+
+/** Rebuilds a firmware image from a delta update, streaming with a fixed amount of RAM.
+ *
+ * A delta copies ranges of the running firmware and inserts new data, the format (integers little endian) is:
+ *  - "EOD1", u32 size of the new image
+ *  - then operations until the new image is complete:
+ *    - 0x01, u32 source offset, u32 length: copy from the running firmware
+ *    - 0x02, u32 length, data: insert new data
+ *
+ * The uploader side lives in esphome/ota_delta.py.
+ */
+class DeltaDecoder {
+ public:
+  /// Read len bytes at offset of the running firmware.
+  using read_source_t = std::function<bool(size_t offset, uint8_t *data, size_t len)>;
+  /// Write the next len bytes of the new image.
+  using write_image_t = std::function<OTAResponseTypes(const uint8_t *data, size_t len)>;
+
+  DeltaDecoder(size_t source_size, read_source_t read_source, write_image_t write_image)
+      : source_size_(source_size), read_source_(std::move(read_source)), write_image_(std::move(write_image)) {}
+
+  /// Decode the next part of the delta.
+  OTAResponseTypes feed(const uint8_t *data, size_t len);
+  /// Whether the whole new image has been written.
+  bool is_complete() const { return this->state_ == State::COMPLETE; }
+  /// Size of the new image, 0 until the header has been decoded.
+  size_t get_image_size() const { return this->image_size_; }
+
+ protected:
+  enum class State : uint8_t { HEADER, OPCODE, COPY_ARGUMENTS, INSERT_ARGUMENTS, INSERT_DATA, COMPLETE };
+
+  /// Collect the fixed size fields of an operation, returns true once len bytes are there.
+  bool collect_(const uint8_t *&data, size_t &len, size_t needed);
+  uint32_t field_(size_t offset) const;
+  OTAResponseTypes copy_(uint32_t offset, uint32_t len);
+  void operation_done_();
+
+  size_t source_size_;
+  read_source_t read_source_;
+  write_image_t write_image_;
+  State state_{State::HEADER};
+  uint8_t field_buffer_[8];
+  size_t field_len_{0};
+  size_t image_size_{0};
+  size_t produced_{0};
+  /// Bytes left to insert in the current INSERT operation.
+  size_t insert_left_{0};
+};
+
+}  // namespace ota
+}  // namespace esphome
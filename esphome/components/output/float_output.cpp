@@ -32,12 +32,32 @@ void FloatOutput::set_level(float state) {
   }
 #endif
 
+  this->write_state(this->adjust_level_(state));
+}
+
+void FloatOutput::fade_level(float state, uint32_t length) {
+  state = clamp(state, 0.0f, 1.0f);
+
+#ifdef USE_POWER_SUPPLY
+  // when fading to off, the power supply is released by the set_level() call after the fade
+  if (state > 0.0f)
+    this->power_.request();
+#endif
+
+  if (this->supports_fade()) {
+    this->write_state_fade(this->adjust_level_(state), length);
+  } else {
+    this->write_state(this->adjust_level_(state));
+  }
+}
+
+float FloatOutput::adjust_level_(float state) const {
   if (!(state == 0.0f && this->zero_means_zero_))  // regardless of min_power_, 0.0 means off
     state = (state * (this->max_power_ - this->min_power_)) + this->min_power_;
 
   if (this->is_inverted())
     state = 1.0f - state;
-  this->write_state(state);
+  return state;
 }
 
 void FloatOutput::write_state(bool state) { this->set_level(state != this->inverted_ ? 1.0f : 0.0f); }
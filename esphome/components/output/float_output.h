@@ -58,6 +58,19 @@ class FloatOutput : public BinaryOutput {
    */
   void set_level(float state);
 
+  /** Fade from the current level to a new level over the given time, in hardware.
+   *
+   * Only outputs for which supports_fade() returns true implement this, others jump to the new level immediately.
+   * The fade happens in the background, the caller doesn't need to do anything until it is finished.
+   *
+   * @param state The new state.
+   * @param length The length of the fade in ms.
+   */
+  void fade_level(float state, uint32_t length);
+
+  /// Whether this output can fade between levels in hardware, see fade_level().
+  virtual bool supports_fade() const { return false; }
+
   /** Set the frequency of the output for PWM outputs.
    *
    * Implemented only by components which can set the output PWM frequency.
@@ -79,6 +92,10 @@ class FloatOutput : public BinaryOutput {
   /// Implement BinarySensor's write_enabled; this should never be called.
   void write_state(bool state) override;
   virtual void write_state(float state) = 0;
+  /// Fade to the state (already adjusted like for write_state()) in length ms, only called if supports_fade().
+  virtual void write_state_fade(float state, uint32_t length) { this->write_state(state); }
+  /// Apply min/max power and inversion to a level.
+  float adjust_level_(float state) const;
 
   float max_power_{1.0f};
   float min_power_{0.0f};
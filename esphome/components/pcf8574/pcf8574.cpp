@@ -16,17 +16,34 @@ void PCF8574Component::setup() {
 
   this->write_gpio_();
   this->read_gpio_();
+
+  if (this->interrupt_pin_ != nullptr) {
+    this->interrupt_pin_->setup();
+    // INT is active low, reading the port releases it again
+    this->interrupt_pin_->attach_interrupt(&PCF8574Component::gpio_intr, this, gpio::INTERRUPT_FALLING_EDGE);
+  }
+}
+void PCF8574Component::loop() {
+  if (this->interrupt_pin_ != nullptr && !this->input_changed_)
+    return;
+  this->input_changed_ = false;
+  this->input_valid_ = false;
 }
+void IRAM_ATTR PCF8574Component::gpio_intr(PCF8574Component *arg) { arg->input_changed_ = true; }
 void PCF8574Component::dump_config() {
   ESP_LOGCONFIG(TAG, "PCF8574:");
   LOG_I2C_DEVICE(this)
   ESP_LOGCONFIG(TAG, "  Is PCF8575: %s", YESNO(this->pcf8575_));
+  LOG_PIN("  Interrupt Pin: ", this->interrupt_pin_);
   if (this->is_failed()) {
     ESP_LOGE(TAG, "Communication with PCF8574 failed!");
   }
 }
 bool PCF8574Component::digital_read(uint8_t pin) {
-  this->read_gpio_();
+  if (!this->input_valid_ && this->read_gpio_()) {
+    // During setup every read goes to the chip
+    this->input_valid_ = (this->get_component_state() & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP;
+  }
   return this->input_mask_ & (1 << pin);
 }
 void PCF8574Component::digital_write(uint8_t pin, bool value) {
@@ -82,6 +99,8 @@ bool PCF8574Component::write_gpio_() {
   uint8_t data[2];
   data[0] = value;
   data[1] = value >> 8;
+  // Output pins read back as what was written, which the cached state doesn't know yet
+  this->input_valid_ = false;
   if (this->write(data, this->pcf8575_ ? 2 : 1) != i2c::ERROR_OK) {
     this->status_set_warning();
     return false;
@@ -12,9 +12,16 @@ class PCF8574Component : public Component, public i2c::I2CDevice {
   PCF8574Component() = default;
 
   void set_pcf8575(bool pcf8575) { pcf8575_ = pcf8575; }
+  /** Set the pin the INT output of the chip is connected to.
+   *
+   * The pins are then only read from the chip again after the chip signalled that an input changed.
+   */
+  void set_interrupt_pin(InternalGPIOPin *interrupt_pin) { interrupt_pin_ = interrupt_pin; }
 
   /// Check i2c availability and setup masks
   void setup() override;
+  /// Drop the port state read during the previous loop iteration (or before the last interrupt).
+  void loop() override;
   /// Helper function to read the value of a pin.
   bool digital_read(uint8_t pin);
   /// Helper function to write the value of a pin.
@@ -31,13 +38,20 @@ class PCF8574Component : public Component, public i2c::I2CDevice {
 
   bool write_gpio_();
 
+  static void gpio_intr(PCF8574Component *arg);
+
   /// Mask for the pin mode - 1 means output, 0 means input
   uint16_t mode_mask_{0x00};
   /// The mask to write as output state - 1 means HIGH, 0 means LOW
   uint16_t output_mask_{0x00};
   /// The state read in read_gpio_ - 1 means HIGH, 0 means LOW
   uint16_t input_mask_{0x00};
+  /// Whether input_mask_ was read during this loop iteration, so all pins are served from one read.
+  bool input_valid_{false};
   bool pcf8575_;  ///< TRUE->16-channel PCF8575, FALSE->8-channel PCF8574
+  InternalGPIOPin *interrupt_pin_{nullptr};
+  /// Set from the ISR of interrupt_pin_ when an input changed.
+  volatile bool input_changed_{true};
 };
 
 /// Helper class to expose a PCF8574 pin as an internal input GPIO pin.
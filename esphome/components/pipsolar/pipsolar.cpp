@@ -1,5 +1,6 @@
 #include "pipsolar.h"
 #include "esphome/core/log.h"
+#include "esphome/core/controller.h"
 
 namespace esphome {
 namespace pipsolar {
@@ -67,6 +68,7 @@ void Pipsolar::loop() {
   }
 
   if (this->state_ == STATE_POLL_DECODED) {
+    StateBatch batch;
     std::string mode;
     switch (this->used_polling_commands_[this->last_polling_command_].identifier) {
       case POLLING_QPIRI:
@@ -3,6 +3,7 @@
 #include <memory>
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 
 // Based on:
 // - https://cdn-shop.adafruit.com/datasheets/PN532C106_Application+Note_v1.2.pdf
@@ -75,6 +76,9 @@ void PN532::setup() {
     return;
   }
 
+  if (this->irq_pin_ != nullptr)
+    this->irq_pin_->setup();
+
   this->turn_off_rf_();
 }
 
@@ -82,6 +86,29 @@ void PN532::update() {
   for (auto *obj : this->binary_sensors_)
     obj->on_scan_end();
 
+  if (this->irq_pin_ != nullptr) {
+    if (this->requested_read_) {
+      // the PN532 is still polling, so the last tag left the field
+      this->report_tag_removed_();
+      return;
+    }
+    // poll until a tag is found, with the update interval (in units of 150ms) in between
+    const uint8_t period = clamp<uint32_t>(this->update_interval_ / 150, 1, 15);
+    if (!this->write_command_({
+            PN532_COMMAND_INAUTOPOLL,
+            0xFF,    // poll forever
+            period,  // pause between the polls
+            0x10,    // ISO14443A (106 kbit/s)
+        })) {
+      ESP_LOGW(TAG, "Starting to poll for tags failed!");
+      this->status_set_warning();
+      return;
+    }
+    this->status_clear_warning();
+    this->requested_read_ = true;
+    return;
+  }
+
   if (!this->write_command_({
           PN532_COMMAND_INLISTPASSIVETARGET,
           0x01,  // max 1 card
@@ -98,20 +125,19 @@ void PN532::update() {
 void PN532::loop() {
   if (!this->requested_read_)
     return;
+  // no response yet, without reading anything over the bus
+  if (this->irq_pin_ != nullptr && this->irq_pin_->digital_read())
+    return;
 
   std::vector<uint8_t> read;
-  bool success = this->read_response(PN532_COMMAND_INLISTPASSIVETARGET, read);
+  const uint8_t command = this->irq_pin_ != nullptr ? PN532_COMMAND_INAUTOPOLL : PN532_COMMAND_INLISTPASSIVETARGET;
+  bool success = this->read_response(command, read);
 
   this->requested_read_ = false;
 
   if (!success) {
     // Something failed
-    if (!this->current_uid_.empty()) {
-      auto tag = make_unique<nfc::NfcTag>(this->current_uid_);
-      for (auto *trigger : this->triggers_ontagremoved_)
-        trigger->process(tag);
-    }
-    this->current_uid_ = {};
+    this->report_tag_removed_();
     this->turn_off_rf_();
     return;
   }
@@ -119,15 +145,16 @@ void PN532::loop() {
   uint8_t num_targets = read[0];
   if (num_targets != 1) {
     // no tags found or too many
-    if (!this->current_uid_.empty()) {
-      auto tag = make_unique<nfc::NfcTag>(this->current_uid_);
-      for (auto *trigger : this->triggers_ontagremoved_)
-        trigger->process(tag);
-    }
-    this->current_uid_ = {};
+    this->report_tag_removed_();
     this->turn_off_rf_();
     return;
   }
+  if (command == PN532_COMMAND_INAUTOPOLL) {
+    // the target data follows the target type and its length, after that it's the same as for InListPassiveTarget
+    if (read.size() < 3)
+      return;
+    read.erase(read.begin() + 1, read.begin() + 3);
+  }
 
   uint8_t nfcid_length = read[5];
   std::vector<uint8_t> nfcid(read.begin() + 6, read.begin() + 6 + nfcid_length);
@@ -205,6 +232,15 @@ void PN532::loop() {
   this->turn_off_rf_();
 }
 
+void PN532::report_tag_removed_() {
+  if (!this->current_uid_.empty()) {
+    auto tag = make_unique<nfc::NfcTag>(this->current_uid_);
+    for (auto *trigger : this->triggers_ontagremoved_)
+      trigger->process(tag);
+  }
+  this->current_uid_ = {};
+}
+
 bool PN532::write_command_(const std::vector<uint8_t> &data) {
   std::vector<uint8_t> write_data;
   // Preamble
@@ -356,6 +392,7 @@ void PN532::dump_config() {
       break;
   }
 
+  LOG_PIN("  IRQ Pin: ", this->irq_pin_);
   LOG_UPDATE_INTERVAL(this);
 
   for (auto *child : this->binary_sensors_) {
@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/hal.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #include "esphome/components/nfc/nfc_tag.h"
 #include "esphome/components/nfc/nfc.h"
@@ -14,6 +15,7 @@ static const uint8_t PN532_COMMAND_SAMCONFIGURATION = 0x14;
 static const uint8_t PN532_COMMAND_RFCONFIGURATION = 0x32;
 static const uint8_t PN532_COMMAND_INDATAEXCHANGE = 0x40;
 static const uint8_t PN532_COMMAND_INLISTPASSIVETARGET = 0x4A;
+static const uint8_t PN532_COMMAND_INAUTOPOLL = 0x60;
 
 class PN532BinarySensor;
 class PN532OnTagTrigger;
@@ -29,6 +31,13 @@ class PN532 : public PollingComponent {
 
   void loop() override;
 
+  /** The P70_IRQ pin (active low), it's low when a response is ready.
+   *
+   * With it the PN532 polls for tags itself (InAutoPoll, every update interval) and only answers once a tag is in the
+   * field, so the bus is idle while there's no tag.
+   */
+  void set_irq_pin(GPIOPin *irq_pin) { this->irq_pin_ = irq_pin; }
+
   void register_tag(PN532BinarySensor *tag) { this->binary_sensors_.push_back(tag); }
   void register_ontag_trigger(PN532OnTagTrigger *trig) { this->triggers_ontag_.push_back(trig); }
   void register_ontagremoved_trigger(PN532OnTagTrigger *trig) { this->triggers_ontagremoved_.push_back(trig); }
@@ -46,6 +55,8 @@ class PN532 : public PollingComponent {
 
  protected:
   void turn_off_rf_();
+  /// Run the tag removed triggers if there was a tag.
+  void report_tag_removed_();
   bool write_command_(const std::vector<uint8_t> &data);
   bool read_ack_();
   void send_nack_();
@@ -77,6 +88,7 @@ class PN532 : public PollingComponent {
   bool write_mifare_ultralight_tag_(std::vector<uint8_t> &uid, nfc::NdefMessage *message);
   bool clean_mifare_ultralight_();
 
+  GPIOPin *irq_pin_{nullptr};
   bool requested_read_{false};
   std::vector<PN532BinarySensor *> binary_sensors_;
   std::vector<PN532OnTagTrigger *> triggers_ontag_;
@@ -0,0 +1,91 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components.esp32 import add_idf_sdkconfig_option, get_esp32_variant
+from esphome.components.esp32.const import (
+    VARIANT_ESP32,
+    VARIANT_ESP32C3,
+    VARIANT_ESP32S2,
+    VARIANT_ESP32S3,
+)
+from esphome.const import CONF_ID
+
+DEPENDENCIES = ["esp32"]
+
+CONF_MAX_FREQUENCY = "max_frequency"
+CONF_MIN_FREQUENCY = "min_frequency"
+CONF_LIGHT_SLEEP = "light_sleep"
+CONF_REPORT_INTERVAL = "report_interval"
+
+# The frequencies the CPU can run at, the minimum may also be the crystal frequency
+MAX_FREQUENCIES = {
+    VARIANT_ESP32: [80, 160, 240],
+    VARIANT_ESP32S2: [80, 160, 240],
+    VARIANT_ESP32S3: [80, 160, 240],
+    VARIANT_ESP32C3: [80, 160],
+}
+
+power_management_ns = cg.esphome_ns.namespace("power_management")
+PowerManagementComponent = power_management_ns.class_(
+    "PowerManagementComponent", cg.Component
+)
+
+
+def mhz(value):
+    value = cv.frequency(value)
+    if value % 1e6 != 0:
+        raise cv.Invalid("Frequency must be a whole number of MHz")
+    return int(value // 1e6)
+
+
+def _validate(config):
+    variant = get_esp32_variant()
+    if variant not in MAX_FREQUENCIES:
+        raise cv.Invalid(f"Power management is not supported on {variant}")
+    max_freq = config[CONF_MAX_FREQUENCY]
+    min_freq = config[CONF_MIN_FREQUENCY]
+    if max_freq not in MAX_FREQUENCIES[variant]:
+        frequencies = ", ".join(f"{f}MHz" for f in MAX_FREQUENCIES[variant])
+        raise cv.Invalid(
+            f"max_frequency must be one of {frequencies}", path=[CONF_MAX_FREQUENCY]
+        )
+    if min_freq > max_freq:
+        raise cv.Invalid(
+            "min_frequency must not be higher than max_frequency",
+            path=[CONF_MIN_FREQUENCY],
+        )
+    if min_freq != 40 and max_freq % min_freq != 0:
+        raise cv.Invalid(
+            "min_frequency must be 40MHz or divide max_frequency",
+            path=[CONF_MIN_FREQUENCY],
+        )
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(PowerManagementComponent),
+            cv.Optional(CONF_MAX_FREQUENCY, default="160MHz"): mhz,
+            cv.Optional(CONF_MIN_FREQUENCY, default="80MHz"): mhz,
+            cv.Optional(CONF_LIGHT_SLEEP, default=False): cv.boolean,
+            cv.Optional(CONF_REPORT_INTERVAL): cv.positive_time_period_milliseconds,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.only_with_esp_idf,
+    _validate,
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_max_frequency(config[CONF_MAX_FREQUENCY]))
+    cg.add(var.set_min_frequency(config[CONF_MIN_FREQUENCY]))
+    cg.add(var.set_light_sleep(config[CONF_LIGHT_SLEEP]))
+
+    add_idf_sdkconfig_option("CONFIG_PM_ENABLE", True)
+    if config[CONF_LIGHT_SLEEP]:
+        add_idf_sdkconfig_option("CONFIG_FREERTOS_USE_TICKLESS_IDLE", True)
+    if CONF_REPORT_INTERVAL in config:
+        cg.add(var.set_report_interval(config[CONF_REPORT_INTERVAL]))
+        add_idf_sdkconfig_option("CONFIG_PM_PROFILING", True)
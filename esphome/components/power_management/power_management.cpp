@@ -0,0 +1,98 @@
+#ifdef USE_ESP_IDF
+
+#include "power_management.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace esphome {
+namespace power_management {
+
+static const char *const TAG = "power_management";
+
+void PowerManagementComponent::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up power management...");
+#if defined(USE_ESP32_VARIANT_ESP32)
+  esp_pm_config_esp32_t config{};
+#elif defined(USE_ESP32_VARIANT_ESP32S2)
+  esp_pm_config_esp32s2_t config{};
+#elif defined(USE_ESP32_VARIANT_ESP32S3)
+  esp_pm_config_esp32s3_t config{};
+#elif defined(USE_ESP32_VARIANT_ESP32C3)
+  esp_pm_config_esp32c3_t config{};
+#endif
+  config.max_freq_mhz = this->max_frequency_mhz_;
+  config.min_freq_mhz = this->min_frequency_mhz_;
+  config.light_sleep_enable = this->light_sleep_;
+  esp_err_t err = esp_pm_configure(&config);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "esp_pm_configure failed: %s", esp_err_to_name(err));
+    this->mark_failed();
+    return;
+  }
+
+  err = esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "esphome_loop", &this->cpu_lock_);
+  if (err == ESP_OK)
+    err = esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "esphome_loop", &this->sleep_lock_);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "esp_pm_lock_create failed: %s", esp_err_to_name(err));
+    this->mark_failed();
+    return;
+  }
+
+  if (this->report_interval_ != 0)
+    this->set_interval("report", this->report_interval_, [this]() { this->report_(); });
+}
+
+void PowerManagementComponent::loop() {
+  // hold the locks for as long as some component needs the loop to run without pauses
+  bool lock = HighFrequencyLoopRequester::is_high_frequency();
+  if (lock == this->locked_)
+    return;
+  if (lock) {
+    esp_pm_lock_acquire(this->cpu_lock_);
+    esp_pm_lock_acquire(this->sleep_lock_);
+  } else {
+    esp_pm_lock_release(this->sleep_lock_);
+    esp_pm_lock_release(this->cpu_lock_);
+  }
+  this->locked_ = lock;
+}
+
+void PowerManagementComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Power Management:");
+  ESP_LOGCONFIG(TAG, "  Max Frequency: %d MHz", this->max_frequency_mhz_);
+  ESP_LOGCONFIG(TAG, "  Min Frequency: %d MHz", this->min_frequency_mhz_);
+  ESP_LOGCONFIG(TAG, "  Light Sleep: %s", YESNO(this->light_sleep_));
+  if (this->report_interval_ != 0)
+    ESP_LOGCONFIG(TAG, "  Report Interval: %u ms", this->report_interval_);
+}
+
+void PowerManagementComponent::report_() {
+  // esp_pm_dump_locks() only writes to a stream, collect that and log it line by line
+  char *buf = nullptr;
+  size_t len = 0;
+  FILE *stream = open_memstream(&buf, &len);
+  if (stream == nullptr)
+    return;
+  esp_pm_dump_locks(stream);
+  fclose(stream);
+  char *line = buf;
+  while (line != nullptr && *line != '\0') {
+    char *end = strchr(line, '\n');
+    if (end != nullptr)
+      *end = '\0';
+    if (*line != '\0')
+      ESP_LOGD(TAG, "%s", line);
+    line = end == nullptr ? nullptr : end + 1;
+  }
+  free(buf);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+}  // namespace power_management
+}  // namespace esphome
+
+#endif  // USE_ESP_IDF
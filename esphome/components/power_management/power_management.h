@@ -0,0 +1,47 @@
+#pragma once
+
+#ifdef USE_ESP_IDF
+
+#include "esphome/core/component.h"
+
+#include <esp_pm.h>
+
+namespace esphome {
+namespace power_management {
+
+/** Let ESP-IDF scale the CPU frequency with the load and enter light sleep while all tasks are idle.
+ *
+ * The main loop is idle most of the time, between its iterations it waits in select() or delay() and then runs at the
+ * minimum frequency or sleeps. While a component requests a high frequency loop (like a light transition), the
+ * maximum frequency is held and light sleep is prevented, so these keep their timing. The ESP-IDF drivers (UART, RMT,
+ * I2C, ...) hold their own locks while they need the clocks.
+ */
+class PowerManagementComponent : public Component {
+ public:
+  void set_max_frequency(int max_frequency_mhz) { this->max_frequency_mhz_ = max_frequency_mhz; }
+  void set_min_frequency(int min_frequency_mhz) { this->min_frequency_mhz_ = min_frequency_mhz; }
+  void set_light_sleep(bool light_sleep) { this->light_sleep_ = light_sleep; }
+  /// Log how long each power mode was used, every report_interval ms.
+  void set_report_interval(uint32_t report_interval) { this->report_interval_ = report_interval; }
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::HARDWARE; }
+
+ protected:
+  void report_();
+
+  int max_frequency_mhz_{240};
+  int min_frequency_mhz_{80};
+  bool light_sleep_{false};
+  uint32_t report_interval_{0};
+  esp_pm_lock_handle_t cpu_lock_{nullptr};
+  esp_pm_lock_handle_t sleep_lock_{nullptr};
+  bool locked_{false};
+};
+
+}  // namespace power_management
+}  // namespace esphome
+
+#endif  // USE_ESP_IDF
@@ -6,11 +6,25 @@
 namespace esphome {
 namespace preferences {
 
+/** Writes saved preferences to flash once the earliest deadline requested by a save passed, so a burst of saves ends
+ * up in one write. Saves without their own max delay have to be written within write_interval_.
+ */
 class IntervalSyncer : public Component {
  public:
   void set_write_interval(uint32_t write_interval) { write_interval_ = write_interval; }
-  void setup() override {
-    set_interval(write_interval_, []() { global_preferences->sync(); });
+  void setup() override { global_preferences->set_default_sync_delay(this->write_interval_); }
+  void loop() override {
+    if (!global_preferences->is_sync_requested())
+      return;
+    const int32_t overdue = static_cast<int32_t>(millis() - global_preferences->get_sync_deadline());
+    if (overdue < 0)
+      return;
+    // Latency-sensitive work can hold the write back, by at most one more write interval
+    if (global_preferences->are_writes_held() && overdue < static_cast<int32_t>(this->write_interval_))
+      return;
+    global_preferences->clear_sync_request();
+    if (!global_preferences->sync())
+      global_preferences->request_sync(0);  // try again later
   }
   void on_shutdown() override { global_preferences->sync(); }
   float get_setup_priority() const override { return setup_priority::BUS; }
@@ -3,163 +3,226 @@
 #include "prometheus_handler.h"
 #include "esphome/core/application.h"
 
+#include <algorithm>
+#include <memory>
+
 namespace esphome {
 namespace prometheus {
 
+/// A Print appending to a string that's reused for the rows of all entities.
+class StringPrint : public Print {
+ public:
+  using Print::write;
+  size_t write(uint8_t c) override {
+    this->buffer.push_back(static_cast<char>(c));
+    return 1;
+  }
+  size_t write(const uint8_t *data, size_t len) override {
+    this->buffer.append(reinterpret_cast<const char *>(data), len);
+    return len;
+  }
+
+  std::string buffer;
+};
+
+/// State of a chunked /metrics response, the rows of one entity are rendered at a time.
+struct MetricsCursor {
+  size_t entity{0};
+  StringPrint pending;
+  size_t pending_pos{0};
+};
+
 void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
+  // Rows are rendered as the connection asks for more data, so they're never all in memory at once
+  auto cursor = std::make_shared<MetricsCursor>();
+  AsyncWebServerResponse *response = req->beginChunkedResponse(
+      "text/plain; version=0.0.4; charset=utf-8", [this, cursor](uint8_t *buffer, size_t max_len, size_t index) {
+        size_t written = 0;
+        while (written < max_len) {
+          if (cursor->pending_pos == cursor->pending.buffer.size()) {
+            cursor->pending.buffer.clear();
+            cursor->pending_pos = 0;
+            if (!this->render_entity_(&cursor->pending, cursor->entity))
+              break;
+            cursor->entity++;
+            continue;
+          }
+          const size_t len = std::min(max_len - written, cursor->pending.buffer.size() - cursor->pending_pos);
+          memcpy(buffer + written, cursor->pending.buffer.data() + cursor->pending_pos, len);
+          written += len;
+          cursor->pending_pos += len;
+        }
+        return written;
+      });
+  req->send(response);
+}
 
+bool PrometheusHandler::render_entity_(Print *stream, size_t index) {
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
-  for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj);
+  if (index < App.get_sensors().size()) {
+    if (index == 0)
+      this->sensor_type_(stream);
+    this->sensor_row_(stream, App.get_sensors()[index]);
+    return true;
+  }
+  index -= App.get_sensors().size();
 #endif
 
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
-  for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj);
+  if (index < App.get_binary_sensors().size()) {
+    if (index == 0)
+      this->binary_sensor_type_(stream);
+    this->binary_sensor_row_(stream, App.get_binary_sensors()[index]);
+    return true;
+  }
+  index -= App.get_binary_sensors().size();
 #endif
 
 #ifdef USE_FAN
-  this->fan_type_(stream);
-  for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj);
+  if (index < App.get_fans().size()) {
+    if (index == 0)
+      this->fan_type_(stream);
+    this->fan_row_(stream, App.get_fans()[index]);
+    return true;
+  }
+  index -= App.get_fans().size();
 #endif
 
 #ifdef USE_LIGHT
-  this->light_type_(stream);
-  for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj);
+  if (index < App.get_lights().size()) {
+    if (index == 0)
+      this->light_type_(stream);
+    this->light_row_(stream, App.get_lights()[index]);
+    return true;
+  }
+  index -= App.get_lights().size();
 #endif
 
 #ifdef USE_COVER
-  this->cover_type_(stream);
-  for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj);
+  if (index < App.get_covers().size()) {
+    if (index == 0)
+      this->cover_type_(stream);
+    this->cover_row_(stream, App.get_covers()[index]);
+    return true;
+  }
+  index -= App.get_covers().size();
 #endif
 
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
-  for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj);
+  if (index < App.get_switches().size()) {
+    if (index == 0)
+      this->switch_type_(stream);
+    this->switch_row_(stream, App.get_switches()[index]);
+    return true;
+  }
+  index -= App.get_switches().size();
 #endif
 
-  req->send(stream);
+  return false;
+}
+
+/// The labels all metrics of an entity start with, the closing brace is added by the caller.
+static std::string entity_labels(EntityBase *obj) {
+  return "{id=\"" + obj->get_object_id() + "\",name=\"" + obj->get_name() + "\"";
 }
 
 // Type-specific implementation
 #ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
+void PrometheusHandler::sensor_type_(Print *stream) {
   stream->print(F("#TYPE esphome_sensor_value GAUGE\n"));
   stream->print(F("#TYPE esphome_sensor_failed GAUGE\n"));
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
+void PrometheusHandler::sensor_row_(Print *stream, sensor::Sensor *obj) {
   if (obj->is_internal())
     return;
+  const std::string labels = entity_labels(obj);
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    stream->print(F("esphome_sensor_failed"));
+    stream->print(labels.c_str());
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",unit=\""));
+    stream->print(F("esphome_sensor_value"));
+    stream->print(labels.c_str());
+    stream->print(F(",unit=\""));
     stream->print(obj->get_unit_of_measurement().c_str());
     stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
+    char value[VALUE_ACCURACY_MAX_LEN];
+    value_accuracy_to_buf(value, sizeof(value), obj->state, obj->get_accuracy_decimals());
+    stream->print(value);
     stream->print('\n');
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    stream->print(F("esphome_sensor_failed"));
+    stream->print(labels.c_str());
+    stream->print(F("} 1\n"));
   }
 }
 #endif
 
 // Type-specific implementation
 #ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
+void PrometheusHandler::binary_sensor_type_(Print *stream) {
   stream->print(F("#TYPE esphome_binary_sensor_value GAUGE\n"));
   stream->print(F("#TYPE esphome_binary_sensor_failed GAUGE\n"));
 }
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
+void PrometheusHandler::binary_sensor_row_(Print *stream, binary_sensor::BinarySensor *obj) {
   if (obj->is_internal())
     return;
+  const std::string labels = entity_labels(obj);
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    stream->print(F("esphome_binary_sensor_failed"));
+    stream->print(labels.c_str());
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
+    stream->print(F("esphome_binary_sensor_value"));
+    stream->print(labels.c_str());
+    stream->print(F("} "));
     stream->print(obj->state);
     stream->print('\n');
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    stream->print(F("esphome_binary_sensor_failed"));
+    stream->print(labels.c_str());
+    stream->print(F("} 1\n"));
   }
 }
 #endif
 
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
+void PrometheusHandler::fan_type_(Print *stream) {
   stream->print(F("#TYPE esphome_fan_value GAUGE\n"));
   stream->print(F("#TYPE esphome_fan_failed GAUGE\n"));
   stream->print(F("#TYPE esphome_fan_speed GAUGE\n"));
   stream->print(F("#TYPE esphome_fan_oscillation GAUGE\n"));
 }
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::FanState *obj) {
+void PrometheusHandler::fan_row_(Print *stream, fan::FanState *obj) {
   if (obj->is_internal())
     return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
+  const std::string labels = entity_labels(obj);
+  stream->print(F("esphome_fan_failed"));
+  stream->print(labels.c_str());
+  stream->print(F("} 0\n"));
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
+  stream->print(F("esphome_fan_value"));
+  stream->print(labels.c_str());
+  stream->print(F("} "));
   stream->print(obj->state);
   stream->print('\n');
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
+    stream->print(F("esphome_fan_speed"));
+    stream->print(labels.c_str());
+    stream->print(F("} "));
     stream->print(obj->speed);
     stream->print('\n');
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
+    stream->print(F("esphome_fan_oscillation"));
+    stream->print(labels.c_str());
+    stream->print(F("} "));
     stream->print(obj->oscillating);
     stream->print('\n');
   }
@@ -167,20 +230,19 @@ void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::FanState *obj
 #endif
 
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
+void PrometheusHandler::light_type_(Print *stream) {
   stream->print(F("#TYPE esphome_light_state GAUGE\n"));
   stream->print(F("#TYPE esphome_light_color GAUGE\n"));
   stream->print(F("#TYPE esphome_light_effect_active GAUGE\n"));
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
+void PrometheusHandler::light_row_(Print *stream, light::LightState *obj) {
   if (obj->is_internal())
     return;
+  const std::string labels = entity_labels(obj);
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
+  stream->print(F("esphome_light_state"));
+  stream->print(labels.c_str());
+  stream->print(F("} "));
   stream->print(obj->remote_values.is_on());
   stream->print(F("\n"));
   // Brightness and RGBW
@@ -188,55 +250,41 @@ void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightStat
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
+  stream->print(F("esphome_light_color"));
+  stream->print(labels.c_str());
+  stream->print(F(",channel=\"brightness\"} "));
   stream->print(brightness);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"r\"} "));
+  stream->print(F("esphome_light_color"));
+  stream->print(labels.c_str());
+  stream->print(F(",channel=\"r\"} "));
   stream->print(r);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"g\"} "));
+  stream->print(F("esphome_light_color"));
+  stream->print(labels.c_str());
+  stream->print(F(",channel=\"g\"} "));
   stream->print(g);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"b\"} "));
+  stream->print(F("esphome_light_color"));
+  stream->print(labels.c_str());
+  stream->print(F(",channel=\"b\"} "));
   stream->print(b);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"w\"} "));
+  stream->print(F("esphome_light_color"));
+  stream->print(labels.c_str());
+  stream->print(F(",channel=\"w\"} "));
   stream->print(w);
   stream->print(F("\n"));
   // Effect
   std::string effect = obj->get_effect_name();
   if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
+    stream->print(F("esphome_light_effect_active"));
+    stream->print(labels.c_str());
+    stream->print(F(",effect=\"None\"} 0\n"));
   } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",effect=\""));
+    stream->print(F("esphome_light_effect_active"));
+    stream->print(labels.c_str());
+    stream->print(F(",effect=\""));
     stream->print(effect.c_str());
     stream->print(F("\"} 1\n"));
   }
@@ -244,67 +292,57 @@ void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightStat
 #endif
 
 #ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
+void PrometheusHandler::cover_type_(Print *stream) {
   stream->print(F("#TYPE esphome_cover_value GAUGE\n"));
   stream->print(F("#TYPE esphome_cover_failed GAUGE\n"));
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
+void PrometheusHandler::cover_row_(Print *stream, cover::Cover *obj) {
   if (obj->is_internal())
     return;
+  const std::string labels = entity_labels(obj);
   if (!std::isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    stream->print(F("esphome_cover_failed"));
+    stream->print(labels.c_str());
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
+    stream->print(F("esphome_cover_value"));
+    stream->print(labels.c_str());
+    stream->print(F("} "));
     stream->print(obj->position);
     stream->print('\n');
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(obj->get_object_id().c_str());
-      stream->print(F("\",name=\""));
-      stream->print(obj->get_name().c_str());
-      stream->print(F("\"} "));
+      stream->print(F("esphome_cover_tilt"));
+      stream->print(labels.c_str());
+      stream->print(F("} "));
       stream->print(obj->tilt);
       stream->print('\n');
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    stream->print(F("esphome_cover_failed"));
+    stream->print(labels.c_str());
+    stream->print(F("} 1\n"));
   }
 }
 #endif
 
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
+void PrometheusHandler::switch_type_(Print *stream) {
   stream->print(F("#TYPE esphome_switch_value GAUGE\n"));
   stream->print(F("#TYPE esphome_switch_failed GAUGE\n"));
 }
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
+void PrometheusHandler::switch_row_(Print *stream, switch_::Switch *obj) {
   if (obj->is_internal())
     return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
+  const std::string labels = entity_labels(obj);
+  stream->print(F("esphome_switch_failed"));
+  stream->print(labels.c_str());
+  stream->print(F("} 0\n"));
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
+  stream->print(F("esphome_switch_value"));
+  stream->print(labels.c_str());
+  stream->print(F("} "));
   stream->print(obj->state);
   stream->print('\n');
 }
@@ -1,7 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components.esp32 import add_idf_sdkconfig_option
-from esphome.core import CORE
+from esphome.core import CORE, coroutine_with_priority
 from esphome.const import (
     CONF_ID,
 )
@@ -10,12 +10,30 @@ CODEOWNERS = ["@esphome/core"]
 
 psram_ns = cg.esphome_ns.namespace("psram")
 PsramComponent = psram_ns.class_("PsramComponent", cg.Component)
+RAMPolicy = cg.esphome_ns.enum("RAMPolicy", is_class=True)
+ram_policy_set_external = cg.esphome_ns.ram_policy_set_external
+
+CONF_BULK_BUFFERS = "bulk_buffers"
+BUFFER_LOCATIONS = {
+    "external": True,
+    "internal": False,
+}
 
 CONFIG_SCHEMA = cv.All(
-    cv.Schema({cv.GenerateID(): cv.declare_id(PsramComponent)}), cv.only_on_esp32
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(PsramComponent),
+            cv.Optional(CONF_BULK_BUFFERS, default="external"): cv.enum(
+                BUFFER_LOCATIONS, lower=True
+            ),
+        }
+    ),
+    cv.only_on_esp32,
 )
 
 
+# Before the components whose buffers are allocated while the configuration is applied (logger)
+@coroutine_with_priority(95.0)
 async def to_code(config):
     if CORE.using_arduino:
         cg.add_build_flag("-DBOARD_HAS_PSRAM")
@@ -27,3 +45,6 @@ async def to_code(config):
 
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+
+    if not config[CONF_BULK_BUFFERS]:
+        cg.add(ram_policy_set_external(RAMPolicy.BULK, False))
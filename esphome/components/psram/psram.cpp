@@ -2,6 +2,7 @@
 
 #ifdef USE_ESP32
 
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 #include <esp_heap_caps.h>
@@ -24,6 +25,12 @@ void PsramComponent::dump_config() {
     ESP_LOGCONFIG(TAG, "  Size: %d MB", heap_caps_get_total_size(MALLOC_CAP_SPIRAM) / 1024 / 1024);
   }
 #endif
+  static const char *const POLICIES[RAM_POLICY_COUNT] = {"Internal", "Bulk"};
+  for (uint8_t i = 0; i < RAM_POLICY_COUNT; i++) {
+    RAMPolicyStats stats = ram_policy_stats(static_cast<RAMPolicy>(i));
+    ESP_LOGCONFIG(TAG, "  %s Buffers: %zu B internal, %zu B external, %zu B peak, %u failed", POLICIES[i],
+                  stats.internal_bytes, stats.external_bytes, stats.peak_bytes, stats.failures);
+  }
 }
 
 }  // namespace psram
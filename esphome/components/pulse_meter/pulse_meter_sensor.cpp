@@ -6,26 +6,74 @@ namespace pulse_meter {
 
 static const char *const TAG = "pulse_meter";
 
+#ifdef HAS_PCNT
+// The PCNT glitch filter counts up to 1023 APB clock cycles, 13us is rounded down to that like in pulse_counter
+static const uint32_t PCNT_MAX_FILTER_US = 13;
+static const uint16_t PCNT_MAX_PULSES_PER_INTERRUPT = 16384;
+#endif
+
 void PulseMeterSensor::setup() {
   this->pin_->setup();
-  this->isr_pin_ = pin_->to_isr();
-  this->pin_->attach_interrupt(PulseMeterSensor::gpio_intr, this, gpio::INTERRUPT_ANY_EDGE);
-
   this->last_detected_edge_us_ = 0;
   this->last_valid_edge_us_ = 0;
+
+#ifdef HAS_PCNT
+  // Longer filters debounce the edges of slow pulses, which only the interrupt handler can do
+  if (this->filter_us_ <= PCNT_MAX_FILTER_US) {
+    this->use_pcnt_ = this->setup_pcnt_();
+    if (this->use_pcnt_)
+      return;
+    ESP_LOGW(TAG, "Falling back to a GPIO interrupt");
+  }
+#endif
+
+  this->isr_pin_ = pin_->to_isr();
+  this->pin_->attach_interrupt(PulseMeterSensor::gpio_intr, this, gpio::INTERRUPT_ANY_EDGE);
 }
 
 void PulseMeterSensor::loop() {
-  const uint32_t now = micros();
-
   // If we've exceeded our timeout interval without receiving any pulses, assume 0 pulses/min until
   // we get at least two valid pulses.
-  const uint32_t time_since_valid_edge_us = now - this->last_valid_edge_us_;
-  if ((this->last_valid_edge_us_ != 0) && (time_since_valid_edge_us > this->timeout_us_)) {
+  uint32_t time_since_valid_edge_us;
+  bool timed_out;
+  {
+    // An edge coming in between the check and the reset isn't lost
+    InterruptLock lock;
+    time_since_valid_edge_us = micros() - this->last_valid_edge_us_;
+    timed_out = (this->last_valid_edge_us_ != 0) && (time_since_valid_edge_us > this->timeout_us_);
+    if (timed_out) {
+      this->last_valid_edge_us_ = 0;
+      this->pulse_width_us_ = 0;
+    }
+  }
+  if (timed_out) {
     ESP_LOGD(TAG, "No pulse detected for %us, assuming 0 pulses/min", time_since_valid_edge_us / 1000000);
-    this->last_valid_edge_us_ = 0;
-    this->pulse_width_us_ = 0;
+#ifdef HAS_PCNT
+    if (this->use_pcnt_ && this->pulses_per_interrupt_ != 1)
+      this->set_pulses_per_interrupt_(1);
+#endif
+  }
+
+#ifdef HAS_PCNT
+  if (this->use_pcnt_ && this->pulse_width_us_ != 0) {
+    // Interrupt about once per millisecond at high rates. Pulses per interrupt follow the pulse rate in powers of
+    // two, with some room so they don't flap.
+    const uint32_t desired = 1000 / this->pulse_width_us_;
+    const uint16_t next = this->next_pulses_per_interrupt_;
+    const uint32_t current = next != 0 ? next : this->pulses_per_interrupt_;
+    if (desired >= current * 2 || desired * 4 < current) {
+      uint32_t pulses = 1;
+      while (pulses < desired && pulses < PCNT_MAX_PULSES_PER_INTERRUPT)
+        pulses *= 2;
+      // While pulses come in, an interrupt for the counter reaching the old limit may be pending, so the new limit is
+      // applied by the interrupt handler after it reset the counter.
+      if (pulses != current) {
+        ESP_LOGV(TAG, "Interrupting every %u pulses", pulses);
+        this->next_pulses_per_interrupt_ = pulses;
+      }
+    }
   }
+#endif
 
   // We quantize our pulse widths to 1 ms to avoid unnecessary jitter
   const uint32_t pulse_width_ms = this->pulse_width_us_ / 1000;
@@ -40,19 +88,38 @@ void PulseMeterSensor::loop() {
   }
 
   if (this->total_sensor_ != nullptr) {
+#ifdef HAS_PCNT
+    const uint32_t total = this->use_pcnt_ ? this->read_total_pulses_() : this->total_pulses_;
+#else
     const uint32_t total = this->total_pulses_;
+#endif
     if (this->total_dedupe_.next(total)) {
       this->total_sensor_->publish_state(total);
     }
   }
 }
 
-void PulseMeterSensor::set_total_pulses(uint32_t pulses) { this->total_pulses_ = pulses; }
+void PulseMeterSensor::set_total_pulses(uint32_t pulses) {
+#ifdef HAS_PCNT
+  if (this->use_pcnt_) {
+    InterruptLock lock;
+    pcnt_counter_clear(this->pcnt_unit_);
+    // The interval that was counting is cut short, so it can't be measured
+    this->last_valid_edge_us_ = 0;
+    this->last_total_ = pulses;
+  }
+#endif
+  this->total_pulses_ = pulses;
+}
 
 void PulseMeterSensor::dump_config() {
   LOG_SENSOR("", "Pulse Meter", this);
   LOG_PIN("  Pin: ", this->pin_);
   ESP_LOGCONFIG(TAG, "  Filtering pulses shorter than %u µs", this->filter_us_);
+#ifdef HAS_PCNT
+  if (this->use_pcnt_)
+    ESP_LOGCONFIG(TAG, "  PCNT Unit Number: %u", this->pcnt_unit_);
+#endif
   ESP_LOGCONFIG(TAG, "  Assuming 0 pulses/min after not receiving a pulse for %us", this->timeout_us_ / 1000000);
 }
 
@@ -81,5 +148,112 @@ void IRAM_ATTR PulseMeterSensor::gpio_intr(PulseMeterSensor *sensor) {
   sensor->last_detected_edge_us_ = now;
 }
 
+#ifdef HAS_PCNT
+bool PulseMeterSensor::setup_pcnt_() {
+  // pulse_counter hands out PCNT units from the first one, so these are taken from the last one
+  static int next_pcnt_unit = PCNT_UNIT_MAX - 1;
+  if (next_pcnt_unit < 0) {
+    ESP_LOGW(TAG, "No PCNT unit left");
+    return false;
+  }
+  this->pcnt_unit_ = pcnt_unit_t(next_pcnt_unit--);
+
+  pcnt_config_t pcnt_config = {
+      .pulse_gpio_num = this->pin_->get_pin(),
+      .ctrl_gpio_num = PCNT_PIN_NOT_USED,
+      .lctrl_mode = PCNT_MODE_KEEP,
+      .hctrl_mode = PCNT_MODE_KEEP,
+      .pos_mode = PCNT_COUNT_INC,
+      .neg_mode = PCNT_COUNT_DIS,
+      .counter_h_lim = 1,
+      .counter_l_lim = 0,
+      .unit = this->pcnt_unit_,
+      .channel = PCNT_CHANNEL_0,
+  };
+  esp_err_t error = pcnt_unit_config(&pcnt_config);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Configuring PCNT unit failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  if (this->filter_us_ != 0) {
+    pcnt_set_filter_value(this->pcnt_unit_, std::min(static_cast<unsigned int>(this->filter_us_ * 80u), 1023u));
+    pcnt_filter_enable(this->pcnt_unit_);
+  }
+
+  // The counter resets when it reaches the high limit, that's when the interrupt timestamps the pulse
+  error = pcnt_isr_service_install(0);
+  // Other components may have installed the service already
+  if (error != ESP_OK && error != ESP_ERR_INVALID_STATE) {
+    ESP_LOGE(TAG, "Installing PCNT interrupt service failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  error = pcnt_isr_handler_add(this->pcnt_unit_, PulseMeterSensor::pcnt_intr, this);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Adding PCNT interrupt handler failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  pcnt_event_enable(this->pcnt_unit_, PCNT_EVT_H_LIM);
+
+  pcnt_counter_pause(this->pcnt_unit_);
+  pcnt_counter_clear(this->pcnt_unit_);
+  pcnt_counter_resume(this->pcnt_unit_);
+  return true;
+}
+
+void PulseMeterSensor::set_pulses_per_interrupt_(uint16_t pulses) {
+  ESP_LOGV(TAG, "Interrupting every %u pulses", pulses);
+  InterruptLock lock;
+  pcnt_counter_pause(this->pcnt_unit_);
+  int16_t counted;
+  pcnt_get_counter_value(this->pcnt_unit_, &counted);
+  // Cleared first, so the counter can't be past the new limit
+  pcnt_counter_clear(this->pcnt_unit_);
+  pcnt_set_event_value(this->pcnt_unit_, PCNT_EVT_H_LIM, pulses);
+  pcnt_counter_resume(this->pcnt_unit_);
+
+  this->total_pulses_ += counted;
+  this->pulses_per_interrupt_ = pulses;
+  this->next_pulses_per_interrupt_ = 0;
+  // The pulse width stays, the next one is measured from the next interrupt
+  this->last_valid_edge_us_ = 0;
+}
+
+uint32_t PulseMeterSensor::read_total_pulses_() {
+  uint32_t total;
+  {
+    InterruptLock lock;
+    int16_t counted;
+    pcnt_get_counter_value(this->pcnt_unit_, &counted);
+    total = this->total_pulses_ + counted;
+  }
+  // When the counter just reset at its limit, the interrupt that adds those pulses may still be pending
+  if (static_cast<int32_t>(total - this->last_total_) < 0)
+    return this->last_total_;
+  this->last_total_ = total;
+  return total;
+}
+
+void IRAM_ATTR PulseMeterSensor::pcnt_intr(void *arg) {
+  auto *sensor = reinterpret_cast<PulseMeterSensor *>(arg);
+  const uint32_t now = micros();
+  const uint16_t pulses = sensor->pulses_per_interrupt_;
+
+  // The hardware filtered and counted the pulses, this is only called for every pulses_per_interrupt_ of them
+  if (sensor->last_valid_edge_us_ != 0) {
+    sensor->pulse_width_us_ = (now - sensor->last_valid_edge_us_) / pulses;
+  }
+  sensor->total_pulses_ += pulses;
+  sensor->last_valid_edge_us_ = now;
+
+  // The counter was just reset, so it can't be past a new limit yet
+  const uint16_t next = sensor->next_pulses_per_interrupt_;
+  if (next != 0) {
+    pcnt_set_event_value(sensor->pcnt_unit_, PCNT_EVT_H_LIM, next);
+    sensor->pulses_per_interrupt_ = next;
+    sensor->next_pulses_per_interrupt_ = 0;
+  }
+}
+#endif
+
 }  // namespace pulse_meter
 }  // namespace esphome
@@ -5,6 +5,11 @@
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/core/helpers.h"
 
+#if defined(USE_ESP32) && !defined(USE_ESP32_VARIANT_ESP32C3)
+#include <driver/pcnt.h>
+#define HAS_PCNT
+#endif
+
 namespace esphome {
 namespace pulse_meter {
 
@@ -25,6 +30,22 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
  protected:
   static void gpio_intr(PulseMeterSensor *sensor);
 
+#ifdef HAS_PCNT
+  bool setup_pcnt_();
+  /// Change how many pulses the PCNT unit counts before it interrupts right away, only while no pulses come in.
+  void set_pulses_per_interrupt_(uint16_t pulses);
+  uint32_t read_total_pulses_();
+  static void pcnt_intr(void *arg);
+
+  bool use_pcnt_{false};
+  pcnt_unit_t pcnt_unit_;
+  volatile uint16_t pulses_per_interrupt_{1};
+  /// Applied by the interrupt handler when the counter was just reset, 0 if nothing is pending.
+  volatile uint16_t next_pulses_per_interrupt_{0};
+  /// The total can't be read atomically with a pending interrupt, so it's kept from going back.
+  uint32_t last_total_{0};
+#endif
+
   InternalGPIOPin *pin_ = nullptr;
   ISRInternalGPIOPin isr_pin_;
   uint32_t filter_us_ = 0;
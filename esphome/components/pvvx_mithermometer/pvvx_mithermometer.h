@@ -21,6 +21,7 @@ class PVVXMiThermometer : public Component, public esp32_ble_tracker::ESPBTDevic
  public:
   void set_address(uint64_t address) { address_ = address; };
 
+  bool skips_duplicates() const override { return true; }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
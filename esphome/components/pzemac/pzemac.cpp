@@ -9,8 +9,8 @@ static const char *const TAG = "pzemac";
 static const uint8_t PZEM_CMD_READ_IN_REGISTERS = 0x04;
 static const uint8_t PZEM_REGISTER_COUNT = 10;  // 10x 16-bit registers
 
-void PZEMAC::on_modbus_data(const std::vector<uint8_t> &data) {
-  if (data.size() < 20) {
+void PZEMAC::on_modbus_frame(const uint8_t *data, size_t len) {
+  if (len < 20) {
     ESP_LOGW(TAG, "Invalid size for PZEM AC!");
     return;
   }
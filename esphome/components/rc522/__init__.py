@@ -8,6 +8,7 @@ CODEOWNERS = ["@glmnet"]
 AUTO_LOAD = ["binary_sensor"]
 
 CONF_RC522_ID = "rc522_id"
+CONF_IRQ_PIN = "irq_pin"
 
 rc522_ns = cg.esphome_ns.namespace("rc522")
 RC522 = rc522_ns.class_("RC522", cg.PollingComponent, i2c.I2CDevice)
@@ -19,6 +20,7 @@ RC522_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(RC522),
         cv.Optional(CONF_RESET_PIN): pins.gpio_output_pin_schema,
+        cv.Optional(CONF_IRQ_PIN): pins.gpio_input_pin_schema,
         cv.Optional(CONF_ON_TAG): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(RC522Trigger),
@@ -35,6 +37,10 @@ async def setup_rc522(var, config):
         reset = await cg.gpio_pin_expression(config[CONF_RESET_PIN])
         cg.add(var.set_reset_pin(reset))
 
+    if CONF_IRQ_PIN in config:
+        irq = await cg.gpio_pin_expression(config[CONF_IRQ_PIN])
+        cg.add(var.set_irq_pin(irq))
+
     for conf in config.get(CONF_ON_TAG, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID])
         cg.add(var.register_trigger(trigger))
@@ -58,6 +58,9 @@ void RC522::setup() {
     }
   }
 
+  if (this->irq_pin_ != nullptr)
+    this->irq_pin_->setup();
+
   // Setup a soft reset
   reset_count_ = RESET_COUNT;
   reset_timeout_ = millis();
@@ -92,6 +95,13 @@ void RC522::initialize_() {
   pcd_write_register(MODE_REG, 0x3D);  // Default 0x3F. Set the preset value for the CRC coprocessor for the CalcCRC
                                        // command to 0x6363 (ISO 14443-3 part 6.2.4)
 
+  if (this->irq_pin_ != nullptr) {
+    // IRqInv=1 (active low IRQ), RxIEn, IdleIEn and TimerIEn: everything await_transceive_() waits for
+    pcd_write_register(COM_I_EN_REG, 0x80 | WAIT_I_RQ | 0x01);
+    // IRQPushPull=1 and CRCIEn for await_crc_()
+    pcd_write_register(DIV_I_EN_REG, 0x80 | 0x04);
+  }
+
   state_ = STATE_INIT;
 }
 
@@ -106,6 +116,7 @@ void RC522::dump_config() {
   }
 
   LOG_PIN("  RESET Pin: ", this->reset_pin_);
+  LOG_PIN("  IRQ Pin: ", this->irq_pin_);
 
   LOG_UPDATE_INTERVAL(this);
 
@@ -376,6 +387,9 @@ void RC522::pcd_transceive_data_(uint8_t send_len) {
 RC522::StatusCode RC522::await_transceive_() {
   if (millis() - awaiting_comm_time_ < 2)  // wait at least 2 ms
     return STATUS_WAITING;
+  // the IRQ pin stays high until one of the interrupts is set, no need to read them before
+  if (this->irq_pin_ != nullptr && this->irq_pin_->digital_read() && millis() - awaiting_comm_time_ < 40)
+    return STATUS_WAITING;
   uint8_t n = pcd_read_register(
       COM_IRQ_REG);  // ComIrqReg[7..0] bits are: Set1 TxIRq RxIRq IdleIRq HiAlertIRq LoAlertIRq ErrIRq TimerIRq
   if (n & 0x01) {    // Timer interrupt - nothing received in 25ms
@@ -454,6 +468,8 @@ void RC522::pcd_calculate_crc_(uint8_t *data,  ///< In: Pointer to the data to t
 RC522::StatusCode RC522::await_crc_() {
   if (millis() - awaiting_comm_time_ < 2)  // wait at least 2 ms
     return STATUS_WAITING;
+  if (this->irq_pin_ != nullptr && this->irq_pin_->digital_read() && millis() - awaiting_comm_time_ < 89)
+    return STATUS_WAITING;
 
   // DivIrqReg[7..0] bits are: Set2 reserved reserved MfinActIRq reserved CRCIRq reserved reserved
   uint8_t n = pcd_read_register(DIV_IRQ_REG);
@@ -462,6 +478,8 @@ RC522::StatusCode RC522::await_crc_() {
     // Transfer the result from the registers to the result buffer
     buffer_[7] = pcd_read_register(CRC_RESULT_REG_L);
     buffer_[8] = pcd_read_register(CRC_RESULT_REG_H);
+    // Clear CRCIRq again, it would keep the IRQ pin active during the next transceive
+    pcd_write_register(DIV_IRQ_REG, 0x04);
 
     ESP_LOGVV(TAG, "pcd_calculate_crc_() STATUS_OK");
     return STATUS_OK;
@@ -25,6 +25,8 @@ class RC522 : public PollingComponent {
   void register_trigger(RC522Trigger *trig) { this->triggers_.push_back(trig); }
 
   void set_reset_pin(GPIOPin *reset) { this->reset_pin_ = reset; }
+  /// The IRQ pin (active low), with it the end of a command is noticed without polling the interrupt registers.
+  void set_irq_pin(GPIOPin *irq) { this->irq_pin_ = irq; }
 
  protected:
   // Return codes from the functions in this class. Remember to update GetStatusCodeName() if you add more.
@@ -237,6 +239,7 @@ class RC522 : public PollingComponent {
   uint8_t *valid_bits_;
 
   GPIOPin *reset_pin_{nullptr};
+  GPIOPin *irq_pin_{nullptr};
   uint8_t reset_count_{0};
   uint32_t reset_timeout_{0};
   std::vector<RC522BinarySensor *> binary_sensors_;
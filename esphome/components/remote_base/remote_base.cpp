@@ -24,6 +24,13 @@ void RemoteRMTChannel::config_rmt(rmt_config_t &rmt) {
 }
 #endif
 
+uint32_t RemoteReceiverBase::next_frame_() {
+  static uint32_t last_frame = 0;
+  if (++last_frame == 0)
+    last_frame = 1;
+  return last_frame;
+}
+
 void RemoteReceiverBinarySensorBase::dump_config() { LOG_BINARY_SENSOR("", "Remote Receiver Binary Sensor", this); }
 
 void RemoteTransmitterBase::send_(uint32_t send_times, uint32_t send_wait) {
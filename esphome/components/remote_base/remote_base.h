@@ -56,7 +56,8 @@ class RemoteTransmitData {
 
 class RemoteReceiveData {
  public:
-  RemoteReceiveData(std::vector<int32_t> *data, uint8_t tolerance) : data_(data), tolerance_(tolerance) {}
+  RemoteReceiveData(std::vector<int32_t> *data, uint8_t tolerance, uint32_t frame = 0)
+      : data_(data), tolerance_(tolerance), frame_(frame) {}
 
   bool peek_mark(uint32_t length, uint32_t offset = 0) {
     if (int32_t(this->index_ + offset) >= this->size())
@@ -126,6 +127,9 @@ class RemoteReceiveData {
 
   std::vector<int32_t> *get_raw_data() { return this->data_; }
 
+  /// Identifies the received frame, decode results are shared while it stays the same. 0 for unknown data.
+  uint32_t get_frame() const { return this->frame_; }
+
  protected:
   int32_t lower_bound_(uint32_t length) { return int32_t(100 - this->tolerance_) * length / 100U; }
   int32_t upper_bound_(uint32_t length) { return int32_t(100 + this->tolerance_) * length / 100U; }
@@ -133,6 +137,7 @@ class RemoteReceiveData {
   uint32_t index_{0};
   std::vector<int32_t> *data_;
   uint8_t tolerance_;
+  uint32_t frame_;
 };
 
 template<typename T> class RemoteProtocol {
@@ -144,6 +149,21 @@ template<typename T> class RemoteProtocol {
   virtual void dump(const T &data) = 0;
 };
 
+/** Decode a received frame with protocol T only once.
+ *
+ * All binary sensors, triggers and the dumper of a protocol get the same result for a frame, instead of each
+ * decoding it again. Decoders reject frames with a different leader in their first check.
+ */
+template<typename T, typename D> optional<D> decode_frame(RemoteReceiveData src) {
+  static uint32_t frame = 0;
+  static optional<D> result;
+  if (src.get_frame() == 0 || src.get_frame() != frame) {
+    result = T().decode(src);
+    frame = src.get_frame();
+  }
+  return result;
+}
+
 class RemoteComponentBase {
  public:
   explicit RemoteComponentBase(InternalGPIOPin *pin) : pin_(pin){};
@@ -236,7 +256,7 @@ class RemoteReceiverBase : public RemoteComponentBase {
   bool call_listeners_() {
     bool success = false;
     for (auto *listener : this->listeners_) {
-      auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+      auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->frame_);
       if (listener->on_receive(data))
         success = true;
     }
@@ -245,18 +265,19 @@ class RemoteReceiverBase : public RemoteComponentBase {
   void call_dumpers_() {
     bool success = false;
     for (auto *dumper : this->dumpers_) {
-      auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+      auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->frame_);
       if (dumper->dump(data))
         success = true;
     }
     if (!success) {
       for (auto *dumper : this->secondary_dumpers_) {
-        auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+        auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->frame_);
         dumper->dump(data);
       }
     }
   }
   void call_listeners_dumpers_() {
+    this->frame_ = next_frame_();
     if (this->call_listeners_())
       return;
     // If a listener handled, then do not dump
@@ -266,8 +287,12 @@ class RemoteReceiverBase : public RemoteComponentBase {
   std::vector<RemoteReceiverListener *> listeners_;
   std::vector<RemoteReceiverDumperBase *> dumpers_;
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
+  /// Unique for each frame of all receivers, never 0.
+  static uint32_t next_frame_();
+
   std::vector<int32_t> temp_;
   uint8_t tolerance_{25};
+  uint32_t frame_{0};
 };
 
 class RemoteReceiverBinarySensorBase : public binary_sensor::BinarySensorInitiallyOff,
@@ -294,8 +319,7 @@ template<typename T, typename D> class RemoteReceiverBinarySensor : public Remot
 
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = decode_frame<T, D>(src);
     return res.has_value() && *res == this->data_;
   }
 
@@ -309,8 +333,7 @@ template<typename T, typename D> class RemoteReceiverBinarySensor : public Remot
 template<typename T, typename D> class RemoteReceiverTrigger : public Trigger<D>, public RemoteReceiverListener {
  protected:
   bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = decode_frame<T, D>(src);
     if (res.has_value()) {
       this->trigger(*res);
       return true;
@@ -343,11 +366,10 @@ template<typename... Ts> class RemoteTransmitterActionBase : public Action<Ts...
 template<typename T, typename D> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
+    auto decoded = decode_frame<T, D>(src);
     if (!decoded.has_value())
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
 };
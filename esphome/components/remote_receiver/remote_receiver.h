@@ -56,8 +56,13 @@ class RemoteReceiverComponent : public remote_base::RemoteReceiverBase,
 #endif
 
 #ifdef USE_ESP8266
+  /// Decode the next signal in the buffer, true if there may be another one.
+  bool decode_signal_();
   RemoteReceiverComponentStore store_;
   HighFrequencyLoopRequester high_freq_;
+  /// How far the signal starting at scan_start_ was searched for its end.
+  uint32_t scan_start_{UINT32_MAX};
+  uint32_t scan_at_{0};
 #endif
 
   uint32_t buffer_size_{};
@@ -69,14 +69,16 @@ void RemoteReceiverComponent::dump_config() {
 }
 
 void RemoteReceiverComponent::loop() {
+  // Several signals can arrive between two loops (e.g. repeated 433 MHz codes), decode all of them
   size_t len = 0;
-  auto *item = (rmt_item32_t *) xRingbufferReceive(this->ringbuf_, &len, 0);
-  if (item != nullptr) {
+  rmt_item32_t *item;
+  while ((item = (rmt_item32_t *) xRingbufferReceive(this->ringbuf_, &len, 0)) != nullptr) {
     this->decode_rmt_(item, len);
+    // Hand the ring buffer space back to the RMT driver before the (slower) listeners run
     vRingbufferReturnItem(this->ringbuf_, item);
 
     if (this->temp_.empty())
-      return;
+      continue;
 
     this->temp_.push_back(-this->idle_us_);
     this->call_listeners_dumpers_();
@@ -104,46 +106,29 @@ void RemoteReceiverComponent::decode_rmt_(rmt_item32_t *item, size_t len) {
   }
   ESP_LOGVV(TAG, "\n");
 
-  this->temp_.reserve(item_count * 2);  // each RMT item has 2 pulses
-  for (size_t i = 0; i < item_count; i++) {
-    if (item[i].duration0 == 0u) {
-      // Do nothing
-    } else if (bool(item[i].level0) == prev_level) {
-      prev_length += item[i].duration0;
-    } else {
-      if (prev_length > 0) {
-        if (prev_level) {
-          this->temp_.push_back(this->to_microseconds_(prev_length) * multiplier);
-        } else {
-          this->temp_.push_back(-int32_t(this->to_microseconds_(prev_length)) * multiplier);
-        }
-      }
-      prev_level = bool(item[i].level0);
-      prev_length = item[i].duration0;
+  // each RMT item has 2 pulses, plus the idle space added by loop(). temp_ keeps its capacity between signals.
+  this->temp_.reserve(item_count * 2 + 1);
+  auto add_pulse = [this, multiplier, &prev_level, &prev_length](bool level, uint32_t duration) {
+    if (duration == 0u)
+      return;
+    if (level == prev_level) {
+      prev_length += duration;
+      return;
     }
-
-    if (item[i].duration1 == 0u) {
-      // Do nothing
-    } else if (bool(item[i].level1) == prev_level) {
-      prev_length += item[i].duration1;
-    } else {
-      if (prev_length > 0) {
-        if (prev_level) {
-          this->temp_.push_back(this->to_microseconds_(prev_length) * multiplier);
-        } else {
-          this->temp_.push_back(-int32_t(this->to_microseconds_(prev_length)) * multiplier);
-        }
-      }
-      prev_level = bool(item[i].level1);
-      prev_length = item[i].duration1;
+    if (prev_length > 0) {
+      const int32_t length = this->to_microseconds_(prev_length);
+      this->temp_.push_back((prev_level ? length : -length) * multiplier);
     }
+    prev_level = level;
+    prev_length = duration;
+  };
+  for (size_t i = 0; i < item_count; i++) {
+    add_pulse(item[i].level0, item[i].duration0);
+    add_pulse(item[i].level1, item[i].duration1);
   }
   if (prev_length > 0) {
-    if (prev_level) {
-      this->temp_.push_back(this->to_microseconds_(prev_length) * multiplier);
-    } else {
-      this->temp_.push_back(-int32_t(this->to_microseconds_(prev_length)) * multiplier);
-    }
+    const int32_t length = this->to_microseconds_(prev_length);
+    this->temp_.push_back((prev_level ? length : -length) * multiplier);
   }
 }
 
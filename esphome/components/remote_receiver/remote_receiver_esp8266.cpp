@@ -70,6 +70,12 @@ void RemoteReceiverComponent::dump_config() {
 }
 
 void RemoteReceiverComponent::loop() {
+  // Decode every complete signal, there may be more than one since the last loop
+  while (this->decode_signal_()) {
+  }
+}
+
+bool RemoteReceiverComponent::decode_signal_() {
   auto &s = this->store_;
 
   // copy write at to local variables, as it's volatile
@@ -77,42 +83,48 @@ void RemoteReceiverComponent::loop() {
   const uint32_t dist = (s.buffer_size + write_at - s.buffer_read_at) % s.buffer_size;
   // signals must at least one rising and one leading edge
   if (dist <= 1)
-    return;
-  const uint32_t now = micros();
-  if (now - s.buffer[write_at] < this->idle_us_)
-    // The last change was fewer than the configured idle time ago.
-    return;
-
-  ESP_LOGVV(TAG, "read_at=%u write_at=%u dist=%u now=%u end=%u", s.buffer_read_at, write_at, dist, now,
-            s.buffer[write_at]);
+    return false;
 
   // Skip first value, it's from the previous idle level
-  s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
-  uint32_t prev = s.buffer_read_at;
-  s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
-  const uint32_t reserve_size = 1 + (s.buffer_size + write_at - s.buffer_read_at) % s.buffer_size;
-  this->temp_.clear();
-  this->temp_.reserve(reserve_size);
-  int32_t multiplier = s.buffer_read_at % 2 == 0 ? 1 : -1;
-
-  for (uint32_t i = 0; prev != write_at; i++) {
-    int32_t delta = s.buffer[s.buffer_read_at] - s.buffer[prev];
-    if (uint32_t(delta) >= this->idle_us_) {
-      // already found a space longer than idle. There must have been two pulses
+  const uint32_t start = (s.buffer_read_at + 1) % s.buffer_size;
+  if (this->scan_start_ != start) {
+    this->scan_start_ = start;
+    this->scan_at_ = start;
+  }
+  // A signal ends at a space longer than idle. That can be found before the line is idle, so back-to-back
+  // signals are decoded while the next one comes in, instead of filling up the buffer.
+  bool complete = false;
+  while (this->scan_at_ != write_at) {
+    const uint32_t next = (this->scan_at_ + 1) % s.buffer_size;
+    if (s.buffer[next] - s.buffer[this->scan_at_] >= this->idle_us_) {
+      complete = true;
       break;
     }
+    this->scan_at_ = next;
+  }
+  const uint32_t end = this->scan_at_;
+  if (!complete && micros() - s.buffer[end] < this->idle_us_)
+    // The last change was fewer than the configured idle time ago.
+    return false;
+
+  ESP_LOGVV(TAG, "read_at=%u write_at=%u dist=%u end=%u", s.buffer_read_at, write_at, dist, end);
 
-    ESP_LOGVV(TAG, "  i=%u buffer[%u]=%u - buffer[%u]=%u -> %d", i, s.buffer_read_at, s.buffer[s.buffer_read_at], prev,
-              s.buffer[prev], multiplier * delta);
+  this->temp_.clear();
+  this->temp_.reserve(2 + (s.buffer_size + end - start) % s.buffer_size);
+  int32_t multiplier = (start + 1) % 2 == 0 ? 1 : -1;
+  for (uint32_t prev = start; prev != end;) {
+    const uint32_t at = (prev + 1) % s.buffer_size;
+    const int32_t delta = s.buffer[at] - s.buffer[prev];
+    ESP_LOGVV(TAG, "  buffer[%u]=%u - buffer[%u]=%u -> %d", at, s.buffer[at], prev, s.buffer[prev], multiplier * delta);
     this->temp_.push_back(multiplier * delta);
-    prev = s.buffer_read_at;
-    s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
+    prev = at;
     multiplier *= -1;
   }
-  s.buffer_read_at = (s.buffer_size + s.buffer_read_at - 1) % s.buffer_size;
   this->temp_.push_back(this->idle_us_ * multiplier);
+  s.buffer_read_at = end;
 
   this->call_listeners_dumpers_();
+  return complete;
 }
 
 }  // namespace remote_receiver
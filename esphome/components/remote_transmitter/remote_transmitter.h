@@ -39,10 +39,14 @@ class RemoteTransmitterComponent : public remote_base::RemoteTransmitterBase,
 
 #ifdef USE_ESP32
   void configure_rmt_();
+  /// Convert rmt_source_ into RMT items.
+  void encode_rmt_();
 
   uint32_t current_carrier_frequency_{UINT32_MAX};
   bool initialized_{false};
   std::vector<rmt_item32_t> rmt_temp_;
+  /// The transmit data rmt_temp_ was encoded from.
+  std::vector<int32_t> rmt_source_;
   esp_err_t error_code_{ESP_OK};
   bool inverted_{false};
 #endif
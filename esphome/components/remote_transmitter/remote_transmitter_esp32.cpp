@@ -71,15 +71,7 @@ void RemoteTransmitterComponent::configure_rmt_() {
   }
 }
 
-void RemoteTransmitterComponent::send_internal(uint32_t send_times, uint32_t send_wait) {
-  if (this->is_failed())
-    return;
-
-  if (this->current_carrier_frequency_ != this->temp_.get_carrier_frequency()) {
-    this->current_carrier_frequency_ = this->temp_.get_carrier_frequency();
-    this->configure_rmt_();
-  }
-
+void RemoteTransmitterComponent::encode_rmt_() {
   this->rmt_temp_.clear();
   this->rmt_temp_.reserve((this->temp_.get_data().size() + 1) / 2);
   uint32_t rmt_i = 0;
@@ -112,6 +104,22 @@ void RemoteTransmitterComponent::send_internal(uint32_t send_times, uint32_t sen
     rmt_item.duration1 = 0;
     this->rmt_temp_.push_back(rmt_item);
   }
+}
+
+void RemoteTransmitterComponent::send_internal(uint32_t send_times, uint32_t send_wait) {
+  if (this->is_failed())
+    return;
+
+  if (this->current_carrier_frequency_ != this->temp_.get_carrier_frequency()) {
+    this->current_carrier_frequency_ = this->temp_.get_carrier_frequency();
+    this->configure_rmt_();
+  }
+
+  // Repeated transmits of the same code (button presses, climate state) reuse the RMT items
+  if (this->temp_.get_data() != this->rmt_source_) {
+    this->rmt_source_ = this->temp_.get_data();
+    this->encode_rmt_();
+  }
 
   for (uint32_t i = 0; i < send_times; i++) {
     esp_err_t error = rmt_write_items(this->channel_, this->rmt_temp_.data(), this->rmt_temp_.size(), true);
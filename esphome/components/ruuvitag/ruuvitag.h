@@ -14,6 +14,7 @@ class RuuviTag : public Component, public esp32_ble_tracker::ESPBTDeviceListener
  public:
   void set_address(uint64_t address) { address_ = address; }
 
+  bool skips_duplicates() const override { return true; }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override {
     if (device.address_uint64() != this->address_)
       return false;
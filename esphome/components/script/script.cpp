@@ -1,18 +1,28 @@
 #include "script.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 
 namespace esphome {
 namespace script {
 
 static const char *const TAG = "script";
 
+void Script::start_run_() {
+  this->runs_started_++;
+  this->trigger();
+  // Runs that finished right away never overlapped with another one.
+  int running = std::max(this->automation_parent_ != nullptr ? this->automation_parent_->num_running() : 0, 1);
+  this->peak_runs_ = std::max(this->peak_runs_, running);
+}
+
 void SingleScript::execute() {
   if (this->is_action_running()) {
     ESP_LOGW(TAG, "Script '%s' is already running! (mode: single)", this->name_.c_str());
+    this->runs_rejected_++;
     return;
   }
 
-  this->trigger();
+  this->start_run_();
 }
 
 void RestartScript::execute() {
@@ -21,7 +31,7 @@ void RestartScript::execute() {
     this->stop_action();
   }
 
-  this->trigger();
+  this->start_run_();
 }
 
 void QueueingScript::execute() {
@@ -30,15 +40,18 @@ void QueueingScript::execute() {
     // num_runs_ + 1
     if (this->max_runs_ != 0 && this->num_runs_ + 1 >= this->max_runs_) {
       ESP_LOGW(TAG, "Script '%s' maximum number of queued runs exceeded!", this->name_.c_str());
+      this->runs_rejected_++;
       return;
     }
 
     ESP_LOGD(TAG, "Script '%s' queueing new instance (mode: queued)", this->name_.c_str());
     this->num_runs_++;
+    this->runs_queued_++;
+    this->enable_loop();
     return;
   }
 
-  this->trigger();
+  this->start_run_();
   // Check if the trigger was immediate and we can continue right away.
   this->loop();
 }
@@ -49,18 +62,24 @@ void QueueingScript::stop() {
 }
 
 void QueueingScript::loop() {
-  if (this->num_runs_ != 0 && !this->is_action_running()) {
+  if (this->num_runs_ == 0) {
+    // Nothing queued, only start watching again once something is.
+    this->disable_loop();
+    return;
+  }
+  if (!this->is_action_running()) {
     this->num_runs_--;
-    this->trigger();
+    this->start_run_();
   }
 }
 
 void ParallelScript::execute() {
   if (this->max_runs_ != 0 && this->automation_parent_->num_running() >= this->max_runs_) {
     ESP_LOGW(TAG, "Script '%s' maximum number of parallel runs exceeded!", this->name_.c_str());
+    this->runs_rejected_++;
     return;
   }
-  this->trigger();
+  this->start_run_();
 }
 
 }  // namespace script
@@ -22,8 +22,24 @@ class Script : public Trigger<> {
   // Internal function to give scripts readable names.
   void set_name(const std::string &name) { name_ = name; }
 
+  /// Number of instances that were started, including queued ones once they start.
+  uint32_t get_runs_started() const { return this->runs_started_; }
+  /// Number of instances that had to wait in the queue (mode: queued).
+  uint32_t get_runs_queued() const { return this->runs_queued_; }
+  /// Number of instances that were discarded because the script was busy or max_runs was reached.
+  uint32_t get_runs_rejected() const { return this->runs_rejected_; }
+  /// Highest number of instances that were running at the same time.
+  int get_peak_runs() const { return this->peak_runs_; }
+
  protected:
+  /// Start a new instance and update the statistics.
+  void start_run_();
+
   std::string name_;
+  uint32_t runs_started_{0};
+  uint32_t runs_queued_{0};
+  uint32_t runs_rejected_{0};
+  int peak_runs_{0};
 };
 
 /** A script type for which only a single instance at a time is allowed.
@@ -118,12 +134,16 @@ template<typename... Ts> class ScriptWaitAction : public Action<Ts...>, public C
       return;
     }
     this->var_ = std::make_tuple(x...);
+    // Only poll the script while something is waiting on it.
+    this->enable_loop();
     this->loop();
   }
 
   void loop() override {
-    if (this->num_running_ == 0)
+    if (this->num_running_ == 0) {
+      this->disable_loop();
       return;
+    }
 
     if (this->script_->is_running())
       return;
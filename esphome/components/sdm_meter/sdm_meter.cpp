@@ -1,6 +1,7 @@
 #include "sdm_meter.h"
 #include "sdm_meter_registers.h"
 #include "esphome/core/log.h"
+#include "esphome/core/controller.h"
 
 namespace esphome {
 namespace sdm_meter {
@@ -10,11 +11,12 @@ static const char *const TAG = "sdm_meter";
 static const uint8_t MODBUS_CMD_READ_IN_REGISTERS = 0x04;
 static const uint8_t MODBUS_REGISTER_COUNT = 80;  // 74 x 16-bit registers
 
-void SDMMeter::on_modbus_data(const std::vector<uint8_t> &data) {
-  if (data.size() < MODBUS_REGISTER_COUNT * 2) {
+void SDMMeter::on_modbus_frame(const uint8_t *data, size_t len) {
+  if (len < MODBUS_REGISTER_COUNT * 2) {
     ESP_LOGW(TAG, "Invalid size for SDMMeter!");
     return;
   }
+  StateBatch batch;
 
   auto sdm_meter_get_float = [&](size_t i) -> float {
     uint32_t temp = encode_uint32(data[i], data[i + 1], data[i + 2], data[i + 3]);
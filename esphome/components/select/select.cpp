@@ -28,12 +28,16 @@ void SelectCall::perform() {
 
 void Select::publish_state(const std::string &state) {
   this->has_state_ = true;
-  this->state = state;
+  {
+    // display update tasks may read the state
+    UpdateTaskGuard guard;
+    this->state = state;
+  }
   ESP_LOGD(TAG, "'%s': Sending state %s", this->get_name().c_str(), state.c_str());
   this->state_callback_.call(state);
 }
 
-void Select::add_on_state_callback(std::function<void(std::string)> &&callback) {
+void Select::add_on_state_callback(std::function<void(const std::string &)> &&callback) {
   this->state_callback_.add(std::move(callback));
 }
 
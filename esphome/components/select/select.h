@@ -57,7 +57,7 @@ class Select : public EntityBase {
   SelectCall make_call() { return SelectCall(this); }
   void set(const std::string &value) { make_call().set_option(value).perform(); }
 
-  void add_on_state_callback(std::function<void(std::string)> &&callback);
+  void add_on_state_callback(std::function<void(const std::string &)> &&callback);
 
   SelectTraits traits;
 
@@ -77,7 +77,7 @@ class Select : public EntityBase {
 
   uint32_t hash_base() override;
 
-  CallbackManager<void(std::string)> state_callback_;
+  CallbackManager<void(const std::string &)> state_callback_;
   bool has_state_{false};
 };
 
@@ -181,6 +181,9 @@ validate_accuracy_decimals = cv.int_
 validate_icon = cv.icon
 validate_device_class = cv.one_of(*DEVICE_CLASSES, lower=True, space="_")
 
+CONF_HISTORY_SIZE = "history_size"
+CONF_JSON_STATE = "json_state"
+
 SENSOR_SCHEMA = cv.ENTITY_BASE_SCHEMA.extend(cv.MQTT_COMPONENT_SCHEMA).extend(
     {
         cv.OnlyWith(CONF_MQTT_ID, "mqtt"): cv.declare_id(mqtt.MQTTSensorComponent),
@@ -197,7 +200,9 @@ SENSOR_SCHEMA = cv.ENTITY_BASE_SCHEMA.extend(cv.MQTT_COMPONENT_SCHEMA).extend(
             cv.requires_component("mqtt"),
             cv.Any(None, cv.positive_time_period_milliseconds),
         ),
+        cv.Optional(CONF_JSON_STATE): cv.All(cv.requires_component("mqtt"), cv.boolean),
         cv.Optional(CONF_FILTERS): validate_filters,
+        cv.Optional(CONF_HISTORY_SIZE): cv.int_range(min=1, max=4096),
         cv.Optional(CONF_ON_VALUE): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(SensorStateTrigger),
@@ -551,6 +556,8 @@ async def setup_sensor_core_(var, config):
     if config.get(CONF_FILTERS):  # must exist and not be empty
         filters = await build_filters(config[CONF_FILTERS])
         cg.add(var.set_filters(filters))
+    if CONF_HISTORY_SIZE in config:
+        cg.add(var.set_history_size(config[CONF_HISTORY_SIZE]))
 
     for conf in config.get(CONF_ON_VALUE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
@@ -578,6 +585,8 @@ async def setup_sensor_core_(var, config):
                 cg.add(mqtt_.disable_expire_after())
             else:
                 cg.add(mqtt_.set_expire_after(config[CONF_EXPIRE_AFTER]))
+        if CONF_JSON_STATE in config:
+            cg.add(mqtt_.set_json_state(config[CONF_JSON_STATE]))
 
 
 async def register_sensor(var, config):
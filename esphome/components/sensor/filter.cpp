@@ -2,6 +2,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "sensor.h"
+#include <algorithm>
 #include <cmath>
 
 namespace esphome {
@@ -9,6 +10,24 @@ namespace sensor {
 
 static const char *const TAG = "sensor.filter";
 
+// SortedFilterWindow
+void SortedFilterWindow::set_capacity(size_t capacity) {
+  this->window_.set_capacity(capacity);
+  this->sorted_.clear();
+  this->sorted_.shrink_to_fit();
+  this->sorted_.reserve(capacity);
+}
+void SortedFilterWindow::push(float value) {
+  if (this->window_.capacity() == 0)
+    return;
+  if (this->window_.full()) {
+    auto oldest = std::lower_bound(this->sorted_.begin(), this->sorted_.end(), this->window_[0]);
+    this->sorted_.erase(oldest);
+  }
+  this->window_.push(value);
+  this->sorted_.insert(std::upper_bound(this->sorted_.begin(), this->sorted_.end(), value), value);
+}
+
 // Filter
 void Filter::input(float value) {
   ESP_LOGVV(TAG, "Filter(%p)::input(%f)", this, value);
@@ -16,6 +35,27 @@ void Filter::input(float value) {
   if (out.has_value())
     this->output(*out);
 }
+size_t Filter::new_values(float *values, size_t count) {
+  size_t out = 0;
+  for (size_t i = 0; i < count; i++) {
+    optional<float> value = this->new_value(values[i]);
+    if (value.has_value())
+      values[out++] = *value;
+  }
+  return out;
+}
+void Filter::input_values(float *values, size_t count) {
+  ESP_LOGVV(TAG, "Filter(%p)::input_values(%u values)", this, (unsigned) count);
+  count = this->new_values(values, count);
+  if (count == 0)
+    return;
+  if (this->next_ == nullptr) {
+    for (size_t i = 0; i < count; i++)
+      this->parent_->internal_send_state_to_frontend(values[i]);
+  } else {
+    this->next_->input_values(values, count);
+  }
+}
 void Filter::output(float value) {
   if (this->next_ == nullptr) {
     ESP_LOGVV(TAG, "Filter(%p)::output(%f) -> SENSOR", this, value);
@@ -33,15 +73,12 @@ void Filter::initialize(Sensor *parent, Filter *next) {
 
 // MedianFilter
 MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MedianFilter::set_window_size(size_t window_size) { this->window_.set_capacity(window_size); }
 optional<float> MedianFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -49,15 +86,12 @@ optional<float> MedianFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float median = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float> median_queue = this->queue_;
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
+    if (!this->window_.empty()) {
+      size_t queue_size = this->window_.size();
       if (queue_size % 2) {
-        median = median_queue[queue_size / 2];
+        median = this->window_[queue_size / 2];
       } else {
-        median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
+        median = (this->window_[queue_size / 2] + this->window_[(queue_size / 2) - 1]) / 2.0f;
       }
     }
 
@@ -69,16 +103,13 @@ optional<float> MedianFilter::new_value(float value) {
 
 // QuantileFilter
 QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at), quantile_(quantile) {}
 void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void QuantileFilter::set_window_size(size_t window_size) { this->window_.set_capacity(window_size); }
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
 optional<float> QuantileFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
   }
 
@@ -86,14 +117,11 @@ optional<float> QuantileFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float result = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float> quantile_queue = this->queue_;
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
+    if (!this->window_.empty()) {
+      size_t queue_size = this->window_.size();
       size_t position = ceilf(queue_size * this->quantile_) - 1;
       ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position, queue_size);
-      result = quantile_queue[position];
+      result = this->window_[position];
     }
 
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING", this, result);
@@ -104,15 +132,12 @@ optional<float> QuantileFilter::new_value(float value) {
 
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MinFilter::set_window_size(size_t window_size) { this->window_.set_capacity(window_size); }
 optional<float> MinFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -120,9 +145,8 @@ optional<float> MinFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float min = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float>::iterator it = std::min_element(queue_.begin(), queue_.end());
-      min = *it;
+    if (!this->window_.empty()) {
+      min = this->window_.result();
     }
 
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING", this, min);
@@ -133,15 +157,12 @@ optional<float> MinFilter::new_value(float value) {
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MaxFilter::set_window_size(size_t window_size) { this->window_.set_capacity(window_size); }
 optional<float> MaxFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -149,9 +170,8 @@ optional<float> MaxFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float max = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float>::iterator it = std::max_element(queue_.begin(), queue_.end());
-      max = *it;
+    if (!this->window_.empty()) {
+      max = this->window_.result();
     }
 
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING", this, max);
@@ -163,32 +183,34 @@ optional<float> MaxFilter::new_value(float value) {
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) {
+  // set_capacity() clears the window, so the sum starts over too
+  this->window_.set_capacity(window_size);
+  this->sum_ = 0.0f;
+}
 optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
   if (!std::isnan(value)) {
-    if (this->queue_.size() == this->window_size_) {
-      this->sum_ -= this->queue_[0];
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    if (this->window_.full())
+      this->sum_ -= this->window_[0];
+    this->window_.push(value);
     this->sum_ += value;
   }
   float average;
-  if (this->queue_.empty())
+  if (this->window_.empty())
     average = 0.0f;
   else
-    average = this->sum_ / this->queue_.size();
+    average = this->sum_ / this->window_.size();
   ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f) -> %f", this, value, average);
 
   if (++this->send_at_ % this->send_every_ == 0) {
     if (this->send_at_ >= 10000) {
       // Recalculate to prevent floating point error accumulating
       this->sum_ = 0;
-      for (auto v : this->queue_)
-        this->sum_ += v;
-      average = this->sum_ / this->queue_.size();
+      for (size_t i = 0; i < this->window_.size(); i++)
+        this->sum_ += this->window_[i];
+      average = this->sum_ / this->window_.size();
       this->send_at_ = 0;
     }
 
@@ -263,11 +285,21 @@ optional<float> LambdaFilter::new_value(float value) {
 OffsetFilter::OffsetFilter(float offset) : offset_(offset) {}
 
 optional<float> OffsetFilter::new_value(float value) { return value + this->offset_; }
+size_t OffsetFilter::new_values(float *values, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    values[i] += this->offset_;
+  return count;
+}
 
 // MultiplyFilter
 MultiplyFilter::MultiplyFilter(float multiplier) : multiplier_(multiplier) {}
 
 optional<float> MultiplyFilter::new_value(float value) { return value * this->multiplier_; }
+size_t MultiplyFilter::new_values(float *values, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    values[i] *= this->multiplier_;
+  return count;
+}
 
 // FilterOutValueFilter
 FilterOutValueFilter::FilterOutValueFilter(float value_to_filter_out) : value_to_filter_out_(value_to_filter_out) {}
@@ -372,6 +404,11 @@ void HeartbeatFilter::setup() {
 float HeartbeatFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
 
 optional<float> CalibrateLinearFilter::new_value(float value) { return value * this->slope_ + this->bias_; }
+size_t CalibrateLinearFilter::new_values(float *values, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    values[i] = values[i] * this->slope_ + this->bias_;
+  return count;
+}
 CalibrateLinearFilter::CalibrateLinearFilter(float slope, float bias) : slope_(slope), bias_(bias) {}
 
 optional<float> CalibratePolynomialFilter::new_value(float value) {
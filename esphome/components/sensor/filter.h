@@ -2,8 +2,10 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
-#include <queue>
+#include <functional>
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace esphome {
 namespace sensor {
@@ -28,10 +30,23 @@ class Filter {
    */
   virtual optional<float> new_value(float value) = 0;
 
+  /** Process a block of values at once, used by Sensor::publish_states().
+   *
+   * The values are filtered in place: the values that should be passed down the chain are written to the start of
+   * the array. Filters produce at most one value per input here. The default implementation calls new_value() for
+   * every value, simple filters override it with a plain loop.
+   *
+   * @param values The new values, overwritten with the output.
+   * @param count The number of new values.
+   * @return The number of values to pass down the chain.
+   */
+  virtual size_t new_values(float *values, size_t count);
+
   /// Initialize this filter, please note this can be called more than once.
   virtual void initialize(Sensor *parent, Filter *next);
 
   void input(float value);
+  void input_values(float *values, size_t count);
 
   void output(float value);
 
@@ -42,6 +57,122 @@ class Filter {
   Sensor *parent_{nullptr};
 };
 
+/** Fixed-capacity ring buffer holding the last values of a windowed filter.
+ *
+ * The storage is allocated once with the window size instead of growing and shrinking like a std::deque.
+ */
+class FilterWindow {
+ public:
+  explicit FilterWindow(size_t capacity) { this->set_capacity(capacity); }
+
+  /// Change the number of values in the window, this clears the current values.
+  void set_capacity(size_t capacity) {
+    this->values_ = std::unique_ptr<float[]>(new float[capacity]);  // NOLINT
+    this->capacity_ = capacity;
+    this->start_ = 0;
+    this->size_ = 0;
+  }
+  size_t capacity() const { return this->capacity_; }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+  bool full() const { return this->size_ == this->capacity_; }
+
+  /// Append a value, when the window is full the oldest value is dropped.
+  void push(float value) {
+    if (this->capacity_ == 0)
+      return;
+    if (this->full()) {
+      this->values_[this->start_] = value;
+      this->start_ = (this->start_ + 1) % this->capacity_;
+    } else {
+      this->values_[(this->start_ + this->size_) % this->capacity_] = value;
+      this->size_++;
+    }
+  }
+  /// The i-th value in the window, 0 is the oldest.
+  float operator[](size_t i) const { return this->values_[(this->start_ + i) % this->capacity_]; }
+
+ protected:
+  std::unique_ptr<float[]> values_;
+  size_t capacity_{0};
+  size_t start_{0};
+  size_t size_{0};
+};
+
+/** A FilterWindow that additionally keeps its values sorted, for median and quantile lookups without sorting.
+ *
+ * Each new value costs a binary search and a move of the values above it, which is cheap for typical window sizes.
+ */
+class SortedFilterWindow {
+ public:
+  explicit SortedFilterWindow(size_t capacity) : window_(capacity) { this->sorted_.reserve(capacity); }
+
+  /// Change the number of values in the window, this clears the current values.
+  void set_capacity(size_t capacity);
+  size_t size() const { return this->sorted_.size(); }
+  bool empty() const { return this->sorted_.empty(); }
+
+  /// Append a value, when the window is full the oldest value is dropped.
+  void push(float value);
+  /// The i-th smallest value in the window.
+  float operator[](size_t i) const { return this->sorted_[i]; }
+
+ protected:
+  FilterWindow window_;
+  std::vector<float> sorted_;
+};
+
+/** Running minimum (Compare = std::less) or maximum (std::greater) of the last values.
+ *
+ * Uses a monotonic queue: values that can never be the result again are dropped as soon as a better value arrives,
+ * so every value is added and removed once (amortized O(1)) and the result is always at the front.
+ */
+template<typename Compare> class MonotonicFilterWindow {
+ public:
+  explicit MonotonicFilterWindow(size_t capacity) { this->set_capacity(capacity); }
+
+  /// Change the number of values in the window, this clears the current values.
+  void set_capacity(size_t capacity) {
+    this->entries_ = std::unique_ptr<Entry[]>(new Entry[capacity]);  // NOLINT
+    this->capacity_ = capacity;
+    this->start_ = 0;
+    this->size_ = 0;
+  }
+  bool empty() const { return this->size_ == 0; }
+
+  /// Append a value, when the window is full the oldest value is dropped.
+  void push(float value) {
+    if (this->capacity_ == 0)
+      return;
+    // at most one entry leaves the window per value
+    if (this->size_ > 0 && this->count_ - this->entries_[this->start_].index >= this->capacity_) {
+      this->start_ = (this->start_ + 1) % this->capacity_;
+      this->size_--;
+    }
+    Compare compare;
+    while (this->size_ > 0 && !compare(this->back_().value, value))
+      this->size_--;
+    this->entries_[(this->start_ + this->size_) % this->capacity_] = Entry{value, this->count_++};
+    this->size_++;
+  }
+  /// The minimum/maximum of the window, must not be empty.
+  float result() const { return this->entries_[this->start_].value; }
+
+ protected:
+  struct Entry {
+    float value;
+    size_t index;
+  };
+  const Entry &back_() const { return this->entries_[(this->start_ + this->size_ - 1) % this->capacity_]; }
+
+  std::unique_ptr<Entry[]> entries_;
+  size_t capacity_{0};
+  size_t start_{0};
+  size_t size_{0};
+  /// Number of values pushed so far, used to tell when an entry leaves the window.
+  size_t count_{0};
+};
+
 /** Simple quantile filter.
  *
  * Takes the quantile of the last <send_every> values and pushes it out every <send_every>.
@@ -66,10 +197,9 @@ class QuantileFilter : public Filter {
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  SortedFilterWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
   float quantile_;
 };
 
@@ -95,10 +225,9 @@ class MedianFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SortedFilterWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple min filter.
@@ -123,10 +252,9 @@ class MinFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  MonotonicFilterWindow<std::less<float>> window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple max filter.
@@ -151,10 +279,9 @@ class MaxFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  MonotonicFilterWindow<std::greater<float>> window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
@@ -181,10 +308,9 @@ class SlidingWindowMovingAverageFilter : public Filter {
 
  protected:
   float sum_{0.0};
-  std::deque<float> queue_;
+  FilterWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple exponential moving average filter.
@@ -257,6 +383,7 @@ class OffsetFilter : public Filter {
   explicit OffsetFilter(float offset);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float offset_;
@@ -268,6 +395,7 @@ class MultiplyFilter : public Filter {
   explicit MultiplyFilter(float multiplier);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float multiplier_;
@@ -360,6 +488,7 @@ class CalibrateLinearFilter : public Filter {
  public:
   CalibrateLinearFilter(float slope, float bias);
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float slope_;
@@ -0,0 +1,48 @@
+#include "integrator.h"
+#include <cmath>
+
+namespace esphome {
+namespace sensor {
+
+static const uint32_t INTEGRATOR_RESTORE_VERSION = 0x5B3C91E7UL;
+
+void Integrator::add(float value, uint32_t now) {
+  // Unknown values are skipped, the next known one is integrated over the whole gap.
+  if (!std::isfinite(value))
+    return;
+  const double dt = now - this->last_time_;
+  double area = 0.0;
+  switch (this->method_) {
+    case INTEGRATOR_METHOD_TRAPEZOID:
+      area = dt * (static_cast<double>(this->last_value_) + value) / 2.0;
+      break;
+    case INTEGRATOR_METHOD_LEFT:
+      area = dt * this->last_value_;
+      break;
+    case INTEGRATOR_METHOD_RIGHT:
+      area = dt * value;
+      break;
+  }
+  this->total_ += std::llround(area * SCALE);
+  this->last_value_ = value;
+  this->last_time_ = now;
+}
+
+void Integrator::set_total(double total, double factor) {
+  if (std::isfinite(total))
+    this->total_ = std::llround(total / factor * SCALE);
+}
+
+void Integrator::load(uint32_t key, double factor) {
+  this->pref_ = global_preferences->make_preference<int64_t>(key ^ INTEGRATOR_RESTORE_VERSION);
+  if (this->pref_.load(&this->total_))
+    return;
+  this->total_ = 0;
+  float legacy = 0.0f;
+  auto legacy_pref = global_preferences->make_preference<float>(key);
+  if (legacy_pref.load(&legacy))
+    this->set_total(legacy, factor);
+}
+
+}  // namespace sensor
+}  // namespace esphome
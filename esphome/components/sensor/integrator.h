@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include "esphome/core/preferences.h"
+
+namespace esphome {
+namespace sensor {
+
+enum IntegratorMethod {
+  INTEGRATOR_METHOD_TRAPEZOID = 0,
+  INTEGRATOR_METHOD_LEFT,
+  INTEGRATOR_METHOD_RIGHT,
+};
+
+/** Accumulates the area under the values of a sensor, for integration and energy totals.
+ *
+ * The total is a 64-bit fixed-point count of value milliseconds. Adding a small area to a large total is exact, so
+ * unlike a float sum it doesn't stop growing (or drift) after a long time, it only becomes a float when published.
+ */
+class Integrator {
+ public:
+  /// Fixed-point steps per value millisecond.
+  static const int64_t SCALE = 1000;
+
+  void set_method(IntegratorMethod method) { this->method_ = method; }
+
+  /// Start timing at now (in ms), the next value is integrated from there.
+  void start(uint32_t now) { this->last_time_ = now; }
+  /// Add the area since the previous value, with value and now taken when the sensor published it.
+  void add(float value, uint32_t now);
+  void reset() { this->total_ = 0; }
+  /// Replace the total with a value in value milliseconds multiplied by factor, as returned by get_total().
+  void set_total(double total, double factor);
+
+  /// The total in value milliseconds multiplied by factor, e.g. 1 / 3600000 for value hours.
+  double get_total(double factor) const { return static_cast<double>(this->total_) * (factor / SCALE); }
+
+  /** Load a total saved with save() from the preference with the given key.
+   *
+   * Totals that were saved as float value units (time factor applied) by earlier versions are converted.
+   */
+  void load(uint32_t key, double factor);
+  void save() { this->pref_.save(&this->total_); }
+
+ protected:
+  IntegratorMethod method_{INTEGRATOR_METHOD_TRAPEZOID};
+  int64_t total_{0};
+  uint32_t last_time_{0};
+  float last_value_{0.0f};
+  ESPPreferenceObject pref_;
+};
+
+}  // namespace sensor
+}  // namespace esphome
@@ -1,4 +1,5 @@
 #include "sensor.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -22,11 +23,11 @@ Sensor::Sensor(const std::string &name) : EntityBase(name), state(NAN), raw_stat
 Sensor::Sensor() : Sensor("") {}
 
 std::string Sensor::get_unit_of_measurement() {
-  if (this->unit_of_measurement_.has_value())
-    return *this->unit_of_measurement_;
+  if (this->unit_of_measurement_ != nullptr)
+    return this->unit_of_measurement_;
   return this->unit_of_measurement();
 }
-void Sensor::set_unit_of_measurement(const std::string &unit_of_measurement) {
+void Sensor::set_unit_of_measurement(const char *unit_of_measurement) {
   this->unit_of_measurement_ = unit_of_measurement;
 }
 std::string Sensor::unit_of_measurement() { return ""; }
@@ -40,11 +41,11 @@ void Sensor::set_accuracy_decimals(int8_t accuracy_decimals) { this->accuracy_de
 int8_t Sensor::accuracy_decimals() { return 0; }
 
 std::string Sensor::get_device_class() {
-  if (this->device_class_.has_value())
-    return *this->device_class_;
+  if (this->device_class_ != nullptr)
+    return this->device_class_;
   return this->device_class();
 }
-void Sensor::set_device_class(const std::string &device_class) { this->device_class_ = device_class; }
+void Sensor::set_device_class(const char *device_class) { this->device_class_ = device_class; }
 std::string Sensor::device_class() { return ""; }
 
 void Sensor::set_state_class(StateClass state_class) { this->state_class_ = state_class; }
@@ -55,8 +56,10 @@ StateClass Sensor::get_state_class() {
 }
 StateClass Sensor::state_class() { return StateClass::STATE_CLASS_NONE; }
 
-void Sensor::publish_state(float state) {
+void Sensor::publish_state(float state) { this->publish_state(state, millis()); }
+void Sensor::publish_state(float state, uint32_t timestamp) {
   this->raw_state = state;
+  this->raw_time_ = timestamp;
   this->raw_callback_.call(state);
 
   ESP_LOGV(TAG, "'%s': Received new state %f", this->name_.c_str(), state);
@@ -68,6 +71,26 @@ void Sensor::publish_state(float state) {
   }
 }
 
+void Sensor::publish_states(float *values, size_t count) {
+  if (count == 0)
+    return;
+  // like publish_state(), raw_state is the value the raw callback is called with
+  this->raw_time_ = millis();
+  for (size_t i = 0; i < count; i++) {
+    this->raw_state = values[i];
+    this->raw_callback_.call(values[i]);
+  }
+
+  ESP_LOGV(TAG, "'%s': Received %u new states", this->name_.c_str(), (unsigned) count);
+
+  if (this->filter_list_ == nullptr) {
+    for (size_t i = 0; i < count; i++)
+      this->internal_send_state_to_frontend(values[i]);
+  } else {
+    this->filter_list_->input_values(values, count);
+  }
+}
+
 void Sensor::add_on_state_callback(std::function<void(float)> &&callback) { this->callback_.add(std::move(callback)); }
 void Sensor::add_on_raw_state_callback(std::function<void(float)> &&callback) {
   this->raw_callback_.add(std::move(callback));
@@ -109,6 +132,9 @@ std::string Sensor::unique_id() { return ""; }
 void Sensor::internal_send_state_to_frontend(float state) {
   this->has_state_ = true;
   this->state = state;
+  this->state_time_ = this->raw_time_;
+  if (this->history_ != nullptr)
+    this->history_->add(this->state_time_, state);
   ESP_LOGD(TAG, "'%s': Sending state %.5f %s with %d decimals of accuracy", this->get_name().c_str(), state,
            this->get_unit_of_measurement().c_str(), this->get_accuracy_decimals());
   this->callback_.call(state);
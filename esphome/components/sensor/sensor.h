@@ -40,6 +40,41 @@ enum StateClass : uint8_t {
 
 std::string state_class_to_string(StateClass state_class);
 
+/// Ring of the last filtered states of a sensor and when they were published, fetched by API clients after a reconnect.
+class SensorHistory {
+ public:
+  explicit SensorHistory(size_t capacity) : entries_(new Entry[capacity]), capacity_(capacity) {}
+
+  void add(uint32_t time, float state) {
+    if (this->capacity_ == 0)
+      return;
+    this->entries_[(this->start_ + this->size_) % this->capacity_] = Entry{time, state};
+    this->added_++;
+    if (this->size_ < this->capacity_) {
+      this->size_++;
+    } else {
+      this->start_ = (this->start_ + 1) % this->capacity_;
+    }
+  }
+  size_t size() const { return this->size_; }
+  /// Number of states added since boot, the oldest stored state is number get_added() - size().
+  uint32_t get_added() const { return this->added_; }
+  /// Time (millis()) of the i-th stored state, 0 is the oldest.
+  uint32_t get_time(size_t i) const { return this->entries_[(this->start_ + i) % this->capacity_].time; }
+  float get_state(size_t i) const { return this->entries_[(this->start_ + i) % this->capacity_].state; }
+
+ protected:
+  struct Entry {
+    uint32_t time;
+    float state;
+  };
+  std::unique_ptr<Entry[]> entries_;
+  size_t capacity_;
+  size_t start_{0};
+  size_t size_{0};
+  uint32_t added_{0};
+};
+
 /** Base-class for all sensors.
  *
  * A sensor has unit of measurement and can use publish_state to send out a new value with the specified accuracy.
@@ -51,8 +86,8 @@ class Sensor : public EntityBase {
 
   /// Get the unit of measurement, using the manual override if set.
   std::string get_unit_of_measurement();
-  /// Manually set the unit of measurement.
-  void set_unit_of_measurement(const std::string &unit_of_measurement);
+  /// Manually set the unit of measurement, the string is referenced, not copied.
+  void set_unit_of_measurement(const char *unit_of_measurement);
 
   /// Get the accuracy in decimals, using the manual override if set.
   int8_t get_accuracy_decimals();
@@ -61,8 +96,8 @@ class Sensor : public EntityBase {
 
   /// Get the device class, using the manual override if set.
   std::string get_device_class();
-  /// Manually set the device class.
-  void set_device_class(const std::string &device_class);
+  /// Manually set the device class, the string is referenced, not copied.
+  void set_device_class(const char *device_class);
 
   /// Get the state class, using the manual override if set.
   StateClass get_state_class();
@@ -115,6 +150,24 @@ class Sensor : public EntityBase {
    */
   void publish_state(float state);
 
+  /** Publish a new state that was measured earlier, like publish_state(float).
+   *
+   * The time is passed on to the frontends, so a state that was buffered or measured during deep sleep keeps its
+   * time.
+   *
+   * @param state The state as a floating point number.
+   * @param timestamp When the state was measured (millis()).
+   */
+  void publish_state(float state, uint32_t timestamp);
+
+  /** Publish a block of raw values at once, for sensors that sample much faster than they publish.
+   *
+   * Like calling publish_state() for every value, but the values pass through each filter with a single call. The
+   * raw state callbacks are called for all values before filtering. The values array is used as scratch space for
+   * the filters and overwritten.
+   */
+  void publish_states(float *values, size_t count);
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Add a callback that will be called every time a filtered value arrives.
@@ -140,6 +193,9 @@ class Sensor : public EntityBase {
   /// Return whether this sensor has gotten a full state (that passed through all filters) yet.
   bool has_state() const;
 
+  /// When (millis()) the current state was measured. Filters that combine several values pass on the latest time.
+  uint32_t get_state_time() const { return this->state_time_; }
+
   /** A unique ID for this sensor, empty for no unique id. See unique ID requirements:
    * https://developers.home-assistant.io/docs/en/entity_registry_index.html#unique-id-requirements
    *
@@ -149,6 +205,11 @@ class Sensor : public EntityBase {
 
   void internal_send_state_to_frontend(float state);
 
+  /// Keep the last size filtered states, so they can be fetched later (for example after the API reconnects).
+  void set_history_size(size_t size) { this->history_ = make_unique<SensorHistory>(size); }
+  /// The stored states, nullptr if no history is kept for this sensor.
+  SensorHistory *get_history() const { return this->history_.get(); }
+
  protected:
   /// Override this to set the default unit of measurement.
   virtual std::string unit_of_measurement();  // NOLINT
@@ -168,11 +229,14 @@ class Sensor : public EntityBase {
   CallbackManager<void(float)> callback_;      ///< Storage for filtered state callbacks.
 
   bool has_state_{false};
-  Filter *filter_list_{nullptr};  ///< Store all active filters.
+  uint32_t raw_time_{0};                    ///< When raw_state was measured.
+  uint32_t state_time_{0};                  ///< When state was measured.
+  Filter *filter_list_{nullptr};            ///< Store all active filters.
+  std::unique_ptr<SensorHistory> history_;  ///< Stored states, only if a history_size is set.
 
-  optional<std::string> unit_of_measurement_;           ///< Unit of measurement override
+  const char *unit_of_measurement_{nullptr};            ///< Unit of measurement override
   optional<int8_t> accuracy_decimals_;                  ///< Accuracy in decimals override
-  optional<std::string> device_class_;                  ///< Device class override
+  const char *device_class_{nullptr};                   ///< Device class override
   optional<StateClass> state_class_{STATE_CLASS_NONE};  ///< State class override
   bool force_update_{false};                            ///< Force update mode
 };
@@ -21,6 +21,14 @@ namespace sntp {
 
 static const char *const TAG = "sntp";
 
+#ifdef USE_ESP_IDF
+// A crystal that's further off than this is broken, limit the damage a bad sync can do
+static const float MAX_DRIFT_PPM = 500.0f;
+static const uint32_t DRIFT_COMPENSATION_INTERVAL = 10000;
+
+static SNTPComponent *global_sntp = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+
 void SNTPComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up SNTP...");
 #ifdef USE_ESP32
@@ -42,6 +50,12 @@ void SNTPComponent::setup() {
   }
 #ifdef USE_ESP_IDF
   sntp_set_sync_interval(this->get_update_interval());
+  if (this->smooth_sync_) {
+    global_sntp = this;
+    sntp_set_sync_mode(SNTP_SYNC_MODE_SMOOTH);
+    sntp_set_time_sync_notification_cb(SNTPComponent::on_sntp_sync_);
+    this->set_interval("drift", DRIFT_COMPENSATION_INTERVAL, [this]() { this->compensate_drift_(); });
+  }
 #endif
 
   sntp_init();
@@ -52,6 +66,9 @@ void SNTPComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Server 2: '%s'", this->server_2_.c_str());
   ESP_LOGCONFIG(TAG, "  Server 3: '%s'", this->server_3_.c_str());
   ESP_LOGCONFIG(TAG, "  Timezone: '%s'", this->timezone_.c_str());
+#ifdef USE_ESP_IDF
+  ESP_LOGCONFIG(TAG, "  Smooth Sync: %s", YESNO(this->smooth_sync_));
+#endif
 }
 void SNTPComponent::update() {
 #ifndef USE_ESP_IDF
@@ -64,6 +81,10 @@ void SNTPComponent::update() {
 #endif
 }
 void SNTPComponent::loop() {
+#ifdef USE_ESP_IDF
+  if (this->smooth_sync_)
+    this->process_sync_();
+#endif
   if (this->has_time_)
     return;
 
@@ -77,5 +98,59 @@ void SNTPComponent::loop() {
   this->has_time_ = true;
 }
 
+#ifdef USE_ESP_IDF
+void SNTPComponent::on_sntp_sync_(struct timeval *tv) {
+  // the clock only starts slewing now, so the offset to the server is still there. It's 0 if the clock was set
+  // instead, because it was off by more than adjtime() slews.
+  struct timeval now;
+  gettimeofday(&now, nullptr);
+  int64_t offset = (int64_t(tv->tv_sec) - now.tv_sec) * 1000000 + (tv->tv_usec - now.tv_usec);
+  LockGuard guard(global_sntp->lock_);
+  global_sntp->sync_offset_us_ = offset;
+  global_sntp->synced_ = true;
+}
+
+void SNTPComponent::process_sync_() {
+  int64_t offset;
+  {
+    LockGuard guard(this->lock_);
+    if (!this->synced_)
+      return;
+    this->synced_ = false;
+    offset = this->sync_offset_us_;
+  }
+  int64_t now = this->timestamp_now_us();
+  if (this->last_sync_us_ != 0 && now > this->last_sync_us_) {
+    // the drift is compensated for already, so the offset is what the estimate was off by
+    float correction = float(offset) * 1e6f / float(now - this->last_sync_us_);
+    this->drift_ppm_ = clamp(this->drift_ppm_ + correction, -MAX_DRIFT_PPM, MAX_DRIFT_PPM);
+    ESP_LOGD(TAG, "Clock was off by %.3f ms, drift %.2f ppm", offset / 1000.0f, this->drift_ppm_);
+  }
+  this->last_sync_us_ = now;
+  this->compensated_us_ = now;
+  if (this->has_time_)
+    this->time_sync_callback_.call();
+}
+
+void SNTPComponent::compensate_drift_() {
+  if (this->last_sync_us_ == 0 || this->drift_ppm_ == 0.0f)
+    return;
+  struct timeval pending;
+  adjtime(nullptr, &pending);
+  if (pending.tv_sec != 0 || pending.tv_usec != 0)
+    // still slewing towards the last sync, a new adjtime() would replace that
+    return;
+  int64_t now = this->timestamp_now_us();
+  auto correction = int64_t(float(now - this->compensated_us_) * this->drift_ppm_ / 1e6f);
+  if (correction == 0)
+    return;
+  struct timeval delta {
+    .tv_sec = static_cast<time_t>(correction / 1000000), .tv_usec = static_cast<suseconds_t>(correction % 1000000),
+  };
+  adjtime(&delta, nullptr);
+  this->compensated_us_ = now;
+}
+#endif
+
 }  // namespace sntp
 }  // namespace esphome
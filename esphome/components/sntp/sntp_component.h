@@ -1,8 +1,13 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/time/real_time_clock.h"
 
+#ifdef USE_ESP_IDF
+#include <sys/time.h>
+#endif
+
 namespace esphome {
 namespace sntp {
 
@@ -27,11 +32,42 @@ class SNTPComponent : public time::RealTimeClock {
   void update() override;
   void loop() override;
 
+#ifdef USE_ESP_IDF
+  /** Slew the clock to the time of the server instead of setting it, as long as it's off by less than 35 minutes.
+   *
+   * The rate the local clock drifts at is measured from the offset at each sync and compensated for between the
+   * syncs, so the clock doesn't jump and stays close to the server in between.
+   */
+  void set_smooth_sync(bool smooth_sync) { this->smooth_sync_ = smooth_sync; }
+  /// The measured drift of the local clock in ppm, positive if it runs slow.
+  float get_drift_ppm() const { return this->drift_ppm_; }
+#endif
+
  protected:
+#ifdef USE_ESP_IDF
+  /// Called from the lwIP task after every sync, in smooth mode tv is the server time the clock slews to.
+  static void on_sntp_sync_(struct timeval *tv);
+  /// Update the drift from the offset of the last sync.
+  void process_sync_();
+  void compensate_drift_();
+#endif
+
   std::string server_1_;
   std::string server_2_;
   std::string server_3_;
   bool has_time_{false};
+#ifdef USE_ESP_IDF
+  bool smooth_sync_{false};
+  Mutex lock_;
+  /// Set by the lwIP task together with sync_offset_us_.
+  bool synced_{false};
+  int64_t sync_offset_us_{0};
+  /// Local clock at the last sync, 0 before the first one.
+  int64_t last_sync_us_{0};
+  /// Local clock up to which the drift has been compensated.
+  int64_t compensated_us_{0};
+  float drift_ppm_{0.0f};
+#endif
 };
 
 }  // namespace sntp
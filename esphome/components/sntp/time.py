@@ -11,6 +11,7 @@ SNTPComponent = sntp_ns.class_("SNTPComponent", time_.RealTimeClock)
 
 
 DEFAULT_SERVERS = ["0.pool.ntp.org", "1.pool.ntp.org", "2.pool.ntp.org"]
+CONF_SMOOTH_SYNC = "smooth_sync"
 
 CONFIG_SCHEMA = time_.TIME_SCHEMA.extend(
     {
@@ -18,6 +19,7 @@ CONFIG_SCHEMA = time_.TIME_SCHEMA.extend(
         cv.Optional(CONF_SERVERS, default=DEFAULT_SERVERS): cv.All(
             cv.ensure_list(cv.Any(cv.domain, cv.hostname)), cv.Length(min=1, max=3)
         ),
+        cv.Optional(CONF_SMOOTH_SYNC): cv.All(cv.only_with_esp_idf, cv.boolean),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -28,6 +30,8 @@ async def to_code(config):
     servers = config[CONF_SERVERS]
     servers += [""] * (3 - len(servers))
     cg.add(var.set_servers(*servers))
+    if CONF_SMOOTH_SYNC in config:
+        cg.add(var.set_smooth_sync(config[CONF_SMOOTH_SYNC]))
 
     await cg.register_component(var, config)
     await time_.register_time(var, config)
@@ -1,11 +1,28 @@
 import esphome.config_validation as cv
 import esphome.codegen as cg
+from esphome.const import CONF_BUFFER_SIZE, CONF_ID
+from esphome.core import CORE
 
 CODEOWNERS = ["@esphome/core"]
 
 CONF_IMPLEMENTATION = "implementation"
 IMPLEMENTATION_LWIP_TCP = "lwip_tcp"
 IMPLEMENTATION_BSD_SOCKETS = "bsd_sockets"
+CONF_TCP_CLIENTS = "tcp_clients"
+CONF_MAX_CLIENTS = "max_clients"
+
+socket_ns = cg.esphome_ns.namespace("socket")
+TCPClientPool = socket_ns.class_("TCPClientPool", cg.Component)
+
+TCP_CLIENTS_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(TCPClientPool),
+        cv.Optional(CONF_MAX_CLIENTS, default=2): cv.int_range(min=1, max=16),
+        cv.Optional(CONF_BUFFER_SIZE, default="1kB"): cv.All(
+            cv.validate_bytes, cv.int_range(min=128, max=16384)
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
 
 CONFIG_SCHEMA = cv.Schema(
     {
@@ -16,6 +33,7 @@ CONFIG_SCHEMA = cv.Schema(
         ): cv.one_of(
             IMPLEMENTATION_LWIP_TCP, IMPLEMENTATION_BSD_SOCKETS, lower=True, space="_"
         ),
+        cv.Optional(CONF_TCP_CLIENTS): TCP_CLIENTS_SCHEMA,
     }
 )
 
@@ -26,3 +44,14 @@ async def to_code(config):
         cg.add_define("USE_SOCKET_IMPL_LWIP_TCP")
     elif impl == IMPLEMENTATION_BSD_SOCKETS:
         cg.add_define("USE_SOCKET_IMPL_BSD_SOCKETS")
+        if CORE.is_esp32:
+            # Lets the main loop sleep in select() on open sockets instead of a fixed delay
+            cg.add_define("USE_SOCKET_SELECT_SUPPORT")
+
+    if CONF_TCP_CLIENTS in config:
+        conf = config[CONF_TCP_CLIENTS]
+        var = cg.new_Pvariable(
+            conf[CONF_ID], conf[CONF_MAX_CLIENTS], conf[CONF_BUFFER_SIZE]
+        )
+        await cg.register_component(var, conf)
+        cg.add_define("USE_SOCKET_TCP_CLIENT_POOL")
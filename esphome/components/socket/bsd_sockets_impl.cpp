@@ -1,6 +1,7 @@
 #include "socket.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/application.h"
 
 #ifdef USE_SOCKET_IMPL_BSD_SOCKETS
 
@@ -35,7 +36,11 @@ std::string format_sockaddr(const struct sockaddr_storage &storage) {
 
 class BSDSocketImpl : public Socket {
  public:
-  BSDSocketImpl(int fd) : Socket(), fd_(fd) {}
+  BSDSocketImpl(int fd) : Socket(), fd_(fd) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    App.register_socket_fd(fd);
+#endif
+  }
   ~BSDSocketImpl() override {
     if (!closed_) {
       close();  // NOLINT(clang-analyzer-optin.cplusplus.VirtualCall)
@@ -48,7 +53,11 @@ class BSDSocketImpl : public Socket {
     return make_unique<BSDSocketImpl>(fd);
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return ::bind(fd_, addr, addrlen); }
+  int connect(const struct sockaddr *addr, socklen_t addrlen) override { return ::connect(fd_, addr, addrlen); }
   int close() override {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    App.unregister_socket_fd(fd_);
+#endif
     int ret = ::close(fd_);
     closed_ = true;
     return ret;
@@ -42,6 +42,7 @@
 #define SO_REUSEADDR 0x0004 /* Allow local address reuse */
 #define SO_KEEPALIVE 0x0008 /* keep connections alive */
 #define SO_BROADCAST 0x0020 /* permit to send and to receive broadcast messages (see IP_SOF_BROADCAST option) */
+#define SO_ERROR 0x1007     /* get error status and clear */
 
 #define SOL_SOCKET 0xfff /* options for socket level */
 
@@ -73,40 +73,8 @@ class LWIPRawImpl : public Socket {
     }
     ip_addr_t ip;
     in_port_t port;
-    auto family = name->sa_family;
-#if LWIP_IPV6
-    if (family == AF_INET) {
-      if (addrlen < sizeof(sockaddr_in6)) {
-        errno = EINVAL;
-        return -1;
-      }
-      auto *addr4 = reinterpret_cast<const sockaddr_in *>(name);
-      port = ntohs(addr4->sin_port);
-      ip.type = IPADDR_TYPE_V4;
-      ip.u_addr.ip4.addr = addr4->sin_addr.s_addr;
-
-    } else if (family == AF_INET6) {
-      if (addrlen < sizeof(sockaddr_in)) {
-        errno = EINVAL;
-        return -1;
-      }
-      auto *addr6 = reinterpret_cast<const sockaddr_in6 *>(name);
-      port = ntohs(addr6->sin6_port);
-      ip.type = IPADDR_TYPE_V6;
-      memcpy(&ip.u_addr.ip6.addr, &addr6->sin6_addr.un.u8_addr, 16);
-    } else {
-      errno = EINVAL;
-      return -1;
-    }
-#else
-    if (family != AF_INET) {
-      errno = EINVAL;
+    if (!parse_sockaddr_(name, addrlen, &ip, &port))
       return -1;
-    }
-    auto *addr4 = reinterpret_cast<const sockaddr_in *>(name);
-    port = ntohs(addr4->sin_port);
-    ip.addr = addr4->sin_addr.s_addr;
-#endif
     LWIP_LOG("tcp_bind(%p ip=%u port=%u)", pcb_, ip.addr, port);
     err_t err = tcp_bind(pcb_, &ip, port);
     if (err == ERR_USE) {
@@ -126,6 +94,45 @@ class LWIPRawImpl : public Socket {
     }
     return 0;
   }
+  int connect(const struct sockaddr *name, socklen_t addrlen) override {
+    if (pcb_ == nullptr) {
+      errno = EBADF;
+      return -1;
+    }
+    if (connecting_) {
+      errno = EALREADY;
+      return -1;
+    }
+    if (name == nullptr) {
+      errno = EINVAL;
+      return -1;
+    }
+    ip_addr_t ip;
+    in_port_t port;
+    if (!parse_sockaddr_(name, addrlen, &ip, &port))
+      return -1;
+    LWIP_LOG("tcp_connect(%p ip=%u port=%u)", pcb_, ip.addr, port);
+    err_t err = tcp_connect(pcb_, &ip, port, LWIPRawImpl::s_connected_fn);
+    if (err == ERR_ISCONN) {
+      LWIP_LOG("  -> err ERR_ISCONN");
+      errno = EISCONN;
+      return -1;
+    }
+    if (err == ERR_RTE) {
+      LWIP_LOG("  -> err ERR_RTE");
+      errno = ENETUNREACH;
+      return -1;
+    }
+    if (err != ERR_OK) {
+      LWIP_LOG("  -> err %d", err);
+      errno = err == ERR_MEM ? ENOMEM : EIO;
+      return -1;
+    }
+    // blocking operation not supported, the connection is established in the background
+    connecting_ = true;
+    errno = EINPROGRESS;
+    return -1;
+  }
   int close() override {
     if (pcb_ == nullptr) {
       errno = ECONNRESET;
@@ -174,6 +181,10 @@ class LWIPRawImpl : public Socket {
       errno = ECONNRESET;
       return -1;
     }
+    if (connecting_) {
+      errno = ENOTCONN;
+      return -1;
+    }
     if (name == nullptr || addrlen == nullptr) {
       errno = EINVAL;
       return -1;
@@ -261,6 +272,17 @@ class LWIPRawImpl : public Socket {
       *optlen = 4;
       return 0;
     }
+    if (level == SOL_SOCKET && optname == SO_ERROR) {
+      if (*optlen < 4) {
+        errno = EINVAL;
+        return -1;
+      }
+
+      // a failed connect frees the pcb, so there's never an error pending on a pcb
+      *reinterpret_cast<int *>(optval) = 0;
+      *optlen = 4;
+      return 0;
+    }
 
     errno = EINVAL;
     return -1;
@@ -325,23 +347,56 @@ class LWIPRawImpl : public Socket {
     if (len == 0) {
       return 0;
     }
-    if (rx_buf_ == nullptr) {
+
+    size_t read = 0;
+    uint8_t *buf8 = reinterpret_cast<uint8_t *>(buf);
+    while (len) {
+      uint8_t *data;
+      ssize_t available = this->peek(&data);
+      if (available <= 0)
+        break;
+      size_t copysize = std::min(len, (size_t) available);
+      memcpy(buf8, data, copysize);
+      this->consume(copysize);
+
+      buf8 += copysize;
+      len -= copysize;
+      read += copysize;
+    }
+
+    if (read == 0) {
       errno = EWOULDBLOCK;
       return -1;
     }
 
-    size_t read = 0;
-    uint8_t *buf8 = reinterpret_cast<uint8_t *>(buf);
+    return read;
+  }
+  ssize_t peek(uint8_t **data) override {
+    if (pcb_ == nullptr) {
+      errno = ECONNRESET;
+      return -1;
+    }
+    if (rx_closed_ && rx_buf_ == nullptr) {
+      return 0;
+    }
+    if (rx_buf_ == nullptr || rx_buf_->len == rx_buf_offset_) {
+      errno = EWOULDBLOCK;
+      return -1;
+    }
+    *data = reinterpret_cast<uint8_t *>(rx_buf_->payload) + rx_buf_offset_;
+    return rx_buf_->len - rx_buf_offset_;
+  }
+  void consume(size_t len) override {
+    if (pcb_ == nullptr)
+      return;
     while (len && rx_buf_ != nullptr) {
-      size_t pb_len = rx_buf_->len;
-      size_t pb_left = pb_len - rx_buf_offset_;
+      size_t pb_left = rx_buf_->len - rx_buf_offset_;
       if (pb_left == 0)
         break;
-      size_t copysize = std::min(len, pb_left);
-      memcpy(buf8, reinterpret_cast<uint8_t *>(rx_buf_->payload) + rx_buf_offset_, copysize);
+      size_t consumed = std::min(len, pb_left);
 
-      if (pb_left == copysize) {
-        // full pb copied, free it
+      if (pb_left == consumed) {
+        // full pb consumed, free it
         if (rx_buf_->next == nullptr) {
           // last buffer in chain
           pbuf_free(rx_buf_);
@@ -355,22 +410,12 @@ class LWIPRawImpl : public Socket {
           rx_buf_offset_ = 0;
         }
       } else {
-        rx_buf_offset_ += copysize;
+        rx_buf_offset_ += consumed;
       }
-      LWIP_LOG("tcp_recved(%p %u)", pcb_, copysize);
-      tcp_recved(pcb_, copysize);
-
-      buf8 += copysize;
-      len -= copysize;
-      read += copysize;
-    }
-
-    if (read == 0) {
-      errno = EWOULDBLOCK;
-      return -1;
+      LWIP_LOG("tcp_recved(%p %u)", pcb_, consumed);
+      tcp_recved(pcb_, consumed);
+      len -= consumed;
     }
-
-    return read;
   }
   ssize_t readv(const struct iovec *iov, int iovcnt) override {
     ssize_t ret = 0;
@@ -502,6 +547,11 @@ class LWIPRawImpl : public Socket {
     accepted_sockets_.push(std::move(sock));
     return ERR_OK;
   }
+  err_t connected_fn(err_t err) {
+    LWIP_LOG("connected(err=%d)", err);
+    connecting_ = false;
+    return ERR_OK;
+  }
   void err_fn(err_t err) {
     LWIP_LOG("err(err=%d)", err);
     // "If a connection is aborted because of an error, the application is alerted of this event by
@@ -538,6 +588,11 @@ class LWIPRawImpl : public Socket {
     return arg_this->accept_fn(newpcb, err);
   }
 
+  static err_t s_connected_fn(void *arg, struct tcp_pcb *pcb, err_t err) {
+    LWIPRawImpl *arg_this = reinterpret_cast<LWIPRawImpl *>(arg);
+    return arg_this->connected_fn(err);
+  }
+
   static void s_err_fn(void *arg, err_t err) {
     LWIPRawImpl *arg_this = reinterpret_cast<LWIPRawImpl *>(arg);
     arg_this->err_fn(err);
@@ -549,8 +604,47 @@ class LWIPRawImpl : public Socket {
   }
 
  protected:
+  static bool parse_sockaddr_(const struct sockaddr *name, socklen_t addrlen, ip_addr_t *ip, in_port_t *port) {
+    auto family = name->sa_family;
+#if LWIP_IPV6
+    if (family == AF_INET) {
+      if (addrlen < sizeof(sockaddr_in)) {
+        errno = EINVAL;
+        return false;
+      }
+      auto *addr4 = reinterpret_cast<const sockaddr_in *>(name);
+      *port = ntohs(addr4->sin_port);
+      ip->type = IPADDR_TYPE_V4;
+      ip->u_addr.ip4.addr = addr4->sin_addr.s_addr;
+
+    } else if (family == AF_INET6) {
+      if (addrlen < sizeof(sockaddr_in6)) {
+        errno = EINVAL;
+        return false;
+      }
+      auto *addr6 = reinterpret_cast<const sockaddr_in6 *>(name);
+      *port = ntohs(addr6->sin6_port);
+      ip->type = IPADDR_TYPE_V6;
+      memcpy(&ip->u_addr.ip6.addr, &addr6->sin6_addr.un.u8_addr, 16);
+    } else {
+      errno = EINVAL;
+      return false;
+    }
+#else
+    if (family != AF_INET) {
+      errno = EINVAL;
+      return false;
+    }
+    auto *addr4 = reinterpret_cast<const sockaddr_in *>(name);
+    *port = ntohs(addr4->sin_port);
+    ip->addr = addr4->sin_addr.s_addr;
+#endif
+    return true;
+  }
+
   struct tcp_pcb *pcb_;
   std::queue<std::unique_ptr<LWIPRawImpl>> accepted_sockets_;
+  bool connecting_ = false;
   bool rx_closed_ = false;
   pbuf *rx_buf_ = nullptr;
   size_t rx_buf_offset_ = 0;
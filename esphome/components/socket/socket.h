@@ -1,4 +1,5 @@
 #pragma once
+#include <cerrno>
 #include <string>
 #include <memory>
 
@@ -18,9 +19,12 @@ class Socket {
   virtual std::unique_ptr<Socket> accept(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual int bind(const struct sockaddr *addr, socklen_t addrlen) = 0;
   virtual int close() = 0;
-  // not supported yet:
-  // virtual int connect(const std::string &address) = 0;
-  // virtual int connect(const struct sockaddr *addr, socklen_t addrlen) = 0;
+  /** Connect to a remote address.
+   *
+   * Non-blocking sockets return -1 with errno EINPROGRESS, the connection is up once getpeername() succeeds, see
+   * TCPClient for an implementation of that.
+   */
+  virtual int connect(const struct sockaddr *addr, socklen_t addrlen) = 0;
   virtual int shutdown(int how) = 0;
 
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
@@ -32,6 +36,18 @@ class Socket {
   virtual int listen(int backlog) = 0;
   virtual ssize_t read(void *buf, size_t len) = 0;
   virtual ssize_t readv(const struct iovec *iov, int iovcnt) = 0;
+  /** Look at received data without copying it out of the socket's receive buffer.
+   *
+   * Points data at the next contiguous block of received bytes and returns its length, or 0 if the connection was
+   * closed. Returns -1 on error with errno set: EWOULDBLOCK if nothing was received, EOPNOTSUPP if this socket can
+   * only read(). The data may be modified in place and stays valid until it's consumed or read.
+   */
+  virtual ssize_t peek(uint8_t **data) {
+    errno = EOPNOTSUPP;
+    return -1;
+  }
+  /// Drop len bytes of received data that were looked at with peek().
+  virtual void consume(size_t len) {}
   virtual ssize_t write(const void *buf, size_t len) = 0;
   virtual ssize_t writev(const struct iovec *iov, int iovcnt) = 0;
   virtual int setblocking(bool blocking) = 0;
@@ -0,0 +1,205 @@
+#include "tcp_client.h"
+
+#ifdef USE_SOCKET_TCP_CLIENT_POOL
+
+#include <cstring>
+
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace socket {
+
+static const char *const TAG = "socket.tcp_client";
+
+TCPClientPool *global_tcp_client_pool = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+bool TCPClient::connect(network::IPAddress ip, uint16_t port) {
+  this->close();
+  this->socket_ = socket::socket(AF_INET, SOCK_STREAM, 0);
+  if (this->socket_ == nullptr) {
+    ESP_LOGW(TAG, "Could not create socket.");
+    return false;
+  }
+  int err = this->socket_->setblocking(false);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", errno);
+    this->socket_ = nullptr;
+    return false;
+  }
+  int enable = 1;
+  err = this->socket_->setsockopt(IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(int));
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket could not enable tcp nodelay, errno: %d", errno);
+    // we can still continue
+  }
+
+  struct sockaddr_in server;
+  memset(&server, 0, sizeof(server));
+  server.sin_family = AF_INET;
+  server.sin_addr.s_addr = (uint32_t) ip;
+  server.sin_port = htons(port);
+
+  err = this->socket_->connect((struct sockaddr *) &server, sizeof(server));
+  if (err != 0 && errno != EINPROGRESS) {
+    ESP_LOGW(TAG, "Socket unable to connect to %s:%u: errno %d", ip.str().c_str(), port, errno);
+    this->socket_ = nullptr;
+    return false;
+  }
+  ESP_LOGV(TAG, "Connecting to %s:%u", ip.str().c_str(), port);
+  this->state_ = State::CONNECTING;
+  return true;
+}
+
+bool TCPClient::write(const uint8_t *data, size_t len) {
+  if (this->state_ == State::IDLE)
+    return false;
+  if (this->state_ == State::CONNECTED && this->tx_buf_.empty()) {
+    ssize_t sent = this->socket_->write(data, len);
+    if (sent == -1) {
+      if (errno != EWOULDBLOCK && errno != EAGAIN) {
+        this->fail_(errno);
+        return false;
+      }
+      sent = 0;
+    }
+    data += sent;
+    len -= sent;
+  }
+  this->tx_buf_.insert(this->tx_buf_.end(), data, data + len);
+  return true;
+}
+
+void TCPClient::close() {
+  if (this->socket_ != nullptr) {
+    this->socket_->close();
+    this->socket_ = nullptr;
+  }
+  this->tx_buf_.clear();
+  this->tx_buf_.shrink_to_fit();
+  this->state_ = State::IDLE;
+}
+
+void TCPClient::loop_(uint8_t *buf, size_t len) {
+  if (this->state_ == State::CONNECTING)
+    this->check_connected_();
+  if (this->state_ != State::CONNECTED)
+    return;
+  if (!this->tx_buf_.empty() && !this->try_send_tx_buf_())
+    return;
+
+  while (true) {
+    uint8_t *data;
+    ssize_t received = this->socket_->peek(&data);
+    bool peeked = received != -1 || errno != EOPNOTSUPP;
+    if (!peeked) {
+      data = buf;
+      received = this->socket_->read(buf, len);
+    }
+    if (received == -1) {
+      if (errno == EWOULDBLOCK || errno == EAGAIN)
+        return;
+      this->fail_(errno);
+      return;
+    }
+    if (received == 0) {
+      ESP_LOGV(TAG, "Connection closed by remote");
+      this->fail_(0);
+      return;
+    }
+
+    if (this->on_data_)
+      this->on_data_(data, received);
+    // the callback may have closed the connection
+    if (this->state_ != State::CONNECTED)
+      return;
+    if (peeked)
+      this->socket_->consume(received);
+  }
+}
+
+void TCPClient::check_connected_() {
+  // a connect() in progress is done once the peer is known, if it failed the socket has the error
+  struct sockaddr_in peer;
+  socklen_t peer_len = sizeof(peer);
+  if (this->socket_->getpeername((struct sockaddr *) &peer, &peer_len) == 0) {
+    ESP_LOGV(TAG, "Connected to %s", this->socket_->getpeername().c_str());
+    this->state_ = State::CONNECTED;
+    if (this->on_connect_)
+      this->on_connect_();
+    return;
+  }
+  if (errno != ENOTCONN) {
+    this->fail_(errno);
+    return;
+  }
+  int error = 0;
+  socklen_t error_len = sizeof(error);
+  if (this->socket_->getsockopt(SOL_SOCKET, SO_ERROR, &error, &error_len) == 0 && error != 0)
+    this->fail_(error);
+}
+
+bool TCPClient::try_send_tx_buf_() {
+  ssize_t sent = this->socket_->write(this->tx_buf_.data(), this->tx_buf_.size());
+  if (sent == -1) {
+    if (errno == EWOULDBLOCK || errno == EAGAIN)
+      return true;
+    this->fail_(errno);
+    return false;
+  }
+  this->tx_buf_.erase(this->tx_buf_.begin(), this->tx_buf_.begin() + sent);
+  return true;
+}
+
+void TCPClient::fail_(int err) {
+  if (err != 0)
+    ESP_LOGW(TAG, "Connection failed: errno %d", err);
+  this->close();
+  if (this->on_close_)
+    this->on_close_();
+}
+
+TCPClientPool::TCPClientPool(size_t max_clients, size_t buffer_size)
+    : clients_(max_clients), buffer_size_(buffer_size) {
+  global_tcp_client_pool = this;
+}
+
+void TCPClientPool::setup() {
+  this->buffer_ = std::unique_ptr<uint8_t[]>(new uint8_t[this->buffer_size_]);  // NOLINT
+}
+
+TCPClient *TCPClientPool::acquire() {
+  for (auto &client : this->clients_) {
+    if (!client.in_use_) {
+      client.in_use_ = true;
+      return &client;
+    }
+  }
+  ESP_LOGW(TAG, "All %u TCP clients are in use", this->clients_.size());
+  return nullptr;
+}
+
+void TCPClientPool::release(TCPClient *client) {
+  client->close();
+  client->on_connect_ = nullptr;
+  client->on_data_ = nullptr;
+  client->on_close_ = nullptr;
+  client->in_use_ = false;
+}
+
+void TCPClientPool::loop() {
+  for (auto &client : this->clients_) {
+    if (client.in_use_)
+      client.loop_(this->buffer_.get(), this->buffer_size_);
+  }
+}
+
+void TCPClientPool::dump_config() {
+  ESP_LOGCONFIG(TAG, "TCP Client Pool:");
+  ESP_LOGCONFIG(TAG, "  Max Clients: %u", this->clients_.size());
+  ESP_LOGCONFIG(TAG, "  Buffer Size: %u", this->buffer_size_);
+}
+
+}  // namespace socket
+}  // namespace esphome
+
+#endif  // USE_SOCKET_TCP_CLIENT_POOL
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SOCKET_TCP_CLIENT_POOL
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "esphome/components/network/ip_address.h"
+#include "esphome/core/component.h"
+#include "socket.h"
+
+namespace esphome {
+namespace socket {
+
+class TCPClientPool;
+
+/** A non-blocking outbound TCP connection.
+ *
+ * Clients are leased from a TCPClientPool, which drives them from its loop() and reads for all of them into one
+ * shared buffer, or straight out of the socket's receive buffer if the socket supports peek(). Received data is
+ * only valid during the data callback.
+ */
+class TCPClient {
+ public:
+  enum class State : uint8_t {
+    IDLE = 0,
+    CONNECTING = 1,
+    CONNECTED = 2,
+  };
+  using data_callback_t = std::function<void(const uint8_t *data, size_t len)>;
+
+  /// Start connecting, the connect callback is called once the connection is up.
+  bool connect(network::IPAddress ip, uint16_t port);
+  /** Send data, whatever the socket doesn't take right away is queued and sent from the pool's loop().
+   *
+   * Data written while connecting is sent once the connection is up. Returns false if there's no connection.
+   */
+  bool write(const uint8_t *data, size_t len);
+  /// Close the connection, this doesn't call the close callback.
+  void close();
+
+  State get_state() const { return this->state_; }
+  bool is_connected() const { return this->state_ == State::CONNECTED; }
+  /// Number of bytes that are queued for sending.
+  size_t get_pending() const { return this->tx_buf_.size(); }
+
+  void set_on_connect(std::function<void()> &&callback) { this->on_connect_ = std::move(callback); }
+  void set_on_data(data_callback_t &&callback) { this->on_data_ = std::move(callback); }
+  /// Called when connecting fails or the connection is lost or closed by the remote end.
+  void set_on_close(std::function<void()> &&callback) { this->on_close_ = std::move(callback); }
+
+ protected:
+  friend class TCPClientPool;
+
+  void loop_(uint8_t *buf, size_t len);
+  void check_connected_();
+  bool try_send_tx_buf_();
+  void fail_(int err);
+
+  std::unique_ptr<Socket> socket_;
+  std::vector<uint8_t> tx_buf_;
+  std::function<void()> on_connect_;
+  data_callback_t on_data_;
+  std::function<void()> on_close_;
+  State state_{State::IDLE};
+  bool in_use_{false};
+};
+
+/// Owns the TCP clients that outbound components share, and one receive buffer for all of them.
+class TCPClientPool : public Component {
+ public:
+  TCPClientPool(size_t max_clients, size_t buffer_size);
+
+  /// Get an unused client, nullptr if all of them are in use.
+  TCPClient *acquire();
+  /// Give a client back, this closes its connection.
+  void release(TCPClient *client);
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+ protected:
+  std::vector<TCPClient> clients_;
+  std::unique_ptr<uint8_t[]> buffer_;
+  size_t buffer_size_;
+};
+
+extern TCPClientPool *global_tcp_client_pool;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace socket
+}  // namespace esphome
+
+#endif  // USE_SOCKET_TCP_CLIENT_POOL
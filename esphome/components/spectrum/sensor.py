@@ -0,0 +1,79 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+import esphome.final_validate as fv
+from esphome.components import sensor, voltage_sampler
+from esphome.const import (
+    CONF_FREQUENCY,
+    CONF_ID,
+    CONF_PLATFORM,
+    CONF_SENSOR,
+    DEVICE_CLASS_VOLTAGE,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_VOLT,
+)
+
+AUTO_LOAD = ["voltage_sampler"]
+
+CONF_BINS = "bins"
+CONF_SAMPLE_RATE = "sample_rate"
+CONF_WINDOW_SIZE = "window_size"
+
+# Sources that read a whole window in one go without stalling the loop, other ones
+# (like ADCs on I2C) would block it for hundreds of conversions.
+BLOCK_SOURCE_PLATFORMS = ["adc", "adc_continuous"]
+
+spectrum_ns = cg.esphome_ns.namespace("spectrum")
+SpectrumComponent = spectrum_ns.class_("SpectrumComponent", cg.PollingComponent)
+
+BIN_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_VOLT,
+    accuracy_decimals=3,
+    device_class=DEVICE_CLASS_VOLTAGE,
+    state_class=STATE_CLASS_MEASUREMENT,
+).extend(
+    {
+        cv.Required(CONF_FREQUENCY): cv.frequency,
+    }
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(SpectrumComponent),
+        cv.Required(CONF_SENSOR): cv.use_id(voltage_sampler.VoltageSampler),
+        cv.Optional(CONF_WINDOW_SIZE, default=256): cv.int_range(min=16, max=512),
+        cv.Optional(CONF_SAMPLE_RATE): cv.frequency,
+        cv.Required(CONF_BINS): cv.All(cv.ensure_list(BIN_SCHEMA), cv.Length(min=1)),
+    }
+).extend(cv.polling_component_schema("10s"))
+
+
+def _final_validate(config):
+    fconf = fv.full_config.get()
+    path = fconf.get_path_for_id(config[CONF_SENSOR])[:-1]
+    # sensor platforms have a platform key, components like adc_continuous are the domain
+    platform = fconf.get_config_for_path(path).get(CONF_PLATFORM, path[0])
+    if platform not in BLOCK_SOURCE_PLATFORMS:
+        raise cv.Invalid(
+            f"{platform} can't provide a window of samples at once, use "
+            f"{' or '.join(BLOCK_SOURCE_PLATFORMS)} as the source",
+            [CONF_SENSOR],
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    source = await cg.get_variable(config[CONF_SENSOR])
+    cg.add(var.set_source(source))
+    cg.add(var.set_window_size(config[CONF_WINDOW_SIZE]))
+    if CONF_SAMPLE_RATE in config:
+        cg.add(var.set_sample_rate(config[CONF_SAMPLE_RATE]))
+
+    for conf in config[CONF_BINS]:
+        sens = await sensor.new_sensor(conf)
+        cg.add(var.add_bin(sens, conf[CONF_FREQUENCY]))
@@ -0,0 +1,87 @@
+#include "spectrum.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace spectrum {
+
+static const char *const TAG = "spectrum";
+
+void SpectrumComponent::setup() {
+  this->samples_.resize(this->window_size_);
+  this->window_.resize(this->window_size_);
+  // Hann window, it leaks less of strong nearby frequencies (like mains) into the bins
+  for (size_t i = 0; i < this->window_size_; i++)
+    this->window_[i] = 0.5f - 0.5f * cosf(2.0f * M_PI * i / (this->window_size_ - 1));
+}
+
+void SpectrumComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Spectrum:");
+  ESP_LOGCONFIG(TAG, "  Window Size: %u", (unsigned) this->window_size_);
+  if (this->sample_rate_ != 0)
+    ESP_LOGCONFIG(TAG, "  Sample Rate: %.0f Hz", this->sample_rate_);
+  LOG_UPDATE_INTERVAL(this);
+  for (auto &bin : this->bins_) {
+    LOG_SENSOR("  ", "Bin", bin.sensor);
+    ESP_LOGCONFIG(TAG, "    Frequency: %.1f Hz", bin.frequency);
+  }
+}
+
+void SpectrumComponent::update() {
+  const size_t count = this->window_size_;
+  float *samples = this->samples_.data();
+
+  const uint32_t start = micros();
+  this->source_->sample_block(samples, count);
+  const uint32_t duration = micros() - start;
+
+  float sample_rate = this->source_->get_sample_rate();
+  if (std::isnan(sample_rate))
+    sample_rate = this->sample_rate_;
+  if (sample_rate == 0)
+    // The source reads as fast as it can, assume it did so at an even pace
+    sample_rate = count * 1e6f / duration;
+
+  float sum = 0.0f;
+  for (size_t i = 0; i < count; i++)
+    sum += samples[i];
+  if (std::isnan(sum)) {
+    ESP_LOGW(TAG, "Sampling failed");
+    for (auto &bin : this->bins_)
+      bin.sensor->publish_state(NAN);
+    return;
+  }
+  const float mean = sum / count;
+  for (size_t i = 0; i < count; i++)
+    samples[i] = (samples[i] - mean) * this->window_[i];
+
+  ESP_LOGV(TAG, "%u samples at %.0f Hz", (unsigned) count, sample_rate);
+  for (auto &bin : this->bins_) {
+    if (bin.frequency * 2 > sample_rate) {
+      ESP_LOGW(TAG, "%.0f Hz is above half the sample rate (%.0f Hz)", bin.frequency, sample_rate);
+      bin.sensor->publish_state(NAN);
+      continue;
+    }
+    bin.sensor->publish_state(this->goertzel_(bin.frequency, sample_rate));
+  }
+}
+
+float SpectrumComponent::goertzel_(float frequency, float sample_rate) const {
+  const float coeff = 2.0f * cosf(2.0f * M_PI * frequency / sample_rate);
+  float s1 = 0.0f;
+  float s2 = 0.0f;
+  for (float sample : this->samples_) {
+    const float s0 = sample + coeff * s1 - s2;
+    s2 = s1;
+    s1 = s0;
+  }
+  const float power = s1 * s1 + s2 * s2 - coeff * s1 * s2;
+  // Amplitude of a sine wave at the frequency, the Hann window halves it
+  return 2.0f * sqrtf(std::max(power, 0.0f)) / (this->window_size_ * 0.5f);
+}
+
+}  // namespace spectrum
+}  // namespace esphome
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/voltage_sampler/voltage_sampler.h"
+
+#include <vector>
+
+namespace esphome {
+namespace spectrum {
+
+/** Measures the amplitude of single frequencies in a voltage signal.
+ *
+ * Every update samples a window of values, removes its DC part and applies a Hann window. Each bin then runs the
+ * Goertzel algorithm, which for a few frequencies is much cheaper than a full FFT.
+ */
+class SpectrumComponent : public PollingComponent {
+ public:
+  void set_source(voltage_sampler::VoltageSampler *source) { this->source_ = source; }
+  void set_window_size(size_t window_size) { this->window_size_ = window_size; }
+  /// Sample rate of the source, if it doesn't know it itself. 0 to measure it.
+  void set_sample_rate(float sample_rate) { this->sample_rate_ = sample_rate; }
+  /// Publish the amplitude (in V) around frequency (in Hz) to sensor.
+  void add_bin(sensor::Sensor *sensor, float frequency) { this->bins_.push_back({sensor, frequency}); }
+
+  void setup() override;
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+ protected:
+  struct Bin {
+    sensor::Sensor *sensor;
+    float frequency;
+  };
+
+  /// The amplitude of the frequency in the windowed samples.
+  float goertzel_(float frequency, float sample_rate) const;
+
+  voltage_sampler::VoltageSampler *source_;
+  size_t window_size_{256};
+  float sample_rate_{0};
+  std::vector<Bin> bins_;
+  std::vector<float> window_;
+  std::vector<float> samples_;
+};
+
+}  // namespace spectrum
+}  // namespace esphome
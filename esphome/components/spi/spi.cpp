@@ -3,12 +3,27 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace spi {
 
 static const char *const TAG = "spi";
 
+#ifdef USE_SPI_ESP_IDF_BACKEND
+/// Largest single transaction, longer transfers are split up.
+static const size_t IDF_MAX_TRANSFER_SIZE = 32768;
+#endif  // USE_SPI_ESP_IDF_BACKEND
+
 void IRAM_ATTR HOT SPIComponent::disable() {
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  if (this->idf_device_ != nullptr) {
+    this->wait_async_writes();
+    spi_device_release_bus(this->idf_device_);
+    this->idf_device_ = nullptr;
+  }
+#endif  // USE_SPI_ESP_IDF_BACKEND
 #ifdef USE_SPI_ARDUINO_BACKEND
   if (this->hw_spi_ != nullptr) {
     this->hw_spi_->endTransaction();
@@ -19,40 +34,48 @@ void IRAM_ATTR HOT SPIComponent::disable() {
     this->active_cs_ = nullptr;
   }
 }
+bool SPIComponent::can_use_hw_spi_() const {
+  const bool has_miso = this->miso_ != nullptr;
+  const bool has_mosi = this->mosi_ != nullptr;
+  if (!this->clk_->is_internal())
+    return false;
+  if (has_miso && !miso_->is_internal())
+    return false;
+  if (has_mosi && !mosi_->is_internal())
+    return false;
+
+  auto *clk_internal = (InternalGPIOPin *) clk_;
+  auto *miso_internal = (InternalGPIOPin *) miso_;
+  auto *mosi_internal = (InternalGPIOPin *) mosi_;
+  if (clk_internal->is_inverted())
+    return false;
+  if (has_miso && miso_internal->is_inverted())
+    return false;
+  if (has_mosi && mosi_internal->is_inverted())
+    return false;
+  return true;
+}
 void SPIComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up SPI bus...");
+
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  if (this->can_use_hw_spi_() && this->setup_idf_())
+    return;
+#endif  // USE_SPI_ESP_IDF_BACKEND
+
   this->clk_->setup();
   this->clk_->digital_write(true);
 
 #ifdef USE_SPI_ARDUINO_BACKEND
-  bool use_hw_spi = true;
+  bool use_hw_spi = this->can_use_hw_spi_();
   const bool has_miso = this->miso_ != nullptr;
   const bool has_mosi = this->mosi_ != nullptr;
   int8_t clk_pin = -1, miso_pin = -1, mosi_pin = -1;
 
-  if (!this->clk_->is_internal())
-    use_hw_spi = false;
-  if (has_miso && !miso_->is_internal())
-    use_hw_spi = false;
-  if (has_mosi && !mosi_->is_internal())
-    use_hw_spi = false;
   if (use_hw_spi) {
-    auto *clk_internal = (InternalGPIOPin *) clk_;
-    auto *miso_internal = (InternalGPIOPin *) miso_;
-    auto *mosi_internal = (InternalGPIOPin *) mosi_;
-
-    if (clk_internal->is_inverted())
-      use_hw_spi = false;
-    if (has_miso && miso_internal->is_inverted())
-      use_hw_spi = false;
-    if (has_mosi && mosi_internal->is_inverted())
-      use_hw_spi = false;
-
-    if (use_hw_spi) {
-      clk_pin = clk_internal->get_pin();
-      miso_pin = has_miso ? miso_internal->get_pin() : -1;
-      mosi_pin = has_mosi ? mosi_internal->get_pin() : -1;
-    }
+    clk_pin = ((InternalGPIOPin *) clk_)->get_pin();
+    miso_pin = has_miso ? ((InternalGPIOPin *) miso_)->get_pin() : -1;
+    mosi_pin = has_mosi ? ((InternalGPIOPin *) mosi_)->get_pin() : -1;
   }
 #ifdef USE_ESP8266
   if (!(clk_pin == 6 && miso_pin == 7 && mosi_pin == 8) &&
@@ -101,7 +124,174 @@ void SPIComponent::dump_config() {
 #ifdef USE_SPI_ARDUINO_BACKEND
   ESP_LOGCONFIG(TAG, "  Using HW SPI: %s", YESNO(this->hw_spi_ != nullptr));
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  ESP_LOGCONFIG(TAG, "  Using HW SPI: %s", YESNO(this->idf_host_ready_));
+#endif  // USE_SPI_ESP_IDF_BACKEND
+}
+void SPIComponent::wait_async_writes() {
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  while (this->idf_pending_ > 0)
+    this->idf_wait_oldest_();
+#endif  // USE_SPI_ESP_IDF_BACKEND
+}
+
+#ifdef USE_SPI_ESP_IDF_BACKEND
+bool SPIComponent::setup_idf_() {
+  static uint8_t spi_bus_num = 0;
+#if SOC_SPI_PERIPH_NUM > 2
+  static const spi_host_device_t HOSTS[] = {SPI2_HOST, SPI3_HOST};
+#else
+  static const spi_host_device_t HOSTS[] = {SPI2_HOST};
+#endif
+  if (spi_bus_num >= sizeof(HOSTS) / sizeof(HOSTS[0]))
+    return false;
+
+  spi_bus_config_t bus_config{};
+  bus_config.sclk_io_num = ((InternalGPIOPin *) this->clk_)->get_pin();
+  bus_config.miso_io_num = this->miso_ != nullptr ? ((InternalGPIOPin *) this->miso_)->get_pin() : -1;
+  bus_config.mosi_io_num = this->mosi_ != nullptr ? ((InternalGPIOPin *) this->mosi_)->get_pin() : -1;
+  bus_config.quadwp_io_num = -1;
+  bus_config.quadhd_io_num = -1;
+  bus_config.max_transfer_sz = IDF_MAX_TRANSFER_SIZE;
+  esp_err_t err = spi_bus_initialize(HOSTS[spi_bus_num], &bus_config, SPI_DMA_CH_AUTO);
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "Initializing SPI peripheral failed, using software SPI: %s", esp_err_to_name(err));
+    return false;
+  }
+  this->idf_host_ = HOSTS[spi_bus_num++];
+  this->idf_host_ready_ = true;
+  return true;
+}
+void SPIComponent::idf_enable_(uint8_t mode, uint32_t data_rate, bool lsb_first) {
+  auto matches = [=](const IDFDevice &device) {
+    return device.mode == mode && device.data_rate == data_rate && device.lsb_first == lsb_first;
+  };
+  spi_device_handle_t handle = nullptr;
+  if (this->idf_last_device_ < this->idf_devices_.size() && matches(this->idf_devices_[this->idf_last_device_])) {
+    handle = this->idf_devices_[this->idf_last_device_].handle;
+  } else {
+    for (size_t i = 0; i < this->idf_devices_.size(); i++) {
+      if (matches(this->idf_devices_[i])) {
+        this->idf_last_device_ = i;
+        handle = this->idf_devices_[i].handle;
+        break;
+      }
+    }
+  }
+  if (handle == nullptr)
+    handle = this->idf_add_device_(mode, data_rate, lsb_first);
+  if (handle == nullptr) {
+    this->idf_device_ = nullptr;
+    return;
+  }
+  // Keep the bus until disable(), the transfers in between then skip the driver's per-transaction bus arbitration
+  spi_device_acquire_bus(handle, portMAX_DELAY);
+  this->idf_device_ = handle;
+}
+spi_device_handle_t SPIComponent::idf_add_device_(uint8_t mode, uint32_t data_rate, bool lsb_first) {
+  spi_device_interface_config_t config{};
+  config.mode = mode;
+  config.clock_speed_hz = data_rate;
+  // chip select is driven by enable() and disable()
+  config.spics_io_num = -1;
+  config.queue_size = 2;
+  if (lsb_first)
+    config.flags |= SPI_DEVICE_BIT_LSBFIRST;
+  spi_device_handle_t handle;
+  esp_err_t err = spi_bus_add_device(this->idf_host_, &config, &handle);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Adding SPI device (mode %u, %u Hz) failed: %s", mode, data_rate, esp_err_to_name(err));
+    return nullptr;
+  }
+  this->idf_last_device_ = this->idf_devices_.size();
+  this->idf_devices_.push_back(IDFDevice{mode, lsb_first, data_rate, handle});
+  return handle;
+}
+void HOT SPIComponent::idf_transfer_(const uint8_t *tx, uint8_t *rx, size_t length) {
+  // the transactions have to be executed in order
+  this->wait_async_writes();
+  if (this->miso_ == nullptr)
+    rx = nullptr;
+  if (this->idf_device_ == nullptr) {
+    if (rx != nullptr)
+      memset(rx, 0, length);
+    return;
+  }
+
+  while (length > 0) {
+    const size_t size = std::min(length, IDF_MAX_TRANSFER_SIZE);
+    spi_transaction_t transaction{};
+    transaction.length = size * 8;
+    if (size <= 4) {
+      // short transfers go through the registers, which avoids a DMA setup
+      transaction.flags = SPI_TRANS_USE_TXDATA | (rx != nullptr ? SPI_TRANS_USE_RXDATA : 0);
+      if (tx != nullptr)
+        memcpy(transaction.tx_data, tx, size);
+    } else {
+      transaction.tx_buffer = tx;
+      transaction.rx_buffer = rx;
+    }
+    esp_err_t err = spi_device_polling_transmit(this->idf_device_, &transaction);
+    if (err != ESP_OK) {
+      ESP_LOGW(TAG, "SPI transaction failed: %s", esp_err_to_name(err));
+      if (rx != nullptr)
+        memset(rx, 0, length);
+      return;
+    }
+    if (size <= 4 && rx != nullptr)
+      memcpy(rx, transaction.rx_data, size);
+
+    length -= size;
+    if (tx != nullptr)
+      tx += size;
+    if (rx != nullptr)
+      rx += size;
+  }
+}
+void SPIComponent::idf_transfer_in_place_(uint8_t *data, size_t length) {
+  // DMA can't send and receive from the same buffer, so go through a copy
+  uint8_t tx[64];
+  while (length > 0) {
+    const size_t size = std::min(length, sizeof(tx));
+    memcpy(tx, data, size);
+    this->idf_transfer_(tx, data, size);
+    data += size;
+    length -= size;
+  }
+}
+void HOT SPIComponent::idf_queue_write_(const uint8_t *data, size_t length) {
+  if (this->idf_device_ == nullptr)
+    return;
+  while (length > 0) {
+    const size_t size = std::min(length, IDF_MAX_TRANSFER_SIZE);
+    if (this->idf_pending_ == 2)
+      this->idf_wait_oldest_();
+
+    spi_transaction_t &transaction = this->idf_transactions_[this->idf_next_transaction_];
+    transaction = spi_transaction_t{};
+    transaction.length = size * 8;
+    transaction.tx_buffer = data;
+    esp_err_t err = spi_device_queue_trans(this->idf_device_, &transaction, portMAX_DELAY);
+    if (err != ESP_OK) {
+      ESP_LOGW(TAG, "Queuing SPI transaction failed: %s", esp_err_to_name(err));
+      return;
+    }
+    this->idf_next_transaction_ ^= 1;
+    this->idf_pending_++;
+
+    data += size;
+    length -= size;
+  }
+  // only the last transaction may still be running when we return, see write_array_async()
+  if (this->idf_pending_ == 2)
+    this->idf_wait_oldest_();
+}
+void SPIComponent::idf_wait_oldest_() {
+  spi_transaction_t *transaction;
+  spi_device_get_trans_result(this->idf_device_, &transaction, portMAX_DELAY);
+  this->idf_pending_--;
 }
+#endif  // USE_SPI_ESP_IDF_BACKEND
 float SPIComponent::get_setup_priority() const { return setup_priority::BUS; }
 
 void SPIComponent::cycle_clock_(bool value) {
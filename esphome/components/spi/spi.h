@@ -2,16 +2,26 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include <array>
+#include <cstring>
 #include <vector>
 
 #ifdef USE_ARDUINO
 #define USE_SPI_ARDUINO_BACKEND
 #endif
 
+#ifdef USE_ESP_IDF
+#define USE_SPI_ESP_IDF_BACKEND
+#endif
+
 #ifdef USE_SPI_ARDUINO_BACKEND
 #include <SPI.h>
 #endif
 
+#ifdef USE_SPI_ESP_IDF_BACKEND
+#include <driver/spi_master.h>
+#endif
+
 namespace esphome {
 namespace spi {
 
@@ -69,6 +79,15 @@ enum SPIDataRate : uint32_t {
   DATA_RATE_40MHZ = 40000000,
 };
 
+/// One part of a transfer_segments() transaction.
+struct SPISegment {
+  /// The data to send, nullptr sends zeros.
+  const uint8_t *tx;
+  /// Where the received data is stored, nullptr discards it.
+  uint8_t *rx;
+  size_t length;
+};
+
 class SPIComponent : public Component {
  public:
   void set_clk(GPIOPin *clk) { clk_ = clk; }
@@ -85,6 +104,13 @@ class SPIComponent : public Component {
       return this->hw_spi_->transfer(0x00);
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_host_ready_) {
+      uint8_t data;
+      this->idf_transfer_(nullptr, &data, 1);
+      return data;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     return this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, true, false>(0x00);
   }
 
@@ -96,6 +122,12 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_host_ready_) {
+      this->idf_transfer_(nullptr, data, length);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     for (size_t i = 0; i < length; i++) {
       data[i] = this->read_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>();
     }
@@ -109,6 +141,12 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_host_ready_) {
+      this->idf_transfer_(&data, nullptr, 1);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, false, true>(data);
   }
 
@@ -120,6 +158,13 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_host_ready_) {
+      const uint8_t bytes[2] = {uint8_t(data >> 8), uint8_t(data)};
+      this->idf_transfer_(bytes, nullptr, 2);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
 
     this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data >> 8);
     this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data);
@@ -149,6 +194,12 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_host_ready_) {
+      this->idf_transfer_(data, nullptr, length);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     for (size_t i = 0; i < length; i++) {
       this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data[i]);
     }
@@ -165,6 +216,13 @@ class SPIComponent : public Component {
       }
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_host_ready_ && this->miso_ != nullptr) {
+      uint8_t in_data;
+      this->idf_transfer_(&data, &in_data, 1);
+      return in_data;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
     this->write_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data);
     return 0;
   }
@@ -181,18 +239,96 @@ class SPIComponent : public Component {
       return;
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_host_ready_) {
+      this->idf_transfer_in_place_(data, length);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
 
     if (this->miso_ != nullptr) {
       for (size_t i = 0; i < length; i++) {
-        data[i] = this->transfer_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data[i]);
+        data[i] = this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, true, true>(data[i]);
       }
     } else {
-      this->write_array<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data, length);
+      for (size_t i = 0; i < length; i++) {
+        this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, false, true>(data[i]);
+      }
     }
   }
 
+  /** Run several transfers back to back while the device stays selected.
+   *
+   * Typically a command or register address followed by the data, without per-byte calls and without copying
+   * everything into one buffer first.
+   */
+  template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE>
+  void transfer_segments(const SPISegment *segments, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      const SPISegment &segment = segments[i];
+      uint8_t *rx = this->miso_ != nullptr ? segment.rx : nullptr;
+#ifdef USE_SPI_ESP_IDF_BACKEND
+      if (this->idf_host_ready_) {
+        this->idf_transfer_(segment.tx, rx, segment.length);
+        continue;
+      }
+#endif  // USE_SPI_ESP_IDF_BACKEND
+#ifdef USE_SPI_ARDUINO_BACKEND
+      if (this->hw_spi_ != nullptr) {
+        if (segment.tx == nullptr && rx != nullptr) {
+          memset(rx, 0, segment.length);
+          this->hw_spi_->transfer(rx, segment.length);
+        } else if (rx != nullptr) {
+          this->hw_spi_->transferBytes(segment.tx, rx, segment.length);
+        } else if (segment.tx != nullptr) {
+          this->hw_spi_->writeBytes(const_cast<uint8_t *>(segment.tx), segment.length);
+        } else {
+          for (size_t j = 0; j < segment.length; j++)
+            this->hw_spi_->write(0x00);
+        }
+        continue;
+      }
+#endif  // USE_SPI_ARDUINO_BACKEND
+      for (size_t j = 0; j < segment.length; j++) {
+        const uint8_t out = segment.tx != nullptr ? segment.tx[j] : 0x00;
+        if (rx != nullptr) {
+          rx[j] = this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, true, true>(out);
+        } else {
+          this->transfer_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, false, true>(out);
+        }
+      }
+    }
+  }
+
+  /** Write `data` in the background where the hardware supports it (ESP-IDF with DMA), otherwise like write_array().
+   *
+   * `data` has to stay valid and unchanged until the next write_array_async() call returns, or until
+   * wait_async_writes() or disable() return. Alternating between two buffers allows preparing the next chunk while
+   * the previous one is still being sent. The bus stays locked to the device until disable(), so other devices only
+   * get it once the writes are done.
+   */
+  template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE>
+  void write_array_async(const uint8_t *data, size_t length) {
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_host_ready_) {
+      this->idf_queue_write_(data, length);
+      return;
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
+    this->write_array<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data, length);
+  }
+
+  /// Wait until all writes started with write_array_async() are finished.
+  void wait_async_writes();
+
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, uint32_t DATA_RATE>
   void enable(GPIOPin *cs) {
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    if (this->idf_host_ready_) {
+      this->idf_enable_(uint8_t(CLOCK_POLARITY) << 1 | uint8_t(CLOCK_PHASE), DATA_RATE,
+                        BIT_ORDER == BIT_ORDER_LSB_FIRST);
+    } else {
+#endif  // USE_SPI_ESP_IDF_BACKEND
 #ifdef USE_SPI_ARDUINO_BACKEND
     if (this->hw_spi_ != nullptr) {
       uint8_t data_mode = SPI_MODE0;
@@ -208,11 +344,17 @@ class SPIComponent : public Component {
     } else {
 #endif  // USE_SPI_ARDUINO_BACKEND
       this->clk_->digital_write(CLOCK_POLARITY);
-      uint32_t cpu_freq_hz = arch_get_cpu_freq_hz();
-      this->wait_cycle_ = uint32_t(cpu_freq_hz) / DATA_RATE / 2ULL;
+      if (this->wait_cycle_rate_ != DATA_RATE) {
+        uint32_t cpu_freq_hz = arch_get_cpu_freq_hz();
+        this->wait_cycle_ = uint32_t(cpu_freq_hz) / DATA_RATE / 2ULL;
+        this->wait_cycle_rate_ = DATA_RATE;
+      }
 #ifdef USE_SPI_ARDUINO_BACKEND
     }
 #endif  // USE_SPI_ARDUINO_BACKEND
+#ifdef USE_SPI_ESP_IDF_BACKEND
+    }
+#endif  // USE_SPI_ESP_IDF_BACKEND
 
     if (cs != nullptr) {
       this->active_cs_ = cs;
@@ -230,6 +372,45 @@ class SPIComponent : public Component {
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, bool READ, bool WRITE>
   uint8_t transfer_(uint8_t data);
 
+  /// Whether the bus pins can be used with the SPI peripheral (internal and not inverted).
+  bool can_use_hw_spi_() const;
+
+#ifdef USE_SPI_ESP_IDF_BACKEND
+  struct IDFDevice {
+    uint8_t mode;
+    bool lsb_first;
+    uint32_t data_rate;
+    spi_device_handle_t handle;
+  };
+
+  /// Set up the SPI peripheral with DMA, false if none is left or the bus can't be initialized.
+  bool setup_idf_();
+  /// Select and lock the bus for the driver device for mode/data rate/bit order, they are added on first use.
+  void idf_enable_(uint8_t mode, uint32_t data_rate, bool lsb_first);
+  spi_device_handle_t idf_add_device_(uint8_t mode, uint32_t data_rate, bool lsb_first);
+  /** Blocking full-duplex transfer, either buffer may be nullptr.
+   *
+   * Once the bus uses the SPI peripheral its pins aren't GPIOs anymore, so transfers without a driver device (it
+   * couldn't be added) or that fail are dropped and read zeros instead of falling back to bit-banging.
+   */
+  void idf_transfer_(const uint8_t *tx, uint8_t *rx, size_t length);
+  void idf_transfer_in_place_(uint8_t *data, size_t length);
+  void idf_queue_write_(const uint8_t *data, size_t length);
+  void idf_wait_oldest_();
+
+  bool idf_host_ready_{false};
+  spi_host_device_t idf_host_;
+  std::vector<IDFDevice> idf_devices_;
+  /// The driver device selected by enable(), nullptr outside of enable()/disable().
+  spi_device_handle_t idf_device_{nullptr};
+  /// Index of the device of the last enable(), devices that talk repeatedly are found without a search.
+  size_t idf_last_device_{0};
+  /// Ring of transactions used by write_array_async().
+  spi_transaction_t idf_transactions_[2];
+  uint8_t idf_next_transaction_{0};
+  uint8_t idf_pending_{0};
+#endif  // USE_SPI_ESP_IDF_BACKEND
+
   GPIOPin *clk_;
   GPIOPin *miso_{nullptr};
   GPIOPin *mosi_{nullptr};
@@ -238,6 +419,8 @@ class SPIComponent : public Component {
   SPIClass *hw_spi_{nullptr};
 #endif  // USE_SPI_ARDUINO_BACKEND
   uint32_t wait_cycle_;
+  /// The data rate wait_cycle_ was calculated for.
+  uint32_t wait_cycle_rate_{0};
 };
 
 template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, SPIDataRate DATA_RATE>
@@ -290,6 +473,12 @@ class SPIDevice {
 
   template<size_t N> void write_array(const std::array<uint8_t, N> &data) { this->write_array(data.data(), N); }
 
+  void write_array_async(const uint8_t *data, size_t length) {
+    this->parent_->template write_array_async<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data, length);
+  }
+
+  void wait_async_writes() { this->parent_->wait_async_writes(); }
+
   void write_array(const std::vector<uint8_t> &data) { this->write_array(data.data(), data.size()); }
 
   uint8_t transfer_byte(uint8_t data) {
@@ -302,6 +491,14 @@ class SPIDevice {
 
   template<size_t N> void transfer_array(std::array<uint8_t, N> &data) { this->transfer_array(data.data(), N); }
 
+  void transfer_segments(const SPISegment *segments, size_t count) {
+    this->parent_->template transfer_segments<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(segments, count);
+  }
+
+  template<size_t N> void transfer_segments(const std::array<SPISegment, N> &segments) {
+    this->transfer_segments(segments.data(), N);
+  }
+
  protected:
   SPIComponent *parent_{nullptr};
   GPIOPin *cs_{nullptr};
@@ -147,26 +147,33 @@ void SSD1306::display() {
     return;
   }
 
-  this->command(SSD1306_COMMAND_COLUMN_ADDRESS);
+  const uint8_t column = this->column_offset_();
+  const uint8_t commands[] = {
+      SSD1306_COMMAND_COLUMN_ADDRESS,
+      column,
+      uint8_t(column + this->get_width_internal() - 1),
+      SSD1306_COMMAND_PAGE_ADDRESS,
+      0,  // Page start address
+      uint8_t(this->get_height_internal() / 8 - 1),
+  };
+  this->send_commands_(commands, sizeof(commands));
+
+  this->write_display_data();
+}
+void SSD1306::send_commands_(const uint8_t *commands, size_t len) {
+  for (size_t i = 0; i < len; i++)
+    this->command(commands[i]);
+}
+uint8_t SSD1306::column_offset_() const {
+  if (this->is_sh1106_())
+    return 2;  // the SH1106 has 132 columns and shows the middle 128
   switch (this->model_) {
     case SSD1306_MODEL_64_48:
     case SSD1306_MODEL_64_32:
-      this->command(0x20 + this->offset_x_);
-      this->command(0x20 + this->offset_x_ + this->get_width_internal() - 1);
-      break;
+      return 0x20 + this->offset_x_;
     default:
-      this->command(0 + this->offset_x_);  // Page start address, 0
-      this->command(this->get_width_internal() + this->offset_x_ - 1);
-      break;
+      return this->offset_x_;
   }
-
-  this->command(SSD1306_COMMAND_PAGE_ADDRESS);
-  // Page start address, 0
-  this->command(0);
-  // Page end address:
-  this->command((this->get_height_internal() / 8) - 1);
-
-  this->write_display_data();
 }
 bool SSD1306::is_sh1106_() const {
   return this->model_ == SH1106_MODEL_96_16 || this->model_ == SH1106_MODEL_128_32 ||
@@ -176,7 +183,8 @@ bool SSD1306::is_ssd1305_() const {
   return this->model_ == SSD1305_MODEL_128_64 || this->model_ == SSD1305_MODEL_128_64;
 }
 void SSD1306::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->display();
 }
 void SSD1306::set_contrast(float contrast) {
@@ -263,10 +271,34 @@ void HOT SSD1306::draw_absolute_pixel_internal(int x, int y, Color color) {
     this->buffer_[pos] &= ~(1 << subpos);
   }
 }
+void HOT SSD1306::fill_span_internal(int x, int y, int width, Color color) {
+  // a row is the same bit in consecutive bytes of one page
+  uint8_t *dst = this->buffer_ + x + (y / 8) * this->get_width_internal();
+  const uint8_t mask = 1 << (y & 0x07);
+  if (color.is_on()) {
+    for (int i = 0; i < width; i++)
+      dst[i] |= mask;
+  } else {
+    for (int i = 0; i < width; i++)
+      dst[i] &= ~mask;
+  }
+}
+void HOT SSD1306::blit_internal(int x, int y, int width, const Color *colors) {
+  uint8_t *dst = this->buffer_ + x + (y / 8) * this->get_width_internal();
+  const uint8_t mask = 1 << (y & 0x07);
+  for (int i = 0; i < width; i++) {
+    if (colors[i].is_on()) {
+      dst[i] |= mask;
+    } else {
+      dst[i] &= ~mask;
+    }
+  }
+}
 void SSD1306::fill(Color color) {
   uint8_t fill = color.is_on() ? 0xFF : 0x00;
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
     this->buffer_[i] = fill;
+  this->mark_all_dirty_();
 }
 void SSD1306::init_reset_() {
   if (this->reset_pin_ != nullptr) {
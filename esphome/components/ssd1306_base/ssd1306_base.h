@@ -50,13 +50,19 @@ class SSD1306 : public PollingComponent, public display::DisplayBuffer {
 
  protected:
   virtual void command(uint8_t value) = 0;
+  /// Send several commands, buses that can send them in one transfer override this.
+  virtual void send_commands_(const uint8_t *commands, size_t len);
   virtual void write_display_data() = 0;
   void init_reset_();
+  /// The controller column that shows x = 0.
+  uint8_t column_offset_() const;
 
   bool is_sh1106_() const;
   bool is_ssd1305_() const;
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_internal(int x, int y, int width, const Color *colors) override;
 
   int get_height_internal() override;
   int get_width_internal() override;
@@ -1,11 +1,22 @@
 #include "ssd1306_i2c.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace ssd1306_i2c {
 
 static const char *const TAG = "ssd1306_i2c";
 
+#ifdef USE_ARDUINO
+// The Wire libraries buffer 128 bytes per transaction, one of them is the control byte
+static const size_t MAX_DATA_PER_TRANSFER = 127;
+#else
+// A whole page of the largest models
+static const size_t MAX_DATA_PER_TRANSFER = 128;
+#endif
+
 void I2CSSD1306::setup() {
   ESP_LOGCONFIG(TAG, "Setting up I2C SSD1306...");
   this->init_reset_();
@@ -18,6 +29,15 @@ void I2CSSD1306::setup() {
   }
 
   SSD1306::setup();
+  if (this->is_failed())
+    return;
+
+  // the copy is optional: without it the whole buffer is sent on every update
+  const size_t len = this->get_buffer_length_();
+  if (ram_policy_max_allocation(RAMPolicy::BULK) >= len)
+    this->shown_ = static_cast<uint8_t *>(ram_allocate(RAMPolicy::BULK, len));
+  if (this->shown_ == nullptr)
+    ESP_LOGW(TAG, "Not enough memory to track display changes, sending the whole display on every update");
 }
 void I2CSSD1306::dump_config() {
   LOG_DISPLAY("", "I2C SSD1306", this);
@@ -37,30 +57,61 @@ void I2CSSD1306::dump_config() {
   }
 }
 void I2CSSD1306::command(uint8_t value) { this->write_byte(0x00, value); }
+void I2CSSD1306::send_commands_(const uint8_t *commands, size_t len) {
+  // a control byte without the continuation bit, all following bytes are commands
+  this->write_register(0x00, commands, len);
+}
 void HOT I2CSSD1306::write_display_data() {
-  if (this->is_sh1106_()) {
-    uint32_t i = 0;
-    for (uint8_t page = 0; page < (uint8_t) this->get_height_internal() / 8; page++) {
-      this->command(0xB0 + page);  // row
-      this->command(0x02);         // lower column
-      this->command(0x10);         // higher column
+  const uint8_t width = this->get_width_internal();
+  const uint8_t pages = this->get_height_internal() / 8;
+  // nothing is known about the display memory until the whole buffer was sent once
+  const bool send_all = this->shown_ == nullptr || !this->shown_valid_;
+  if (this->shown_ != nullptr && send_all) {
+    memcpy(this->shown_, this->buffer_, this->get_buffer_length_());
+    this->shown_valid_ = true;
+  }
 
-      for (uint8_t x = 0; x < (uint8_t) this->get_width_internal() / 16; x++) {
-        uint8_t data[16];
-        for (uint8_t &j : data)
-          j = this->buffer_[i++];
-        this->write_bytes(0x40, data, sizeof(data));
-      }
+  for (uint8_t page = 0; page < pages; page++) {
+    const uint8_t *data = this->buffer_ + page * width;
+    uint8_t x1 = 0;
+    uint8_t x2 = width - 1;
+    if (!send_all) {
+      uint8_t *shown = this->shown_ + page * width;
+      while (x1 < width && data[x1] == shown[x1])
+        x1++;
+      if (x1 == width)
+        continue;
+      while (data[x2] == shown[x2])
+        x2--;
+      memcpy(shown + x1, data + x1, x2 - x1 + 1);
     }
-  } else {
-    for (uint32_t i = 0; i < this->get_buffer_length_();) {
-      uint8_t data[16];
-      for (uint8_t &j : data)
-        j = this->buffer_[i++];
-      this->write_bytes(0x40, data, sizeof(data));
+    if (!this->write_page_span_(page, x1, x2)) {
+      // send everything again next time
+      this->shown_valid_ = false;
+      return;
     }
   }
 }
+bool I2CSSD1306::write_page_span_(uint8_t page, uint8_t x1, uint8_t x2) {
+  const uint8_t column = this->column_offset_() + x1;
+  if (this->is_sh1106_()) {
+    // page addressing mode, the column pointer stays in the page
+    const uint8_t commands[] = {uint8_t(0xB0 + page), uint8_t(0x00 | (column & 0x0F)), uint8_t(0x10 | (column >> 4))};
+    this->send_commands_(commands, sizeof(commands));
+  } else {
+    // column address and page address, the window is just this span
+    const uint8_t commands[] = {0x21, column, uint8_t(column + x2 - x1), 0x22, page, page};
+    this->send_commands_(commands, sizeof(commands));
+  }
+
+  const uint8_t *data = this->buffer_ + page * this->get_width_internal();
+  for (size_t x = x1; x <= x2; x += MAX_DATA_PER_TRANSFER) {
+    const size_t len = std::min<size_t>(MAX_DATA_PER_TRANSFER, x2 - x + 1);
+    if (this->write_register(0x40, data + x, len) != i2c::ERROR_OK)
+      return false;
+  }
+  return true;
+}
 
 }  // namespace ssd1306_i2c
 }  // namespace esphome
@@ -83,15 +83,22 @@ void SSD1327::setup() {
   this->turn_on();           // display ON
 }
 void SSD1327::display() {
-  this->command(SSD1327_SETCOLUMNADDRESS);  // set column address
-  this->command(0x00);                      // set column start address
-  this->command(0x3F);                      // set column end address
-  this->command(SSD1327_SETROWADDRESS);     // set row address
-  this->command(0x00);                      // set row start address
-  this->command(127);                       // set last row
+  const uint8_t commands[] = {
+      SSD1327_SETCOLUMNADDRESS,  // set column address
+      0x00,                      // set column start address
+      0x3F,                      // set column end address
+      SSD1327_SETROWADDRESS,     // set row address
+      0x00,                      // set row start address
+      127,                       // set last row
+  };
+  this->send_commands_(commands, sizeof(commands));
 
   this->write_display_data();
 }
+void SSD1327::send_commands_(const uint8_t *commands, size_t len) {
+  for (size_t i = 0; i < len; i++)
+    this->command(commands[i]);
+}
 void SSD1327::update() {
   if (!this->is_failed()) {
     this->do_update_();
@@ -32,6 +32,8 @@ class SSD1327 : public PollingComponent, public display::DisplayBuffer {
 
  protected:
   virtual void command(uint8_t value) = 0;
+  /// Send several commands, buses that can send them in one transfer override this.
+  virtual void send_commands_(const uint8_t *commands, size_t len);
   virtual void write_display_data() = 0;
   void init_reset_();
 
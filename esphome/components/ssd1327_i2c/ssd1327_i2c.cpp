@@ -1,11 +1,22 @@
 #include "ssd1327_i2c.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace ssd1327_i2c {
 
 static const char *const TAG = "ssd1327_i2c";
 
+#ifdef USE_ARDUINO
+// The Wire libraries buffer 128 bytes per transaction, one of them is the control byte
+static const size_t MAX_DATA_PER_TRANSFER = 127;
+#else
+static const size_t MAX_DATA_PER_TRANSFER = 1024;
+#endif
+static const size_t MAX_ROWS_PER_TRANSFER = 16;
+
 void I2CSSD1327::setup() {
   ESP_LOGCONFIG(TAG, "Setting up I2C SSD1327...");
   this->init_reset_();
@@ -18,6 +29,15 @@ void I2CSSD1327::setup() {
   }
 
   SSD1327::setup();
+  if (this->is_failed())
+    return;
+
+  // the copy is optional: without it the whole buffer is sent on every update
+  const size_t len = this->get_buffer_length_();
+  if (ram_policy_max_allocation(RAMPolicy::BULK) >= len)
+    this->shown_ = static_cast<uint8_t *>(ram_allocate(RAMPolicy::BULK, len));
+  if (this->shown_ == nullptr)
+    ESP_LOGW(TAG, "Not enough memory to track display changes, sending the whole display on every update");
 }
 void I2CSSD1327::dump_config() {
   LOG_DISPLAY("", "I2C SSD1327", this);
@@ -31,13 +51,85 @@ void I2CSSD1327::dump_config() {
   }
 }
 void I2CSSD1327::command(uint8_t value) { this->write_byte(0x00, value); }
+void I2CSSD1327::send_commands_(const uint8_t *commands, size_t len) {
+  // a control byte without the continuation bit, all following bytes are commands
+  this->write_register(0x00, commands, len);
+}
 void HOT I2CSSD1327::write_display_data() {
-  for (uint32_t i = 0; i < this->get_buffer_length_();) {
-    uint8_t data[16];
-    for (uint8_t &j : data)
-      j = this->buffer_[i++];
-    this->write_bytes(0x40, data, sizeof(data));
+  const uint8_t row_bytes = this->get_width_internal() / 2;
+  const uint8_t rows = this->get_height_internal();
+  // nothing is known about the display memory until the whole buffer was sent once
+  if (this->shown_ == nullptr || !this->shown_valid_) {
+    if (this->shown_ != nullptr)
+      memcpy(this->shown_, this->buffer_, this->get_buffer_length_());
+    this->shown_valid_ = this->write_window_(0, row_bytes - 1, 0, rows - 1);
+    return;
+  }
+
+  // consecutive changed rows are sent as one window, spanning the changed bytes of all of them
+  int run_start = -1;
+  uint8_t x1 = 0;
+  uint8_t x2 = 0;
+  for (int row = 0; row <= rows; row++) {
+    uint8_t first = row_bytes;
+    uint8_t last = 0;
+    if (row < rows) {
+      const uint8_t *data = this->buffer_ + row * row_bytes;
+      uint8_t *shown = this->shown_ + row * row_bytes;
+      while (first < row_bytes && data[first] == shown[first])
+        first++;
+      if (first < row_bytes) {
+        last = row_bytes - 1;
+        while (data[last] == shown[last])
+          last--;
+        memcpy(shown + first, data + first, last - first + 1);
+      }
+    }
+    if (first < row_bytes) {
+      if (run_start < 0) {
+        run_start = row;
+        x1 = first;
+        x2 = last;
+      } else {
+        x1 = std::min(x1, first);
+        x2 = std::max(x2, last);
+      }
+      continue;
+    }
+    if (run_start < 0)
+      continue;
+    if (!this->write_window_(x1, x2, run_start, row - 1)) {
+      // send everything again next time
+      this->shown_valid_ = false;
+      return;
+    }
+    run_start = -1;
+  }
+}
+bool I2CSSD1327::write_window_(uint8_t x1, uint8_t x2, uint8_t y1, uint8_t y2) {
+  // column address (in bytes of two pixels) and row address
+  const uint8_t commands[] = {0x15, x1, x2, 0x75, y1, y2};
+  this->send_commands_(commands, sizeof(commands));
+
+  // the rows of the window are only contiguous in the buffer if it's as wide as the display, collect them with writev
+  const uint8_t control = 0x40;
+  const size_t row_bytes = this->get_width_internal() / 2;
+  const size_t width = x2 - x1 + 1;
+  i2c::WriteBuffer buffers[MAX_ROWS_PER_TRANSFER + 1];
+  buffers[0] = {&control, 1};
+  size_t count = 1;
+  size_t len = 0;
+  for (size_t row = y1; row <= y2; row++) {
+    if (len + width > MAX_DATA_PER_TRANSFER || count > MAX_ROWS_PER_TRANSFER) {
+      if (this->bus_->writev(this->address_, buffers, count) != i2c::ERROR_OK)
+        return false;
+      count = 1;
+      len = 0;
+    }
+    buffers[count++] = {this->buffer_ + row * row_bytes + x1, width};
+    len += width;
   }
+  return this->bus_->writev(this->address_, buffers, count) == i2c::ERROR_OK;
 }
 
 }  // namespace ssd1327_i2c
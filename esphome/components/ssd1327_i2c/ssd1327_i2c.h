@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/ssd1327_base/ssd1327_base.h"
 #include "esphome/components/i2c/i2c.h"
 
@@ -14,7 +15,16 @@ class I2CSSD1327 : public ssd1327_base::SSD1327, public i2c::I2CDevice {
 
  protected:
   void command(uint8_t value) override;
+  void send_commands_(const uint8_t *commands, size_t len) override;
   void write_display_data() override;
+  /// Send the bytes x1 to x2 (inclusive) of the rows y1 to y2.
+  bool write_window_(uint8_t x1, uint8_t x2, uint8_t y1, uint8_t y2);
+
+  /// What the display shows, only the rows (and the bytes within them) that differ from the buffer are sent.
+  /// nullptr if there wasn't enough memory for it, then the whole buffer is sent on every update.
+  uint8_t *shown_{nullptr};
+  /// Whether shown_ matches the display memory, false until the whole buffer was sent once (and after errors).
+  bool shown_valid_{false};
 
   enum ErrorCode { NONE = 0, COMMUNICATION_FAILED } error_code_{NONE};
 };
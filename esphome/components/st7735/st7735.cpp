@@ -292,7 +292,8 @@ void ST7735::setup() {
 }
 
 void ST7735::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->write_display_data_();
 }
 
@@ -323,6 +324,40 @@ void HOT ST7735::draw_absolute_pixel_internal(int x, int y, Color color) {
   }
 }
 
+void HOT ST7735::fill_span_internal(int x, int y, int width, Color color) {
+  if (this->eightbitcolor_) {
+    memset(this->buffer_ + x + y * this->get_width_internal(), display::ColorUtil::color_to_332(color), width);
+    return;
+  }
+  const uint16_t color565 = display::ColorUtil::color_to_565(color);
+  const uint8_t high = color565 >> 8;
+  const uint8_t low = color565 & 0xff;
+  uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * 2;
+  if (high == low) {
+    memset(dst, high, width * 2);
+    return;
+  }
+  for (int i = 0; i < width; i++) {
+    *dst++ = high;
+    *dst++ = low;
+  }
+}
+
+void HOT ST7735::blit_internal(int x, int y, int width, const Color *colors) {
+  if (this->eightbitcolor_) {
+    uint8_t *dst = this->buffer_ + x + y * this->get_width_internal();
+    for (int i = 0; i < width; i++)
+      dst[i] = display::ColorUtil::color_to_332(colors[i]);
+    return;
+  }
+  uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * 2;
+  for (int i = 0; i < width; i++) {
+    const uint16_t color565 = display::ColorUtil::color_to_565(colors[i]);
+    *dst++ = color565 >> 8;
+    *dst++ = color565 & 0xff;
+  }
+}
+
 void ST7735::init_reset_() {
   if (this->reset_pin_ != nullptr) {
     this->reset_pin_->setup();
@@ -418,13 +453,20 @@ void HOT ST7735::senddata_(const uint8_t *data_bytes, uint8_t num_data_bytes) {
 }
 
 void HOT ST7735::write_display_data_() {
+  // only send the regions that changed since the last update
+  for (uint8_t i = 0; i < this->dirty_region_count_; i++)
+    this->write_region_(this->dirty_regions_[i]);
+  this->clear_dirty_regions_();
+}
+
+void HOT ST7735::write_region_(const display::DisplayRegion &region) {
   uint16_t offsetx = colstart_;
   uint16_t offsety = rowstart_;
 
-  uint16_t x1 = offsetx;
-  uint16_t x2 = x1 + get_width_internal() - 1;
-  uint16_t y1 = offsety;
-  uint16_t y2 = y1 + get_height_internal() - 1;
+  uint16_t x1 = offsetx + region.x1;
+  uint16_t x2 = offsetx + region.x2;
+  uint16_t y1 = offsety + region.y1;
+  uint16_t y2 = offsety + region.y2;
 
   this->enable();
 
@@ -446,8 +488,9 @@ void HOT ST7735::write_display_data_() {
   this->dc_pin_->digital_write(true);
 
   if (this->eightbitcolor_) {
-    for (size_t line = 0; line < this->get_buffer_length(); line = line + this->get_width_internal()) {
-      for (int index = 0; index < this->get_width_internal(); ++index) {
+    for (int row = region.y1; row <= region.y2; row++) {
+      const size_t line = size_t(row) * this->get_width_internal();
+      for (int index = region.x1; index <= region.x2; ++index) {
         auto color332 = display::ColorUtil::to_color(this->buffer_[index + line], display::ColorOrder::COLOR_ORDER_RGB,
                                                      display::ColorBitness::COLOR_BITNESS_332, true);
 
@@ -457,8 +500,14 @@ void HOT ST7735::write_display_data_() {
         this->write_byte(color & 0xff);
       }
     }
+  } else if (region.width() == this->get_width_internal()) {
+    // full rows are contiguous in the buffer
+    this->write_array(this->buffer_ + size_t(region.y1) * this->get_width_internal() * 2, region.area() * 2);
   } else {
-    this->write_array(this->buffer_, this->get_buffer_length());
+    for (int row = region.y1; row <= region.y2; row++) {
+      this->write_array(this->buffer_ + (size_t(row) * this->get_width_internal() + region.x1) * 2,
+                        region.width() * 2);
+    }
   }
   this->disable();
 }
@@ -66,8 +66,11 @@ class ST7735 : public PollingComponent,
   void display_init_(const uint8_t *addr);
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_internal(int x, int y, int width, const Color *colors) override;
   void spi_master_write_addr_(uint16_t addr1, uint16_t addr2);
   void spi_master_write_color_(uint16_t color, uint16_t size);
+  void write_region_(const display::DisplayRegion &region);
 
   int get_width_internal() override;
   int get_height_internal() override;
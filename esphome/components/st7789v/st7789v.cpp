@@ -127,17 +127,25 @@ void ST7789V::dump_config() {
 float ST7789V::get_setup_priority() const { return setup_priority::PROCESSOR; }
 
 void ST7789V::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->write_display_data();
 }
 
 void ST7789V::loop() {}
 
 void ST7789V::write_display_data() {
-  uint16_t x1 = 52;   // _offsetx
-  uint16_t x2 = 186;  // _offsetx
-  uint16_t y1 = 40;   // _offsety
-  uint16_t y2 = 279;  // _offsety
+  // only send the regions that changed since the last update
+  for (uint8_t i = 0; i < this->dirty_region_count_; i++)
+    this->write_region_(this->dirty_regions_[i]);
+  this->clear_dirty_regions_();
+}
+
+void ST7789V::write_region_(const display::DisplayRegion &region) {
+  uint16_t x1 = 52 + region.x1;  // _offsetx
+  uint16_t x2 = 52 + region.x2;  // _offsetx
+  uint16_t y1 = 40 + region.y1;  // _offsety
+  uint16_t y2 = 40 + region.y2;  // _offsety
 
   this->enable();
 
@@ -156,7 +164,13 @@ void ST7789V::write_display_data() {
   this->write_byte(ST7789_RAMWR);
   this->dc_pin_->digital_write(true);
 
-  this->write_array(this->buffer_, this->get_buffer_length_());
+  if (region.width() == this->get_width_internal()) {
+    // full rows are contiguous in the buffer
+    this->write_array(this->buffer_ + region.y1 * this->get_width_internal() * 2, region.area() * 2);
+  } else {
+    for (int row = region.y1; row <= region.y2; row++)
+      this->write_array(this->buffer_ + (row * this->get_width_internal() + region.x1) * 2, region.width() * 2);
+  }
 
   this->disable();
 }
@@ -270,5 +284,29 @@ void HOT ST7789V::draw_absolute_pixel_internal(int x, int y, Color color) {
   this->buffer_[pos] = color565 & 0xff;
 }
 
+void HOT ST7789V::fill_span_internal(int x, int y, int width, Color color) {
+  const uint16_t color565 = display::ColorUtil::color_to_565(color);
+  const uint8_t high = color565 >> 8;
+  const uint8_t low = color565 & 0xff;
+  uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * 2;
+  if (high == low) {
+    memset(dst, high, width * 2);
+    return;
+  }
+  for (int i = 0; i < width; i++) {
+    *dst++ = high;
+    *dst++ = low;
+  }
+}
+
+void HOT ST7789V::blit_internal(int x, int y, int width, const Color *colors) {
+  uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * 2;
+  for (int i = 0; i < width; i++) {
+    const uint16_t color565 = display::ColorUtil::color_to_565(colors[i]);
+    *dst++ = color565 >> 8;
+    *dst++ = color565 & 0xff;
+  }
+}
+
 }  // namespace st7789v
 }  // namespace esphome
@@ -137,6 +137,7 @@ class ST7789V : public PollingComponent,
   void write_data_(uint8_t value);
   void write_addr_(uint16_t addr1, uint16_t addr2);
   void write_color_(uint16_t color, uint16_t size);
+  void write_region_(const display::DisplayRegion &region);
 
   int get_height_internal() override;
   int get_width_internal() override;
@@ -145,6 +146,8 @@ class ST7789V : public PollingComponent,
   void draw_filled_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_internal(int x, int y, int width, const Color *colors) override;
 };
 
 }  // namespace st7789v
@@ -47,5 +47,22 @@ int32_t Stepper::should_step_() {
   return 0;
 }
 
+StepProfile Stepper::compute_step_profile_(uint32_t tick_us) const {
+  // 2^32 phase units are one step
+  const double phase_per_step = 4294967296.0;
+  const float tick_s = tick_us * 1e-6f;
+  auto to_phase = [phase_per_step](float value) -> uint32_t {
+    // At most a step every other tick, the step pulse needs one tick to go low again. Below 2^31 so that the speed
+    // can't skip an overflow of the phase, in double because a float would round the bound up to 2^31.
+    return static_cast<uint32_t>(clamp(value * phase_per_step, 1.0, phase_per_step / 2 - 1));
+  };
+
+  StepProfile profile;
+  profile.max_speed = to_phase(this->max_speed_ * tick_s);
+  profile.acceleration = to_phase(this->acceleration_ * tick_s * tick_s);
+  profile.deceleration = to_phase(this->deceleration_ * tick_s * tick_s);
+  return profile;
+}
+
 }  // namespace stepper
 }  // namespace esphome
@@ -12,6 +12,25 @@ namespace stepper {
   ESP_LOGCONFIG(TAG, "  Deceleration: %.0f steps/s^2", this->deceleration_); \
   ESP_LOGCONFIG(TAG, "  Max Speed: %.0f steps/s", this->max_speed_);
 
+/** Integer speed profile for generating steps from a timer interrupt with a fixed tick interval.
+ *
+ * Speeds are phase increments per tick, a step is due whenever the 32 bit phase accumulator overflows. So the interrupt
+ * only needs additions, and one multiplication and division per step to know when to start decelerating.
+ */
+struct StepProfile {
+  uint32_t max_speed{0};
+  /// Added to the speed each tick while accelerating.
+  uint32_t acceleration{1};
+  /// Subtracted from the speed each tick while decelerating.
+  uint32_t deceleration{1};
+
+  /// Steps needed to stop from the given speed.
+  uint32_t steps_to_stop(uint32_t speed) const {
+    // 64 bit, 2 * deceleration doesn't fit 32 bits for the largest decelerations
+    return static_cast<uint32_t>(((uint64_t(speed) * speed) >> 32) / (2 * uint64_t(this->deceleration)));
+  }
+};
+
 class Stepper {
  public:
   void set_target(int32_t steps) { this->target_position = steps; }
@@ -28,6 +47,8 @@ class Stepper {
  protected:
   void calculate_speed_(uint32_t now);
   int32_t should_step_();
+  /// The current speed settings for stepping from a timer interrupt that fires every tick_us microseconds.
+  StepProfile compute_step_profile_(uint32_t tick_us) const;
 
   float acceleration_{1e6f};
   float deceleration_{1e6f};
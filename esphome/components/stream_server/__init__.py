@@ -0,0 +1,54 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import uart
+from esphome.const import CONF_BUFFER_SIZE, CONF_ID, CONF_PORT
+
+DEPENDENCIES = ["network", "uart"]
+AUTO_LOAD = ["socket"]
+MULTI_CONF = True
+
+CONF_MAX_CLIENTS = "max_clients"
+CONF_STREAM_SERVER_ID = "stream_server_id"
+
+stream_server_ns = cg.esphome_ns.namespace("stream_server")
+StreamServerComponent = stream_server_ns.class_(
+    "StreamServerComponent", cg.Component, uart.UARTDevice
+)
+
+
+def validate_buffer_size(value):
+    # the positions in the buffer are counters modulo its size, which only stays
+    # consistent across the counter wrapping around for powers of two
+    if value & (value - 1) != 0:
+        raise cv.Invalid("Buffer size must be a power of two")
+    return value
+
+
+CONFIG_SCHEMA = (
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(StreamServerComponent),
+            cv.Optional(CONF_PORT, default=6638): cv.port,
+            cv.Optional(CONF_BUFFER_SIZE, default="1kB"): cv.All(
+                cv.validate_bytes, cv.int_range(min=64, max=65536), validate_buffer_size
+            ),
+            cv.Optional(CONF_MAX_CLIENTS, default=4): cv.int_range(min=1, max=8),
+        }
+    )
+    .extend(cv.COMPONENT_SCHEMA)
+    .extend(uart.UART_DEVICE_SCHEMA)
+)
+
+FINAL_VALIDATE_SCHEMA = uart.final_validate_device_schema(
+    "stream_server", require_tx=True, require_rx=True
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await uart.register_uart_device(var, config)
+
+    cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_buffer_size(config[CONF_BUFFER_SIZE]))
+    cg.add(var.set_max_clients(config[CONF_MAX_CLIENTS]))
@@ -0,0 +1,61 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+)
+from . import CONF_STREAM_SERVER_ID, StreamServerComponent, stream_server_ns
+
+DEPENDENCIES = ["stream_server"]
+
+CONF_UART_RX_BYTES = "uart_rx_bytes"
+CONF_UART_TX_BYTES = "uart_tx_bytes"
+CONF_DROPPED_BYTES = "dropped_bytes"
+CONF_CONNECTED_CLIENTS = "connected_clients"
+
+UNIT_BYTES = "B"
+
+StreamServerSensor = stream_server_ns.class_("StreamServerSensor", cg.PollingComponent)
+
+BYTES_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_BYTES,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_TOTAL_INCREASING,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(StreamServerSensor),
+        cv.GenerateID(CONF_STREAM_SERVER_ID): cv.use_id(StreamServerComponent),
+        cv.Optional(CONF_UART_RX_BYTES): BYTES_SCHEMA,
+        cv.Optional(CONF_UART_TX_BYTES): BYTES_SCHEMA,
+        cv.Optional(CONF_DROPPED_BYTES): BYTES_SCHEMA,
+        cv.Optional(CONF_CONNECTED_CLIENTS): sensor.sensor_schema(
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    parent = await cg.get_variable(config[CONF_STREAM_SERVER_ID])
+    cg.add(var.set_parent(parent))
+
+    for key in [
+        CONF_UART_RX_BYTES,
+        CONF_UART_TX_BYTES,
+        CONF_DROPPED_BYTES,
+        CONF_CONNECTED_CLIENTS,
+    ]:
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, f"set_{key}_sensor")(sens))
@@ -0,0 +1,225 @@
+#include "stream_server.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace esphome {
+namespace stream_server {
+
+static const char *const TAG = "stream_server";
+
+// the most that's written to the UART from one client per loop, writing blocks once the UART's TX buffer is full
+static const size_t MAX_UART_WRITE = 256;
+// at most one warning per client in this time, with the bytes it lost since the previous one
+static const uint32_t DROPPED_WARNING_INTERVAL = 10000;
+
+void StreamServerComponent::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up stream server...");
+  if (ram_policy_max_allocation(RAMPolicy::BULK) < this->buffer_size_) {
+    ESP_LOGE(TAG, "Not enough memory for a buffer of %u bytes", this->buffer_size_);
+    this->mark_failed();
+    return;
+  }
+  this->buffer_.resize(this->buffer_size_);
+
+  this->socket_ = socket::socket(AF_INET, SOCK_STREAM, 0);
+  if (this->socket_ == nullptr) {
+    ESP_LOGW(TAG, "Could not create socket.");
+    this->mark_failed();
+    return;
+  }
+  int enable = 1;
+  int err = this->socket_->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set reuseaddr: errno %d", err);
+    // we can still continue
+  }
+  err = this->socket_->setblocking(false);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", err);
+    this->mark_failed();
+    return;
+  }
+
+  struct sockaddr_in server;
+  memset(&server, 0, sizeof(server));
+  server.sin_family = AF_INET;
+  server.sin_addr.s_addr = ESPHOME_INADDR_ANY;
+  server.sin_port = htons(this->port_);
+
+  err = this->socket_->bind((struct sockaddr *) &server, sizeof(server));
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to bind: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+  err = this->socket_->listen(this->max_clients_);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to listen: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+}
+
+void StreamServerComponent::loop() {
+  this->accept_clients_();
+  this->read_uart_();
+  for (auto &client : this->clients_) {
+    this->write_client_(client.get());
+    this->read_client_(client.get());
+  }
+
+  auto new_end = std::partition(this->clients_.begin(), this->clients_.end(),
+                                [](const std::unique_ptr<Client> &client) { return !client->disconnected; });
+  if (new_end == this->clients_.end())
+    return;
+  this->clients_.erase(new_end, this->clients_.end());
+  if (this->clients_.empty())
+    this->high_freq_.stop();
+}
+
+void StreamServerComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Stream Server:");
+  ESP_LOGCONFIG(TAG, "  Port: %u", this->port_);
+  ESP_LOGCONFIG(TAG, "  Buffer Size: %u bytes", this->buffer_size_);
+  ESP_LOGCONFIG(TAG, "  Max Clients: %u", this->max_clients_);
+}
+
+void StreamServerComponent::on_shutdown() {
+  for (auto &client : this->clients_)
+    client->socket->shutdown(SHUT_RDWR);
+}
+
+void StreamServerComponent::accept_clients_() {
+  while (true) {
+    struct sockaddr_storage source_addr;
+    socklen_t addr_len = sizeof(source_addr);
+    auto sock = this->socket_->accept((struct sockaddr *) &source_addr, &addr_len);
+    if (!sock)
+      break;
+    if (this->clients_.size() >= this->max_clients_) {
+      ESP_LOGW(TAG, "Rejecting %s, maximum number of clients (%u) reached", sock->getpeername().c_str(),
+               this->max_clients_);
+      sock->close();
+      continue;
+    }
+    int err = sock->setblocking(false);
+    if (err != 0) {
+      ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", err);
+      sock->close();
+      continue;
+    }
+    int enable = 1;
+    sock->setsockopt(IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(int));
+    auto client = make_unique<Client>();
+    client->peername = sock->getpeername();
+    client->socket = std::move(sock);
+    // a new client only gets the data that's received from now on
+    client->position = this->head_;
+    client->last_dropped_warning = millis() - DROPPED_WARNING_INTERVAL;
+    ESP_LOGD(TAG, "Accepted %s", client->peername.c_str());
+    this->clients_.push_back(std::move(client));
+    this->high_freq_.start();
+  }
+}
+
+void StreamServerComponent::read_uart_() {
+  // read at most one buffer per loop, at high baud rates the UART could otherwise keep the loop busy
+  size_t total = 0;
+  while (total < this->buffer_size_) {
+    int available = this->available();
+    if (available <= 0)
+      break;
+    size_t pos = this->head_ % this->buffer_size_;
+    size_t len = std::min<size_t>(available, this->buffer_size_ - pos);
+    len = std::min(len, this->buffer_size_ - total);
+    if (!this->read_array(&this->buffer_[pos], len))
+      break;
+    this->head_ += len;
+    total += len;
+  }
+  if (total == 0)
+    return;
+  this->uart_rx_bytes_ += total;
+
+  // the new data overwrote the oldest data of clients that are more than a buffer behind
+  for (auto &client : this->clients_) {
+    size_t behind = this->head_ - client->position;
+    if (behind <= this->buffer_size_)
+      continue;
+    size_t lost = behind - this->buffer_size_;
+    this->dropped_bytes_ += lost;
+    client->position += lost;
+    client->unreported_dropped += lost;
+    const uint32_t now = millis();
+    if (now - client->last_dropped_warning >= DROPPED_WARNING_INTERVAL) {
+      ESP_LOGW(TAG, "%s doesn't keep up, dropped %u bytes", client->peername.c_str(), client->unreported_dropped);
+      client->unreported_dropped = 0;
+      client->last_dropped_warning = now;
+    }
+  }
+}
+
+void StreamServerComponent::write_client_(Client *client) {
+  size_t pending = this->head_ - client->position;
+  if (client->disconnected || pending == 0)
+    return;
+  // the pending data wraps around the end of the buffer at most once
+  size_t pos = client->position % this->buffer_size_;
+  struct iovec iov[2];
+  iov[0].iov_base = &this->buffer_[pos];
+  iov[0].iov_len = std::min(pending, this->buffer_size_ - pos);
+  iov[1].iov_base = &this->buffer_[0];
+  iov[1].iov_len = pending - iov[0].iov_len;
+  ssize_t written = client->socket->writev(iov, iov[1].iov_len == 0 ? 1 : 2);
+  if (written == -1) {
+    if (errno != EWOULDBLOCK && errno != EAGAIN) {
+      ESP_LOGW(TAG, "Writing to %s failed: errno %d", client->peername.c_str(), errno);
+      this->disconnect_(client);
+    }
+    return;
+  }
+  client->position += written;
+}
+
+void StreamServerComponent::read_client_(Client *client) {
+  if (client->disconnected)
+    return;
+  // without a copy if the socket supports it
+  uint8_t *data;
+  ssize_t received = client->socket->peek(&data);
+  bool peeked = true;
+  uint8_t buf[MAX_UART_WRITE];
+  if (received == -1 && errno == EOPNOTSUPP) {
+    received = client->socket->read(buf, sizeof(buf));
+    data = buf;
+    peeked = false;
+  }
+  if (received == -1) {
+    if (errno != EWOULDBLOCK && errno != EAGAIN) {
+      ESP_LOGW(TAG, "Reading from %s failed: errno %d", client->peername.c_str(), errno);
+      this->disconnect_(client);
+    }
+    return;
+  }
+  if (received == 0) {
+    this->disconnect_(client);
+    return;
+  }
+  size_t len = std::min<size_t>(received, MAX_UART_WRITE);
+  this->write_array(data, len);
+  if (peeked)
+    client->socket->consume(len);
+  this->uart_tx_bytes_ += len;
+}
+
+void StreamServerComponent::disconnect_(Client *client) {
+  ESP_LOGD(TAG, "Disconnected %s", client->peername.c_str());
+  client->socket->close();
+  client->disconnected = true;
+}
+
+}  // namespace stream_server
+}  // namespace esphome
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/socket/socket.h"
+#include "esphome/components/uart/uart.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace stream_server {
+
+/** TCP server that bridges a UART to its clients.
+ *
+ * Everything received on the UART is sent to all connected clients, and everything a client sends is written to the
+ * UART. The data is moved in chunks instead of bytes: the UART is read into a ring buffer, every client is sent what
+ * it hasn't got yet from there with one writev(), and the data of a client is written to the UART straight from the
+ * socket's receive buffer where the socket implementation supports that.
+ *
+ * The ring buffer never holds back the UART, a client that doesn't keep up loses the oldest data instead (counted as
+ * dropped), so one stalled connection doesn't stop the others.
+ */
+class StreamServerComponent : public Component, public uart::UARTDevice {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  void on_shutdown() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  void set_port(uint16_t port) { this->port_ = port; }
+  /// Size of the buffer for the data from the UART, the most a client can fall behind. Must be a power of two.
+  void set_buffer_size(size_t buffer_size) { this->buffer_size_ = buffer_size; }
+  void set_max_clients(uint8_t max_clients) { this->max_clients_ = max_clients; }
+
+  /// Bytes read from the UART since boot.
+  uint32_t get_uart_rx_bytes() const { return this->uart_rx_bytes_; }
+  /// Bytes written to the UART since boot.
+  uint32_t get_uart_tx_bytes() const { return this->uart_tx_bytes_; }
+  /// Bytes from the UART that a client didn't get because it fell behind by more than the buffer size.
+  uint32_t get_dropped_bytes() const { return this->dropped_bytes_; }
+  size_t get_client_count() const { return this->clients_.size(); }
+
+ protected:
+  struct Client {
+    std::unique_ptr<socket::Socket> socket;
+    std::string peername;
+    /// Position in the UART data up to which this client was sent everything.
+    size_t position;
+    /// Bytes this client lost since the last warning about it, the warnings are rate limited.
+    uint32_t unreported_dropped{0};
+    uint32_t last_dropped_warning{0};
+    bool disconnected{false};
+  };
+
+  void accept_clients_();
+  void read_uart_();
+  void write_client_(Client *client);
+  void read_client_(Client *client);
+  void disconnect_(Client *client);
+
+  uint16_t port_{6638};
+  size_t buffer_size_{1024};
+  uint8_t max_clients_{4};
+  std::unique_ptr<socket::Socket> socket_;
+  std::vector<std::unique_ptr<Client>> clients_;
+  std::vector<uint8_t, RAMAllocator<uint8_t, RAMPolicy::BULK>> buffer_;
+  /// Total amount of data read from the UART, the write position in the buffer is this modulo the buffer size.
+  size_t head_{0};
+  uint32_t uart_rx_bytes_{0};
+  uint32_t uart_tx_bytes_{0};
+  uint32_t dropped_bytes_{0};
+  /// Keeps the loop from sleeping while there are clients, the UART can't wake it up.
+  HighFrequencyLoopRequester high_freq_;
+};
+
+}  // namespace stream_server
+}  // namespace esphome
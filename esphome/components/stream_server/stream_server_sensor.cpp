@@ -0,0 +1,30 @@
+#include "stream_server_sensor.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace stream_server {
+
+static const char *const TAG = "stream_server.sensor";
+
+void StreamServerSensor::update() {
+  if (this->uart_rx_bytes_sensor_ != nullptr)
+    this->uart_rx_bytes_sensor_->publish_state(this->parent_->get_uart_rx_bytes());
+  if (this->uart_tx_bytes_sensor_ != nullptr)
+    this->uart_tx_bytes_sensor_->publish_state(this->parent_->get_uart_tx_bytes());
+  if (this->dropped_bytes_sensor_ != nullptr)
+    this->dropped_bytes_sensor_->publish_state(this->parent_->get_dropped_bytes());
+  if (this->connected_clients_sensor_ != nullptr)
+    this->connected_clients_sensor_->publish_state(this->parent_->get_client_count());
+}
+
+void StreamServerSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "Stream Server Sensor:");
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "UART RX Bytes", this->uart_rx_bytes_sensor_);
+  LOG_SENSOR("  ", "UART TX Bytes", this->uart_tx_bytes_sensor_);
+  LOG_SENSOR("  ", "Dropped Bytes", this->dropped_bytes_sensor_);
+  LOG_SENSOR("  ", "Connected Clients", this->connected_clients_sensor_);
+}
+
+}  // namespace stream_server
+}  // namespace esphome
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "stream_server.h"
+
+namespace esphome {
+namespace stream_server {
+
+/// Publishes the throughput counters of a stream server.
+class StreamServerSensor : public PollingComponent {
+ public:
+  void update() override;
+  void dump_config() override;
+
+  void set_parent(StreamServerComponent *parent) { this->parent_ = parent; }
+  void set_uart_rx_bytes_sensor(sensor::Sensor *sensor) { this->uart_rx_bytes_sensor_ = sensor; }
+  void set_uart_tx_bytes_sensor(sensor::Sensor *sensor) { this->uart_tx_bytes_sensor_ = sensor; }
+  void set_dropped_bytes_sensor(sensor::Sensor *sensor) { this->dropped_bytes_sensor_ = sensor; }
+  void set_connected_clients_sensor(sensor::Sensor *sensor) { this->connected_clients_sensor_ = sensor; }
+
+ protected:
+  StreamServerComponent *parent_;
+  sensor::Sensor *uart_rx_bytes_sensor_{nullptr};
+  sensor::Sensor *uart_tx_bytes_sensor_{nullptr};
+  sensor::Sensor *dropped_bytes_sensor_{nullptr};
+  sensor::Sensor *connected_clients_sensor_{nullptr};
+};
+
+}  // namespace stream_server
+}  // namespace esphome
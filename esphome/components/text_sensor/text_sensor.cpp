@@ -10,7 +10,11 @@ TextSensor::TextSensor() : TextSensor("") {}
 TextSensor::TextSensor(const std::string &name) : EntityBase(name) {}
 
 void TextSensor::publish_state(const std::string &state) {
-  this->raw_state = state;
+  {
+    // display update tasks may read the states
+    UpdateTaskGuard guard;
+    this->raw_state = state;
+  }
   this->raw_callback_.call(state);
 
   ESP_LOGV(TAG, "'%s': Received new state %s", this->name_.c_str(), state.c_str());
@@ -52,17 +56,20 @@ void TextSensor::clear_filters() {
   this->filter_list_ = nullptr;
 }
 
-void TextSensor::add_on_state_callback(std::function<void(std::string)> callback) {
+void TextSensor::add_on_state_callback(std::function<void(const std::string &)> callback) {
   this->callback_.add(std::move(callback));
 }
-void TextSensor::add_on_raw_state_callback(std::function<void(std::string)> callback) {
+void TextSensor::add_on_raw_state_callback(std::function<void(const std::string &)> callback) {
   this->raw_callback_.add(std::move(callback));
 }
 
 std::string TextSensor::get_state() const { return this->state; }
 std::string TextSensor::get_raw_state() const { return this->raw_state; }
 void TextSensor::internal_send_state_to_frontend(const std::string &state) {
-  this->state = state;
+  {
+    UpdateTaskGuard guard;
+    this->state = state;
+  }
   this->has_state_ = true;
   ESP_LOGD(TAG, "'%s': Sending state '%s'", this->name_.c_str(), state.c_str());
   this->callback_.call(state);
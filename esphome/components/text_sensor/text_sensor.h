@@ -43,9 +43,14 @@ class TextSensor : public EntityBase {
   /// Clear the entire filter chain.
   void clear_filters();
 
-  void add_on_state_callback(std::function<void(std::string)> callback);
+  /** Add a callback that will be called every time a filtered value arrives.
+   *
+   * The state is passed by reference, so it isn't copied for every subscriber. Callbacks that take a std::string by
+   * value still work, they just make their own copy.
+   */
+  void add_on_state_callback(std::function<void(const std::string &)> callback);
   /// Add a callback that will be called every time the sensor sends a raw value.
-  void add_on_raw_state_callback(std::function<void(std::string)> callback);
+  void add_on_raw_state_callback(std::function<void(const std::string &)> callback);
 
   std::string state;
   std::string raw_state;
@@ -61,8 +66,8 @@ class TextSensor : public EntityBase {
  protected:
   uint32_t hash_base() override;
 
-  CallbackManager<void(std::string)> raw_callback_;  ///< Storage for raw state callbacks.
-  CallbackManager<void(std::string)> callback_;      ///< Storage for filtered state callbacks.
+  CallbackManager<void(const std::string &)> raw_callback_;  ///< Storage for raw state callbacks.
+  CallbackManager<void(const std::string &)> callback_;      ///< Storage for filtered state callbacks.
 
   Filter *filter_list_{nullptr};  ///< Store all active filters.
 
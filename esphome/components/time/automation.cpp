@@ -1,6 +1,9 @@
 #include "automation.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 #include <cinttypes>
+#include <ctime>
+#include <sys/time.h>
 
 namespace esphome {
 namespace time {
@@ -17,40 +20,86 @@ bool CronTrigger::matches(const ESPTime &time) {
   return time.is_valid() && this->seconds_[time.second] && this->minutes_[time.minute] && this->hours_[time.hour] &&
          this->days_of_month_[time.day_of_month] && this->months_[time.month] && this->days_of_week_[time.day_of_week];
 }
-void CronTrigger::loop() {
+void CronTrigger::setup() {
+  // The time a match is due changes when the clock is set
+  this->rtc_->add_on_time_sync_callback([this]() { this->check_(); });
+  this->check_();
+}
+void CronTrigger::check_() {
+  this->cancel_timeout("check");
   ESPTime time = this->rtc_->now();
   if (!time.is_valid())
+    // checked again when the time is synced
     return;
 
-  if (this->last_check_.has_value()) {
-    if (*this->last_check_ > time && this->last_check_->timestamp - time.timestamp > 900) {
-      // We went back in time (a lot), probably caused by time synchronization
-      ESP_LOGW(TAG, "Time has jumped back!");
-    } else if (*this->last_check_ >= time) {
-      // already handled this one
-      return;
+  const time_t now = time.timestamp;
+  if (this->last_check_ == 0) {
+    if (!time.fields_in_range()) {
+      ESP_LOGW(TAG, "Time is out of range!");
+      ESP_LOGD(TAG, "Second=%02u Minute=%02u Hour=%02u DayOfWeek=%u DayOfMonth=%u DayOfYear=%u Month=%u time=%" PRId64,
+               time.second, time.minute, time.hour, time.day_of_week, time.day_of_month, time.day_of_year,
+               time.month, (int64_t) time.timestamp);
     }
-
-    while (true) {
-      this->last_check_->increment_second();
-      if (*this->last_check_ >= time)
-        break;
-
-      if (this->matches(*this->last_check_))
-        this->trigger();
+    if (this->matches(time))
+      this->trigger();
+    this->last_check_ = now;
+  } else if (this->last_check_ - now > 900) {
+    // We went back in time (a lot), probably caused by time synchronization
+    ESP_LOGW(TAG, "Time has jumped back!");
+    this->last_check_ = now;
+  } else {
+    // Everything that was due since the last check, also when the time jumped forward. After small jumps back
+    // nothing is triggered until the time of the last check again.
+    time_t next = this->last_check_;
+    while (this->next_match_(next, &next) && next <= now) {
+      this->trigger();
+      this->last_check_ = next;
     }
+    this->last_check_ = std::max(this->last_check_, now);
   }
 
-  this->last_check_ = time;
-  if (!time.fields_in_range()) {
-    ESP_LOGW(TAG, "Time is out of range!");
-    ESP_LOGD(TAG, "Second=%02u Minute=%02u Hour=%02u DayOfWeek=%u DayOfMonth=%u DayOfYear=%u Month=%u time=%" PRId64,
-             time.second, time.minute, time.hour, time.day_of_week, time.day_of_month, time.day_of_year, time.month,
-             (int64_t) time.timestamp);
+  time_t next;
+  if (!this->next_match_(this->last_check_, &next))
+    return;
+  // Check again when the next match is due, at least every hour so the timeout can't drift away from the clock
+  struct timeval tv;
+  ::gettimeofday(&tv, nullptr);
+  const time_t seconds = std::min<time_t>(next - now, 3600);
+  const uint32_t timeout = seconds * 1000 - std::min<uint32_t>(tv.tv_usec / 1000, seconds * 1000 - 1);
+  this->set_timeout("check", timeout, [this]() { this->check_(); });
+}
+bool CronTrigger::next_match_(time_t after, time_t *next) const {
+  // Skip ahead to the start of the next month, day, hour, ... whenever a field doesn't match. mktime() normalizes the
+  // overflowing fields, including across DST changes.
+  time_t candidate = after + 1;
+  for (int i = 0; i < 10000; i++) {
+    struct tm t {};
+    ::localtime_r(&candidate, &t);
+    if (!this->months_[t.tm_mon + 1]) {
+      t.tm_mon++;
+      t.tm_mday = 1;
+      t.tm_hour = t.tm_min = t.tm_sec = 0;
+    } else if (!this->days_of_month_[t.tm_mday] || !this->days_of_week_[t.tm_wday + 1]) {
+      t.tm_mday++;
+      t.tm_hour = t.tm_min = t.tm_sec = 0;
+    } else if (!this->hours_[t.tm_hour]) {
+      t.tm_hour++;
+      t.tm_min = t.tm_sec = 0;
+    } else if (!this->minutes_[t.tm_min]) {
+      t.tm_min++;
+      t.tm_sec = 0;
+    } else if (!this->seconds_[t.tm_sec]) {
+      t.tm_sec++;
+    } else {
+      *next = candidate;
+      return true;
+    }
+    t.tm_isdst = -1;
+    // when DST ends the same local time comes twice, don't go back to the first one
+    candidate = std::max(::mktime(&t), candidate + 1);
   }
-
-  if (this->matches(time))
-    this->trigger();
+  // There's no such date (like February 30th)
+  return false;
 }
 CronTrigger::CronTrigger(RealTimeClock *rtc) : rtc_(rtc) {}
 void CronTrigger::add_seconds(const std::vector<uint8_t> &seconds) {
@@ -23,10 +23,15 @@ class CronTrigger : public Trigger<>, public Component {
   void add_day_of_week(uint8_t day_of_week);
   void add_days_of_week(const std::vector<uint8_t> &days_of_week);
   bool matches(const ESPTime &time);
-  void loop() override;
+  void setup() override;
   float get_setup_priority() const override;
 
  protected:
+  /// Trigger for the matches since the last check, and schedule the next check.
+  void check_();
+  /// Find the first matching local time after the timestamp after.
+  bool next_match_(time_t after, time_t *next) const;
+
   std::bitset<61> seconds_;
   std::bitset<60> minutes_;
   std::bitset<24> hours_;
@@ -34,7 +39,8 @@ class CronTrigger : public Trigger<>, public Component {
   std::bitset<13> months_;
   std::bitset<8> days_of_week_;
   RealTimeClock *rtc_;
-  optional<ESPTime> last_check_;
+  /// The timestamp up to which matches were handled, 0 before the time was valid.
+  time_t last_check_{0};
 };
 
 class SyncTrigger : public Trigger<>, public Component {
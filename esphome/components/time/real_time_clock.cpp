@@ -17,6 +17,11 @@ void RealTimeClock::call_setup() {
   tzset();
   PollingComponent::call_setup();
 }
+int64_t RealTimeClock::timestamp_now_us() {
+  struct timeval tv;
+  ::gettimeofday(&tv, nullptr);
+  return int64_t(tv.tv_sec) * 1000000 + tv.tv_usec;
+}
 void RealTimeClock::synchronize_epoch_(uint32_t epoch) {
   struct timeval timev {
     .tv_sec = static_cast<time_t>(epoch), .tv_usec = 0,
@@ -122,6 +122,9 @@ class RealTimeClock : public PollingComponent {
   /// Get the current time as the UTC epoch since January 1st 1970.
   time_t timestamp_now() { return ::time(nullptr); }
 
+  /// Get the current time in microseconds since January 1st 1970 UTC, for timestamps that need sub-second resolution.
+  int64_t timestamp_now_us();
+
   void call_setup() override;
 
   void add_on_time_sync_callback(std::function<void()> callback) {
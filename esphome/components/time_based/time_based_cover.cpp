@@ -2,6 +2,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 
+#include <cmath>
+
 namespace esphome {
 namespace time_based {
 
@@ -13,6 +15,7 @@ void TimeBasedCover::dump_config() {
   LOG_COVER("", "Time Based Cover", this);
   ESP_LOGCONFIG(TAG, "  Open Duration: %.1fs", this->open_duration_ / 1e3f);
   ESP_LOGCONFIG(TAG, "  Close Duration: %.1fs", this->close_duration_ / 1e3f);
+  ESP_LOGCONFIG(TAG, "  Publish Interval: %.1fs", this->publish_interval_ / 1e3f);
 }
 void TimeBasedCover::setup() {
   auto restore = this->restore_state_();
@@ -22,31 +25,27 @@ void TimeBasedCover::setup() {
     this->position = 0.5f;
   }
 }
-void TimeBasedCover::loop() {
-  if (this->current_operation == COVER_OPERATION_IDLE)
-    return;
-
-  const uint32_t now = millis();
-
-  // Recompute position every loop cycle
+void TimeBasedCover::on_arrival_() {
   this->recompute_position_();
-
-  if (this->is_at_target_()) {
-    if (this->has_built_in_endstop_ &&
-        (this->target_position_ == COVER_OPEN || this->target_position_ == COVER_CLOSED)) {
-      // Don't trigger stop, let the cover stop by itself.
-      this->current_operation = COVER_OPERATION_IDLE;
-    } else {
-      this->start_direction_(COVER_OPERATION_IDLE);
-    }
-    this->publish_state();
-  }
-
-  // Send current position every second
-  if (now - this->last_publish_time_ > 1000) {
-    this->publish_state(false);
-    this->last_publish_time_ = now;
+  if (this->has_built_in_endstop_ &&
+      (this->target_position_ == COVER_OPEN || this->target_position_ == COVER_CLOSED)) {
+    // Don't trigger stop, let the cover stop by itself.
+    this->current_operation = COVER_OPERATION_IDLE;
+    this->cancel_interval("publish");
+  } else {
+    this->start_direction_(COVER_OPERATION_IDLE);
   }
+  this->position = this->target_position_;
+  this->publish_state();
+}
+void TimeBasedCover::schedule_arrival_() {
+  this->recompute_position_();
+  const float duration = this->current_operation == COVER_OPERATION_OPENING ? this->open_duration_
+                                                                             : this->close_duration_;
+  // a target that was moved behind the cover is reached right away
+  const uint32_t remaining =
+      this->is_at_target_() ? 0 : uint32_t(std::fabs(this->target_position_ - this->position) * duration);
+  this->set_timeout("arrival", remaining, [this]() { this->on_arrival_(); });
 }
 float TimeBasedCover::get_setup_priority() const { return setup_priority::DATA; }
 CoverTraits TimeBasedCover::get_traits() {
@@ -110,8 +109,11 @@ bool TimeBasedCover::is_at_target_() const {
   }
 }
 void TimeBasedCover::start_direction_(CoverOperation dir) {
-  if (dir == this->current_operation && dir != COVER_OPERATION_IDLE)
+  if (dir == this->current_operation && dir != COVER_OPERATION_IDLE) {
+    // the target may have changed
+    this->schedule_arrival_();
     return;
+  }
 
   this->recompute_position_();
   Trigger<> *trig;
@@ -140,6 +142,18 @@ void TimeBasedCover::start_direction_(CoverOperation dir) {
   this->stop_prev_trigger_();
   trig->trigger();
   this->prev_command_trigger_ = trig;
+
+  if (dir == COVER_OPERATION_IDLE) {
+    this->cancel_timeout("arrival");
+    this->cancel_interval("publish");
+    return;
+  }
+  // the position is only computed when it's published, and once more when the target is reached
+  this->schedule_arrival_();
+  this->set_interval("publish", this->publish_interval_, [this]() {
+    this->recompute_position_();
+    this->publish_state(false);
+  });
 }
 void TimeBasedCover::recompute_position_() {
   if (this->current_operation == COVER_OPERATION_IDLE)
@@ -10,7 +10,6 @@ namespace time_based {
 class TimeBasedCover : public cover::Cover, public Component {
  public:
   void setup() override;
-  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override;
 
@@ -22,6 +21,8 @@ class TimeBasedCover : public cover::Cover, public Component {
   cover::CoverTraits get_traits() override;
   void set_has_built_in_endstop(bool value) { this->has_built_in_endstop_ = value; }
   void set_assumed_state(bool value) { this->assumed_state_ = value; }
+  /// How often the position is published while the cover moves.
+  void set_publish_interval(uint32_t publish_interval) { this->publish_interval_ = publish_interval; }
 
  protected:
   void control(const cover::CoverCall &call) override;
@@ -29,6 +30,9 @@ class TimeBasedCover : public cover::Cover, public Component {
   bool is_at_target_() const;
 
   void start_direction_(cover::CoverOperation dir);
+  /// Set the timeout for when the current operation reaches the target position.
+  void schedule_arrival_();
+  void on_arrival_();
 
   void recompute_position_();
 
@@ -41,7 +45,7 @@ class TimeBasedCover : public cover::Cover, public Component {
   Trigger<> *prev_command_trigger_{nullptr};
   uint32_t last_recompute_time_{0};
   uint32_t start_dir_time_{0};
-  uint32_t last_publish_time_{0};
+  uint32_t publish_interval_{1000};
   float target_position_{0};
   bool has_built_in_endstop_{false};
   bool assumed_state_{false};
@@ -3,6 +3,8 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/hal.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace tm1637 {
 
@@ -163,6 +165,13 @@ void TM1637Display::stop_() {
 }
 
 void TM1637Display::display() {
+  // the bit-banged transfer takes several milliseconds, skip it if nothing changed
+  if (this->shown_valid_ && this->shown_intensity_ == this->intensity_ &&
+      memcmp(this->shown_, this->buffer_, sizeof(this->buffer_)) == 0)
+    return;
+  memcpy(this->shown_, this->buffer_, sizeof(this->buffer_));
+  this->shown_intensity_ = this->intensity_;
+  this->shown_valid_ = true;
   ESP_LOGVV(TAG, "Display %02X%02X%02X%02X", buffer_[0], buffer_[1], buffer_[2], buffer_[3]);
 
   // Write COMM1
@@ -68,6 +68,10 @@ class TM1637Display : public PollingComponent {
   bool inverted_;
   optional<tm1637_writer_t> writer_{};
   uint8_t buffer_[6] = {0};
+  /// What the display shows, display() only sends the buffer if it differs.
+  uint8_t shown_[6] = {0};
+  uint8_t shown_intensity_{0};
+  bool shown_valid_{false};
 };
 
 }  // namespace tm1637
@@ -28,24 +28,20 @@ void TMP102Component::dump_config() {
 }
 
 void TMP102Component::update() {
-  uint16_t raw_temperature;
-  if (this->write(&TMP102_REGISTER_TEMPERATURE, 1) != i2c::ERROR_OK) {
-    this->status_set_warning();
-    return;
-  }
-  delay(50);  // NOLINT
-  if (this->read(reinterpret_cast<uint8_t *>(&raw_temperature), 2) != i2c::ERROR_OK) {
-    this->status_set_warning();
-    return;
-  }
-  raw_temperature = i2c::i2ctohs(raw_temperature);
-
-  raw_temperature = raw_temperature >> 4;
-  float temperature = raw_temperature * TMP102_CONVERSION_FACTOR;
-  ESP_LOGD(TAG, "Got Temperature=%.1f°C", temperature);
-
-  this->publish_state(temperature);
-  this->status_clear_warning();
+  auto on_read = [this](i2c::ErrorCode err, const uint8_t *data, size_t len) {
+    if (err != i2c::ERROR_OK) {
+      this->status_set_warning();
+      return;
+    }
+    uint16_t raw_temperature = encode_uint16(data[0], data[1]) >> 4;
+    float temperature = raw_temperature * TMP102_CONVERSION_FACTOR;
+    ESP_LOGD(TAG, "Got Temperature=%.1f°C", temperature);
+
+    this->publish_state(temperature);
+    this->status_clear_warning();
+  };
+  // The sensor converts continuously, so the last result can be read right away
+  this->read_register_async(TMP102_REGISTER_TEMPERATURE, 2, on_read);
 }
 
 float TMP102Component::get_setup_priority() const { return setup_priority::DATA; }
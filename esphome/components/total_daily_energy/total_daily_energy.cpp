@@ -6,23 +6,27 @@ namespace total_daily_energy {
 
 static const char *const TAG = "total_daily_energy";
 
-void TotalDailyEnergy::setup() {
-  float initial_value = 0;
+static const double MS_TO_HOURS = 1.0 / 3600000.0;
 
-  if (this->restore_) {
-    this->pref_ = global_preferences->make_preference<float>(this->get_object_id_hash());
-    this->pref_.load(&initial_value);
-  }
-  this->publish_state_and_save(initial_value);
+void TotalDailyEnergy::setup() {
+  if (this->restore_)
+    this->integrator_.load(this->get_object_id_hash(), MS_TO_HOURS);
 
-  this->last_update_ = millis();
-  this->last_save_ = this->last_update_;
+  const uint32_t now = millis();
+  this->integrator_.start(now);
+  this->last_save_ = now;
+  this->publish_state_and_save();
 
   this->parent_->add_on_state_callback([this](float state) { this->process_new_state_(state); });
 }
 
 void TotalDailyEnergy::dump_config() { LOG_SENSOR("", "Total Daily Energy", this); }
 
+void TotalDailyEnergy::on_shutdown() {
+  if (this->restore_)
+    this->integrator_.save();
+}
+
 void TotalDailyEnergy::loop() {
   auto t = this->time_->now();
   if (!t.is_valid())
@@ -35,44 +39,45 @@ void TotalDailyEnergy::loop() {
 
   if (t.day_of_year != this->last_day_of_year_) {
     this->last_day_of_year_ = t.day_of_year;
-    this->total_energy_ = 0;
-    this->publish_state_and_save(0);
+    this->integrator_.reset();
+    this->publish_state_and_save();
   }
 }
 
+void TotalDailyEnergy::publish_state_and_save() {
+  this->publish_state(this->integrator_.get_total(MS_TO_HOURS));
+  this->save_();
+}
+
 void TotalDailyEnergy::publish_state_and_save(float state) {
-  this->total_energy_ = state;
-  this->publish_state(state);
+  this->integrator_.set_total(state, MS_TO_HOURS);
+  this->publish_state_and_save();
+}
+
+void TotalDailyEnergy::save_() {
+  if (!this->restore_)
+    return;
   const uint32_t now = millis();
-  if (now - this->last_save_ < this->min_save_interval_) {
+  const uint32_t since_save = now - this->last_save_;
+  if (since_save >= this->min_save_interval_) {
+    this->last_save_ = now;
+    this->integrator_.save();
     return;
   }
-  this->last_save_ = now;
-  this->pref_.save(&state);
+  // Save the latest total when the interval is over instead of dropping it.
+  if (this->save_pending_)
+    return;
+  this->save_pending_ = true;
+  this->set_timeout("save", this->min_save_interval_ - since_save, [this]() {
+    this->save_pending_ = false;
+    this->save_();
+  });
 }
 
 void TotalDailyEnergy::process_new_state_(float state) {
-  if (std::isnan(state))
-    return;
-  const uint32_t now = millis();
-  const float old_state = this->last_power_state_;
-  const float new_state = state;
-  float delta_hours = (now - this->last_update_) / 1000.0f / 60.0f / 60.0f;
-  float delta_energy = 0.0f;
-  switch (this->method_) {
-    case TOTAL_DAILY_ENERGY_METHOD_TRAPEZOID:
-      delta_energy = delta_hours * (old_state + new_state) / 2.0;
-      break;
-    case TOTAL_DAILY_ENERGY_METHOD_LEFT:
-      delta_energy = delta_hours * old_state;
-      break;
-    case TOTAL_DAILY_ENERGY_METHOD_RIGHT:
-      delta_energy = delta_hours * new_state;
-      break;
-  }
-  this->last_power_state_ = new_state;
-  this->last_update_ = now;
-  this->publish_state_and_save(this->total_energy_ + delta_energy);
+  // Callbacks run while the power sensor publishes, so this is the time of the value.
+  this->integrator_.add(state, millis());
+  this->publish_state_and_save();
 }
 
 }  // namespace total_daily_energy
@@ -3,7 +3,9 @@
 #include "esphome/core/component.h"
 #include "esphome/core/preferences.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/sensor/sensor.h"
+#include "esphome/components/sensor/integrator.h"
 #include "esphome/components/time/real_time_clock.h"
 
 namespace esphome {
@@ -21,30 +23,35 @@ class TotalDailyEnergy : public sensor::Sensor, public Component {
   void set_min_save_interval(uint32_t min_interval) { this->min_save_interval_ = min_interval; }
   void set_time(time::RealTimeClock *time) { time_ = time; }
   void set_parent(Sensor *parent) { parent_ = parent; }
-  void set_method(TotalDailyEnergyMethod method) { method_ = method; }
+  // The methods are in the same order as sensor::IntegratorMethod.
+  void set_method(TotalDailyEnergyMethod method) {
+    this->integrator_.set_method(static_cast<sensor::IntegratorMethod>(method));
+  }
   void setup() override;
   void dump_config() override;
+  void on_shutdown() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
   std::string unit_of_measurement() override { return this->parent_->get_unit_of_measurement() + "h"; }
   int8_t accuracy_decimals() override { return this->parent_->get_accuracy_decimals() + 2; }
   void loop() override;
 
+  void publish_state_and_save();
+  ESPDEPRECATED("publish_state_and_save(float) is deprecated, use publish_state_and_save() instead.", "2022.1")
   void publish_state_and_save(float state);
 
  protected:
   void process_new_state_(float state);
+  /// Save the total now, or once min_save_interval has passed since the last save.
+  void save_();
 
-  ESPPreferenceObject pref_;
   time::RealTimeClock *time_;
   Sensor *parent_;
-  TotalDailyEnergyMethod method_;
+  sensor::Integrator integrator_;
   uint16_t last_day_of_year_{};
-  uint32_t last_update_{0};
   uint32_t last_save_{0};
   uint32_t min_save_interval_{0};
+  bool save_pending_{false};
   bool restore_;
-  float total_energy_{0.0f};
-  float last_power_state_{0.0f};
 };
 
 }  // namespace total_daily_energy
@@ -16,10 +16,14 @@ void Tuya::setup() {
 }
 
 void Tuya::loop() {
-  while (this->available()) {
-    uint8_t c;
-    this->read_byte(&c);
-    this->handle_char_(c);
+  uint8_t buffer[64];
+  int available;
+  while ((available = this->available()) > 0) {
+    size_t len = std::min<size_t>(available, sizeof(buffer));
+    if (!this->read_array(buffer, len))
+      break;
+    for (size_t i = 0; i < len; i++)
+      this->handle_char_(buffer[i]);
   }
   process_command_queue_();
 }
@@ -376,7 +380,7 @@ void Tuya::process_command_queue_() {
   if (delay > COMMAND_DELAY && !this->command_queue_.empty() && this->rx_message_.empty() &&
       !this->expected_response_.has_value()) {
     this->send_raw_command_(command_queue_.front());
-    this->command_queue_.erase(command_queue_.begin());
+    this->command_queue_.pop_front();
   }
 }
 
@@ -567,6 +571,15 @@ void Tuya::send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datap
   buffer.push_back(data.size() >> 0);
   buffer.insert(buffer.end(), data.begin(), data.end());
 
+  // A value for this datapoint that wasn't sent yet is outdated, only send the latest one
+  for (auto &command : this->command_queue_) {
+    if (command.cmd == TuyaCommandType::DATAPOINT_DELIVER && command.payload[0] == datapoint_id) {
+      ESP_LOGV(TAG, "Replacing queued value of datapoint %u", datapoint_id);
+      command.payload = std::move(buffer);
+      this->process_command_queue_();
+      return;
+    }
+  }
   this->send_command_(TuyaCommand{.cmd = TuyaCommandType::DATAPOINT_DELIVER, .payload = buffer});
 }
 
@@ -4,6 +4,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include "esphome/components/uart/uart.h"
+#include <deque>
 
 #ifdef USE_TIME
 #include "esphome/components/time/real_time_clock.h"
@@ -72,6 +73,7 @@ struct TuyaCommand {
 class Tuya : public Component, public uart::UARTDevice {
  public:
   float get_setup_priority() const override { return setup_priority::LATE; }
+  bool can_setup_while_blocked() const override { return true; }
   void setup() override;
   void loop() override;
   void dump_config() override;
@@ -132,7 +134,7 @@ class Tuya : public Component, public uart::UARTDevice {
   std::vector<TuyaDatapoint> datapoints_;
   std::vector<uint8_t> rx_message_;
   std::vector<uint8_t> ignore_mcu_update_on_datapoints_{};
-  std::vector<TuyaCommand> command_queue_;
+  std::deque<TuyaCommand> command_queue_;
   optional<TuyaCommandType> expected_response_{};
   uint8_t wifi_status_ = -1;
   CallbackManager<void()> initialized_callback_{};
@@ -20,5 +20,60 @@ bool UARTComponent::check_read_timeout_(size_t len) {
   return true;
 }
 
+void UARTComponent::poll_rx_frames_() {
+  if (!this->rx_frame_callback_)
+    return;
+  const uint32_t now = micros();
+  int available = this->available();
+  if (available > 0) {
+    this->read_rx_frame_data_(available);
+    this->rx_frame_last_read_ = now;
+    return;
+  }
+  if (this->rx_frame_.empty())
+    return;
+  // start bit, data bits, parity bit and stop bits
+  uint32_t char_bits = 1 + this->data_bits_ + (this->parity_ != UART_CONFIG_PARITY_NONE ? 1 : 0) + this->stop_bits_;
+  uint32_t idle_us = this->rx_frame_idle_chars_ * char_bits * 1000000UL / this->baud_rate_;
+  if (now - this->rx_frame_last_read_ >= idle_us)
+    this->end_rx_frame_();
+}
+
+void UARTComponent::read_rx_frame_data_(size_t len) {
+  size_t at = this->rx_frame_.size();
+  this->rx_frame_.resize(at + len);
+  this->read_array(&this->rx_frame_[at], len);
+  if (this->rx_frame_pattern_count_ == 0) {
+    // pass on frames that never end in pieces
+    if (this->rx_frame_.size() >= this->rx_buffer_size_)
+      this->end_rx_frame_();
+    return;
+  }
+
+  size_t start = 0;
+  for (size_t i = at; i < this->rx_frame_.size(); i++) {
+    if (this->rx_frame_[i] != this->rx_frame_pattern_) {
+      this->rx_frame_pattern_seen_ = 0;
+      continue;
+    }
+    if (++this->rx_frame_pattern_seen_ < this->rx_frame_pattern_count_)
+      continue;
+    this->rx_frame_pattern_seen_ = 0;
+    this->rx_frame_callback_(&this->rx_frame_[start], i + 1 - start);
+    start = i + 1;
+  }
+  this->rx_frame_.erase(this->rx_frame_.begin(), this->rx_frame_.begin() + start);
+  if (this->rx_frame_.size() >= this->rx_buffer_size_)
+    this->end_rx_frame_();
+}
+
+void UARTComponent::end_rx_frame_() {
+  if (this->rx_frame_.empty())
+    return;
+  this->rx_frame_callback_(this->rx_frame_.data(), this->rx_frame_.size());
+  this->rx_frame_.clear();
+  this->rx_frame_pattern_seen_ = 0;
+}
+
 }  // namespace uart
 }  // namespace esphome
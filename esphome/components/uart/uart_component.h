@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <vector>
 #include <cstring>
 #include "esphome/core/defines.h"
@@ -49,6 +50,24 @@ class UARTComponent {
   /// Block until all bytes have been written to the UART bus.
   virtual void flush() = 0;
 
+  using rx_frame_callback_t = std::function<void(const uint8_t *data, size_t len)>;
+  /** Receive whole frames from the loop() of the UART bus instead of reading it byte by byte.
+   *
+   * A frame ends once the line was idle for idle_chars character times, or with the pattern set by
+   * set_rx_frame_pattern(). Don't use the read methods besides this.
+   */
+  void set_rx_frame_callback(rx_frame_callback_t &&callback, uint8_t idle_chars = 4) {
+    this->rx_frame_callback_ = std::move(callback);
+    this->rx_frame_idle_chars_ = idle_chars;
+    this->apply_rx_frame_config_();
+  }
+  /// Also end frames after count repetitions of chr, for example for line based protocols.
+  void set_rx_frame_pattern(uint8_t chr, uint8_t count = 1) {
+    this->rx_frame_pattern_ = chr;
+    this->rx_frame_pattern_count_ = count;
+    this->rx_frame_pattern_seen_ = 0;
+  }
+
   void set_tx_pin(InternalGPIOPin *tx_pin) { this->tx_pin_ = tx_pin; }
   void set_rx_pin(InternalGPIOPin *rx_pin) { this->rx_pin_ = rx_pin; }
   void set_rx_buffer_size(size_t rx_buffer_size) { this->rx_buffer_size_ = rx_buffer_size; }
@@ -73,6 +92,23 @@ class UARTComponent {
   virtual void check_logger_conflict() = 0;
   bool check_read_timeout_(size_t len = 1);
 
+  /// Called when the frame callback changes, for platforms that detect the end of frames in hardware.
+  virtual void apply_rx_frame_config_() {}
+  /// Frame detection by polling available(), for platforms without an RX timeout event.
+  void poll_rx_frames_();
+  /// Read len bytes into the current frame, passing on the frames completed by the pattern.
+  void read_rx_frame_data_(size_t len);
+  /// Pass on the current frame, if there is one.
+  void end_rx_frame_();
+
+  rx_frame_callback_t rx_frame_callback_{};
+  std::vector<uint8_t> rx_frame_;
+  uint32_t rx_frame_last_read_{0};
+  uint8_t rx_frame_idle_chars_{4};
+  uint8_t rx_frame_pattern_{0};
+  uint8_t rx_frame_pattern_count_{0};
+  uint8_t rx_frame_pattern_seen_{0};
+
   InternalGPIOPin *tx_pin_;
   InternalGPIOPin *rx_pin_;
   size_t rx_buffer_size_;
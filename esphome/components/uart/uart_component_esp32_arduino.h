@@ -15,6 +15,7 @@ namespace uart {
 class ESP32ArduinoUARTComponent : public UARTComponent, public Component {
  public:
   void setup() override;
+  void loop() override { this->poll_rx_frames_(); }
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::BUS; }
 
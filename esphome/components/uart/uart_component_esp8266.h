@@ -50,6 +50,7 @@ class ESP8266SoftwareSerial {
 class ESP8266UartComponent : public UARTComponent, public Component {
  public:
   void setup() override;
+  void loop() override { this->poll_rx_frames_(); }
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::BUS; }
 
@@ -13,6 +13,9 @@
 namespace esphome {
 namespace uart {
 static const char *const TAG = "uart.idf";
+static const int UART_EVENT_QUEUE_SIZE = 20;
+// The RX timeout is a 7 bit value on the ESP32
+static const uint8_t UART_RX_TIMEOUT_MAX = 126;
 
 uart_config_t IDFUARTComponent::get_config_() {
   uart_parity_t parity = UART_PARITY_DISABLE;
@@ -78,7 +81,9 @@ void IDFUARTComponent::setup() {
     return;
   }
 
-  err = uart_driver_install(this->uart_num_, this->rx_buffer_size_, 0, 0, nullptr, 0);
+  // the event queue tells about received data, and frame ends by the RX timeout
+  err = uart_driver_install(this->uart_num_, this->rx_buffer_size_, 0, UART_EVENT_QUEUE_SIZE, &this->uart_event_queue_,
+                            0);
   if (err != ESP_OK) {
     ESP_LOGW(TAG, "uart_driver_install failed: %s", esp_err_to_name(err));
     this->mark_failed();
@@ -109,6 +114,60 @@ void IDFUARTComponent::setup() {
   }
 
   xSemaphoreGive(this->lock_);
+
+  if (this->rx_frame_callback_)
+    this->apply_rx_frame_config_();
+}
+
+void IDFUARTComponent::loop() {
+  if (this->uart_event_queue_ == nullptr)
+    return;
+
+  uart_event_t event;
+  while (xQueueReceive(this->uart_event_queue_, &event, 0) == pdTRUE) {
+    switch (event.type) {
+      case UART_DATA: {
+        if (!this->rx_frame_callback_)
+          break;
+        // Events get lost while the queue is full, so take everything that was received instead of event.size
+        int len = this->available();
+        if (len > 0)
+          this->read_rx_frame_data_(len);
+        // the line was idle for rx_frame_idle_chars_ after this data
+        if (event.timeout_flag)
+          this->end_rx_frame_();
+        break;
+      }
+      case UART_FIFO_OVF:
+      case UART_BUFFER_FULL:
+        ESP_LOGW(TAG, "UART %u RX overflow, dropping received data", this->uart_num_);
+        xSemaphoreTake(this->lock_, portMAX_DELAY);
+        uart_flush_input(this->uart_num_);
+        this->has_peek_ = false;
+        xSemaphoreGive(this->lock_);
+        xQueueReset(this->uart_event_queue_);
+        this->rx_frame_.clear();
+        this->rx_frame_pattern_seen_ = 0;
+        return;
+      default:
+        break;
+    }
+  }
+}
+
+void IDFUARTComponent::apply_rx_frame_config_() {
+  if (this->uart_event_queue_ == nullptr)
+    // not set up yet, done in setup()
+    return;
+  // the RX timeout is counted in character times, and limited by the hardware
+  uint8_t idle_chars = std::min<uint8_t>(std::max<uint8_t>(this->rx_frame_idle_chars_, 1), UART_RX_TIMEOUT_MAX);
+  xSemaphoreTake(this->lock_, portMAX_DELAY);
+  esp_err_t err = uart_set_rx_timeout(this->uart_num_, idle_chars);
+  xSemaphoreGive(this->lock_);
+  if (err != ESP_OK)
+    ESP_LOGW(TAG, "uart_set_rx_timeout failed: %s", esp_err_to_name(err));
+  // events from before were about data nobody waited for
+  xQueueReset(this->uart_event_queue_);
 }
 
 void IDFUARTComponent::dump_config() {
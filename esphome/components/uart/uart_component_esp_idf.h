@@ -12,6 +12,7 @@ namespace uart {
 class IDFUARTComponent : public UARTComponent, public Component {
  public:
   void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::BUS; }
 
@@ -25,7 +26,9 @@ class IDFUARTComponent : public UARTComponent, public Component {
 
  protected:
   void check_logger_conflict() override;
+  void apply_rx_frame_config_() override;
   uart_port_t uart_num_;
+  QueueHandle_t uart_event_queue_{nullptr};
   uart_config_t get_config_();
   SemaphoreHandle_t lock_;
 
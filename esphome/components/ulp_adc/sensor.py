@@ -0,0 +1,114 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+import esphome.final_validate as fv
+from esphome import pins
+from esphome.components import sensor
+from esphome.components.adc.sensor import (
+    ATTENUATION_MODES,
+    ESP32_VARIANT_ADC1_PIN_TO_CHANNEL,
+)
+from esphome.components.esp32 import add_idf_sdkconfig_option, get_esp32_variant
+from esphome.components.esp32.const import VARIANT_ESP32
+from esphome.const import (
+    CONF_ATTENUATION,
+    CONF_ID,
+    CONF_NUMBER,
+    CONF_PIN,
+    CONF_PLATFORM,
+    CONF_RAW,
+    CONF_SENSOR,
+    DEVICE_CLASS_VOLTAGE,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_VOLT,
+)
+from esphome.core import CORE
+
+DEPENDENCIES = ["esp32"]
+
+CONF_SAMPLE_INTERVAL = "sample_interval"
+CONF_BATCH_SIZE = "batch_size"
+CONF_WAKEUP_ABOVE = "wakeup_above"
+CONF_WAKEUP_BELOW = "wakeup_below"
+
+# The sum of a batch has to fit in a 16 bit ULP register
+MAX_BATCH_SIZE = 16
+# The attenuation can't be switched between the samples of the ULP
+ULP_ATTENUATION_MODES = {k: v for k, v in ATTENUATION_MODES.items() if k != "auto"}
+
+
+def validate_ulp_adc_pin(value):
+    variant = get_esp32_variant()
+    if variant != VARIANT_ESP32:
+        raise cv.Invalid(f"The ULP ADC is not supported on {variant}")
+    value = pins.internal_gpio_input_pin_number(value)
+    if value not in ESP32_VARIANT_ADC1_PIN_TO_CHANNEL[variant]:
+        raise cv.Invalid(f"{variant} doesn't support ADC1 on this pin")
+    return pins.internal_gpio_input_pin_schema(value)
+
+
+ulp_adc_ns = cg.esphome_ns.namespace("ulp_adc")
+ULPADCSensor = ulp_adc_ns.class_("ULPADCSensor", sensor.Sensor, cg.PollingComponent)
+
+CONFIG_SCHEMA = (
+    sensor.sensor_schema(
+        unit_of_measurement=UNIT_VOLT,
+        accuracy_decimals=2,
+        device_class=DEVICE_CLASS_VOLTAGE,
+        state_class=STATE_CLASS_MEASUREMENT,
+    )
+    .extend(
+        {
+            cv.GenerateID(): cv.declare_id(ULPADCSensor),
+            cv.Required(CONF_PIN): validate_ulp_adc_pin,
+            cv.Optional(CONF_RAW, default=False): cv.boolean,
+            cv.Optional(CONF_ATTENUATION, default="0db"): cv.enum(
+                ULP_ATTENUATION_MODES, lower=True
+            ),
+            cv.Optional(
+                CONF_SAMPLE_INTERVAL, default="1s"
+            ): cv.positive_time_period_microseconds,
+            cv.Optional(CONF_BATCH_SIZE, default=MAX_BATCH_SIZE): cv.int_range(
+                min=1, max=MAX_BATCH_SIZE
+            ),
+            cv.Optional(CONF_WAKEUP_ABOVE): cv.int_range(min=0, max=4095),
+            cv.Optional(CONF_WAKEUP_BELOW): cv.int_range(min=0, max=4095),
+        }
+    )
+    .extend(cv.polling_component_schema("60s"))
+)
+
+
+def _final_validate(config):
+    # The data words in RTC slow memory and the ULP program are the same for every
+    # instance, a second sensor would clear the data of the first one.
+    sensors = fv.full_config.get().get(CONF_SENSOR, [])
+    if sum(1 for conf in sensors if conf.get(CONF_PLATFORM) == "ulp_adc") > 1:
+        raise cv.Invalid("Only one ulp_adc sensor is supported")
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await sensor.register_sensor(var, config)
+
+    pin = await cg.gpio_pin_expression(config[CONF_PIN])
+    cg.add(var.set_pin(pin))
+    variant = get_esp32_variant()
+    chan = ESP32_VARIANT_ADC1_PIN_TO_CHANNEL[variant][config[CONF_PIN][CONF_NUMBER]]
+    cg.add(var.set_channel(chan))
+    cg.add(var.set_output_raw(config[CONF_RAW]))
+    cg.add(var.set_attenuation(config[CONF_ATTENUATION]))
+    cg.add(var.set_sample_interval(config[CONF_SAMPLE_INTERVAL]))
+    cg.add(var.set_batch_size(config[CONF_BATCH_SIZE]))
+    if CONF_WAKEUP_ABOVE in config:
+        cg.add(var.set_wakeup_above(config[CONF_WAKEUP_ABOVE]))
+    if CONF_WAKEUP_BELOW in config:
+        cg.add(var.set_wakeup_below(config[CONF_WAKEUP_BELOW]))
+
+    if CORE.using_esp_idf:
+        add_idf_sdkconfig_option("CONFIG_ESP32_ULP_COPROC_ENABLED", True)
+        add_idf_sdkconfig_option("CONFIG_ESP32_ULP_COPROC_RESERVE_MEM", 512)
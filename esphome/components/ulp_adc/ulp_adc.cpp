@@ -0,0 +1,136 @@
+#ifdef USE_ESP32_VARIANT_ESP32
+#include "ulp_adc.h"
+#include "esphome/core/log.h"
+
+#include <esp_sleep.h>
+#include <esp32/ulp.h>
+#include <soc/rtc_cntl_reg.h>
+
+namespace esphome {
+namespace ulp_adc {
+
+static const char *const TAG = "ulp_adc";
+
+// RTC slow memory words shared with the ULP program, the ULP only uses the lower 16 bits of a word.
+static const uint32_t DATA_MAGIC = 0;  // written by the main CPU only, marks the data as valid
+static const uint32_t DATA_COUNT = 1;
+static const uint32_t DATA_SUM = 2;
+static const uint32_t DATA_LAST = 3;
+static const uint32_t PROGRAM_ADDR = 4;
+static const uint32_t MAGIC = 0x55AD;
+
+static const uint32_t LABEL_WAKE = 0;
+// Raw readings have 12 bits, so a threshold of this value never triggers
+static const uint16_t THRESHOLD_NEVER = 0xFFFF;
+
+void ULPADCSensor::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up ULP ADC '%s'...", this->get_name().c_str());
+  this->pin_->setup();
+  // the ULP may still run after a reset that wasn't a wakeup
+  CLEAR_PERI_REG_MASK(RTC_CNTL_STATE0_REG, RTC_CNTL_ULP_CP_SLP_TIMER_EN);
+
+  adc1_config_width(ADC_WIDTH_BIT_12);
+  adc1_config_channel_atten(this->channel_, this->attenuation_);
+  esp_adc_cal_characterize(ADC_UNIT_1, this->attenuation_, ADC_WIDTH_BIT_12, 1100, &this->cal_characteristics_);
+  adc_gpio_init(ADC_UNIT_1, (adc_channel_t) this->channel_);
+
+  bool woken = esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_UNDEFINED;
+  uint32_t count = RTC_SLOW_MEM[DATA_COUNT] & 0xFFFF;
+  if (woken && (RTC_SLOW_MEM[DATA_MAGIC] & 0xFFFF) == MAGIC && count != 0) {
+    uint32_t sum = RTC_SLOW_MEM[DATA_SUM] & 0xFFFF;
+    uint32_t average = (sum + count / 2) / count;
+    ESP_LOGD(TAG, "'%s': Got %u samples from the ULP, average %u, last %u", this->get_name().c_str(), count, average,
+             RTC_SLOW_MEM[DATA_LAST] & 0xFFFF);
+    this->publish_state(this->convert_(average));
+  }
+  RTC_SLOW_MEM[DATA_MAGIC] = 0;
+}
+
+void ULPADCSensor::dump_config() {
+  LOG_SENSOR("", "ULP ADC Sensor", this);
+  LOG_PIN("  Pin: ", this->pin_);
+  ESP_LOGCONFIG(TAG, "  Sample Interval: %u ms", this->sample_interval_us_ / 1000);
+  ESP_LOGCONFIG(TAG, "  Batch Size: %u", this->batch_size_);
+  if (this->wakeup_above_.has_value())
+    ESP_LOGCONFIG(TAG, "  Wakeup Above: %u", *this->wakeup_above_);
+  if (this->wakeup_below_.has_value())
+    ESP_LOGCONFIG(TAG, "  Wakeup Below: %u", *this->wakeup_below_);
+  LOG_UPDATE_INTERVAL(this);
+}
+
+float ULPADCSensor::get_setup_priority() const { return setup_priority::DATA; }
+
+void ULPADCSensor::update() {
+  int raw = adc1_get_raw(this->channel_);
+  float value = raw == -1 ? NAN : this->convert_(raw);
+  ESP_LOGV(TAG, "'%s': Got value=%.4f", this->get_name().c_str(), value);
+  this->publish_state(value);
+}
+
+void ULPADCSensor::on_safe_shutdown() {
+  if (!this->load_program_())
+    return;
+  RTC_SLOW_MEM[DATA_COUNT] = 0;
+  RTC_SLOW_MEM[DATA_SUM] = 0;
+  RTC_SLOW_MEM[DATA_LAST] = 0;
+  RTC_SLOW_MEM[DATA_MAGIC] = MAGIC;
+
+  adc1_config_channel_atten(this->channel_, this->attenuation_);
+  adc1_ulp_enable();
+  ulp_set_wakeup_period(0, this->sample_interval_us_);
+  esp_sleep_enable_ulp_wakeup();
+  esp_err_t err = ulp_run(PROGRAM_ADDR);
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "Starting the ULP failed: %s", esp_err_to_name(err));
+    return;
+  }
+  ESP_LOGD(TAG, "ULP sampling started");
+}
+
+bool ULPADCSensor::load_program_() {
+  uint16_t above = this->wakeup_above_.value_or(THRESHOLD_NEVER);
+  uint16_t below = this->wakeup_below_.value_or(0);
+  const ulp_insn_t program[] = {
+      I_MOVI(R3, 0),  // base address of the data
+      I_ADC(R0, 0, this->channel_),
+      I_ST(R0, R3, DATA_LAST),
+      I_LD(R1, R3, DATA_SUM),
+      I_ADDR(R1, R1, R0),
+      I_ST(R1, R3, DATA_SUM),
+      I_LD(R2, R3, DATA_COUNT),
+      I_ADDI(R2, R2, 1),
+      I_ST(R2, R3, DATA_COUNT),
+      // conditional branches compare R0, which still holds the sample
+      M_BGE(LABEL_WAKE, above),
+      M_BL(LABEL_WAKE, below),
+      I_MOVR(R0, R2),
+      M_BGE(LABEL_WAKE, this->batch_size_),
+      I_HALT(),
+      M_LABEL(LABEL_WAKE),
+      // the wakeup is lost if the main CPU isn't fully asleep yet
+      I_RD_REG(RTC_CNTL_LOW_POWER_ST_REG, RTC_CNTL_RDY_FOR_WAKEUP_S, RTC_CNTL_RDY_FOR_WAKEUP_S),
+      I_ANDI(R0, R0, 1),
+      M_BXZ(LABEL_WAKE),
+      I_WAKE(),
+      I_END(),  // stop sampling until the next deep sleep
+      I_HALT(),
+  };
+  size_t size = sizeof(program) / sizeof(ulp_insn_t);
+  esp_err_t err = ulp_process_macros_and_load(PROGRAM_ADDR, program, &size);
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "Loading the ULP program failed: %s", esp_err_to_name(err));
+    return false;
+  }
+  return true;
+}
+
+float ULPADCSensor::convert_(uint32_t raw) {
+  if (this->output_raw_)
+    return raw;
+  return esp_adc_cal_raw_to_voltage(raw, &this->cal_characteristics_) / 1000.0f;
+}
+
+}  // namespace ulp_adc
+}  // namespace esphome
+
+#endif  // USE_ESP32_VARIANT_ESP32
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/optional.h"
+#include "esphome/components/sensor/sensor.h"
+
+#ifdef USE_ESP32_VARIANT_ESP32
+
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+
+namespace esphome {
+namespace ulp_adc {
+
+/** An ADC1 channel that the ULP coprocessor keeps sampling while the main CPU is in deep sleep.
+ *
+ * When the node enters deep sleep, a small ULP program is loaded that samples the channel every sample interval and
+ * sums up the readings in RTC memory. The main CPU is only woken once batch_size samples were taken or a sample is
+ * outside of the wakeup thresholds. After the wakeup the average of the batch is published. While awake, the channel
+ * is read directly every update interval, like the adc sensor does.
+ *
+ * The data words in RTC memory and the program are at fixed addresses, so there can only be one instance.
+ */
+class ULPADCSensor : public sensor::Sensor, public PollingComponent {
+ public:
+  void set_pin(InternalGPIOPin *pin) { this->pin_ = pin; }
+  void set_channel(adc1_channel_t channel) { this->channel_ = channel; }
+  void set_attenuation(adc_atten_t attenuation) { this->attenuation_ = attenuation; }
+  void set_output_raw(bool output_raw) { this->output_raw_ = output_raw; }
+  /// How often the ULP samples the channel during deep sleep.
+  void set_sample_interval(uint32_t sample_interval_us) { this->sample_interval_us_ = sample_interval_us; }
+  /// Wake the main CPU after this many samples, at most MAX_BATCH_SIZE.
+  void set_batch_size(uint8_t batch_size) { this->batch_size_ = batch_size; }
+  /// Wake the main CPU as soon as a raw reading is at or above this value.
+  void set_wakeup_above(uint16_t wakeup_above) { this->wakeup_above_ = wakeup_above; }
+  /// Wake the main CPU as soon as a raw reading is below this value.
+  void set_wakeup_below(uint16_t wakeup_below) { this->wakeup_below_ = wakeup_below; }
+
+  void setup() override;
+  void dump_config() override;
+  void update() override;
+  /// Starts the ULP program, deep_sleep runs the safe shutdown hooks right before it enters deep sleep.
+  void on_safe_shutdown() override;
+  float get_setup_priority() const override;
+
+  /// The sum of the samples of a batch has to fit in the 16 bits of a ULP register.
+  static const uint8_t MAX_BATCH_SIZE = 16;
+
+ protected:
+  float convert_(uint32_t raw);
+  bool load_program_();
+
+  InternalGPIOPin *pin_;
+  adc1_channel_t channel_{};
+  adc_atten_t attenuation_{ADC_ATTEN_DB_0};
+  bool output_raw_{false};
+  uint32_t sample_interval_us_{1000000};
+  uint8_t batch_size_{MAX_BATCH_SIZE};
+  optional<uint16_t> wakeup_above_;
+  optional<uint16_t> wakeup_below_;
+  esp_adc_cal_characteristics_t cal_characteristics_{};
+};
+
+}  // namespace ulp_adc
+}  // namespace esphome
+
+#endif  // USE_ESP32_VARIANT_ESP32
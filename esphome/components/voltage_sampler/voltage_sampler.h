@@ -2,6 +2,8 @@
 
 #include "esphome/core/component.h"
 
+#include <cmath>
+
 namespace esphome {
 namespace voltage_sampler {
 
@@ -10,6 +12,19 @@ class VoltageSampler {
  public:
   /// Get a voltage reading, in V.
   virtual float sample() = 0;
+
+  /** Get count voltage readings in a row, in V (NAN for failed readings).
+   *
+   * Samplers that can read a burst of values faster than one at a time override this, by default sample() is
+   * called count times.
+   */
+  virtual void sample_block(float *values, size_t count) {
+    for (size_t i = 0; i < count; i++)
+      values[i] = this->sample();
+  }
+
+  /// The rate sample_block() values were taken at in Hz, NAN if it's as fast as the sampler can read.
+  virtual float get_sample_rate() const { return NAN; }
 };
 
 }  // namespace voltage_sampler
@@ -123,15 +123,52 @@ bool WaveshareEPaper::wait_until_idle_() {
   }
   return true;
 }
+void WaveshareEPaper::when_idle_(std::function<void()> &&step, uint32_t delay_ms) {
+  this->idle_step_ = std::move(step);
+  this->idle_wait_start_ = millis();
+  this->idle_wait_delay_ = delay_ms;
+}
 void WaveshareEPaper::update() {
-  this->do_update_();
+  // the previous refresh is still running, update once it's done
+  if (this->idle_step_ == nullptr && this->is_busy_())
+    this->when_idle_([]() {});
+  if (this->idle_step_ != nullptr) {
+    this->update_pending_ = true;
+    return;
+  }
+  if (!this->do_update_())
+    return;
   this->display();
 }
+void WaveshareEPaper::loop() {
+  if (this->idle_step_ == nullptr)
+    return;
+  const uint32_t elapsed = millis() - this->idle_wait_start_;
+  if (elapsed < this->idle_wait_delay_)
+    return;
+  if (this->is_busy_()) {
+    // same timeout as a blocking wait_until_idle_()
+    if (elapsed < this->idle_wait_delay_ + this->idle_timeout_())
+      return;
+    ESP_LOGE(TAG, "Timeout while displaying image!");
+    this->status_set_warning();
+  }
+
+  // the step may queue the next one
+  std::function<void()> step = std::move(this->idle_step_);
+  this->idle_step_ = nullptr;
+  step();
+  if (this->idle_step_ == nullptr && this->update_pending_) {
+    this->update_pending_ = false;
+    this->update();
+  }
+}
 void WaveshareEPaper::fill(Color color) {
   // flip logic
   const uint8_t fill = color.is_on() ? 0x00 : 0xFF;
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
     this->buffer_[i] = fill;
+  this->mark_all_dirty_();
 }
 void HOT WaveshareEPaper::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x >= this->get_width_internal() || y >= this->get_height_internal() || x < 0 || y < 0)
@@ -145,6 +182,37 @@ void HOT WaveshareEPaper::draw_absolute_pixel_internal(int x, int y, Color color
   else
     this->buffer_[pos] &= ~(0x80 >> subpos);
 }
+void HOT WaveshareEPaper::fill_span_internal(int x, int y, int width, Color color) {
+  // rows are stored back to back one bit per pixel, so a span is a run of whole bytes with partial bytes at the ends
+  uint32_t bit = x + y * this->get_width_internal();
+  const uint32_t end = bit + width;
+  // flip logic
+  const bool set = !color.is_on();
+  for (; bit < end && (bit & 0x07) != 0; bit++) {
+    if (set)
+      this->buffer_[bit / 8u] |= 0x80 >> (bit & 0x07);
+    else
+      this->buffer_[bit / 8u] &= ~(0x80 >> (bit & 0x07));
+  }
+  const uint32_t bytes = (end - bit) / 8u;
+  memset(this->buffer_ + bit / 8u, set ? 0xFF : 0x00, bytes);
+  for (bit += bytes * 8u; bit < end; bit++) {
+    if (set)
+      this->buffer_[bit / 8u] |= 0x80 >> (bit & 0x07);
+    else
+      this->buffer_[bit / 8u] &= ~(0x80 >> (bit & 0x07));
+  }
+}
+void HOT WaveshareEPaper::blit_internal(int x, int y, int width, const Color *colors) {
+  uint32_t bit = x + y * this->get_width_internal();
+  for (int i = 0; i < width; i++, bit++) {
+    // flip logic
+    if (!colors[i].is_on())
+      this->buffer_[bit / 8u] |= 0x80 >> (bit & 0x07);
+    else
+      this->buffer_[bit / 8u] &= ~(0x80 >> (bit & 0x07));
+  }
+}
 uint32_t WaveshareEPaper::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal() / 8u; }
 void WaveshareEPaper::start_command_() {
   this->dc_pin_->digital_write(false);
@@ -284,79 +352,59 @@ void HOT WaveshareEPaperTypeA::display() {
     this->at_update_ = (this->at_update_ + 1) % this->full_update_every_;
   }
 
-  // Set x & y regions we want to write to (full)
-  switch (this->model_) {
-    case TTGO_EPAPER_2_13_IN_B1:
-      // COMMAND SET RAM X ADDRESS START END POSITION
-      this->command(0x44);
-      this->data(0x00);
-      this->data((this->get_width_internal() - 1) >> 3);
-      // COMMAND SET RAM Y ADDRESS START END POSITION
-      this->command(0x45);
-      this->data(this->get_height_internal() - 1);
-      this->data((this->get_height_internal() - 1) >> 8);
-      this->data(0x00);
-      this->data(0x00);
+  if (this->model_ == TTGO_EPAPER_2_13_IN_B1) {
+    // Set x & y regions we want to write to (full)
+    // COMMAND SET RAM X ADDRESS START END POSITION
+    this->command(0x44);
+    this->data(0x00);
+    this->data((this->get_width_internal() - 1) >> 3);
+    // COMMAND SET RAM Y ADDRESS START END POSITION
+    this->command(0x45);
+    this->data(this->get_height_internal() - 1);
+    this->data((this->get_height_internal() - 1) >> 8);
+    this->data(0x00);
+    this->data(0x00);
 
-      // COMMAND SET RAM X ADDRESS COUNTER
-      this->command(0x4E);
-      this->data(0x00);
-      // COMMAND SET RAM Y ADDRESS COUNTER
-      this->command(0x4F);
-      this->data(this->get_height_internal() - 1);
-      this->data((this->get_height_internal() - 1) >> 8);
+    // COMMAND SET RAM X ADDRESS COUNTER
+    this->command(0x4E);
+    this->data(0x00);
+    // COMMAND SET RAM Y ADDRESS COUNTER
+    this->command(0x4F);
+    this->data(this->get_height_internal() - 1);
+    this->data((this->get_height_internal() - 1) >> 8);
+
+    if (!this->wait_until_idle_()) {
+      this->status_set_warning();
+      return;
+    }
 
-      break;
-    case TTGO_EPAPER_2_13_IN_B74:
+    // COMMAND WRITE RAM
+    this->command(0x24);
+    this->start_data_();
+    int16_t wb = ((this->get_width_internal()) >> 3);
+    for (int i = 0; i < this->get_height_internal(); i++) {
+      for (int j = 0; j < wb; j++) {
+        int idx = j + (this->get_height_internal() - 1 - i) * wb;
+        this->write_byte(this->buffer_[idx]);
+      }
+    }
+    this->end_data_();
+  } else {
+    if (this->model_ == TTGO_EPAPER_2_13_IN_B74) {
       // BorderWaveform
       this->command(0x3C);
       this->data(full_update ? 0x05 : 0x80);
+    }
 
-      // fall through
-    default:
-      // COMMAND SET RAM X ADDRESS START END POSITION
-      this->command(0x44);
-      this->data(0x00);
-      this->data((this->get_width_internal() - 1) >> 3);
-      // COMMAND SET RAM Y ADDRESS START END POSITION
-      this->command(0x45);
-      this->data(0x00);
-      this->data(0x00);
-      this->data(this->get_height_internal() - 1);
-      this->data((this->get_height_internal() - 1) >> 8);
-
-      // COMMAND SET RAM X ADDRESS COUNTER
-      this->command(0x4E);
-      this->data(0x00);
-      // COMMAND SET RAM Y ADDRESS COUNTER
-      this->command(0x4F);
-      this->data(0x00);
-      this->data(0x00);
-  }
-
-  if (!this->wait_until_idle_()) {
-    this->status_set_warning();
-    return;
-  }
-
-  // COMMAND WRITE RAM
-  this->command(0x24);
-  this->start_data_();
-  switch (this->model_) {
-    case TTGO_EPAPER_2_13_IN_B1: {  // block needed because of variable initializations
-      int16_t wb = ((this->get_width_internal()) >> 3);
-      for (int i = 0; i < this->get_height_internal(); i++) {
-        for (int j = 0; j < wb; j++) {
-          int idx = j + (this->get_height_internal() - 1 - i) * wb;
-          this->write_byte(this->buffer_[idx]);
-        }
+    // The controller keeps its RAM between updates, so only the regions that changed have to be written
+    for (uint8_t i = 0; i < this->dirty_region_count_; i++) {
+      if (!this->write_region_(this->dirty_regions_[i])) {
+        this->status_set_warning();
+        return;
       }
-      break;
     }
-    default:
-      this->write_array(this->buffer_, this->get_buffer_length_());
   }
-  this->end_data_();
+  this->clear_dirty_regions_();
 
   // COMMAND DISPLAY UPDATE CONTROL 2
   this->command(0x22);
@@ -381,6 +429,42 @@ void HOT WaveshareEPaperTypeA::display() {
 
   this->status_clear_warning();
 }
+bool WaveshareEPaperTypeA::write_region_(const display::DisplayRegion &region) {
+  // the RAM is addressed in bytes along x
+  const uint8_t xb1 = region.x1 >> 3;
+  const uint8_t xb2 = region.x2 >> 3;
+
+  // COMMAND SET RAM X ADDRESS START END POSITION
+  this->command(0x44);
+  this->data(xb1);
+  this->data(xb2);
+  // COMMAND SET RAM Y ADDRESS START END POSITION
+  this->command(0x45);
+  this->data(region.y1);
+  this->data(region.y1 >> 8);
+  this->data(region.y2);
+  this->data(region.y2 >> 8);
+
+  // COMMAND SET RAM X ADDRESS COUNTER
+  this->command(0x4E);
+  this->data(xb1);
+  // COMMAND SET RAM Y ADDRESS COUNTER
+  this->command(0x4F);
+  this->data(region.y1);
+  this->data(region.y1 >> 8);
+
+  if (!this->wait_until_idle_())
+    return false;
+
+  // COMMAND WRITE RAM
+  this->command(0x24);
+  this->start_data_();
+  const uint32_t wb = this->get_width_internal() >> 3;
+  for (int row = region.y1; row <= region.y2; row++)
+    this->write_array(this->buffer_ + row * wb + xb1, xb2 - xb1 + 1);
+  this->end_data_();
+  return true;
+}
 int WaveshareEPaperTypeA::get_width_internal() {
   switch (this->model_) {
     case WAVESHARE_EPAPER_1_54_IN:
@@ -645,11 +729,12 @@ void HOT WaveshareEPaper2P9InB::display() {
   // COMMAND DISPLAY REFRESH
   this->command(0x12);
   delay(2);
-  this->wait_until_idle_();
 
-  // COMMAND POWER OFF
-  // NOTE: power off < deep sleep
-  this->command(0x02);
+  this->when_idle_([this]() {
+    // COMMAND POWER OFF
+    // NOTE: power off < deep sleep
+    this->command(0x02);
+  });
 }
 int WaveshareEPaper2P9InB::get_width_internal() { return 128; }
 int WaveshareEPaper2P9InB::get_height_internal() { return 296; }
@@ -823,11 +908,12 @@ void HOT WaveshareEPaper4P2InBV2::display() {
 
   // COMMAND DISPLAY REFRESH
   this->command(0x12);
-  this->wait_until_idle_();
 
-  // COMMAND POWER OFF
-  // NOTE: power off < deep sleep
-  this->command(0x02);
+  this->when_idle_([this]() {
+    // COMMAND POWER OFF
+    // NOTE: power off < deep sleep
+    this->command(0x02);
+  });
 }
 int WaveshareEPaper4P2InBV2::get_width_internal() { return 400; }
 int WaveshareEPaper4P2InBV2::get_height_internal() { return 300; }
@@ -1057,8 +1143,8 @@ void HOT WaveshareEPaper7P5InV2::display() {
 
   // COMMAND DISPLAY REFRESH
   this->command(0x12);
-  delay(100);  // NOLINT
-  this->wait_until_idle_();
+  // BUSY only goes high a while after the refresh command
+  this->when_idle_([]() {}, 100);
 }
 
 int WaveshareEPaper7P5InV2::get_width_internal() { return 800; }
@@ -1194,8 +1280,9 @@ void HOT WaveshareEPaper2P13InDKE::display() {
 
   // start and set up data format
   this->command(0x12);
-  this->wait_until_idle_();
-
+  this->when_idle_([this, partial]() { this->write_frame_(partial); });
+}
+void WaveshareEPaper2P13InDKE::write_frame_(bool partial) {
   this->command(0x11);
   this->data(0x03);
   this->command(0x44);
@@ -1221,7 +1308,7 @@ void HOT WaveshareEPaper2P13InDKE::display() {
 
     // commit
     this->command(0x20);
-    this->wait_until_idle_();
+    this->when_idle_([]() { ESP_LOGI(TAG, "Completed e-paper update."); });
   } else {
     // set up partial update
     this->command(0x32);
@@ -1256,30 +1343,31 @@ void HOT WaveshareEPaper2P13InDKE::display() {
     this->command(0x22);
     this->data(0xC0);
     this->command(0x20);
-    this->wait_until_idle_();
 
-    // send data
-    this->command(0x24);
-    this->start_data_();
-    this->write_array(this->buffer_, this->get_buffer_length_());
-    this->end_data_();
-
-    // commit as partial
-    this->command(0x22);
-    this->data(0xCF);
-    this->command(0x20);
-    this->wait_until_idle_();
-
-    // data must be sent again on partial update
-    delay(300);  // NOLINT
-    this->command(0x24);
-    this->start_data_();
-    this->write_array(this->buffer_, this->get_buffer_length_());
-    this->end_data_();
-    delay(300);  // NOLINT
+    this->when_idle_([this]() {
+      // send data
+      this->command(0x24);
+      this->start_data_();
+      this->write_array(this->buffer_, this->get_buffer_length_());
+      this->end_data_();
+
+      // commit as partial
+      this->command(0x22);
+      this->data(0xCF);
+      this->command(0x20);
+
+      // data must be sent again on partial update
+      this->when_idle_(
+          [this]() {
+            this->command(0x24);
+            this->start_data_();
+            this->write_array(this->buffer_, this->get_buffer_length_());
+            this->end_data_();
+            this->when_idle_([]() { ESP_LOGI(TAG, "Completed e-paper update."); }, 300);
+          },
+          300);
+    });
   }
-
-  ESP_LOGI(TAG, "Completed e-paper update.");
 }
 
 int WaveshareEPaper2P13InDKE::get_width_internal() { return 128; }
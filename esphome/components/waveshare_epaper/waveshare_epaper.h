@@ -26,6 +26,7 @@ class WaveshareEPaper : public PollingComponent,
   virtual void deep_sleep() = 0;
 
   void update() override;
+  void loop() override;
 
   void fill(Color color) override;
 
@@ -38,8 +39,18 @@ class WaveshareEPaper : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_internal(int x, int y, int width, const Color *colors) override;
 
   bool wait_until_idle_();
+  bool is_busy_() { return this->busy_pin_ != nullptr && this->busy_pin_->digital_read(); }
+
+  /** Run step from loop() once the display is no longer busy and at least delay_ms have passed.
+   *
+   * Refreshes take seconds, so display() starts them and leaves what comes after to this instead of blocking the
+   * main loop. Updates requested in the meantime are postponed until the last step ran.
+   */
+  void when_idle_(std::function<void()> &&step, uint32_t delay_ms = 0);
 
   void setup_pins_();
 
@@ -64,6 +75,11 @@ class WaveshareEPaper : public PollingComponent,
   GPIOPin *dc_pin_;
   GPIOPin *busy_pin_{nullptr};
   virtual uint32_t idle_timeout_() { return 1000u; }  // NOLINT(readability-identifier-naming)
+
+  std::function<void()> idle_step_{nullptr};
+  uint32_t idle_wait_start_{0};
+  uint32_t idle_wait_delay_{0};
+  bool update_pending_{false};
 };
 
 enum WaveshareEPaperTypeAModel {
@@ -104,6 +120,8 @@ class WaveshareEPaperTypeA : public WaveshareEPaper {
 
  protected:
   void write_lut_(const uint8_t *lut, uint8_t size);
+  /// Write the given part of the buffer to the controller RAM, false if the display didn't become idle.
+  bool write_region_(const display::DisplayRegion &region);
 
   int get_width_internal() override;
 
@@ -350,6 +368,9 @@ class WaveshareEPaper2P13InDKE : public WaveshareEPaper {
 
   uint32_t idle_timeout_() override;
 
+  /// Send the frame once the controller finished its reset.
+  void write_frame_(bool partial);
+
   uint32_t full_update_every_{30};
   uint32_t at_update_{0};
 };
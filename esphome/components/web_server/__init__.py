@@ -1,3 +1,7 @@
+import gzip
+import hashlib
+import io
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import web_server_base
@@ -15,13 +19,16 @@ from esphome.const import (
     CONF_INCLUDE_INTERNAL,
     CONF_OTA,
 )
-from esphome.core import CORE, coroutine_with_priority
+from esphome.core import CORE, HexInt, coroutine_with_priority
 
 AUTO_LOAD = ["json", "web_server_base"]
 
 web_server_ns = cg.esphome_ns.namespace("web_server")
 WebServer = web_server_ns.class_("WebServer", cg.Component, cg.Controller)
 
+CONF_CSS_INCLUDE_DATA_ID = "css_include_data_id"
+CONF_JS_INCLUDE_DATA_ID = "js_include_data_id"
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -31,10 +38,12 @@ CONFIG_SCHEMA = cv.All(
                 CONF_CSS_URL, default="https://esphome.io/_static/webserver-v1.min.css"
             ): cv.string,
             cv.Optional(CONF_CSS_INCLUDE): cv.file_,
+            cv.GenerateID(CONF_CSS_INCLUDE_DATA_ID): cv.declare_id(cg.uint8),
             cv.Optional(
                 CONF_JS_URL, default="https://esphome.io/_static/webserver-v1.min.js"
             ): cv.string,
             cv.Optional(CONF_JS_INCLUDE): cv.file_,
+            cv.GenerateID(CONF_JS_INCLUDE_DATA_ID): cv.declare_id(cg.uint8),
             cv.Optional(CONF_AUTH): cv.Schema(
                 {
                     cv.Required(CONF_USERNAME): cv.All(
@@ -56,6 +65,23 @@ CONFIG_SCHEMA = cv.All(
 )
 
 
+def compressed_include(data_id, path):
+    """Store the file at path gzip-compressed in flash.
+
+    Returns the array, its length and an ETag derived from the content.
+    """
+    with open(file=CORE.relative_config_path(path), mode="rb") as include_file:
+        content = include_file.read()
+    buffer = io.BytesIO()
+    # A fixed mtime keeps the output (and the firmware) reproducible
+    with gzip.GzipFile(fileobj=buffer, mode="wb", compresslevel=9, mtime=0) as gz:
+        gz.write(content)
+    compressed = buffer.getvalue()
+    etag = f'"{hashlib.sha256(content).hexdigest()[:16]}"'
+    prog_arr = cg.progmem_array(data_id, [HexInt(x) for x in compressed])
+    return prog_arr, len(compressed), etag
+
+
 @coroutine_with_priority(40.0)
 async def to_code(config):
     paren = await cg.get_variable(config[CONF_WEB_SERVER_BASE_ID])
@@ -76,12 +102,14 @@ async def to_code(config):
         cg.add(paren.set_auth_password(config[CONF_AUTH][CONF_PASSWORD]))
     if CONF_CSS_INCLUDE in config:
         cg.add_define("WEBSERVER_CSS_INCLUDE")
-        path = CORE.relative_config_path(config[CONF_CSS_INCLUDE])
-        with open(file=path, mode="r", encoding="utf-8") as myfile:
-            cg.add(var.set_css_include(myfile.read()))
+        prog_arr, length, etag = compressed_include(
+            config[CONF_CSS_INCLUDE_DATA_ID], config[CONF_CSS_INCLUDE]
+        )
+        cg.add(var.set_css_include(prog_arr, length, etag))
     if CONF_JS_INCLUDE in config:
         cg.add_define("WEBSERVER_JS_INCLUDE")
-        path = CORE.relative_config_path(config[CONF_JS_INCLUDE])
-        with open(file=path, mode="r", encoding="utf-8") as myfile:
-            cg.add(var.set_js_include(myfile.read()))
+        prog_arr, length, etag = compressed_include(
+            config[CONF_JS_INCLUDE_DATA_ID], config[CONF_JS_INCLUDE]
+        )
+        cg.add(var.set_js_include(prog_arr, length, etag))
     cg.add(var.set_include_internal(config[CONF_INCLUDE_INTERNAL]))
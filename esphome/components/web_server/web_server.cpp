@@ -10,6 +10,8 @@
 
 #include "StreamString.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 
 #ifdef USE_LIGHT
@@ -29,6 +31,25 @@ namespace web_server {
 
 static const char *const TAG = "web_server";
 
+/// Entities whose state is sent to new event clients per loop iteration.
+static const uint8_t INITIAL_STATES_PER_LOOP = 4;
+/// How long a /states request with since= waits for a change before answering with no states.
+static const uint32_t STATES_LONG_POLL_TIMEOUT = 25000;
+
+/// State of a chunked /states response, the JSON of one entity is rendered at a time.
+struct StatesCursor {
+  std::string domain;  ///< Only entities of this domain, empty for all.
+  bool changed_only{false};
+  uint32_t since{0};  ///< If changed_only, only entities that changed after this sequence number.
+  uint32_t wait_start{0};
+  bool started{false};
+  bool first{true};
+  bool finished{false};
+  size_t entity{0};
+  std::string pending;
+  size_t pending_pos{0};
+};
+
 void write_row(AsyncResponseStream *stream, EntityBase *obj, const std::string &klass, const std::string &action,
                const std::function<void(AsyncResponseStream &stream, EntityBase *obj)> &action_func = nullptr) {
   stream->print("<tr class=\"");
@@ -77,94 +98,326 @@ UrlMatch match_url(const std::string &url, bool only_domain = false) {
 }
 
 void WebServer::set_css_url(const char *css_url) { this->css_url_ = css_url; }
-void WebServer::set_css_include(const char *css_include) { this->css_include_ = css_include; }
+void WebServer::set_css_include(const uint8_t *css_include, size_t length, const char *etag) {
+  this->css_include_ = css_include;
+  this->css_include_length_ = length;
+  this->css_include_etag_ = etag;
+}
 void WebServer::set_js_url(const char *js_url) { this->js_url_ = js_url; }
-void WebServer::set_js_include(const char *js_include) { this->js_include_ = js_include; }
+void WebServer::set_js_include(const uint8_t *js_include, size_t length, const char *etag) {
+  this->js_include_ = js_include;
+  this->js_include_length_ = length;
+  this->js_include_etag_ = etag;
+}
 
 void WebServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up web server...");
   this->setup_controller(this->include_internal_);
   this->base_->init();
 
+  for (size_t i = 0;; i++) {
+    EntityBase *obj;
+    const char *domain;
+    json::json_build_t json;
+    if (!this->entity_at_(i, obj, domain, json))
+      break;
+    this->entities_.push_back(obj);
+  }
+  this->changed_seq_.resize(this->entities_.size());
+
+  char etag[11];
+  sprintf(etag, "\"%08x\"", fnv1_hash(App.get_compilation_time()));
+  this->index_etag_ = etag;
+
   this->events_.onConnect([this](AsyncEventSourceClient *client) {
     // Configure reconnect timeout
     client->send("", "ping", millis(), 30000);
+    // The states are sent from loop() to all clients, clients connecting at the same time share them
+    this->initial_state_requested_ = true;
+  });
 
-#ifdef USE_SENSOR
-    for (auto *obj : App.get_sensors())
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->sensor_json(obj, obj->state).c_str(), "state");
+#ifdef USE_LOGGER
+  if (logger::global_logger != nullptr)
+    logger::global_logger->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
 #endif
+  this->base_->add_handler(&this->events_);
+  this->base_->add_handler(this);
 
+  if (this->allow_ota_) {
+    this->base_->add_ota_handler();
+    // runs in the web server task, so without the shared JSON document
+    this->base_->add_on_ota_state_callback([this](web_server_base::OTAUploadState state, float progress) {
+      static const char *const STATES[] = {"started", "in_progress", "completed", "error", "aborted"};
+      char buf[64];
+      if (std::isnan(progress)) {
+        snprintf(buf, sizeof(buf), "{\"state\":\"%s\",\"progress\":null}", STATES[state]);
+      } else {
+        snprintf(buf, sizeof(buf), "{\"state\":\"%s\",\"progress\":%.1f}", STATES[state], progress);
+      }
+      this->events_.send(buf, "ota", millis());
+    });
+  }
+
+  this->set_interval(10000, [this]() { this->events_.send("", "ping", millis(), 30000); });
+}
+
+void WebServer::loop() {
+  if (this->initial_state_requested_.exchange(false)) {
+    // Start over, so a client that connected in the middle of sending the states gets all of them
+    this->initial_state_index_ = 0;
+    this->sending_initial_state_ = true;
+  }
+  if (!this->sending_initial_state_)
+    return;
+  for (uint8_t i = 0; i < INITIAL_STATES_PER_LOOP; i++) {
+    if (!this->send_initial_state_(this->initial_state_index_)) {
+      this->sending_initial_state_ = false;
+      return;
+    }
+    this->initial_state_index_++;
+  }
+}
+
+void WebServer::mark_changed_(EntityBase *obj) {
+  auto it = std::find(this->entities_.begin(), this->entities_.end(), obj);
+  if (it != this->entities_.end())
+    this->changed_seq_[it - this->entities_.begin()] = ++this->state_seq_;
+}
+
+void WebServer::handle_states_request(AsyncWebServerRequest *request) {
+  auto cursor = std::make_shared<StatesCursor>();
+  if (request->hasParam("domain"))
+    cursor->domain = request->getParam("domain")->value().c_str();
+  if (request->hasParam("since")) {
+    cursor->changed_only = true;
+    cursor->since = strtoul(request->getParam("since")->value().c_str(), nullptr, 10);
+  }
+  cursor->wait_start = millis();
+
+  // Runs as the connection asks for more data, so only the JSON of one entity is in memory at a time
+  AsyncWebServerResponse *response = request->beginChunkedResponse(
+      "application/json", [this, cursor](uint8_t *buffer, size_t max_len, size_t index) -> size_t {
+        if (!cursor->started) {
+          // Long-poll: hold the response until something changed
+          if (cursor->changed_only && this->state_seq_ <= cursor->since &&
+              millis() - cursor->wait_start < STATES_LONG_POLL_TIMEOUT)
+            return RESPONSE_TRY_AGAIN;
+          cursor->started = true;
+          char header[32];
+          sprintf(header, "{\"seq\":%u,\"states\":[", static_cast<unsigned>(this->state_seq_));
+          cursor->pending = header;
+        }
+
+        size_t written = 0;
+        while (written < max_len) {
+          if (cursor->pending_pos == cursor->pending.size()) {
+            cursor->pending.clear();
+            cursor->pending_pos = 0;
+            if (!this->render_next_state_(*cursor))
+              break;
+            continue;
+          }
+          const size_t len = std::min(max_len - written, cursor->pending.size() - cursor->pending_pos);
+          memcpy(buffer + written, cursor->pending.data() + cursor->pending_pos, len);
+          written += len;
+          cursor->pending_pos += len;
+        }
+        return written;
+      });
+  request->send(response);
+}
+
+bool WebServer::render_next_state_(StatesCursor &cursor) {
+  if (cursor.finished)
+    return false;
+
+  EntityBase *obj;
+  const char *domain;
+  json::json_build_t json;
+  const size_t index = cursor.entity;
+  if (!this->entity_at_(index, obj, domain, json)) {
+    cursor.pending = "]}";
+    cursor.finished = true;
+    return true;
+  }
+  cursor.entity++;
+
+  if (obj == nullptr || (!cursor.domain.empty() && cursor.domain != domain))
+    return true;
+  if (cursor.changed_only && this->changed_seq_[index] <= cursor.since)
+    return true;
+  if (!json::build_json(json, cursor.pending))
+    return true;
+  if (!cursor.first)
+    cursor.pending.insert(0, 1, ',');
+  cursor.first = false;
+  return true;
+}
+
+bool WebServer::send_initial_state_(size_t index) {
+  EntityBase *obj;
+  const char *domain;
+  json::json_build_t json;
+  if (!this->entity_at_(index, obj, domain, json))
+    return false;
+  if (obj != nullptr)
+    this->send_state_event_(json);
+  return true;
+}
+
+bool WebServer::entity_at_(size_t index, EntityBase *&obj, const char *&domain, json::json_build_t &json) {
+#ifdef USE_SENSOR
+  if (index < App.get_sensors().size()) {
+    auto *entity = App.get_sensors()[index];
+    obj = nullptr;
+    if (this->include_internal_ || !entity->is_internal()) {
+      obj = entity;
+      domain = "sensor";
+      json = this->sensor_json(entity, entity->state);
+    }
+    return true;
+  }
+  index -= App.get_sensors().size();
+#endif
 #ifdef USE_SWITCH
-    for (auto *obj : App.get_switches())
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->switch_json(obj, obj->state).c_str(), "state");
+  if (index < App.get_switches().size()) {
+    auto *entity = App.get_switches()[index];
+    obj = nullptr;
+    if (this->include_internal_ || !entity->is_internal()) {
+      obj = entity;
+      domain = "switch";
+      json = this->switch_json(entity, entity->state);
+    }
+    return true;
+  }
+  index -= App.get_switches().size();
 #endif
-
 #ifdef USE_BINARY_SENSOR
-    for (auto *obj : App.get_binary_sensors())
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->binary_sensor_json(obj, obj->state).c_str(), "state");
+  if (index < App.get_binary_sensors().size()) {
+    auto *entity = App.get_binary_sensors()[index];
+    obj = nullptr;
+    if (this->include_internal_ || !entity->is_internal()) {
+      obj = entity;
+      domain = "binary_sensor";
+      json = this->binary_sensor_json(entity, entity->state);
+    }
+    return true;
+  }
+  index -= App.get_binary_sensors().size();
 #endif
-
 #ifdef USE_FAN
-    for (auto *obj : App.get_fans())
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->fan_json(obj).c_str(), "state");
+  if (index < App.get_fans().size()) {
+    auto *entity = App.get_fans()[index];
+    obj = nullptr;
+    if (this->include_internal_ || !entity->is_internal()) {
+      obj = entity;
+      domain = "fan";
+      json = this->fan_json(entity);
+    }
+    return true;
+  }
+  index -= App.get_fans().size();
 #endif
-
 #ifdef USE_LIGHT
-    for (auto *obj : App.get_lights())
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->light_json(obj).c_str(), "state");
+  if (index < App.get_lights().size()) {
+    auto *entity = App.get_lights()[index];
+    obj = nullptr;
+    if (this->include_internal_ || !entity->is_internal()) {
+      obj = entity;
+      domain = "light";
+      json = this->light_json(entity);
+    }
+    return true;
+  }
+  index -= App.get_lights().size();
 #endif
-
 #ifdef USE_TEXT_SENSOR
-    for (auto *obj : App.get_text_sensors())
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->text_sensor_json(obj, obj->state).c_str(), "state");
+  if (index < App.get_text_sensors().size()) {
+    auto *entity = App.get_text_sensors()[index];
+    obj = nullptr;
+    if (this->include_internal_ || !entity->is_internal()) {
+      obj = entity;
+      domain = "text_sensor";
+      json = this->text_sensor_json(entity, entity->state);
+    }
+    return true;
+  }
+  index -= App.get_text_sensors().size();
 #endif
-
 #ifdef USE_COVER
-    for (auto *obj : App.get_covers())
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->cover_json(obj).c_str(), "state");
+  if (index < App.get_covers().size()) {
+    auto *entity = App.get_covers()[index];
+    obj = nullptr;
+    if (this->include_internal_ || !entity->is_internal()) {
+      obj = entity;
+      domain = "cover";
+      json = this->cover_json(entity);
+    }
+    return true;
+  }
+  index -= App.get_covers().size();
 #endif
-
 #ifdef USE_NUMBER
-    for (auto *obj : App.get_numbers())
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->number_json(obj, obj->state).c_str(), "state");
+  if (index < App.get_numbers().size()) {
+    auto *entity = App.get_numbers()[index];
+    obj = nullptr;
+    if (this->include_internal_ || !entity->is_internal()) {
+      obj = entity;
+      domain = "number";
+      json = this->number_json(entity, entity->state);
+    }
+    return true;
+  }
+  index -= App.get_numbers().size();
 #endif
-
 #ifdef USE_SELECT
-    for (auto *obj : App.get_selects())
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->select_json(obj, obj->state).c_str(), "state");
-#endif
-  });
-
-#ifdef USE_LOGGER
-  if (logger::global_logger != nullptr)
-    logger::global_logger->add_on_log_callback(
-        [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
+  if (index < App.get_selects().size()) {
+    auto *entity = App.get_selects()[index];
+    obj = nullptr;
+    if (this->include_internal_ || !entity->is_internal()) {
+      obj = entity;
+      domain = "select";
+      json = this->select_json(entity, entity->state);
+    }
+    return true;
+  }
+  index -= App.get_selects().size();
 #endif
-  this->base_->add_handler(&this->events_);
-  this->base_->add_handler(this);
-
-  if (this->allow_ota_)
-    this->base_->add_ota_handler();
-
-  this->set_interval(10000, [this]() { this->events_.send("", "ping", millis(), 30000); });
+  return false;
 }
+
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->base_->get_port());
 }
 float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
 
+bool WebServer::handle_cached_request_(AsyncWebServerRequest *request, const char *etag) {
+  if (!request->hasHeader("If-None-Match") || request->getHeader("If-None-Match")->value() != etag)
+    return false;
+  AsyncWebServerResponse *response = request->beginResponse(304);
+  response->addHeader("ETag", etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+  return true;
+}
+
+void WebServer::send_compressed_asset_(AsyncWebServerRequest *request, const char *content_type, const uint8_t *data,
+                                       size_t length, const char *etag) {
+  if (this->handle_cached_request_(request, etag))
+    return;
+  AsyncWebServerResponse *response = request->beginResponse_P(200, content_type, data, length);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", etag);
+  // The URL stays the same when the content changes, so browsers have to check the ETag every time
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
+  if (this->handle_cached_request_(request, this->index_etag_.c_str()))
+    return;
   AsyncResponseStream *stream = request->beginResponseStream("text/html");
   std::string title = App.get_name() + " Web Server";
   stream->print(F("<!DOCTYPE html><html lang=\"en\"><head><meta charset=UTF-8>"
@@ -185,6 +438,8 @@ void WebServer::handle_index_request(AsyncWebServerRequest *request) {
   stream->print(F("</h1><h2>States</h2><table id=\"states\"><thead><tr><th>Name<th>State<th>Actions<tbody>"));
   // All content is controlled and created by user - so allowing all origins is fine here.
   stream->addHeader("Access-Control-Allow-Origin", "*");
+  stream->addHeader("ETag", this->index_etag_.c_str());
+  stream->addHeader("Cache-Control", "no-cache");
 
 #ifdef USE_SENSOR
   for (auto *obj : App.get_sensors())
@@ -281,157 +536,163 @@ void WebServer::handle_index_request(AsyncWebServerRequest *request) {
 
 #ifdef WEBSERVER_CSS_INCLUDE
 void WebServer::handle_css_request(AsyncWebServerRequest *request) {
-  AsyncResponseStream *stream = request->beginResponseStream("text/css");
-  if (this->css_include_ != nullptr) {
-    stream->print(this->css_include_);
+  if (this->css_include_ == nullptr) {
+    request->send(404);
+    return;
   }
-
-  request->send(stream);
+  this->send_compressed_asset_(request, "text/css", this->css_include_, this->css_include_length_,
+                               this->css_include_etag_);
 }
 #endif
 
 #ifdef WEBSERVER_JS_INCLUDE
 void WebServer::handle_js_request(AsyncWebServerRequest *request) {
-  AsyncResponseStream *stream = request->beginResponseStream("text/javascript");
-  if (this->js_include_ != nullptr) {
-    stream->print(this->js_include_);
+  if (this->js_include_ == nullptr) {
+    request->send(404);
+    return;
   }
+  this->send_compressed_asset_(request, "text/javascript", this->js_include_, this->js_include_length_,
+                               this->js_include_etag_);
+}
+#endif
 
+void WebServer::send_state_event_(const json::json_build_t &f) {
+  if (json::build_json(f, this->event_buffer_))
+    this->events_.send(this->event_buffer_.c_str(), "state");
+}
+void WebServer::send_json_response_(AsyncWebServerRequest *request, const json::json_build_t &f) {
+  AsyncResponseStream *stream = request->beginResponseStream("text/json");
+  json::build_json(f, *stream);
   request->send(stream);
 }
-#endif
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  this->events_.send(this->sensor_json(obj, state).c_str(), "state");
+  this->mark_changed_(obj);
+  this->send_state_event_(this->sensor_json(obj, state));
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (sensor::Sensor *obj : App.get_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  auto *obj = App.get_sensor_by_key(fnv1_hash(match.id), true);
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
     return;
   }
-  request->send(404);
+  this->send_json_response_(request, this->sensor_json(obj, obj->state));
 }
-std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
-  return json::build_json([obj, value](JsonObject root) {
+json::json_build_t WebServer::sensor_json(sensor::Sensor *obj, float value) {
+  return [obj, value](JsonObject root) {
     root["id"] = "sensor-" + obj->get_object_id();
     std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
     if (!obj->get_unit_of_measurement().empty())
       state += " " + obj->get_unit_of_measurement();
     root["state"] = state;
     root["value"] = value;
-  });
+  };
 }
 #endif
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  this->events_.send(this->text_sensor_json(obj, state).c_str(), "state");
+  this->mark_changed_(obj);
+  this->send_state_event_(this->text_sensor_json(obj, state));
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->text_sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  auto *obj = App.get_text_sensor_by_key(fnv1_hash(match.id), true);
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
     return;
   }
-  request->send(404);
+  this->send_json_response_(request, this->text_sensor_json(obj, obj->state));
 }
-std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject root) {
+json::json_build_t WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value) {
+  return [obj, value](JsonObject root) {
     root["id"] = "text_sensor-" + obj->get_object_id();
     root["state"] = value;
     root["value"] = value;
-  });
+  };
 }
 #endif
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  this->events_.send(this->switch_json(obj, state).c_str(), "state");
+  this->mark_changed_(obj);
+  this->send_state_event_(this->switch_json(obj, state));
 }
-std::string WebServer::switch_json(switch_::Switch *obj, bool value) {
-  return json::build_json([obj, value](JsonObject root) {
+json::json_build_t WebServer::switch_json(switch_::Switch *obj, bool value) {
+  return [obj, value](JsonObject root) {
     root["id"] = "switch-" + obj->get_object_id();
     root["state"] = value ? "ON" : "OFF";
     root["value"] = value;
-  });
+  };
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (switch_::Switch *obj : App.get_switches()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->switch_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      this->defer([obj]() { obj->turn_on(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->defer([obj]() { obj->turn_off(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  auto *obj = App.get_switch_by_key(fnv1_hash(match.id), true);
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
     return;
   }
-  request->send(404);
+  if (request->method() == HTTP_GET) {
+    this->send_json_response_(request, this->switch_json(obj, obj->state));
+  } else if (match.method == "toggle") {
+    this->defer([obj]() { obj->toggle(); });
+    request->send(200);
+  } else if (match.method == "turn_on") {
+    this->defer([obj]() { obj->turn_on(); });
+    request->send(200);
+  } else if (match.method == "turn_off") {
+    this->defer([obj]() { obj->turn_off(); });
+    request->send(200);
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
 #ifdef USE_BUTTON
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (button::Button *obj : App.get_buttons()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_POST && match.method == "press") {
-      this->defer([obj]() { obj->press(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  auto *obj = App.get_button_by_key(fnv1_hash(match.id), true);
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
     return;
   }
-  request->send(404);
+  if (request->method() == HTTP_POST && match.method == "press") {
+    this->defer([obj]() { obj->press(); });
+    request->send(200);
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  this->events_.send(this->binary_sensor_json(obj, state).c_str(), "state");
+  this->mark_changed_(obj);
+  this->send_state_event_(this->binary_sensor_json(obj, state));
 }
-std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value) {
-  return json::build_json([obj, value](JsonObject root) {
+json::json_build_t WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value) {
+  return [obj, value](JsonObject root) {
     root["id"] = "binary_sensor-" + obj->get_object_id();
     root["state"] = value ? "ON" : "OFF";
     root["value"] = value;
-  });
+  };
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->binary_sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  auto *obj = App.get_binary_sensor_by_key(fnv1_hash(match.id), true);
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
     return;
   }
-  request->send(404);
+  this->send_json_response_(request, this->binary_sensor_json(obj, obj->state));
 }
 #endif
 
 #ifdef USE_FAN
-void WebServer::on_fan_update(fan::FanState *obj) { this->events_.send(this->fan_json(obj).c_str(), "state"); }
-std::string WebServer::fan_json(fan::FanState *obj) {
-  return json::build_json([obj](JsonObject root) {
+void WebServer::on_fan_update(fan::FanState *obj) {
+  this->mark_changed_(obj);
+  this->send_state_event_(this->fan_json(obj));
+}
+json::json_build_t WebServer::fan_json(fan::FanState *obj) {
+  return [obj](JsonObject root) {
     root["id"] = "fan-" + obj->get_object_id();
     root["state"] = obj->state ? "ON" : "OFF";
     root["value"] = obj->state;
@@ -456,183 +717,180 @@ std::string WebServer::fan_json(fan::FanState *obj) {
     }
     if (obj->get_traits().supports_oscillation())
       root["oscillation"] = obj->oscillating;
-  });
+  };
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (fan::FanState *obj : App.get_fans()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->fan_json(obj);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("speed")) {
-        String speed = request->getParam("speed")->value();
+  auto *obj = App.get_fan_by_key(fnv1_hash(match.id), true);
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
+    return;
+  }
+  if (request->method() == HTTP_GET) {
+    this->send_json_response_(request, this->fan_json(obj));
+  } else if (match.method == "toggle") {
+    this->defer([obj]() { obj->toggle().perform(); });
+    request->send(200);
+  } else if (match.method == "turn_on") {
+    auto call = obj->turn_on();
+    if (request->hasParam("speed")) {
+      String speed = request->getParam("speed")->value();
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-        call.set_speed(speed.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
+      call.set_speed(speed.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
 #pragma GCC diagnostic pop
+    }
+    if (request->hasParam("speed_level")) {
+      String speed_level = request->getParam("speed_level")->value();
+      auto val = parse_number<int>(speed_level.c_str());
+      if (!val.has_value()) {
+        ESP_LOGW(TAG, "Can't convert '%s' to number!", speed_level.c_str());
+        return;
       }
-      if (request->hasParam("speed_level")) {
-        String speed_level = request->getParam("speed_level")->value();
-        auto val = parse_number<int>(speed_level.c_str());
-        if (!val.has_value()) {
-          ESP_LOGW(TAG, "Can't convert '%s' to number!", speed_level.c_str());
+      call.set_speed(*val);
+    }
+    if (request->hasParam("oscillation")) {
+      String speed = request->getParam("oscillation")->value();
+      auto val = parse_on_off(speed.c_str());
+      switch (val) {
+        case PARSE_ON:
+          call.set_oscillating(true);
+          break;
+        case PARSE_OFF:
+          call.set_oscillating(false);
+          break;
+        case PARSE_TOGGLE:
+          call.set_oscillating(!obj->oscillating);
+          break;
+        case PARSE_NONE:
+          request->send(404);
           return;
-        }
-        call.set_speed(*val);
-      }
-      if (request->hasParam("oscillation")) {
-        String speed = request->getParam("oscillation")->value();
-        auto val = parse_on_off(speed.c_str());
-        switch (val) {
-          case PARSE_ON:
-            call.set_oscillating(true);
-            break;
-          case PARSE_OFF:
-            call.set_oscillating(false);
-            break;
-          case PARSE_TOGGLE:
-            call.set_oscillating(!obj->oscillating);
-            break;
-          case PARSE_NONE:
-            request->send(404);
-            return;
-        }
       }
-      this->defer([call]() { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->defer([obj]() { obj->turn_off().perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
     }
-    return;
+    this->defer([call]() { call.perform(); });
+    request->send(200);
+  } else if (match.method == "turn_off") {
+    this->defer([obj]() { obj->turn_off().perform(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 #endif
 
 #ifdef USE_LIGHT
-void WebServer::on_light_update(light::LightState *obj) { this->events_.send(this->light_json(obj).c_str(), "state"); }
+void WebServer::on_light_update(light::LightState *obj) {
+  this->mark_changed_(obj);
+  this->send_state_event_(this->light_json(obj));
+}
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (light::LightState *obj : App.get_lights()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->light_json(obj);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("brightness"))
-        call.set_brightness(request->getParam("brightness")->value().toFloat() / 255.0f);
-      if (request->hasParam("r"))
-        call.set_red(request->getParam("r")->value().toFloat() / 255.0f);
-      if (request->hasParam("g"))
-        call.set_green(request->getParam("g")->value().toFloat() / 255.0f);
-      if (request->hasParam("b"))
-        call.set_blue(request->getParam("b")->value().toFloat() / 255.0f);
-      if (request->hasParam("white_value"))
-        call.set_white(request->getParam("white_value")->value().toFloat() / 255.0f);
-      if (request->hasParam("color_temp"))
-        call.set_color_temperature(request->getParam("color_temp")->value().toFloat());
-
-      if (request->hasParam("flash")) {
-        float length_s = request->getParam("flash")->value().toFloat();
-        call.set_flash_length(static_cast<uint32_t>(length_s * 1000));
-      }
+  auto *obj = App.get_light_by_key(fnv1_hash(match.id), true);
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
+    return;
+  }
+  if (request->method() == HTTP_GET) {
+    this->send_json_response_(request, this->light_json(obj));
+  } else if (match.method == "toggle") {
+    this->defer([obj]() { obj->toggle().perform(); });
+    request->send(200);
+  } else if (match.method == "turn_on") {
+    auto call = obj->turn_on();
+    if (request->hasParam("brightness"))
+      call.set_brightness(request->getParam("brightness")->value().toFloat() / 255.0f);
+    if (request->hasParam("r"))
+      call.set_red(request->getParam("r")->value().toFloat() / 255.0f);
+    if (request->hasParam("g"))
+      call.set_green(request->getParam("g")->value().toFloat() / 255.0f);
+    if (request->hasParam("b"))
+      call.set_blue(request->getParam("b")->value().toFloat() / 255.0f);
+    if (request->hasParam("white_value"))
+      call.set_white(request->getParam("white_value")->value().toFloat() / 255.0f);
+    if (request->hasParam("color_temp"))
+      call.set_color_temperature(request->getParam("color_temp")->value().toFloat());
+
+    if (request->hasParam("flash")) {
+      float length_s = request->getParam("flash")->value().toFloat();
+      call.set_flash_length(static_cast<uint32_t>(length_s * 1000));
+    }
 
-      if (request->hasParam("transition")) {
-        float length_s = request->getParam("transition")->value().toFloat();
-        call.set_transition_length(static_cast<uint32_t>(length_s * 1000));
-      }
+    if (request->hasParam("transition")) {
+      float length_s = request->getParam("transition")->value().toFloat();
+      call.set_transition_length(static_cast<uint32_t>(length_s * 1000));
+    }
 
-      if (request->hasParam("effect")) {
-        const char *effect = request->getParam("effect")->value().c_str();
-        call.set_effect(effect);
-      }
+    if (request->hasParam("effect")) {
+      const char *effect = request->getParam("effect")->value().c_str();
+      call.set_effect(effect);
+    }
 
-      this->defer([call]() mutable { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      auto call = obj->turn_off();
-      if (request->hasParam("transition")) {
-        auto length = (uint32_t) request->getParam("transition")->value().toFloat() * 1000;
-        call.set_transition_length(length);
-      }
-      this->defer([call]() mutable { call.perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
+    this->defer([call]() mutable { call.perform(); });
+    request->send(200);
+  } else if (match.method == "turn_off") {
+    auto call = obj->turn_off();
+    if (request->hasParam("transition")) {
+      auto length = (uint32_t) request->getParam("transition")->value().toFloat() * 1000;
+      call.set_transition_length(length);
     }
-    return;
+    this->defer([call]() mutable { call.perform(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
-std::string WebServer::light_json(light::LightState *obj) {
-  return json::build_json([obj](JsonObject root) {
+json::json_build_t WebServer::light_json(light::LightState *obj) {
+  return [obj](JsonObject root) {
     root["id"] = "light-" + obj->get_object_id();
     root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
     light::LightJSONSchema::dump_json(*obj, root);
-  });
+  };
 }
 #endif
 
 #ifdef USE_COVER
-void WebServer::on_cover_update(cover::Cover *obj) { this->events_.send(this->cover_json(obj).c_str(), "state"); }
+void WebServer::on_cover_update(cover::Cover *obj) {
+  this->mark_changed_(obj);
+  this->send_state_event_(this->cover_json(obj));
+}
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (cover::Cover *obj : App.get_covers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->cover_json(obj);
-      request->send(200, "text/json", data.c_str());
-      continue;
-    }
-
-    auto call = obj->make_call();
-    if (match.method == "open") {
-      call.set_command_open();
-    } else if (match.method == "close") {
-      call.set_command_close();
-    } else if (match.method == "stop") {
-      call.set_command_stop();
-    } else if (match.method != "set") {
-      request->send(404);
-      return;
-    }
-
-    auto traits = obj->get_traits();
-    if ((request->hasParam("position") && !traits.get_supports_position()) ||
-        (request->hasParam("tilt") && !traits.get_supports_tilt())) {
-      request->send(409);
-      return;
-    }
+  auto *obj = App.get_cover_by_key(fnv1_hash(match.id), true);
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
+    return;
+  }
+  if (request->method() == HTTP_GET) {
+    this->send_json_response_(request, this->cover_json(obj));
+    return;
+  }
 
-    if (request->hasParam("position"))
-      call.set_position(request->getParam("position")->value().toFloat());
-    if (request->hasParam("tilt"))
-      call.set_tilt(request->getParam("tilt")->value().toFloat());
+  auto call = obj->make_call();
+  if (match.method == "open") {
+    call.set_command_open();
+  } else if (match.method == "close") {
+    call.set_command_close();
+  } else if (match.method == "stop") {
+    call.set_command_stop();
+  } else if (match.method != "set") {
+    request->send(404);
+    return;
+  }
 
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
+  auto traits = obj->get_traits();
+  if ((request->hasParam("position") && !traits.get_supports_position()) ||
+      (request->hasParam("tilt") && !traits.get_supports_tilt())) {
+    request->send(409);
     return;
   }
-  request->send(404);
+
+  if (request->hasParam("position"))
+    call.set_position(request->getParam("position")->value().toFloat());
+  if (request->hasParam("tilt"))
+    call.set_tilt(request->getParam("tilt")->value().toFloat());
+
+  this->defer([call]() mutable { call.perform(); });
+  request->send(200);
 }
-std::string WebServer::cover_json(cover::Cover *obj) {
-  return json::build_json([obj](JsonObject root) {
+json::json_build_t WebServer::cover_json(cover::Cover *obj) {
+  return [obj](JsonObject root) {
     root["id"] = "cover-" + obj->get_object_id();
     root["state"] = obj->is_fully_closed() ? "CLOSED" : "OPEN";
     root["value"] = obj->position;
@@ -640,89 +898,96 @@ std::string WebServer::cover_json(cover::Cover *obj) {
 
     if (obj->get_traits().get_supports_tilt())
       root["tilt"] = obj->tilt;
-  });
+  };
 }
 #endif
 
 #ifdef USE_NUMBER
 void WebServer::on_number_update(number::Number *obj, float state) {
-  this->events_.send(this->number_json(obj, state).c_str(), "state");
+  this->mark_changed_(obj);
+  this->send_state_event_(this->number_json(obj, state));
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_numbers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->number_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  auto *obj = App.get_number_by_key(fnv1_hash(match.id), true);
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
     return;
   }
-  request->send(404);
+  this->send_json_response_(request, this->number_json(obj, obj->state));
 }
-std::string WebServer::number_json(number::Number *obj, float value) {
-  return json::build_json([obj, value](JsonObject root) {
+json::json_build_t WebServer::number_json(number::Number *obj, float value) {
+  return [obj, value](JsonObject root) {
     root["id"] = "number-" + obj->get_object_id();
     char buffer[64];
     snprintf(buffer, sizeof(buffer), "%f", value);
     root["state"] = buffer;
     root["value"] = value;
-  });
+  };
 }
 #endif
 
 #ifdef USE_SELECT
 void WebServer::on_select_update(select::Select *obj, const std::string &state) {
-  this->events_.send(this->select_json(obj, state).c_str(), "state");
+  this->mark_changed_(obj);
+  this->send_state_event_(this->select_json(obj, state));
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_selects()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->select_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-      return;
-    }
-
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  auto *obj = App.get_select_by_key(fnv1_hash(match.id), true);
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
+    return;
+  }
+  if (request->method() == HTTP_GET) {
+    this->send_json_response_(request, this->select_json(obj, obj->state));
+    return;
+  }
 
-    auto call = obj->make_call();
+  if (match.method != "set") {
+    request->send(404);
+    return;
+  }
 
-    if (request->hasParam("option")) {
-      String option = request->getParam("option")->value();
-      call.set_option(option.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
-    }
+  auto call = obj->make_call();
 
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
+  if (request->hasParam("option")) {
+    String option = request->getParam("option")->value();
+    call.set_option(option.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
   }
-  request->send(404);
+
+  this->defer([call]() mutable { call.perform(); });
+  request->send(200);
 }
-std::string WebServer::select_json(select::Select *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject root) {
+json::json_build_t WebServer::select_json(select::Select *obj, const std::string &value) {
+  return [obj, value](JsonObject root) {
     root["id"] = "select-" + obj->get_object_id();
     root["state"] = value;
     root["value"] = value;
-  });
+  };
 }
 #endif
 
 bool WebServer::canHandle(AsyncWebServerRequest *request) {
-  if (request->url() == "/")
+  if (request->url() == "/states")
+    return request->method() == HTTP_GET;
+
+  // Headers are dropped after canHandle() unless a handler asks for them
+  if (request->url() == "/") {
+    request->addInterestingHeader("If-None-Match");
     return true;
+  }
 
 #ifdef WEBSERVER_CSS_INCLUDE
-  if (request->url() == "/0.css")
+  if (request->url() == "/0.css") {
+    request->addInterestingHeader("If-None-Match");
     return true;
+  }
 #endif
 
 #ifdef WEBSERVER_JS_INCLUDE
-  if (request->url() == "/0.js")
+  if (request->url() == "/0.js") {
+    request->addInterestingHeader("If-None-Match");
     return true;
+  }
 #endif
 
   UrlMatch match = match_url(request->url().c_str(), true);
@@ -786,6 +1051,11 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
     return;
   }
 
+  if (request->url() == "/states") {
+    this->handle_states_request(request);
+    return;
+  }
+
 #ifdef WEBSERVER_CSS_INCLUDE
   if (request->url() == "/0.css") {
     this->handle_css_request(request);
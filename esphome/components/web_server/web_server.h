@@ -4,13 +4,17 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
+#include "esphome/components/json/json_util.h"
 #include "esphome/components/web_server_base/web_server_base.h"
 
+#include <atomic>
 #include <vector>
 
 namespace esphome {
 namespace web_server {
 
+struct StatesCursor;
+
 /// Internal helper struct that is used to parse incoming URLs
 struct UrlMatch {
   std::string domain;  ///< The domain of the component, for example "sensor"
@@ -39,11 +43,13 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    */
   void set_css_url(const char *css_url);
 
-  /** Set local path to the script that's embedded in the index page. Defaults to
+  /** Set the stylesheet that's served under /0.css and linked from the index page.
    *
-   * @param css_include Local path to web server script.
+   * @param css_include The gzip-compressed stylesheet, stored in flash.
+   * @param length The length of the compressed stylesheet.
+   * @param etag The quoted ETag of the stylesheet.
    */
-  void set_css_include(const char *css_include);
+  void set_css_include(const uint8_t *css_include, size_t length, const char *etag);
 
   /** Set the URL to the script that's embedded in the index page. Defaults to
    * https://esphome.io/_static/webserver-v1.min.js
@@ -52,11 +58,13 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    */
   void set_js_url(const char *js_url);
 
-  /** Set local path to the script that's embedded in the index page. Defaults to
+  /** Set the script that's served under /0.js and embedded in the index page.
    *
-   * @param js_include Local path to web server script.
+   * @param js_include The gzip-compressed script, stored in flash.
+   * @param length The length of the compressed script.
+   * @param etag The quoted ETag of the script.
    */
-  void set_js_include(const char *js_include);
+  void set_js_include(const uint8_t *js_include, size_t length, const char *etag);
 
   /** Determine whether internal components should be displayed on the web server.
    * Defaults to false.
@@ -74,6 +82,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   // (In most use cases you won't need these)
   /// Setup the internal web server and register handlers.
   void setup() override;
+  /// Send the states to new event clients, a few at a time.
+  void loop() override;
 
   void dump_config() override;
 
@@ -83,6 +93,13 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle an index request under '/'.
   void handle_index_request(AsyncWebServerRequest *request);
 
+  /** Handle a request for the states of all entities under '/states'.
+   *
+   * ?domain=<domain> only returns entities of that domain. ?since=<seq> only returns entities that changed after the
+   * sequence number returned by an earlier request, waiting up to 25s for a change if there wasn't one.
+   */
+  void handle_states_request(AsyncWebServerRequest *request);
+
 #ifdef WEBSERVER_CSS_INCLUDE
   /// Handle included css request under '/0.css'.
   void handle_css_request(AsyncWebServerRequest *request);
@@ -98,8 +115,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a sensor request under '/sensor/<id>'.
   void handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the sensor state with its value as a JSON string.
-  std::string sensor_json(sensor::Sensor *obj, float value);
+  /// Build the sensor state with its value as a JSON document.
+  json::json_build_t sensor_json(sensor::Sensor *obj, float value);
 #endif
 
 #ifdef USE_SWITCH
@@ -108,8 +125,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a switch request under '/switch/<id>/</turn_on/turn_off/toggle>'.
   void handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the switch state with its value as a JSON string.
-  std::string switch_json(switch_::Switch *obj, bool value);
+  /// Build the switch state with its value as a JSON document.
+  json::json_build_t switch_json(switch_::Switch *obj, bool value);
 #endif
 
 #ifdef USE_BUTTON
@@ -123,8 +140,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a binary sensor request under '/binary_sensor/<id>'.
   void handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the binary sensor state with its value as a JSON string.
-  std::string binary_sensor_json(binary_sensor::BinarySensor *obj, bool value);
+  /// Build the binary sensor state with its value as a JSON document.
+  json::json_build_t binary_sensor_json(binary_sensor::BinarySensor *obj, bool value);
 #endif
 
 #ifdef USE_FAN
@@ -133,8 +150,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a fan request under '/fan/<id>/</turn_on/turn_off/toggle>'.
   void handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the fan state as a JSON string.
-  std::string fan_json(fan::FanState *obj);
+  /// Build the fan state as a JSON document.
+  json::json_build_t fan_json(fan::FanState *obj);
 #endif
 
 #ifdef USE_LIGHT
@@ -143,8 +160,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a light request under '/light/<id>/</turn_on/turn_off/toggle>'.
   void handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the light state as a JSON string.
-  std::string light_json(light::LightState *obj);
+  /// Build the light state as a JSON document.
+  json::json_build_t light_json(light::LightState *obj);
 #endif
 
 #ifdef USE_TEXT_SENSOR
@@ -153,8 +170,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a text sensor request under '/text_sensor/<id>'.
   void handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the text sensor state with its value as a JSON string.
-  std::string text_sensor_json(text_sensor::TextSensor *obj, const std::string &value);
+  /// Build the text sensor state with its value as a JSON document.
+  json::json_build_t text_sensor_json(text_sensor::TextSensor *obj, const std::string &value);
 #endif
 
 #ifdef USE_COVER
@@ -163,8 +180,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a cover request under '/cover/<id>/<open/close/stop/set>'.
   void handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the cover state as a JSON string.
-  std::string cover_json(cover::Cover *obj);
+  /// Build the cover state as a JSON document.
+  json::json_build_t cover_json(cover::Cover *obj);
 #endif
 
 #ifdef USE_NUMBER
@@ -172,8 +189,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a number request under '/number/<id>'.
   void handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the number state with its value as a JSON string.
-  std::string number_json(number::Number *obj, float value);
+  /// Build the number state with its value as a JSON document.
+  json::json_build_t number_json(number::Number *obj, float value);
 #endif
 
 #ifdef USE_SELECT
@@ -181,8 +198,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle a select request under '/select/<id>'.
   void handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match);
 
-  /// Dump the number state with its value as a JSON string.
-  std::string select_json(select::Select *obj, const std::string &value);
+  /// Build the number state with its value as a JSON document.
+  json::json_build_t select_json(select::Select *obj, const std::string &value);
 #endif
 
   /// Override the web handler's canHandle method.
@@ -193,12 +210,52 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   bool isRequestHandlerTrivial() override;
 
  protected:
+  /// Send the state built by f to all event clients, serialized into the reused event_buffer_.
+  void send_state_event_(const json::json_build_t &f);
+  /// Respond to request with the JSON document built by f, serialized straight into the response stream.
+  void send_json_response_(AsyncWebServerRequest *request, const json::json_build_t &f);
+  /** Check if the client already has the response tagged etag, answering 304 if it does.
+   *
+   * @return true if the request was answered.
+   */
+  bool handle_cached_request_(AsyncWebServerRequest *request, const char *etag);
+  /// Serve a gzip-compressed asset stored in flash.
+  void send_compressed_asset_(AsyncWebServerRequest *request, const char *content_type, const uint8_t *data,
+                              size_t length, const char *etag);
+  /** Get the entity at index, counting through all entity types. Returns false past the last one.
+   *
+   * obj is set to nullptr if the entity isn't shown, otherwise domain and json are set to its domain and state.
+   */
+  bool entity_at_(size_t index, EntityBase *&obj, const char *&domain, json::json_build_t &json);
+  /// Record that the state of obj changed, for /states?since=.
+  void mark_changed_(EntityBase *obj);
+  /// Render the next part of a /states response into cursor.pending, returns false when it's complete.
+  bool render_next_state_(StatesCursor &cursor);
+  /// Send the state of the entity at index, counting through all entity types. Returns false past the last one.
+  bool send_initial_state_(size_t index);
+
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
+  std::string event_buffer_;
+  /// Set from the web server's task when an event client connects.
+  std::atomic<bool> initial_state_requested_{false};
+  bool sending_initial_state_{false};
+  size_t initial_state_index_{0};
+  /// All entities in entity_at_() order (nullptr for the ones that aren't shown) and the sequence number of their
+  /// last change. Both are filled in setup() and only the sequence numbers change afterwards.
+  std::vector<EntityBase *> entities_;
+  std::vector<uint32_t> changed_seq_;
+  std::atomic<uint32_t> state_seq_{0};
   const char *css_url_{nullptr};
-  const char *css_include_{nullptr};
+  const uint8_t *css_include_{nullptr};
+  size_t css_include_length_{0};
+  const char *css_include_etag_{nullptr};
   const char *js_url_{nullptr};
-  const char *js_include_{nullptr};
+  const uint8_t *js_include_{nullptr};
+  size_t js_include_length_{0};
+  const char *js_include_etag_{nullptr};
+  /// The index page only changes with the firmware, this is a hash of the compilation time.
+  std::string index_etag_;
   bool include_internal_{false};
   bool allow_ota_{true};
 };
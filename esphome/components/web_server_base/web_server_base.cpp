@@ -4,6 +4,7 @@
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 #include <StreamString.h>
+#include <cmath>
 
 #ifdef USE_ESP32
 #include <Update.h>
@@ -34,6 +35,25 @@ void report_ota_error() {
   ESP_LOGW(TAG, "OTA Update failed! Error: %s", ss.c_str());
 }
 
+float OTARequestHandler::progress_(AsyncWebServerRequest *request) const {
+  // the content length includes the multipart headers, which is close enough for a progress
+  if (request->contentLength() == 0)
+    return NAN;
+  return (this->ota_read_length_ * 100.0f) / request->contentLength();
+}
+void OTARequestHandler::abort_() {
+  if (!this->uploading_)
+    return;
+  this->uploading_ = false;
+  ESP_LOGW(TAG, "OTA Update aborted, the client disconnected after %u bytes", this->ota_read_length_);
+#ifdef USE_ESP8266
+  Update.end();
+#endif
+#ifdef USE_ESP32
+  Update.abort();
+#endif
+  this->parent_->ota_state_callback_.call(OTA_UPLOAD_ABORTED, NAN);
+}
 void OTARequestHandler::handleUpload(AsyncWebServerRequest *request, const String &filename, size_t index,
                                      uint8_t *data, size_t len, bool final) {
   bool success;
@@ -52,9 +72,13 @@ void OTARequestHandler::handleUpload(AsyncWebServerRequest *request, const Strin
 #endif
     if (!success) {
       report_ota_error();
+      this->parent_->ota_state_callback_.call(OTA_UPLOAD_ERROR, NAN);
       return;
     }
-  } else if (Update.hasError()) {
+    this->uploading_ = true;
+    request->onDisconnect([this]() { this->abort_(); });
+    this->parent_->ota_state_callback_.call(OTA_UPLOAD_STARTED, 0.0f);
+  } else if (Update.hasError() || !this->uploading_) {
     // don't spam logs with errors if something failed at start
     return;
   }
@@ -62,27 +86,33 @@ void OTARequestHandler::handleUpload(AsyncWebServerRequest *request, const Strin
   success = Update.write(data, len) == len;
   if (!success) {
     report_ota_error();
+    this->uploading_ = false;
+    this->parent_->ota_state_callback_.call(OTA_UPLOAD_ERROR, this->progress_(request));
     return;
   }
   this->ota_read_length_ += len;
 
   const uint32_t now = millis();
   if (now - this->last_ota_progress_ > 1000) {
-    if (request->contentLength() != 0) {
-      float percentage = (this->ota_read_length_ * 100.0f) / request->contentLength();
+    float percentage = this->progress_(request);
+    if (!std::isnan(percentage)) {
       ESP_LOGD(TAG, "OTA in progress: %0.1f%%", percentage);
     } else {
       ESP_LOGD(TAG, "OTA in progress: %u bytes read", this->ota_read_length_);
     }
+    this->parent_->ota_state_callback_.call(OTA_UPLOAD_IN_PROGRESS, percentage);
     this->last_ota_progress_ = now;
   }
 
   if (final) {
+    this->uploading_ = false;
     if (Update.end(true)) {
       ESP_LOGI(TAG, "OTA update successful!");
+      this->parent_->ota_state_callback_.call(OTA_UPLOAD_COMPLETED, 100.0f);
       this->parent_->set_timeout(100, []() { App.safe_reboot(); });
     } else {
       report_ota_error();
+      this->parent_->ota_state_callback_.call(OTA_UPLOAD_ERROR, 100.0f);
     }
   }
 }
@@ -5,6 +5,7 @@
 #include <memory>
 #include <utility>
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 
 #include <ESPAsyncWebServer.h>
 
@@ -57,22 +58,39 @@ class AuthMiddlewareHandler : public MiddlewareHandler {
   }
   void handleUpload(AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len,
                     bool final) override {
-    if (!check_auth(request))
+    if (!check_chunk_auth(request, index))
       return;
     MiddlewareHandler::handleUpload(request, filename, index, data, len, final);
   }
   void handleBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) override {
-    if (!check_auth(request))
+    if (!check_chunk_auth(request, index))
       return;
     MiddlewareHandler::handleBody(request, data, len, index, total);
   }
 
  protected:
+  /// Check the credentials with the first chunk of a body only, the following chunks belong to the same request.
+  bool check_chunk_auth(AsyncWebServerRequest *request, size_t index) {
+    if (index != 0)
+      return request == this->authenticated_;
+    this->authenticated_ = check_auth(request) ? request : nullptr;
+    return this->authenticated_ != nullptr;
+  }
+
   Credentials *credentials_;
+  AsyncWebServerRequest *authenticated_{nullptr};
 };
 
 }  // namespace internal
 
+enum OTAUploadState {
+  OTA_UPLOAD_STARTED = 0,
+  OTA_UPLOAD_IN_PROGRESS,
+  OTA_UPLOAD_COMPLETED,
+  OTA_UPLOAD_ERROR,
+  OTA_UPLOAD_ABORTED,
+};
+
 class WebServerBase : public Component {
  public:
   void init() {
@@ -103,6 +121,10 @@ class WebServerBase : public Component {
   void add_handler(AsyncWebHandler *handler);
 
   void add_ota_handler();
+  /// Get notified about uploads to the OTA handler, with the progress in percent (NAN if the size is unknown).
+  void add_on_ota_state_callback(std::function<void(OTAUploadState, float)> &&callback) {
+    this->ota_state_callback_.add(std::move(callback));
+  }
 
   void set_port(uint16_t port) { port_ = port; }
   uint16_t get_port() const { return port_; }
@@ -115,6 +137,7 @@ class WebServerBase : public Component {
   std::shared_ptr<AsyncWebServer> server_{nullptr};
   std::vector<AsyncWebHandler *> handlers_;
   internal::Credentials credentials_;
+  CallbackManager<void(OTAUploadState, float)> ota_state_callback_;
 };
 
 class OTARequestHandler : public AsyncWebHandler {
@@ -130,8 +153,13 @@ class OTARequestHandler : public AsyncWebHandler {
   bool isRequestHandlerTrivial() override { return false; }
 
  protected:
+  float progress_(AsyncWebServerRequest *request) const;
+  /// Abort an upload that didn't finish, when its client disconnected.
+  void abort_();
+
   uint32_t last_ota_progress_{0};
   uint32_t ota_read_length_{0};
+  bool uploading_{false};
   WebServerBase *parent_;
 };
 
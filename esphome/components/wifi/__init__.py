@@ -32,6 +32,7 @@ from esphome.const import (
     CONF_EAP,
 )
 from esphome.core import CORE, HexInt, coroutine_with_priority
+from esphome.components.esp32 import add_idf_sdkconfig_option
 from esphome.components.network import IPAddress
 from . import wpa2_eap
 
@@ -220,6 +221,11 @@ def _validate(config):
         if len(networks) != 1:
             raise cv.Invalid("Fast connect can only be used with one network!")
 
+    if config.get(CONF_REUSE_DHCP_ADDRESS, False) and not config.get(
+        CONF_FAST_RECONNECT, False
+    ):
+        raise cv.Invalid("reuse_dhcp_address requires fast_reconnect!")
+
     if CONF_USE_ADDRESS not in config:
         use_address = CORE.name + config[CONF_DOMAIN]
         if CONF_MANUAL_IP in config:
@@ -243,6 +249,8 @@ def _validate(config):
 
 
 CONF_OUTPUT_POWER = "output_power"
+CONF_FAST_RECONNECT = "fast_reconnect"
+CONF_REUSE_DHCP_ADDRESS = "reuse_dhcp_address"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -261,6 +269,8 @@ CONFIG_SCHEMA = cv.All(
                 CONF_POWER_SAVE_MODE, esp8266="none", esp32="light"
             ): cv.enum(WIFI_POWER_SAVE_MODES, upper=True),
             cv.Optional(CONF_FAST_CONNECT, default=False): cv.boolean,
+            cv.Optional(CONF_FAST_RECONNECT, default=False): cv.boolean,
+            cv.Optional(CONF_REUSE_DHCP_ADDRESS, default=False): cv.boolean,
             cv.Optional(CONF_USE_ADDRESS): cv.string_strict,
             cv.SplitDefault(CONF_OUTPUT_POWER, esp8266=20.0): cv.All(
                 cv.decibel, cv.float_range(min=10.0, max=20.5)
@@ -358,6 +368,11 @@ async def to_code(config):
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
     cg.add(var.set_power_save_mode(config[CONF_POWER_SAVE_MODE]))
     cg.add(var.set_fast_connect(config[CONF_FAST_CONNECT]))
+    cg.add(var.set_fast_reconnect(config[CONF_FAST_RECONNECT]))
+    cg.add(var.set_reuse_dhcp_address(config[CONF_REUSE_DHCP_ADDRESS]))
+    if config[CONF_FAST_RECONNECT] and CORE.using_esp_idf:
+        # Ask the DHCP server for the last address again instead of starting over
+        add_idf_sdkconfig_option("CONFIG_LWIP_DHCP_RESTORE_LAST_IP", True)
     if CONF_OUTPUT_POWER in config:
         cg.add(var.set_output_power(config[CONF_OUTPUT_POWER]))
 
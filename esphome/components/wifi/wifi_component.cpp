@@ -9,6 +9,7 @@
 
 #include <utility>
 #include <algorithm>
+#include <cstring>
 #include "lwip/err.h"
 #include "lwip/dns.h"
 
@@ -26,6 +27,10 @@
 #include "esphome/components/esp32_improv/esp32_improv_component.h"
 #endif
 
+#ifdef USE_API
+#include "esphome/components/api/api_server.h"
+#endif
+
 namespace esphome {
 namespace wifi {
 
@@ -52,6 +57,7 @@ void WiFiComponent::setup() {
   }
 
   if (this->has_sta()) {
+    this->start_connect_timing_();
     this->wifi_sta_pre_setup_();
     if (this->output_power_.has_value() && !this->wifi_apply_output_power_(*this->output_power_)) {
       ESP_LOGV(TAG, "Setting Output Power Option failed!");
@@ -61,7 +67,9 @@ void WiFiComponent::setup() {
       ESP_LOGV(TAG, "Setting Power Save Option failed!");
     }
 
-    if (this->fast_connect_) {
+    if (this->fast_reconnect_ && this->load_fast_reconnect_settings_()) {
+      this->start_connecting(this->selected_ap_, false);
+    } else if (this->fast_connect_) {
       this->selected_ap_ = this->sta_[0];
       this->start_connecting(this->selected_ap_, false);
     } else {
@@ -117,11 +125,19 @@ void WiFiComponent::loop() {
       case WIFI_COMPONENT_STATE_STA_CONNECTED: {
         if (!this->is_connected()) {
           ESP_LOGW(TAG, "WiFi Connection lost... Reconnecting...");
+          this->start_connect_timing_();
           this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTING;
           this->retry_connect();
         } else {
           this->status_clear_warning();
           this->last_connected_ = now;
+#ifdef USE_API
+          if (this->connect_timing_.first_client == 0 && api::global_api_server != nullptr &&
+              api::global_api_server->is_connected()) {
+            this->connect_timing_.first_client = now;
+            ESP_LOGD(TAG, "First API client %ums after connecting", now - this->connect_timing_.connected);
+          }
+#endif
         }
         break;
       }
@@ -241,6 +257,70 @@ void WiFiComponent::save_wifi_sta(const std::string &ssid, const std::string &pa
   this->set_sta(sta);
 }
 
+bool WiFiComponent::load_fast_reconnect_settings_() {
+  this->fast_reconnect_pref_ =
+      global_preferences->make_preference<SavedWifiFastReconnectSettings>(fnv1_hash("wifi_fast_reconnect"), false);
+  SavedWifiFastReconnectSettings save{};
+  if (!this->fast_reconnect_pref_.load(&save))
+    return false;
+  // the configured networks may have changed since
+  if (save.ap_index >= this->sta_.size() || fnv1_hash(this->sta_[save.ap_index].get_ssid()) != save.ssid_hash)
+    return false;
+  this->fast_reconnect_settings_ = save;
+
+  WiFiAP ap = this->sta_[save.ap_index];
+  bssid_t bssid;
+  std::copy(save.bssid, save.bssid + 6, bssid.begin());
+  ap.set_bssid(bssid);
+  ap.set_channel(save.channel);
+  if (this->reuse_dhcp_address_ && save.ip != 0 && !ap.get_manual_ip().has_value()) {
+    // falls back to DHCP with the scan if this connect fails
+    ManualIP manual_ip;
+    manual_ip.static_ip = save.ip;
+    manual_ip.gateway = save.gateway;
+    manual_ip.subnet = save.subnet;
+    manual_ip.dns1 = save.dns1;
+    manual_ip.dns2 = save.dns2;
+    ap.set_manual_ip(manual_ip);
+    ESP_LOGD(TAG, "Reusing the address %s of the last connection", network::IPAddress(save.ip).str().c_str());
+  }
+  ESP_LOGD(TAG, "Connecting to the access point of the last connection");
+  this->selected_ap_ = ap;
+  this->fast_reconnect_pending_ = true;
+  return true;
+}
+
+void WiFiComponent::save_fast_reconnect_settings_() {
+  for (size_t i = 0; i < this->sta_.size(); i++) {
+    if (this->sta_[i].get_ssid() != this->selected_ap_.get_ssid())
+      continue;
+
+    SavedWifiFastReconnectSettings save{};
+    save.ssid_hash = fnv1_hash(this->sta_[i].get_ssid());
+    bssid_t bssid = this->wifi_bssid();
+    std::copy(bssid.begin(), bssid.end(), save.bssid);
+    save.channel = this->wifi_channel_();
+    save.ap_index = i;
+    // Only save the address of a real DHCP exchange. One that was reused from the last connection may not be leased
+    // to us any more, so the next connection asks the DHCP server again.
+    const bool reused = this->selected_ap_.get_manual_ip().has_value() && !this->sta_[i].get_manual_ip().has_value();
+    if (!this->sta_[i].get_manual_ip().has_value() && !reused) {
+      save.ip = this->wifi_sta_ip();
+      save.gateway = this->wifi_gateway_ip_();
+      save.subnet = this->wifi_subnet_mask_();
+      save.dns1 = this->wifi_dns_ip_(0);
+      save.dns2 = this->wifi_dns_ip_(1);
+    }
+    // on the ESP32 this is stored in flash, so only save when the access point changed
+    if (memcmp(&save, &this->fast_reconnect_settings_, sizeof(save)) == 0)
+      return;
+    ESP_LOGV(TAG, "Saving access point for fast reconnect");
+    this->fast_reconnect_settings_ = save;
+    this->fast_reconnect_pref_.save(&save);
+    return;
+  }
+}
+
 void WiFiComponent::start_connecting(const WiFiAP &ap, bool two) {
   ESP_LOGI(TAG, "WiFi Connecting to '%s'...", ap.get_ssid().c_str());
 #ifdef ESPHOME_LOG_HAS_VERBOSE
@@ -287,6 +367,9 @@ void WiFiComponent::start_connecting(const WiFiAP &ap, bool two) {
   ESP_LOGV(TAG, "  Hidden: %s", YESNO(ap.get_hidden()));
 #endif
 
+  this->connect_timing_.connecting = millis();
+  this->connect_timing_.associated = 0;
+  this->connect_timing_.got_ip = 0;
   if (!this->wifi_sta_connect_(ap)) {
     ESP_LOGE(TAG, "wifi_sta_connect_ failed!");
     this->retry_connect();
@@ -365,13 +448,52 @@ void WiFiComponent::print_connect_params_() {
   ESP_LOGCONFIG(TAG, "  DNS2: %s", wifi_dns_ip_(1).str().c_str());
 }
 
+void WiFiComponent::start_connect_timing_() {
+  uint32_t attempt = this->connect_timing_.attempt + 1;
+  this->connect_timing_ = {};
+  this->connect_timing_.attempt = attempt;
+  this->connect_timing_.started = millis();
+}
+
 void WiFiComponent::start_scanning() {
   this->action_started_ = millis();
+  this->connect_timing_.scan_started = this->action_started_;
   ESP_LOGD(TAG, "Starting scan...");
   this->wifi_scan_start_();
   this->state_ = WIFI_COMPONENT_STATE_STA_SCANNING;
 }
 
+// return true if a is better than b
+static bool is_better_scan_result(const WiFiScanResult &a, const WiFiScanResult &b) {
+  if (a.get_matches() && !b.get_matches())
+    return true;
+  if (!a.get_matches() && b.get_matches())
+    return false;
+
+  if (a.get_matches() && b.get_matches()) {
+    // if both match, check priority
+    if (a.get_priority() != b.get_priority())
+      return a.get_priority() > b.get_priority();
+  }
+
+  return a.get_rssi() > b.get_rssi();
+}
+
+void WiFiComponent::add_scan_result_(WiFiScanResult &&result) {
+  for (auto &ap : this->sta_) {
+    if (result.matches(ap)) {
+      result.set_matches(true);
+      break;
+    }
+  }
+  // the captive portal lists all networks
+  if (!result.get_matches() && !this->keep_scan_results_ && !this->is_captive_portal_active_()) {
+    this->scan_skipped_++;
+    return;
+  }
+  this->scan_result_.push_back(result);
+}
+
 void WiFiComponent::check_scanning_finished() {
   if (!this->scan_done_) {
     if (millis() - this->action_started_ > 30000) {
@@ -381,18 +503,24 @@ void WiFiComponent::check_scanning_finished() {
     return;
   }
   this->scan_done_ = false;
+  this->connect_timing_.scan_done = millis();
 
   ESP_LOGD(TAG, "Found networks:");
   if (this->scan_result_.empty()) {
-    ESP_LOGD(TAG, "  No network found!");
+    if (this->scan_skipped_ != 0) {
+      ESP_LOGD(TAG, "  No matching network among %u found!", this->scan_skipped_);
+    } else {
+      ESP_LOGD(TAG, "  No network found!");
+    }
     this->retry_connect();
     return;
   }
 
   for (auto &res : this->scan_result_) {
+    if (!res.get_matches())
+      continue;
     for (auto &ap : this->sta_) {
       if (res.matches(ap)) {
-        res.set_matches(true);
         if (!this->has_sta_priority(res.get_bssid())) {
           this->set_sta_priority(res.get_bssid(), ap.get_priority());
         }
@@ -402,22 +530,14 @@ void WiFiComponent::check_scanning_finished() {
     }
   }
 
-  std::stable_sort(this->scan_result_.begin(), this->scan_result_.end(),
-                   [](const WiFiScanResult &a, const WiFiScanResult &b) {
-                     // return true if a is better than b
-                     if (a.get_matches() && !b.get_matches())
-                       return true;
-                     if (!a.get_matches() && b.get_matches())
-                       return false;
-
-                     if (a.get_matches() && b.get_matches()) {
-                       // if both match, check priority
-                       if (a.get_priority() != b.get_priority())
-                         return a.get_priority() > b.get_priority();
-                     }
-
-                     return a.get_rssi() > b.get_rssi();
-                   });
+  // insertion sort: stable like std::stable_sort, but in place instead of with a temporary buffer
+  for (size_t i = 1; i < this->scan_result_.size(); i++) {
+    WiFiScanResult res = this->scan_result_[i];
+    size_t j = i;
+    for (; j > 0 && is_better_scan_result(res, this->scan_result_[j - 1]); j--)
+      this->scan_result_[j] = this->scan_result_[j - 1];
+    this->scan_result_[j] = res;
+  }
 
   for (auto &res : this->scan_result_) {
     char bssid_s[18];
@@ -425,16 +545,19 @@ void WiFiComponent::check_scanning_finished() {
     sprintf(bssid_s, "%02X:%02X:%02X:%02X:%02X:%02X", bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
 
     if (res.get_matches()) {
-      ESP_LOGI(TAG, "- '%s' %s" LOG_SECRET("(%s) ") "%s", res.get_ssid().c_str(),
+      ESP_LOGI(TAG, "- '%s' %s" LOG_SECRET("(%s) ") "%s", res.get_ssid(),
                res.get_is_hidden() ? "(HIDDEN) " : "", bssid_s, LOG_STR_ARG(get_signal_bars(res.get_rssi())));
       ESP_LOGD(TAG, "    Channel: %u", res.get_channel());
       ESP_LOGD(TAG, "    RSSI: %d dB", res.get_rssi());
     } else {
-      ESP_LOGD(TAG, "- " LOG_SECRET("'%s'") " " LOG_SECRET("(%s) ") "%s", res.get_ssid().c_str(), bssid_s,
+      ESP_LOGD(TAG, "- " LOG_SECRET("'%s'") " " LOG_SECRET("(%s) ") "%s", res.get_ssid(), bssid_s,
                LOG_STR_ARG(get_signal_bars(res.get_rssi())));
     }
   }
 
+  if (this->scan_skipped_ != 0)
+    ESP_LOGD(TAG, "- %u other networks", this->scan_skipped_);
+
   if (!this->scan_result_[0].get_matches()) {
     ESP_LOGW(TAG, "No matching network found!");
     this->retry_connect();
@@ -502,6 +625,17 @@ void WiFiComponent::check_connecting_finished() {
     ESP_LOGI(TAG, "WiFi Connected!");
     this->print_connect_params_();
 
+    WiFiConnectTiming &timing = this->connect_timing_;
+    timing.connected = millis();
+    // not every platform reports all phases
+    if (timing.got_ip == 0)
+      timing.got_ip = timing.connected;
+    if (timing.associated == 0)
+      timing.associated = timing.got_ip;
+    ESP_LOGD(TAG, "Connected in %ums: scan %ums, association %ums, IP address %ums", timing.connected - timing.started,
+             timing.scan_done - timing.scan_started, timing.associated - timing.connecting,
+             timing.got_ip - timing.associated);
+
     if (this->has_ap()) {
 #ifdef USE_CAPTIVE_PORTAL
       if (this->is_captive_portal_active_()) {
@@ -519,6 +653,9 @@ void WiFiComponent::check_connecting_finished() {
 
     this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTED;
     this->num_retried_ = 0;
+    this->fast_reconnect_pending_ = false;
+    if (this->fast_reconnect_)
+      this->save_fast_reconnect_settings_();
     return;
   }
 
@@ -573,6 +710,18 @@ void WiFiComponent::retry_connect() {
     this->num_retried_++;
   }
   this->error_from_callback_ = false;
+  if (this->fast_reconnect_pending_) {
+    // the access point of the last connection didn't work, look for one the usual way
+    ESP_LOGD(TAG, "Connecting to the last access point failed");
+    this->fast_reconnect_pending_ = false;
+    if (this->fast_connect_) {
+      this->selected_ap_ = this->sta_[0];
+      this->start_connecting(this->selected_ap_, false);
+    } else {
+      this->start_scanning();
+    }
+    return;
+  }
   if (this->state_ == WIFI_COMPONENT_STATE_STA_CONNECTING) {
     yield();
     this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTING_2;
@@ -637,14 +786,13 @@ const optional<uint8_t> &WiFiAP::get_channel() const { return this->channel_; }
 const optional<ManualIP> &WiFiAP::get_manual_ip() const { return this->manual_ip_; }
 bool WiFiAP::get_hidden() const { return this->hidden_; }
 
-WiFiScanResult::WiFiScanResult(const bssid_t &bssid, std::string ssid, uint8_t channel, int8_t rssi, bool with_auth,
-                               bool is_hidden)
-    : bssid_(bssid),
-      ssid_(std::move(ssid)),
-      channel_(channel),
-      rssi_(rssi),
-      with_auth_(with_auth),
-      is_hidden_(is_hidden) {}
+WiFiScanResult::WiFiScanResult(const bssid_t &bssid, const char *ssid, size_t ssid_len, uint8_t channel, int8_t rssi,
+                               bool with_auth, bool is_hidden)
+    : bssid_(bssid), channel_(channel), rssi_(rssi), with_auth_(with_auth), is_hidden_(is_hidden) {
+  ssid_len = std::min(ssid_len, sizeof(this->ssid_) - 1);
+  memcpy(this->ssid_, ssid, ssid_len);
+  this->ssid_[ssid_len] = '\0';
+}
 bool WiFiScanResult::matches(const WiFiAP &config) {
   if (config.get_hidden()) {
     // User configured a hidden network, only match actually hidden networks
@@ -685,7 +833,7 @@ bool WiFiScanResult::matches(const WiFiAP &config) {
 bool WiFiScanResult::get_matches() const { return this->matches_; }
 void WiFiScanResult::set_matches(bool matches) { this->matches_ = matches; }
 const bssid_t &WiFiScanResult::get_bssid() const { return this->bssid_; }
-const std::string &WiFiScanResult::get_ssid() const { return this->ssid_; }
+const char *WiFiScanResult::get_ssid() const { return this->ssid_; }
 uint8_t WiFiScanResult::get_channel() const { return this->channel_; }
 int8_t WiFiScanResult::get_rssi() const { return this->rssi_; }
 bool WiFiScanResult::get_with_auth() const { return this->with_auth_; }
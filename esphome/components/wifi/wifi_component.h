@@ -33,6 +33,33 @@ struct SavedWifiSettings {
   char password[65];
 } PACKED;  // NOLINT
 
+/// The access point of the last connection, tried first on the next connect.
+struct SavedWifiFastReconnectSettings {
+  uint32_t ssid_hash;
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t ap_index;
+  /// The address the DHCP server handed out for the last connection, 0 if it had a static IP or reused this one.
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns1;
+  uint32_t dns2;
+} PACKED;  // NOLINT
+
+/// When (millis()) the phases of the last connection attempt happened, 0 for phases that didn't happen (yet).
+struct WiFiConnectTiming {
+  uint32_t attempt;  ///< Counts the connection attempts.
+  uint32_t started;
+  uint32_t scan_started;
+  uint32_t scan_done;
+  uint32_t connecting;  ///< Start of the last connect, the one that succeeded once connected.
+  uint32_t associated;
+  uint32_t got_ip;
+  uint32_t connected;
+  uint32_t first_client;  ///< First API client after the connection came up.
+};
+
 enum WiFiComponentState {
   /** Nothing has been initialized yet. Internal AP, if configured, is disabled at this point. */
   WIFI_COMPONENT_STATE_OFF = 0,
@@ -122,16 +149,18 @@ class WiFiAP {
   bool hidden_{false};
 };
 
+/// A network found by a scan, with the SSID in a fixed buffer so that scan results don't allocate.
 class WiFiScanResult {
  public:
-  WiFiScanResult(const bssid_t &bssid, std::string ssid, uint8_t channel, int8_t rssi, bool with_auth, bool is_hidden);
+  WiFiScanResult(const bssid_t &bssid, const char *ssid, size_t ssid_len, uint8_t channel, int8_t rssi, bool with_auth,
+                 bool is_hidden);
 
   bool matches(const WiFiAP &config);
 
   bool get_matches() const;
   void set_matches(bool matches);
   const bssid_t &get_bssid() const;
-  const std::string &get_ssid() const;
+  const char *get_ssid() const;
   uint8_t get_channel() const;
   int8_t get_rssi() const;
   bool get_with_auth() const;
@@ -142,7 +171,8 @@ class WiFiScanResult {
  protected:
   bool matches_{false};
   bssid_t bssid_;
-  std::string ssid_;
+  /// 32 bytes and a terminating null.
+  char ssid_[33];
   uint8_t channel_;
   int8_t rssi_;
   bool with_auth_;
@@ -188,6 +218,15 @@ class WiFiComponent : public Component {
   void check_scanning_finished();
   void start_connecting(const WiFiAP &ap, bool two);
   void set_fast_connect(bool fast_connect);
+  /// Remember the access point of the last connection and connect to it directly on the next attempt.
+  void set_fast_reconnect(bool fast_reconnect) { this->fast_reconnect_ = fast_reconnect; }
+  /** Use the address DHCP handed out for the last connection as a static IP on the fast reconnect.
+   *
+   * Skips the DHCP exchange, which is most of the connect time of a node waking up from deep sleep. The address isn't
+   * leased anymore though, so this should only be used with a DHCP reservation for the node. An address is only
+   * reused once, the connection after that goes through DHCP again and picks up a lease that moved.
+   */
+  void set_reuse_dhcp_address(bool reuse_dhcp_address) { this->reuse_dhcp_address_ = reuse_dhcp_address; }
   void set_ap_timeout(uint32_t ap_timeout) { ap_timeout_ = ap_timeout; }
 
   void check_connecting_finished();
@@ -223,7 +262,15 @@ class WiFiComponent : public Component {
   std::string get_use_address() const;
   void set_use_address(const std::string &use_address);
 
+  /** The networks found by the last scan, best first.
+   *
+   * Only the networks that match a configured one are kept, unless the captive portal is active or all of them were
+   * requested with set_keep_scan_results().
+   */
   const std::vector<WiFiScanResult> &get_scan_result() const { return scan_result_; }
+  /// Keep all networks found by a scan, for components that list them.
+  void set_keep_scan_results(bool keep_scan_results) { this->keep_scan_results_ = keep_scan_results; }
+  const WiFiConnectTiming &get_connect_timing() const { return connect_timing_; }
 
   network::IPAddress wifi_soft_ap_ip();
 
@@ -261,6 +308,11 @@ class WiFiComponent : public Component {
   static std::string format_mac_addr(const uint8_t mac[6]);
   void setup_ap_config_();
   void print_connect_params_();
+  /// Called by the platform for every network found by a scan.
+  void add_scan_result_(WiFiScanResult &&result);
+  bool load_fast_reconnect_settings_();
+  void save_fast_reconnect_settings_();
+  void start_connect_timing_();
 
   void wifi_loop_();
   bool wifi_mode_(optional<bool> sta, optional<bool> ap);
@@ -307,6 +359,10 @@ class WiFiComponent : public Component {
   std::vector<WiFiSTAPriority> sta_priorities_;
   WiFiAP selected_ap_;
   bool fast_connect_{false};
+  bool fast_reconnect_{false};
+  bool reuse_dhcp_address_{false};
+  // Currently trying the access point of the last connection, scan if that fails
+  bool fast_reconnect_pending_{false};
 
   bool has_ap_{false};
   WiFiAP ap_;
@@ -319,10 +375,16 @@ class WiFiComponent : public Component {
   WiFiPowerSaveMode power_save_{WIFI_POWER_SAVE_NONE};
   bool error_from_callback_{false};
   std::vector<WiFiScanResult> scan_result_;
+  /// Networks of the last scan that weren't kept because they don't match a configured network.
+  uint16_t scan_skipped_{0};
+  bool keep_scan_results_{false};
+  WiFiConnectTiming connect_timing_{};
   bool scan_done_{false};
   bool ap_setup_{false};
   optional<float> output_power_;
   ESPPreferenceObject pref_;
+  ESPPreferenceObject fast_reconnect_pref_;
+  SavedWifiFastReconnectSettings fast_reconnect_settings_{};
   bool has_saved_wifi_settings_{false};
 };
 
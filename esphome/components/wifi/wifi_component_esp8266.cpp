@@ -468,6 +468,7 @@ void WiFiComponent::wifi_event_callback(System_Event_t *event) {
       ESP_LOGV(TAG, "Event: Connected ssid='%s' bssid=%s channel=%u", buf, format_mac_addr(it.bssid).c_str(),
                it.channel);
       s_sta_connected = true;
+      global_wifi_component->connect_timing_.associated = millis();
       break;
     }
     case EVENT_STAMODE_DISCONNECTED: {
@@ -507,6 +508,7 @@ void WiFiComponent::wifi_event_callback(System_Event_t *event) {
       ESP_LOGV(TAG, "Event: Got IP static_ip=%s gateway=%s netmask=%s", format_ip_addr(it.ip).c_str(),
                format_ip_addr(it.gw).c_str(), format_ip_addr(it.mask).c_str());
       s_sta_got_ip = true;
+      global_wifi_component->connect_timing_.got_ip = millis();
       break;
     }
     case EVENT_STAMODE_DHCP_TIMEOUT: {
@@ -651,6 +653,7 @@ void WiFiComponent::s_wifi_scan_done_callback(void *arg, STATUS status) {
 
 void WiFiComponent::wifi_scan_done_callback_(void *arg, STATUS status) {
   this->scan_result_.clear();
+  this->scan_skipped_ = 0;
 
   if (status != OK) {
     ESP_LOGV(TAG, "Scan failed! %d", status);
@@ -659,10 +662,10 @@ void WiFiComponent::wifi_scan_done_callback_(void *arg, STATUS status) {
   }
   auto *head = reinterpret_cast<bss_info *>(arg);
   for (bss_info *it = head; it != nullptr; it = STAILQ_NEXT(it, next)) {
-    WiFiScanResult res({it->bssid[0], it->bssid[1], it->bssid[2], it->bssid[3], it->bssid[4], it->bssid[5]},
-                       std::string(reinterpret_cast<char *>(it->ssid), it->ssid_len), it->channel, it->rssi,
-                       it->authmode != AUTH_OPEN, it->is_hidden != 0);
-    this->scan_result_.push_back(res);
+    this->add_scan_result_(
+        WiFiScanResult({it->bssid[0], it->bssid[1], it->bssid[2], it->bssid[3], it->bssid[4], it->bssid[5]},
+                       reinterpret_cast<char *>(it->ssid), it->ssid_len, it->channel, it->rssi,
+                       it->authmode != AUTH_OPEN, it->is_hidden != 0));
   }
   this->scan_done_ = true;
 }
@@ -0,0 +1,65 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+)
+
+DEPENDENCIES = ["wifi"]
+
+CONF_CONNECT_TIME = "connect_time"
+CONF_SCAN_TIME = "scan_time"
+CONF_ASSOCIATION_TIME = "association_time"
+CONF_IP_ADDRESS_TIME = "ip_address_time"
+CONF_API_CLIENT_TIME = "api_client_time"
+UNIT_MILLISECOND = "ms"
+
+wifi_info_ns = cg.esphome_ns.namespace("wifi_info")
+ConnectTimingWiFiInfo = wifi_info_ns.class_("ConnectTimingWiFiInfo", cg.Component)
+
+TIMING_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MILLISECOND,
+    icon=ICON_TIMER,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(ConnectTimingWiFiInfo),
+            cv.Optional(CONF_CONNECT_TIME): TIMING_SCHEMA,
+            cv.Optional(CONF_SCAN_TIME): TIMING_SCHEMA,
+            cv.Optional(CONF_ASSOCIATION_TIME): TIMING_SCHEMA,
+            cv.Optional(CONF_IP_ADDRESS_TIME): TIMING_SCHEMA,
+            cv.Optional(CONF_API_CLIENT_TIME): TIMING_SCHEMA,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.has_at_least_one_key(
+        CONF_CONNECT_TIME,
+        CONF_SCAN_TIME,
+        CONF_ASSOCIATION_TIME,
+        CONF_IP_ADDRESS_TIME,
+        CONF_API_CLIENT_TIME,
+    ),
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    for key, setter in (
+        (CONF_CONNECT_TIME, var.set_connect_time_sensor),
+        (CONF_SCAN_TIME, var.set_scan_time_sensor),
+        (CONF_ASSOCIATION_TIME, var.set_association_time_sensor),
+        (CONF_IP_ADDRESS_TIME, var.set_ip_address_time_sensor),
+        (CONF_API_CLIENT_TIME, var.set_api_client_time_sensor),
+    ):
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(setter(sens))
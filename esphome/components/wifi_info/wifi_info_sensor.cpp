@@ -0,0 +1,44 @@
+#include "wifi_info_sensor.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace wifi_info {
+
+static const char *const TAG = "wifi_info";
+
+void ConnectTimingWiFiInfo::loop() {
+  const wifi::WiFiConnectTiming &timing = wifi::global_wifi_component->get_connect_timing();
+  if (timing.connected == 0)
+    return;
+
+  if (timing.attempt != this->published_attempt_) {
+    this->published_attempt_ = timing.attempt;
+    this->api_client_published_ = false;
+    if (this->connect_time_sensor_ != nullptr)
+      this->connect_time_sensor_->publish_state(timing.connected - timing.started);
+    if (this->scan_time_sensor_ != nullptr)
+      this->scan_time_sensor_->publish_state(timing.scan_done - timing.scan_started);
+    if (this->association_time_sensor_ != nullptr)
+      this->association_time_sensor_->publish_state(timing.associated - timing.connecting);
+    if (this->ip_address_time_sensor_ != nullptr)
+      this->ip_address_time_sensor_->publish_state(timing.got_ip - timing.associated);
+  }
+
+  if (!this->api_client_published_ && timing.first_client != 0) {
+    this->api_client_published_ = true;
+    if (this->api_client_time_sensor_ != nullptr)
+      this->api_client_time_sensor_->publish_state(timing.first_client - timing.connected);
+  }
+}
+
+void ConnectTimingWiFiInfo::dump_config() {
+  ESP_LOGCONFIG(TAG, "WifiInfo Connect Timing:");
+  LOG_SENSOR("  ", "Connect Time", this->connect_time_sensor_);
+  LOG_SENSOR("  ", "Scan Time", this->scan_time_sensor_);
+  LOG_SENSOR("  ", "Association Time", this->association_time_sensor_);
+  LOG_SENSOR("  ", "IP Address Time", this->ip_address_time_sensor_);
+  LOG_SENSOR("  ", "API Client Time", this->api_client_time_sensor_);
+}
+
+}  // namespace wifi_info
+}  // namespace esphome
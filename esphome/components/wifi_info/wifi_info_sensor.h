@@ -0,0 +1,34 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/wifi/wifi_component.h"
+
+namespace esphome {
+namespace wifi_info {
+
+/// Publishes how long the phases of each WiFi connection took, once the connection is up.
+class ConnectTimingWiFiInfo : public Component {
+ public:
+  void set_connect_time_sensor(sensor::Sensor *sensor) { this->connect_time_sensor_ = sensor; }
+  void set_scan_time_sensor(sensor::Sensor *sensor) { this->scan_time_sensor_ = sensor; }
+  void set_association_time_sensor(sensor::Sensor *sensor) { this->association_time_sensor_ = sensor; }
+  void set_ip_address_time_sensor(sensor::Sensor *sensor) { this->ip_address_time_sensor_ = sensor; }
+  void set_api_client_time_sensor(sensor::Sensor *sensor) { this->api_client_time_sensor_ = sensor; }
+
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+ protected:
+  sensor::Sensor *connect_time_sensor_{nullptr};
+  sensor::Sensor *scan_time_sensor_{nullptr};
+  sensor::Sensor *association_time_sensor_{nullptr};
+  sensor::Sensor *ip_address_time_sensor_{nullptr};
+  sensor::Sensor *api_client_time_sensor_{nullptr};
+  uint32_t published_attempt_{0};
+  bool api_client_published_{false};
+};
+
+}  // namespace wifi_info
+}  // namespace esphome
@@ -26,6 +26,8 @@ class IPAddressWiFiInfo : public Component, public text_sensor::TextSensor {
 
 class ScanResultsWiFiInfo : public PollingComponent, public text_sensor::TextSensor {
  public:
+  // list all networks, not only the ones wifi connects to
+  void setup() override { wifi::global_wifi_component->set_keep_scan_results(true); }
   void update() override {
     std::string scan_results;
     for (auto &scan : wifi::global_wifi_component->get_scan_result()) {
@@ -5,7 +5,6 @@
 #ifdef USE_ESP32
 
 #include <vector>
-#include "mbedtls/ccm.h"
 
 namespace esphome {
 namespace xiaomi_ble {
@@ -214,12 +213,22 @@ optional<XiaomiParseResult> parse_xiaomi_header(const esp32_ble_tracker::Service
   return result;
 }
 
-bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, const uint64_t &address) {
-  if (!((raw.size() == 19) || ((raw.size() >= 22) && (raw.size() <= 24)))) {
-    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): data packet has wrong size (%d)!", raw.size());
-    ESP_LOGVV(TAG, "  Packet : %s", format_hex_pretty(raw.data(), raw.size()).c_str());
+bool XiaomiCipher::set_key(const uint8_t *bindkey) {
+  this->has_key_ = mbedtls_ccm_setkey(&this->ctx_, MBEDTLS_CIPHER_ID_AES, bindkey, 16 * 8) == 0;
+  if (!this->has_key_) {
+    ESP_LOGW(TAG, "mbedtls_ccm_setkey() failed.");
+  }
+  return this->has_key_;
+}
+
+bool XiaomiCipher::decrypt(uint8_t *raw, size_t size, uint64_t address) {
+  if (!((size == 19) || ((size >= 22) && (size <= 24)))) {
+    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): data packet has wrong size (%d)!", size);
+    ESP_LOGVV(TAG, "  Packet : %s", format_hex_pretty(raw, size).c_str());
     return false;
   }
+  if (!this->has_key_)
+    return false;
 
   uint8_t mac_reverse[6] = {0};
   mac_reverse[5] = (uint8_t)(address >> 40);
@@ -229,42 +238,29 @@ bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, c
   mac_reverse[1] = (uint8_t)(address >> 8);
   mac_reverse[0] = (uint8_t)(address >> 0);
 
-  XiaomiAESVector vector{.key = {0},
-                         .plaintext = {0},
+  XiaomiAESVector vector{.plaintext = {0},
                          .ciphertext = {0},
                          .authdata = {0x11},
                          .iv = {0},
                          .tag = {0},
-                         .keysize = 16,
                          .authsize = 1,
                          .datasize = 0,
                          .tagsize = 4,
                          .ivsize = 12};
 
-  vector.datasize = (raw.size() == 19) ? raw.size() - 12 : raw.size() - 18;
-  int cipher_pos = (raw.size() == 19) ? 5 : 11;
+  vector.datasize = (size == 19) ? size - 12 : size - 18;
+  int cipher_pos = (size == 19) ? 5 : 11;
 
-  const uint8_t *v = raw.data();
+  const uint8_t *v = raw;
 
-  memcpy(vector.key, bindkey, vector.keysize);
   memcpy(vector.ciphertext, v + cipher_pos, vector.datasize);
-  memcpy(vector.tag, v + raw.size() - vector.tagsize, vector.tagsize);
-  memcpy(vector.iv, mac_reverse, 6);             // MAC address reverse
-  memcpy(vector.iv + 6, v + 2, 3);               // sensor type (2) + packet id (1)
-  memcpy(vector.iv + 9, v + raw.size() - 7, 3);  // payload counter
-
-  mbedtls_ccm_context ctx;
-  mbedtls_ccm_init(&ctx);
-
-  int ret = mbedtls_ccm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, vector.key, vector.keysize * 8);
-  if (ret) {
-    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): mbedtls_ccm_setkey() failed.");
-    mbedtls_ccm_free(&ctx);
-    return false;
-  }
+  memcpy(vector.tag, v + size - vector.tagsize, vector.tagsize);
+  memcpy(vector.iv, mac_reverse, 6);       // MAC address reverse
+  memcpy(vector.iv + 6, v + 2, 3);         // sensor type (2) + packet id (1)
+  memcpy(vector.iv + 9, v + size - 7, 3);  // payload counter
 
-  ret = mbedtls_ccm_auth_decrypt(&ctx, vector.datasize, vector.iv, vector.ivsize, vector.authdata, vector.authsize,
-                                 vector.ciphertext, vector.plaintext, vector.tag, vector.tagsize);
+  int ret = mbedtls_ccm_auth_decrypt(&this->ctx_, vector.datasize, vector.iv, vector.ivsize, vector.authdata,
+                                     vector.authsize, vector.ciphertext, vector.plaintext, vector.tag, vector.tagsize);
   if (ret) {
     uint8_t mac_address[6] = {0};
     memcpy(mac_address, mac_reverse + 5, 1);
@@ -275,33 +271,32 @@ bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, c
     memcpy(mac_address + 5, mac_reverse, 1);
     ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): authenticated decryption failed.");
     ESP_LOGVV(TAG, "  MAC address : %s", format_hex_pretty(mac_address, 6).c_str());
-    ESP_LOGVV(TAG, "       Packet : %s", format_hex_pretty(raw.data(), raw.size()).c_str());
-    ESP_LOGVV(TAG, "          Key : %s", format_hex_pretty(vector.key, vector.keysize).c_str());
+    ESP_LOGVV(TAG, "       Packet : %s", format_hex_pretty(raw, size).c_str());
     ESP_LOGVV(TAG, "           Iv : %s", format_hex_pretty(vector.iv, vector.ivsize).c_str());
     ESP_LOGVV(TAG, "       Cipher : %s", format_hex_pretty(vector.ciphertext, vector.datasize).c_str());
     ESP_LOGVV(TAG, "          Tag : %s", format_hex_pretty(vector.tag, vector.tagsize).c_str());
-    mbedtls_ccm_free(&ctx);
     return false;
   }
 
   // replace encrypted payload with plaintext
-  uint8_t *p = vector.plaintext;
-  for (std::vector<uint8_t>::iterator it = raw.begin() + cipher_pos; it != raw.begin() + cipher_pos + vector.datasize;
-       ++it) {
-    *it = *(p++);
-  }
+  memcpy(raw + cipher_pos, vector.plaintext, vector.datasize);
 
   // clear encrypted flag
   raw[0] &= ~0x08;
 
   ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): authenticated decryption passed.");
-  ESP_LOGVV(TAG, "  Plaintext : %s, Packet : %d", format_hex_pretty(raw.data() + cipher_pos, vector.datasize).c_str(),
+  ESP_LOGVV(TAG, "  Plaintext : %s, Packet : %d", format_hex_pretty(raw + cipher_pos, vector.datasize).c_str(),
             static_cast<int>(raw[4]));
-
-  mbedtls_ccm_free(&ctx);
   return true;
 }
 
+bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, const uint64_t &address) {
+  XiaomiCipher cipher;
+  if (!cipher.set_key(bindkey))
+    return false;
+  return cipher.decrypt(raw.data(), raw.size(), address);
+}
+
 bool report_xiaomi_results(const optional<XiaomiParseResult> &result, const std::string &address) {
   if (!result.has_value()) {
     ESP_LOGVV(TAG, "report_xiaomi_results(): no results available.");
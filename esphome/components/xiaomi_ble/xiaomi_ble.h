@@ -5,6 +5,8 @@
 
 #ifdef USE_ESP32
 
+#include "mbedtls/ccm.h"
+
 namespace esphome {
 namespace xiaomi_ble {
 
@@ -47,13 +49,11 @@ struct XiaomiParseResult {
 };
 
 struct XiaomiAESVector {
-  uint8_t key[16];
   uint8_t plaintext[16];
   uint8_t ciphertext[16];
   uint8_t authdata[16];
   uint8_t iv[16];
   uint8_t tag[16];
-  size_t keysize;
   size_t authsize;
   size_t datasize;
   size_t tagsize;
@@ -66,6 +66,28 @@ optional<XiaomiParseResult> parse_xiaomi_header(const esp32_ble_tracker::Service
 bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, const uint64_t &address);
 bool report_xiaomi_results(const optional<XiaomiParseResult> &result, const std::string &address);
 
+/** AES-CCM decryption of Xiaomi payloads with one bindkey.
+ *
+ * The key schedule is computed once in set_key() instead of for every packet, so devices with a bindkey should keep
+ * one of these around. mbedtls uses the AES peripheral of the ESP32 for the block operations.
+ */
+class XiaomiCipher {
+ public:
+  XiaomiCipher() { mbedtls_ccm_init(&this->ctx_); }
+  ~XiaomiCipher() { mbedtls_ccm_free(&this->ctx_); }
+  XiaomiCipher(const XiaomiCipher &) = delete;
+  XiaomiCipher &operator=(const XiaomiCipher &) = delete;
+
+  /// Set the 16 byte bindkey, returns false if mbedtls rejected it.
+  bool set_key(const uint8_t *bindkey);
+  /// Authenticate and decrypt the payload in place, raw is only modified if that succeeded.
+  bool decrypt(uint8_t *raw, size_t size, uint64_t address);
+
+ protected:
+  mbedtls_ccm_context ctx_;
+  bool has_key_{false};
+};
+
 class XiaomiListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
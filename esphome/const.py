@@ -301,6 +301,7 @@ CONF_INTERLOCK = "interlock"
 CONF_INTERNAL = "internal"
 CONF_INTERNAL_FILTER = "internal_filter"
 CONF_INTERRUPT = "interrupt"
+CONF_INTERRUPT_PIN = "interrupt_pin"
 CONF_INTERVAL = "interval"
 CONF_INVALID_COOLDOWN = "invalid_cooldown"
 CONF_INVERT = "invert"
@@ -737,6 +738,7 @@ CONF_X_GRID = "x_grid"
 CONF_Y_GRID = "y_grid"
 CONF_ZERO = "zero"
 
+ENV_BUILD_CACHE_DIR = "ESPHOME_BUILD_CACHE_DIR"
 ENV_NOGITIGNORE = "ESPHOME_NOGITIGNORE"
 ENV_QUICKWIZARD = "ESPHOME_QUICKWIZARD"
 
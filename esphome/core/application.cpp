@@ -7,10 +7,34 @@
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#ifdef USE_NETWORK
+#include "esphome/components/network/util.h"
+#endif
+
+#ifdef USE_DEBUG_PROFILER
+#include "esphome/components/debug/profiler.h"
+#endif
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+#include <cerrno>
+#include <lwip/sockets.h>
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
 
+#ifdef USE_BOOT_PROFILE
+/// Record how long the setup() of a component takes.
+#define BOOT_PROFILE_SETUP(component) BootSetupTimer boot_setup_timer_{this, component}
+#else
+#define BOOT_PROFILE_SETUP(component)
+#endif
+#ifdef USE_FAST_BOOT
+/// Dump the config at the latest this long after setup, even if the network isn't connected.
+static const uint32_t FAST_BOOT_DUMP_TIMEOUT = 30000;
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -25,8 +49,105 @@ void Application::register_component_(Component *comp) {
   }
   this->components_.push_back(comp);
 }
+#ifdef USE_BOOT_PROFILE
+Application::BootSetupTimer::BootSetupTimer(Application *app, Component *component)
+    : app_(app), component_(component), started_us_(micros()) {}
+Application::BootSetupTimer::~BootSetupTimer() {
+  this->app_->boot_timings_.push_back(BootTiming{this->component_, micros() - this->started_us_, 0});
+}
+void Application::dump_boot_profile_() {
+  ESP_LOGI(TAG, "Boot profile: setup() started after %u ms and took %u ms", this->boot_setup_started_,
+           this->boot_setup_finished_ - this->boot_setup_started_);
+  for (auto &timing : this->boot_timings_) {
+    if (timing.wait_ms != 0) {
+      ESP_LOGI(TAG, "  %s: setup %.1f ms, waited %u ms until it could proceed", timing.component->get_component_source(),
+               timing.setup_us / 1000.0f, timing.wait_ms);
+    } else {
+      ESP_LOGI(TAG, "  %s: setup %.1f ms", timing.component->get_component_source(), timing.setup_us / 1000.0f);
+    }
+  }
+}
+#endif
+void Application::reserve_registries_() {
+#ifdef ESPHOME_COMPONENT_COUNT
+  this->components_.reserve(ESPHOME_COMPONENT_COUNT);
+#endif
+#if defined(USE_BINARY_SENSOR) && defined(ESPHOME_BINARY_SENSOR_COUNT)
+  this->binary_sensors_.reserve(ESPHOME_BINARY_SENSOR_COUNT);
+#endif
+#if defined(USE_SWITCH) && defined(ESPHOME_SWITCH_COUNT)
+  this->switches_.reserve(ESPHOME_SWITCH_COUNT);
+#endif
+#if defined(USE_BUTTON) && defined(ESPHOME_BUTTON_COUNT)
+  this->buttons_.reserve(ESPHOME_BUTTON_COUNT);
+#endif
+#if defined(USE_SENSOR) && defined(ESPHOME_SENSOR_COUNT)
+  this->sensors_.reserve(ESPHOME_SENSOR_COUNT);
+#endif
+#if defined(USE_TEXT_SENSOR) && defined(ESPHOME_TEXT_SENSOR_COUNT)
+  this->text_sensors_.reserve(ESPHOME_TEXT_SENSOR_COUNT);
+#endif
+#if defined(USE_FAN) && defined(ESPHOME_FAN_COUNT)
+  this->fans_.reserve(ESPHOME_FAN_COUNT);
+#endif
+#if defined(USE_COVER) && defined(ESPHOME_COVER_COUNT)
+  this->covers_.reserve(ESPHOME_COVER_COUNT);
+#endif
+#if defined(USE_CLIMATE) && defined(ESPHOME_CLIMATE_COUNT)
+  this->climates_.reserve(ESPHOME_CLIMATE_COUNT);
+#endif
+#if defined(USE_LIGHT) && defined(ESPHOME_LIGHT_COUNT)
+  this->lights_.reserve(ESPHOME_LIGHT_COUNT);
+#endif
+#if defined(USE_NUMBER) && defined(ESPHOME_NUMBER_COUNT)
+  this->numbers_.reserve(ESPHOME_NUMBER_COUNT);
+#endif
+#if defined(USE_SELECT) && defined(ESPHOME_SELECT_COUNT)
+  this->selects_.reserve(ESPHOME_SELECT_COUNT);
+#endif
+}
+void Application::build_key_indexes_() {
+#ifdef USE_BINARY_SENSOR
+  build_key_index_(this->binary_sensors_, this->binary_sensors_by_key_);
+#endif
+#ifdef USE_SWITCH
+  build_key_index_(this->switches_, this->switches_by_key_);
+#endif
+#ifdef USE_BUTTON
+  build_key_index_(this->buttons_, this->buttons_by_key_);
+#endif
+#ifdef USE_SENSOR
+  build_key_index_(this->sensors_, this->sensors_by_key_);
+#endif
+#ifdef USE_TEXT_SENSOR
+  build_key_index_(this->text_sensors_, this->text_sensors_by_key_);
+#endif
+#ifdef USE_FAN
+  build_key_index_(this->fans_, this->fans_by_key_);
+#endif
+#ifdef USE_COVER
+  build_key_index_(this->covers_, this->covers_by_key_);
+#endif
+#ifdef USE_CLIMATE
+  build_key_index_(this->climates_, this->climates_by_key_);
+#endif
+#ifdef USE_LIGHT
+  build_key_index_(this->lights_, this->lights_by_key_);
+#endif
+#ifdef USE_NUMBER
+  build_key_index_(this->numbers_, this->numbers_by_key_);
+#endif
+#ifdef USE_SELECT
+  build_key_index_(this->selects_, this->selects_by_key_);
+#endif
+}
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+  this->build_key_indexes_();
+#ifdef USE_BOOT_PROFILE
+  this->boot_setup_started_ = millis();
+  this->boot_timings_.reserve(this->components_.size());
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -35,20 +156,53 @@ void Application::setup() {
   for (uint32_t i = 0; i < this->components_.size(); i++) {
     Component *component = this->components_[i];
 
-    component->call();
+    {
+      BOOT_PROFILE_SETUP(component);
+      WarnIfComponentBlockingGuard guard{component, ComponentCallSource::SETUP};
+      component->call();
+    }
     this->scheduler.process_to_add();
     this->feed_wdt();
     if (component->can_proceed())
       continue;
 
-    std::stable_sort(this->components_.begin(), this->components_.begin() + i + 1,
+    // While this component blocks, set up the later components that don't need to wait for it, so that
+    // e.g. a slow Wi-Fi connection doesn't delay them. They keep their relative order.
+    auto waiting_end = std::stable_partition(
+        this->components_.begin() + i + 1, this->components_.end(), [](Component *c) {
+          return c->can_setup_while_blocked() &&
+                 (c->get_component_state() & COMPONENT_STATE_MASK) == COMPONENT_STATE_CONSTRUCTION;
+        });
+    const uint32_t last = std::distance(this->components_.begin(), waiting_end) - 1;
+    for (uint32_t j = i + 1; j <= last; j++) {
+      ESP_LOGV(TAG, "Setting up %s while waiting for %s", this->components_[j]->get_component_source(),
+               component->get_component_source());
+      {
+        BOOT_PROFILE_SETUP(this->components_[j]);
+        WarnIfComponentBlockingGuard guard{this->components_[j], ComponentCallSource::SETUP};
+        this->components_[j]->call();
+      }
+      this->scheduler.process_to_add();
+      this->feed_wdt();
+    }
+
+    std::stable_sort(this->components_.begin(), this->components_.begin() + last + 1,
                      [](Component *a, Component *b) { return a->get_loop_priority() > b->get_loop_priority(); });
 
+#ifdef USE_BOOT_PROFILE
+    const uint32_t wait_started = millis();
+#endif
+    // The components that were set up early may block too, wait for all of them before continuing after them
+    // (the ones set up before them already could proceed, so checking them all is the same)
+    auto all_can_proceed = [this, last]() {
+      return std::all_of(this->components_.begin(), this->components_.begin() + last + 1,
+                         [](Component *c) { return c->can_proceed(); });
+    };
     do {
       uint32_t new_app_state = STATUS_LED_WARNING;
       this->scheduler.call();
       this->feed_wdt();
-      for (uint32_t j = 0; j <= i; j++) {
+      for (uint32_t j = 0; j <= last; j++) {
         this->components_[j]->call();
         new_app_state |= this->components_[j]->get_component_state();
         this->app_state_ |= new_app_state;
@@ -56,19 +210,45 @@ void Application::setup() {
       }
       this->app_state_ = new_app_state;
       yield();
-    } while (!component->can_proceed());
+    } while (!all_can_proceed());
+#ifdef USE_BOOT_PROFILE
+    for (auto &timing : this->boot_timings_) {
+      if (timing.component == component)
+        timing.wait_ms += millis() - wait_started;
+    }
+#endif
+    // Components that were set up early are done, continue after them
+    i = last;
   }
 
   ESP_LOGI(TAG, "setup() finished successfully!");
+#if defined(USE_BOOT_PROFILE) || defined(USE_FAST_BOOT)
+  this->boot_setup_finished_ = millis();
+#endif
+#ifdef USE_FAST_BOOT
+  // The config dump is long and slows down the first loops, wait with it until the node is reachable
+  this->boot_dump_pending_ = true;
+#else
   this->schedule_dump_config();
+#endif
   this->calculate_looping_components_();
 }
 void Application::loop() {
   uint32_t new_app_state = 0;
+#ifdef USE_DEBUG_PROFILER
+  const uint32_t loop_started_us = micros();
+#endif
 
+  this->publish_queue.drain();
+  uint32_t dropped = this->publish_queue.take_dropped();
+  if (dropped != 0)
+    ESP_LOGW(TAG, "Dropped %u states published from other tasks, the main loop didn't keep up", dropped);
   this->scheduler.call();
   this->feed_wdt();
-  for (Component *component : this->looping_components_) {
+  // Components can disable/enable their loop (and thereby reorder this list) while it is being iterated
+  for (this->current_loop_index_ = 0; this->current_loop_index_ < this->looping_components_active_end_;
+       this->current_loop_index_++) {
+    Component *component = this->looping_components_[this->current_loop_index_];
     {
       WarnIfComponentBlockingGuard guard{component};
       component->call();
@@ -78,6 +258,9 @@ void Application::loop() {
     this->feed_wdt();
   }
   this->app_state_ = new_app_state;
+#ifdef USE_DEBUG_PROFILER
+  debug::global_profiler.record(nullptr, ComponentCallSource::LOOP, micros() - loop_started_us);
+#endif
 
   const uint32_t now = millis();
 
@@ -93,15 +276,29 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    this->yield_with_select_(delay_time);
   }
   this->last_loop_ = now;
 
+#ifdef USE_FAST_BOOT
+  if (this->boot_dump_pending_) {
+    bool ready = millis() - this->boot_setup_finished_ > FAST_BOOT_DUMP_TIMEOUT;
+#ifdef USE_NETWORK
+    ready = ready || network::is_connected();
+#endif
+    if (ready)
+      this->schedule_dump_config();
+  }
+#endif
+
   if (this->dump_config_at_ < this->components_.size()) {
     if (this->dump_config_at_ == 0) {
       ESP_LOGI(TAG, "ESPHome version " ESPHOME_VERSION " compiled on %s", this->compilation_time_.c_str());
 #ifdef ESPHOME_PROJECT_NAME
       ESP_LOGI(TAG, "Project " ESPHOME_PROJECT_NAME " version " ESPHOME_PROJECT_VERSION);
+#endif
+#ifdef USE_BOOT_PROFILE
+      this->dump_boot_profile_();
 #endif
     }
 
@@ -138,11 +335,96 @@ void Application::safe_reboot() {
   arch_restart();
 }
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+void Application::register_socket_fd(int fd) {
+  if (fd < 0)
+    return;
+  LockGuard guard(this->socket_fds_lock_);
+  this->socket_fds_.push_back(fd);
+}
+void Application::unregister_socket_fd(int fd) {
+  LockGuard guard(this->socket_fds_lock_);
+  auto it = std::find(this->socket_fds_.begin(), this->socket_fds_.end(), fd);
+  if (it != this->socket_fds_.end())
+    this->socket_fds_.erase(it);
+}
+#endif
+
+void Application::yield_with_select_(uint32_t delay_ms) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  fd_set read_fds;
+  FD_ZERO(&read_fds);
+  int max_fd = -1;
+  {
+    LockGuard guard(this->socket_fds_lock_);
+    for (int fd : this->socket_fds_) {
+      FD_SET(fd, &read_fds);
+      max_fd = std::max(max_fd, fd);
+    }
+  }
+  if (max_fd >= 0) {
+    struct timeval tv;
+    tv.tv_sec = delay_ms / 1000;
+    tv.tv_usec = (delay_ms % 1000) * 1000;
+    const uint32_t started = millis();
+    // Returns early when one of the sockets has data (or a pending connection) to process
+    int ret = lwip_select(max_fd + 1, &read_fds, nullptr, nullptr, &tv);
+    if (ret > 0 && millis() - started < 1) {
+      // A socket that stays readable because nobody reads it would keep the loop from ever sleeping, so after two
+      // immediate wakeups in a row sleep at least a millisecond.
+      if (this->select_woke_early_)
+        delay(1);
+      this->select_woke_early_ = true;
+      return;
+    }
+    this->select_woke_early_ = false;
+    if (ret >= 0 || errno == EINTR)
+      return;
+    ESP_LOGV(TAG, "select() failed with errno %d, falling back to delay", errno);
+  }
+#endif
+  delay(delay_ms);
+}
+
 void Application::calculate_looping_components_() {
   for (auto *obj : this->components_) {
-    if (obj->has_overridden_loop())
+    uint32_t state = obj->get_component_state() & COMPONENT_STATE_MASK;
+    if (obj->has_overridden_loop() && state != COMPONENT_STATE_LOOP_DONE && state != COMPONENT_STATE_FAILED)
       this->looping_components_.push_back(obj);
   }
+  this->looping_components_active_end_ = this->looping_components_.size();
+  // Components that disabled their loop during setup can still enable it later
+  for (auto *obj : this->components_) {
+    uint32_t state = obj->get_component_state() & COMPONENT_STATE_MASK;
+    if (obj->has_overridden_loop() && state == COMPONENT_STATE_LOOP_DONE)
+      this->looping_components_.push_back(obj);
+  }
+}
+void Application::disable_component_loop_(Component *component) {
+  for (size_t i = 0; i < this->looping_components_active_end_; i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // Move it to the start of the inactive range, keeping the order of the other components
+    auto begin = this->looping_components_.begin();
+    std::rotate(begin + i, begin + i + 1, begin + this->looping_components_active_end_);
+    this->looping_components_active_end_--;
+    // Everything after i moved down by one, so make sure the loop in loop() doesn't skip a component.
+    // If i == current_loop_index_ == 0 this wraps around and the loop's increment brings it back to 0.
+    if (i <= this->current_loop_index_)
+      this->current_loop_index_--;
+    return;
+  }
+}
+void Application::enable_component_loop_(Component *component) {
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // Move it to the end of the active range
+    auto begin = this->looping_components_.begin();
+    std::rotate(begin + this->looping_components_active_end_, begin + i, begin + i + 1);
+    this->looping_components_active_end_++;
+    return;
+  }
 }
 
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
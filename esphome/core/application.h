@@ -1,9 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "esphome/core/defines.h"
 #include "esphome/core/preferences.h"
+#include "esphome/core/publish_queue.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -56,6 +58,7 @@ class Application {
       this->name_ = name;
     }
     this->compilation_time_ = compilation_time;
+    this->reserve_registries_();
   }
 
 #ifdef USE_BINARY_SENSOR
@@ -139,7 +142,25 @@ class Application {
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
-  void schedule_dump_config() { this->dump_config_at_ = 0; }
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  /** Register a socket file descriptor that should wake up the main loop when it becomes readable.
+   *
+   * Instead of sleeping for a fixed time between loop iterations, the main loop then waits in select() on all
+   * registered sockets, so that incoming data is handled right away. Can be called from any task.
+   *
+   * Only sockets wake up the loop, other events (like UART data or GPIO interrupts) are still handled on the next
+   * regular iteration.
+   */
+  void register_socket_fd(int fd);
+  void unregister_socket_fd(int fd);
+#endif
+
+  void schedule_dump_config() {
+    this->dump_config_at_ = 0;
+#ifdef USE_FAST_BOOT
+    this->boot_dump_pending_ = false;
+#endif
+  }
 
   void feed_wdt();
 
@@ -161,149 +182,197 @@ class Application {
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->binary_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->binary_sensors_, this->binary_sensors_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_SWITCH
   const std::vector<switch_::Switch *> &get_switches() { return this->switches_; }
   switch_::Switch *get_switch_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->switches_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->switches_, this->switches_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_BUTTON
   const std::vector<button::Button *> &get_buttons() { return this->buttons_; }
   button::Button *get_button_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->buttons_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->buttons_, this->buttons_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_SENSOR
   const std::vector<sensor::Sensor *> &get_sensors() { return this->sensors_; }
   sensor::Sensor *get_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->sensors_, this->sensors_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_TEXT_SENSOR
   const std::vector<text_sensor::TextSensor *> &get_text_sensors() { return this->text_sensors_; }
   text_sensor::TextSensor *get_text_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->text_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->text_sensors_, this->text_sensors_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_FAN
   const std::vector<fan::FanState *> &get_fans() { return this->fans_; }
   fan::FanState *get_fan_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->fans_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->fans_, this->fans_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_COVER
   const std::vector<cover::Cover *> &get_covers() { return this->covers_; }
   cover::Cover *get_cover_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->covers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->covers_, this->covers_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_LIGHT
   const std::vector<light::LightState *> &get_lights() { return this->lights_; }
   light::LightState *get_light_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->lights_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->lights_, this->lights_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_CLIMATE
   const std::vector<climate::Climate *> &get_climates() { return this->climates_; }
   climate::Climate *get_climate_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->climates_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->climates_, this->climates_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_NUMBER
   const std::vector<number::Number *> &get_numbers() { return this->numbers_; }
   number::Number *get_number_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->numbers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->numbers_, this->numbers_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_SELECT
   const std::vector<select::Select *> &get_selects() { return this->selects_; }
   select::Select *get_select_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->selects_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->selects_, this->selects_by_key_, key, include_internal);
   }
 #endif
 
   Scheduler scheduler;
+  /// States pushed from interrupts and other tasks, published at the start of the next loop().
+  PublishQueue publish_queue;
 
  protected:
   friend Component;
 
   void register_component_(Component *comp);
+  /// Reserve the registries for the number of registrations counted by the code generator.
+  void reserve_registries_();
+
+#ifdef USE_BOOT_PROFILE
+  struct BootTiming {
+    Component *component;
+    uint32_t setup_us;
+    /// Time the boot waited for can_proceed() of this component.
+    uint32_t wait_ms;
+  };
+  /// Records the duration of a setup() call for the boot profile.
+  class BootSetupTimer {
+   public:
+    BootSetupTimer(Application *app, Component *component);
+    ~BootSetupTimer();
+
+   protected:
+    Application *app_;
+    Component *component_;
+    uint32_t started_us_;
+  };
+  /// Log the setup duration of every component (with the config dump).
+  void dump_boot_profile_();
+#endif
+
+  /// Sort the entities by key into the indexes used by the get_*_by_key() methods.
+  void build_key_indexes_();
+  template<typename T> static void build_key_index_(const std::vector<T *> &entities, std::vector<T *> &index) {
+    index = entities;
+    std::sort(index.begin(), index.end(), [](T *a, T *b) { return a->get_object_id_hash() < b->get_object_id_hash(); });
+  }
+
+  /** Find an entity by its key.
+   *
+   * index holds the same entities sorted by key. It's only built once at the start of setup(), before any component
+   * (and so any other task that looks up entities) runs, and never written again. Entities registered later, or whose
+   * key changed since, are found by going through all entities when the index doesn't have the key.
+   */
+  template<typename T>
+  static T *find_by_key_(const std::vector<T *> &entities, const std::vector<T *> &index, uint32_t key,
+                         bool include_internal) {
+    auto it = std::lower_bound(index.begin(), index.end(), key,
+                               [](T *obj, uint32_t key) { return obj->get_object_id_hash() < key; });
+    for (; it != index.end() && (*it)->get_object_id_hash() == key; ++it) {
+      if (include_internal || !(*it)->is_internal())
+        return *it;
+    }
+    for (T *obj : entities) {
+      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
+        return obj;
+    }
+    return nullptr;
+  }
 
   void calculate_looping_components_();
+  void disable_component_loop_(Component *component);
+  void enable_component_loop_(Component *component);
 
   void feed_wdt_arch_();
 
+  /// Sleep for at most delay_ms, returning early if a registered socket becomes readable.
+  void yield_with_select_(uint32_t delay_ms);
+
   std::vector<Component *> components_{};
+  /// Components with a loop(), the ones in [0, looping_components_active_end_) currently have it enabled.
   std::vector<Component *> looping_components_{};
+  size_t looping_components_active_end_{0};
+  size_t current_loop_index_{0};
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  std::vector<int> socket_fds_{};
+  /// Sockets are also opened and closed in other tasks.
+  Mutex socket_fds_lock_;
+  /// Whether the last select() returned right away because a socket was readable.
+  bool select_woke_early_{false};
+#endif
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
+  std::vector<binary_sensor::BinarySensor *> binary_sensors_by_key_{};
 #endif
 #ifdef USE_SWITCH
   std::vector<switch_::Switch *> switches_{};
+  std::vector<switch_::Switch *> switches_by_key_{};
 #endif
 #ifdef USE_BUTTON
   std::vector<button::Button *> buttons_{};
+  std::vector<button::Button *> buttons_by_key_{};
 #endif
 #ifdef USE_SENSOR
   std::vector<sensor::Sensor *> sensors_{};
+  std::vector<sensor::Sensor *> sensors_by_key_{};
 #endif
 #ifdef USE_TEXT_SENSOR
   std::vector<text_sensor::TextSensor *> text_sensors_{};
+  std::vector<text_sensor::TextSensor *> text_sensors_by_key_{};
 #endif
 #ifdef USE_FAN
   std::vector<fan::FanState *> fans_{};
+  std::vector<fan::FanState *> fans_by_key_{};
 #endif
 #ifdef USE_COVER
   std::vector<cover::Cover *> covers_{};
+  std::vector<cover::Cover *> covers_by_key_{};
 #endif
 #ifdef USE_CLIMATE
   std::vector<climate::Climate *> climates_{};
+  std::vector<climate::Climate *> climates_by_key_{};
 #endif
 #ifdef USE_LIGHT
   std::vector<light::LightState *> lights_{};
+  std::vector<light::LightState *> lights_by_key_{};
 #endif
 #ifdef USE_NUMBER
   std::vector<number::Number *> numbers_{};
+  std::vector<number::Number *> numbers_by_key_{};
 #endif
 #ifdef USE_SELECT
   std::vector<select::Select *> selects_{};
+  std::vector<select::Select *> selects_by_key_{};
 #endif
 
   std::string name_;
@@ -312,6 +381,16 @@ class Application {
   uint32_t last_loop_{0};
   uint32_t loop_interval_{16};
   size_t dump_config_at_{SIZE_MAX};
+#ifdef USE_BOOT_PROFILE
+  std::vector<BootTiming> boot_timings_{};
+  uint32_t boot_setup_started_{0};
+#endif
+#if defined(USE_BOOT_PROFILE) || defined(USE_FAST_BOOT)
+  uint32_t boot_setup_finished_{0};
+#endif
+#ifdef USE_FAST_BOOT
+  bool boot_dump_pending_{false};
+#endif
   uint32_t app_state_{0};
 };
 
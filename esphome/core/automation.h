@@ -71,6 +71,14 @@ template<typename... Ts> class Condition {
   /// Check whether this condition passes. This condition check must be instant, and not cause any delays.
   virtual bool check(Ts... x) = 0;
 
+  /** Get notified whenever the result of check() may have changed.
+   *
+   * Returns false if this condition can't tell when it changes (for example lambdas), users then have to keep
+   * polling check(). The callback may be called without an actual change, and may already have been registered with
+   * some inner conditions when false is returned.
+   */
+  virtual bool add_on_change_callback(std::function<void()> &&callback) { return false; }
+
   /// Call check with a tuple of values as parameter.
   bool check_tuple(const std::tuple<Ts...> &tuple) {
     return this->check_tuple_(tuple, typename gens<sizeof...(Ts)>::type());
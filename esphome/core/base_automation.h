@@ -17,6 +17,14 @@ template<typename... Ts> class AndCondition : public Condition<Ts...> {
     return true;
   }
 
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    for (auto *condition : this->conditions_) {
+      if (!condition->add_on_change_callback(std::function<void()>(callback)))
+        return false;
+    }
+    return true;
+  }
+
  protected:
   std::vector<Condition<Ts...> *> conditions_;
 };
@@ -33,6 +41,14 @@ template<typename... Ts> class OrCondition : public Condition<Ts...> {
     return false;
   }
 
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    for (auto *condition : this->conditions_) {
+      if (!condition->add_on_change_callback(std::function<void()>(callback)))
+        return false;
+    }
+    return true;
+  }
+
  protected:
   std::vector<Condition<Ts...> *> conditions_;
 };
@@ -41,6 +57,9 @@ template<typename... Ts> class NotCondition : public Condition<Ts...> {
  public:
   explicit NotCondition(Condition<Ts...> *condition) : condition_(condition) {}
   bool check(Ts... x) override { return !this->condition_->check(x...); }
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    return this->condition_->add_on_change_callback(std::move(callback));
+  }
 
  protected:
   Condition<Ts...> *condition_;
@@ -61,12 +80,20 @@ template<typename... Ts> class ForCondition : public Condition<Ts...>, public Co
 
   TEMPLATABLE_VALUE(uint32_t, time);
 
+  void setup() override {
+    // If the inner condition tells us when it changes there's no need to watch it every loop.
+    if (this->condition_->add_on_change_callback([this]() { this->check_internal(); })) {
+      this->check_internal();
+      this->disable_loop();
+    }
+  }
   void loop() override { this->check_internal(); }
   float get_setup_priority() const override { return setup_priority::DATA; }
   bool check_internal() {
     bool cond = this->condition_->check();
-    if (!cond)
+    if (!cond || !this->was_active_)
       this->last_inactive_ = millis();
+    this->was_active_ = cond;
     return cond;
   }
 
@@ -79,6 +106,8 @@ template<typename... Ts> class ForCondition : public Condition<Ts...>, public Co
  protected:
   Condition<> *condition_;
   uint32_t last_inactive_{0};
+  /// A condition that is already active on boot counts as active since boot.
+  bool was_active_{true};
 };
 
 class StartupTrigger : public Trigger<>, public Component {
@@ -109,9 +138,11 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
   TEMPLATABLE_VALUE(uint32_t, delay)
 
   void play_complex(Ts... x) override {
-    auto f = std::bind(&DelayAction<Ts...>::play_next_, this, x...);
     this->num_running_++;
-    this->set_timeout(this->delay_.value(x...), f);
+    // A lambda is smaller than std::bind (no member function pointer to store). libstdc++'s std::function stores
+    // callables of up to two pointers inline, so without trigger arguments (or with one pointer-sized argument) this
+    // needs no heap allocation; larger argument lists are still heap allocated.
+    this->set_timeout(this->delay_.value(x...), [this, x...]() { this->play_next_(x...); });
   }
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
@@ -131,6 +162,20 @@ template<typename... Ts> class LambdaAction : public Action<Ts...> {
   std::function<void(Ts...)> f_;
 };
 
+/// Consecutive lambda actions built as one action, the function gets the action to check is_stopped() between bodies.
+template<typename... Ts> class MergedLambdaAction : public Action<Ts...> {
+ public:
+  explicit MergedLambdaAction(std::function<void(MergedLambdaAction<Ts...> *, Ts...)> &&f) : f_(std::move(f)) {}
+
+  /// Whether the action was stopped (for example by script.stop in one of the lambdas) while it runs.
+  bool is_stopped() const { return this->num_running_ == 0; }
+
+  void play(Ts... x) override { this->f_(this, x...); }
+
+ protected:
+  std::function<void(MergedLambdaAction<Ts...> *, Ts...)> f_;
+};
+
 template<typename... Ts> class IfAction : public Action<Ts...> {
  public:
   explicit IfAction(Condition<Ts...> *condition) : condition_(condition) {}
@@ -275,16 +320,19 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
     this->var_ = std::make_tuple(x...);
 
     if (this->timeout_value_.has_value()) {
-      auto f = std::bind(&WaitUntilAction<Ts...>::play_next_, this, x...);
-      this->set_timeout("timeout", this->timeout_value_.value(x...), f);
+      this->set_timeout("timeout", this->timeout_value_.value(x...), [this]() { this->play_next_tuple_(this->var_); });
     }
 
+    // Only poll the condition while something is waiting on it.
+    this->enable_loop();
     this->loop();
   }
 
   void loop() override {
-    if (this->num_running_ == 0)
+    if (this->num_running_ == 0) {
+      this->disable_loop();
       return;
+    }
 
     if (!this->condition_->check_tuple(this->var_)) {
       return;
@@ -4,7 +4,9 @@
 #include <functional>
 #include <cmath>
 
+#include "esphome/core/defines.h"
 #include "esphome/core/optional.h"
+#include "esphome/core/helpers.h"
 
 namespace esphome {
 
@@ -56,6 +58,7 @@ extern const uint32_t COMPONENT_STATE_CONSTRUCTION;
 extern const uint32_t COMPONENT_STATE_SETUP;
 extern const uint32_t COMPONENT_STATE_LOOP;
 extern const uint32_t COMPONENT_STATE_FAILED;
+extern const uint32_t COMPONENT_STATE_LOOP_DONE;
 extern const uint32_t STATUS_LED_MASK;
 extern const uint32_t STATUS_LED_OK;
 extern const uint32_t STATUS_LED_WARNING;
@@ -118,8 +121,26 @@ class Component {
 
   bool is_failed();
 
+  /** Stop calling loop() for this component until enable_loop() is called.
+   *
+   * Components that only need loop() while some operation is in progress should disable it when idle, so the
+   * main loop doesn't spend time calling into them. Failed components are removed from the loop automatically.
+   */
+  void disable_loop();
+
+  /// Resume calling loop() after disable_loop().
+  void enable_loop();
+
   virtual bool can_proceed();
 
+  /** Whether setup() of this component may run while a component with a higher setup priority is still blocking
+   * the boot process (its can_proceed() returns false, e.g. Wi-Fi while connecting).
+   *
+   * Components that don't depend on the network or on other blocking components can return true here, so that
+   * they get set up right away instead of after the blocking component has finished. Defaults to false.
+   */
+  virtual bool can_setup_while_blocked() const;
+
   bool status_has_warning();
 
   bool status_has_error();
@@ -173,6 +194,12 @@ class Component {
    */
   void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);  // NOLINT
 
+  /** Set an interval function with a name that has static storage (usually a string literal).
+   *
+   * Unlike the std::string overload this neither copies nor allocates the name.
+   */
+  void set_interval(const char *name, uint32_t interval, std::function<void()> &&f);  // NOLINT
+
   void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
 
   /** Cancel an interval function.
@@ -181,6 +208,7 @@ class Component {
    * @return Whether an interval functions was deleted.
    */
   bool cancel_interval(const std::string &name);  // NOLINT
+  bool cancel_interval(const char *name);         // NOLINT
 
   /** Set an retry function with a unique name. Empty name means no cancelling possible.
    *
@@ -202,6 +230,9 @@ class Component {
   void set_retry(const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,  // NOLINT
                  std::function<RetryResult()> &&f, float backoff_increase_factor = 1.0f);    // NOLINT
 
+  void set_retry(const char *name, uint32_t initial_wait_time, uint8_t max_attempts,  // NOLINT
+                 std::function<RetryResult()> &&f, float backoff_increase_factor = 1.0f);  // NOLINT
+
   void set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std::function<RetryResult()> &&f,  // NOLINT
                  float backoff_increase_factor = 1.0f);                                               // NOLINT
 
@@ -211,6 +242,7 @@ class Component {
    * @return Whether a retry function was deleted.
    */
   bool cancel_retry(const std::string &name);  // NOLINT
+  bool cancel_retry(const char *name);         // NOLINT
 
   /** Set a timeout function with a unique name.
    *
@@ -228,6 +260,12 @@ class Component {
    */
   void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
+  /** Set a timeout function with a name that has static storage (usually a string literal).
+   *
+   * Unlike the std::string overload this neither copies nor allocates the name.
+   */
+  void set_timeout(const char *name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
+
   void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
   /** Cancel a timeout function.
@@ -236,6 +274,7 @@ class Component {
    * @return Whether a timeout functions was deleted.
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
+  bool cancel_timeout(const char *name);         // NOLINT
 
   /** Defer a callback to the next loop() call.
    *
@@ -245,12 +284,14 @@ class Component {
    * @param f The callback.
    */
   void defer(const std::string &name, std::function<void()> &&f);  // NOLINT
+  void defer(const char *name, std::function<void()> &&f);         // NOLINT
 
   /// Defer a callback to the next loop() call.
   void defer(std::function<void()> &&f);  // NOLINT
 
   /// Cancel a defer callback using the specified name, name must not be empty.
   bool cancel_defer(const std::string &name);  // NOLINT
+  bool cancel_defer(const char *name);         // NOLINT
 
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
@@ -292,18 +333,77 @@ class PollingComponent : public Component {
   /// Get the update interval in ms of this sensor
   virtual uint32_t get_update_interval() const;
 
+#ifdef USE_ESP32
+  /** Run update() in a separate FreeRTOS task pinned to the given core, instead of from the main loop.
+   *
+   * Only displays offer this (run_on_core): their update() renders into their own buffer and writes it out. The
+   * contract for update() running in the task:
+   *  - it must not publish states or call into other components, hand that back with App.scheduler.defer_from_task();
+   *  - the bus it writes to must not be used by other components;
+   *  - it may read plain values (like sensor and binary sensor states) and the states of text sensors and selects,
+   *    which are only changed under an UpdateTaskGuard. Anything else that main loop code changes (strings,
+   *    globals, containers) must not be read.
+   */
+  void set_update_task_core(int8_t core) { this->get_update_task_config_()->core = core; }
+  /// Stack size of the update task in bytes, rendering with large fonts or many nested lambdas may need more.
+  void set_update_task_stack_size(uint32_t stack_size) { this->get_update_task_config_()->stack_size = stack_size; }
+#endif
+
  protected:
   uint32_t update_interval_;
+#ifdef USE_ESP32
+  /// Only allocated for the few components with an update task, see set_update_task_core().
+  struct UpdateTask {
+    int8_t core{-1};
+    uint32_t stack_size{8192};
+    void *handle{nullptr};
+  };
+
+  UpdateTask *get_update_task_config_();
+  static void update_task_(void *arg);
+
+  UpdateTask *update_task_config_{nullptr};
+#endif
+};
+
+/** Held by update tasks (see PollingComponent::set_update_task_core()) while they run update(), and by main loop code
+ * while it changes values they may read. It's one lock for all update tasks, which only exists once one was started,
+ * so this does nothing on nodes without them.
+ *
+ * Only hold it for the change itself, not while calling callbacks: it's not recursive.
+ */
+class UpdateTaskGuard {
+ public:
+#ifdef USE_ESP32
+  UpdateTaskGuard();
+  ~UpdateTaskGuard();
+
+ protected:
+  Mutex *lock_;
+#else
+  UpdateTaskGuard() {}
+#endif
+};
+
+/// What kind of call into a component is being timed by WarnIfComponentBlockingGuard.
+enum class ComponentCallSource : uint8_t {
+  SETUP,
+  LOOP,
+  SCHEDULER,
 };
 
 class WarnIfComponentBlockingGuard {
  public:
-  WarnIfComponentBlockingGuard(Component *component);
+  WarnIfComponentBlockingGuard(Component *component, ComponentCallSource source = ComponentCallSource::LOOP);
   ~WarnIfComponentBlockingGuard();
 
  protected:
   uint32_t started_;
   Component *component_;
+#ifdef USE_DEBUG_PROFILER
+  uint32_t started_us_;
+  ComponentCallSource source_;
+#endif
 };
 
 }  // namespace esphome
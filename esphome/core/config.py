@@ -50,6 +50,9 @@ LoopTrigger = cg.esphome_ns.class_(
 VERSION_REGEX = re.compile(r"^[0-9]+\.[0-9]+\.[0-9]+(?:[ab]\d+)?$")
 
 CONF_NAME_ADD_MAC_SUFFIX = "name_add_mac_suffix"
+CONF_BOOT_PROFILE = "boot_profile"
+CONF_FAST_BOOT = "fast_boot"
+CONF_LOOP_BUDGET = "loop_budget"
 
 
 VALID_INCLUDE_EXTS = {".h", ".hpp", ".tcc", ".ino", ".cpp", ".c"}
@@ -127,6 +130,9 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_INCLUDES, default=[]): cv.ensure_list(valid_include),
             cv.Optional(CONF_LIBRARIES, default=[]): cv.ensure_list(cv.string_strict),
             cv.Optional(CONF_NAME_ADD_MAC_SUFFIX, default=False): cv.boolean,
+            cv.Optional(CONF_BOOT_PROFILE, default=False): cv.boolean,
+            cv.Optional(CONF_FAST_BOOT, default=False): cv.boolean,
+            cv.Optional(CONF_LOOP_BUDGET): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_PROJECT): cv.Schema(
                 {
                     cv.Required(CONF_NAME): cv.All(
@@ -283,6 +289,22 @@ async def _add_platformio_options(pio_options):
         cg.add_platformio_option(key, val)
 
 
+_REGISTER_RE = re.compile(r"^App\.register_(\w+)\(")
+
+
+@coroutine_with_priority(-1000.0)
+async def _add_registry_sizes():
+    # Everything is registered by now, so Application can reserve its registries at once
+    # instead of growing them (custom components registered in lambdas still can)
+    counts = {}
+    for statement in CORE.main_statements:
+        match = _REGISTER_RE.match(str(statement))
+        if match is not None:
+            counts[match.group(1)] = counts.get(match.group(1), 0) + 1
+    for kind, count in sorted(counts.items()):
+        cg.add_define(f"ESPHOME_{kind.upper()}_COUNT", count)
+
+
 @coroutine_with_priority(30.0)
 async def _add_automations(config):
     for conf in config.get(CONF_ON_BOOT, []):
@@ -319,7 +341,19 @@ async def to_code(config):
 
     CORE.add_job(_add_automations, config)
 
+    if "network" in CORE.loaded_integrations:
+        cg.add_define("USE_NETWORK")
+    if config[CONF_BOOT_PROFILE]:
+        cg.add_define("USE_BOOT_PROFILE")
+    if config[CONF_FAST_BOOT]:
+        cg.add_define("USE_FAST_BOOT")
+    if CONF_LOOP_BUDGET in config:
+        cg.add(cg.App.scheduler.set_loop_budget(config[CONF_LOOP_BUDGET]))
+    CORE.add_job(_add_registry_sizes)
+
     cg.add_build_flag("-fno-exceptions")
+    # For the size report (esphome compile --size-report)
+    cg.add_build_flag("-Wl,-Map,${BUILD_DIR}/firmware.map")
 
     # Libraries
     for lib in config[CONF_LIBRARIES]:
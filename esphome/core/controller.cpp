@@ -4,7 +4,24 @@
 
 namespace esphome {
 
+std::vector<Controller *> Controller::controllers_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+uint8_t Controller::state_batch_depth_ = 0;         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void Controller::begin_state_batch() {
+  if (state_batch_depth_++ != 0)
+    return;
+  for (auto *controller : controllers_)
+    controller->on_state_batch_begin();
+}
+void Controller::end_state_batch() {
+  if (state_batch_depth_ == 0 || --state_batch_depth_ != 0)
+    return;
+  for (auto *controller : controllers_)
+    controller->on_state_batch_end();
+}
+
 void Controller::setup_controller(bool include_internal) {
+  controllers_.push_back(this);
 #ifdef USE_BINARY_SENSOR
   for (auto *obj : App.get_binary_sensors()) {
     if (include_internal || !obj->is_internal())
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include "esphome/core/defines.h"
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
@@ -40,6 +41,19 @@ namespace esphome {
 class Controller {
  public:
   void setup_controller(bool include_internal = false);
+  /// A component starts publishing a group of related states, see StateBatch.
+  virtual void on_state_batch_begin() {}
+  /// All states of the group were published, they can be sent to the clients together now.
+  virtual void on_state_batch_end() {}
+
+  static void begin_state_batch();
+  static void end_state_batch();
+
+ protected:
+  static std::vector<Controller *> controllers_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  static uint8_t state_batch_depth_;             // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+ public:
 #ifdef USE_BINARY_SENSOR
   virtual void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state){};
 #endif
@@ -72,4 +86,23 @@ class Controller {
 #endif
 };
 
+/** Group the states a component publishes while this object exists.
+ *
+ * Frontends get on_state_batch_begin() before and on_state_batch_end() after the publish_state() calls, so for
+ * example the native API can send all the states in one packet. Batches can be nested, only the outermost one counts.
+ *
+ * \code
+ * StateBatch batch;
+ * this->voltage_->publish_state(voltage);
+ * this->current_->publish_state(current);
+ * \endcode
+ */
+class StateBatch {
+ public:
+  StateBatch() { Controller::begin_state_batch(); }
+  ~StateBatch() { Controller::end_state_batch(); }
+  StateBatch(const StateBatch &) = delete;
+  StateBatch &operator=(const StateBatch &) = delete;
+};
+
 }  // namespace esphome
@@ -16,22 +16,26 @@
 #define USE_API_NOISE
 #define USE_API_PLAINTEXT
 #define USE_BINARY_SENSOR
+#define USE_BOOT_PROFILE
 #define USE_BUTTON
 #define USE_CLIMATE
 #define USE_COVER
 #define USE_DEEP_SLEEP
 #define USE_FAN
+#define USE_FAST_BOOT
 #define USE_GRAPH
 #define USE_HOMEASSISTANT_TIME
 #define USE_LIGHT
 #define USE_LOGGER
 #define USE_MDNS
+#define USE_NETWORK
 #define USE_NUMBER
 #define USE_OTA_PASSWORD
 #define USE_OTA_STATE_CALLBACK
 #define USE_POWER_SUPPLY
 #define USE_SELECT
 #define USE_SENSOR
+#define USE_SOCKET_TCP_CLIENT_POOL
 #define USE_STATUS_LED
 #define USE_SWITCH
 #define USE_TEXT_SENSOR
@@ -57,6 +61,7 @@
 #define USE_ESP32_CAMERA
 #define USE_ESP32_IGNORE_EFUSE_MAC_CRC
 #define USE_IMPROV
+#define USE_LOGGER_CRASH_LOG_SIZE 2048  // NOLINT
 #define USE_SOCKET_IMPL_BSD_SOCKETS
 
 #ifdef USE_ARDUINO
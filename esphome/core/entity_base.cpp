@@ -13,6 +13,11 @@ void EntityBase::set_name(const std::string &name) {
   this->name_ = name;
   this->calc_object_id_();
 }
+void EntityBase::set_name(const std::string &name, const char *object_id, uint32_t object_id_hash) {
+  this->name_ = name;
+  this->object_id_ = object_id;
+  this->object_id_hash_ = object_id_hash;
+}
 
 // Entity Internal
 bool EntityBase::is_internal() const { return this->internal_; }
@@ -23,8 +28,8 @@ bool EntityBase::is_disabled_by_default() const { return this->disabled_by_defau
 void EntityBase::set_disabled_by_default(bool disabled_by_default) { this->disabled_by_default_ = disabled_by_default; }
 
 // Entity Icon
-const std::string &EntityBase::get_icon() const { return this->icon_; }
-void EntityBase::set_icon(const std::string &name) { this->icon_ = name; }
+std::string EntityBase::get_icon() const { return this->icon_ == nullptr ? "" : this->icon_; }
+void EntityBase::set_icon(const char *icon) { this->icon_ = icon; }
 
 // Entity Category
 EntityCategory EntityBase::get_entity_category() const { return this->entity_category_; }
@@ -20,6 +20,8 @@ class EntityBase {
   // Get/set the name of this Entity
   const std::string &get_name() const;
   void set_name(const std::string &name);
+  /// Set the name together with the object id and hash of it that codegen calculated already.
+  void set_name(const std::string &name, const char *object_id, uint32_t object_id_hash);
 
   // Get the sanitized name of this Entity as an ID. Caching it internally.
   const std::string &get_object_id();
@@ -41,9 +43,9 @@ class EntityBase {
   EntityCategory get_entity_category() const;
   void set_entity_category(EntityCategory entity_category);
 
-  // Get/set this entity's icon
-  const std::string &get_icon() const;
-  void set_icon(const std::string &name);
+  // Get/set this entity's icon, the icon string is referenced (usually a literal in flash), not copied.
+  std::string get_icon() const;
+  void set_icon(const char *icon);
 
  protected:
   virtual uint32_t hash_base() = 0;
@@ -51,7 +53,7 @@ class EntityBase {
 
   std::string name_;
   std::string object_id_;
-  std::string icon_;
+  const char *icon_{nullptr};
   uint32_t object_id_hash_;
   bool internal_{false};
   bool disabled_by_default_{false};
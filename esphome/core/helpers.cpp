@@ -5,6 +5,7 @@
 #include <cctype>
 #include <cmath>
 #include <cstring>
+#include <atomic>
 
 #if defined(USE_ESP8266)
 #include <osapi.h>
@@ -17,6 +18,12 @@
 #include "esp_system.h"
 #include <freertos/FreeRTOS.h>
 #include <freertos/portmacro.h>
+#elif defined(USE_HOST)
+#include <random>
+#endif
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#include <soc/soc_memory_layout.h>
 #endif
 #ifdef USE_ESP32_IGNORE_EFUSE_MAC_CRC
 #include "esp_efuse.h"
@@ -69,6 +76,9 @@ uint32_t random_uint32() {
   return esp_random();
 #elif defined(USE_ESP8266)
   return os_random();
+#elif defined(USE_HOST)
+  std::random_device dev;
+  return dev();
 #endif
 }
 
@@ -82,6 +92,10 @@ void fill_random(uint8_t *data, size_t len) {
 #elif defined(USE_ESP8266)
   int err = os_get_random(data, len);
   assert(err == 0);
+#elif defined(USE_HOST)
+  std::random_device dev;
+  for (size_t i = 0; i < len; i++)
+    data[i] = dev();
 #else
 #error "No random source for this system config"
 #endif
@@ -120,15 +134,50 @@ float gamma_uncorrect(float value, float gamma) {
   return powf(value, 1 / gamma);
 }
 
-std::string value_accuracy_to_string(float value, int8_t accuracy_decimals) {
+static const uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+static const int8_t POW10_MAX = sizeof(POW10) / sizeof(POW10[0]) - 1;
+
+size_t value_accuracy_to_buf(char *buf, size_t len, float value, int8_t accuracy_decimals) {
+  if (len == 0)
+    return 0;
   if (accuracy_decimals < 0) {
     auto multiplier = powf(10.0f, accuracy_decimals);
     value = roundf(value * multiplier) / multiplier;
     accuracy_decimals = 0;
   }
-  char tmp[32];  // should be enough, but we should maybe improve this at some point.
-  snprintf(tmp, sizeof(tmp), "%.*f", accuracy_decimals, value);
-  return std::string(tmp);
+  // Anything the integer path can't represent exactly goes through printf.
+  if (!std::isfinite(value) || accuracy_decimals > POW10_MAX ||
+      std::fabs(static_cast<double>(value)) * POW10[accuracy_decimals] >= 1e18) {
+    int written = snprintf(buf, len, "%.*f", accuracy_decimals, value);
+    return written < 0 ? 0 : std::min(static_cast<size_t>(written), len - 1);
+  }
+  // Round half to even like printf does.
+  uint64_t scaled = llrint(std::fabs(static_cast<double>(value)) * POW10[accuracy_decimals]);
+
+  // Write the digits backwards, then copy them out in order.
+  char tmp[24];
+  int pos = 0;
+  for (int digit = 0; scaled != 0 || digit <= accuracy_decimals; digit++) {
+    if (digit == accuracy_decimals && digit != 0)
+      tmp[pos++] = '.';
+    tmp[pos++] = static_cast<char>('0' + scaled % 10);
+    scaled /= 10;
+  }
+  // Like printf, keep the sign of negative values that round to zero.
+  if (std::signbit(value))
+    tmp[pos++] = '-';
+
+  size_t count = std::min(static_cast<size_t>(pos), len - 1);
+  for (size_t i = 0; i < count; i++)
+    buf[i] = tmp[pos - 1 - i];
+  buf[count] = '\0';
+  return count;
+}
+
+std::string value_accuracy_to_string(float value, int8_t accuracy_decimals) {
+  char tmp[VALUE_ACCURACY_MAX_LEN];
+  size_t len = value_accuracy_to_buf(tmp, sizeof(tmp), value, accuracy_decimals);
+  return std::string(tmp, len);
 }
 
 ParseOnOffState parse_on_off(const char *str, const char *on, const char *off) {
@@ -176,11 +225,12 @@ void delay_microseconds_safe(uint32_t us) {  // avoids CPU locks that could trig
     ;
 }
 
-uint32_t fnv1_hash(const std::string &str) {
+uint32_t fnv1_hash(const std::string &str) { return fnv1_hash(str.c_str()); }
+uint32_t fnv1_hash(const char *str) {
   uint32_t hash = 2166136261UL;
-  for (char c : str) {
+  for (; *str != '\0'; str++) {
     hash *= 16777619UL;
-    hash ^= c;
+    hash ^= *str;
   }
   return hash;
 }
@@ -312,6 +362,98 @@ IRAM_ATTR InterruptLock::InterruptLock() { portDISABLE_INTERRUPTS(); }
 IRAM_ATTR InterruptLock::~InterruptLock() { portENABLE_INTERRUPTS(); }
 #endif
 
+#ifdef USE_ESP32
+Mutex::Mutex() { handle_ = xSemaphoreCreateMutex(); }
+void Mutex::lock() { xSemaphoreTake(this->handle_, portMAX_DELAY); }
+bool Mutex::try_lock() { return xSemaphoreTake(this->handle_, 0) == pdTRUE; }
+void Mutex::unlock() { xSemaphoreGive(this->handle_); }
+#else
+Mutex::Mutex() = default;
+void Mutex::lock() {}
+bool Mutex::try_lock() { return true; }
+void Mutex::unlock() {}
+#endif
+
+// Memory
+
+namespace {
+struct RAMPolicyState {
+  bool external;
+  std::atomic<size_t> internal_bytes{0};
+  std::atomic<size_t> external_bytes{0};
+  std::atomic<size_t> peak_bytes{0};
+  std::atomic<uint32_t> failures{0};
+};
+}  // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static RAMPolicyState ram_policies[RAM_POLICY_COUNT] = {{false}, {true}};
+
+void *ram_allocate(RAMPolicy policy, size_t size) {
+  RAMPolicyState &state = ram_policies[static_cast<uint8_t>(policy)];
+  void *ptr = nullptr;
+  bool external = false;
+#ifdef USE_ESP32
+  if (state.external) {
+    ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    external = ptr != nullptr;
+  }
+  if (ptr == nullptr)
+    ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#else
+  ptr = malloc(size);  // NOLINT(cppcoreguidelines-owning-memory,cppcoreguidelines-no-malloc)
+#endif
+  if (ptr == nullptr) {
+    state.failures++;
+    return nullptr;
+  }
+  if (external) {
+    state.external_bytes += size;
+  } else {
+    state.internal_bytes += size;
+  }
+  size_t total = state.internal_bytes.load() + state.external_bytes.load();
+  size_t peak = state.peak_bytes.load();
+  while (total > peak && !state.peak_bytes.compare_exchange_weak(peak, total)) {
+  }
+  return ptr;
+}
+void ram_free(RAMPolicy policy, void *ptr, size_t size) {
+  if (ptr == nullptr)
+    return;
+  RAMPolicyState &state = ram_policies[static_cast<uint8_t>(policy)];
+#ifdef USE_ESP32
+  if (esp_ptr_external_ram(ptr)) {
+    state.external_bytes -= size;
+  } else {
+    state.internal_bytes -= size;
+  }
+#else
+  state.internal_bytes -= size;
+#endif
+  free(ptr);  // NOLINT(cppcoreguidelines-owning-memory,cppcoreguidelines-no-malloc)
+}
+void ram_policy_set_external(RAMPolicy policy, bool external) {
+  ram_policies[static_cast<uint8_t>(policy)].external = external;
+}
+RAMPolicyStats ram_policy_stats(RAMPolicy policy) {
+  const RAMPolicyState &state = ram_policies[static_cast<uint8_t>(policy)];
+  return RAMPolicyStats{state.internal_bytes.load(), state.external_bytes.load(), state.peak_bytes.load(),
+                        state.failures.load()};
+}
+size_t ram_policy_max_allocation(RAMPolicy policy) {
+#ifdef USE_ESP32
+  size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (ram_policies[static_cast<uint8_t>(policy)].external)
+    largest = std::max(largest, heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  return largest;
+#elif defined(USE_ESP8266)
+  return ESP.getMaxFreeBlockSize();  // NOLINT(readability-static-accessed-through-instance)
+#else
+  return SIZE_MAX;
+#endif
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 
 // Strings
@@ -320,7 +462,7 @@ std::string str_truncate(const std::string &str, size_t length) {
   return str.length() > length ? str.substr(0, length) : str;
 }
 std::string str_until(const char *str, char ch) {
-  char *pos = strchr(str, ch);
+  const char *pos = strchr(str, ch);
   return pos == nullptr ? std::string(str) : std::string(str, pos - str);
 }
 std::string str_until(const std::string &str, char ch) { return str.substr(0, str.find(ch)); }
@@ -11,6 +11,8 @@
 
 #ifdef USE_ESP32
 #include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #endif
 
 #include "esphome/core/optional.h"
@@ -102,6 +104,16 @@ float gamma_correct(float value, float gamma);
 /// Reverts gamma correction with the provided gamma to value.
 float gamma_uncorrect(float value, float gamma);
 
+/// Buffer size that always fits the result of value_accuracy_to_buf(), including the terminating null byte.
+static const size_t VALUE_ACCURACY_MAX_LEN = 48;
+
+/** Format a value with an accuracy in decimals into buf, like printf's "%.*f" but without its float formatting.
+ *
+ * Negative accuracies round to tens, hundreds etc. Returns the length of the string written (without the null
+ * terminator), which is truncated to fit len.
+ */
+size_t value_accuracy_to_buf(char *buf, size_t len, float value, int8_t accuracy_decimals);
+
 /// Create a string from a value and an accuracy in decimals.
 std::string value_accuracy_to_string(float value, int8_t accuracy_decimals);
 
@@ -143,6 +155,37 @@ class InterruptLock {
 #endif
 };
 
+/** Mutex implementation, with API based on the unavailable std::mutex.
+ *
+ * Use this to protect data that is shared between the main loop and other FreeRTOS tasks. On platforms that don't
+ * run multiple tasks (ESP8266) this is a no-op.
+ */
+class Mutex {
+ public:
+  Mutex();
+  Mutex(const Mutex &) = delete;
+  Mutex &operator=(const Mutex &) = delete;
+
+  void lock();
+  bool try_lock();
+  void unlock();
+
+ protected:
+#ifdef USE_ESP32
+  SemaphoreHandle_t handle_;
+#endif
+};
+
+/// Helper class that acquires a Mutex for as long as it's in scope, like std::lock_guard.
+class LockGuard {
+ public:
+  LockGuard(Mutex &mutex) : mutex_(mutex) { mutex_.lock(); }
+  ~LockGuard() { mutex_.unlock(); }
+
+ protected:
+  Mutex &mutex_;
+};
+
 /// Calculate a crc8 of data with the provided data length.
 uint8_t crc8(uint8_t *data, uint8_t len);
 
@@ -168,21 +211,37 @@ template<typename T, enable_if_t<std::is_pointer<T *>::value, int> = 0> T &id(T
 template<typename... X> class CallbackManager;
 
 /** Simple helper class to allow having multiple subscribers to a signal.
+ *
+ * Most signals have at most one subscriber (e.g. the API or MQTT client), so the first callback is stored inline
+ * and only additional callbacks are put in a heap-allocated list.
  *
  * @tparam Ts The arguments for the callback, wrapped in void().
  */
 template<typename... Ts> class CallbackManager<void(Ts...)> {
  public:
   /// Add a callback to the internal callback list.
-  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  void add(std::function<void(Ts...)> &&callback) {
+    if (!this->first_) {
+      this->first_ = std::move(callback);
+    } else {
+      this->callbacks_.push_back(std::move(callback));
+    }
+  }
 
   /// Call all callbacks in this manager.
   void call(Ts... args) {
+    if (!this->first_)
+      return;
+    this->first_(args...);
     for (auto &cb : this->callbacks_)
       cb(args...);
   }
 
+  /// Get the number of registered callbacks.
+  size_t size() const { return this->first_ ? this->callbacks_.size() + 1 : 0; }
+
  protected:
+  std::function<void(Ts...)> first_;
   std::vector<std::function<void(Ts...)>> callbacks_;
 };
 
@@ -230,6 +289,7 @@ template<typename T> class Parented {
 };
 
 uint32_t fnv1_hash(const std::string &str);
+uint32_t fnv1_hash(const char *str);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -562,6 +622,56 @@ template<class T> class ExternalRAMAllocator {
   Flags flags_{Flags::NONE};
 };
 
+/// What a buffer is used for, which decides the memory it's allocated from (see ram_allocate()).
+enum class RAMPolicy : uint8_t {
+  /// Buffers used by DMA, from interrupts or in timing critical code, always in internal RAM.
+  INTERNAL = 0,
+  /// Large buffers that are fine in slower memory (frame buffers, queues, documents), in external RAM if there is any.
+  BULK,
+};
+static const uint8_t RAM_POLICY_COUNT = 2;
+
+/// The memory currently allocated through a policy.
+struct RAMPolicyStats {
+  size_t internal_bytes;  ///< Allocated from internal RAM.
+  size_t external_bytes;  ///< Allocated from external (SPI) RAM.
+  size_t peak_bytes;      ///< The most that was allocated at once.
+  uint32_t failures;      ///< Allocations that couldn't be served.
+};
+
+/// Allocate a buffer of size bytes for the given policy, nullptr if there's no memory for it.
+void *ram_allocate(RAMPolicy policy, size_t size);
+/// Free a buffer returned by ram_allocate() for the same policy and size.
+void ram_free(RAMPolicy policy, void *ptr, size_t size);
+/// Allow or prevent placing the buffers of a policy in external RAM, only affects later allocations.
+void ram_policy_set_external(RAMPolicy policy, bool external);
+RAMPolicyStats ram_policy_stats(RAMPolicy policy);
+/// The largest buffer ram_allocate() can currently return for a policy.
+size_t ram_policy_max_allocation(RAMPolicy policy);
+
+/// An STL allocator that allocates through a RAMPolicy and aborts if that fails, like the default allocator.
+template<class T, RAMPolicy P> class RAMAllocator {
+ public:
+  using value_type = T;
+  template<class U> struct rebind {
+    using other = RAMAllocator<U, P>;
+  };
+
+  RAMAllocator() = default;
+  template<class U> constexpr RAMAllocator(const RAMAllocator<U, P> &other) {}
+
+  T *allocate(size_t n) {
+    T *ptr = static_cast<T *>(ram_allocate(P, n * sizeof(T)));
+    if (ptr == nullptr)
+      abort();
+    return ptr;
+  }
+  void deallocate(T *p, size_t n) { ram_free(P, p, n * sizeof(T)); }
+
+  bool operator==(const RAMAllocator &other) const { return true; }
+  bool operator!=(const RAMAllocator &other) const { return false; }
+};
+
 /// @}
 
 /// @name Deprecated functions
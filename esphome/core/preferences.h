@@ -3,6 +3,7 @@
 #include <cstring>
 #include <cstdint>
 
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 
 namespace esphome {
@@ -21,7 +22,10 @@ class ESPPreferenceObject {
   template<typename T> bool save(const T *src) {
     if (backend_ == nullptr)
       return false;
-    return backend_->save(reinterpret_cast<const uint8_t *>(src), sizeof(T));
+    if (!backend_->save(reinterpret_cast<const uint8_t *>(src), sizeof(T)))
+      return false;
+    this->request_sync_();
+    return true;
   }
 
   template<typename T> bool load(T *dest) {
@@ -31,6 +35,8 @@ class ESPPreferenceObject {
   }
 
  protected:
+  void request_sync_() const;
+
   ESPPreferenceBackend *backend_{nullptr};
 };
 
@@ -55,8 +61,47 @@ class ESPPreferences {
   ESPPreferenceObject make_preference(uint32_t type) {
     return this->make_preference(sizeof(T), type);
   }
+
+  /** Ask for pending saves to be written to flash within max_delay ms, a syncer writes them once the earliest
+   * requested deadline passed. 0 uses the default delay.
+   */
+  void request_sync(uint32_t max_delay) {
+    if (max_delay == 0)
+      max_delay = this->default_sync_delay_;
+    const uint32_t deadline = millis() + max_delay;
+    if (!this->sync_requested_ || static_cast<int32_t>(deadline - this->sync_deadline_) < 0)
+      this->sync_deadline_ = deadline;
+    this->sync_requested_ = true;
+  }
+  bool is_sync_requested() const { return this->sync_requested_; }
+  uint32_t get_sync_deadline() const { return this->sync_deadline_; }
+  void clear_sync_request() { this->sync_requested_ = false; }
+  void set_default_sync_delay(uint32_t default_sync_delay) { this->default_sync_delay_ = default_sync_delay; }
+
+  /// Latency-sensitive work (like a running light effect) holds back syncer writes while it runs.
+  void hold_writes() { this->write_holds_++; }
+  void release_writes() {
+    if (this->write_holds_ > 0)
+      this->write_holds_--;
+  }
+  bool are_writes_held() const { return this->write_holds_ != 0; }
+
+  /// Number of flash writes done by sync() since boot.
+  uint32_t get_flash_writes() const { return this->flash_writes_; }
+  /// Number of pending saves sync() didn't write because the flash already held the same data.
+  uint32_t get_skipped_writes() const { return this->skipped_writes_; }
+
+ protected:
+  uint32_t flash_writes_{0};
+  uint32_t skipped_writes_{0};
+  bool sync_requested_{false};
+  uint32_t sync_deadline_{0};
+  uint32_t default_sync_delay_{60000};
+  uint8_t write_holds_{0};
 };
 
 extern ESPPreferences *global_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
+inline void ESPPreferenceObject::request_sync_() const { global_preferences->request_sync(0); }
+
 }  // namespace esphome
@@ -0,0 +1,63 @@
+#include "esphome/core/publish_queue.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+PublishQueue::PublishQueue() {
+  for (uint32_t i = 0; i < SIZE; i++)
+    this->slots_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool IRAM_ATTR PublishQueue::push(PublishHandler handler, void *target, uint32_t value) {
+#ifdef USE_ESP8266
+  // single core, so keeping interrupts out is enough, and there's no native compare-and-swap
+  InterruptLock lock;
+  uint32_t pos = this->push_pos_.load(std::memory_order_relaxed);
+  Slot *slot = &this->slots_[pos % SIZE];
+  if (slot->sequence.load(std::memory_order_acquire) != pos) {
+    this->dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  this->push_pos_.store(pos + 1, std::memory_order_relaxed);
+#else
+  uint32_t pos = this->push_pos_.load(std::memory_order_relaxed);
+  Slot *slot;
+  while (true) {
+    slot = &this->slots_[pos % SIZE];
+    auto diff = static_cast<int32_t>(slot->sequence.load(std::memory_order_acquire) - pos);
+    if (diff == 0) {
+      // the slot is free, reserve it unless another producer was faster
+      if (this->push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      // the slot still holds the record from one round ago: full
+      this->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      pos = this->push_pos_.load(std::memory_order_relaxed);
+    }
+  }
+#endif
+  slot->handler = handler;
+  slot->target = target;
+  slot->value = value;
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+void PublishQueue::drain() {
+  while (true) {
+    Slot &slot = this->slots_[this->drain_pos_ % SIZE];
+    if (slot.sequence.load(std::memory_order_acquire) != this->drain_pos_ + 1)
+      return;
+    PublishHandler handler = slot.handler;
+    void *target = slot.target;
+    uint32_t value = slot.value;
+    // free the slot before the handler runs, producers can already reuse it
+    slot.sequence.store(this->drain_pos_ + SIZE, std::memory_order_release);
+    this->drain_pos_++;
+    handler(target, value);
+  }
+}
+
+}  // namespace esphome
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "esphome/core/hal.h"
+
+namespace esphome {
+
+/// Called from the main loop with the target and value of a pushed record.
+using PublishHandler = void (*)(void *target, uint32_t value);
+
+/** Fixed size multi-producer single-consumer queue that hands states over to the main loop.
+ *
+ * Records can be pushed from interrupts, other FreeRTOS tasks and the other core; pushing never allocates or blocks,
+ * a record that doesn't fit is counted as dropped. The application drains the queue at the start of every loop() and
+ * calls the handler of each record there, so it's safe to publish states from it.
+ *
+ * On a multi-core chip this is a bounded queue with a sequence number per slot (producers reserve a slot with a
+ * compare-and-swap). Single-core chips only need to keep interrupts out while a slot is reserved.
+ */
+class PublishQueue {
+ public:
+  PublishQueue();
+
+  /// Queue handler(target, value) to be called from the main loop, false if the queue is full.
+  bool push(PublishHandler handler, void *target, uint32_t value);
+
+  /// Queue target->publish_state(value) for an entity with a float state, like a sensor.
+  template<typename T> bool IRAM_ATTR push_float(T *target, float value) {
+    uint32_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    return this->push(
+        [](void *obj, uint32_t state) {
+          float f;
+          memcpy(&f, &state, sizeof(f));
+          static_cast<T *>(obj)->publish_state(f);
+        },
+        target, raw);
+  }
+  /// Queue target->publish_state(value) for an entity with a bool state, like a binary sensor.
+  template<typename T> bool IRAM_ATTR push_bool(T *target, bool value) {
+    return this->push([](void *obj, uint32_t state) { static_cast<T *>(obj)->publish_state(state != 0); }, target,
+                      value);
+  }
+
+  /// Call the handlers of all queued records. Only called by the main loop.
+  void drain();
+
+  /// Number of records that didn't fit since the last call.
+  uint32_t take_dropped() { return this->dropped_.exchange(0, std::memory_order_relaxed); }
+
+  /// Has to be a power of two, so that the slot index stays consistent when the positions wrap around.
+  static const uint32_t SIZE = 32;
+
+ protected:
+  struct Slot {
+    /// The position this slot is free for (== position) or filled at (== position + 1).
+    std::atomic<uint32_t> sequence;
+    PublishHandler handler;
+    void *target;
+    uint32_t value;
+  };
+
+  Slot slots_[SIZE];
+  std::atomic<uint32_t> push_pos_{0};
+  /// Only touched by the main loop.
+  uint32_t drain_pos_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace esphome
@@ -3,48 +3,106 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/hal.h"
 #include <algorithm>
+#include <cstring>
 
 namespace esphome {
 
 static const char *const TAG = "scheduler";
 
-static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+// Number of finished items kept around for reuse, so steady-state timeouts and defers don't hit the heap
+static const size_t MAX_POOL_SIZE = 8;
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
 
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
                                 std::function<void()> &&func) {
-  const uint32_t now = this->millis_();
+  this->set_timeout_(component, name.c_str(), true, timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout(Component *component, const char *name, uint32_t timeout,
+                                std::function<void()> &&func) {
+  this->set_timeout_(component, name, false, timeout, std::move(func));
+}
+bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name_hash(name), name.c_str(), SchedulerItem::TIMEOUT);
+}
+bool HOT Scheduler::cancel_timeout(Component *component, const char *name) {
+  return this->cancel_item_(component, name_hash(name), name, SchedulerItem::TIMEOUT);
+}
+void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
+                                 std::function<void()> &&func) {
+  this->set_interval_(component, name.c_str(), true, interval, std::move(func));
+}
+void HOT Scheduler::set_interval(Component *component, const char *name, uint32_t interval,
+                                 std::function<void()> &&func) {
+  this->set_interval_(component, name, false, interval, std::move(func));
+}
+bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name_hash(name), name.c_str(), SchedulerItem::INTERVAL);
+}
+bool HOT Scheduler::cancel_interval(Component *component, const char *name) {
+  return this->cancel_item_(component, name_hash(name), name, SchedulerItem::INTERVAL);
+}
+void HOT Scheduler::set_retry(Component *component, const std::string &name, uint32_t initial_wait_time,
+                              uint8_t max_attempts, std::function<RetryResult()> &&func,
+                              float backoff_increase_factor) {
+  this->set_retry_(component, name.c_str(), true, initial_wait_time, max_attempts, std::move(func),
+                   backoff_increase_factor);
+}
+void HOT Scheduler::set_retry(Component *component, const char *name, uint32_t initial_wait_time,
+                              uint8_t max_attempts, std::function<RetryResult()> &&func,
+                              float backoff_increase_factor) {
+  this->set_retry_(component, name, false, initial_wait_time, max_attempts, std::move(func),
+                   backoff_increase_factor);
+}
+bool HOT Scheduler::cancel_retry(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name_hash(name), name.c_str(), SchedulerItem::RETRY);
+}
+bool HOT Scheduler::cancel_retry(Component *component, const char *name) {
+  return this->cancel_item_(component, name_hash(name), name, SchedulerItem::RETRY);
+}
 
-  if (!name.empty())
-    this->cancel_timeout(component, name);
+uint32_t Scheduler::name_hash(const char *name) {
+  if (name == nullptr || *name == '\0')
+    return 0;
+  uint32_t hash = fnv1_hash(name);
+  // 0 is reserved for unnamed items
+  return hash != 0 ? hash : 1;
+}
+uint32_t Scheduler::name_hash(const std::string &name) { return name_hash(name.c_str()); }
+
+void HOT Scheduler::set_timeout_(Component *component, const char *name, bool copy_name, uint32_t timeout,
+                                 std::function<void()> &&func) {
+  const uint64_t now = this->millis_();
+  const uint32_t name_hash = Scheduler::name_hash(name);
+
+  if (name_hash != 0)
+    this->cancel_item_(component, name_hash, name, SchedulerItem::TIMEOUT);
 
   if (timeout == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
+  ESP_LOGVV(TAG, "set_timeout(name='%s' (0x%08X), timeout=%u)", name == nullptr ? "" : name, name_hash, timeout);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
-  item->name = name;
+  item->set_name(name_hash != 0 ? name : nullptr, copy_name);
+  item->name_hash = name_hash;
   item->type = SchedulerItem::TIMEOUT;
   item->timeout = timeout;
-  item->last_execution = now;
-  item->last_execution_major = this->millis_major_;
-  item->void_callback = std::move(func);
+  item->next_execution = now + timeout;
+  item->set_callback(std::move(func));
   item->remove = false;
+  this->index_add_(item.get());
   this->push_(std::move(item));
 }
-bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
-}
-void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
-                                 std::function<void()> &&func) {
-  const uint32_t now = this->millis_();
+void HOT Scheduler::set_interval_(Component *component, const char *name, bool copy_name, uint32_t interval,
+                                  std::function<void()> &&func) {
+  const uint64_t now = this->millis_();
+  const uint32_t name_hash = Scheduler::name_hash(name);
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  if (name_hash != 0)
+    this->cancel_item_(component, name_hash, name, SchedulerItem::INTERVAL);
 
   if (interval == SCHEDULER_DONT_RUN)
     return;
@@ -54,176 +112,165 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
   if (interval != 0)
     offset = (random_uint32() % interval) / 2;
 
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name.c_str(), interval, offset);
+  ESP_LOGVV(TAG, "set_interval(name='%s' (0x%08X), interval=%u, offset=%u)", name == nullptr ? "" : name, name_hash,
+            interval, offset);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
-  item->name = name;
+  item->set_name(name_hash != 0 ? name : nullptr, copy_name);
+  item->name_hash = name_hash;
   item->type = SchedulerItem::INTERVAL;
   item->interval = interval;
-  item->last_execution = now - offset - interval;
-  item->last_execution_major = this->millis_major_;
-  if (item->last_execution > now)
-    item->last_execution_major--;
-  item->void_callback = std::move(func);
+  // Run as soon as possible, the offset only shifts the phase of subsequent executions
+  item->next_execution = now > offset ? now - offset : 0;
+  item->set_callback(std::move(func));
   item->remove = false;
+  this->index_add_(item.get());
   this->push_(std::move(item));
 }
-bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
-}
-
-void HOT Scheduler::set_retry(Component *component, const std::string &name, uint32_t initial_wait_time,
-                              uint8_t max_attempts, std::function<RetryResult()> &&func,
-                              float backoff_increase_factor) {
-  const uint32_t now = this->millis_();
+void HOT Scheduler::set_retry_(Component *component, const char *name, bool copy_name, uint32_t initial_wait_time,
+                               uint8_t max_attempts, std::function<RetryResult()> &&func,
+                               float backoff_increase_factor) {
+  const uint64_t now = this->millis_();
+  const uint32_t name_hash = Scheduler::name_hash(name);
 
-  if (!name.empty())
-    this->cancel_retry(component, name);
+  if (name_hash != 0)
+    this->cancel_item_(component, name_hash, name, SchedulerItem::RETRY);
 
   if (initial_wait_time == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_retry(name='%s', initial_wait_time=%u,max_attempts=%u, backoff_factor=%0.1f)", name.c_str(),
-            initial_wait_time, max_attempts, backoff_increase_factor);
+  ESP_LOGVV(TAG, "set_retry(name='%s' (0x%08X), initial_wait_time=%u,max_attempts=%u, backoff_factor=%0.1f)",
+            name == nullptr ? "" : name, name_hash, initial_wait_time, max_attempts, backoff_increase_factor);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
-  item->name = name;
+  item->set_name(name_hash != 0 ? name : nullptr, copy_name);
+  item->name_hash = name_hash;
   item->type = SchedulerItem::RETRY;
   item->interval = initial_wait_time;
   item->retry_countdown = max_attempts;
   item->backoff_multiplier = backoff_increase_factor;
-  item->last_execution = now - initial_wait_time;
-  item->last_execution_major = this->millis_major_;
-  if (item->last_execution > now)
-    item->last_execution_major--;
-  item->retry_callback = std::move(func);
+  item->next_execution = now;
+  item->set_callback(std::move(func));
   item->remove = false;
+  this->index_add_(item.get());
   this->push_(std::move(item));
 }
-bool HOT Scheduler::cancel_retry(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::RETRY);
+
+void Scheduler::defer_from_task(Component *component, std::function<void()> &&func) {
+  LockGuard guard{this->task_deferred_lock_};
+  this->task_deferred_.emplace_back(component, std::move(func));
 }
 
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
-  if (this->empty_())
+  if (this->items_.empty())
     return {};
   auto &item = this->items_[0];
-  const uint32_t now = this->millis_();
-  uint32_t next_time = item->last_execution + item->interval;
-  if (next_time < now)
+  const uint64_t now = this->millis_();
+  if (item->next_execution <= now)
     return 0;
-  return next_time - now;
+  return std::min<uint64_t>(item->next_execution - now, UINT32_MAX);
 }
 void IRAM_ATTR HOT Scheduler::call() {
-  const uint32_t now = this->millis_();
+  const uint64_t now = this->millis_();
   this->process_to_add();
 
+  if (!this->task_deferred_.empty()) {
+    std::vector<std::pair<Component *, std::function<void()>>> deferred;
+    {
+      LockGuard guard{this->task_deferred_lock_};
+      deferred.swap(this->task_deferred_);
+    }
+    for (auto &it : deferred) {
+      if (it.first != nullptr && it.first->is_failed())
+        continue;
+      WarnIfComponentBlockingGuard guard{it.first, ComponentCallSource::SCHEDULER};
+      it.second();
+    }
+  }
+
 #ifdef ESPHOME_DEBUG_SCHEDULER
-  static uint32_t last_print = 0;
+  static uint64_t last_print = 0;
 
   if (now - last_print > 2000) {
     last_print = now;
-    std::vector<std::unique_ptr<SchedulerItem>> old_items;
-    ESP_LOGVV(TAG, "Items: count=%u, now=%u", this->items_.size(), now);
-    while (!this->empty_()) {
-      auto item = std::move(this->items_[0]);
-      ESP_LOGVV(TAG, "  %s '%s' interval=%u last_execution=%u (%u) next=%u (%u)", item->get_type_str(),
-                item->name.c_str(), item->interval, item->last_execution, item->last_execution_major,
-                item->next_execution(), item->next_execution_major());
-
-      this->pop_raw_();
-      old_items.push_back(std::move(item));
+    ESP_LOGVV(TAG, "Items: count=%u, now=%llu", this->items_.size(), now);
+    for (auto &item : this->items_) {
+      ESP_LOGVV(TAG, "  %s '%s' interval=%u next=%llu", item->get_type_str(), item->get_name_str(),
+                item->interval, item->next_execution);
     }
     ESP_LOGVV(TAG, "\n");
-    this->items_ = std::move(old_items);
   }
 #endif  // ESPHOME_DEBUG_SCHEDULER
 
-  auto to_remove_was = to_remove_;
-  auto items_was = items_.size();
-  // If we have too many items to remove
-  if (to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
-    std::vector<std::unique_ptr<SchedulerItem>> valid_items;
-    while (!this->empty_()) {
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      valid_items.push_back(std::move(item));
+  const uint32_t started = millis();
+  bool ran_any = false;
+  while (!this->items_.empty() && this->items_[0]->next_execution <= now) {
+    if (this->loop_budget_ != 0 && ran_any && millis() - started + this->items_[0]->cost > this->loop_budget_) {
+      // Leave the rest for the next loop iteration
+      this->items_[0]->deferred = true;
+      break;
     }
-    this->items_ = std::move(valid_items);
+    // Take the item out of the heap while it runs, cancelling it in the meantime only marks it as removed.
+    auto item = this->heap_remove_(0);
 
-    // The following should not happen unless I'm missing something
-    if (to_remove_ != 0) {
-      ESP_LOGW(TAG, "to_remove_ was %u now: %u items where %zu now %zu. Please report this", to_remove_was, to_remove_,
-               items_was, items_.size());
-      to_remove_ = 0;
+    // Don't run on failed components
+    if (item->component != nullptr && item->component->is_failed()) {
+      this->index_remove_(item.get());
+      this->recycle_item_(std::move(item));
+      continue;
     }
-  }
-
-  while (!this->empty_()) {
-    RetryResult retry_result = RETRY;
-    // use scoping to indicate visibility of `item` variable
-    {
-      // Don't copy-by value yet
-      auto &item = this->items_[0];
-      if ((now - item->last_execution) < item->interval)
-        // Not reached timeout yet, done for this call
-        break;
-      uint8_t major = item->next_execution_major();
-      if (this->millis_major_ - major > 1)
-        break;
-
-      // Don't run on failed components
-      if (item->component != nullptr && item->component->is_failed()) {
-        this->pop_raw_();
-        continue;
-      }
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
-      ESP_LOGVV(TAG, "Running %s '%s' with interval=%u last_execution=%u (now=%u)", item->get_type_str(),
-                item->name.c_str(), item->interval, item->last_execution, now);
+    ESP_LOGVV(TAG, "Running %s '%s' with interval=%u next_execution=%llu (now=%llu)", item->get_type_str(),
+              item->get_name_str(), item->interval, item->next_execution, now);
 #endif
 
-      // Warning: During callback(), a lot of stuff can happen, including:
-      //  - timeouts/intervals get added, potentially invalidating vector pointers
-      //  - timeouts/intervals get cancelled
-      {
-        WarnIfComponentBlockingGuard guard{item->component};
-        if (item->type == SchedulerItem::RETRY)
-          retry_result = item->retry_callback();
-        else
-          item->void_callback();
-      }
-    }
-
+    // Warning: During callback(), a lot of stuff can happen, including:
+    //  - timeouts/intervals get added
+    //  - timeouts/intervals get cancelled, including this one
+    RetryResult retry_result = RETRY;
+    const uint32_t item_started = this->loop_budget_ != 0 ? millis() : 0;
     {
-      // new scope, item from before might have been moved in the vector
-      auto item = std::move(this->items_[0]);
-
-      // Only pop after function call, this ensures we were reachable
-      // during the function call and know if we were cancelled.
-      this->pop_raw_();
+      WarnIfComponentBlockingGuard guard{item->component, ComponentCallSource::SCHEDULER};
+      if (item->type == SchedulerItem::RETRY)
+        retry_result = item->retry_callback();
+      else
+        item->void_callback();
+    }
+    ran_any = true;
+    if (this->loop_budget_ != 0) {
+      const uint32_t took = std::min<uint32_t>(millis() - item_started, UINT16_MAX);
+      item->cost = item->cost == 0 ? took : (item->cost * 3 + took) / 4;
+    }
 
-      if (item->remove) {
-        // We were removed/cancelled in the function call, stop
-        to_remove_--;
-        continue;
-      }
+    if (item->remove) {
+      // We were removed/cancelled in the function call, stop
+      this->recycle_item_(std::move(item));
+      continue;
+    }
 
-      if (item->type == SchedulerItem::INTERVAL ||
-          (item->type == SchedulerItem::RETRY && (--item->retry_countdown > 0 && retry_result != RetryResult::DONE))) {
-        if (item->interval != 0) {
-          const uint32_t before = item->last_execution;
-          const uint32_t amount = (now - item->last_execution) / item->interval;
-          item->last_execution += amount * item->interval;
-          if (item->last_execution < before)
-            item->last_execution_major++;
-          if (item->type == SchedulerItem::RETRY)
-            item->interval *= item->backoff_multiplier;
-        }
-        this->push_(std::move(item));
+    if (item->type == SchedulerItem::INTERVAL ||
+        (item->type == SchedulerItem::RETRY && (--item->retry_countdown > 0 && retry_result != RetryResult::DONE))) {
+      if (item->deferred && item->type == SchedulerItem::INTERVAL) {
+        // Move the phase instead of catching up, so it doesn't collide with the same items again
+        item->deferred = false;
+        item->next_execution = now + item->interval;
+      } else if (item->interval != 0) {
+        // Skip executions we missed, keeping the phase of the interval
+        const uint64_t missed = (now - item->next_execution) / item->interval;
+        item->next_execution += missed * item->interval;
+        if (item->type == SchedulerItem::RETRY)
+          item->interval *= item->backoff_multiplier;
+        item->next_execution += item->interval;
+      } else {
+        item->next_execution = now;
       }
+      this->push_(std::move(item));
+    } else {
+      this->index_remove_(item.get());
+      this->recycle_item_(std::move(item));
     }
   }
 
@@ -232,82 +279,171 @@ void IRAM_ATTR HOT Scheduler::call() {
 void HOT Scheduler::process_to_add() {
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      this->recycle_item_(std::move(it));
       continue;
     }
 
-    this->items_.push_back(std::move(it));
-    std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+    this->heap_insert_(std::move(it));
   }
   this->to_add_.clear();
 }
-void HOT Scheduler::cleanup_() {
-  while (!this->items_.empty()) {
-    auto &item = this->items_[0];
-    if (!item->remove)
-      return;
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::acquire_item_() {
+  if (this->item_pool_.empty())
+    return make_unique<SchedulerItem>();
+  auto item = std::move(this->item_pool_.back());
+  this->item_pool_.pop_back();
+  return item;
+}
+void HOT Scheduler::recycle_item_(std::unique_ptr<SchedulerItem> item) {
+  // Release whatever the callback captured right away, even if the item itself is kept
+  item->clear_callback();
+  if (this->item_pool_.size() >= MAX_POOL_SIZE)
+    return;
+  item->heap_index = NOT_IN_HEAP;
+  item->retry_countdown = 3;
+  item->backoff_multiplier = 1.0f;
+  item->deferred = false;
+  item->cost = 0;
+  this->item_pool_.push_back(std::move(item));
+}
+void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) { this->to_add_.push_back(std::move(item)); }
+bool HOT Scheduler::cancel_item_(Component *component, uint32_t name_hash, const char *name,
+                                 Scheduler::SchedulerItem::Type type) {
+  if (name_hash == 0)
+    return false;
+  if (this->index_.empty())
+    return false;
+  const uint32_t key = item_key_(component, name_hash, type);
+  for (SchedulerItem **link = &this->index_bucket_(key); *link != nullptr; link = &(*link)->index_next) {
+    SchedulerItem *item = *link;
+    // the hash only narrows it down, different names can collide
+    if (item->key != key || item->component != component || item->type != type || item->name_hash != name_hash ||
+        strcmp(item->name, name) != 0)
+      continue;
 
-    to_remove_--;
-    this->pop_raw_();
+    *link = item->index_next;
+    item->index_next = nullptr;
+    this->index_count_--;
+    if (item->heap_index != NOT_IN_HEAP) {
+      // In the heap, remove it right away
+      this->recycle_item_(this->heap_remove_(item->heap_index));
+    } else {
+      // Either staged in to_add_ or currently running, drop it once it is processed
+      item->remove = true;
+    }
+    // Setting an item always cancels the previous one with the same name, so there is at most one match
+    return true;
   }
+  return false;
 }
-void HOT Scheduler::pop_raw_() {
-  std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
-  this->items_.pop_back();
+void HOT Scheduler::index_add_(SchedulerItem *item) {
+  if (item->name_hash == 0)
+    return;
+  item->key = item_key_(item->component, item->name_hash, item->type);
+  if (this->index_count_ >= this->index_.size() * 2)
+    this->index_grow_();
+  SchedulerItem *&bucket = this->index_bucket_(item->key);
+  item->index_next = bucket;
+  bucket = item;
+  this->index_count_++;
 }
-void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) { this->to_add_.push_back(std::move(item)); }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
-  bool ret = false;
-  for (auto &it : this->items_)
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
-      to_remove_++;
-      it->remove = true;
-      ret = true;
+void HOT Scheduler::index_remove_(SchedulerItem *item) {
+  if (item->name_hash == 0 || this->index_.empty())
+    return;
+  for (SchedulerItem **link = &this->index_bucket_(item->key); *link != nullptr; link = &(*link)->index_next) {
+    if (*link == item) {
+      *link = item->index_next;
+      item->index_next = nullptr;
+      this->index_count_--;
+      return;
     }
-  for (auto &it : this->to_add_)
-    if (it->component == component && it->name == name && it->type == type) {
-      it->remove = true;
-      ret = true;
+  }
+}
+void Scheduler::index_grow_() {
+  std::vector<SchedulerItem *> old(std::max<size_t>(16, this->index_.size() * 2), nullptr);
+  this->index_.swap(old);
+  for (SchedulerItem *item : old) {
+    while (item != nullptr) {
+      SchedulerItem *next = item->index_next;
+      SchedulerItem *&bucket = this->index_bucket_(item->key);
+      item->index_next = bucket;
+      bucket = item;
+      item = next;
     }
-
-  return ret;
+  }
+}
+uint32_t Scheduler::item_key_(Component *component, uint32_t name_hash, SchedulerItem::Type type) {
+  uint32_t hash = name_hash;
+  hash ^= reinterpret_cast<uintptr_t>(component);
+  hash = hash * 16777619UL + static_cast<uint32_t>(type);
+  return hash;
 }
-uint32_t Scheduler::millis_() {
+uint64_t Scheduler::millis_() {
+  // Extend the 32-bit millis() to a monotonic 64-bit clock, so that item times never wrap around
   const uint32_t now = millis();
   if (now < this->last_millis_) {
     ESP_LOGD(TAG, "Incrementing scheduler major");
     this->millis_major_++;
   }
   this->last_millis_ = now;
-  return now;
+  return (static_cast<uint64_t>(this->millis_major_) << 32) | now;
+}
+
+void HOT Scheduler::heap_insert_(std::unique_ptr<SchedulerItem> item) {
+  item->heap_index = this->items_.size();
+  this->items_.push_back(std::move(item));
+  this->heap_sift_up_(this->items_.size() - 1);
+}
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::heap_remove_(size_t index) {
+  const size_t last = this->items_.size() - 1;
+  if (index != last)
+    this->heap_swap_(index, last);
+  auto item = std::move(this->items_.back());
+  this->items_.pop_back();
+  item->heap_index = NOT_IN_HEAP;
+  if (index != last) {
+    // The moved item can need to go either way
+    this->heap_sift_up_(index);
+    this->heap_sift_down_(index);
+  }
+  return item;
+}
+void HOT Scheduler::heap_swap_(size_t a, size_t b) {
+  std::swap(this->items_[a], this->items_[b]);
+  this->items_[a]->heap_index = a;
+  this->items_[b]->heap_index = b;
+}
+void HOT Scheduler::heap_sift_up_(size_t index) {
+  while (index > 0) {
+    const size_t parent = (index - 1) / 2;
+    if (!SchedulerItem::cmp(this->items_[parent], this->items_[index]))
+      break;
+    this->heap_swap_(parent, index);
+    index = parent;
+  }
+}
+void HOT Scheduler::heap_sift_down_(size_t index) {
+  const size_t size = this->items_.size();
+  while (true) {
+    const size_t left = 2 * index + 1;
+    const size_t right = left + 1;
+    size_t smallest = index;
+    if (left < size && SchedulerItem::cmp(this->items_[smallest], this->items_[left]))
+      smallest = left;
+    if (right < size && SchedulerItem::cmp(this->items_[smallest], this->items_[right]))
+      smallest = right;
+    if (smallest == index)
+      break;
+    this->heap_swap_(index, smallest);
+    index = smallest;
+  }
 }
 
 bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
                                        const std::unique_ptr<SchedulerItem> &b) {
   // min-heap
   // return true if *a* will happen after *b*
-  uint32_t a_next_exec = a->next_execution();
-  uint8_t a_next_exec_major = a->next_execution_major();
-  uint32_t b_next_exec = b->next_execution();
-  uint8_t b_next_exec_major = b->next_execution_major();
-
-  if (a_next_exec_major != b_next_exec_major) {
-    // The "major" calculation is quite complicated.
-    // Basically, we need to check if the major value lies in the future or
-    //
-
-    // Here are some cases to think about:
-    // Format: a_major,b_major -> expected result (a-b, b-a)
-    // a=255,b=0 -> false (255, 1)
-    // a=0,b=1 -> false   (255, 1)
-    // a=1,b=0 -> true    (1, 255)
-    // a=0,b=255 -> true  (1, 255)
-
-    uint8_t diff1 = a_next_exec_major - b_next_exec_major;
-    uint8_t diff2 = b_next_exec_major - a_next_exec_major;
-    return diff1 < diff2;
-  }
-
-  return a_next_exec > b_next_exec;
+  return a->next_execution > b->next_execution;
 }
 
 }  // namespace esphome
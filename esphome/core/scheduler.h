@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include <vector>
 #include <memory>
 
@@ -10,14 +11,43 @@ class Component;
 
 class Scheduler {
  public:
+  // Items are looked up by a hash of their name, and the name is compared only when the hashes match. The
+  // const char * overloads are meant for names with static storage (usually string literals) and keep just the
+  // pointer, the std::string overloads keep a copy of the name.
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> &&func);
+  void set_timeout(Component *component, const char *name, uint32_t timeout, std::function<void()> &&func);
   bool cancel_timeout(Component *component, const std::string &name);
+  bool cancel_timeout(Component *component, const char *name);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> &&func);
+  void set_interval(Component *component, const char *name, uint32_t interval, std::function<void()> &&func);
   bool cancel_interval(Component *component, const std::string &name);
+  bool cancel_interval(Component *component, const char *name);
 
   void set_retry(Component *component, const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                  std::function<RetryResult()> &&func, float backoff_increase_factor = 1.0f);
+  void set_retry(Component *component, const char *name, uint32_t initial_wait_time, uint8_t max_attempts,
+                 std::function<RetryResult()> &&func, float backoff_increase_factor = 1.0f);
   bool cancel_retry(Component *component, const std::string &name);
+  bool cancel_retry(Component *component, const char *name);
+
+  /// Hash used to identify a named item, 0 means unnamed.
+  static uint32_t name_hash(const char *name);
+  static uint32_t name_hash(const std::string &name);
+
+  /** Run func from the main loop as soon as possible.
+   *
+   * Unlike the other methods this is safe to call from other FreeRTOS tasks (not from ISRs), it's meant to hand
+   * off work like publishing states from worker tasks back to the main loop.
+   */
+  void defer_from_task(Component *component, std::function<void()> &&func);
+
+  /** Limit how long one call() runs the due items for, 0 (the default) runs all of them.
+   *
+   * Before an item runs, its average run time is checked against what's left of the budget, an item that doesn't fit
+   * any more is left for the next loop iteration (at least one item always runs). An interval that had to wait like
+   * this keeps the new phase, so intervals that keep landing in the same loop iteration drift apart.
+   */
+  void set_loop_budget(uint32_t loop_budget) { this->loop_budget_ = loop_budget; }
 
   optional<uint32_t> next_schedule_in();
 
@@ -26,35 +56,85 @@ class Scheduler {
   void process_to_add();
 
  protected:
+  static const size_t NOT_IN_HEAP = SIZE_MAX;
+
   struct SchedulerItem {
     Component *component;
-    std::string name;
+    /// Identifies the item together with component and type, nullptr if unnamed. Either a name with static storage
+    /// or name_copy.
+    const char *name;
+    /// Storage for names that were passed as std::string, kept (with its capacity) when the item is pooled.
+    std::string name_copy;
+    /// Hash of the name, 0 if unnamed.
+    uint32_t name_hash;
     enum Type { TIMEOUT, INTERVAL, RETRY } type;
     union {
       uint32_t interval;
       uint32_t timeout;
     };
-    uint32_t last_execution;
-    // Ideally this should be a union or std::variant
-    // but unions don't work with object like std::function
-    //  union CallBack_{
-    std::function<void()> void_callback;
-    std::function<RetryResult()> retry_callback;
-    //  };
+    /// Absolute time (on the 64-bit scheduler clock) at which this item should run next.
+    uint64_t next_execution;
+    // Only one of the callbacks is ever used (depending on type), so they share storage.
+    // Which member is alive is tracked by has_callback and callback_is_retry.
+    union {
+      std::function<void()> void_callback;
+      std::function<RetryResult()> retry_callback;
+    };
+    bool has_callback{false};
+    bool callback_is_retry{false};
     uint8_t retry_countdown{3};
     float backoff_multiplier{1.0f};
     bool remove;
-    uint8_t last_execution_major;
-
-    inline uint32_t next_execution() { return this->last_execution + this->timeout; }
-    inline uint8_t next_execution_major() {
-      uint32_t next_exec = this->next_execution();
-      uint8_t next_exec_major = this->last_execution_major;
-      if (next_exec < this->last_execution)
-        next_exec_major++;
-      return next_exec_major;
+    /// Set when the loop budget made this item wait, its interval continues with the new phase.
+    bool deferred{false};
+    /// Moving average of the run time in ms, only measured with a loop budget.
+    uint16_t cost{0};
+    /// Position of this item in the items_ heap, or NOT_IN_HEAP if it is staged or currently running.
+    size_t heap_index{NOT_IN_HEAP};
+    /// Hash of (component, name_hash, type) used as key in the name index. Only valid for named items.
+    uint32_t key;
+    /// Next item in the same bucket of the name index.
+    SchedulerItem *index_next{nullptr};
+
+    SchedulerItem() {}  // NOLINT(modernize-use-equals-default)
+    ~SchedulerItem() { this->clear_callback(); }
+    SchedulerItem(const SchedulerItem &) = delete;
+    SchedulerItem &operator=(const SchedulerItem &) = delete;
+
+    void set_callback(std::function<void()> &&func) {
+      this->clear_callback();
+      new (&this->void_callback) std::function<void()>(std::move(func));
+      this->has_callback = true;
+      this->callback_is_retry = false;
+    }
+    void set_callback(std::function<RetryResult()> &&func) {
+      this->clear_callback();
+      new (&this->retry_callback) std::function<RetryResult()>(std::move(func));
+      this->has_callback = true;
+      this->callback_is_retry = true;
+    }
+    void clear_callback() {
+      if (!this->has_callback)
+        return;
+      using VoidCallback = std::function<void()>;
+      using RetryCallback = std::function<RetryResult()>;
+      if (this->callback_is_retry) {
+        this->retry_callback.~RetryCallback();
+      } else {
+        this->void_callback.~VoidCallback();
+      }
+      this->has_callback = false;
     }
 
+    void set_name(const char *name, bool copy) {
+      if (copy && name != nullptr) {
+        this->name_copy.assign(name);
+        this->name = this->name_copy.c_str();
+      } else {
+        this->name = name;
+      }
+    }
+    const char *get_name_str() const { return this->name == nullptr ? "" : this->name; }
     static bool cmp(const std::unique_ptr<SchedulerItem> &a, const std::unique_ptr<SchedulerItem> &b);
     const char *get_type_str() {
       switch (this->type) {
@@ -70,21 +150,54 @@ class Scheduler {
     }
   };
 
-  uint32_t millis_();
-  void cleanup_();
-  void pop_raw_();
+  static uint32_t item_key_(Component *component, uint32_t name_hash, SchedulerItem::Type type);
+
+  // copy_name is set for names that don't have static storage
+  void set_timeout_(Component *component, const char *name, bool copy_name, uint32_t timeout,
+                    std::function<void()> &&func);
+  void set_interval_(Component *component, const char *name, bool copy_name, uint32_t interval,
+                     std::function<void()> &&func);
+  void set_retry_(Component *component, const char *name, bool copy_name, uint32_t initial_wait_time,
+                  uint8_t max_attempts, std::function<RetryResult()> &&func, float backoff_increase_factor);
+
+  /// Get an item from the pool (or allocate a new one if it is empty).
+  std::unique_ptr<SchedulerItem> acquire_item_();
+  /// Release the callback of an item and return it to the pool if there is room.
+  void recycle_item_(std::unique_ptr<SchedulerItem> item);
+
+  uint64_t millis_();
   void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
-  bool empty_() {
-    this->cleanup_();
-    return this->items_.empty();
-  }
+  bool cancel_item_(Component *component, uint32_t name_hash, const char *name, SchedulerItem::Type type);
+
+  // Indexed binary min-heap keyed on next_execution, supports O(log n) removal of arbitrary items.
+  void heap_insert_(std::unique_ptr<SchedulerItem> item);
+  std::unique_ptr<SchedulerItem> heap_remove_(size_t index);
+  void heap_swap_(size_t a, size_t b);
+  void heap_sift_up_(size_t index);
+  void heap_sift_down_(size_t index);
+
+  void index_add_(SchedulerItem *item);
+  void index_remove_(SchedulerItem *item);
+  /// Double the number of buckets of the name index and move the items to their new buckets.
+  void index_grow_();
+  SchedulerItem *&index_bucket_(uint32_t key) { return this->index_[key & (this->index_.size() - 1)]; }
 
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  std::vector<std::unique_ptr<SchedulerItem>> item_pool_;
+  /// Callbacks queued by defer_from_task(), protected by task_deferred_lock_.
+  std::vector<std::pair<Component *, std::function<void()>>> task_deferred_;
+  Mutex task_deferred_lock_;
+  /** Named items (in the heap, staged in to_add_ or running), used for fast cancellation.
+   *
+   * A hash table with a power of two number of buckets, the items of a bucket are chained through
+   * SchedulerItem::index_next. Adding and removing items doesn't allocate, only growing the table does.
+   */
+  std::vector<SchedulerItem *> index_;
+  size_t index_count_{0};
   uint32_t last_millis_{0};
-  uint8_t millis_major_{0};
-  uint32_t to_remove_{0};
+  uint32_t millis_major_{0};
+  uint32_t loop_budget_{0};
 };
 
 }  // namespace esphome
@@ -16,6 +16,7 @@ from esphome.core import coroutine, ID, CORE
 from esphome.types import ConfigType
 from esphome.cpp_generator import add, get_variable
 from esphome.cpp_types import App
+from esphome.helpers import entity_object_id, fnv1_hash
 from esphome.util import Registry, RegistryEntry
 
 
@@ -97,7 +98,9 @@ async def register_parented(var, value):
 
 async def setup_entity(var, config):
     """Set up generic properties of an Entity"""
-    add(var.set_name(config[CONF_NAME]))
+    # Calculate the object id here so the device doesn't have to on every boot
+    object_id = entity_object_id(config[CONF_NAME])
+    add(var.set_name(config[CONF_NAME], object_id, fnv1_hash(object_id)))
     add(var.set_disabled_by_default(config[CONF_DISABLED_BY_DEFAULT]))
     if CONF_INTERNAL in config:
         add(var.set_internal(config[CONF_INTERNAL]))
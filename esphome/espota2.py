@@ -6,6 +6,7 @@ import sys
 import time
 import gzip
 
+from esphome import ota_delta
 from esphome.core import EsphomeError
 from esphome.helpers import is_ip_address, resolve_ip_address
 
@@ -19,6 +20,9 @@ RESPONSE_BIN_MD5_OK = 67
 RESPONSE_RECEIVE_OK = 68
 RESPONSE_UPDATE_END_OK = 69
 RESPONSE_SUPPORTS_COMPRESSION = 70
+RESPONSE_SUPPORTS_RESUME = 71
+RESPONSE_SUPPORTS_COMPRESSION_AND_RESUME = 72
+RESPONSE_SUPPORTED_FEATURES = 73
 
 RESPONSE_ERROR_MAGIC = 128
 RESPONSE_ERROR_UPDATE_PREPARE = 129
@@ -30,6 +34,8 @@ RESPONSE_ERROR_WRONG_CURRENT_FLASH_CONFIG = 134
 RESPONSE_ERROR_WRONG_NEW_FLASH_CONFIG = 135
 RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136
 RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137
+RESPONSE_ERROR_NO_UPDATE_PARTITION = 138
+RESPONSE_ERROR_DELTA = 139
 RESPONSE_ERROR_UNKNOWN = 255
 
 OTA_VERSION_1_0 = 1
@@ -37,6 +43,8 @@ OTA_VERSION_1_0 = 1
 MAGIC_BYTES = [0x6C, 0x26, 0xF7, 0x5C, 0x45]
 
 FEATURE_SUPPORTS_COMPRESSION = 0x01
+FEATURE_SUPPORTS_RESUME = 0x02
+FEATURE_SUPPORTS_DELTA = 0x04
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -151,6 +159,16 @@ def check_error(data, expect):
             "Error: The OTA partition on the ESP is too small. ESPHome needs to resize "
             "this partition, please flash over USB."
         )
+    if dat == RESPONSE_ERROR_NO_UPDATE_PARTITION:
+        raise OTAError(
+            "Error: The ESP has no OTA partition to write the update to, please "
+            "flash over USB."
+        )
+    if dat == RESPONSE_ERROR_DELTA:
+        raise OTAError(
+            "Error: The ESP could not apply the delta update. Try again, a full image "
+            "is uploaded if the running firmware is unknown."
+        )
     if dat == RESPONSE_ERROR_UNKNOWN:
         raise OTAError("Unknown error from ESP")
     if not isinstance(expect, (list, tuple)):
@@ -187,12 +205,36 @@ def perform_ota(sock, password, file_handle, filename):
         raise OTAError(f"Unsupported OTA version {version}")
 
     # Features
-    send_check(sock, FEATURE_SUPPORTS_COMPRESSION, "features")
+    features = (
+        FEATURE_SUPPORTS_COMPRESSION | FEATURE_SUPPORTS_RESUME | FEATURE_SUPPORTS_DELTA
+    )
+    send_check(sock, features, "features")
     features = receive_exactly(
-        sock, 1, "features", [RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_COMPRESSION]
+        sock,
+        1,
+        "features",
+        [
+            RESPONSE_HEADER_OK,
+            RESPONSE_SUPPORTS_COMPRESSION,
+            RESPONSE_SUPPORTS_RESUME,
+            RESPONSE_SUPPORTS_COMPRESSION_AND_RESUME,
+            RESPONSE_SUPPORTED_FEATURES,
+        ],
     )[0]
-
-    if features == RESPONSE_SUPPORTS_COMPRESSION:
+    if features == RESPONSE_SUPPORTED_FEATURES:
+        # Newer devices send the features both sides support as a bit field
+        supported = receive_exactly(sock, 1, "supported features", [])[0]
+    else:
+        supported = {
+            RESPONSE_HEADER_OK: 0,
+            RESPONSE_SUPPORTS_COMPRESSION: FEATURE_SUPPORTS_COMPRESSION,
+            RESPONSE_SUPPORTS_RESUME: FEATURE_SUPPORTS_RESUME,
+            RESPONSE_SUPPORTS_COMPRESSION_AND_RESUME: FEATURE_SUPPORTS_COMPRESSION
+            | FEATURE_SUPPORTS_RESUME,
+        }[features]
+    resume = (supported & FEATURE_SUPPORTS_RESUME) != 0
+
+    if supported & FEATURE_SUPPORTS_COMPRESSION:
         upload_contents = gzip.compress(file_contents, compresslevel=9)
         _LOGGER.info("Compressed to %s bytes", len(upload_contents))
     else:
@@ -223,6 +265,17 @@ def perform_ota(sock, password, file_handle, filename):
         send_check(sock, result, "auth result")
         receive_exactly(sock, 1, "auth result", RESPONSE_AUTH_OK)
 
+    if supported & FEATURE_SUPPORTS_DELTA:
+        # The ESP sends the SHA-256 of its running firmware, a delta against it is
+        # only possible if that firmware was uploaded from here before
+        digest = receive_exactly(
+            sock, 32, "running firmware digest", [], decode=False
+        )
+        delta = ota_delta.create_upload(filename, file_contents, digest)
+        send_check(sock, 0 if delta is None else 1, "delta mode")
+        if delta is not None:
+            upload_contents = delta
+
     upload_size = len(upload_contents)
     upload_size_encoded = [
         (upload_size >> 24) & 0xFF,
@@ -239,6 +292,17 @@ def perform_ota(sock, password, file_handle, filename):
     send_check(sock, upload_md5, "file checksum")
     receive_exactly(sock, 1, "file checksum", RESPONSE_BIN_MD5_OK)
 
+    offset = 0
+    if resume:
+        # The ESP continues an interrupted upload of the same binary
+        offset = int.from_bytes(
+            receive_exactly(sock, 4, "resume offset", [], decode=False), "big"
+        )
+        if offset > upload_size:
+            raise OTAError(f"Invalid resume offset {offset}")
+        if offset:
+            _LOGGER.info("Resuming upload at %s bytes", offset)
+
     # Disable nodelay for transfer
     sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 0)
     # Limit send buffer (usually around 100kB) in order to have progress bar
@@ -247,7 +311,6 @@ def perform_ota(sock, password, file_handle, filename):
     # Set higher timeout during upload
     sock.settimeout(20.0)
 
-    offset = 0
     progress = ProgressBar()
     while True:
         chunk = upload_contents[offset : offset + 1024]
@@ -274,6 +337,7 @@ def perform_ota(sock, password, file_handle, filename):
     send_check(sock, RESPONSE_OK, "end acknowledgement")
 
     _LOGGER.info("OTA successful")
+    ota_delta.store_base(filename, file_contents)
 
     # Do not connect logs until it is fully on
     time.sleep(1)
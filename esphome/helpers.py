@@ -57,6 +57,26 @@ def cpp_string_escape(string, encoding="utf-8"):
     return f'"{result}"'
 
 
+def fnv1_hash(string):
+    """The 32-bit FNV-1 hash of a string, the same as fnv1_hash() in core/helpers.cpp."""
+    hash_ = 2166136261
+    for byte in string.encode("utf-8"):
+        hash_ = ((hash_ * 16777619) & 0xFFFFFFFF) ^ byte
+    return hash_
+
+
+def entity_object_id(name):
+    """The object id EntityBase derives from an entity name (snake case, sanitized)."""
+    result = ""
+    for byte in name.encode("utf-8"):
+        char = chr(byte).lower() if byte < 128 else ""
+        if char == " ":
+            char = "_"
+        if char == "-" or char == "_" or char.isalnum() and char.isascii():
+            result += char
+    return result
+
+
 def run_system_command(*args):
     import subprocess
 
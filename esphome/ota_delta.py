@@ -0,0 +1,121 @@
+"""Delta OTA updates: patches that rebuild the new firmware from the running one.
+
+The patch format is what ota/ota_delta.cpp decodes, all integers are little endian:
+
+- ``b"EOD1"``, u32 size of the new image
+- then operations until the new image is complete:
+
+  - ``0x01``, u32 source offset, u32 length: copy from the running firmware
+  - ``0x02``, u32 length, data: insert new data
+"""
+import hashlib
+import logging
+import os
+import struct
+
+_LOGGER = logging.getLogger(__name__)
+
+DELTA_MAGIC = b"EOD1"
+OP_COPY = 0x01
+OP_INSERT = 0x02
+
+# Matches shorter than this cost more in operations than they save
+BLOCK_SIZE = 32
+# Only this many firmware images that were uploaded are kept as delta bases
+MAX_BASES = 3
+# A delta that saves less than this is not worth the slower apply on the ESP
+MIN_SAVING = 0.25
+
+
+def image_digest(image):
+    """The SHA-256 the ESP reports for a firmware image.
+
+    ESP32 images usually have a SHA-256 digest appended (flag at byte 23), which is
+    what the ESP reports for the running partition.
+    """
+    if len(image) > 56 and image[0] == 0xE9 and image[23] == 1:
+        return bytes(image[-32:])
+    return hashlib.sha256(image).digest()
+
+
+def make_delta(base, target):
+    """Create a patch that turns base into target."""
+    index = {}
+    for offset in range(0, len(base) - BLOCK_SIZE + 1, BLOCK_SIZE):
+        index.setdefault(base[offset : offset + BLOCK_SIZE], offset)
+
+    out = bytearray(DELTA_MAGIC + struct.pack("<I", len(target)))
+    literal_start = 0
+
+    def flush_literal(end):
+        if end > literal_start:
+            out.extend(struct.pack("<BI", OP_INSERT, end - literal_start))
+            out.extend(target[literal_start:end])
+
+    pos = 0
+    while pos + BLOCK_SIZE <= len(target):
+        source = index.get(target[pos : pos + BLOCK_SIZE])
+        if source is None:
+            pos += 1
+            continue
+        length = BLOCK_SIZE
+        while (
+            pos + length < len(target)
+            and source + length < len(base)
+            and target[pos + length] == base[source + length]
+        ):
+            length += 1
+        flush_literal(pos)
+        out.extend(struct.pack("<BII", OP_COPY, source, length))
+        pos += length
+        literal_start = pos
+    flush_literal(len(target))
+    return bytes(out)
+
+
+def _base_dir(filename):
+    return os.path.join(os.path.dirname(os.path.abspath(filename)), "ota_bases")
+
+
+def find_base(filename, digest):
+    """Find a previously uploaded firmware image with the given digest."""
+    path = os.path.join(_base_dir(filename), f"{digest.hex()}.bin")
+    if not os.path.isfile(path):
+        return None
+    with open(path, "rb") as file_handle:
+        base = file_handle.read()
+    if image_digest(base) != digest:
+        return None
+    return base
+
+
+def store_base(filename, image):
+    """Keep an uploaded firmware image, so the next upload can be a delta against it."""
+    path = _base_dir(filename)
+    try:
+        os.makedirs(path, exist_ok=True)
+        with open(os.path.join(path, f"{image_digest(image).hex()}.bin"), "wb") as f:
+            f.write(image)
+        bases = sorted(
+            (os.path.join(path, name) for name in os.listdir(path)),
+            key=os.path.getmtime,
+            reverse=True,
+        )
+        for old in bases[MAX_BASES:]:
+            os.remove(old)
+    except OSError as err:
+        _LOGGER.debug("Could not store delta OTA base: %s", err)
+
+
+def create_upload(filename, image, digest):
+    """Return a patch for image against the running firmware, None for a full upload."""
+    base = find_base(filename, digest)
+    if base is None:
+        _LOGGER.info("Running firmware is unknown, uploading the full image")
+        return None
+    delta = make_delta(base, image)
+    if len(delta) > len(image) * (1 - MIN_SAVING):
+        _LOGGER.info("Delta is %s bytes, uploading the full image", len(delta))
+        return None
+    _LOGGER.info("Uploading delta of %s bytes", len(delta))
+    return delta
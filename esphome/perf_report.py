@@ -0,0 +1,232 @@
+"""Firmware performance metrics of a reference configuration, compared with a baseline.
+
+The static metrics (flash and RAM) come from the linker map of the build, the
+runtime metrics from a device running the firmware: the time from its reset
+until the native API accepts a connection, and the states of the debug sensors
+of the reference configuration (main loop duration percentiles and free heap)
+while it runs.
+
+Runtime metrics are read from the sensors whose object id is the metric name
+prefixed with ``perf_``, for example a sensor named ``perf_loop_p95``.
+"""
+import asyncio
+import json
+import logging
+import math
+import os
+import statistics
+import time
+from typing import NamedTuple
+
+from esphome import size_report
+
+_LOGGER = logging.getLogger(__name__)
+
+SENSOR_PREFIX = "perf_"
+
+
+class Metric(NamedTuple):
+    unit: str
+    # a change in this direction is a regression
+    lower_is_better: bool
+    # relative change that's still accepted, unless the baseline overrides it
+    tolerance: float
+    # how the samples of a runtime metric are reduced to one value
+    reduce: object = statistics.median
+
+
+METRICS = {
+    "flash": Metric("B", True, 0.01),
+    "ram": Metric("B", True, 0.01),
+    "time_to_api": Metric("s", True, 0.25),
+    "loop_p50": Metric("ms", True, 0.25),
+    "loop_p95": Metric("ms", True, 0.25),
+    "loop_p99": Metric("ms", True, 0.5),
+    "heap_free": Metric("B", False, 0.05),
+    # already the lowest value since boot
+    "heap_min_free": Metric("B", False, 0.05, min),
+}
+
+
+class Comparison(NamedTuple):
+    name: str
+    value: float
+    baseline: float
+    tolerance: float
+    regressed: bool
+
+    @property
+    def change(self):
+        if not self.baseline:
+            return 0.0
+        return (self.value - self.baseline) / self.baseline
+
+
+def size_metrics(sizes):
+    """Flash and RAM use of all owners of a parsed linker map."""
+    total = {c: sum(s[c] for s in sizes.values()) for c in size_report.CATEGORIES}
+    return {
+        "flash": total["text"] + total["rodata"] + total["data"],
+        "ram": total["data"] + total["bss"],
+    }
+
+
+def runtime_metrics(samples):
+    """Reduce the states received per sensor object id to the runtime metrics."""
+    metrics = {}
+    for name, metric in METRICS.items():
+        values = [
+            v for v in samples.get(SENSOR_PREFIX + name, []) if not math.isnan(v)
+        ]
+        if values:
+            metrics[name] = metric.reduce(values)
+    return metrics
+
+
+def compare(metrics, baseline, tolerances=None):
+    """Compare the metrics with the baseline, skipping the ones it doesn't have."""
+    tolerances = tolerances or {}
+    results = []
+    for name, metric in METRICS.items():
+        if name not in metrics or name not in baseline:
+            continue
+        value = metrics[name]
+        base = baseline[name]
+        tolerance = tolerances.get(name, metric.tolerance)
+        if metric.lower_is_better:
+            regressed = value > base * (1 + tolerance)
+        else:
+            regressed = value < base * (1 - tolerance)
+        results.append(Comparison(name, value, base, tolerance, regressed))
+    return results
+
+
+def _format_value(name, value):
+    if METRICS[name].unit == "B":
+        return f"{value:.0f} B"
+    return f"{value:.3f} {METRICS[name].unit}"
+
+
+def format_metrics(metrics):
+    lines = []
+    for name in METRICS:
+        if name in metrics:
+            lines.append(f"{name:<16}{_format_value(name, metrics[name]):>16}")
+    return "\n".join(lines)
+
+
+def format_comparison(results):
+    lines = [f"{'Metric':<16}{'Value':>16}{'Baseline':>16}{'Change':>10}"]
+    for result in results:
+        line = (
+            f"{result.name:<16}{_format_value(result.name, result.value):>16}"
+            f"{_format_value(result.name, result.baseline):>16}"
+            f"{result.change:>+10.1%}"
+        )
+        if result.regressed:
+            line += f"  REGRESSION (tolerance {result.tolerance:.0%})"
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def load_baseline(path):
+    """The baseline metrics and tolerance overrides stored at path."""
+    if not os.path.isfile(path):
+        return {}, {}
+    with open(path, encoding="utf-8") as file_handle:
+        data = json.load(file_handle)
+    return data.get("metrics", {}), data.get("tolerances", {})
+
+
+def write_baseline(path, metrics):
+    """Store the metrics as the new baseline, keeping the tolerance overrides."""
+    _, tolerances = load_baseline(path)
+    data = {"metrics": metrics}
+    if tolerances:
+        data["tolerances"] = tolerances
+    with open(path, "w", encoding="utf-8") as file_handle:
+        json.dump(data, file_handle, indent=2, sort_keys=True)
+        file_handle.write("\n")
+
+
+def reset_device(port):
+    """Reset the chip through the DTR/RTS lines of its USB-serial adapter."""
+    import serial
+
+    with serial.Serial(port) as ser:
+        # same sequence as esptool's hard reset: EN low, then back high without
+        # holding the boot pin
+        ser.dtr = False
+        ser.rts = True
+        time.sleep(0.1)
+        ser.rts = False
+
+
+async def async_measure(config, address, duration, started=None, timeout=60):
+    """Collect the runtime metrics of the device at address for duration seconds.
+
+    If started is a time.monotonic() timestamp of the device's reset, the time
+    until the API accepts a connection is measured too.
+    """
+    from aioesphomeapi import APIClient, APIConnectionError, SensorInfo
+
+    from esphome.components.api import CONF_ENCRYPTION
+    from esphome.const import CONF_KEY, CONF_PASSWORD, CONF_PORT, __version__
+
+    conf = config["api"]
+    noise_psk = None
+    if CONF_ENCRYPTION in conf:
+        noise_psk = conf[CONF_ENCRYPTION][CONF_KEY]
+    cli = APIClient(
+        address,
+        int(conf[CONF_PORT]),
+        conf[CONF_PASSWORD],
+        client_info=f"ESPHome Perf {__version__}",
+        noise_psk=noise_psk,
+    )
+
+    deadline = time.monotonic() + timeout
+    while True:
+        try:
+            await cli.connect(login=True)
+            break
+        except APIConnectionError as err:
+            if time.monotonic() > deadline:
+                raise
+            _LOGGER.debug("Device not reachable yet: %s", err)
+            await asyncio.sleep(0.25)
+    metrics = {}
+    if started is not None:
+        metrics["time_to_api"] = time.monotonic() - started
+
+    try:
+        entities, _ = await cli.list_entities_services()
+        object_ids = {
+            e.key: e.object_id for e in entities if isinstance(e, SensorInfo)
+        }
+        samples = {}
+
+        def on_state(state):
+            object_id = object_ids.get(state.key)
+            if object_id is None or getattr(state, "missing_state", False):
+                return
+            samples.setdefault(object_id, []).append(state.state)
+
+        await cli.subscribe_states(on_state)
+        _LOGGER.info("Collecting metrics for %s seconds...", duration)
+        await asyncio.sleep(duration)
+    finally:
+        await cli.disconnect()
+
+    runtime = runtime_metrics(samples)
+    missing = [
+        n for n in METRICS if n.startswith(("loop_", "heap_")) and n not in runtime
+    ]
+    if missing:
+        _LOGGER.warning("No values for %s", ", ".join(missing))
+    metrics.update(runtime)
+    return metrics
+
+
+def measure(config, address, duration, started=None):
+    return asyncio.run(async_measure(config, address, duration, started))
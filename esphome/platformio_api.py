@@ -8,7 +8,7 @@ import os
 import re
 import subprocess
 
-from esphome.const import KEY_CORE
+from esphome.const import ENV_BUILD_CACHE_DIR, KEY_CORE
 from esphome.core import CORE, EsphomeError
 from esphome.util import run_external_command, run_external_process
 
@@ -80,6 +80,11 @@ def run_platformio_cli(*args, **kwargs) -> Union[str, int]:
     os.environ.setdefault(
         "PLATFORMIO_LIBDEPS_DIR", os.path.abspath(CORE.relative_piolibdeps_path())
     )
+    # Objects are cached by the signature of their sources, headers and command line, so
+    # builds of different configs can share every object that compiles the same
+    build_cache_dir = os.environ.get(ENV_BUILD_CACHE_DIR)
+    if build_cache_dir:
+        os.environ["PLATFORMIO_BUILD_CACHE_DIR"] = os.path.abspath(build_cache_dir)
     cmd = ["platformio"] + list(args)
 
     if not CORE.verbose:
@@ -0,0 +1,134 @@
+"""Firmware size per component, from the linker map of a build.
+
+Every input section in the map file is attributed to the component whose source
+file it was compiled from (``esphome/components/<name>/``), to ``core`` for
+``esphome/core/`` and ``main`` for the generated main.cpp. Everything else
+(framework, libraries, toolchain runtime) is summed up as ``other``.
+"""
+import json
+import logging
+import os
+import re
+
+_LOGGER = logging.getLogger(__name__)
+
+CATEGORIES = ("text", "rodata", "data", "bss")
+
+_COMPONENT_RE = re.compile(r"src[/\\]esphome[/\\]components[/\\]([^/\\]+)[/\\]")
+_CORE_RE = re.compile(r"src[/\\]esphome[/\\]core[/\\]")
+_MAIN_RE = re.compile(r"src[/\\]main\.cpp\.o$")
+# An input section, either on one line or with the name alone on the previous line
+_SECTION_RE = re.compile(r"^ (\S+)?\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*)$")
+_SECTION_NAME_RE = re.compile(r"^ (\S+)$")
+_OUTPUT_SECTION_RE = re.compile(r"^(\.\S+)")
+
+
+def section_category(output_section):
+    """The category of an output section name (chip specific), None if not stored."""
+    name = output_section.lower()
+    if "bss" in name or "noinit" in name:
+        return "bss"
+    if "rodata" in name:
+        return "rodata"
+    if "data" in name:
+        return "data"
+    if "text" in name or "literal" in name or "vectors" in name:
+        return "text"
+    return None
+
+
+def source_owner(path):
+    """The component (or core/main/other) an object file belongs to."""
+    match = _COMPONENT_RE.search(path)
+    if match:
+        return match.group(1)
+    if _CORE_RE.search(path):
+        return "core"
+    if _MAIN_RE.search(path):
+        return "main"
+    return "other"
+
+
+def parse_map(text):
+    """Sum up the sizes in a GNU ld map file as {owner: {category: bytes}}."""
+    result = {}
+    in_memory_map = False
+    category = None
+    pending_name = None
+    for line in text.splitlines():
+        if not in_memory_map:
+            in_memory_map = line.startswith("Linker script and memory map")
+            continue
+        output = _OUTPUT_SECTION_RE.match(line)
+        if output:
+            category = section_category(output.group(1))
+            pending_name = None
+            continue
+        if category is None:
+            continue
+        match = _SECTION_RE.match(line)
+        if match is None:
+            name = _SECTION_NAME_RE.match(line)
+            pending_name = name.group(1) if name else None
+            continue
+        size = int(match.group(3), 16)
+        if match.group(1) is None and pending_name is None:
+            continue
+        pending_name = None
+        if size == 0 or match.group(1) == "*fill*":
+            continue
+        owner = source_owner(match.group(4).strip())
+        sizes = result.setdefault(owner, dict.fromkeys(CATEGORIES, 0))
+        sizes[category] += size
+    return result
+
+
+def _format_row(name, sizes, previous):
+    cells = [f"{name:<24}"]
+    for category in CATEGORIES:
+        cell = f"{sizes.get(category, 0):>8}"
+        if previous is not None:
+            delta = sizes.get(category, 0) - previous.get(category, 0)
+            cell += f" {delta:>+7}" if delta else " " * 8
+        cells.append(cell)
+    return " ".join(cells).rstrip()
+
+
+def format_report(sizes, previous=None):
+    """A table of all owners (largest first) with the difference to a previous build."""
+    header = [f"{'Component':<24}"]
+    for category in CATEGORIES:
+        header.append(f"{category:>8}" + (" " * 8 if previous is not None else ""))
+    lines = [" ".join(header).rstrip()]
+    owners = set(sizes) | set(previous or {})
+    empty = dict.fromkeys(CATEGORIES, 0)
+    for owner in sorted(owners, key=lambda o: -sum(sizes.get(o, empty).values())):
+        old = None if previous is None else previous.get(owner, empty)
+        lines.append(_format_row(owner, sizes.get(owner, empty), old))
+    total = {c: sum(s[c] for s in sizes.values()) for c in CATEGORIES}
+    old_total = None
+    if previous is not None:
+        old_total = {c: sum(s[c] for s in previous.values()) for c in CATEGORIES}
+    lines.append(_format_row("total", total, old_total))
+    return "\n".join(lines)
+
+
+def create_report(map_path, report_path):
+    """Parse the map file of a build, compare it with the last report and store it."""
+    if not os.path.isfile(map_path):
+        _LOGGER.warning("No linker map at %s, can't create a size report", map_path)
+        return None
+    with open(map_path, encoding="utf-8", errors="replace") as file_handle:
+        sizes = parse_map(file_handle.read())
+
+    previous = None
+    if os.path.isfile(report_path):
+        try:
+            with open(report_path, encoding="utf-8") as file_handle:
+                previous = json.load(file_handle)
+        except (OSError, ValueError) as err:
+            _LOGGER.debug("Could not read previous size report: %s", err)
+    with open(report_path, "w", encoding="utf-8") as file_handle:
+        json.dump(sizes, file_handle, indent=2, sort_keys=True)
+        file_handle.write("\n")
+    return format_report(sizes, previous)
@@ -0,0 +1,128 @@
+// Host benchmark and fuzz target for the native API protobuf codec.
+//
+// Build and run with script/api_benchmark, the list of messages (api_messages.inc) is generated from api_pb2.h.
+
+#include "esphome/components/api/api_pb2.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+using namespace esphome::api;
+
+static size_t allocation_count = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void *operator new(size_t size) {
+  allocation_count++;
+  void *ptr = malloc(size);  // NOLINT(cppcoreguidelines-no-malloc)
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+void operator delete(void *ptr) noexcept { free(ptr); }          // NOLINT(cppcoreguidelines-no-malloc)
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }  // NOLINT(cppcoreguidelines-no-malloc)
+
+/// Wire data with every field id up to 20 in every wire type, decoding it fills all fields of any message.
+static std::vector<uint8_t> make_sample_fields() {
+  std::vector<uint8_t> out;
+  const char *string = "benchmark";
+  const float number = 21.5f;
+  uint8_t fixed[4];
+  memcpy(fixed, &number, sizeof(fixed));
+  for (uint32_t field_id = 1; field_id <= 20; field_id++) {
+    ProtoVarInt((field_id << 3) | 0).encode(out);
+    ProtoVarInt(123456).encode(out);
+    ProtoVarInt((field_id << 3) | 2).encode(out);
+    ProtoVarInt(strlen(string)).encode(out);
+    out.insert(out.end(), string, string + strlen(string));
+    ProtoVarInt((field_id << 3) | 5).encode(out);
+    out.insert(out.end(), fixed, fixed + sizeof(fixed));
+  }
+  return out;
+}
+
+static uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+template<typename T> void benchmark_message(const char *name, const std::vector<uint8_t> &sample, size_t iterations) {
+  T msg;
+  msg.decode(sample.data(), sample.size());
+  std::vector<uint8_t> encoded;
+  ProtoWriteBuffer encoded_buffer{&encoded};
+  msg.encode(encoded_buffer);
+
+  std::vector<uint8_t> out;
+  out.reserve(encoded.size());
+  size_t allocations_before = allocation_count;
+  uint64_t start = now_ns();
+  for (size_t i = 0; i < iterations; i++) {
+    out.clear();
+    ProtoWriteBuffer buffer{&out};
+    msg.encode(buffer);
+  }
+  double encode_ns = double(now_ns() - start) / iterations;
+  double encode_allocations = double(allocation_count - allocations_before) / iterations;
+
+  allocations_before = allocation_count;
+  start = now_ns();
+  for (size_t i = 0; i < iterations; i++) {
+    T decoded;
+    decoded.decode(encoded.data(), encoded.size());
+  }
+  double decode_ns = double(now_ns() - start) / iterations;
+  double decode_allocations = double(allocation_count - allocations_before) / iterations;
+
+  printf("%-42s %6zu %10.1f %8.2f %10.1f %8.2f\n", name, encoded.size(), encode_ns, encode_allocations, decode_ns,
+         decode_allocations);
+}
+
+template<typename T> void fuzz_message(const uint8_t *data, size_t size) {
+  T msg;
+  msg.decode(data, size);
+  // whatever was decoded must encode and decode again
+  std::vector<uint8_t> encoded;
+  ProtoWriteBuffer buffer{&encoded};
+  msg.encode(buffer);
+  T again;
+  again.decode(encoded.data(), encoded.size());
+}
+
+struct MessageCodec {
+  const char *name;
+  void (*benchmark)(const char *name, const std::vector<uint8_t> &sample, size_t iterations);
+  void (*fuzz)(const uint8_t *data, size_t size);
+};
+
+#define API_MESSAGE(type) {#type, benchmark_message<type>, fuzz_message<type>},
+static const MessageCodec MESSAGES[] = {
+#include "api_messages.inc"
+};
+#undef API_MESSAGE
+static const size_t MESSAGE_COUNT = sizeof(MESSAGES) / sizeof(MESSAGES[0]);
+
+#ifdef API_PROTO_FUZZ
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  // the first byte selects the message type
+  if (size == 0)
+    return 0;
+  MESSAGES[data[0] % MESSAGE_COUNT].fuzz(data + 1, size - 1);
+  return 0;
+}
+#else
+int main(int argc, char **argv) {
+  size_t iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+  if (iterations == 0)
+    iterations = 1;
+  std::vector<uint8_t> sample = make_sample_fields();
+
+  printf("%-42s %6s %10s %8s %10s %8s\n", "message", "bytes", "enc ns", "enc new", "dec ns", "dec new");
+  for (const auto &message : MESSAGES)
+    message.benchmark(message.name, sample, iterations);
+  return 0;
+}
+#endif
@@ -0,0 +1,331 @@
+// Host benchmark for core hot paths: the scheduler, sensor filter chains, protobuf encoding, build_json, the logger,
+// addressable light effects and display buffer primitives.
+//
+// Build and run with script/core_benchmark. Every benchmark prints one JSON object per line, for example
+//   {"benchmark": "scheduler.set_cancel_timeout", "iterations": 100000, "ns_per_op": 85.2, "allocs_per_op": 0.00}
+
+#include "hal.h"
+
+#include "esphome/core/log.h"
+#include "esphome/core/scheduler.h"
+#include "esphome/components/api/api_pb2.h"
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/components/light/addressable_light_effect.h"
+#include "esphome/components/logger/logger.h"
+#include "esphome/components/sensor/filter.h"
+#include "esphome/components/sensor/sensor.h"
+#ifdef USE_JSON
+#include "esphome/components/json/json_util.h"
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+using namespace esphome;
+
+static size_t allocation_count = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void *operator new(size_t size) {
+  allocation_count++;
+  void *ptr = malloc(size);  // NOLINT(cppcoreguidelines-no-malloc)
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+void operator delete(void *ptr) noexcept { free(ptr); }          // NOLINT(cppcoreguidelines-no-malloc)
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }  // NOLINT(cppcoreguidelines-no-malloc)
+
+static uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static size_t iterations = 100000;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// Run body iterations times (after one warm-up run) and print the time and operator new calls per run.
+template<typename F> void run_benchmark(const char *name, F &&body) {
+  body();
+  size_t allocations_before = allocation_count;
+  uint64_t start = now_ns();
+  for (size_t i = 0; i < iterations; i++)
+    body();
+  double ns = double(now_ns() - start) / iterations;
+  double allocations = double(allocation_count - allocations_before) / iterations;
+  printf("{\"benchmark\": \"%s\", \"iterations\": %zu, \"ns_per_op\": %.1f, \"allocs_per_op\": %.2f}\n", name,
+         iterations, ns, allocations);
+}
+
+static void skip_benchmark(const char *name, const char *reason) {
+  printf("{\"benchmark\": \"%s\", \"skipped\": \"%s\"}\n", name, reason);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+class DummyComponent : public Component {};
+
+static void benchmark_scheduler() {
+  DummyComponent component;
+  Scheduler scheduler;
+  uint32_t runs = 0;
+
+  run_benchmark("scheduler.set_cancel_timeout", [&]() {
+    scheduler.set_timeout(&component, "timeout", 1000, [&runs]() { runs++; });
+    scheduler.cancel_timeout(&component, "timeout");
+    scheduler.process_to_add();
+  });
+  run_benchmark("scheduler.replace_timeout_string", [&]() {
+    static const std::string NAME = "replaced";
+    scheduler.set_timeout(&component, NAME, 1000, [&runs]() { runs++; });
+    scheduler.process_to_add();
+  });
+  scheduler.cancel_timeout(&component, std::string("replaced"));
+
+  // a realistic number of pending items, one timeout runs every call
+  char names[64][16];
+  for (int i = 0; i < 64; i++) {
+    snprintf(names[i], sizeof(names[i]), "interval%d", i);
+    scheduler.set_interval(&component, names[i], 1000 + i * 37, [&runs]() { runs++; });
+  }
+  run_benchmark("scheduler.call_timeout_64_intervals", [&]() {
+    scheduler.set_timeout(&component, "once", 1, [&runs]() { runs++; });
+    host_advance_millis(1);
+    scheduler.call();
+  });
+  for (auto &name : names)
+    scheduler.cancel_interval(&component, name);
+  scheduler.call();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void benchmark_filters() {
+  sensor::Sensor plain;
+  float value = 0.0f;
+  run_benchmark("sensor.publish_no_filters", [&]() { plain.publish_state(value += 0.25f); });
+
+  sensor::Sensor filtered;
+  filtered.add_filters({
+      new sensor::OffsetFilter(1.5f),
+      new sensor::MultiplyFilter(0.9f),
+      new sensor::SlidingWindowMovingAverageFilter(15, 1, 1),
+      new sensor::MedianFilter(5, 1, 1),
+      new sensor::DeltaFilter(0.0f),
+  });
+  run_benchmark("sensor.publish_filter_chain", [&]() { filtered.publish_state(value += 0.25f); });
+
+  sensor::Sensor quantile;
+  quantile.add_filter(new sensor::QuantileFilter(64, 1, 1, 0.9f));
+  run_benchmark("sensor.publish_quantile_64", [&]() { quantile.publish_state(value += 0.25f); });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void benchmark_proto() {
+  std::vector<uint8_t> out;
+  out.reserve(512);
+
+  api::SensorStateResponse state;
+  state.key = 0x12345678;
+  state.state = 21.5f;
+  run_benchmark("proto.encode_sensor_state", [&]() {
+    out.clear();
+    api::ProtoWriteBuffer buffer{&out};
+    state.encode(buffer);
+  });
+
+  api::ListEntitiesSensorResponse entity;
+  entity.object_id = "living_room_temperature";
+  entity.key = 0x12345678;
+  entity.name = "Living Room Temperature";
+  entity.unique_id = "livingroomtemperaturesensor";
+  entity.unit_of_measurement = "°C";
+  entity.device_class = "temperature";
+  run_benchmark("proto.encode_list_entities_sensor", [&]() {
+    out.clear();
+    api::ProtoWriteBuffer buffer{&out};
+    entity.encode(buffer);
+  });
+
+  run_benchmark("proto.encode_varints", [&]() {
+    out.clear();
+    api::ProtoWriteBuffer buffer{&out};
+    for (uint32_t i = 1; i < 32; i++)
+      buffer.encode_uint32(i, i * 2654435761UL);
+  });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void benchmark_json() {
+#ifdef USE_JSON
+  std::string out;
+  float value = 0.0f;
+  run_benchmark("json.build_state", [&]() {
+    json::build_json(
+        [&value](JsonObject root) {
+          root["id"] = "sensor-living_room_temperature";
+          root["state"] = "21.5 °C";
+          root["value"] = value += 0.25f;
+        },
+        out);
+  });
+#else
+  skip_benchmark("json.build_state", "ArduinoJson not found");
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void benchmark_logger() {
+  // no UART output, only a callback like the API or web server would add
+  auto *log = new logger::Logger(0, 512, logger::UART_SELECTION_UART0);  // NOLINT
+  log->pre_setup();
+  size_t received = 0;
+  log->add_on_log_callback([&received](int level, const char *tag, const char *msg) { received += strlen(msg); });
+
+  static const char *const TAG = "benchmark";
+  static const char *const QUIET_TAG = "quiet";
+  log->set_log_level(QUIET_TAG, ESPHOME_LOG_LEVEL_WARN);
+  int counter = 0;
+  run_benchmark("logger.log_debug", [&]() { ESP_LOGD(TAG, "Sending state %.2f with %d decimals", 21.5f, counter++); });
+  run_benchmark("logger.log_debug_tag_filtered", [&]() { ESP_LOGD(QUIET_TAG, "Filtered %d", counter++); });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/// RGB strip with a plain pixel buffer, like the NeoPixelBus outputs.
+class HostLightOutput : public light::AddressableLight {
+ public:
+  using Format = light::AddressablePixelFormat<3, 1, 0, 2>;
+
+  explicit HostLightOutput(int32_t size) : pixels_(size * 3), effect_data_(size) {}
+
+  int32_t size() const override { return this->effect_data_.size(); }
+  void clear_effect_data() override { std::fill(this->effect_data_.begin(), this->effect_data_.end(), 0); }
+  light::LightTraits get_traits() override {
+    auto traits = light::LightTraits();
+    traits.set_supported_color_modes({light::ColorMode::RGB});
+    return traits;
+  }
+  void write_state(light::LightState *state) override {}
+  optional<light::AddressableLightBuffer> get_raw_buffer() const override {
+    return Format::buffer(const_cast<uint8_t *>(this->pixels_.data()));  // NOLINT
+  }
+  void fill_range(int32_t from, int32_t to, Color color) override {
+    Format::fill(this->pixels_.data(), from, to, color, this->correction_);
+  }
+  void write_span(int32_t first, const Color *colors, int32_t count) override {
+    Format::write(this->pixels_.data(), first, colors, count, this->correction_);
+  }
+  void read_span(int32_t first, Color *colors, int32_t count) const override {
+    Format::read(this->pixels_.data(), first, colors, count, this->correction_);
+  }
+
+ protected:
+  light::ESPColorView get_view_internal(int32_t index) const override {
+    auto *base = const_cast<uint8_t *>(this->pixels_.data()) + 3 * index;  // NOLINT
+    return light::ESPColorView(base + 1, base, base + 2, nullptr,
+                               const_cast<uint8_t *>(this->effect_data_.data()) + index,  // NOLINT
+                               &this->correction_);
+  }
+
+  std::vector<uint8_t> pixels_;
+  std::vector<uint8_t> effect_data_;
+};
+
+static void benchmark_light() {
+  HostLightOutput strip(300);
+  light::AddressableLightState state(&strip);
+  strip.setup_state(&state);
+  const Color color(255, 128, 0);
+
+  light::AddressableRainbowLightEffect rainbow("rainbow");
+  run_benchmark("light.rainbow_300", [&]() {
+    host_advance_millis(16);
+    rainbow.apply(strip, color);
+  });
+  light::AddressableTwinkleEffect twinkle("twinkle");
+  run_benchmark("light.twinkle_300", [&]() {
+    host_advance_millis(16);
+    twinkle.apply(strip, color);
+  });
+  light::AddressableFireworksEffect fireworks("fireworks");
+  run_benchmark("light.fireworks_300", [&]() {
+    host_advance_millis(16);
+    fireworks.apply(strip, color);
+  });
+  run_benchmark("light.fill_range_300", [&]() { strip.fill_range(0, strip.size(), color); });
+  run_benchmark("light.view_assign_300", [&]() {
+    for (auto led : strip)
+      led = color;
+  });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/// 16 bit color framebuffer, like the TFT displays.
+class HostDisplay : public display::DisplayBuffer {
+ public:
+  HostDisplay() : pixels_(WIDTH * HEIGHT) {}
+
+  static const int WIDTH = 320;
+  static const int HEIGHT = 240;
+
+ protected:
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT)
+      return;
+    this->pixels_[y * WIDTH + x] = ((color.r & 0xF8) << 8) | ((color.g & 0xFC) << 3) | (color.b >> 3);
+  }
+  int get_width_internal() override { return WIDTH; }
+  int get_height_internal() override { return HEIGHT; }
+
+  std::vector<uint16_t> pixels_;
+};
+
+static void benchmark_display() {
+  HostDisplay display;
+  const Color color(200, 100, 50);
+  int i = 0;
+  run_benchmark("display.fill", [&]() { display.fill(color); });
+  run_benchmark("display.line", [&]() {
+    display.line(0, i % HostDisplay::HEIGHT, HostDisplay::WIDTH - 1, HostDisplay::HEIGHT - 1 - i % HostDisplay::HEIGHT,
+                 color);
+    i++;
+  });
+  run_benchmark("display.filled_rectangle_100x50", [&]() { display.filled_rectangle(20, 20, 100, 50, color); });
+  run_benchmark("display.filled_circle_r40", [&]() { display.filled_circle(160, 120, 40, color); });
+  run_benchmark("display.circle_r80", [&]() { display.circle(160, 120, 80, color); });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+struct Benchmark {
+  const char *group;
+  void (*run)();
+};
+static const Benchmark BENCHMARKS[] = {
+    {"scheduler", benchmark_scheduler}, {"sensor", benchmark_filters}, {"proto", benchmark_proto},
+    {"json", benchmark_json},           {"logger", benchmark_logger},  {"light", benchmark_light},
+    {"display", benchmark_display},
+};
+
+int main(int argc, char **argv) {
+  // script/core_benchmark [iterations] [group...]
+  int arg = 1;
+  if (arg < argc && strtoul(argv[arg], nullptr, 10) != 0)
+    iterations = strtoul(argv[arg++], nullptr, 10);
+  for (const auto &benchmark : BENCHMARKS) {
+    bool selected = arg >= argc;
+    for (int i = arg; i < argc; i++)
+      selected |= strcmp(argv[i], benchmark.group) == 0;
+    if (selected)
+      benchmark.run();
+  }
+  return 0;
+}
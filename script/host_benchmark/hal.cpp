@@ -0,0 +1,75 @@
+// Mock HAL for building core code on the host, used by script/core_benchmark.
+//
+// millis() and micros() follow a virtual clock that only moves when the benchmark advances it (or calls delay()), so
+// scheduler runs are deterministic and don't depend on how fast the host is.
+
+#include "hal.h"
+
+#include "esphome/core/hal.h"
+#include "esphome/core/preferences.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+namespace esphome {
+
+static uint64_t virtual_micros = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void host_advance_millis(uint32_t ms) { virtual_micros += uint64_t(ms) * 1000; }
+
+void yield() {}
+uint32_t millis() { return virtual_micros / 1000; }
+uint32_t micros() { return virtual_micros; }
+void delay(uint32_t ms) { host_advance_millis(ms); }
+void delayMicroseconds(uint32_t us) { virtual_micros += us; }  // NOLINT(readability-identifier-naming)
+void arch_restart() { abort(); }
+void arch_init() {}
+void arch_feed_wdt() {}
+uint32_t arch_get_cpu_cycle_count() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+uint32_t arch_get_cpu_freq_hz() { return 1000000000UL; }
+uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
+
+/// Preferences kept in memory, so components that restore their state can be set up.
+class HostPreferenceBackend : public ESPPreferenceBackend {
+ public:
+  bool save(const uint8_t *data, size_t len) override {
+    this->data_.assign(data, data + len);
+    return true;
+  }
+  bool load(uint8_t *data, size_t len) override {
+    if (this->data_.size() != len)
+      return false;
+    std::copy(this->data_.begin(), this->data_.end(), data);
+    return true;
+  }
+
+ protected:
+  std::vector<uint8_t> data_;
+};
+
+class HostPreferences : public ESPPreferences {
+ public:
+  ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
+    return &this->backends_[type];
+  }
+  ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
+    return this->make_preference(length, type, false);
+  }
+  bool sync() override {
+    this->flash_writes_++;
+    return true;
+  }
+
+ protected:
+  std::map<uint32_t, HostPreferenceBackend> backends_;
+};
+
+static HostPreferences host_preferences;                 // NOLINT
+ESPPreferences *global_preferences = &host_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace esphome
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+
+/// Move the virtual clock behind millis() and micros() forward.
+void host_advance_millis(uint32_t ms);
+
+}  // namespace esphome
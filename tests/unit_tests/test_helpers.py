@@ -81,6 +81,34 @@ def test_cpp_string_escape(string, expected):
     assert actual == expected
 
 
+@pytest.mark.parametrize(
+    "string, expected",
+    (
+        ("", 2166136261),
+        ("test_bs1", 3362636122),
+        ("living_room", 3355232812),
+    ),
+)
+def test_fnv1_hash(string, expected):
+    actual = helpers.fnv1_hash(string)
+
+    assert actual == expected
+
+
+@pytest.mark.parametrize(
+    "name, expected",
+    (
+        ("test bs1", "test_bs1"),
+        ("Living Room Temp-1 (°C)", "living_room_temp-1_c"),
+        ("Wifi Signal 🐍", "wifi_signal_"),
+    ),
+)
+def test_entity_object_id(name, expected):
+    actual = helpers.entity_object_id(name)
+
+    assert actual == expected
+
+
 @pytest.mark.parametrize(
     "host",
     (
@@ -0,0 +1,60 @@
+import pytest
+
+from esphome.components import image
+
+
+def rle_decode(data, height, width, pixel_size):
+    """Reference implementation of what DisplayBuffer::image_rle_() does on the ESP."""
+    rows = []
+    for y in range(height):
+        pos = data[y * 3] | data[y * 3 + 1] << 8 | data[y * 3 + 2] << 16
+        row = []
+        while len(row) < width:
+            header = data[pos]
+            pos += 1
+            count = (header & 0x7F) + 1
+            if header & 0x80:
+                row += [tuple(data[pos : pos + pixel_size])] * count
+                pos += pixel_size
+            else:
+                for _ in range(count):
+                    row.append(tuple(data[pos : pos + pixel_size]))
+                    pos += pixel_size
+        assert len(row) == width
+        rows.append(row)
+    return rows
+
+
+@pytest.mark.parametrize(
+    "rows",
+    (
+        [[(0,)] * 10],
+        [[(x,) for x in range(10)]],
+        [[(1,), (1,), (2,), (3,), (3,), (3,), (3,), (4,)]],
+        [[(7,)] * 300, [(x % 256,) for x in range(300)]],
+        [[(1, 2, 3)] * 5 + [(4, 5, 6), (7, 8, 9)], [(0, 0, 0)] * 7],
+    ),
+)
+def test_rle_encode_round_trip(rows):
+    compressed = image.rle_encode(rows)
+
+    assert rle_decode(compressed, len(rows), len(rows[0]), len(rows[0][0])) == rows
+
+
+def test_rle_encode_packets():
+    compressed = image.rle_encode([[(5,)] * 4 + [(1,), (2,)]])
+
+    # offset table, a repeat packet of 4, then a literal packet of 2
+    assert compressed == [3, 0, 0, 0x83, 5, 0x01, 1, 2]
+
+
+def test_rle_encode_splits_long_runs():
+    compressed = image.rle_encode([[(9,)] * (image.RLE_MAX_PACKET + 1)])
+
+    assert compressed[3:] == [0xFF, 9, 0x00, 9]
+
+
+def test_rle_encode_keeps_short_repeats_literal():
+    compressed = image.rle_encode([[(1,), (1,), (2,)]])
+
+    assert compressed[3:] == [0x02, 1, 1, 2]
@@ -0,0 +1,65 @@
+import os
+import struct
+
+import pytest
+
+from esphome import ota_delta
+
+
+def apply_delta(base, delta):
+    """Reference implementation of what ota/ota_delta.cpp does on the ESP."""
+    assert delta[:4] == ota_delta.DELTA_MAGIC
+    (size,) = struct.unpack_from("<I", delta, 4)
+    pos = 8
+    image = bytearray()
+    while len(image) < size:
+        op = delta[pos]
+        pos += 1
+        if op == ota_delta.OP_COPY:
+            source, length = struct.unpack_from("<II", delta, pos)
+            pos += 8
+            image += base[source : source + length]
+        else:
+            assert op == ota_delta.OP_INSERT
+            (length,) = struct.unpack_from("<I", delta, pos)
+            pos += 4
+            image += delta[pos : pos + length]
+            pos += length
+    assert pos == len(delta)
+    return bytes(image)
+
+
+BASE = os.urandom(20000)
+
+
+@pytest.mark.parametrize(
+    "target",
+    (
+        b"",
+        BASE,
+        BASE[:5000] + b"inserted" + BASE[5000:],
+        BASE[:1000] + BASE[1500:],
+        BASE[10000:] + BASE[:10000],
+        os.urandom(1000),
+    ),
+)
+def test_make_delta_round_trip(target):
+    delta = ota_delta.make_delta(BASE, target)
+
+    assert apply_delta(BASE, delta) == target
+
+
+def test_make_delta_is_small_for_small_changes():
+    target = BASE[:5000] + b"inserted" + BASE[5000:]
+
+    delta = ota_delta.make_delta(BASE, target)
+
+    assert len(delta) < 100
+
+
+def test_image_digest_uses_appended_sha256():
+    image = bytearray(os.urandom(100))
+    image[0] = 0xE9
+    image[23] = 1
+
+    assert ota_delta.image_digest(image) == bytes(image[-32:])
@@ -0,0 +1,70 @@
+import math
+
+from esphome import perf_report
+
+
+def test_size_metrics():
+    sizes = {
+        "core": {"text": 100, "rodata": 20, "data": 4, "bss": 50},
+        "other": {"text": 1000, "rodata": 200, "data": 40, "bss": 500},
+    }
+
+    assert perf_report.size_metrics(sizes) == {"flash": 1364, "ram": 594}
+
+
+def test_runtime_metrics():
+    samples = {
+        "perf_loop_p95": [1.0, 3.0, 2.0],
+        "perf_heap_min_free": [2000, 1500, 1800],
+        "perf_heap_free": [math.nan],
+        "other_sensor": [5.0],
+    }
+
+    assert perf_report.runtime_metrics(samples) == {
+        "loop_p95": 2.0,
+        "heap_min_free": 1500,
+    }
+
+
+def test_compare():
+    metrics = {"flash": 1050, "ram": 1000, "heap_free": 900, "loop_p50": 1.0}
+    baseline = {"flash": 1000, "ram": 1000, "heap_free": 1000, "time_to_api": 3.0}
+
+    results = {r.name: r for r in perf_report.compare(metrics, baseline)}
+
+    assert set(results) == {"flash", "ram", "heap_free"}
+    assert results["flash"].regressed
+    assert math.isclose(results["flash"].change, 0.05)
+    assert not results["ram"].regressed
+    # less free heap is worse
+    assert results["heap_free"].regressed
+
+
+def test_compare_tolerance_override():
+    results = perf_report.compare({"flash": 1050}, {"flash": 1000}, {"flash": 0.1})
+
+    assert not results[0].regressed
+    assert results[0].tolerance == 0.1
+
+
+def test_baseline_roundtrip(tmp_path):
+    path = str(tmp_path / "baseline.json")
+    assert perf_report.load_baseline(path) == ({}, {})
+
+    perf_report.write_baseline(path, {"flash": 1000})
+    assert perf_report.load_baseline(path) == ({"flash": 1000}, {})
+
+    with open(path, "w", encoding="utf-8") as file_handle:
+        file_handle.write('{"metrics": {"flash": 1}, "tolerances": {"flash": 0.1}}')
+    perf_report.write_baseline(path, {"flash": 2000})
+    assert perf_report.load_baseline(path) == ({"flash": 2000}, {"flash": 0.1})
+
+
+def test_format_comparison():
+    results = perf_report.compare({"flash": 1100}, {"flash": 1000})
+
+    text = perf_report.format_comparison(results)
+
+    assert "flash" in text
+    assert "+10.0%" in text
+    assert "REGRESSION" in text
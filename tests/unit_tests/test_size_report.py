@@ -0,0 +1,66 @@
+from esphome import size_report
+
+MAP_FILE = """\
+Archive member included to satisfy reference by file (symbol)
+
+Discarded input sections
+
+ .text          0x00000000       0x10 .pioenvs/test/src/esphome/components/wifi/wifi_component.cpp.o
+
+Linker script and memory map
+
+.irom0.text     0x40201010     0x1000
+ *(.irom0.literal .irom.literal .irom.text.literal .irom0.text .irom0.text.* .irom.text .irom.text.*)
+ .irom0.text    0x40201010       0x40 .pioenvs/test/src/esphome/core/application.cpp.o
+ .text._ZN7esphome4wifi13WiFiComponent5setupEv
+                0x40201050      0x120 .pioenvs/test/src/esphome/components/wifi/wifi_component.cpp.o
+                0x40201050                esphome::wifi::WiFiComponent::setup()
+ *fill*         0x40201170        0x4 
+ .text          0x40201174       0x30 .pioenvs/test/src/main.cpp.o
+ .text          0x402011a4       0x20 /home/user/.platformio/packages/framework/libc.a(memcpy.o)
+.data           0x3ffe8000       0x20
+ .data          0x3ffe8000       0x10 .pioenvs/test/src/esphome/components/wifi/wifi_component.cpp.o
+ .data          0x3ffe8010        0x0 .pioenvs/test/src/main.cpp.o
+.rodata         0x3ffe8020       0x10
+ .rodata.str1.1
+                0x3ffe8020        0x8 .pioenvs/test/src/esphome/components/wifi/wifi_component.cpp.o
+.bss            0x3ffe8100       0x40
+ .bss           0x3ffe8100       0x18 .pioenvs/test/src/esphome/core/application.cpp.o
+.debug_info     0x00000000     0x9000
+ .debug_info    0x00000000      0x100 .pioenvs/test/src/esphome/core/application.cpp.o
+"""
+
+
+def test_parse_map():
+    sizes = size_report.parse_map(MAP_FILE)
+
+    assert sizes == {
+        "core": {"text": 0x40, "rodata": 0, "data": 0, "bss": 0x18},
+        "wifi": {"text": 0x120, "rodata": 0x8, "data": 0x10, "bss": 0},
+        "main": {"text": 0x30, "rodata": 0, "data": 0, "bss": 0},
+        "other": {"text": 0x20, "rodata": 0, "data": 0, "bss": 0},
+    }
+
+
+def test_format_report__with_previous():
+    sizes = {"wifi": {"text": 300, "rodata": 8, "data": 16, "bss": 0}}
+    previous = {"wifi": {"text": 200, "rodata": 8, "data": 16, "bss": 0}}
+
+    report = size_report.format_report(sizes, previous)
+
+    assert "+100" in report.splitlines()[1]
+    assert report.splitlines()[-1].split()[:2] == ["total", "300"]
+
+
+def test_create_report__stores_and_compares(tmp_path):
+    map_path = tmp_path / "firmware.map"
+    map_path.write_text(MAP_FILE)
+    report_path = tmp_path / "size_report.json"
+
+    first = size_report.create_report(str(map_path), str(report_path))
+    second = size_report.create_report(str(map_path), str(report_path))
+
+    assert report_path.is_file()
+    assert "+" not in first
+    # Unchanged since the last report, so no differences are shown
+    assert "+" not in second and "-" not in second